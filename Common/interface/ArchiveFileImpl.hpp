@@ -29,13 +29,23 @@
 /// \file
 /// Implementation of the Diligent::ArchiveFileImpl class
 
-#include <mutex>
-
+#include "../../Primitives/interface/DataBlob.h"
 #include "Archive.h"
 #include "ObjectBase.hpp"
-#include "FileWrapper.hpp"
 #include "RefCntAutoPtr.hpp"
 
+#if PLATFORM_LINUX
+// Positional reads and memory mapping allow concurrent reads without locking
+#    define DILIGENT_ARCHIVE_FILE_POSIX 1
+#else
+#    define DILIGENT_ARCHIVE_FILE_POSIX 0
+#endif
+
+#if !DILIGENT_ARCHIVE_FILE_POSIX
+#    include <mutex>
+#    include "FileWrapper.hpp"
+#endif
+
 namespace Diligent
 {
 
@@ -48,6 +58,7 @@ public:
     static RefCntAutoPtr<IArchive> Create(const Char* Path);
 
     ArchiveFileImpl(IReferenceCounters* pRefCounters, const Char* Path);
+    ~ArchiveFileImpl();
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_Archive, TObjectBase)
 
@@ -55,10 +66,32 @@ public:
 
     virtual Uint64 DILIGENT_CALL_TYPE GetSize() const override final { return m_FileSize; }
 
+    /// Returns the data blob that references the archive data in the range [Offset, Offset + Size).
+
+    /// \param[in]  Offset - Offset, in bytes, from the beginning of the archive.
+    /// \param[in]  Size   - Size of the data, in bytes.
+    /// \return     Data blob that contains the requested data, or null if the range
+    ///             is out of the archive bounds or the data could not be read.
+    ///
+    /// \remarks    If the file is memory-mapped, the blob is a read-only view into the mapping
+    ///             that keeps the archive alive; no data is copied. Otherwise, the data is read
+    ///             into a new blob.
+    ///             The method is thread-safe.
+    RefCntAutoPtr<IDataBlob> Map(Uint64 Offset, Uint64 Size);
+
+    /// Returns true if the archive file is memory-mapped.
+    bool IsMapped() const { return m_pMappedData != nullptr; }
+
 private:
-    std::mutex   m_Mtx;
-    FileWrapper  m_File;
-    const size_t m_FileSize;
+#if DILIGENT_ARCHIVE_FILE_POSIX
+    int m_FD = -1;
+#else
+    std::mutex  m_Mtx;
+    FileWrapper m_File;
+#endif
+
+    const Uint8* m_pMappedData = nullptr;
+    Uint64       m_FileSize    = 0;
 };
 
 } // namespace Diligent
@@ -30,15 +30,14 @@
 /// \file
 /// Declaration of Diligent::FixedBlockMemoryAllocator class
 
-#include <unordered_map>
 #include <mutex>
-#include <unordered_set>
 #include <vector>
 #include <cstring>
 #include <memory>
 #include "../../Primitives/interface/Errors.hpp"
 #include "../../Primitives/interface/MemoryAllocator.h"
 #include "STDAllocator.hpp"
+#include "LockHelper.hpp"
 
 namespace Diligent
 {
@@ -53,10 +52,26 @@ inline void FillWithDebugPattern(void* ptr, Uint8 Pattern, size_t NumBytes)
 #endif
 
 /// Memory allocator that allocates memory in a fixed-size chunks
+
+/// Every block is prefixed with the pointer to the page that owns it, so that
+/// the page can be found in O(1) time when the block is released.
+/// The allocator optionally maintains a set of small per-thread free-block caches
+/// that let threads allocate and release blocks without taking the allocator-wide mutex.
 class FixedBlockMemoryAllocator final : public IMemoryAllocator
 {
 public:
-    FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator, size_t BlockSize, Uint32 NumBlocksInPage);
+    /// \param [in] RawMemoryAllocator - Raw memory allocator that is used to allocate pages.
+    /// \param [in] BlockSize          - Block size.
+    /// \param [in] NumBlocksInPage    - The number of blocks in one page.
+    /// \param [in] MaxEmptyPages      - The maximum number of empty pages that the allocator keeps.
+    ///                                  Empty pages past this watermark are returned to the raw allocator.
+    /// \param [in] ThreadCacheSize    - The maximum number of free blocks in each per-thread cache.
+    ///                                  If this value is zero, per-thread caches are disabled.
+    FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator,
+                              size_t            BlockSize,
+                              Uint32            NumBlocksInPage,
+                              Uint32            MaxEmptyPages   = ~Uint32{0},
+                              Uint32            ThreadCacheSize = 0);
     ~FixedBlockMemoryAllocator();
 
     /// Allocates block of memory
@@ -65,6 +80,9 @@ public:
     /// Releases memory
     virtual void Free(void* Ptr) override final;
 
+    /// Returns the number of pages currently owned by the allocator
+    size_t GetNumPages() const;
+
 private:
     // clang-format off
     FixedBlockMemoryAllocator             (const FixedBlockMemoryAllocator&) = delete;
@@ -73,164 +91,77 @@ private:
     FixedBlockMemoryAllocator& operator = (FixedBlockMemoryAllocator&&)      = delete;
     // clang-format on
 
-    void CreateNewPage();
-
-    // Memory page class is based on the fixed-size memory pool described in "Fast Efficient Fixed-Size Memory Pool"
+    // Memory page header that is placed at the beginning of every page.
+    // Pages are based on the fixed-size memory pool described in "Fast Efficient Fixed-Size Memory Pool"
     // by Ben Kenwright
-    class MemoryPage
-    {
-    public:
-        static constexpr Uint8 NewPageMemPattern          = 0xAA;
-        static constexpr Uint8 AllocatedBlockMemPattern   = 0xAB;
-        static constexpr Uint8 DeallocatedBlockMemPattern = 0xDE;
-        static constexpr Uint8 InitializedBlockMemPattern = 0xCF;
-
-        MemoryPage(FixedBlockMemoryAllocator& OwnerAllocator) :
-            // clang-format off
-            m_NumFreeBlocks       {OwnerAllocator.m_NumBlocksInPage},
-            m_NumInitializedBlocks{0},
-            m_pOwnerAllocator     {&OwnerAllocator}
-        // clang-format on
-        {
-            auto PageSize = OwnerAllocator.m_BlockSize * OwnerAllocator.m_NumBlocksInPage;
-            m_pPageStart  = reinterpret_cast<Uint8*>(
-                OwnerAllocator.m_RawMemoryAllocator.Allocate(PageSize, "FixedBlockMemoryAllocator page", __FILE__, __LINE__));
-            m_pNextFreeBlock = m_pPageStart;
-            FillWithDebugPattern(m_pPageStart, NewPageMemPattern, PageSize);
-        }
+    struct MemoryPage;
 
-        MemoryPage(MemoryPage&& Page) noexcept :
-            // clang-format off
-            m_NumFreeBlocks       {Page.m_NumFreeBlocks       },
-            m_NumInitializedBlocks{Page.m_NumInitializedBlocks},
-            m_pPageStart          {Page.m_pPageStart          },
-            m_pNextFreeBlock      {Page.m_pNextFreeBlock      },
-            m_pOwnerAllocator     {Page.m_pOwnerAllocator     }
-        // clang-format on
-        {
-            Page.m_NumFreeBlocks        = 0;
-            Page.m_NumInitializedBlocks = 0;
-            Page.m_pPageStart           = nullptr;
-            Page.m_pNextFreeBlock       = nullptr;
-            Page.m_pOwnerAllocator      = nullptr;
-        }
+    static constexpr Uint8 NewPageMemPattern          = 0xAA;
+    static constexpr Uint8 AllocatedBlockMemPattern   = 0xAB;
+    static constexpr Uint8 DeallocatedBlockMemPattern = 0xDE;
+    static constexpr Uint8 InitializedBlockMemPattern = 0xCF;
 
-        ~MemoryPage()
-        {
-            if (m_pOwnerAllocator)
-                m_pOwnerAllocator->m_RawMemoryAllocator.Free(m_pPageStart);
-        }
+    // All methods below must be called with m_Mutex locked
+    MemoryPage* CreateNewPage();
+    void        ReleasePage(MemoryPage* pPage);
+    void        AddAvailablePage(MemoryPage* pPage);
+    void        RemoveAvailablePage(MemoryPage* pPage);
+    void*       AllocateFromPages();
+    void        ReturnToPage(void* Ptr);
 
-        void* GetBlockStartAddress(Uint32 BlockIndex) const
-        {
-            VERIFY_EXPR(m_pOwnerAllocator != nullptr);
-            VERIFY(BlockIndex >= 0 && BlockIndex < m_pOwnerAllocator->m_NumBlocksInPage, "Invalid block index");
-            return reinterpret_cast<Uint8*>(m_pPageStart) + BlockIndex * m_pOwnerAllocator->m_BlockSize;
-        }
+    void* GetBlockAddress(MemoryPage* pPage, Uint32 BlockIndex) const;
 
-#ifdef DILIGENT_DEBUG
-        void dbgVerifyAddress(const void* pBlockAddr) const
-        {
-            size_t Delta = reinterpret_cast<const Uint8*>(pBlockAddr) - reinterpret_cast<Uint8*>(m_pPageStart);
-            VERIFY(Delta % m_pOwnerAllocator->m_BlockSize == 0, "Invalid address");
-            Uint32 BlockIndex = static_cast<Uint32>(Delta / m_pOwnerAllocator->m_BlockSize);
-            VERIFY(BlockIndex >= 0 && BlockIndex < m_pOwnerAllocator->m_NumBlocksInPage, "Invalid block index");
-        }
-#else
-#    define dbgVerifyAddress(...)
-#endif
+    static MemoryPage* GetBlockPage(void* Ptr)
+    {
+        return reinterpret_cast<MemoryPage**>(Ptr)[-1];
+    }
 
-        void* Allocate()
-        {
-            VERIFY_EXPR(m_pOwnerAllocator != nullptr);
-
-            if (m_NumFreeBlocks == 0)
-            {
-                VERIFY_EXPR(m_NumInitializedBlocks == m_pOwnerAllocator->m_NumBlocksInPage);
-                return nullptr;
-            }
-
-            // Initialize the next block
-            if (m_NumInitializedBlocks < m_pOwnerAllocator->m_NumBlocksInPage)
-            {
-                // Link next uninitialized block to the end of the list:
-
-                //
-                //                            ___________                      ___________
-                //                           |           |                    |           |
-                //                           | 0xcdcdcd  |                 -->| 0xcdcdcd  |   m_NumInitializedBlocks
-                //                           |-----------|                |   |-----------|
-                //                           |           |                |   |           |
-                //  m_NumInitializedBlocks   | 0xcdcdcd  |      ==>        ---|           |
-                //                           |-----------|                    |-----------|
-                //
-                //                           ~           ~                    ~           ~
-                //                           |           |                    |           |
-                //                       0   |           |                    |           |
-                //                            -----------                      -----------
-                //
-                auto* pUninitializedBlock = GetBlockStartAddress(m_NumInitializedBlocks);
-                FillWithDebugPattern(pUninitializedBlock, InitializedBlockMemPattern, m_pOwnerAllocator->m_BlockSize);
-                void** ppNextBlock = reinterpret_cast<void**>(pUninitializedBlock);
-                ++m_NumInitializedBlocks;
-                if (m_NumInitializedBlocks < m_pOwnerAllocator->m_NumBlocksInPage)
-                    *ppNextBlock = GetBlockStartAddress(m_NumInitializedBlocks);
-                else
-                    *ppNextBlock = nullptr;
-            }
-
-            void* res = m_pNextFreeBlock;
-            dbgVerifyAddress(res);
-            // Move pointer to the next free block
-            m_pNextFreeBlock = *reinterpret_cast<void**>(m_pNextFreeBlock);
-            --m_NumFreeBlocks;
-            if (m_NumFreeBlocks != 0)
-                dbgVerifyAddress(m_pNextFreeBlock);
-            else
-                VERIFY_EXPR(m_pNextFreeBlock == nullptr);
-
-            FillWithDebugPattern(res, AllocatedBlockMemPattern, m_pOwnerAllocator->m_BlockSize);
-            return res;
-        }
+    static void*& GetNextFreeBlock(void* Ptr)
+    {
+        return *reinterpret_cast<void**>(Ptr);
+    }
 
-        void DeAllocate(void* p)
-        {
-            VERIFY_EXPR(m_pOwnerAllocator != nullptr);
-
-            dbgVerifyAddress(p);
-            FillWithDebugPattern(p, DeallocatedBlockMemPattern, m_pOwnerAllocator->m_BlockSize);
-            // Add block to the beginning of the linked list
-            *reinterpret_cast<void**>(p) = m_pNextFreeBlock;
-            m_pNextFreeBlock             = p;
-            ++m_NumFreeBlocks;
-        }
+#ifdef DILIGENT_DEBUG
+    void dbgVerifyAddress(const MemoryPage* pPage, const void* pBlockAddr) const;
+#endif
 
-        bool HasSpace() const { return m_NumFreeBlocks > 0; }
-        bool HasAllocations() const { return m_NumFreeBlocks < m_NumInitializedBlocks; }
+    static constexpr size_t CacheLineSize = 64;
 
-    private:
-        MemoryPage(const MemoryPage&) = delete;
-        MemoryPage& operator=(const MemoryPage) = delete;
-        MemoryPage& operator=(MemoryPage&&) = delete;
+    struct ThreadCacheData
+    {
+        ThreadingTools::LockFlag Lock;
 
-        Uint32                     m_NumFreeBlocks        = 0;       // Num of remaining blocks
-        Uint32                     m_NumInitializedBlocks = 0;       // Num of initialized blocks
-        void*                      m_pPageStart           = nullptr; // Beginning of memory pool
-        void*                      m_pNextFreeBlock       = nullptr; // Num of next free block
-        FixedBlockMemoryAllocator* m_pOwnerAllocator      = nullptr;
+        // Singly-linked list of free blocks
+        void*  pHead     = nullptr;
+        Uint32 NumBlocks = 0;
     };
+    // Pad every cache to the cache line size to avoid false sharing
+    struct ThreadCache : ThreadCacheData
+    {
+        Uint8 Padding[CacheLineSize - sizeof(ThreadCacheData)];
+    };
+    static_assert(sizeof(ThreadCache) == CacheLineSize, "Unexpected sizeof(ThreadCache)");
+
+    ThreadCache& GetThreadCache();
+    void         FlushThreadCaches();
 
-    std::vector<MemoryPage, STDAllocatorRawMem<MemoryPage>>                                          m_PagePool;
-    std::unordered_set<size_t, std::hash<size_t>, std::equal_to<size_t>, STDAllocatorRawMem<size_t>> m_AvailablePages;
+    std::vector<MemoryPage*, STDAllocatorRawMem<MemoryPage*>> m_Pages;
+    std::vector<ThreadCache, STDAllocatorRawMem<ThreadCache>> m_ThreadCaches;
 
-    using AddrToPageIdMapElem = std::pair<void* const, size_t>;
-    std::unordered_map<void*, size_t, std::hash<void*>, std::equal_to<void*>, STDAllocatorRawMem<AddrToPageIdMapElem>> m_AddrToPageId;
+    // Doubly-linked list of pages that have free blocks
+    MemoryPage* m_pAvailablePages = nullptr;
+    Uint32      m_NumEmptyPages   = 0;
 
-    std::mutex m_Mutex;
+    mutable std::mutex m_Mutex;
 
     IMemoryAllocator& m_RawMemoryAllocator;
     const size_t      m_BlockSize;
+    const size_t      m_BlockPrefixSize;
+    const size_t      m_BlockStride;
+    const size_t      m_PageHeaderSize;
     const Uint32      m_NumBlocksInPage;
+    const Uint32      m_MaxEmptyPages;
+    const Uint32      m_ThreadCacheSize;
 };
 
 IMemoryAllocator& GetRawAllocator();
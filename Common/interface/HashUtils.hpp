@@ -30,7 +30,9 @@
 #include <functional>
 #include <memory>
 #include <cstring>
+#include <type_traits>
 
+#include "../../Primitives/interface/BasicTypes.h"
 #include "../../Primitives/interface/Errors.hpp"
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
 
@@ -218,4 +220,129 @@ protected:
     size_t Ownership_Hash = 0;
 };
 
+
+/// 128-bit hash of the contents of a memory block.
+
+/// The hash is intended to be used as a key of content-addressed caches
+/// (e.g. compiled shaders keyed by their source) where the probability of
+/// collisions must be negligible. It is not a cryptographic hash.
+struct ContentHash
+{
+    Uint64 Lo = 0;
+    Uint64 Hi = 0;
+
+    bool operator==(const ContentHash& RHS) const
+    {
+        return Lo == RHS.Lo && Hi == RHS.Hi;
+    }
+
+    bool operator!=(const ContentHash& RHS) const
+    {
+        return !(*this == RHS);
+    }
+
+    struct Hasher
+    {
+        size_t operator()(const ContentHash& Hash) const
+        {
+            return static_cast<size_t>(Hash.Lo ^ (Hash.Hi * 0x9e3779b97f4a7c15ull));
+        }
+    };
+};
+
+/// Computes the 128-bit content hash of the data.
+
+/// \param [in] pData - Pointer to the data.
+/// \param [in] Size  - Data size, in bytes.
+/// \param [in] Seed  - Hash of the preceding data. This allows computing a single
+///                     hash of several non-contiguous blocks:
+///                     ComputeContentHash(B, SizeB, ComputeContentHash(A, SizeA)).
+inline ContentHash ComputeContentHash(const void* pData, size_t Size, const ContentHash& Seed = {})
+{
+    VERIFY(pData != nullptr || Size == 0, "Data pointer must not be null");
+
+    constexpr Uint64 K0 = 0x9e3779b97f4a7c15ull;
+    constexpr Uint64 K1 = 0xc2b2ae3d27d4eb4full;
+    constexpr Uint64 K2 = 0x165667b19e3779f9ull;
+    constexpr Uint64 K3 = 0xff51afd7ed558ccdull;
+
+    auto RotL = [](Uint64 x, int r) {
+        return (x << r) | (x >> (64 - r));
+    };
+    // MurmurHash3 finalizer
+    auto FMix = [](Uint64 x) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdull;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ull;
+        x ^= x >> 33;
+        return x;
+    };
+
+    Uint64 Lo = Seed.Lo ^ (static_cast<Uint64>(Size) * K0);
+    Uint64 Hi = Seed.Hi ^ (static_cast<Uint64>(Size) * K1) ^ K2;
+
+    const auto* pBytes   = static_cast<const Uint8*>(pData);
+    const auto  NumWords = Size / sizeof(Uint64);
+    for (size_t i = 0; i < NumWords; ++i)
+    {
+        Uint64 Word;
+        memcpy(&Word, pBytes + i * sizeof(Uint64), sizeof(Word));
+        Lo = RotL(Lo ^ (Word * K1), 31) * K0 + Hi;
+        Hi = RotL(Hi ^ (Word * K3), 29) * K2 + Lo;
+    }
+
+    const auto TailSize = Size % sizeof(Uint64);
+    if (TailSize != 0)
+    {
+        Uint64 Word = 0;
+        memcpy(&Word, pBytes + NumWords * sizeof(Uint64), TailSize);
+        Lo = RotL(Lo ^ (Word * K1), 31) * K0 + Hi;
+        Hi = RotL(Hi ^ (Word * K3), 29) * K2 + Lo;
+    }
+
+    ContentHash Hash;
+    Hash.Lo = FMix(Lo + RotL(Hi, 17));
+    Hash.Hi = FMix(Hi ^ RotL(Lo, 41));
+    return Hash;
+}
+
+/// Incrementally computes the content hash of a sequence of values.
+
+/// Values are hashed one by one, so structures with padding must be hashed field-wise.
+class ContentHasher
+{
+public:
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type Update(const T& Val)
+    {
+        m_Hash = ComputeContentHash(&Val, sizeof(Val), m_Hash);
+    }
+
+    /// Hashes the string including its length. Null string is distinct from an empty string.
+    void Update(const char* Str)
+    {
+        const Uint64 Len = Str != nullptr ? strlen(Str) : ~Uint64{0};
+        Update(Len);
+        if (Str != nullptr)
+            m_Hash = ComputeContentHash(Str, static_cast<size_t>(Len), m_Hash);
+    }
+
+    void Update(const ContentHash& Hash)
+    {
+        Update(Hash.Lo);
+        Update(Hash.Hi);
+    }
+
+    void UpdateRaw(const void* pData, size_t Size)
+    {
+        m_Hash = ComputeContentHash(pData, Size, m_Hash);
+    }
+
+    const ContentHash& Get() const { return m_Hash; }
+
+private:
+    ContentHash m_Hash;
+};
+
 } // namespace Diligent
@@ -39,14 +39,21 @@
 namespace Diligent
 {
 
+// {4F3A8E1D-7C62-4B9A-A5D4-2E81C6B07F93}
+static const INTERFACE_ID IID_MemoryFileStream =
+    {0x4f3a8e1d, 0x7c62, 0x4b9a, {0xa5, 0xd4, 0x2e, 0x81, 0xc6, 0xb0, 0x7f, 0x93}};
+
 /// Memory file stream implementation
 class MemoryFileStream : public ObjectBase<IFileStream>
 {
 public:
     typedef ObjectBase<IFileStream> TBase;
 
+    /// If ReadOnly is true, the stream does not allow writing, so that
+    /// the data blob can be safely shared between multiple streams.
     MemoryFileStream(IReferenceCounters* pRefCounters,
-                     IDataBlob*          pData);
+                     IDataBlob*          pData,
+                     bool                ReadOnly = false);
 
     virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override;
 
@@ -63,9 +70,21 @@ public:
 
     virtual bool DILIGENT_CALL_TYPE IsValid() override;
 
+    /// Returns the data blob the stream reads from.
+    IDataBlob* GetDataBlob() { return m_DataBlob; }
+
 private:
+    friend RefCntAutoPtr<IDataBlob> ReadStreamBlob(IFileStream* pStream);
+
     RefCntAutoPtr<IDataBlob> m_DataBlob;
     size_t                   m_CurrentOffset = 0;
+    const bool               m_ReadOnly;
 };
 
+/// Reads the remaining contents of the stream into a data blob.
+
+/// If the stream is a read-only memory stream that has not been read from, its data blob
+/// is returned without copying. Otherwise, a new data blob is created.
+RefCntAutoPtr<IDataBlob> ReadStreamBlob(IFileStream* pStream);
+
 } // namespace Diligent
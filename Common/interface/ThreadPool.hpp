@@ -0,0 +1,111 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ThreadPool class
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Fixed-size pool of worker threads with work stealing.
+
+/// Every worker owns a task queue. Tasks enqueued by a worker thread go to its own queue,
+/// tasks enqueued by other threads are distributed between the queues in round-robin fashion.
+/// A worker executes tasks from its own queue in FIFO order and, when it runs out of work,
+/// steals tasks from the other queues.
+class ThreadPool
+{
+public:
+    using TaskType = std::function<void()>;
+
+    /// \param [in] NumThreads - The number of worker threads, must not be zero.
+    explicit ThreadPool(Uint32 NumThreads);
+
+    /// Executes all remaining tasks and joins the worker threads.
+    ~ThreadPool();
+
+    // clang-format off
+    ThreadPool           (const ThreadPool&)  = delete;
+    ThreadPool           (      ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&)  = delete;
+    ThreadPool& operator=(      ThreadPool&&) = delete;
+    // clang-format on
+
+    /// Adds the task to the pool and returns the future that becomes ready when the task completes.
+    /// The exception thrown by the task, if any, is stored in the future.
+    std::future<void> Enqueue(TaskType Task);
+
+    /// Waits until all enqueued tasks complete.
+
+    /// \warning This method must not be called from a worker thread.
+    void WaitForAllTasks();
+
+    Uint32 GetNumThreads() const { return static_cast<Uint32>(m_Threads.size()); }
+
+    /// Returns the number of tasks that have been enqueued, but have not completed yet.
+    Uint32 GetNumPendingTasks() const { return m_NumPendingTasks.load(); }
+
+private:
+    void WorkerThreadProc(Uint32 WorkerId);
+    bool PopTask(Uint32 WorkerId, TaskType& Task);
+
+    struct WorkerQueue
+    {
+        std::mutex           Mtx;
+        std::deque<TaskType> Tasks;
+    };
+    std::vector<std::unique_ptr<WorkerQueue>> m_Queues;
+    std::vector<std::thread>                  m_Threads;
+
+    std::mutex              m_Mtx;
+    std::condition_variable m_WakeUpCV;
+    std::condition_variable m_IdleCV;
+    bool                    m_Stop = false;
+
+    // The number of tasks in all queues. This value may be temporarily greater
+    // than the actual number of tasks while a new task is being added.
+    std::atomic<Int32> m_NumQueuedTasks{0};
+    // The number of tasks that have been enqueued, but have not completed yet.
+    std::atomic<Uint32> m_NumPendingTasks{0};
+    std::atomic<Uint32> m_NextQueue{0};
+};
+
+} // namespace Diligent
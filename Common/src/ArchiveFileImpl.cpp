@@ -26,9 +26,110 @@
 
 #include "ArchiveFileImpl.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#if DILIGENT_ARCHIVE_FILE_POSIX
+#    include <cerrno>
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include "DataBlobImpl.hpp"
+
 namespace Diligent
 {
 
+namespace
+{
+
+/// Read-only data blob that references a range of the memory-mapped archive file.
+class MappedArchiveDataBlob final : public ObjectBase<IDataBlob>
+{
+public:
+    using TBase = ObjectBase<IDataBlob>;
+
+    MappedArchiveDataBlob(IReferenceCounters* pRefCounters, IArchive* pArchive, const void* pData, size_t Size) :
+        TBase{pRefCounters},
+        m_pArchive{pArchive},
+        m_pData{pData},
+        m_Size{Size}
+    {}
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DataBlob, TBase)
+
+    virtual void DILIGENT_CALL_TYPE Resize(size_t /*NewSize*/) override final
+    {
+        UNEXPECTED("Mapped archive data blob can't be resized");
+    }
+
+    virtual size_t DILIGENT_CALL_TYPE GetSize() const override final
+    {
+        return m_Size;
+    }
+
+    virtual void* DILIGENT_CALL_TYPE GetDataPtr() override final
+    {
+        // The mapping is read-only: the returned memory must not be written to
+        return const_cast<void*>(m_pData);
+    }
+
+    virtual const void* DILIGENT_CALL_TYPE GetConstDataPtr() const override final
+    {
+        return m_pData;
+    }
+
+private:
+    // Keep the archive and thus the mapping alive
+    RefCntAutoPtr<IArchive> m_pArchive;
+
+    const void* const m_pData;
+    const size_t      m_Size;
+};
+
+} // namespace
+
+#if DILIGENT_ARCHIVE_FILE_POSIX
+
+ArchiveFileImpl::ArchiveFileImpl(IReferenceCounters* pRefCounters, const Char* Path) :
+    TObjectBase{pRefCounters},
+    m_FD{open(Path, O_RDONLY | O_CLOEXEC)}
+{
+    if (m_FD < 0)
+        LOG_ERROR_AND_THROW("Failed to open file '", Path, "'");
+
+    struct stat FileStat;
+    if (fstat(m_FD, &FileStat) != 0)
+    {
+        close(m_FD);
+        LOG_ERROR_AND_THROW("Failed to query the size of file '", Path, "'");
+    }
+    m_FileSize = static_cast<Uint64>(FileStat.st_size);
+
+    if (m_FileSize > 0 && m_FileSize <= std::numeric_limits<size_t>::max())
+    {
+        void* pMapping = mmap(nullptr, static_cast<size_t>(m_FileSize), PROT_READ, MAP_SHARED, m_FD, 0);
+        if (pMapping != MAP_FAILED)
+            m_pMappedData = static_cast<const Uint8*>(pMapping);
+        else
+            LOG_WARNING_MESSAGE("Failed to map file '", Path, "' into memory. Positional reads will be used instead.");
+    }
+}
+
+ArchiveFileImpl::~ArchiveFileImpl()
+{
+    if (m_pMappedData != nullptr)
+        munmap(const_cast<Uint8*>(m_pMappedData), static_cast<size_t>(m_FileSize));
+
+    if (m_FD >= 0)
+        close(m_FD);
+}
+
+#else
+
 ArchiveFileImpl::ArchiveFileImpl(IReferenceCounters* pRefCounters, const Char* Path) :
     TObjectBase{pRefCounters},
     m_File{Path, EFileAccessMode::Read},
@@ -38,6 +139,12 @@ ArchiveFileImpl::ArchiveFileImpl(IReferenceCounters* pRefCounters, const Char* P
         LOG_ERROR_AND_THROW("Failed to open file '", Path, "'");
 }
 
+ArchiveFileImpl::~ArchiveFileImpl()
+{
+}
+
+#endif
+
 Bool ArchiveFileImpl::Read(Uint64 Offset, Uint64 Size, void* pData)
 {
     if (Size == 0)
@@ -48,13 +155,55 @@ Bool ArchiveFileImpl::Read(Uint64 Offset, Uint64 Size, void* pData)
 
     DEV_CHECK_ERR(pData != nullptr, "pData must not be null");
 
+    const auto RemainingSize = m_FileSize - Offset;
+    const auto ReadSize      = StaticCast<size_t>(std::min(Size, RemainingSize));
+
+    if (m_pMappedData != nullptr)
+    {
+        std::memcpy(pData, m_pMappedData + Offset, ReadSize);
+        return Size <= RemainingSize;
+    }
+
+#if DILIGENT_ARCHIVE_FILE_POSIX
+    // pread does not modify the file position, so concurrent reads don't need synchronization
+    auto*  pDst      = static_cast<Uint8*>(pData);
+    size_t BytesRead = 0;
+    while (BytesRead < ReadSize)
+    {
+        const auto Res = pread(m_FD, pDst + BytesRead, ReadSize - BytesRead, static_cast<off_t>(Offset + BytesRead));
+        if (Res < 0 && errno == EINTR)
+            continue;
+        if (Res <= 0)
+            return False;
+        BytesRead += static_cast<size_t>(Res);
+    }
+    return Size <= RemainingSize;
+#else
     std::unique_lock<std::mutex> Lock{m_Mtx};
 
     if (!m_File->SetPos(StaticCast<size_t>(Offset), FilePosOrigin::Start))
         return False;
 
-    const auto RemainingSize = m_FileSize - Offset;
-    return m_File->Read(pData, StaticCast<size_t>(std::min(Size, RemainingSize))) && Size <= RemainingSize;
+    return m_File->Read(pData, ReadSize) && Size <= RemainingSize;
+#endif
+}
+
+RefCntAutoPtr<IDataBlob> ArchiveFileImpl::Map(Uint64 Offset, Uint64 Size)
+{
+    if (Offset > m_FileSize || Size > m_FileSize - Offset)
+        return {};
+
+    if (m_pMappedData != nullptr)
+    {
+        return RefCntAutoPtr<IDataBlob>{
+            MakeNewRCObj<MappedArchiveDataBlob>()(this, m_pMappedData + Offset, StaticCast<size_t>(Size))};
+    }
+
+    auto pDataBlob = DataBlobImpl::Create(StaticCast<size_t>(Size));
+    if (!Read(Offset, Size, pDataBlob->GetDataPtr()))
+        return {};
+
+    return RefCntAutoPtr<IDataBlob>{pDataBlob};
 }
 
 RefCntAutoPtr<IArchive> ArchiveFileImpl::Create(const Char* Path)
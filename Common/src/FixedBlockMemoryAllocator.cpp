@@ -27,49 +27,273 @@
 
 #include "pch.h"
 #include <algorithm>
+#include <atomic>
+#include <thread>
 #include "FixedBlockMemoryAllocator.hpp"
 #include "Align.hpp"
 
 namespace Diligent
 {
 
+struct FixedBlockMemoryAllocator::MemoryPage
+{
+    FixedBlockMemoryAllocator* pOwner = nullptr;
+
+    MemoryPage* pPrevAvailable = nullptr;
+    MemoryPage* pNextAvailable = nullptr;
+
+    void*  pNextFreeBlock       = nullptr; // Next free block
+    Uint32 NumFreeBlocks        = 0;       // Num of remaining blocks
+    Uint32 NumInitializedBlocks = 0;       // Num of initialized blocks
+    size_t PageIdx              = 0;       // Index of this page in m_Pages
+    bool   IsAvailable          = false;   // Whether the page is in the available pages list
+
+    bool HasSpace() const { return NumFreeBlocks > 0; }
+};
+
 static size_t AdjustBlockSize(size_t BlockSize)
 {
     return AlignUp(std::max(BlockSize, size_t{1}), sizeof(void*));
 }
 
+// The block prefix stores the pointer to the owning page. We make the prefix as large
+// as the block alignment so that the blocks keep the same alignment as without the prefix.
+static size_t GetBlockPrefixSize(size_t BlockSize)
+{
+    return (BlockSize % 16 == 0) ? 16 : sizeof(void*);
+}
+
+static size_t GetNumThreadCaches(Uint32 ThreadCacheSize)
+{
+    return ThreadCacheSize > 0 ? std::max(std::thread::hardware_concurrency(), 1u) : 0;
+}
+
 FixedBlockMemoryAllocator::FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator,
                                                      size_t            BlockSize,
-                                                     Uint32            NumBlocksInPage) :
+                                                     Uint32            NumBlocksInPage,
+                                                     Uint32            MaxEmptyPages,
+                                                     Uint32            ThreadCacheSize) :
     // clang-format off
-    m_PagePool          (STD_ALLOCATOR_RAW_MEM(MemoryPage, RawMemoryAllocator, "Allocator for vector<MemoryPage>")),
-    m_AvailablePages    (STD_ALLOCATOR_RAW_MEM(size_t, RawMemoryAllocator, "Allocator for unordered_set<size_t>") ),
-    m_AddrToPageId      (STD_ALLOCATOR_RAW_MEM(AddrToPageIdMapElem, RawMemoryAllocator, "Allocator for unordered_map<void*, size_t>")),
-    m_RawMemoryAllocator{RawMemoryAllocator        },
-    m_BlockSize         {AdjustBlockSize(BlockSize)},
-    m_NumBlocksInPage   {NumBlocksInPage           }
+    m_Pages             (STD_ALLOCATOR_RAW_MEM(MemoryPage*, RawMemoryAllocator, "Allocator for vector<MemoryPage*>")),
+    m_ThreadCaches      (GetNumThreadCaches(ThreadCacheSize), STD_ALLOCATOR_RAW_MEM(ThreadCache, RawMemoryAllocator, "Allocator for vector<ThreadCache>")),
+    m_RawMemoryAllocator{RawMemoryAllocator                          },
+    m_BlockSize         {AdjustBlockSize(BlockSize)                  },
+    m_BlockPrefixSize   {GetBlockPrefixSize(m_BlockSize)             },
+    m_BlockStride       {m_BlockSize + m_BlockPrefixSize             },
+    m_PageHeaderSize    {AlignUp(sizeof(MemoryPage), size_t{16})     },
+    m_NumBlocksInPage   {std::max(NumBlocksInPage, Uint32{1})        },
+    m_MaxEmptyPages     {MaxEmptyPages                               },
+    m_ThreadCacheSize   {ThreadCacheSize                             }
 // clang-format on
 {
     // Allocate one page
+    std::lock_guard<std::mutex> LockGuard{m_Mutex};
     CreateNewPage();
 }
 
 FixedBlockMemoryAllocator::~FixedBlockMemoryAllocator()
 {
-#ifdef DILIGENT_DEBUG
-    for (size_t p = 0; p < m_PagePool.size(); ++p)
+    FlushThreadCaches();
+
+    for (auto* pPage : m_Pages)
     {
-        VERIFY(!m_PagePool[p].HasAllocations(), "Memory leak detected: memory page has allocated block");
-        VERIFY(m_AvailablePages.find(p) != m_AvailablePages.end(), "Memory page is not in the available page pool");
+        VERIFY(pPage->NumFreeBlocks == m_NumBlocksInPage, "Memory leak detected: memory page has allocated block");
+        VERIFY(pPage->IsAvailable, "Memory page is not in the available page list");
+        pPage->~MemoryPage();
+        m_RawMemoryAllocator.Free(pPage);
     }
+}
+
+size_t FixedBlockMemoryAllocator::GetNumPages() const
+{
+    std::lock_guard<std::mutex> LockGuard{m_Mutex};
+    return m_Pages.size();
+}
+
+void* FixedBlockMemoryAllocator::GetBlockAddress(MemoryPage* pPage, Uint32 BlockIndex) const
+{
+    VERIFY(BlockIndex < m_NumBlocksInPage, "Invalid block index");
+    return reinterpret_cast<Uint8*>(pPage) + m_PageHeaderSize + BlockIndex * m_BlockStride + m_BlockPrefixSize;
+}
+
+#ifdef DILIGENT_DEBUG
+void FixedBlockMemoryAllocator::dbgVerifyAddress(const MemoryPage* pPage, const void* pBlockAddr) const
+{
+    VERIFY(pPage->pOwner == this, "The block was not allocated by this allocator");
+    const auto* pFirstBlock = reinterpret_cast<const Uint8*>(pPage) + m_PageHeaderSize + m_BlockPrefixSize;
+    size_t      Delta       = reinterpret_cast<const Uint8*>(pBlockAddr) - pFirstBlock;
+    VERIFY(Delta % m_BlockStride == 0, "Invalid address");
+    Uint32 BlockIndex = static_cast<Uint32>(Delta / m_BlockStride);
+    VERIFY(BlockIndex < m_NumBlocksInPage, "Invalid block index");
+}
+#else
+#    define dbgVerifyAddress(...)
 #endif
+
+FixedBlockMemoryAllocator::MemoryPage* FixedBlockMemoryAllocator::CreateNewPage()
+{
+    const auto PageSize = m_PageHeaderSize + m_BlockStride * m_NumBlocksInPage;
+
+    auto* pRawMem = m_RawMemoryAllocator.Allocate(PageSize, "FixedBlockMemoryAllocator page", __FILE__, __LINE__);
+    FillWithDebugPattern(pRawMem, NewPageMemPattern, PageSize);
+
+    auto* pPage           = new (pRawMem) MemoryPage{};
+    pPage->pOwner         = this;
+    pPage->pNextFreeBlock = GetBlockAddress(pPage, 0);
+    pPage->NumFreeBlocks  = m_NumBlocksInPage;
+    pPage->PageIdx        = m_Pages.size();
+    m_Pages.push_back(pPage);
+    AddAvailablePage(pPage);
+    ++m_NumEmptyPages;
+
+    return pPage;
+}
+
+void FixedBlockMemoryAllocator::ReleasePage(MemoryPage* pPage)
+{
+    VERIFY_EXPR(pPage->NumFreeBlocks == m_NumBlocksInPage);
+    VERIFY_EXPR(m_NumEmptyPages > 0);
+
+    RemoveAvailablePage(pPage);
+
+    // Move the last page into the slot of the released one
+    VERIFY_EXPR(m_Pages[pPage->PageIdx] == pPage);
+    m_Pages[pPage->PageIdx]          = m_Pages.back();
+    m_Pages[pPage->PageIdx]->PageIdx = pPage->PageIdx;
+    m_Pages.pop_back();
+    --m_NumEmptyPages;
+
+    pPage->~MemoryPage();
+    m_RawMemoryAllocator.Free(pPage);
+}
+
+void FixedBlockMemoryAllocator::AddAvailablePage(MemoryPage* pPage)
+{
+    VERIFY_EXPR(!pPage->IsAvailable);
+    pPage->pPrevAvailable = nullptr;
+    pPage->pNextAvailable = m_pAvailablePages;
+    if (m_pAvailablePages != nullptr)
+        m_pAvailablePages->pPrevAvailable = pPage;
+    m_pAvailablePages  = pPage;
+    pPage->IsAvailable = true;
+}
+
+void FixedBlockMemoryAllocator::RemoveAvailablePage(MemoryPage* pPage)
+{
+    VERIFY_EXPR(pPage->IsAvailable);
+    if (pPage->pPrevAvailable != nullptr)
+        pPage->pPrevAvailable->pNextAvailable = pPage->pNextAvailable;
+    else
+        m_pAvailablePages = pPage->pNextAvailable;
+    if (pPage->pNextAvailable != nullptr)
+        pPage->pNextAvailable->pPrevAvailable = pPage->pPrevAvailable;
+    pPage->pPrevAvailable = nullptr;
+    pPage->pNextAvailable = nullptr;
+    pPage->IsAvailable    = false;
+}
+
+void* FixedBlockMemoryAllocator::AllocateFromPages()
+{
+    auto* pPage = m_pAvailablePages != nullptr ? m_pAvailablePages : CreateNewPage();
+    VERIFY_EXPR(pPage->HasSpace());
+
+    if (pPage->NumFreeBlocks == m_NumBlocksInPage)
+    {
+        VERIFY_EXPR(m_NumEmptyPages > 0);
+        --m_NumEmptyPages;
+    }
+
+    // Initialize the next block
+    if (pPage->NumInitializedBlocks < m_NumBlocksInPage)
+    {
+        // Link next uninitialized block to the end of the list:
+
+        //
+        //                            ___________                      ___________
+        //                           |           |                    |           |
+        //                           | 0xcdcdcd  |                 -->| 0xcdcdcd  |   m_NumInitializedBlocks
+        //                           |-----------|                |   |-----------|
+        //                           |           |                |   |           |
+        //  m_NumInitializedBlocks   | 0xcdcdcd  |      ==>        ---|           |
+        //                           |-----------|                    |-----------|
+        //
+        //                           ~           ~                    ~           ~
+        //                           |           |                    |           |
+        //                       0   |           |                    |           |
+        //                            -----------                      -----------
+        //
+        auto* pUninitializedBlock = GetBlockAddress(pPage, pPage->NumInitializedBlocks);
+        FillWithDebugPattern(pUninitializedBlock, InitializedBlockMemPattern, m_BlockSize);
+        reinterpret_cast<MemoryPage**>(pUninitializedBlock)[-1] = pPage;
+        ++pPage->NumInitializedBlocks;
+        if (pPage->NumInitializedBlocks < m_NumBlocksInPage)
+            GetNextFreeBlock(pUninitializedBlock) = GetBlockAddress(pPage, pPage->NumInitializedBlocks);
+        else
+            GetNextFreeBlock(pUninitializedBlock) = nullptr;
+    }
+
+    void* res = pPage->pNextFreeBlock;
+    dbgVerifyAddress(pPage, res);
+    // Move pointer to the next free block
+    pPage->pNextFreeBlock = GetNextFreeBlock(res);
+    --pPage->NumFreeBlocks;
+    if (pPage->NumFreeBlocks != 0)
+        dbgVerifyAddress(pPage, pPage->pNextFreeBlock);
+    else
+    {
+        VERIFY_EXPR(pPage->pNextFreeBlock == nullptr);
+        RemoveAvailablePage(pPage);
+    }
+
+    return res;
+}
+
+void FixedBlockMemoryAllocator::ReturnToPage(void* Ptr)
+{
+    auto* pPage = GetBlockPage(Ptr);
+    dbgVerifyAddress(pPage, Ptr);
+    VERIFY(pPage->NumFreeBlocks < m_NumBlocksInPage, "The page has no allocations - double freeing memory?");
+
+    FillWithDebugPattern(Ptr, DeallocatedBlockMemPattern, m_BlockSize);
+    // Add block to the beginning of the linked list
+    GetNextFreeBlock(Ptr) = pPage->pNextFreeBlock;
+    pPage->pNextFreeBlock = Ptr;
+    ++pPage->NumFreeBlocks;
+
+    if (!pPage->IsAvailable)
+        AddAvailablePage(pPage);
+
+    if (pPage->NumFreeBlocks == m_NumBlocksInPage)
+    {
+        ++m_NumEmptyPages;
+        if (m_NumEmptyPages > m_MaxEmptyPages)
+            ReleasePage(pPage);
+    }
+}
+
+FixedBlockMemoryAllocator::ThreadCache& FixedBlockMemoryAllocator::GetThreadCache()
+{
+    // Threads are assigned cache slots in round-robin order, so that as long as
+    // the number of threads does not exceed the number of caches, every thread has its own cache.
+    static std::atomic<Uint32>     NumThreads{0};
+    static thread_local const auto ThreadId = NumThreads.fetch_add(1);
+    return m_ThreadCaches[ThreadId % m_ThreadCaches.size()];
 }
 
-void FixedBlockMemoryAllocator::CreateNewPage()
+void FixedBlockMemoryAllocator::FlushThreadCaches()
 {
-    m_PagePool.emplace_back(*this);
-    m_AvailablePages.insert(m_PagePool.size() - 1);
-    m_AddrToPageId.reserve(m_PagePool.size() * m_NumBlocksInPage);
+    std::lock_guard<std::mutex> LockGuard{m_Mutex};
+    for (auto& Cache : m_ThreadCaches)
+    {
+        ThreadingTools::LockHelper CacheLock{Cache.Lock};
+        while (Cache.pHead != nullptr)
+        {
+            auto* pNext = GetNextFreeBlock(Cache.pHead);
+            ReturnToPage(Cache.pHead);
+            Cache.pHead = pNext;
+        }
+        Cache.NumBlocks = 0;
+    }
 }
 
 void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
@@ -79,48 +303,107 @@ void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescriptio
     Size = AdjustBlockSize(Size);
     VERIFY(m_BlockSize == Size, "Requested size (", Size, ") does not match the block size (", m_BlockSize, ")");
 
-    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+    if (m_ThreadCacheSize == 0)
+    {
+        std::lock_guard<std::mutex> LockGuard{m_Mutex};
+
+        auto* Ptr = AllocateFromPages();
+        FillWithDebugPattern(Ptr, AllocatedBlockMemPattern, m_BlockSize);
+        return Ptr;
+    }
+
+    auto& Cache = GetThreadCache();
+    {
+        ThreadingTools::LockHelper CacheLock{Cache.Lock};
+        if (Cache.pHead != nullptr)
+        {
+            auto* Ptr   = Cache.pHead;
+            Cache.pHead = GetNextFreeBlock(Ptr);
+            --Cache.NumBlocks;
+            FillWithDebugPattern(Ptr, AllocatedBlockMemPattern, m_BlockSize);
+            return Ptr;
+        }
+    }
 
-    if (m_AvailablePages.empty())
+    // The cache is empty - refill half of it from the pages
+    void*  Ptr            = nullptr;
+    void*  pBatchHead     = nullptr;
+    void*  pBatchTail     = nullptr;
+    Uint32 NumBatchBlocks = 0;
     {
-        CreateNewPage();
+        std::lock_guard<std::mutex> LockGuard{m_Mutex};
+
+        Ptr = AllocateFromPages();
+        for (; NumBatchBlocks < m_ThreadCacheSize / 2; ++NumBatchBlocks)
+        {
+            auto* pBlock = AllocateFromPages();
+            FillWithDebugPattern(pBlock, DeallocatedBlockMemPattern, m_BlockSize);
+            GetNextFreeBlock(pBlock) = pBatchHead;
+            pBatchHead               = pBlock;
+            if (pBatchTail == nullptr)
+                pBatchTail = pBlock;
+        }
     }
 
-    auto  PageId = *m_AvailablePages.begin();
-    auto& Page   = m_PagePool[PageId];
-    auto* Ptr    = Page.Allocate();
-    m_AddrToPageId.insert(std::make_pair(Ptr, PageId));
-    if (!Page.HasSpace())
+    if (pBatchHead != nullptr)
     {
-        m_AvailablePages.erase(m_AvailablePages.begin());
+        ThreadingTools::LockHelper CacheLock{Cache.Lock};
+        GetNextFreeBlock(pBatchTail) = Cache.pHead;
+        Cache.pHead                  = pBatchHead;
+        Cache.NumBlocks += NumBatchBlocks;
     }
 
+    FillWithDebugPattern(Ptr, AllocatedBlockMemPattern, m_BlockSize);
     return Ptr;
 }
 
 void FixedBlockMemoryAllocator::Free(void* Ptr)
 {
-    std::lock_guard<std::mutex> LockGuard(m_Mutex);
-    auto                        PageIdIt = m_AddrToPageId.find(Ptr);
-    if (PageIdIt != m_AddrToPageId.end())
+    if (Ptr == nullptr)
     {
-        auto PageId = PageIdIt->second;
-        VERIFY_EXPR(PageId >= 0 && PageId < m_PagePool.size());
-        m_PagePool[PageId].DeAllocate(Ptr);
-        m_AvailablePages.insert(PageId);
-        m_AddrToPageId.erase(PageIdIt);
-        if (m_AvailablePages.size() > 1 && !m_PagePool[PageId].HasAllocations())
-        {
-            // In current implementation pages are never released!
-            // Note that if we delete a page, all indices past it will be invalid
+        UNEXPECTED("Attempting to free null pointer");
+        return;
+    }
 
-            //m_PagePool.erase(m_PagePool.begin() + PageId);
-            //m_AvailablePages.erase(PageId);
-        }
+    if (m_ThreadCacheSize == 0)
+    {
+        std::lock_guard<std::mutex> LockGuard{m_Mutex};
+        ReturnToPage(Ptr);
+        return;
     }
-    else
+
+    dbgVerifyAddress(GetBlockPage(Ptr), Ptr);
+
+    void* pEvicted = nullptr;
+    {
+        auto&                      Cache = GetThreadCache();
+        ThreadingTools::LockHelper CacheLock{Cache.Lock};
+
+        FillWithDebugPattern(Ptr, DeallocatedBlockMemPattern, m_BlockSize);
+        GetNextFreeBlock(Ptr) = Cache.pHead;
+        Cache.pHead           = Ptr;
+        ++Cache.NumBlocks;
+        if (Cache.NumBlocks <= m_ThreadCacheSize)
+            return;
+
+        // The cache is full - keep the most recently released half of the blocks
+        // and return the rest to the pages.
+        const auto NumBlocksToKeep = std::max(m_ThreadCacheSize / 2, 1u);
+
+        auto* pLastKept = Cache.pHead;
+        for (Uint32 i = 1; i < NumBlocksToKeep; ++i)
+            pLastKept = GetNextFreeBlock(pLastKept);
+        pEvicted                    = GetNextFreeBlock(pLastKept);
+        GetNextFreeBlock(pLastKept) = nullptr;
+        Cache.NumBlocks             = NumBlocksToKeep;
+    }
+
+    std::lock_guard<std::mutex> LockGuard{m_Mutex};
+    while (pEvicted != nullptr)
     {
-        UNEXPECTED("Address not found in the allocations list - double freeing memory?");
+        auto* pNext = GetNextFreeBlock(pEvicted);
+        ReturnToPage(pEvicted);
+        pEvicted = pNext;
     }
 }
 
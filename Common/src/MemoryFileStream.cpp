@@ -29,18 +29,35 @@
 #include "pch.h"
 
 #include "MemoryFileStream.hpp"
+#include "DataBlobImpl.hpp"
 
 namespace Diligent
 {
 
 MemoryFileStream::MemoryFileStream(IReferenceCounters* pRefCounters,
-                                   IDataBlob*          pData) :
+                                   IDataBlob*          pData,
+                                   bool                ReadOnly) :
     TBase{pRefCounters},
-    m_DataBlob{pData}
+    m_DataBlob{pData},
+    m_ReadOnly{ReadOnly}
 {
 }
 
-IMPLEMENT_QUERY_INTERFACE(MemoryFileStream, IID_FileStream, TBase)
+void MemoryFileStream::QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface)
+{
+    if (ppInterface == nullptr)
+        return;
+
+    if (IID == IID_MemoryFileStream || IID == IID_FileStream)
+    {
+        *ppInterface = this;
+        (*ppInterface)->AddRef();
+    }
+    else
+    {
+        TBase::QueryInterface(IID, ppInterface);
+    }
+}
 
 bool MemoryFileStream::Read(void* Data, size_t Size)
 {
@@ -64,6 +81,12 @@ void MemoryFileStream::ReadBlob(IDataBlob* pData)
 
 bool MemoryFileStream::Write(const void* Data, size_t Size)
 {
+    if (m_ReadOnly)
+    {
+        DEV_ERROR("Writing to a read-only memory stream");
+        return false;
+    }
+
     if (m_CurrentOffset + Size > m_DataBlob->GetSize())
     {
         m_DataBlob->Resize(m_CurrentOffset + Size);
@@ -84,4 +107,21 @@ size_t MemoryFileStream::GetSize()
     return m_DataBlob->GetSize();
 }
 
+RefCntAutoPtr<IDataBlob> ReadStreamBlob(IFileStream* pStream)
+{
+    VERIFY_EXPR(pStream != nullptr);
+
+    RefCntAutoPtr<MemoryFileStream> pMemStream{pStream, IID_MemoryFileStream};
+    if (pMemStream && pMemStream->m_ReadOnly && pMemStream->m_CurrentOffset == 0)
+    {
+        // The data can't be modified through the stream, so the blob can be shared
+        pMemStream->m_CurrentOffset = pMemStream->m_DataBlob->GetSize();
+        return pMemStream->m_DataBlob;
+    }
+
+    RefCntAutoPtr<IDataBlob> pData{MakeNewRCObj<DataBlobImpl>()(0)};
+    pStream->ReadBlob(pData);
+    return pData;
+}
+
 } // namespace Diligent
@@ -0,0 +1,166 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include <algorithm>
+
+#include "ThreadPool.hpp"
+#include "../../Platforms/Basic/interface/DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// The pool the current thread is a worker of, and the worker index
+thread_local const ThreadPool* tls_pWorkerPool = nullptr;
+thread_local Uint32            tls_WorkerId    = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(Uint32 NumThreads)
+{
+    VERIFY(NumThreads > 0, "The number of threads must not be zero");
+    NumThreads = std::max(NumThreads, 1u);
+
+    m_Queues.reserve(NumThreads);
+    for (Uint32 i = 0; i < NumThreads; ++i)
+        m_Queues.emplace_back(new WorkerQueue);
+
+    m_Threads.reserve(NumThreads);
+    for (Uint32 i = 0; i < NumThreads; ++i)
+        m_Threads.emplace_back(&ThreadPool::WorkerThreadProc, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_Stop = true;
+    }
+    m_WakeUpCV.notify_all();
+
+    for (auto& Thread : m_Threads)
+        Thread.join();
+
+    VERIFY_EXPR(m_NumPendingTasks.load() == 0);
+}
+
+std::future<void> ThreadPool::Enqueue(TaskType Task)
+{
+    VERIFY(Task, "Task must not be empty");
+
+    // std::function requires the callable to be copyable, so the packaged task is shared
+    auto pPackagedTask = std::make_shared<std::packaged_task<void()>>(std::move(Task));
+    auto Future        = pPackagedTask->get_future();
+
+    // Tasks enqueued by a worker go to its own queue as the worker is likely to execute them soon
+    const size_t QueueIdx = tls_pWorkerPool == this ?
+        tls_WorkerId :
+        m_NextQueue.fetch_add(1) % m_Queues.size();
+
+    m_NumPendingTasks.fetch_add(1);
+    // Increment the counter before the task is added to make sure it never goes negative
+    m_NumQueuedTasks.fetch_add(1);
+    {
+        auto& Queue = *m_Queues[QueueIdx];
+
+        std::lock_guard<std::mutex> Lock{Queue.Mtx};
+        Queue.Tasks.emplace_back([pPackagedTask]() { (*pPackagedTask)(); });
+    }
+
+    {
+        // A worker checks the counter while holding the mutex, so acquiring the mutex here
+        // guarantees that the worker either sees the new task or receives the notification.
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+    }
+    m_WakeUpCV.notify_one();
+
+    return Future;
+}
+
+void ThreadPool::WaitForAllTasks()
+{
+    VERIFY(tls_pWorkerPool != this, "Waiting for all tasks from a worker thread will result in a deadlock");
+
+    std::unique_lock<std::mutex> Lock{m_Mtx};
+    m_IdleCV.wait(Lock, [this]() { return m_NumPendingTasks.load() == 0; });
+}
+
+bool ThreadPool::PopTask(Uint32 WorkerId, TaskType& Task)
+{
+    // Start with the worker's own queue and then try to steal from the others
+    const auto NumQueues = m_Queues.size();
+    for (size_t i = 0; i < NumQueues; ++i)
+    {
+        auto& Queue = *m_Queues[(WorkerId + i) % NumQueues];
+
+        std::lock_guard<std::mutex> Lock{Queue.Mtx};
+        if (Queue.Tasks.empty())
+            continue;
+
+        Task = std::move(Queue.Tasks.front());
+        Queue.Tasks.pop_front();
+        m_NumQueuedTasks.fetch_sub(1);
+        return true;
+    }
+
+    return false;
+}
+
+void ThreadPool::WorkerThreadProc(Uint32 WorkerId)
+{
+    tls_pWorkerPool = this;
+    tls_WorkerId    = WorkerId;
+
+    for (;;)
+    {
+        TaskType Task;
+        if (PopTask(WorkerId, Task))
+        {
+            Task();
+            if (m_NumPendingTasks.fetch_sub(1) == 1)
+            {
+                std::lock_guard<std::mutex> Lock{m_Mtx};
+                m_IdleCV.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> Lock{m_Mtx};
+        m_WakeUpCV.wait(Lock, [this]() { return m_Stop || m_NumQueuedTasks.load() > 0; });
+        // Execute all remaining tasks before exiting
+        if (m_Stop && m_NumQueuedTasks.load() == 0)
+            break;
+    }
+
+    tls_pWorkerPool = nullptr;
+}
+
+} // namespace Diligent
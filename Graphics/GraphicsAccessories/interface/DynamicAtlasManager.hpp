@@ -31,7 +31,8 @@
 /// \file
 /// Declaration of DynamicAtlasManager class
 
-#include <map>
+#include <vector>
+#include <algorithm>
 #include <unordered_map>
 
 #include "../../../Primitives/interface/BasicTypes.h"
@@ -223,10 +224,66 @@ private:
     void RegisterNode(Node& N);
     void UnregisterNode(const Node& N);
 
+    // Flat array of free regions kept sorted by CompareType.
+    // The number of free regions is typically small, so a binary search followed by
+    // a linear scan over contiguous memory is considerably faster than walking tree nodes.
+    template <typename CompareType>
+    class FreeRegionIndex
+    {
+    public:
+        struct Entry
+        {
+            Region R;
+            Node*  pNode = nullptr;
+        };
+        using ConstIterator = typename std::vector<Entry>::const_iterator;
+
+        void Insert(const Region& R, Node* pNode)
+        {
+            auto it = LowerBound(R);
+            VERIFY(it == m_Entries.end() || it->R != R, "Region is already present in the index");
+            m_Entries.insert(it, Entry{R, pNode});
+        }
+
+        void Erase(const Region& R)
+        {
+            auto it = LowerBound(R);
+            if (it != m_Entries.end() && it->R == R)
+                m_Entries.erase(it);
+            else
+                UNEXPECTED("Region is not found in the index");
+        }
+
+        bool Contains(const Region& R) const
+        {
+            auto it = LowerBound(R);
+            return it != m_Entries.end() && it->R == R;
+        }
+
+        // Returns the first entry that is not less than R
+        ConstIterator LowerBound(const Region& R) const
+        {
+            return std::lower_bound(m_Entries.begin(), m_Entries.end(), R,
+                                    [](const Entry& E, const Region& R) //
+                                    {
+                                        return CompareType{}(E.R, R);
+                                    });
+        }
+
+        ConstIterator begin() const { return m_Entries.begin(); }
+        ConstIterator end() const { return m_Entries.end(); }
+
+        size_t size() const { return m_Entries.size(); }
+        bool   empty() const { return m_Entries.empty(); }
+
+    private:
+        std::vector<Entry> m_Entries;
+    };
+
     // Free regions ordered by width->height->x->y
-    std::map<Region, Node*, WidthFirstCompare> m_FreeRegionsByWidth;
+    FreeRegionIndex<WidthFirstCompare> m_FreeRegionsByWidth;
     // Free regions ordered by height->width->y->x
-    std::map<Region, Node*, HeightFirstCompare> m_FreeRegionsByHeight;
+    FreeRegionIndex<HeightFirstCompare> m_FreeRegionsByHeight;
     // Allocated regions
     std::unordered_map<Region, Node*, Region::Hasher> m_AllocatedRegions;
 };
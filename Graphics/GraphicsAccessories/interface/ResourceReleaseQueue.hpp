@@ -34,10 +34,12 @@
 /// Implementation of Diligent::ResourceReleaseQueue class
 
 #include <mutex>
-#include <deque>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <new>
 
 #include "../../../Primitives/interface/MemoryAllocator.h"
-#include "../../../Common/interface/STDAllocator.hpp"
 #include "../../../Platforms/interface/Atomics.hpp"
 #include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
 
@@ -207,6 +209,34 @@ private:
     ResourceType m_StaleResource;
 };
 
+/// Resource release queue statistics, see Diligent::ResourceReleaseQueue::GetStats().
+struct ResourceReleaseQueueStats
+{
+    /// The number of resources waiting for the command list they were released with to be submitted.
+    size_t NumStaleResources = 0;
+
+    /// The number of resources waiting for the GPU to reach their fence value.
+    size_t NumPendingResources = 0;
+
+    /// The maximum total number of stale and pending resources observed.
+    size_t MaxQueueDepth = 0;
+
+    /// The total number of resources destroyed by Purge().
+    Uint64 NumReleasedResources = 0;
+
+    /// The number of Purge() calls that destroyed at least one resource.
+    Uint64 NumPurges = 0;
+
+    /// The time, in seconds, spent destroying resources by the last Purge() call that destroyed at least one resource.
+    double LastPurgeTime = 0;
+
+    /// The maximum time, in seconds, spent destroying resources by a single Purge() call.
+    double MaxPurgeTime = 0;
+
+    /// The total time, in seconds, spent destroying resources by all Purge() calls.
+    double TotalPurgeTime = 0;
+};
+
 /// Facilitates safe resource destruction in D3D12 and Vulkan
 
 /// Resource destruction is a two-stage process:
@@ -216,24 +246,38 @@ private:
 ///   the command list
 /// * Resources are removed and actually destroyed from the queue when fence is signaled and the queue is Purged
 ///
+/// SafeReleaseResource() and DiscardResource() never block: the resources are pushed into lock-free
+/// lists that are drained by DiscardStaleResources() and Purge(). Purge() destroys resources outside
+/// of the lock, so it may be called from a background thread without stalling threads that release
+/// resources or submit command lists.
+///
 /// \tparam ResourceWrapperType -  Type of the resource wrapper used by the release queue.
 template <typename ResourceWrapperType>
 class ResourceReleaseQueue
 {
 public:
-    // clang-format off
     ResourceReleaseQueue(IMemoryAllocator& Allocator) :
-        m_ReleaseQueue  (STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>")),
-        m_StaleResources(STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>"))
+        m_Allocator{Allocator}
     {}
-    // clang-format on
 
     ~ResourceReleaseQueue()
     {
-        DEV_CHECK_ERR(m_StaleResources.empty(), "Not all stale objects were destroyed");
-        DEV_CHECK_ERR(m_ReleaseQueue.empty(), "Release queue is not empty");
+        DEV_CHECK_ERR(GetStaleResourceCount() == 0, "Not all stale objects were destroyed");
+        DEV_CHECK_ERR(GetPendingReleaseResourceCount() == 0, "Release queue is not empty");
+
+        DestroyNodes(m_NewStaleResources.exchange(nullptr));
+        DestroyNodes(m_NewDiscardedResources.exchange(nullptr));
+        DestroyNodes(m_StaleResources.pHead);
+        DestroyNodes(m_ReleaseQueue.pHead);
     }
 
+    // clang-format off
+    ResourceReleaseQueue             (const ResourceReleaseQueue&)  = delete;
+    ResourceReleaseQueue             (      ResourceReleaseQueue&&) = delete;
+    ResourceReleaseQueue& operator = (const ResourceReleaseQueue&)  = delete;
+    ResourceReleaseQueue& operator = (      ResourceReleaseQueue&&) = delete;
+    // clang-format on
+
     /// Creates a resource wrapper for the specific resource type
     /// \param [in] Resource      - Resource to be released
     /// \param [in] NumReferences - Number of references to the resource
@@ -257,8 +301,9 @@ public:
     /// \param [in] NextCommandListNumber - Number of the command list that will be submitted to the queue next
     void SafeReleaseResource(ResourceWrapperType&& Wrapper, Uint64 NextCommandListNumber)
     {
-        std::lock_guard<std::mutex> LockGuard(m_StaleObjectsMutex);
-        m_StaleResources.emplace_back(NextCommandListNumber, std::move(Wrapper));
+        auto* pNode = CreateNode(NextCommandListNumber, std::move(Wrapper));
+        OnResourcesAdded(m_NumStaleResources, 1);
+        PushNodes(m_NewStaleResources, pNode, pNode);
     }
 
     /// Moves a copy of the resource wrapper to the stale resources queue
@@ -266,8 +311,9 @@ public:
     /// \param [in] NextCommandListNumber - Number of the command list that will be submitted to the queue next
     void SafeReleaseResource(const ResourceWrapperType& Wrapper, Uint64 NextCommandListNumber)
     {
-        std::lock_guard<std::mutex> LockGuard(m_StaleObjectsMutex);
-        m_StaleResources.emplace_back(NextCommandListNumber, Wrapper);
+        auto* pNode = CreateNode(NextCommandListNumber, Wrapper);
+        OnResourcesAdded(m_NumStaleResources, 1);
+        PushNodes(m_NewStaleResources, pNode, pNode);
     }
 
     /// Adds a resource directly to the release queue
@@ -284,8 +330,9 @@ public:
     /// \param [in] FenceValue  - Fence value indicating when the resource was used last time.
     void DiscardResource(ResourceWrapperType&& Wrapper, Uint64 FenceValue)
     {
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        m_ReleaseQueue.emplace_back(FenceValue, std::move(Wrapper));
+        auto* pNode = CreateNode(FenceValue, std::move(Wrapper));
+        OnResourcesAdded(m_NumPendingResources, 1);
+        PushNodes(m_NewDiscardedResources, pNode, pNode);
     }
 
     /// Adds a copy of the resource wrapper directly to the release queue
@@ -293,8 +340,9 @@ public:
     /// \param [in] FenceValue  - Fence value indicating when the resource was used last time.
     void DiscardResource(const ResourceWrapperType& Wrapper, Uint64 FenceValue)
     {
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        m_ReleaseQueue.emplace_back(FenceValue, Wrapper);
+        auto* pNode = CreateNode(FenceValue, Wrapper);
+        OnResourcesAdded(m_NumPendingResources, 1);
+        PushNodes(m_NewDiscardedResources, pNode, pNode);
     }
 
     /// Adds multiple resources directly to the release queue
@@ -303,11 +351,26 @@ public:
     template <typename ResourceType, typename IteratorType>
     void DiscardResources(Uint64 FenceValue, IteratorType Iterator)
     {
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        ResourceType                Resource;
+        // Build the chain locally and publish it with a single atomic operation.
+        // The nodes are pushed in reverse order, which is restored when the list is drained.
+        Node*        pFirst = nullptr;
+        Node*        pLast  = nullptr;
+        size_t       Count  = 0;
+        ResourceType Resource;
         while (Iterator(Resource))
         {
-            m_ReleaseQueue.emplace_back(FenceValue, CreateWrapper(std::move(Resource), 1));
+            auto* pNode  = CreateNode(FenceValue, CreateWrapper(std::move(Resource), 1));
+            pNode->pNext = pFirst;
+            pFirst       = pNode;
+            if (pLast == nullptr)
+                pLast = pNode;
+            ++Count;
+        }
+
+        if (pFirst != nullptr)
+        {
+            OnResourcesAdded(m_NumPendingResources, Count);
+            PushNodes(m_NewDiscardedResources, pFirst, pLast);
         }
     }
 
@@ -320,20 +383,39 @@ public:
     ///                                      is greater or equal to the fence value associated with the resource
     void DiscardStaleResources(Uint64 SubmittedCmdBuffNumber, Uint64 FenceValue)
     {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        // Resources discarded directly must precede the stale resources that get the new fence value
+        m_ReleaseQueue.Append(DrainNodes(m_NewDiscardedResources));
+        m_StaleResources.Append(DrainNodes(m_NewStaleResources));
+
         // Only discard these stale objects that were released before CmdBuffNumber
-        // was executed
-        std::lock_guard<std::mutex> StaleObjectsLock(m_StaleObjectsMutex);
-        std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        while (!m_StaleResources.empty())
+        // was executed. Resources released by different threads may arrive out of order,
+        // so the whole list is scanned.
+        size_t NumDiscarded = 0;
+        Node*  pPrev        = nullptr;
+        for (auto* pNode = m_StaleResources.pHead; pNode != nullptr;)
         {
-            auto& FirstStaleObj = m_StaleResources.front();
-            if (FirstStaleObj.first <= SubmittedCmdBuffNumber)
+            auto* pNext = pNode->pNext;
+            if (pNode->Value <= SubmittedCmdBuffNumber)
             {
-                m_ReleaseQueue.emplace_back(FenceValue, std::move(FirstStaleObj.second));
-                m_StaleResources.pop_front();
+                m_StaleResources.Remove(pNode, pPrev);
+                pNode->Value = FenceValue;
+                m_ReleaseQueue.Append(NodeList{pNode, pNode});
+                ++NumDiscarded;
             }
             else
-                break;
+            {
+                pPrev = pNode;
+            }
+            pNode = pNext;
+        }
+
+        if (NumDiscarded != 0)
+        {
+            // Increment the pending count first so that the resources are always accounted for
+            m_NumPendingResources.fetch_add(NumDiscarded);
+            m_NumStaleResources.fetch_sub(NumDiscarded);
         }
     }
 
@@ -341,41 +423,199 @@ public:
     /// Removes all objects from the release queue whose fence value is
     /// less than or equal to CompletedFenceValue
     /// \param [in] CompletedFenceValue  -  Value of the fence that has been completed by the GPU
+    ///
+    /// \remarks    The objects are destroyed after the lock has been released, so that
+    ///             other threads are not blocked while this method runs.
     void Purge(Uint64 CompletedFenceValue)
     {
-        std::lock_guard<std::mutex> LockGuard(m_ReleaseQueueMutex);
-
-        // Release all objects whose associated fence value is at most CompletedFenceValue
-        // See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
-        while (!m_ReleaseQueue.empty())
+        NodeList ReadyList;
         {
-            auto& FirstObj = m_ReleaseQueue.front();
-            if (FirstObj.first <= CompletedFenceValue)
-                m_ReleaseQueue.pop_front();
-            else
-                break;
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+
+            m_ReleaseQueue.Append(DrainNodes(m_NewDiscardedResources));
+
+            // Release all objects whose associated fence value is at most CompletedFenceValue
+            // See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
+            auto* pNode = m_ReleaseQueue.pHead;
+            while (pNode != nullptr && pNode->Value <= CompletedFenceValue)
+            {
+                ReadyList.pTail = pNode;
+                pNode           = pNode->pNext;
+            }
+            if (ReadyList.pTail != nullptr)
+            {
+                ReadyList.pHead        = m_ReleaseQueue.pHead;
+                ReadyList.pTail->pNext = nullptr;
+                m_ReleaseQueue.pHead   = pNode;
+                if (pNode == nullptr)
+                    m_ReleaseQueue.pTail = nullptr;
+            }
         }
+
+        if (ReadyList.pHead == nullptr)
+            return;
+
+        const auto   StartTime   = std::chrono::high_resolution_clock::now();
+        const size_t NumReleased = DestroyNodes(ReadyList.pHead);
+        const auto   EndTime     = std::chrono::high_resolution_clock::now();
+        const double PurgeTime   = std::chrono::duration_cast<std::chrono::duration<double>>(EndTime - StartTime).count();
+
+        m_NumPendingResources.fetch_sub(NumReleased);
+
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_PurgeStats.NumReleasedResources += NumReleased;
+        m_PurgeStats.NumPurges += 1;
+        m_PurgeStats.LastPurgeTime = PurgeTime;
+        m_PurgeStats.MaxPurgeTime  = std::max(m_PurgeStats.MaxPurgeTime, PurgeTime);
+        m_PurgeStats.TotalPurgeTime += PurgeTime;
     }
 
     /// Returns the number of stale resources
     size_t GetStaleResourceCount() const
     {
-        return m_StaleResources.size();
+        return m_NumStaleResources.load();
     }
 
     /// Returns the number of resources pending release
     size_t GetPendingReleaseResourceCount() const
     {
-        return m_ReleaseQueue.size();
+        return m_NumPendingResources.load();
+    }
+
+    /// Returns the queue statistics
+    ResourceReleaseQueueStats GetStats() const
+    {
+        ResourceReleaseQueueStats Stats;
+        {
+            std::lock_guard<std::mutex> Lock{m_Mtx};
+            Stats = m_PurgeStats;
+        }
+        Stats.NumStaleResources   = GetStaleResourceCount();
+        Stats.NumPendingResources = GetPendingReleaseResourceCount();
+        Stats.MaxQueueDepth       = m_MaxQueueDepth.load();
+        return Stats;
     }
 
 private:
-    std::mutex m_ReleaseQueueMutex;
-    using ReleaseQueueElemType = std::pair<Uint64, ResourceWrapperType>;
-    std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_ReleaseQueue;
+    struct Node
+    {
+        template <typename WrapperType>
+        Node(Uint64 _Value, WrapperType&& _Wrapper) :
+            Value{_Value},
+            Wrapper{std::forward<WrapperType>(_Wrapper)}
+        {}
+
+        // Command list number for stale resources, fence value for resources in the release queue
+        Uint64              Value;
+        ResourceWrapperType Wrapper;
+        Node*               pNext = nullptr;
+    };
+
+    // Singly-linked FIFO list
+    struct NodeList
+    {
+        Node* pHead = nullptr;
+        Node* pTail = nullptr;
+
+        void Append(const NodeList& List)
+        {
+            if (List.pHead == nullptr)
+                return;
+
+            if (pTail != nullptr)
+                pTail->pNext = List.pHead;
+            else
+                pHead = List.pHead;
+            pTail = List.pTail;
+        }
+
+        void Remove(Node* pNode, Node* pPrev)
+        {
+            if (pPrev != nullptr)
+                pPrev->pNext = pNode->pNext;
+            else
+                pHead = pNode->pNext;
+            if (pTail == pNode)
+                pTail = pPrev;
+            pNode->pNext = nullptr;
+        }
+    };
+
+    template <typename WrapperType>
+    Node* CreateNode(Uint64 Value, WrapperType&& Wrapper)
+    {
+        void* pRawMem = m_Allocator.Allocate(sizeof(Node), "Resource release queue node", __FILE__, __LINE__);
+        return new (pRawMem) Node{Value, std::forward<WrapperType>(Wrapper)};
+    }
+
+    size_t DestroyNodes(Node* pNode)
+    {
+        size_t Count = 0;
+        while (pNode != nullptr)
+        {
+            auto* pNext = pNode->pNext;
+            pNode->~Node();
+            m_Allocator.Free(pNode);
+            pNode = pNext;
+            ++Count;
+        }
+        return Count;
+    }
+
+    // Pushes the chain [pFirst, pLast] to the head of the lock-free LIFO list.
+    static void PushNodes(std::atomic<Node*>& Head, Node* pFirst, Node* pLast)
+    {
+        auto* pHead = Head.load(std::memory_order_relaxed);
+        do
+        {
+            pLast->pNext = pHead;
+        } while (!Head.compare_exchange_weak(pHead, pFirst, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    // Takes all nodes from the lock-free LIFO list and returns them in the order they were pushed.
+    static NodeList DrainNodes(std::atomic<Node*>& Head)
+    {
+        NodeList List;
+        auto*    pNode = Head.exchange(nullptr, std::memory_order_acquire);
+        List.pTail     = pNode;
+        while (pNode != nullptr)
+        {
+            auto* pNext  = pNode->pNext;
+            pNode->pNext = List.pHead;
+            List.pHead   = pNode;
+            pNode        = pNext;
+        }
+        return List;
+    }
+
+    void OnResourcesAdded(std::atomic<size_t>& Counter, size_t Count)
+    {
+        Counter.fetch_add(Count);
+
+        const auto QueueDepth = m_NumStaleResources.load() + m_NumPendingResources.load();
+        auto       MaxDepth   = m_MaxQueueDepth.load();
+        while (QueueDepth > MaxDepth && !m_MaxQueueDepth.compare_exchange_weak(MaxDepth, QueueDepth))
+        {
+        }
+    }
+
+    IMemoryAllocator& m_Allocator;
+
+    // Resources added by SafeReleaseResource() and DiscardResource() that have not been processed yet
+    std::atomic<Node*> m_NewStaleResources{nullptr};
+    std::atomic<Node*> m_NewDiscardedResources{nullptr};
+
+    std::atomic<size_t> m_NumStaleResources{0};
+    std::atomic<size_t> m_NumPendingResources{0};
+    std::atomic<size_t> m_MaxQueueDepth{0};
+
+    // Protects the lists below and purge statistics. Never held while resources are destroyed.
+    mutable std::mutex m_Mtx;
+
+    NodeList m_StaleResources;
+    NodeList m_ReleaseQueue;
 
-    std::mutex                                                                 m_StaleObjectsMutex;
-    std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_StaleResources;
+    ResourceReleaseQueueStats m_PurgeStats;
 };
 
 } // namespace Diligent
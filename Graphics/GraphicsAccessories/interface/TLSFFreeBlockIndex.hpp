@@ -0,0 +1,534 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::TLSFFreeBlockIndex class
+
+#include <vector>
+#include <algorithm>
+
+#include "../../../Primitives/interface/BasicTypes.h"
+#include "../../../Primitives/interface/MemoryAllocator.h"
+#include "../../../Platforms/interface/PlatformMisc.hpp"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../../Common/interface/Align.hpp"
+#include "../../../Common/interface/STDAllocator.hpp"
+
+namespace Diligent
+{
+
+// Two-level segregated fit (TLSF) index of free blocks, see
+// M. Masmano, I. Ripoll, A. Crespo, J. Real, "TLSF: a New Dynamic Memory Allocator for Real-Time Systems".
+//
+// Free blocks are kept in segregated doubly-linked lists. The first level splits block sizes into
+// power-of-two ranges, and the second level splits every range into SLCount linear sub-ranges:
+//
+//     FL:           0          1           2                  k
+//                 [0, 16)   [16, 32)    [32, 64)   ...   [2^(k+3), 2^(k+4))
+//     SL:         1 each     1 each      2 each            2^(k-1) each
+//
+// Two levels of bitmaps indicate non-empty lists, so a list that is guaranteed to contain
+// a large enough block is found with two bit scans. Blocks adjacent to a given offset are found
+// through open-addressing hash tables keyed by the block start and end offsets.
+// All storage is preallocated and only grows when the number of free blocks exceeds its previous
+// maximum, so adding and removing blocks does not allocate memory in the steady state.
+class TLSFFreeBlockIndex
+{
+public:
+    using OffsetType = size_t;
+
+    static constexpr Uint32 InvalidIndex = ~Uint32{0};
+
+    struct FreeBlock
+    {
+        OffsetType Offset = 0;
+        OffsetType Size   = 0;
+
+        // Previous and next blocks in the segregated list
+        Uint32 PrevFree = InvalidIndex;
+        Uint32 NextFree = InvalidIndex;
+    };
+
+    explicit TLSFFreeBlockIndex(IMemoryAllocator& Allocator) :
+        // clang-format off
+        m_Blocks   {STD_ALLOCATOR_RAW_MEM(FreeBlock, Allocator, "Allocator for vector<FreeBlock>")},
+        m_ListHeads{STD_ALLOCATOR_RAW_MEM(Uint32,    Allocator, "Allocator for vector<Uint32>")   },
+        m_SLBitmaps{STD_ALLOCATOR_RAW_MEM(Uint32,    Allocator, "Allocator for vector<Uint32>")   },
+        m_ByOffset {Allocator},
+        m_ByEnd    {Allocator}
+    // clang-format on
+    {}
+
+    // clang-format off
+    TLSFFreeBlockIndex(TLSFFreeBlockIndex&& rhs) noexcept :
+        m_Blocks          {std::move(rhs.m_Blocks)   },
+        m_ListHeads       {std::move(rhs.m_ListHeads)},
+        m_SLBitmaps       {std::move(rhs.m_SLBitmaps)},
+        m_FLBitmap        {rhs.m_FLBitmap            },
+        m_FirstUnusedBlock{rhs.m_FirstUnusedBlock    },
+        m_NumBlocks       {rhs.m_NumBlocks           },
+        m_ByOffset        {std::move(rhs.m_ByOffset) },
+        m_ByEnd           {std::move(rhs.m_ByEnd)    }
+    {
+        // clang-format on
+        rhs.Clear();
+    }
+
+    TLSFFreeBlockIndex& operator=(TLSFFreeBlockIndex&& rhs) noexcept
+    {
+        if (this == &rhs)
+            return *this;
+
+        m_Blocks           = std::move(rhs.m_Blocks);
+        m_ListHeads        = std::move(rhs.m_ListHeads);
+        m_SLBitmaps        = std::move(rhs.m_SLBitmaps);
+        m_FLBitmap         = rhs.m_FLBitmap;
+        m_FirstUnusedBlock = rhs.m_FirstUnusedBlock;
+        m_NumBlocks        = rhs.m_NumBlocks;
+        m_ByOffset         = std::move(rhs.m_ByOffset);
+        m_ByEnd            = std::move(rhs.m_ByEnd);
+
+        rhs.Clear();
+        return *this;
+    }
+
+    // clang-format off
+    TLSFFreeBlockIndex           (const TLSFFreeBlockIndex&) = delete;
+    TLSFFreeBlockIndex& operator=(const TLSFFreeBlockIndex&) = delete;
+    // clang-format on
+
+    // Removes all blocks and leaves the index in the same state as a newly created one
+    void Clear()
+    {
+        m_Blocks.clear();
+        m_ListHeads.clear();
+        m_SLBitmaps.clear();
+        m_FLBitmap         = 0;
+        m_FirstUnusedBlock = InvalidIndex;
+        m_NumBlocks        = 0;
+        m_ByOffset.Clear();
+        m_ByEnd.Clear();
+    }
+
+    // Adds a new free block. The block must not overlap or be adjacent to any existing block.
+    void AddBlock(OffsetType Offset, OffsetType Size)
+    {
+        VERIFY_EXPR(Size > 0);
+        VERIFY(m_ByOffset.Find(Offset + Size) == InvalidIndex && m_ByEnd.Find(Offset) == InvalidIndex,
+               "Adjacent free blocks must be merged");
+
+        Uint32 BlockIdx = m_FirstUnusedBlock;
+        if (BlockIdx != InvalidIndex)
+            m_FirstUnusedBlock = m_Blocks[BlockIdx].NextFree;
+        else
+        {
+            BlockIdx = static_cast<Uint32>(m_Blocks.size());
+            m_Blocks.emplace_back();
+        }
+
+        auto& Block  = m_Blocks[BlockIdx];
+        Block.Offset = Offset;
+        Block.Size   = Size;
+
+        Uint32 fl = 0, sl = 0;
+        MapSize(Size, fl, sl);
+        ReserveFirstLevels(fl + 1);
+
+        auto& Head     = m_ListHeads[fl * SLCount + sl];
+        Block.PrevFree = InvalidIndex;
+        Block.NextFree = Head;
+        if (Head != InvalidIndex)
+            m_Blocks[Head].PrevFree = BlockIdx;
+        Head = BlockIdx;
+
+        m_FLBitmap |= Uint64{1} << fl;
+        m_SLBitmaps[fl] |= 1u << sl;
+
+        m_ByOffset.Insert(Offset, BlockIdx);
+        m_ByEnd.Insert(Offset + Size, BlockIdx);
+        ++m_NumBlocks;
+    }
+
+    void RemoveBlock(Uint32 BlockIdx)
+    {
+        auto& Block = m_Blocks[BlockIdx];
+        VERIFY_EXPR(Block.Size > 0);
+
+        Uint32 fl = 0, sl = 0;
+        MapSize(Block.Size, fl, sl);
+
+        if (Block.PrevFree != InvalidIndex)
+            m_Blocks[Block.PrevFree].NextFree = Block.NextFree;
+        else
+        {
+            auto& Head = m_ListHeads[fl * SLCount + sl];
+            VERIFY_EXPR(Head == BlockIdx);
+            Head = Block.NextFree;
+            if (Head == InvalidIndex)
+            {
+                m_SLBitmaps[fl] &= ~(1u << sl);
+                if (m_SLBitmaps[fl] == 0)
+                    m_FLBitmap &= ~(Uint64{1} << fl);
+            }
+        }
+        if (Block.NextFree != InvalidIndex)
+            m_Blocks[Block.NextFree].PrevFree = Block.PrevFree;
+
+        m_ByOffset.Erase(Block.Offset);
+        m_ByEnd.Erase(Block.Offset + Block.Size);
+
+        Block.Size         = 0;
+        Block.PrevFree     = InvalidIndex;
+        Block.NextFree     = m_FirstUnusedBlock;
+        m_FirstUnusedBlock = BlockIdx;
+        VERIFY_EXPR(m_NumBlocks > 0);
+        --m_NumBlocks;
+    }
+
+    // Finds a free block that can accommodate Size bytes at the given alignment.
+    Uint32 FindBlock(OffsetType Size, OffsetType Alignment) const
+    {
+        VERIFY_EXPR(Size > 0 && IsPowerOfTwo(Alignment));
+
+        // Good fit: round the request up to the next list boundary, so that every block in the list
+        // found by the bitmap search is large enough to hold the request including the alignment reserve.
+        const auto Needed = Size + (Alignment - 1);
+        if (Needed >= Size)
+        {
+            Uint32 fl = 0, sl = 0;
+            MapSize(RoundUpToListBoundary(Needed), fl, sl);
+            const auto BlockIdx = FindNonEmptyList(fl, sl);
+            if (BlockIdx != InvalidIndex)
+                return BlockIdx;
+        }
+
+        // All lists past the good-fit one are empty, but a block in a list that straddles
+        // the requested size may still be large enough. Check these blocks one by one.
+        Uint32 fl = 0, sl = 0;
+        MapSize(Size, fl, sl);
+        for (auto BlockIdx = FindNonEmptyList(fl, sl); BlockIdx != InvalidIndex; BlockIdx = FindNonEmptyList(fl, sl))
+        {
+            for (; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextFree)
+            {
+                const auto& Block = m_Blocks[BlockIdx];
+                if (AlignUp(Block.Offset, Alignment) + Size <= Block.Offset + Block.Size)
+                    return BlockIdx;
+            }
+
+            if (++sl == SLCount)
+            {
+                sl = 0;
+                ++fl;
+            }
+        }
+
+        return InvalidIndex;
+    }
+
+    // Returns the index of the free block that starts at the given offset
+    Uint32 FindByOffset(OffsetType Offset) const
+    {
+        return m_ByOffset.Find(Offset);
+    }
+
+    // Returns the index of the free block that ends at the given offset
+    Uint32 FindByEnd(OffsetType End) const
+    {
+        return m_ByEnd.Find(End);
+    }
+
+    const FreeBlock& GetBlock(Uint32 BlockIdx) const
+    {
+        VERIFY_EXPR(BlockIdx < m_Blocks.size() && m_Blocks[BlockIdx].Size > 0);
+        return m_Blocks[BlockIdx];
+    }
+
+    size_t GetNumBlocks() const
+    {
+        return m_NumBlocks;
+    }
+
+    OffsetType GetMaxBlockSize() const
+    {
+        if (m_FLBitmap == 0)
+            return 0;
+
+        const auto fl = PlatformMisc::GetMSB(m_FLBitmap);
+        const auto sl = PlatformMisc::GetMSB(m_SLBitmaps[fl]);
+
+        OffsetType MaxSize = 0;
+        for (auto BlockIdx = m_ListHeads[fl * SLCount + sl]; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextFree)
+            MaxSize = std::max(MaxSize, m_Blocks[BlockIdx].Size);
+        return MaxSize;
+    }
+
+#ifdef DILIGENT_DEBUG
+    OffsetType DbgGetTotalFreeSize() const
+    {
+        OffsetType TotalSize = 0;
+        size_t     NumBlocks = 0;
+        for (Uint32 fl = 0; fl < m_SLBitmaps.size(); ++fl)
+        {
+            for (Uint32 sl = 0; sl < SLCount; ++sl)
+            {
+                const auto Head = m_ListHeads[fl * SLCount + sl];
+                VERIFY((Head != InvalidIndex) == ((m_SLBitmaps[fl] & (1u << sl)) != 0), "Second-level bitmap is out of sync with the list");
+                for (auto BlockIdx = Head; BlockIdx != InvalidIndex; BlockIdx = m_Blocks[BlockIdx].NextFree)
+                {
+                    const auto& Block = m_Blocks[BlockIdx];
+
+                    Uint32 BlockFl = 0, BlockSl = 0;
+                    MapSize(Block.Size, BlockFl, BlockSl);
+                    VERIFY(BlockFl == fl && BlockSl == sl, "Block is in the wrong list");
+                    VERIFY(m_ByOffset.Find(Block.Offset) == BlockIdx, "Block is not found by its offset");
+                    VERIFY(m_ByEnd.Find(Block.Offset + Block.Size) == BlockIdx, "Block is not found by its end");
+                    VERIFY(m_ByEnd.Find(Block.Offset) == InvalidIndex, "Unmerged adjacent blocks detected");
+                    TotalSize += Block.Size;
+                    ++NumBlocks;
+                }
+            }
+            VERIFY(((m_FLBitmap >> fl) & 1) == (m_SLBitmaps[fl] != 0 ? 1 : 0), "First-level bitmap is out of sync with the second-level bitmap");
+        }
+        VERIFY_EXPR(NumBlocks == m_NumBlocks);
+        return TotalSize;
+    }
+#endif
+
+private:
+    static constexpr Uint32 SLBits  = 4;
+    static constexpr Uint32 SLCount = 1u << SLBits;
+
+    // Returns the indices of the list that contains blocks of the given size
+    static void MapSize(OffsetType Size, Uint32& fl, Uint32& sl)
+    {
+        if (Size < SLCount)
+        {
+            fl = 0;
+            sl = static_cast<Uint32>(Size);
+        }
+        else
+        {
+            const auto MSB = PlatformMisc::GetMSB(Uint64{Size});
+
+            fl = MSB - SLBits + 1;
+            sl = static_cast<Uint32>(Size >> (MSB - SLBits)) - SLCount;
+        }
+        VERIFY_EXPR(sl < SLCount);
+    }
+
+    static OffsetType RoundUpToListBoundary(OffsetType Size)
+    {
+        if (Size < SLCount)
+            return Size;
+
+        const auto MSB     = PlatformMisc::GetMSB(Uint64{Size});
+        const auto Rounded = Size + (OffsetType{1} << (MSB - SLBits)) - 1;
+        return Rounded >= Size ? Rounded : Size;
+    }
+
+    // Returns the head of the first non-empty list starting from (fl, sl),
+    // and updates fl and sl with the indices of this list.
+    Uint32 FindNonEmptyList(Uint32& fl, Uint32& sl) const
+    {
+        if (fl >= m_SLBitmaps.size())
+            return InvalidIndex;
+
+        auto SLMap = m_SLBitmaps[fl] & (~0u << sl);
+        if (SLMap == 0)
+        {
+            const auto FLMap = (fl + 1 < 64) ? m_FLBitmap & (~Uint64{0} << (fl + 1)) : 0;
+            if (FLMap == 0)
+                return InvalidIndex;
+
+            fl    = PlatformMisc::GetLSB(FLMap);
+            SLMap = m_SLBitmaps[fl];
+        }
+        VERIFY_EXPR(SLMap != 0);
+
+        sl = PlatformMisc::GetLSB(SLMap);
+        return m_ListHeads[fl * SLCount + sl];
+    }
+
+    void ReserveFirstLevels(Uint32 NumLevels)
+    {
+        if (NumLevels > m_SLBitmaps.size())
+        {
+            m_SLBitmaps.resize(NumLevels, 0);
+            m_ListHeads.resize(size_t{NumLevels} * SLCount, Uint32{InvalidIndex});
+        }
+    }
+
+    // Open-addressing hash table with linear probing that maps offsets to block indices
+    class OffsetHashTable
+    {
+    public:
+        explicit OffsetHashTable(IMemoryAllocator& Allocator) :
+            m_Entries{STD_ALLOCATOR_RAW_MEM(Entry, Allocator, "Allocator for vector<Entry>")}
+        {}
+
+        // clang-format off
+        OffsetHashTable(OffsetHashTable&& rhs) noexcept :
+            m_Entries   {std::move(rhs.m_Entries)},
+            m_NumEntries{rhs.m_NumEntries        },
+            m_HashShift {rhs.m_HashShift         }
+        {
+            // clang-format on
+            rhs.Clear();
+        }
+
+        OffsetHashTable& operator=(OffsetHashTable&& rhs) noexcept
+        {
+            if (this == &rhs)
+                return *this;
+
+            m_Entries    = std::move(rhs.m_Entries);
+            m_NumEntries = rhs.m_NumEntries;
+            m_HashShift  = rhs.m_HashShift;
+            rhs.Clear();
+            return *this;
+        }
+
+        // clang-format off
+        OffsetHashTable           (const OffsetHashTable&) = delete;
+        OffsetHashTable& operator=(const OffsetHashTable&) = delete;
+        // clang-format on
+
+        void Clear()
+        {
+            m_Entries.clear();
+            m_NumEntries = 0;
+            m_HashShift  = 64;
+        }
+
+        void Insert(OffsetType Key, Uint32 Value)
+        {
+            VERIFY_EXPR(Value != InvalidIndex);
+            if ((m_NumEntries + 1) * 2 > m_Entries.size())
+                Rehash(std::max(m_Entries.size() * 2, size_t{16}));
+
+            auto Idx = GetHomeIndex(Key);
+            while (m_Entries[Idx].Value != InvalidIndex)
+            {
+                VERIFY(m_Entries[Idx].Key != Key, "Key ", Key, " is already in the table");
+                Idx = (Idx + 1) & (m_Entries.size() - 1);
+            }
+            m_Entries[Idx] = {Key, Value};
+            ++m_NumEntries;
+        }
+
+        Uint32 Find(OffsetType Key) const
+        {
+            const auto Idx = FindEntry(Key);
+            return Idx != InvalidEntry ? m_Entries[Idx].Value : InvalidIndex;
+        }
+
+        void Erase(OffsetType Key)
+        {
+            auto Idx = FindEntry(Key);
+            VERIFY(Idx != InvalidEntry, "Key ", Key, " is not found in the table");
+            if (Idx == InvalidEntry)
+                return;
+
+            // Shift subsequent entries of the probe sequence back to avoid tombstones
+            const auto Mask = m_Entries.size() - 1;
+            for (auto Next = (Idx + 1) & Mask; m_Entries[Next].Value != InvalidIndex; Next = (Next + 1) & Mask)
+            {
+                const auto Home = GetHomeIndex(m_Entries[Next].Key);
+                // Move the entry if its home slot is cyclically outside of (Idx, Next]
+                if (((Next - Home) & Mask) >= ((Next - Idx) & Mask))
+                {
+                    m_Entries[Idx] = m_Entries[Next];
+                    Idx            = Next;
+                }
+            }
+            m_Entries[Idx] = {};
+            --m_NumEntries;
+        }
+
+    private:
+        struct Entry
+        {
+            OffsetType Key   = 0;
+            Uint32     Value = InvalidIndex;
+        };
+
+        static constexpr size_t InvalidEntry = ~size_t{0};
+
+        size_t GetHomeIndex(OffsetType Key) const
+        {
+            // Fibonacci hashing spreads aligned offsets uniformly across the table
+            return static_cast<size_t>((Uint64{Key} * Uint64{0x9E3779B97F4A7C15}) >> m_HashShift);
+        }
+
+        size_t FindEntry(OffsetType Key) const
+        {
+            if (m_NumEntries == 0)
+                return InvalidEntry;
+
+            for (auto Idx = GetHomeIndex(Key); m_Entries[Idx].Value != InvalidIndex; Idx = (Idx + 1) & (m_Entries.size() - 1))
+            {
+                if (m_Entries[Idx].Key == Key)
+                    return Idx;
+            }
+            return InvalidEntry;
+        }
+
+        void Rehash(size_t NewSize)
+        {
+            VERIFY_EXPR(IsPowerOfTwo(NewSize));
+            auto OldEntries = std::move(m_Entries);
+            m_Entries       = decltype(m_Entries)(NewSize, Entry{}, OldEntries.get_allocator());
+            m_HashShift     = 64 - PlatformMisc::GetMSB(Uint64{NewSize});
+            m_NumEntries    = 0;
+            for (const auto& OldEntry : OldEntries)
+            {
+                if (OldEntry.Value != InvalidIndex)
+                    Insert(OldEntry.Key, OldEntry.Value);
+            }
+        }
+
+        std::vector<Entry, STDAllocatorRawMem<Entry>> m_Entries;
+
+        size_t m_NumEntries = 0;
+        Uint32 m_HashShift  = 64;
+    };
+
+    std::vector<FreeBlock, STDAllocatorRawMem<FreeBlock>> m_Blocks;
+    std::vector<Uint32, STDAllocatorRawMem<Uint32>>       m_ListHeads;
+    std::vector<Uint32, STDAllocatorRawMem<Uint32>>       m_SLBitmaps;
+
+    Uint64 m_FLBitmap         = 0;
+    Uint32 m_FirstUnusedBlock = InvalidIndex;
+    size_t m_NumBlocks        = 0;
+
+    OffsetHashTable m_ByOffset;
+    OffsetHashTable m_ByEnd;
+};
+
+} // namespace Diligent
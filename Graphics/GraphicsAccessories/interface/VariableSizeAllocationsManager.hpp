@@ -37,6 +37,7 @@
 #include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
 #include "../../../Common/interface/Align.hpp"
 #include "../../../Common/interface/STDAllocator.hpp"
+#include "TLSFFreeBlockIndex.hpp"
 
 namespace Diligent
 {
@@ -61,11 +62,25 @@ namespace Diligent
 //
 //                32 ------------------> 104 ---------->  {size = 32, &m_FreeBlocksBySize[3]}
 //
+// Alternatively, the free blocks can be managed by the two-level segregated fit index (see TLSFFreeBlockIndex),
+// which performs allocation and release in constant time and does not allocate memory in the steady state.
 class VariableSizeAllocationsManager
 {
 public:
     using OffsetType = size_t;
 
+    /// Free block management algorithm
+    enum ALGORITHM : Uint8
+    {
+        /// Free blocks are kept in two ordered maps sorted by offset and by size.
+        /// Allocations are best-fit.
+        ALGORITHM_ORDERED_MAPS = 0,
+
+        /// Free blocks are kept in two-level segregated lists.
+        /// Allocations are good-fit and take constant time.
+        ALGORITHM_TLSF
+    };
+
 private:
     struct FreeBlockInfo;
 
@@ -98,11 +113,13 @@ private:
     };
 
 public:
-    VariableSizeAllocationsManager(OffsetType MaxSize, IMemoryAllocator& Allocator) :
+    VariableSizeAllocationsManager(OffsetType MaxSize, IMemoryAllocator& Allocator, ALGORITHM Algorithm = ALGORITHM_ORDERED_MAPS) :
         m_FreeBlocksByOffset(STD_ALLOCATOR_RAW_MEM(TFreeBlocksByOffsetMap::value_type, Allocator, "Allocator for map<OffsetType, FreeBlockInfo>")),
         m_FreeBlocksBySize(STD_ALLOCATOR_RAW_MEM(TFreeBlocksBySizeMap::value_type, Allocator, "Allocator for multimap<OffsetType, TFreeBlocksByOffsetMap::iterator>")),
+        m_TLSFIndex(Allocator),
         m_MaxSize(MaxSize),
-        m_FreeSize(MaxSize)
+        m_FreeSize(MaxSize),
+        m_Algorithm(Algorithm)
     {
         // Insert single maximum-size block
         AddNewBlock(0, m_MaxSize);
@@ -128,6 +145,12 @@ public:
             VERIFY(m_FreeBlocksBySize.begin()->first == m_MaxSize, "Head chunk size is expected to be ", m_MaxSize);
             VERIFY(m_FreeBlocksBySize.begin()->second == m_FreeBlocksByOffset.begin(), "Incorrect first block");
         }
+        if (m_TLSFIndex.GetNumBlocks() != 0)
+        {
+            VERIFY(m_TLSFIndex.GetNumBlocks() == 1, "Single free block is expected");
+            const auto& HeadBlock = m_TLSFIndex.GetBlock(m_TLSFIndex.FindByOffset(0));
+            VERIFY(HeadBlock.Size == m_MaxSize, "Head chunk size is expected to be ", m_MaxSize);
+        }
 #endif
     }
 
@@ -135,18 +158,47 @@ public:
     VariableSizeAllocationsManager(VariableSizeAllocationsManager&& rhs) noexcept :
         m_FreeBlocksByOffset {std::move(rhs.m_FreeBlocksByOffset)},
         m_FreeBlocksBySize   {std::move(rhs.m_FreeBlocksBySize)  },
+        m_TLSFIndex          {std::move(rhs.m_TLSFIndex)         },
         m_MaxSize            {rhs.m_MaxSize      },
         m_FreeSize           {rhs.m_FreeSize     },
-        m_CurrAlignment      {rhs.m_CurrAlignment}
+        m_CurrAlignment      {rhs.m_CurrAlignment},
+        m_Algorithm          {rhs.m_Algorithm    }
     {
         // clang-format on
+        rhs.m_FreeBlocksByOffset.clear();
+        rhs.m_FreeBlocksBySize.clear();
         rhs.m_MaxSize       = 0;
         rhs.m_FreeSize      = 0;
         rhs.m_CurrAlignment = 0;
     }
 
+    VariableSizeAllocationsManager& operator=(VariableSizeAllocationsManager&& rhs) noexcept
+    {
+        if (this == &rhs)
+            return *this;
+
+        // Allocators are not propagated on move assignment, so the maps may be moved element-wise,
+        // which invalidates the iterators stored in m_FreeBlocksBySize. Rebuild the size map instead.
+        m_FreeBlocksByOffset = std::move(rhs.m_FreeBlocksByOffset);
+        m_FreeBlocksBySize.clear();
+        for (auto BlockIt = m_FreeBlocksByOffset.begin(); BlockIt != m_FreeBlocksByOffset.end(); ++BlockIt)
+            BlockIt->second.OrderBySizeIt = m_FreeBlocksBySize.emplace(BlockIt->second.Size, BlockIt);
+        m_TLSFIndex     = std::move(rhs.m_TLSFIndex);
+        m_MaxSize       = rhs.m_MaxSize;
+        m_FreeSize      = rhs.m_FreeSize;
+        m_CurrAlignment = rhs.m_CurrAlignment;
+        m_Algorithm     = rhs.m_Algorithm;
+
+        rhs.m_FreeBlocksByOffset.clear();
+        rhs.m_FreeBlocksBySize.clear();
+        rhs.m_MaxSize       = 0;
+        rhs.m_FreeSize      = 0;
+        rhs.m_CurrAlignment = 0;
+
+        return *this;
+    }
+
     // clang-format off
-    VariableSizeAllocationsManager& operator = (VariableSizeAllocationsManager&& rhs) = default;
     VariableSizeAllocationsManager             (const VariableSizeAllocationsManager&) = delete;
     VariableSizeAllocationsManager& operator = (const VariableSizeAllocationsManager&) = delete;
     // clang-format on
@@ -193,6 +245,9 @@ public:
         if (m_FreeSize < Size)
             return Allocation::InvalidAllocation();
 
+        if (m_Algorithm == ALGORITHM_TLSF)
+            return AllocateTLSF(Size, Alignment);
+
         auto AlignmentReserve = (Alignment > m_CurrAlignment) ? Alignment - m_CurrAlignment : 0;
         // Get the first block that is large enough to encompass Size + AlignmentReserve bytes
         // lower_bound() returns an iterator pointing to the first element that
@@ -259,6 +314,12 @@ public:
     {
         VERIFY_EXPR(Offset != Allocation::InvalidOffset && Offset + Size <= m_MaxSize);
 
+        if (m_Algorithm == ALGORITHM_TLSF)
+        {
+            FreeTLSF(Offset, Size);
+            return;
+        }
+
         // Find the first element whose offset is greater than the specified offset.
         // upper_bound() returns an iterator pointing to the first element in the
         // container whose key is considered to go after k.
@@ -359,13 +420,18 @@ public:
     OffsetType GetUsedSize()const{return m_MaxSize - m_FreeSize;}
     // clang-format on
 
+    ALGORITHM GetAlgorithm() const { return m_Algorithm; }
+
     size_t GetNumFreeBlocks() const
     {
-        return m_FreeBlocksByOffset.size();
+        return m_Algorithm == ALGORITHM_TLSF ? m_TLSFIndex.GetNumBlocks() : m_FreeBlocksByOffset.size();
     }
 
     OffsetType GetMaxFreeBlockSize() const
     {
+        if (m_Algorithm == ALGORITHM_TLSF)
+            return m_TLSFIndex.GetMaxBlockSize();
+
         return !m_FreeBlocksBySize.empty() ? m_FreeBlocksBySize.rbegin()->first : 0;
     }
 
@@ -374,7 +440,19 @@ public:
         size_t NewBlockOffset = m_MaxSize;
         size_t NewBlockSize   = ExtraSize;
 
-        if (!m_FreeBlocksByOffset.empty())
+        if (m_Algorithm == ALGORITHM_TLSF)
+        {
+            const auto LastBlockIdx = m_TLSFIndex.FindByEnd(m_MaxSize);
+            if (LastBlockIdx != TLSFFreeBlockIndex::InvalidIndex)
+            {
+                // Extend the last block
+                const auto& LastBlock = m_TLSFIndex.GetBlock(LastBlockIdx);
+                NewBlockOffset        = LastBlock.Offset;
+                NewBlockSize += LastBlock.Size;
+                m_TLSFIndex.RemoveBlock(LastBlockIdx);
+            }
+        }
+        else if (!m_FreeBlocksByOffset.empty())
         {
             auto LastBlockIt = m_FreeBlocksByOffset.end();
             --LastBlockIt;
@@ -405,8 +483,86 @@ public:
     }
 
 private:
+    Allocation AllocateTLSF(OffsetType Size, OffsetType Alignment)
+    {
+        const auto BlockIdx = m_TLSFIndex.FindBlock(Size, Alignment);
+        if (BlockIdx == TLSFFreeBlockIndex::InvalidIndex)
+            return Allocation::InvalidAllocation();
+
+        //     Block.Offset
+        //        |                                  |
+        //        |<-----------Block.Size----------->|
+        //        |<---AdjustedSize--->|<--NewSize-->|
+        //        |     |              |
+        //      Offset AlignedOffset  NewOffset
+        //
+        const auto& Block         = m_TLSFIndex.GetBlock(BlockIdx);
+        const auto  Offset        = Block.Offset;
+        const auto  BlockSize     = Block.Size;
+        const auto  AlignedOffset = AlignUp(Offset, Alignment);
+        const auto  AdjustedSize  = Size + (AlignedOffset - Offset);
+        VERIFY_EXPR(AdjustedSize <= BlockSize);
+
+        m_TLSFIndex.RemoveBlock(BlockIdx);
+        if (BlockSize > AdjustedSize)
+            m_TLSFIndex.AddBlock(Offset + AdjustedSize, BlockSize - AdjustedSize);
+
+        m_FreeSize -= AdjustedSize;
+
+#ifdef DILIGENT_DEBUG
+        DbgVerifyList();
+#endif
+        return Allocation{Offset, AdjustedSize};
+    }
+
+    void FreeTLSF(OffsetType Offset, OffsetType Size)
+    {
+        auto NewOffset = Offset;
+        auto NewSize   = Size;
+
+        const auto PrevBlockIdx = m_TLSFIndex.FindByEnd(Offset);
+        if (PrevBlockIdx != TLSFFreeBlockIndex::InvalidIndex)
+        {
+            //  PrevBlock.Offset             Offset
+            //       |                          |
+            //       |<-----PrevBlock.Size----->|<------Size-------->|
+            //
+            const auto& PrevBlock = m_TLSFIndex.GetBlock(PrevBlockIdx);
+            NewOffset             = PrevBlock.Offset;
+            NewSize += PrevBlock.Size;
+            m_TLSFIndex.RemoveBlock(PrevBlockIdx);
+        }
+
+        const auto NextBlockIdx = m_TLSFIndex.FindByOffset(Offset + Size);
+        if (NextBlockIdx != TLSFFreeBlockIndex::InvalidIndex)
+        {
+            //                  Offset            NextBlock.Offset
+            //                    |                    |
+            //                    |<------Size-------->|<-----NextBlock.Size----->|
+            //
+            NewSize += m_TLSFIndex.GetBlock(NextBlockIdx).Size;
+            m_TLSFIndex.RemoveBlock(NextBlockIdx);
+        }
+
+        m_TLSFIndex.AddBlock(NewOffset, NewSize);
+
+        m_FreeSize += Size;
+        VERIFY_EXPR(m_FreeSize <= m_MaxSize);
+
+#ifdef DILIGENT_DEBUG
+        DbgVerifyList();
+#endif
+    }
+
     void AddNewBlock(OffsetType Offset, OffsetType Size)
     {
+        if (m_Algorithm == ALGORITHM_TLSF)
+        {
+            if (Size > 0)
+                m_TLSFIndex.AddBlock(Offset, Size);
+            return;
+        }
+
         auto NewBlockIt = m_FreeBlocksByOffset.emplace(Offset, Size);
         VERIFY_EXPR(NewBlockIt.second);
         auto OrderIt                           = m_FreeBlocksBySize.emplace(Size, NewBlockIt.first);
@@ -422,6 +578,13 @@ private:
 #ifdef DILIGENT_DEBUG
     void DbgVerifyList()
     {
+        if (m_Algorithm == ALGORITHM_TLSF)
+        {
+            VERIFY_EXPR(m_FreeBlocksByOffset.empty() && m_FreeBlocksBySize.empty());
+            VERIFY_EXPR(m_TLSFIndex.DbgGetTotalFreeSize() == m_FreeSize);
+            return;
+        }
+
         OffsetType TotalFreeSize = 0;
 
         VERIFY_EXPR(IsPowerOfTwo(m_CurrAlignment));
@@ -460,10 +623,12 @@ private:
 
     TFreeBlocksByOffsetMap m_FreeBlocksByOffset;
     TFreeBlocksBySizeMap   m_FreeBlocksBySize;
+    TLSFFreeBlockIndex     m_TLSFIndex;
 
     OffsetType m_MaxSize       = 0;
     OffsetType m_FreeSize      = 0;
     OffsetType m_CurrAlignment = 0;
+    ALGORITHM  m_Algorithm     = ALGORITHM_ORDERED_MAPS;
     // When adding new members, do not forget to update move ctor
 };
 } // namespace Diligent
@@ -147,8 +147,8 @@ void DynamicAtlasManager::RegisterNode(Node& N)
     VERIFY(!N.R.IsEmpty(), "Region must not be empty");
 
     VERIFY(m_AllocatedRegions.find(N.R) == m_AllocatedRegions.end(), "New region should not be present in allocated regions hash map");
-    VERIFY(m_FreeRegionsByWidth.find(N.R) == m_FreeRegionsByWidth.end(), "New region should not be present in free regions map");
-    VERIFY(m_FreeRegionsByHeight.find(N.R) == m_FreeRegionsByHeight.end(), "New region should not be present in free regions map");
+    VERIFY(!m_FreeRegionsByWidth.Contains(N.R), "New region should not be present in free regions map");
+    VERIFY(!m_FreeRegionsByHeight.Contains(N.R), "New region should not be present in free regions map");
 
     if (N.IsAllocated)
     {
@@ -156,8 +156,8 @@ void DynamicAtlasManager::RegisterNode(Node& N)
     }
     else
     {
-        m_FreeRegionsByWidth.emplace(N.R, &N);
-        m_FreeRegionsByHeight.emplace(N.R, &N);
+        m_FreeRegionsByWidth.Insert(N.R, &N);
+        m_FreeRegionsByHeight.Insert(N.R, &N);
     }
 }
 
@@ -173,10 +173,10 @@ void DynamicAtlasManager::UnregisterNode(const Node& N)
     }
     else
     {
-        VERIFY(m_FreeRegionsByWidth.find(N.R) != m_FreeRegionsByWidth.end(), "Region is not found in free regions map");
-        VERIFY(m_FreeRegionsByHeight.find(N.R) != m_FreeRegionsByHeight.end(), "Region is not is not in free regions map");
-        m_FreeRegionsByWidth.erase(N.R);
-        m_FreeRegionsByHeight.erase(N.R);
+        VERIFY(m_FreeRegionsByWidth.Contains(N.R), "Region is not found in free regions map");
+        VERIFY(m_FreeRegionsByHeight.Contains(N.R), "Region is not is not in free regions map");
+        m_FreeRegionsByWidth.Erase(N.R);
+        m_FreeRegionsByHeight.Erase(N.R);
     }
 }
 
@@ -184,18 +184,18 @@ void DynamicAtlasManager::UnregisterNode(const Node& N)
 
 DynamicAtlasManager::Region DynamicAtlasManager::Allocate(Uint32 Width, Uint32 Height)
 {
-    auto it_w = m_FreeRegionsByWidth.lower_bound(Region{0, 0, Width, 0});
-    while (it_w != m_FreeRegionsByWidth.end() && it_w->first.height < Height)
+    auto it_w = m_FreeRegionsByWidth.LowerBound(Region{0, 0, Width, 0});
+    while (it_w != m_FreeRegionsByWidth.end() && it_w->R.height < Height)
         ++it_w;
-    VERIFY_EXPR(it_w == m_FreeRegionsByWidth.end() || (it_w->first.width >= Width && it_w->first.height >= Height));
+    VERIFY_EXPR(it_w == m_FreeRegionsByWidth.end() || (it_w->R.width >= Width && it_w->R.height >= Height));
 
-    auto it_h = m_FreeRegionsByHeight.lower_bound(Region{0, 0, 0, Height});
-    while (it_h != m_FreeRegionsByHeight.end() && it_h->first.width < Width)
+    auto it_h = m_FreeRegionsByHeight.LowerBound(Region{0, 0, 0, Height});
+    while (it_h != m_FreeRegionsByHeight.end() && it_h->R.width < Width)
         ++it_h;
-    VERIFY_EXPR(it_h == m_FreeRegionsByHeight.end() || (it_h->first.width >= Width && it_h->first.height >= Height));
+    VERIFY_EXPR(it_h == m_FreeRegionsByHeight.end() || (it_h->R.width >= Width && it_h->R.height >= Height));
 
-    const auto AreaW = it_w != m_FreeRegionsByWidth.end() ? it_w->first.width * it_w->first.height : 0;
-    const auto AreaH = it_h != m_FreeRegionsByHeight.end() ? it_h->first.width * it_h->first.height : 0;
+    const auto AreaW = it_w != m_FreeRegionsByWidth.end() ? it_w->R.width * it_w->R.height : 0;
+    const auto AreaH = it_h != m_FreeRegionsByHeight.end() ? it_h->R.width * it_h->R.height : 0;
     VERIFY_EXPR(AreaW == 0 || AreaW >= Width * Height);
     VERIFY_EXPR(AreaH == 0 || AreaH >= Width * Height);
 
@@ -203,15 +203,15 @@ DynamicAtlasManager::Region DynamicAtlasManager::Allocate(Uint32 Width, Uint32 H
     // Use the smaller area source region
     if (AreaW > 0 && AreaH > 0)
     {
-        pSrcNode = AreaW < AreaH ? it_w->second : it_h->second;
+        pSrcNode = AreaW < AreaH ? it_w->pNode : it_h->pNode;
     }
     else if (AreaW > 0)
     {
-        pSrcNode = it_w->second;
+        pSrcNode = it_w->pNode;
     }
     else if (AreaH > 0)
     {
-        pSrcNode = it_h->second;
+        pSrcNode = it_h->pNode;
     }
     else
     {
@@ -390,8 +390,8 @@ void DynamicAtlasManager::DbgRecursiveVerifyConsistency(const Node& N, Uint32& A
     {
         VERIFY_EXPR(!N.IsAllocated);
         VERIFY(m_AllocatedRegions.find(N.R) == m_AllocatedRegions.end(), "Regions with children must not be present in allocated regions hash map");
-        VERIFY(m_FreeRegionsByWidth.find(N.R) == m_FreeRegionsByWidth.end(), "Regions with children must not be present in free regions map");
-        VERIFY(m_FreeRegionsByHeight.find(N.R) == m_FreeRegionsByHeight.end(), "Regions with children must not be present in free regions map");
+        VERIFY(!m_FreeRegionsByWidth.Contains(N.R), "Regions with children must not be present in free regions map");
+        VERIFY(!m_FreeRegionsByHeight.Contains(N.R), "Regions with children must not be present in free regions map");
 
         N.ProcessChildren([&Area, this](const Node& Child) //
                           {
@@ -403,14 +403,14 @@ void DynamicAtlasManager::DbgRecursiveVerifyConsistency(const Node& N, Uint32& A
         if (N.IsAllocated)
         {
             VERIFY(m_AllocatedRegions.find(N.R) != m_AllocatedRegions.end(), "Allocated region is not found in allocated regions hash map");
-            VERIFY(m_FreeRegionsByWidth.find(N.R) == m_FreeRegionsByWidth.end(), "Allocated region should not be present in free regions map");
-            VERIFY(m_FreeRegionsByHeight.find(N.R) == m_FreeRegionsByHeight.end(), "Allocated region should not be present in free regions map");
+            VERIFY(!m_FreeRegionsByWidth.Contains(N.R), "Allocated region should not be present in free regions map");
+            VERIFY(!m_FreeRegionsByHeight.Contains(N.R), "Allocated region should not be present in free regions map");
         }
         else
         {
             VERIFY(m_AllocatedRegions.find(N.R) == m_AllocatedRegions.end(), "Free region is found in allocated regions hash map");
-            VERIFY(m_FreeRegionsByWidth.find(N.R) != m_FreeRegionsByWidth.end(), "Free region is not found in free regions map");
-            VERIFY(m_FreeRegionsByHeight.find(N.R) != m_FreeRegionsByHeight.end(), "Free region is not found in free regions map");
+            VERIFY(m_FreeRegionsByWidth.Contains(N.R), "Free region is not found in free regions map");
+            VERIFY(m_FreeRegionsByHeight.Contains(N.R), "Free region is not found in free regions map");
         }
 
         Area += N.R.width * N.R.height;
@@ -429,13 +429,13 @@ void DynamicAtlasManager::DbgVerifyConsistency() const
     {
         Uint64 FreeArea = 0;
         for (const auto& it : m_FreeRegionsByWidth)
-            FreeArea += Uint64{it.second->R.width} * Uint64{it.second->R.height};
+            FreeArea += Uint64{it.R.width} * Uint64{it.R.height};
         VERIFY_EXPR(FreeArea == m_TotalFreeArea);
     }
     {
         Uint32 FreeArea = 0;
         for (const auto& it : m_FreeRegionsByHeight)
-            FreeArea += Uint64{it.second->R.width} * Uint64{it.second->R.height};
+            FreeArea += Uint64{it.R.width} * Uint64{it.R.height};
         VERIFY_EXPR(FreeArea == m_TotalFreeArea);
     }
 }
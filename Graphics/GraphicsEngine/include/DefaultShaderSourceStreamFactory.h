@@ -38,4 +38,58 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 void CreateDefaultShaderSourceStreamFactory(const Char*                       SearchDirectories,
                                             IShaderSourceInputStreamFactory** ppShaderSourceStreamFactory);
 
+/// Creates a shader source stream factory that caches the contents of the files it opens.
+
+/// \param [in]  SearchDirectories           - Semicolon-separated list of search directories.
+/// \param [in]  RevalidationPeriodMs        - Minimal time, in milliseconds, between two checks of the
+///                                            modification time of a cached file. If zero, the time
+///                                            is checked every time the file is requested.
+/// \param [in]  MaxCacheSize                - Maximum total size, in bytes, of the cached file contents.
+///                                            When the size is exceeded, the least recently used files
+///                                            are evicted. Files larger than this size are not cached.
+/// \param [out] ppShaderSourceStreamFactory - Memory address where the pointer to the shader source stream factory will be written.
+///
+/// \remarks   Cached files are keyed by the requested name and are returned as read-only memory streams
+///            that share the same immutable data blob (see ReadStreamBlob()). A file is re-read when its
+///            modification time changes; if the new contents hash to the same value, the existing blob
+///            is kept. The factory is thread-safe and is intended to be shared between compilations.
+void CreateCachingShaderSourceStreamFactory(const Char*                       SearchDirectories,
+                                            Uint32                            RevalidationPeriodMs,
+                                            Uint64                            MaxCacheSize,
+                                            IShaderSourceInputStreamFactory** ppShaderSourceStreamFactory);
+
+
+/// Shader source stream factory statistics
+struct ShaderSourceStreamFactoryStats
+{
+    /// The number of requests served from the cache.
+    Uint64 NumHits DEFAULT_INITIALIZER(0);
+
+    /// The number of requests that required reading the file.
+    Uint64 NumMisses DEFAULT_INITIALIZER(0);
+
+    /// The number of cached files that were re-read because their modification time changed.
+    Uint64 NumInvalidations DEFAULT_INITIALIZER(0);
+
+    /// The number of files that were evicted from the cache to keep its size within the limit.
+    Uint64 NumEvictions DEFAULT_INITIALIZER(0);
+
+    /// The number of files in the cache.
+    Uint64 NumCachedFiles DEFAULT_INITIALIZER(0);
+
+    /// The total size, in bytes, of the cached file contents.
+    Uint64 CachedDataSize DEFAULT_INITIALIZER(0);
+
+    /// The number of file system queries (existence checks, file opens and
+    /// modification time queries) performed by the factory.
+    Uint64 NumFileSystemCalls DEFAULT_INITIALIZER(0);
+};
+typedef struct ShaderSourceStreamFactoryStats ShaderSourceStreamFactoryStats;
+
+/// Returns the statistics of the factory created by CreateDefaultShaderSourceStreamFactory()
+/// or CreateCachingShaderSourceStreamFactory(). For other factories, returns zero statistics.
+
+/// \remarks   The default (non-caching) factory only counts file system calls.
+ShaderSourceStreamFactoryStats GetShaderSourceStreamFactoryStats(IShaderSourceInputStreamFactory* pFactory);
+
 DILIGENT_END_NAMESPACE // namespace Diligent
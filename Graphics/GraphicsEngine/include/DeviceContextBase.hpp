@@ -55,6 +55,8 @@ namespace Diligent
 // clang-format off
 bool VerifyDrawAttribs               (const DrawAttribs&                Attribs);
 bool VerifyDrawIndexedAttribs        (const DrawIndexedAttribs&         Attribs);
+bool VerifyMultiDrawAttribs          (const MultiDrawAttribs&           Attribs);
+bool VerifyMultiDrawIndexedAttribs   (const MultiDrawIndexedAttribs&    Attribs);
 bool VerifyDrawIndirectAttribs       (const DrawIndirectAttribs&        Attribs);
 bool VerifyDrawIndexedIndirectAttribs(const DrawIndexedIndirectAttribs& Attribs);
 
@@ -515,6 +517,8 @@ protected:
     // clang-format off
     void DvpVerifyDrawArguments                 (const DrawAttribs&                  Attribs) const;
     void DvpVerifyDrawIndexedArguments          (const DrawIndexedAttribs&           Attribs) const;
+    void DvpVerifyMultiDrawArguments            (const MultiDrawAttribs&             Attribs) const;
+    void DvpVerifyMultiDrawIndexedArguments     (const MultiDrawIndexedAttribs&      Attribs) const;
     void DvpVerifyDrawMeshArguments             (const DrawMeshAttribs&              Attribs) const;
     void DvpVerifyDrawIndirectArguments         (const DrawIndirectAttribs&          Attribs) const;
     void DvpVerifyDrawIndexedIndirectArguments  (const DrawIndexedIndirectAttribs&   Attribs) const;
@@ -541,6 +545,8 @@ protected:
     // clang-format off
     void DvpVerifyDrawArguments                 (const DrawAttribs&                  Attribs) const {}
     void DvpVerifyDrawIndexedArguments          (const DrawIndexedAttribs&           Attribs) const {}
+    void DvpVerifyMultiDrawArguments            (const MultiDrawAttribs&             Attribs) const {}
+    void DvpVerifyMultiDrawIndexedArguments     (const MultiDrawIndexedAttribs&      Attribs) const {}
     void DvpVerifyDrawMeshArguments             (const DrawMeshAttribs&              Attribs) const {}
     void DvpVerifyDrawIndirectArguments         (const DrawIndirectAttribs&          Attribs) const {}
     void DvpVerifyDrawIndexedIndirectArguments  (const DrawIndexedIndirectAttribs&   Attribs) const {}
@@ -2153,6 +2159,41 @@ inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawIndexedArgumen
     DEV_CHECK_ERR(VerifyDrawIndexedAttribs(Attribs), "DrawIndexedAttribs are invalid");
 }
 
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::DvpVerifyMultiDrawArguments(const MultiDrawAttribs& Attribs) const
+{
+    if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+        return;
+
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "MultiDraw");
+
+    DEV_CHECK_ERR(m_pPipelineState, "MultiDraw command arguments are invalid: no pipeline state is bound.");
+
+    DEV_CHECK_ERR(m_pPipelineState->GetDesc().PipelineType == PIPELINE_TYPE_GRAPHICS,
+                  "MultiDraw command arguments are invalid: pipeline state '", m_pPipelineState->GetDesc().Name, "' is not a graphics pipeline.");
+
+    DEV_CHECK_ERR(VerifyMultiDrawAttribs(Attribs), "MultiDrawAttribs are invalid");
+}
+
+template <typename ImplementationTraits>
+inline void DeviceContextBase<ImplementationTraits>::DvpVerifyMultiDrawIndexedArguments(const MultiDrawIndexedAttribs& Attribs) const
+{
+    if ((Attribs.Flags & DRAW_FLAG_VERIFY_DRAW_ATTRIBS) == 0)
+        return;
+
+    DVP_CHECK_QUEUE_TYPE_COMPATIBILITY(COMMAND_QUEUE_TYPE_GRAPHICS, "MultiDrawIndexed");
+
+    DEV_CHECK_ERR(m_pPipelineState, "MultiDrawIndexed command arguments are invalid: no pipeline state is bound.");
+
+    DEV_CHECK_ERR(m_pPipelineState->GetDesc().PipelineType == PIPELINE_TYPE_GRAPHICS,
+                  "MultiDrawIndexed command arguments are invalid: pipeline state '",
+                  m_pPipelineState->GetDesc().Name, "' is not a graphics pipeline.");
+
+    DEV_CHECK_ERR(m_pIndexBuffer, "MultiDrawIndexed command arguments are invalid: no index buffer is bound.");
+
+    DEV_CHECK_ERR(VerifyMultiDrawIndexedAttribs(Attribs), "MultiDrawIndexedAttribs are invalid");
+}
+
 template <typename ImplementationTraits>
 inline void DeviceContextBase<ImplementationTraits>::DvpVerifyDrawMeshArguments(const DrawMeshAttribs& Attribs) const
 {
@@ -31,6 +31,8 @@
 /// Implementation of the Diligent::PipelineStateBase template class
 
 #include <array>
+#include <atomic>
+#include <future>
 #include <unordered_map>
 #include <unordered_set>
 #include <cstring>
@@ -44,6 +46,7 @@
 #include "GraphicsAccessories.hpp"
 #include "FixedLinearAllocator.hpp"
 #include "HashUtils.hpp"
+#include "ThreadPool.hpp"
 #include "PipelineResourceSignatureBase.hpp"
 
 namespace Diligent
@@ -222,6 +225,8 @@ public:
     {
         VERIFY(!m_IsDestructed, "This object has already been destructed");
 
+        WaitForAsyncInitTask();
+
         if (this->m_Desc.IsAnyGraphicsPipeline() && m_pGraphicsPipelineData != nullptr)
         {
             m_pGraphicsPipelineData->~GraphicsPipelineData();
@@ -463,12 +468,79 @@ public:
         return true;
     }
 
+    /// Implementation of IPipelineState::GetStatus().
+    virtual PIPELINE_STATE_STATUS DILIGENT_CALL_TYPE GetStatus(bool WaitForCompletion) override final
+    {
+        if (WaitForCompletion)
+            WaitForAsyncInitTask();
+
+        return m_Status.load(std::memory_order_acquire);
+    }
+
+    bool IsReady() const
+    {
+        return m_Status.load(std::memory_order_acquire) == PIPELINE_STATE_STATUS_READY;
+    }
+
+    /// Returns true only the first time it is called. Device contexts use this method to
+    /// report commands that are skipped because asynchronous compilation of the pipeline has failed.
+    bool MarkFailureReported() const
+    {
+        return !m_FailureReported.exchange(true, std::memory_order_relaxed);
+    }
+
     SHADER_TYPE GetActiveShaderStages() const
     {
         return m_ActiveShaderStages;
     }
 
 protected:
+    /// Runs the final stage of pipeline initialization.
+
+    /// If PSO_CREATE_FLAG_ASYNCHRONOUS flag is set and the device has the pipeline compilation
+    /// thread pool, the handler is executed by the pool and the pipeline status is
+    /// PIPELINE_STATE_STATUS_COMPILING until the handler completes. Otherwise, the handler is
+    /// executed on the calling thread and its exceptions are propagated to the caller.
+    ///
+    /// \remarks  The handler must not rely on any data owned by the create info struct
+    ///           and must keep strong references to all objects it uses.
+    ///           The derived class must call WaitForAsyncInitTask() before it releases
+    ///           any object the handler may access.
+    template <typename HandlerType>
+    void RunPipelineInitTask(PSO_CREATE_FLAGS Flags, HandlerType&& Handler) noexcept(false)
+    {
+        auto* pThreadPool = (Flags & PSO_CREATE_FLAG_ASYNCHRONOUS) != 0 ?
+            this->m_pDevice->GetPipelineCompilationThreadPool() :
+            nullptr;
+        if (pThreadPool == nullptr)
+        {
+            Handler();
+            return;
+        }
+
+        m_Status.store(PIPELINE_STATE_STATUS_COMPILING, std::memory_order_relaxed);
+
+        auto Task = [this, Handler = std::forward<HandlerType>(Handler)]() mutable {
+            try
+            {
+                Handler();
+                m_Status.store(PIPELINE_STATE_STATUS_READY, std::memory_order_release);
+            }
+            catch (...)
+            {
+                LOG_ERROR_MESSAGE("Failed to asynchronously create pipeline state '", (this->m_Desc.Name != nullptr ? this->m_Desc.Name : ""), "'");
+                m_Status.store(PIPELINE_STATE_STATUS_FAILED, std::memory_order_release);
+            }
+        };
+        m_AsyncInitTask = pThreadPool->Enqueue(std::move(Task)).share();
+    }
+
+    void WaitForAsyncInitTask() const
+    {
+        if (m_AsyncInitTask.valid())
+            m_AsyncInitTask.wait();
+    }
+
     using TNameToGroupIndexMap = std::unordered_map<HashMapStringKey, Uint32, HashMapStringKey::Hasher>;
 
     void ReserveSpaceForPipelineDesc(const GraphicsPipelineStateCreateInfo& CreateInfo,
@@ -1134,6 +1206,14 @@ protected:
     using SignatureAutoPtrType         = RefCntAutoPtr<PipelineResourceSignatureImplType>;
     SignatureAutoPtrType* m_Signatures = nullptr; // [m_SignatureCount]
 
+    std::atomic<PIPELINE_STATE_STATUS> m_Status{PIPELINE_STATE_STATUS_READY};
+
+    /// Indicates that the failure of asynchronous compilation has been reported, see MarkFailureReported().
+    mutable std::atomic<bool> m_FailureReported{false};
+
+    /// Asynchronous initialization task, see RunPipelineInitTask().
+    std::shared_future<void> m_AsyncInitTask;
+
     struct GraphicsPipelineData
     {
         GraphicsPipelineDesc Desc;
@@ -29,8 +29,14 @@
 /// \file
 /// Implementation of the Diligent::PipelineStateCacheBase template class
 
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include "PipelineStateCache.h"
 #include "DeviceObjectBase.hpp"
+#include "HashUtils.hpp"
+#include "RefCntAutoPtr.hpp"
 
 namespace Diligent
 {
@@ -38,6 +44,83 @@ namespace Diligent
 /// Validates PSO cache create info and throws an exception in case of an error.
 void ValidatePipelineStateCacheCreateInfo(const PipelineStateCacheCreateInfo& CreateInfo) noexcept(false);
 
+/// Backend-independent content-addressed storage of the pipeline state cache.
+
+/// The storage keeps data blobs (e.g. compiled shaders or pipeline entries) keyed by the content hash
+/// of the data they were produced from, as well as the opaque driver cache data.
+/// Serialized layout:
+///
+///     | Header | Entry table | Entry data | Driver data |
+///
+/// Entries loaded from the serialized data reference the source blob (which may be a memory-mapped
+/// file) and are not copied, neither when they are loaded nor when they are found. Data that do not start with the storage header are treated as raw
+/// driver cache data (e.g. a blob returned by vkGetPipelineCacheData).
+/// The storage is thread-safe.
+class PipelineStateCacheStorage
+{
+public:
+    /// Initializes the storage from CreateInfo.pCacheData or CreateInfo.FilePath. If the data were
+    /// produced by an incompatible device or version, the storage starts empty.
+    PipelineStateCacheStorage(RENDER_DEVICE_TYPE DeviceType, const PipelineStateCacheCreateInfo& CreateInfo);
+
+    // clang-format off
+    PipelineStateCacheStorage           (const PipelineStateCacheStorage&)  = delete;
+    PipelineStateCacheStorage& operator=(const PipelineStateCacheStorage&)  = delete;
+    PipelineStateCacheStorage           (      PipelineStateCacheStorage&&) = delete;
+    PipelineStateCacheStorage& operator=(      PipelineStateCacheStorage&&) = delete;
+    // clang-format on
+
+    /// Returns the data blob of the entry with the given key, or null if there is no such entry.
+
+    /// \remarks   The blob references the entry data without copying them and keeps the data alive
+    ///            after the storage is cleared or destroyed. The data must not be modified and are
+    ///            not necessarily aligned.
+    RefCntAutoPtr<IDataBlob> Find(const ContentHash& Key) const;
+
+    /// Adds a new entry. If an entry with the same key already exists, the call has no effect.
+    void Store(const ContentHash& Key, const void* pData, size_t DataSize);
+
+    /// Driver cache data that was loaded from the serialized data.
+    const Uint8* GetDriverData() const { return m_pDriverData; }
+    size_t       GetDriverDataSize() const { return m_DriverDataSize; }
+
+    size_t GetNumEntries() const;
+
+    /// Removes all entries and the driver data.
+    void Clear();
+
+    /// Serializes all entries along with the driver data provided by the caller.
+    RefCntAutoPtr<IDataBlob> Serialize(const void* pDriverData, size_t DriverDataSize) const;
+
+    /// Checks if the data start with a valid header. Returns false for empty data.
+    static bool IsValidData(const void* pData, size_t DataSize);
+
+private:
+    void Load();
+
+    struct Entry
+    {
+        // Points to the source data or to the data of pDataBlob
+        const Uint8* pData = nullptr;
+        size_t       Size  = 0;
+
+        // Data blob returned by Find(). Entries added by Store() own the blob with the data;
+        // for entries loaded from the source data, the view is created when it is first requested.
+        mutable RefCntAutoPtr<IDataBlob> pDataBlob;
+    };
+
+    const RENDER_DEVICE_TYPE m_DeviceType;
+
+    // Serialized data the storage was initialized from
+    RefCntAutoPtr<IDataBlob> m_pSourceData;
+
+    mutable std::mutex                                          m_Mtx;
+    std::unordered_map<ContentHash, Entry, ContentHash::Hasher> m_Entries;
+
+    const Uint8* m_pDriverData    = nullptr;
+    size_t       m_DriverDataSize = 0;
+};
+
 /// Template class implementing base functionality of the pipeline state cache object
 
 /// \tparam EngineImplTraits - Engine implementation type traits.
@@ -62,12 +145,18 @@ public:
                            RenderDeviceImplType*               pDevice,
                            const PipelineStateCacheCreateInfo& CreateInfo,
                            bool                                bIsDeviceInternal = false) :
-        TDeviceObjectBase{pRefCounters, pDevice, CreateInfo.Desc, bIsDeviceInternal}
+        TDeviceObjectBase{pRefCounters, pDevice, CreateInfo.Desc, bIsDeviceInternal},
+        m_Storage{pDevice->GetDeviceInfo().Type, CreateInfo}
     {
         ValidatePipelineStateCacheCreateInfo(CreateInfo);
     }
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_PipelineStateCache, TDeviceObjectBase)
+
+    PipelineStateCacheStorage& GetStorage() { return m_Storage; }
+
+protected:
+    PipelineStateCacheStorage m_Storage;
 };
 
 } // namespace Diligent
@@ -44,6 +44,7 @@
 #include "EngineMemory.h"
 #include "STDAllocator.hpp"
 #include "IndexWrapper.hpp"
+#include "ThreadPool.hpp"
 
 namespace std
 {
@@ -262,13 +263,13 @@ public:
         m_wpDeferredContexts     (EngineCI.NumDeferredContexts, RefCntWeakPtr<DeviceContextImplType>(), STD_ALLOCATOR_RAW_MEM(RefCntWeakPtr<DeviceContextImplType>, RawMemAllocator, "Allocator for vector<RefCntWeakPtr<DeviceContextImplType>>")),
         m_RawMemAllocator        {RawMemAllocator},
         m_TexObjAllocator        {RawMemAllocator, sizeof(TextureImplType),                    64},
-        m_TexViewObjAllocator    {RawMemAllocator, sizeof(TextureViewImplType),                64},
+        m_TexViewObjAllocator    {RawMemAllocator, sizeof(TextureViewImplType),                64, MaxEmptyObjPages, ObjThreadCacheSize},
         m_BufObjAllocator        {RawMemAllocator, sizeof(BufferImplType),                    128},
-        m_BuffViewObjAllocator   {RawMemAllocator, sizeof(BufferViewImplType),                128},
+        m_BuffViewObjAllocator   {RawMemAllocator, sizeof(BufferViewImplType),                128, MaxEmptyObjPages, ObjThreadCacheSize},
         m_ShaderObjAllocator     {RawMemAllocator, sizeof(ShaderImplType),                     32},
         m_SamplerObjAllocator    {RawMemAllocator, sizeof(SamplerImplType),                    32},
         m_PSOAllocator           {RawMemAllocator, sizeof(PipelineStateImplType),             128},
-        m_SRBAllocator           {RawMemAllocator, sizeof(ShaderResourceBindingImplType),    1024},
+        m_SRBAllocator           {RawMemAllocator, sizeof(ShaderResourceBindingImplType),    1024, MaxEmptyObjPages, ObjThreadCacheSize},
         m_ResMappingAllocator    {RawMemAllocator, sizeof(ResourceMappingImpl),                16},
         m_FenceAllocator         {RawMemAllocator, sizeof(FenceImplType),                      16},
         m_QueryAllocator         {RawMemAllocator, sizeof(QueryImplType),                      16},
@@ -282,6 +283,9 @@ public:
         m_PSOCacheAllocator      {RawMemAllocator, sizeof(PipelineStateCacheImplType),         16}
     // clang-format on
     {
+        if (EngineCI.NumPipelineCompilationThreads > 0)
+            m_pPipelineCompilationThreadPool.reset(new ThreadPool{EngineCI.NumPipelineCompilationThreads});
+
         // Initialize texture format info
         for (Uint32 Fmt = TEX_FORMAT_UNKNOWN; Fmt < TEX_FORMAT_NUM_FORMATS; ++Fmt)
             static_cast<TextureFormatAttribs&>(m_TextureFormatsInfo[Fmt]) = GetTextureFormatAttribs(static_cast<TEXTURE_FORMAT>(Fmt));
@@ -412,6 +416,12 @@ public:
         UNSUPPORTED("Tile pipeline is not supported by this device. Please check DeviceFeatures.TileShaders feature.");
     }
 
+    /// Implementation of IRenderDevice::GetSamplerRegistryStats().
+    virtual StateObjectsRegistryStats DILIGENT_CALL_TYPE GetSamplerRegistryStats() const override final
+    {
+        return m_SamplersRegistry.GetStats();
+    }
+
     StateObjectsRegistry<SamplerDesc>& GetSamplerRegistry() { return m_SamplersRegistry; }
 
     /// Set weak reference to the immediate context
@@ -449,6 +459,10 @@ public:
 
     VALIDATION_FLAGS GetValidationFlags() const { return m_ValidationFlags; }
 
+    /// Returns the pool that compiles pipelines created with PSO_CREATE_FLAG_ASYNCHRONOUS flag,
+    /// or null if the pool was not requested (see EngineCreateInfo::NumPipelineCompilationThreads).
+    ThreadPool* GetPipelineCompilationThreadPool() { return m_pPipelineCompilationThreadPool.get(); }
+
     // Convenience function
     const DeviceFeatures& GetFeatures() const
     {
@@ -565,12 +579,13 @@ protected:
         CreateDeviceObject("Sampler", SamplerDesc, ppSampler,
                            [&]() //
                            {
-                               m_SamplersRegistry.Find(SamplerDesc, reinterpret_cast<IDeviceObject**>(ppSampler));
+                               const auto Hash = m_SamplersRegistry.ComputeHash(SamplerDesc);
+                               m_SamplersRegistry.Find(SamplerDesc, Hash, reinterpret_cast<IDeviceObject**>(ppSampler));
                                if (*ppSampler == nullptr)
                                {
                                    auto* pSamplerImpl{NEW_RC_OBJ(m_SamplerObjAllocator, "Sampler instance", SamplerImplType)(static_cast<RenderDeviceImplType*>(this), SamplerDesc, ExtraArgs...)};
                                    pSamplerImpl->QueryInterface(IID_Sampler, reinterpret_cast<IObject**>(ppSampler));
-                                   m_SamplersRegistry.Add(SamplerDesc, *ppSampler);
+                                   m_SamplersRegistry.Add(SamplerDesc, Hash, *ppSampler);
                                }
                            });
     }
@@ -703,6 +718,11 @@ protected:
     /// Weak references to deferred contexts.
     std::vector<RefCntWeakPtr<DeviceContextImplType>, STDAllocatorRawMem<RefCntWeakPtr<DeviceContextImplType>>> m_wpDeferredContexts;
 
+    // Views and SRBs are created and destroyed from many threads at once, so their allocators
+    // use per-thread block caches and return empty pages to the raw allocator.
+    static constexpr Uint32 MaxEmptyObjPages   = 4;
+    static constexpr Uint32 ObjThreadCacheSize = 32;
+
     IMemoryAllocator&         m_RawMemAllocator;      ///< Raw memory allocator
     FixedBlockMemoryAllocator m_TexObjAllocator;      ///< Allocator for texture objects
     FixedBlockMemoryAllocator m_TexViewObjAllocator;  ///< Allocator for texture view objects
@@ -723,6 +743,8 @@ protected:
     FixedBlockMemoryAllocator m_PipeResSignAllocator; ///< Allocator for pipeline resource signature objects
     FixedBlockMemoryAllocator m_MemObjAllocator;      ///< Allocator for device memory objects
     FixedBlockMemoryAllocator m_PSOCacheAllocator;    ///< Allocator for pipeline state cache objects
+
+    std::unique_ptr<ThreadPool> m_pPipelineCompilationThreadPool;
 };
 
 } // namespace Diligent
@@ -30,6 +30,8 @@
 /// \file
 /// Implementation of the Diligent::ShaderBase template class
 
+#include <atomic>
+#include <future>
 #include <vector>
 
 #include "Shader.h"
@@ -38,6 +40,7 @@
 #include "PlatformMisc.hpp"
 #include "EngineMemory.h"
 #include "Align.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -93,6 +96,70 @@ public:
     }
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_Shader, TDeviceObjectBase)
+
+    /// Implementation of IShader::GetStatus().
+    virtual SHADER_STATUS DILIGENT_CALL_TYPE GetStatus(bool WaitForCompletion) override final
+    {
+        if (WaitForCompletion)
+            WaitForAsyncCompileTask();
+
+        return m_Status.load(std::memory_order_acquire);
+    }
+
+    bool IsReady() const
+    {
+        return m_Status.load(std::memory_order_acquire) == SHADER_STATUS_READY;
+    }
+
+    void WaitForAsyncCompileTask() const
+    {
+        if (m_AsyncCompileTask.valid())
+            m_AsyncCompileTask.wait();
+    }
+
+protected:
+    /// Returns true if the shader should be compiled by the pipeline compilation thread pool,
+    /// i.e. if SHADER_COMPILE_FLAG_ASYNCHRONOUS flag is set and the device has the pool.
+    bool IsAsyncCompilationEnabled(SHADER_COMPILE_FLAGS Flags) const
+    {
+        return (Flags & SHADER_COMPILE_FLAG_ASYNCHRONOUS) != 0 && this->m_pDevice->GetPipelineCompilationThreadPool() != nullptr;
+    }
+
+    /// Compiles the shader on the pipeline compilation thread pool.
+
+    /// The shader status is SHADER_STATUS_COMPILING until the handler completes.
+    ///
+    /// \remarks  The handler must not rely on any data owned by the create info struct
+    ///           and must keep strong references to all objects it uses.
+    ///           The derived class must call WaitForAsyncCompileTask() in its destructor.
+    template <typename HandlerType>
+    void RunAsyncCompileTask(HandlerType&& Handler)
+    {
+        auto* pThreadPool = this->m_pDevice->GetPipelineCompilationThreadPool();
+        VERIFY_EXPR(pThreadPool != nullptr);
+
+        m_Status.store(SHADER_STATUS_COMPILING, std::memory_order_relaxed);
+
+        auto Task = [this, Handler = std::forward<HandlerType>(Handler)]() mutable {
+            try
+            {
+                Handler();
+                m_Status.store(SHADER_STATUS_READY, std::memory_order_release);
+            }
+            catch (...)
+            {
+                LOG_ERROR_MESSAGE("Failed to asynchronously compile shader '", (this->m_Desc.Name != nullptr ? this->m_Desc.Name : ""), "'");
+                m_Status.store(SHADER_STATUS_FAILED, std::memory_order_release);
+            }
+        };
+        m_AsyncCompileTask = pThreadPool->Enqueue(std::move(Task)).share();
+    }
+
+private:
+    std::atomic<SHADER_STATUS> m_Status{SHADER_STATUS_READY};
+
+    /// Asynchronous compilation task, see RunAsyncCompileTask().
+    std::shared_future<void> m_AsyncCompileTask;
 };
 
 } // namespace Diligent
@@ -30,9 +30,18 @@
 /// \file
 /// Implementation of the Diligent::StateObjectsRegistry template class
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <new>
+#include <functional>
+#include <algorithm>
+
 #include "DeviceObject.h"
-#include <unordered_map>
-#include "STDAllocator.hpp"
+#include "GraphicsTypes.h"
+#include "MemoryAllocator.h"
+#include "RefCntAutoPtr.hpp"
+#include "DebugUtilities.hpp"
 
 namespace Diligent
 {
@@ -50,26 +59,43 @@ namespace Diligent
 ///   the protection section.
 /// - Strong pointers will cause circular references and result in memory leaks.
 /// \remarks
-/// Only weak pointers provide thread-safe solution. The object is either atomically destroyed,
-/// so that no other thread can obtain a reference to it through weak pointers. Or it is atomically
+/// Only weak references provide thread-safe solution. The object is either atomically destroyed,
+/// so that no other thread can obtain a reference to it through the weak reference. Or it is atomically
 /// locked, so that strong reference is obtained. In this case no other thread can destroy the object,
-/// because there is at least one strong reference now. Note however that removing the object from the
-/// registry in the object's destructor may cause a deadlock at the point where Find() locks the weak pointer:
-/// if other thread has started dtor, the object will be locked by Diligent::RefCountedObject::Release().
-/// If after that this thread locks the registry first, it will be waiting for the object to unlock in
-/// Diligent::RefCntWeakPtr::Lock(), while the dtor thread will be waiting for the registry to unlock.
+/// because there is at least one strong reference now.
+///
+/// \remarks
+/// The registry is an open-addressing hash table with linear probing. Every entry stores the precomputed
+/// hash of the description, the description itself and a weak reference to the object. Entries are
+/// immutable: an entry is replaced or removed by atomically updating the table slot.
+/// Find() is lock-free: it never blocks and never modifies the table. Add() and Purge() are serialized
+/// by a mutex. Removed entries and old tables are retired and only released when no thread is executing
+/// Find(). Entries of destroyed objects are purged incrementally by Add() a few slots at a time,
+/// and all at once when the table is resized.
 template <typename ResourceDescType>
 class StateObjectsRegistry
 {
 public:
-    /// Number of outstanding deleted objects to purge the registry.
-    static constexpr int DeletedObjectsToPurge = 32;
+    /// The number of table slots checked for destroyed objects by every Add() call while there
+    /// are outstanding deleted objects.
+    static constexpr Uint32 PurgeStepSize = 16;
+
+    /// Initial and minimal hash table capacity.
+    static constexpr Uint32 MinCapacity = 64;
 
     StateObjectsRegistry(IMemoryAllocator& RawAllocator, const Char* RegistryName) :
-        m_NumDeletedObjects{0},
-        m_DescToObjHashMap(STD_ALLOCATOR_RAW_MEM(HashMapElem, RawAllocator, "Allocator for unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject> >")),
+        m_RawAllocator{RawAllocator},
         m_RegistryName{RegistryName}
-    {}
+    {
+        m_pTable.store(CreateTable(MinCapacity));
+    }
+
+    // clang-format off
+    StateObjectsRegistry           (const StateObjectsRegistry&)  = delete;
+    StateObjectsRegistry           (      StateObjectsRegistry&&) = delete;
+    StateObjectsRegistry& operator=(const StateObjectsRegistry&)  = delete;
+    StateObjectsRegistry& operator=(      StateObjectsRegistry&&) = delete;
+    // clang-format on
 
     ~StateObjectsRegistry()
     {
@@ -79,136 +105,447 @@ public:
         // may only be expired references in the registry. After we
         // purge it, the registry must be empty.
         Purge();
-        VERIFY(m_DescToObjHashMap.empty(), "DescToObjHashMap is not empty");
+        VERIFY(m_NumObjects.load() == 0, "The registry is not empty");
+        VERIFY_EXPR(m_NumActiveReaders.load() == 0);
+
+        auto* pTable = m_pTable.load();
+        for (Uint32 i = 0; i <= pTable->Mask; ++i)
+        {
+            auto* pEntry = pTable->Slots[i].load();
+            if (pEntry != nullptr && pEntry != Tombstone())
+                DestroyEntry(pEntry);
+        }
+        DestroyTable(pTable);
+
+        for (auto* pEntry : m_RetiredEntries)
+            DestroyEntry(pEntry);
+        for (auto* pRetiredTable : m_RetiredTables)
+            DestroyTable(pRetiredTable);
+    }
+
+    /// Computes the hash of the object description.
+
+    /// The hash may be passed to Find() and Add() to avoid hashing the description twice.
+    static size_t ComputeHash(const ResourceDescType& ObjectDesc)
+    {
+        return std::hash<ResourceDescType>{}(ObjectDesc);
     }
 
     /// Adds a new object to the registry
 
     /// \param [in] ObjectDesc - object description.
-    /// \param [in] pObject - pointer to the object.
+    /// \param [in] Hash       - object description hash, see ComputeHash().
+    /// \param [in] pObject    - pointer to the object.
     ///
-    /// Besides adding a new object, the function also checks the number of
-    /// outstanding deleted objects and calls Purge() if the number has reached
-    /// the threshold value DeletedObjectsToPurge. Creating a state object is
-    /// assumed to be an expensive operation and should be performed during
-    /// the initialization. Occasional purge operations should not add significant
-    /// cost to it.
-    void Add(const ResourceDescType& ObjectDesc, IDeviceObject* pObject)
+    /// Besides adding a new object, the function also incrementally purges
+    /// entries of deleted objects if there are any. Creating a state object is
+    /// assumed to be an expensive operation, so the small fixed amount of
+    /// purge work should not add significant cost to it.
+    void Add(const ResourceDescType& ObjectDesc, size_t Hash, IDeviceObject* pObject)
     {
-        ThreadingTools::LockHelper Lock(m_LockFlag);
+        VERIFY_EXPR(Hash == ComputeHash(ObjectDesc));
+        std::lock_guard<std::mutex> Lock{m_WriteMtx};
 
-        // If the number of outstanding deleted objects reached the threshold value,
-        // purge the registry. Since we have exclusive access now, it is safe
-        // to do.
-        if (m_NumDeletedObjects >= DeletedObjectsToPurge)
-        {
-            Purge();
-            m_NumDeletedObjects = 0;
-        }
+        auto* pTable = m_pTable.load();
+        if (m_NumDeletedObjects.load() > 0)
+            PurgeSlots(*pTable, PurgeStepSize);
+
+        // Keep the load factor (including tombstones) below 3/4
+        if ((pTable->NumUsedSlots + 1) * 4 > (pTable->Mask + 1) * 3)
+            pTable = Rehash(*pTable);
+
+        auto* pNewEntry = CreateEntry(ObjectDesc, Hash, pObject);
 
-        // Try to construct the new element in place
-        auto Elems = m_DescToObjHashMap.emplace(std::make_pair(ObjectDesc, Diligent::RefCntWeakPtr<IDeviceObject>(pObject)));
-        // It is theoretically possible that the same object can be found
-        // in the registry. This might happen if two threads try to create
-        // the same object at the same time. They both will not find the
-        // object and then will create and try to add it.
-        //
-        // If the object already exists, we replace the existing reference.
-        // This is safer as there might be scenarios where existing reference
-        // might be expired. For instance, two threads try to create the same
-        // object which is not in the registry. The first thread creates
-        // the object, adds it to the registry and then releases it. After that
-        // the second thread creates the same object and tries to add it to
-        // the registry. It will find an existing expired reference to the
-        // object.
-        if (!Elems.second)
+        const Uint32 InvalidSlot = ~Uint32{0};
+        Uint32       InsertSlot  = InvalidSlot;
+        for (Uint32 n = 0, i = static_cast<Uint32>(Hash) & pTable->Mask; n <= pTable->Mask; ++n, i = (i + 1) & pTable->Mask)
         {
-            VERIFY(Elems.first->first == ObjectDesc, "Incorrect object description");
-            LOG_WARNING_MESSAGE("Object named '", Elems.first->first.Name,
-                                "' with the same description already exists in the registry."
-                                "Replacing with the new object named '",
-                                ObjectDesc.Name ? ObjectDesc.Name : "", "'.");
-            Elems.first->second = pObject;
+            auto* pEntry = pTable->Slots[i].load();
+            if (pEntry == nullptr)
+            {
+                if (InsertSlot == InvalidSlot)
+                {
+                    InsertSlot = i;
+                    ++pTable->NumUsedSlots;
+                }
+                break;
+            }
+
+            if (pEntry == Tombstone())
+            {
+                // Reuse the first tombstone, but keep probing to make sure the object is not in the table
+                if (InsertSlot == InvalidSlot)
+                    InsertSlot = i;
+                continue;
+            }
+
+            if (pEntry->Hash == Hash && pEntry->Desc == ObjectDesc)
+            {
+                // It is theoretically possible that the same object can be found
+                // in the registry. This might happen if two threads try to create
+                // the same object at the same time. They both will not find the
+                // object and then will create and try to add it.
+                //
+                // If the object already exists, we replace the existing reference.
+                // This is safer as there might be scenarios where existing reference
+                // might be expired. For instance, two threads try to create the same
+                // object which is not in the registry. The first thread creates
+                // the object, adds it to the registry and then releases it. After that
+                // the second thread creates the same object and tries to add it to
+                // the registry. It will find an existing expired reference to the
+                // object.
+                if (!pEntry->IsExpired())
+                {
+                    LOG_WARNING_MESSAGE("Object named '", pEntry->Desc.Name ? pEntry->Desc.Name : "",
+                                        "' with the same description already exists in the registry."
+                                        "Replacing with the new object named '",
+                                        ObjectDesc.Name ? ObjectDesc.Name : "", "'.");
+                }
+                else
+                {
+                    OnDeletedObjectPurged();
+                }
+                pTable->Slots[i].store(pNewEntry);
+                m_RetiredEntries.push_back(pEntry);
+                ReleaseRetiredObjects();
+                return;
+            }
         }
+        VERIFY(InsertSlot != InvalidSlot, "There must always be free slots in the table as the load factor is kept below 3/4");
+
+        pTable->Slots[InsertSlot].store(pNewEntry);
+        m_NumObjects.fetch_add(1);
+
+        ReleaseRetiredObjects();
+    }
+
+    void Add(const ResourceDescType& ObjectDesc, IDeviceObject* pObject)
+    {
+        Add(ObjectDesc, ComputeHash(ObjectDesc), pObject);
     }
 
     /// Finds the object in the registry
-    void Find(const ResourceDescType& Desc, IDeviceObject** ppObject)
+
+    /// \param [in]  Desc     - object description.
+    /// \param [in]  Hash     - object description hash, see ComputeHash().
+    /// \param [out] ppObject - address of the memory location where the pointer to the
+    ///                         object will be written, or null if no live object was found.
+    ///
+    /// \remarks The method is lock-free and may be safely called from multiple threads
+    ///          concurrently with Add() and Purge().
+    void Find(const ResourceDescType& Desc, size_t Hash, IDeviceObject** ppObject)
     {
         VERIFY(*ppObject == nullptr, "Overwriting reference to existing object may cause memory leaks");
+        VERIFY_EXPR(Hash == ComputeHash(Desc));
         *ppObject = nullptr;
-        ThreadingTools::LockHelper Lock(m_LockFlag);
 
-        auto It = m_DescToObjHashMap.find(Desc);
-        if (It != m_DescToObjHashMap.end())
+        // Entries and tables that the writer retires while this counter is not zero are kept alive.
+        // Note that the counter must be incremented before the table is loaded.
+        m_NumActiveReaders.fetch_add(1);
+
+        const auto* pTable = m_pTable.load();
+        for (Uint32 n = 0, i = static_cast<Uint32>(Hash) & pTable->Mask; n <= pTable->Mask; ++n, i = (i + 1) & pTable->Mask)
         {
+            auto* pEntry = pTable->Slots[i].load();
+            if (pEntry == nullptr)
+                break;
+
+            if (pEntry == Tombstone() || pEntry->Hash != Hash || !(pEntry->Desc == Desc))
+                continue;
+
             // Try to obtain strong reference to the object.
             // This is an atomic operation and we either get
             // a new strong reference or object has been destroyed
             // and we get null.
-            auto pObject = It->second.Lock();
-            if (pObject)
+            // Note that the entry's weak reference keeps the reference counters alive.
+            RefCntAutoPtr<IObject> pOwner;
+            pEntry->pRefCounters->GetObject(&pOwner);
+            if (pOwner)
             {
-                *ppObject = pObject.Detach();
+                pEntry->pObject->AddRef();
+                *ppObject = pEntry->pObject;
                 //LOG_INFO_MESSAGE( "Equivalent of the requested state object named \"", Desc.Name ? Desc.Name : "", "\" found in the ", m_RegistryName, " registry. Reusing existing object.");
             }
-            else
+            // Expired entry will be replaced by Add() or removed by the purge
+            break;
+        }
+
+        m_NumActiveReaders.fetch_add(-1);
+
+        if (*ppObject != nullptr)
+            m_NumHits.fetch_add(1, std::memory_order_relaxed);
+        else
+            m_NumMisses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Find(const ResourceDescType& Desc, IDeviceObject** ppObject)
+    {
+        Find(Desc, ComputeHash(Desc), ppObject);
+    }
+
+    /// Purges all outstanding deleted objects from the registry
+    void Purge()
+    {
+        std::lock_guard<std::mutex> Lock{m_WriteMtx};
+
+        const auto NumPurgedObjects = m_NumPurgedObjects.load();
+
+        auto* pTable = m_pTable.load();
+        PurgeSlots(*pTable, pTable->Mask + 1);
+        ReleaseRetiredObjects();
+
+        LOG_INFO_MESSAGE("Purged ", m_NumPurgedObjects.load() - NumPurgedObjects, " deleted objects from the ", m_RegistryName, " registry");
+    }
+
+    /// Increments the number of outstanding deleted objects.
+    /// While this number is not zero, Add() will incrementally purge the registry.
+    void ReportDeletedObject()
+    {
+        m_NumDeletedObjects.fetch_add(1);
+    }
+
+    /// Returns the registry statistics
+    StateObjectsRegistryStats GetStats() const
+    {
+        StateObjectsRegistryStats Stats;
+        Stats.NumObjects       = m_NumObjects.load();
+        Stats.NumHits          = m_NumHits.load();
+        Stats.NumMisses        = m_NumMisses.load();
+        Stats.NumPurgedObjects = m_NumPurgedObjects.load();
+        return Stats;
+    }
+
+private:
+    struct Entry
+    {
+        const size_t           Hash;
+        const ResourceDescType Desc;
+        IDeviceObject* const   pObject;
+        // Entry holds a weak reference, so that the reference counters outlive the object
+        IReferenceCounters* const pRefCounters;
+
+        Entry(const ResourceDescType& _Desc, size_t _Hash, IDeviceObject* _pObject) :
+            // clang-format off
+            Hash        {_Hash},
+            Desc        {_Desc},
+            pObject     {_pObject},
+            pRefCounters{_pObject->GetReferenceCounters()}
+        // clang-format on
+        {
+            pRefCounters->AddWeakRef();
+        }
+
+        ~Entry()
+        {
+            pRefCounters->ReleaseWeakRef();
+        }
+
+        // Note that the object may be destroyed at any moment after this method returns false.
+        // Expired objects, however, never come back to life.
+        bool IsExpired() const
+        {
+            return pRefCounters->GetNumStrongRefs() == 0;
+        }
+    };
+
+    struct Table
+    {
+        // Capacity - 1. Capacity is always a power of two.
+        const Uint32 Mask;
+
+        // The number of non-empty slots, including tombstones. Only accessed by the writer.
+        Uint32 NumUsedSlots = 0;
+
+        std::atomic<Entry*>* const Slots;
+
+        Table(Uint32 _Mask, std::atomic<Entry*>* _Slots) :
+            Mask{_Mask},
+            Slots{_Slots}
+        {}
+    };
+
+    // Marks slots of removed entries so that probing continues past them
+    static Entry* Tombstone()
+    {
+        return reinterpret_cast<Entry*>(alignof(Entry));
+    }
+
+    Entry* CreateEntry(const ResourceDescType& Desc, size_t Hash, IDeviceObject* pObject)
+    {
+        void* pMem = m_RawAllocator.Allocate(sizeof(Entry), "State object registry entry", __FILE__, __LINE__);
+        return new (pMem) Entry{Desc, Hash, pObject};
+    }
+
+    void DestroyEntry(Entry* pEntry)
+    {
+        pEntry->~Entry();
+        m_RawAllocator.Free(pEntry);
+    }
+
+    Table* CreateTable(Uint32 Capacity)
+    {
+        VERIFY_EXPR(Capacity >= MinCapacity && (Capacity & (Capacity - 1)) == 0);
+
+        // Allocate the table and the slots in a single memory block
+        const size_t SlotsOffset = (sizeof(Table) + alignof(std::atomic<Entry*>) - 1) & ~(alignof(std::atomic<Entry*>) - 1);
+        auto*        pMem        = static_cast<Uint8*>(m_RawAllocator.Allocate(SlotsOffset + sizeof(std::atomic<Entry*>) * Capacity, "State object registry hash table", __FILE__, __LINE__));
+
+        auto* pSlots = reinterpret_cast<std::atomic<Entry*>*>(pMem + SlotsOffset);
+        for (Uint32 i = 0; i < Capacity; ++i)
+            new (pSlots + i) std::atomic<Entry*>{nullptr};
+
+        return new (pMem) Table{Capacity - 1, pSlots};
+    }
+
+    void DestroyTable(Table* pTable)
+    {
+        // std::atomic<Entry*> and Table are trivially destructible
+        m_RawAllocator.Free(pTable);
+    }
+
+    // Removes expired entries from NumSlots slots starting at the purge cursor.
+    // Must be called by the writer.
+    void PurgeSlots(Table& Tbl, Uint32 NumSlots)
+    {
+        NumSlots = std::min(NumSlots, Tbl.Mask + 1);
+        for (Uint32 n = 0; n < NumSlots; ++n)
+        {
+            const auto i = m_PurgeCursor++ & Tbl.Mask;
+
+            auto* pEntry = Tbl.Slots[i].load();
+            if (pEntry == nullptr || pEntry == Tombstone())
+                continue;
+
+            // Note that the object may be expiring while we are checking it. It is not a problem
+            // if we miss an expired object as it will be removed next time.
+            if (pEntry->IsExpired())
             {
-                // Expired object found: remove it from the map
-                m_DescToObjHashMap.erase(It);
-                Atomics::AtomicDecrement(m_NumDeletedObjects);
+                // If the next slot is empty, no probe sequence continues past this slot
+                // and it can be cleared instead of being marked with a tombstone.
+                if (Tbl.Slots[(i + 1) & Tbl.Mask].load() == nullptr)
+                {
+                    Tbl.Slots[i].store(nullptr);
+                    --Tbl.NumUsedSlots;
+                }
+                else
+                {
+                    Tbl.Slots[i].store(Tombstone());
+                }
+                m_RetiredEntries.push_back(pEntry);
+                m_NumObjects.fetch_add(-1);
+                OnDeletedObjectPurged();
             }
         }
     }
 
-    /// Purges outstanding deleted objects from the registry
-    void Purge()
+    // Moves live entries to a new table and retires the old one.
+    // Must be called by the writer.
+    Table* Rehash(Table& OldTable)
     {
-        Uint32 NumPurgedObjects = 0;
-        auto   It               = m_DescToObjHashMap.begin();
-        while (It != m_DescToObjHashMap.end())
+        Uint32 NumLiveObjects = 0;
+        for (Uint32 i = 0; i <= OldTable.Mask; ++i)
+        {
+            auto* pEntry = OldTable.Slots[i].load();
+            if (pEntry != nullptr && pEntry != Tombstone() && !pEntry->IsExpired())
+                ++NumLiveObjects;
+        }
+
+        // Make sure that the new table is at most half full
+        Uint32 Capacity = MinCapacity;
+        while ((NumLiveObjects + 1) * 2 > Capacity)
+            Capacity *= 2;
+
+        auto* pNewTable = CreateTable(Capacity);
+        for (Uint32 i = 0; i <= OldTable.Mask; ++i)
         {
-            auto NextIt = It;
-            ++NextIt;
-            // Note that IsValid() is not a thread-safe function in the sense that it
-            // can give false positive results. The only thread-safe way to check if the
-            // object is alive is to lock the weak pointer, but that requires thread
-            // synchronization. We will immediately unlock the pointer anyway, so we
-            // want to detect 100% expired pointers. IsValid() does provide that information
-            // because once a weak pointer becomes invalid, it will be invalid
-            // until it is destroyed. It is not a problem if we miss an expired weak
-            // pointer as it will definitely be removed next time.
-            if (!It->second.IsValid())
+            auto* pEntry = OldTable.Slots[i].load();
+            if (pEntry == nullptr || pEntry == Tombstone())
+                continue;
+
+            // The object may have expired since we counted live objects, but not the other way around
+            if (pEntry->IsExpired())
             {
-                m_DescToObjHashMap.erase(It);
-                ++NumPurgedObjects;
+                m_RetiredEntries.push_back(pEntry);
+                m_NumObjects.fetch_add(-1);
+                OnDeletedObjectPurged();
+                continue;
             }
 
-            It = NextIt;
+            auto j = static_cast<Uint32>(pEntry->Hash) & pNewTable->Mask;
+            while (pNewTable->Slots[j].load(std::memory_order_relaxed) != nullptr)
+                j = (j + 1) & pNewTable->Mask;
+            pNewTable->Slots[j].store(pEntry, std::memory_order_relaxed);
+            ++pNewTable->NumUsedSlots;
         }
-        LOG_INFO_MESSAGE("Purged ", NumPurgedObjects, " deleted objects from the ", m_RegistryName, " registry");
+
+        // Readers that have loaded the old table may still be accessing it
+        m_pTable.store(pNewTable);
+        m_RetiredTables.push_back(&OldTable);
+
+        return pNewTable;
     }
 
-    /// Increments the number of outstanding deleted objects.
-    /// When this number reaches DeletedObjectsToPurge, Purge() will
-    /// be called.
-    void ReportDeletedObject()
+    void OnDeletedObjectPurged()
     {
-        Atomics::AtomicIncrement(m_NumDeletedObjects);
+        m_NumPurgedObjects.fetch_add(1, std::memory_order_relaxed);
+
+        // The counter is only a hint and must not go below zero
+        auto NumDeleted = m_NumDeletedObjects.load();
+        while (NumDeleted > 0 && !m_NumDeletedObjects.compare_exchange_weak(NumDeleted, NumDeleted - 1))
+        {}
+    }
+
+    // Releases retired entries and tables if no reader may be accessing them.
+    // Must be called by the writer after the retired objects have been unlinked.
+    void ReleaseRetiredObjects()
+    {
+        if (m_RetiredEntries.empty() && m_RetiredTables.empty())
+            return;
+
+        // Every reader that might have obtained a pointer to a retired object incremented the counter
+        // before loading the table and has not decremented it yet. Readers that start after this
+        // point can't observe the retired objects as they have already been unlinked.
+        if (m_NumActiveReaders.load() != 0)
+            return;
+
+        for (auto* pEntry : m_RetiredEntries)
+            DestroyEntry(pEntry);
+        m_RetiredEntries.clear();
+
+        for (auto* pTable : m_RetiredTables)
+            DestroyTable(pTable);
+        m_RetiredTables.clear();
     }
 
 private:
-    /// Lock flag to protect the m_DescToObjHashMap
-    ThreadingTools::LockFlag m_LockFlag;
+    IMemoryAllocator& m_RawAllocator;
+
+    /// Current hash table
+    std::atomic<Table*> m_pTable{nullptr};
+
+    /// The number of threads currently executing Find()
+    std::atomic<Int32> m_NumActiveReaders{0};
+
+    /// Mutex that serializes Add() and Purge()
+    std::mutex m_WriteMtx;
+
+    /// Slot index where the next incremental purge step starts
+    Uint32 m_PurgeCursor = 0;
+
+    /// Entries and tables that have been removed, but may still be accessed by readers
+    std::vector<Entry*> m_RetiredEntries;
+    std::vector<Table*> m_RetiredTables;
 
     /// Number of outstanding deleted objects that have not been purged
-    Atomics::AtomicLong m_NumDeletedObjects;
+    std::atomic<Int32> m_NumDeletedObjects{0};
 
-    /// Hash map that stores weak pointers to the referenced objects
-    typedef std::pair<const ResourceDescType, RefCntWeakPtr<IDeviceObject>>                                                                                           HashMapElem;
-    std::unordered_map<ResourceDescType, RefCntWeakPtr<IDeviceObject>, std::hash<ResourceDescType>, std::equal_to<ResourceDescType>, STDAllocatorRawMem<HashMapElem>> m_DescToObjHashMap;
+    std::atomic<Uint32> m_NumObjects{0};
+    std::atomic<Uint64> m_NumHits{0};
+    std::atomic<Uint64> m_NumMisses{0};
+    std::atomic<Uint64> m_NumPurgedObjects{0};
 
     /// Registry name used for debug output
     const String m_RegistryName;
 };
+
 } // namespace Diligent
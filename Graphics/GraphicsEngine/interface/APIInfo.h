@@ -30,7 +30,7 @@
 /// \file
 /// Diligent API information
 
-#define DILIGENT_API_VERSION 250012
+#define DILIGENT_API_VERSION 250025
 
 #include "../../../Primitives/interface/BasicTypes.h"
 
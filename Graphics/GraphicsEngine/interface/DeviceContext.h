@@ -373,6 +373,147 @@ struct DrawIndexedAttribs
 typedef struct DrawIndexedAttribs DrawIndexedAttribs;
 
 
+/// Defines a single draw item of the multi-draw command.
+
+/// This structure is used by IDeviceContext::MultiDraw().
+struct MultiDrawItem
+{
+    /// The number of vertices to draw.
+    Uint32 NumVertices         DEFAULT_INITIALIZER(0);
+
+    /// LOCATION (or INDEX, but NOT the byte offset) of the first vertex in the
+    /// vertex buffer to start reading vertices from.
+    Uint32 StartVertexLocation DEFAULT_INITIALIZER(0);
+
+#if DILIGENT_CPP_INTERFACE
+    constexpr MultiDrawItem() noexcept {}
+
+    constexpr MultiDrawItem(Uint32 _NumVertices,
+                            Uint32 _StartVertexLocation = 0) noexcept :
+        NumVertices        {_NumVertices        },
+        StartVertexLocation{_StartVertexLocation}
+    {}
+#endif
+};
+typedef struct MultiDrawItem MultiDrawItem;
+
+
+/// Defines the multi-draw command attributes.
+
+/// This structure is used by IDeviceContext::MultiDraw().
+struct MultiDrawAttribs
+{
+    /// The number of draw items in pDrawItems array.
+    Uint32               NumDrawItems          DEFAULT_INITIALIZER(0);
+
+    /// A pointer to the array of NumDrawItems draw items.
+    const MultiDrawItem* pDrawItems            DEFAULT_INITIALIZER(nullptr);
+
+    /// Additional flags, see Diligent::DRAW_FLAGS.
+    DRAW_FLAGS           Flags                 DEFAULT_INITIALIZER(DRAW_FLAG_NONE);
+
+    /// The number of instances to draw for every draw item.
+    Uint32               NumInstances          DEFAULT_INITIALIZER(1);
+
+    /// LOCATION (or INDEX, but NOT the byte offset) in the vertex buffer to start
+    /// reading instance data from. The same location is used by all draw items.
+    Uint32               FirstInstanceLocation DEFAULT_INITIALIZER(0);
+
+#if DILIGENT_CPP_INTERFACE
+    constexpr MultiDrawAttribs() noexcept {}
+
+    constexpr MultiDrawAttribs(Uint32               _NumDrawItems,
+                               const MultiDrawItem* _pDrawItems,
+                               DRAW_FLAGS           _Flags,
+                               Uint32               _NumInstances          = 1,
+                               Uint32               _FirstInstanceLocation = 0) noexcept :
+        NumDrawItems         {_NumDrawItems         },
+        pDrawItems           {_pDrawItems           },
+        Flags                {_Flags                },
+        NumInstances         {_NumInstances         },
+        FirstInstanceLocation{_FirstInstanceLocation}
+    {}
+#endif
+};
+typedef struct MultiDrawAttribs MultiDrawAttribs;
+
+
+/// Defines a single draw item of the indexed multi-draw command.
+
+/// This structure is used by IDeviceContext::MultiDrawIndexed().
+struct MultiDrawIndexedItem
+{
+    /// The number of indices to draw.
+    Uint32 NumIndices         DEFAULT_INITIALIZER(0);
+
+    /// LOCATION (NOT the byte offset) of the first index in
+    /// the index buffer to start reading indices from.
+    Uint32 FirstIndexLocation DEFAULT_INITIALIZER(0);
+
+    /// A constant which is added to each index before accessing the vertex buffer.
+    Uint32 BaseVertex         DEFAULT_INITIALIZER(0);
+
+#if DILIGENT_CPP_INTERFACE
+    constexpr MultiDrawIndexedItem() noexcept {}
+
+    constexpr MultiDrawIndexedItem(Uint32 _NumIndices,
+                                   Uint32 _FirstIndexLocation = 0,
+                                   Uint32 _BaseVertex         = 0) noexcept :
+        NumIndices        {_NumIndices        },
+        FirstIndexLocation{_FirstIndexLocation},
+        BaseVertex        {_BaseVertex        }
+    {}
+#endif
+};
+typedef struct MultiDrawIndexedItem MultiDrawIndexedItem;
+
+
+/// Defines the indexed multi-draw command attributes.
+
+/// This structure is used by IDeviceContext::MultiDrawIndexed().
+struct MultiDrawIndexedAttribs
+{
+    /// The number of draw items in pDrawItems array.
+    Uint32                      NumDrawItems          DEFAULT_INITIALIZER(0);
+
+    /// A pointer to the array of NumDrawItems draw items.
+    const MultiDrawIndexedItem* pDrawItems            DEFAULT_INITIALIZER(nullptr);
+
+    /// The type of elements in the index buffer.
+    /// Allowed values: VT_UINT16 and VT_UINT32.
+    VALUE_TYPE                  IndexType             DEFAULT_INITIALIZER(VT_UNDEFINED);
+
+    /// Additional flags, see Diligent::DRAW_FLAGS.
+    DRAW_FLAGS                  Flags                 DEFAULT_INITIALIZER(DRAW_FLAG_NONE);
+
+    /// The number of instances to draw for every draw item.
+    Uint32                      NumInstances          DEFAULT_INITIALIZER(1);
+
+    /// LOCATION (or INDEX, but NOT the byte offset) in the vertex buffer to start
+    /// reading instance data from. The same location is used by all draw items.
+    Uint32                      FirstInstanceLocation DEFAULT_INITIALIZER(0);
+
+#if DILIGENT_CPP_INTERFACE
+    constexpr MultiDrawIndexedAttribs() noexcept {}
+
+    constexpr MultiDrawIndexedAttribs(Uint32                      _NumDrawItems,
+                                      const MultiDrawIndexedItem* _pDrawItems,
+                                      VALUE_TYPE                  _IndexType,
+                                      DRAW_FLAGS                  _Flags,
+                                      Uint32                      _NumInstances          = 1,
+                                      Uint32                      _FirstInstanceLocation = 0) noexcept :
+        NumDrawItems         {_NumDrawItems         },
+        pDrawItems           {_pDrawItems           },
+        IndexType            {_IndexType            },
+        Flags                {_Flags                },
+        NumInstances         {_NumInstances         },
+        FirstInstanceLocation{_FirstInstanceLocation}
+    {}
+#endif
+};
+typedef struct MultiDrawIndexedAttribs MultiDrawIndexedAttribs;
+
+
 /// Defines the indirect draw command attributes.
 
 /// This structure is used by IDeviceContext::DrawIndirect().
@@ -2373,6 +2514,42 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContext, IObject)
                                      const DrawIndexedAttribs REF Attribs) PURE;
 
 
+    /// Executes a sequence of draw commands that share the same pipeline state and resources.
+
+    /// \param [in] Attribs - Multi-draw command attributes, see Diligent::MultiDrawAttribs for details.
+    ///
+    /// \remarks  The draw state is prepared and validated once for all items, which makes the command
+    ///           considerably cheaper than the equivalent sequence of IDeviceContext::Draw() calls.
+    ///           If Diligent::DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW capability is supported, the items
+    ///           are submitted with a single native command. Otherwise, they are recorded in a loop.
+    ///
+    ///           If Diligent::DRAW_FLAG_VERIFY_STATES flag is set, the method reads the state of vertex
+    ///           buffers, so no other threads are allowed to alter the states of the same resources.
+    ///           It is OK to read these states.
+    ///
+    /// \remarks Supported contexts: graphics.
+    VIRTUAL void METHOD(MultiDraw)(THIS_
+                                   const MultiDrawAttribs REF Attribs) PURE;
+
+
+    /// Executes a sequence of indexed draw commands that share the same pipeline state and resources.
+
+    /// \param [in] Attribs - Indexed multi-draw command attributes, see Diligent::MultiDrawIndexedAttribs for details.
+    ///
+    /// \remarks  The draw state is prepared and validated once for all items, which makes the command
+    ///           considerably cheaper than the equivalent sequence of IDeviceContext::DrawIndexed() calls.
+    ///           If Diligent::DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW capability is supported, the items
+    ///           are submitted with a single native command. Otherwise, they are recorded in a loop.
+    ///
+    ///           If Diligent::DRAW_FLAG_VERIFY_STATES flag is set, the method reads the state of vertex/index
+    ///           buffers, so no other threads are allowed to alter the states of the same resources.
+    ///           It is OK to read these states.
+    ///
+    /// \remarks Supported contexts: graphics.
+    VIRTUAL void METHOD(MultiDrawIndexed)(THIS_
+                                          const MultiDrawIndexedAttribs REF Attribs) PURE;
+
+
     /// Executes an indirect draw command.
 
     /// \param [in] Attribs - Structure describing the command attributes, see Diligent::DrawIndirectAttribs for details.
@@ -3213,6 +3390,8 @@ DILIGENT_END_INTERFACE
 #    define IDeviceContext_EndRenderPass(This)                      CALL_IFACE_METHOD(DeviceContext, EndRenderPass,             This)
 #    define IDeviceContext_Draw(This, ...)                          CALL_IFACE_METHOD(DeviceContext, Draw,                      This, __VA_ARGS__)
 #    define IDeviceContext_DrawIndexed(This, ...)                   CALL_IFACE_METHOD(DeviceContext, DrawIndexed,               This, __VA_ARGS__)
+#    define IDeviceContext_MultiDraw(This, ...)                     CALL_IFACE_METHOD(DeviceContext, MultiDraw,                 This, __VA_ARGS__)
+#    define IDeviceContext_MultiDrawIndexed(This, ...)              CALL_IFACE_METHOD(DeviceContext, MultiDrawIndexed,          This, __VA_ARGS__)
 #    define IDeviceContext_DrawIndirect(This, ...)                  CALL_IFACE_METHOD(DeviceContext, DrawIndirect,              This, __VA_ARGS__)
 #    define IDeviceContext_DrawIndexedIndirect(This, ...)           CALL_IFACE_METHOD(DeviceContext, DrawIndexedIndirect,       This, __VA_ARGS__)
 #    define IDeviceContext_DrawMesh(This, ...)                      CALL_IFACE_METHOD(DeviceContext, DrawMesh,                  This, __VA_ARGS__)
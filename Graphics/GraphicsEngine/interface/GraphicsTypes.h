@@ -1729,6 +1729,10 @@ struct DeviceFeatures
     /// Indicates if device supports sparse (aka tiled or partially resident) resources.
     DEVICE_FEATURE_STATE SparseResources                  DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
 
+    /// Indicates if device supports pipeline specialization constants,
+    /// see Diligent::PipelineStateCreateInfo::pSpecializationConstants.
+    DEVICE_FEATURE_STATE SpecializationConstants          DEFAULT_INITIALIZER(DEVICE_FEATURE_STATE_DISABLED);
+
 #if DILIGENT_CPP_INTERFACE
     constexpr DeviceFeatures() noexcept {}
 
@@ -1771,10 +1775,11 @@ struct DeviceFeatures
         TileShaders                       {State},
         TransferQueueTimestampQueries     {State},
         VariableRateShading               {State},
-        SparseResources                   {State}
+        SparseResources                   {State},
+        SpecializationConstants           {State}
     {
 #   if defined(_MSC_VER) && defined(_WIN64)
-        static_assert(sizeof(*this) == 39, "Did you add a new feature to DeviceFeatures? Please handle its status above.");
+        static_assert(sizeof(*this) == 40, "Did you add a new feature to DeviceFeatures? Please handle its status above.");
 #   endif
     }
 #endif
@@ -2593,7 +2598,13 @@ DILIGENT_TYPED_ENUM(DRAW_COMMAND_CAP_FLAGS, Uint16)
     /// Indicates that IDeviceContext::DrawIndirect() and IDeviceContext::DrawIndexedIndirect()
     /// commands may take non-null counter buffer. If this flag is not set, the number
     /// of draw commands must be specified through the command attributes.
-    DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNTER_BUFFER = 1u << 4
+    DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNTER_BUFFER = 1u << 4,
+
+    /// Indicates that device natively supports IDeviceContext::MultiDraw() and
+    /// IDeviceContext::MultiDrawIndexed() commands. When this flag is not set, the
+    /// commands are recorded as a sequence of individual draws after the state
+    /// has been prepared once.
+    DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW            = 1u << 5
 };
 DEFINE_FLAG_ENUM_OPERATORS(DRAW_COMMAND_CAP_FLAGS);
 
@@ -2937,6 +2948,14 @@ struct EngineCreateInfo
     ///           deferred contexts to let the engine release stale resources.
     Uint32                   NumDeferredContexts    DEFAULT_INITIALIZER(0);
 
+    /// The number of threads in the pool that compiles pipelines created with
+    /// PSO_CREATE_FLAG_ASYNCHRONOUS flag (see Diligent::PSO_CREATE_FLAGS) and shaders
+    /// created with SHADER_COMPILE_FLAG_ASYNCHRONOUS flag (see Diligent::SHADER_COMPILE_FLAGS).
+    /// If this value is zero, the pool is not created and all pipelines and shaders are created synchronously.
+    ///
+    /// \remarks   Only Vulkan backend uses the pool; other backends create all pipelines and shaders synchronously.
+    Uint32                   NumPipelineCompilationThreads DEFAULT_INITIALIZER(0);
+
     /// Requested device features.
 
     /// \remarks    If a feature is requested to be enabled, but is not supported
@@ -3000,6 +3019,17 @@ struct EngineGLCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// Use IRenderDevice::GetDeviceInfo().NDC to get current NDC.
     bool         ZeroToOneNDZ DEFAULT_INITIALIZER(false);
 
+    /// Size of the dynamic heap, a persistently mapped buffer that is used to suballocate
+    /// memory for USAGE_DYNAMIC uniform buffers when they are mapped with MAP_FLAG_DISCARD.
+    /// The memory is recycled when the GPU completes the frame (see IDeviceContext::FinishFrame()).
+    ///
+    /// \remarks    The heap requires OpenGL 4.4 or GL_ARB_buffer_storage extension. If the
+    ///             size is zero or the heap is not supported, dynamic buffers are mapped
+    ///             with glMapBufferRange().
+    ///             As in other backends, contents of the buffers that use the heap is discarded
+    ///             at the end of every frame, so a buffer must be mapped before its first use in any frame.
+    Uint32       DynamicHeapSize DEFAULT_INITIALIZER(0);
+
 #if DILIGENT_CPP_INTERFACE
     EngineGLCreateInfo() noexcept : EngineGLCreateInfo{EngineCreateInfo{}}
     {}
@@ -3377,6 +3407,11 @@ struct EngineVkCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// features when compiling shaders from HLSL.
     const char* pDxCompilerPath DEFAULT_INITIALIZER(nullptr);
 
+    /// The maximum number of shader modules kept in the device-level cache.
+    /// Pipelines that use the same shader with compatible resource layouts share
+    /// the cached module. Zero disables the cache.
+    Uint32 ShaderModuleCacheSize DEFAULT_INITIALIZER(1024);
+
 #if DILIGENT_CPP_INTERFACE
     EngineVkCreateInfo() noexcept :
         EngineVkCreateInfo{EngineCreateInfo{}}
@@ -3717,6 +3752,44 @@ struct SparseTextureFormatInfo
 };
 typedef struct SparseTextureFormatInfo SparseTextureFormatInfo;
 
+
+/// State objects registry statistics, see IRenderDevice::GetSamplerRegistryStats().
+struct StateObjectsRegistryStats
+{
+    /// The number of objects currently referenced by the registry, including
+    /// destroyed objects that have not been purged yet.
+    Uint32 NumObjects       DEFAULT_INITIALIZER(0);
+
+    /// The number of lookups that returned an existing object.
+    Uint64 NumHits          DEFAULT_INITIALIZER(0);
+
+    /// The number of lookups that did not find a live object, so that
+    /// a new object had to be created.
+    Uint64 NumMisses        DEFAULT_INITIALIZER(0);
+
+    /// The total number of destroyed objects purged from the registry.
+    Uint64 NumPurgedObjects DEFAULT_INITIALIZER(0);
+};
+typedef struct StateObjectsRegistryStats StateObjectsRegistryStats;
+
+
+/// Shader module cache statistics, see IRenderDeviceVk::GetShaderModuleCacheStats().
+struct ShaderModuleCacheStats
+{
+    /// The number of shader modules currently kept in the cache.
+    Uint32 NumModules   DEFAULT_INITIALIZER(0);
+
+    /// The number of pipeline shader stages that reused a cached module.
+    Uint64 NumHits      DEFAULT_INITIALIZER(0);
+
+    /// The number of pipeline shader stages that had to create a new module.
+    Uint64 NumMisses    DEFAULT_INITIALIZER(0);
+
+    /// The total number of modules evicted from the cache.
+    Uint64 NumEvictions DEFAULT_INITIALIZER(0);
+};
+typedef struct ShaderModuleCacheStats ShaderModuleCacheStats;
+
 /// Pipeline stage flags.
 
 /// These flags mirror [VkPipelineStageFlagBits](https://www.khronos.org/registry/vulkan/specs/1.1-extensions/html/vkspec.html#VkPipelineStageFlagBits)
@@ -435,10 +435,81 @@ DILIGENT_TYPED_ENUM(PSO_CREATE_FLAGS, Uint32)
     /// that is not found in any of the designated shader stages.
     /// Use this flag to silence these warnings.
     PSO_CREATE_FLAG_IGNORE_MISSING_IMMUTABLE_SAMPLERS = 0x02,
+
+    /// Create the pipeline asynchronously.
+
+    /// When this flag is set, the pipeline layout is initialized on the calling thread,
+    /// while shader module creation and backend pipeline compilation are performed by
+    /// the device's pipeline compilation thread pool (see EngineCreateInfo::NumPipelineCompilationThreads).
+    /// The pipeline state object is returned immediately; use IPipelineState::GetStatus()
+    /// to query if the pipeline is ready. Shader resource bindings may be created and
+    /// static resources may be bound while the pipeline is being compiled.
+    /// Draw and dispatch commands that use a pipeline that is not ready are skipped.
+    /// If the compilation has failed, the error is logged the first time such a command is skipped.
+    /// The pipeline layout is initialized from the shader resources, so the calling thread waits
+    /// for the shaders created with SHADER_COMPILE_FLAG_ASYNCHRONOUS flag to compile.
+    ///
+    /// \remarks   Only Vulkan backend honors this flag, and only for graphics and compute pipelines.
+    ///            All other backends, as well as ray tracing pipelines, ignore the flag and create the
+    ///            pipeline synchronously. The flag is also ignored if the device was created without
+    ///            the pipeline compilation thread pool (EngineCreateInfo::NumPipelineCompilationThreads is 0).
+    PSO_CREATE_FLAG_ASYNCHRONOUS                      = 0x04,
 };
 DEFINE_FLAG_ENUM_OPERATORS(PSO_CREATE_FLAGS);
 
 
+/// Pipeline state status
+DILIGENT_TYPED_ENUM(PIPELINE_STATE_STATUS, Uint8)
+{
+    /// The pipeline is being compiled asynchronously.
+    PIPELINE_STATE_STATUS_COMPILING = 0,
+
+    /// The pipeline is ready to be used.
+    PIPELINE_STATE_STATUS_READY,
+
+    /// Asynchronous pipeline compilation has failed.
+    PIPELINE_STATE_STATUS_FAILED
+};
+
+
+/// Pipeline specialization constant.
+
+/// Specialization constants are set when the pipeline is created and allow
+/// a single compiled shader to be used by multiple pipelines with
+/// different constant values.
+struct SpecializationConstant
+{
+    /// The name of the constant as it is declared in the shader.
+    const Char* Name         DEFAULT_INITIALIZER(nullptr);
+
+    /// Shader stages this constant applies to. Shader stages used by different
+    /// constants with the same name must not overlap.
+    SHADER_TYPE ShaderStages DEFAULT_INITIALIZER(SHADER_TYPE_UNKNOWN);
+
+    /// The size of the constant value, in bytes. Must match the size of the
+    /// constant type in the shader (4 bytes for bool, int, uint and float).
+    Uint32      Size         DEFAULT_INITIALIZER(0);
+
+    /// A pointer to the constant value.
+    const void* pValue       DEFAULT_INITIALIZER(nullptr);
+
+#if DILIGENT_CPP_INTERFACE
+    constexpr SpecializationConstant() noexcept {}
+
+    constexpr SpecializationConstant(const Char* _Name,
+                                     SHADER_TYPE _ShaderStages,
+                                     Uint32      _Size,
+                                     const void* _pValue) noexcept :
+        Name        {_Name        },
+        ShaderStages{_ShaderStages},
+        Size        {_Size        },
+        pValue      {_pValue      }
+    {}
+#endif
+};
+typedef struct SpecializationConstant SpecializationConstant;
+
+
 /// Pipeline state creation attributes
 struct PipelineStateCreateInfo
 {
@@ -469,6 +540,24 @@ struct PipelineStateCreateInfo
     /// data is used to create the PSO. Otherwise, the PSO
     /// is added to the cache.
     IPipelineStateCache* pPSOCache DEFAULT_INITIALIZER(nullptr);
+
+    /// The number of elements in pSpecializationConstants array.
+    Uint32 NumSpecializationConstants DEFAULT_INITIALIZER(0);
+
+    /// An array of NumSpecializationConstants specialization constants,
+    /// see Diligent::SpecializationConstant.
+    ///
+    /// \remarks   Constants that are not declared by any shader of the pipeline are ignored.
+    ///            The device must support DeviceFeatures::SpecializationConstants feature.
+    ///            In Vulkan, the values are passed to the pipeline through VkSpecializationInfo.
+    ///            In OpenGL, the constants are emulated by patching the source of GLSL shaders,
+    ///            where they must be declared on a single line as
+    ///            `layout(constant_id = N) const <type> <Name> = <default value>;`.
+    ///            The type must be bool, int, uint, float or double. Other qualifiers and
+    ///            multiple declarators are not supported, and the shader fails to compile.
+    ///            The source is not preprocessed, so declarations in disabled conditional
+    ///            blocks are also specialized.
+    const SpecializationConstant* pSpecializationConstants DEFAULT_INITIALIZER(nullptr);
 };
 typedef struct PipelineStateCreateInfo PipelineStateCreateInfo;
 
@@ -789,6 +878,17 @@ DILIGENT_BEGIN_INTERFACE(IPipelineState, IDeviceObject)
     /// \return     Pointer to pipeline resource signature interface.
     VIRTUAL IPipelineResourceSignature* METHOD(GetResourceSignature)(THIS_
                                                                      Uint32 Index) CONST PURE;
+
+    /// Returns the pipeline state status, see Diligent::PIPELINE_STATE_STATUS.
+
+    /// \param [in] WaitForCompletion - If true, the method waits until asynchronous
+    ///                                 compilation of the pipeline completes.
+    /// \return     Pipeline state status.
+    ///
+    /// \remarks  Pipelines that were not created with PSO_CREATE_FLAG_ASYNCHRONOUS flag
+    ///           are always ready.
+    VIRTUAL PIPELINE_STATE_STATUS METHOD(GetStatus)(THIS_
+                                                    bool WaitForCompletion DEFAULT_VALUE(false)) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -812,6 +912,7 @@ DILIGENT_END_INTERFACE
 #    define IPipelineState_IsCompatibleWith(This, ...)             CALL_IFACE_METHOD(PipelineState, IsCompatibleWith,             This, __VA_ARGS__)
 #    define IPipelineState_GetResourceSignatureCount(This)         CALL_IFACE_METHOD(PipelineState, GetResourceSignatureCount,    This)
 #    define IPipelineState_GetResourceSignature(This, ...)         CALL_IFACE_METHOD(PipelineState, GetResourceSignature,         This, __VA_ARGS__)
+#    define IPipelineState_GetStatus(This, ...)                    CALL_IFACE_METHOD(PipelineState, GetStatus,                    This, __VA_ARGS__)
 
 // clang-format on
 
@@ -50,12 +50,24 @@ struct PipelineStateCacheCreateInfo
 {
     PipelineStateCacheDesc Desc;
 
-    // AZ TODO
-    /// All fields can be null to create an empty cache
+    /// Data previously returned by IPipelineStateCache::GetData(), or null to create an empty cache.
+
+    /// The data contain compiled shaders and pipeline entries keyed by the hash of their
+    /// create info as well as the driver cache data. Data that do not start with the engine
+    /// header (e.g. a raw blob returned by vkGetPipelineCacheData) are passed to the driver as is.
+    /// Data created by a device of a different type or by an incompatible engine version are ignored.
+    /// The data are copied, so the memory may be released once the cache object is created.
     const void* pCacheData    DEFAULT_INITIALIZER(nullptr);
 
     /// The size of data pointed to by pCacheData
     Uint32      CacheDataSize DEFAULT_INITIALIZER(0);
+
+    /// Path to the file with the data previously returned by IPipelineStateCache::GetData().
+
+    /// The file is used when pCacheData is null. Where supported, the file is memory-mapped
+    /// until the cache object is destroyed, and the entries are read from the mapping on
+    /// demand without copying.
+    const Char* FilePath      DEFAULT_INITIALIZER(nullptr);
 };
 typedef struct PipelineStateCacheCreateInfo PipelineStateCacheCreateInfo;
 
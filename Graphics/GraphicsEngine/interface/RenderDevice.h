@@ -389,6 +389,14 @@ DILIGENT_BEGIN_INTERFACE(IRenderDevice, IObject)
     /// \remark This method does not increment the reference counter of the returned interface,
     ///         so the application should not call Release().
     VIRTUAL IEngineFactory* METHOD(GetEngineFactory)(THIS) CONST PURE;
+
+
+    /// Returns the statistics of the sampler registry.
+
+    /// Samplers with identical descriptions are shared: IRenderDevice::CreateSampler() first looks
+    /// up the registry and only creates a new object if no live sampler with the same description exists.
+    /// The statistics can be used to check the sampler deduplication rate.
+    VIRTUAL StateObjectsRegistryStats METHOD(GetSamplerRegistryStats)(THIS) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -422,6 +430,7 @@ DILIGENT_END_INTERFACE
 #    define IRenderDevice_ReleaseStaleResources(This, ...)           CALL_IFACE_METHOD(RenderDevice, ReleaseStaleResources,           This, __VA_ARGS__)
 #    define IRenderDevice_IdleGPU(This)                              CALL_IFACE_METHOD(RenderDevice, IdleGPU,                         This)
 #    define IRenderDevice_GetEngineFactory(This)                     CALL_IFACE_METHOD(RenderDevice, GetEngineFactory,                This)
+#    define IRenderDevice_GetSamplerRegistryStats(This)              CALL_IFACE_METHOD(RenderDevice, GetSamplerRegistryStats,         This)
 // clang-format on
 
 #endif
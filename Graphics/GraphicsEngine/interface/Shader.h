@@ -190,10 +190,40 @@ DILIGENT_TYPED_ENUM(SHADER_COMPILE_FLAGS, Uint32)
     /// Enable unbounded resource arrays (e.g. Texture2D g_Texture[]).
     SHADER_COMPILE_FLAG_ENABLE_UNBOUNDED_ARRAYS = 0x01,
 
-    SHADER_COMPILE_FLAG_LAST = SHADER_COMPILE_FLAG_ENABLE_UNBOUNDED_ARRAYS
+    /// Compile the shader asynchronously.
+
+    /// When this flag is set, the shader object is returned immediately, while compilation
+    /// and reflection are performed by the device's pipeline compilation thread pool
+    /// (see EngineCreateInfo::NumPipelineCompilationThreads). Use IShader::GetStatus()
+    /// to query if the shader is ready. Methods that return the shader resources wait
+    /// until the compilation completes. Pipeline creation also waits for its shaders and
+    /// fails if any of them has failed to compile.
+    ///
+    /// \remarks   Only Vulkan backend honors this flag; other backends compile the shader synchronously.
+    ///            The flag is also ignored if the device was created without the pipeline compilation
+    ///            thread pool (EngineCreateInfo::NumPipelineCompilationThreads is 0).
+    ///            Compiler output is not returned through ShaderCreateInfo::ppCompilerOutput when the
+    ///            shader is compiled asynchronously; compilation errors are written to the log.
+    SHADER_COMPILE_FLAG_ASYNCHRONOUS = 0x02,
+
+    SHADER_COMPILE_FLAG_LAST = SHADER_COMPILE_FLAG_ASYNCHRONOUS
 };
 DEFINE_FLAG_ENUM_OPERATORS(SHADER_COMPILE_FLAGS);
 
+
+/// Shader status
+DILIGENT_TYPED_ENUM(SHADER_STATUS, Uint8)
+{
+    /// The shader is being compiled asynchronously.
+    SHADER_STATUS_COMPILING = 0,
+
+    /// The shader is ready to be used.
+    SHADER_STATUS_READY,
+
+    /// Asynchronous shader compilation has failed.
+    SHADER_STATUS_FAILED
+};
+
 // clang-format on
 
 
@@ -320,6 +350,26 @@ struct ShaderCreateInfo
     /// output message. The second one is the full shader source code including definitions added
     /// by the engine. Data blob object must be released by the client.
     IDataBlob** ppCompilerOutput DEFAULT_INITIALIZER(nullptr);
+
+    /// Optional pre-reflected shader resources, when ByteCode is not null.
+
+    /// \note This option is only supported by Vulkan backend. The data must be obtained
+    ///       from IShaderVk::GetReflectionData() for the same byte code. If the data does
+    ///       not match the byte code, it is ignored and the byte code is reflected.
+    ///       This member is ignored if ByteCode is null.
+    const void* pReflectionData DEFAULT_INITIALIZER(nullptr);
+
+    /// Size of the reflection data, in bytes.
+    size_t ReflectionDataSize DEFAULT_INITIALIZER(0);
+
+    /// Optional pipeline state cache to load the compiled shader from and store it to.
+
+    /// \note This option is only supported by Vulkan backend and is ignored by other backends.
+    ///       When a shader is created from source code or a file, the byte code and the reflection
+    ///       data are stored in the cache along with the hashes of all files read through
+    ///       pShaderSourceStreamFactory. If a matching entry is found and none of these files have
+    ///       changed, compilation and reflection are skipped.
+    struct IPipelineStateCache* pPSOCache DEFAULT_INITIALIZER(nullptr);
 };
 typedef struct ShaderCreateInfo ShaderCreateInfo;
 
@@ -411,6 +461,17 @@ DILIGENT_BEGIN_INTERFACE(IShader, IDeviceObject)
     VIRTUAL void METHOD(GetResourceDesc)(THIS_
                                          Uint32 Index,
                                          ShaderResourceDesc REF ResourceDesc) CONST PURE;
+
+    /// Returns the shader status, see Diligent::SHADER_STATUS.
+
+    /// \param [in] WaitForCompletion - If true, the method waits until asynchronous
+    ///                                 compilation of the shader completes.
+    /// \return     Shader status.
+    ///
+    /// \remarks  Shaders that were not created with SHADER_COMPILE_FLAG_ASYNCHRONOUS flag
+    ///           are always ready.
+    VIRTUAL SHADER_STATUS METHOD(GetStatus)(THIS_
+                                            bool WaitForCompletion DEFAULT_VALUE(false)) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -424,6 +485,7 @@ DILIGENT_END_INTERFACE
 
 #    define IShader_GetResourceCount(This)     CALL_IFACE_METHOD(Shader, GetResourceCount, This)
 #    define IShader_GetResourceDesc(This, ...) CALL_IFACE_METHOD(Shader, GetResourceDesc,  This, __VA_ARGS__)
+#    define IShader_GetStatus(This, ...)       CALL_IFACE_METHOD(Shader, GetStatus,        This, __VA_ARGS__)
 
 // clang-format on
 
@@ -27,18 +27,40 @@
 
 #include "DefaultShaderSourceStreamFactory.h"
 
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include "ObjectBase.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "EngineMemory.h"
 #include "BasicFileStream.hpp"
+#include "MemoryFileStream.hpp"
+#include "DataBlobImpl.hpp"
+#include "HashUtils.hpp"
 
 namespace Diligent
 {
 
+// {6B2C1F4E-93A7-4D58-B1E0-5C27D8A4F316}
+static const INTERFACE_ID IID_DefaultShaderSourceStreamFactory =
+    {0x6b2c1f4e, 0x93a7, 0x4d58, {0xb1, 0xe0, 0x5c, 0x27, 0xd8, 0xa4, 0xf3, 0x16}};
+
 class DefaultShaderSourceStreamFactory final : public ObjectBase<IShaderSourceInputStreamFactory>
 {
 public:
-    DefaultShaderSourceStreamFactory(IReferenceCounters* pRefCounters, const Char* SearchDirectories);
+    using TBase = ObjectBase<IShaderSourceInputStreamFactory>;
+
+    DefaultShaderSourceStreamFactory(IReferenceCounters* pRefCounters,
+                                     const Char*         SearchDirectories,
+                                     bool                EnableCache,
+                                     Uint32              RevalidationPeriodMs,
+                                     Uint64              MaxCacheSize);
+
+    virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final;
 
     virtual void DILIGENT_CALL_TYPE CreateInputStream(const Char* Name, IFileStream** ppStream) override final;
 
@@ -46,14 +68,51 @@ public:
                                                        CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS Flags,
                                                        IFileStream**                           ppStream) override final;
 
-    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_IShaderSourceInputStreamFactory, ObjectBase<IShaderSourceInputStreamFactory>);
+    ShaderSourceStreamFactoryStats GetStats();
 
 private:
+    RefCntAutoPtr<BasicFileStream> OpenFile(const Char* Name, String& FullPath);
+
+    RefCntAutoPtr<IDataBlob> GetCachedFile(const Char* Name);
+
+    void EraseLocked(const String& Name);
+    void EvictLocked();
+
     std::vector<String> m_SearchDirectories;
+
+    std::atomic<Uint64> m_NumFileSystemCalls{0};
+
+    struct CachedFile
+    {
+        String                   FullPath;
+        Uint64                   ModificationTime = 0;
+        ContentHash              Hash;
+        RefCntAutoPtr<IDataBlob> pData;
+
+        std::chrono::steady_clock::time_point LastValidationTime;
+
+        std::list<String>::iterator LRUPos;
+    };
+
+    const bool                      m_CacheEnabled;
+    const std::chrono::milliseconds m_RevalidationPeriod;
+    const Uint64                    m_MaxCacheSize;
+
+    std::mutex                             m_CacheMtx;
+    std::unordered_map<String, CachedFile> m_Cache; // Keyed by the requested name
+    std::list<String>                      m_LRU;   // Most recently used names first
+    ShaderSourceStreamFactoryStats         m_CacheStats;
 };
 
-DefaultShaderSourceStreamFactory::DefaultShaderSourceStreamFactory(IReferenceCounters* pRefCounters, const Char* SearchDirectories) :
-    ObjectBase<IShaderSourceInputStreamFactory>(pRefCounters)
+DefaultShaderSourceStreamFactory::DefaultShaderSourceStreamFactory(IReferenceCounters* pRefCounters,
+                                                                   const Char*         SearchDirectories,
+                                                                   bool                EnableCache,
+                                                                   Uint32              RevalidationPeriodMs,
+                                                                   Uint64              MaxCacheSize) :
+    TBase{pRefCounters},
+    m_CacheEnabled{EnableCache},
+    m_RevalidationPeriod{RevalidationPeriodMs},
+    m_MaxCacheSize{MaxCacheSize}
 {
     while (SearchDirectories)
     {
@@ -80,6 +139,151 @@ DefaultShaderSourceStreamFactory::DefaultShaderSourceStreamFactory(IReferenceCou
     m_SearchDirectories.push_back("");
 }
 
+void DefaultShaderSourceStreamFactory::QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface)
+{
+    if (ppInterface == nullptr)
+        return;
+
+    if (IID == IID_DefaultShaderSourceStreamFactory || IID == IID_IShaderSourceInputStreamFactory)
+    {
+        *ppInterface = this;
+        (*ppInterface)->AddRef();
+    }
+    else
+    {
+        TBase::QueryInterface(IID, ppInterface);
+    }
+}
+
+RefCntAutoPtr<BasicFileStream> DefaultShaderSourceStreamFactory::OpenFile(const Char* Name, String& FullPath)
+{
+    for (const auto& SearchDir : m_SearchDirectories)
+    {
+        FullPath = SearchDir + ((Name[0] == '\\' || Name[0] == '/') ? Name + 1 : Name);
+        m_NumFileSystemCalls.fetch_add(1);
+        if (!FileSystem::FileExists(FullPath.c_str()))
+            continue;
+
+        m_NumFileSystemCalls.fetch_add(1);
+        RefCntAutoPtr<BasicFileStream> pBasicFileStream{MakeNewRCObj<BasicFileStream>()(FullPath.c_str(), EFileAccessMode::Read)};
+        if (pBasicFileStream->IsValid())
+            return pBasicFileStream;
+    }
+
+    FullPath.clear();
+    return {};
+}
+
+void DefaultShaderSourceStreamFactory::EraseLocked(const String& Name)
+{
+    auto it = m_Cache.find(Name);
+    if (it == m_Cache.end())
+        return;
+
+    m_CacheStats.CachedDataSize -= it->second.pData->GetSize();
+    m_LRU.erase(it->second.LRUPos);
+    m_Cache.erase(it);
+}
+
+void DefaultShaderSourceStreamFactory::EvictLocked()
+{
+    while (m_CacheStats.CachedDataSize > m_MaxCacheSize && !m_LRU.empty())
+    {
+        // Copy the name as erasing the entry destroys the list node
+        const String Name = m_LRU.back();
+        EraseLocked(Name);
+        ++m_CacheStats.NumEvictions;
+    }
+}
+
+RefCntAutoPtr<IDataBlob> DefaultShaderSourceStreamFactory::GetCachedFile(const Char* Name)
+{
+    const auto CurrTime = std::chrono::steady_clock::now();
+
+    String CachedPath;
+    {
+        std::lock_guard<std::mutex> Lock{m_CacheMtx};
+
+        auto it = m_Cache.find(Name);
+        if (it != m_Cache.end())
+        {
+            if (CurrTime - it->second.LastValidationTime < m_RevalidationPeriod)
+            {
+                ++m_CacheStats.NumHits;
+                m_LRU.splice(m_LRU.begin(), m_LRU, it->second.LRUPos);
+                return it->second.pData;
+            }
+            CachedPath = it->second.FullPath;
+        }
+    }
+
+    if (!CachedPath.empty())
+    {
+        // Query the modification time without holding the lock
+        m_NumFileSystemCalls.fetch_add(1);
+        const auto ModificationTime = FileSystem::GetFileModificationTime(CachedPath.c_str());
+
+        std::lock_guard<std::mutex> Lock{m_CacheMtx};
+
+        auto it = m_Cache.find(Name);
+        // Zero modification time means that it is unknown (e.g. the file is in Android assets),
+        // in which case the file is never invalidated.
+        if (it != m_Cache.end() && it->second.ModificationTime == ModificationTime)
+        {
+            it->second.LastValidationTime = CurrTime;
+            ++m_CacheStats.NumHits;
+            m_LRU.splice(m_LRU.begin(), m_LRU, it->second.LRUPos);
+            return it->second.pData;
+        }
+    }
+
+    // The file is not in the cache or has been modified: (re)load it
+    String FullPath;
+    auto   pFileStream = OpenFile(Name, FullPath);
+    if (!pFileStream)
+    {
+        std::lock_guard<std::mutex> Lock{m_CacheMtx};
+        EraseLocked(Name);
+        return {};
+    }
+
+    m_NumFileSystemCalls.fetch_add(1);
+    CachedFile NewFile;
+    NewFile.ModificationTime   = FileSystem::GetFileModificationTime(FullPath.c_str());
+    NewFile.LastValidationTime = CurrTime;
+    NewFile.FullPath           = std::move(FullPath);
+    NewFile.pData              = MakeNewRCObj<DataBlobImpl>()(0);
+    pFileStream->ReadBlob(NewFile.pData);
+    NewFile.Hash = ComputeContentHash(NewFile.pData->GetConstDataPtr(), NewFile.pData->GetSize());
+
+    std::lock_guard<std::mutex> Lock{m_CacheMtx};
+
+    ++m_CacheStats.NumMisses;
+    auto it = m_Cache.find(Name);
+    if (it != m_Cache.end())
+    {
+        ++m_CacheStats.NumInvalidations;
+        // If the contents have not changed, keep the existing blob so that
+        // the data pointers held by the clients remain the same.
+        if (it->second.Hash == NewFile.Hash)
+            NewFile.pData = it->second.pData;
+        EraseLocked(Name);
+    }
+
+    auto pData = NewFile.pData;
+    if (pData->GetSize() <= m_MaxCacheSize)
+    {
+        m_LRU.emplace_front(Name);
+        NewFile.LRUPos = m_LRU.begin();
+        m_CacheStats.CachedDataSize += pData->GetSize();
+        m_Cache.emplace(Name, std::move(NewFile));
+        // The new file is at the front of the list and fits into the cache, so it is never evicted
+        EvictLocked();
+    }
+
+    return pData;
+}
+
 void DefaultShaderSourceStreamFactory::CreateInputStream(const Char*   Name,
                                                          IFileStream** ppStream)
 {
@@ -90,36 +294,43 @@ void DefaultShaderSourceStreamFactory::CreateInputStream2(const Char*
                                                           CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS Flags,
                                                           IFileStream**                           ppStream)
 {
-    bool                                     bFileCreated = false;
-    Diligent::RefCntAutoPtr<BasicFileStream> pBasicFileStream;
-    for (const auto& SearchDir : m_SearchDirectories)
+    DEV_CHECK_ERR(ppStream != nullptr, "ppStream must not be null");
+
+    *ppStream = nullptr;
+    if (Name != nullptr && Name[0] != 0)
     {
-        String FullPath = SearchDir + ((Name[0] == '\\' || Name[0] == '/') ? Name + 1 : Name);
-        if (!FileSystem::FileExists(FullPath.c_str()))
-            continue;
-        pBasicFileStream = MakeNewRCObj<BasicFileStream>()(FullPath.c_str(), EFileAccessMode::Read);
-        if (pBasicFileStream->IsValid())
+        if (m_CacheEnabled)
         {
-            bFileCreated = true;
-            break;
+            if (auto pData = GetCachedFile(Name))
+            {
+                auto* pMemStream = MakeNewRCObj<MemoryFileStream>()(pData, true);
+                pMemStream->QueryInterface(IID_FileStream, reinterpret_cast<IObject**>(ppStream));
+            }
         }
         else
         {
-            pBasicFileStream.Release();
+            String FullPath;
+            if (auto pBasicFileStream = OpenFile(Name, FullPath))
+                pBasicFileStream->QueryInterface(IID_FileStream, reinterpret_cast<IObject**>(ppStream));
         }
     }
-    if (bFileCreated)
+
+    if (*ppStream == nullptr && (Flags & CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT) == 0)
     {
-        pBasicFileStream->QueryInterface(IID_FileStream, reinterpret_cast<IObject**>(ppStream));
+        LOG_ERROR("Failed to create input stream for source file ", (Name != nullptr ? Name : "<null>"));
     }
-    else
+}
+
+ShaderSourceStreamFactoryStats DefaultShaderSourceStreamFactory::GetStats()
+{
+    ShaderSourceStreamFactoryStats Stats;
     {
-        *ppStream = nullptr;
-        if ((Flags & CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT) == 0)
-        {
-            LOG_ERROR("Failed to create input stream for source file ", Name);
-        }
+        std::lock_guard<std::mutex> Lock{m_CacheMtx};
+        Stats                = m_CacheStats;
+        Stats.NumCachedFiles = m_Cache.size();
     }
+    Stats.NumFileSystemCalls = m_NumFileSystemCalls.load();
+    return Stats;
 }
 
 void CreateDefaultShaderSourceStreamFactory(const Char*                       SearchDirectories,
@@ -128,8 +339,25 @@ void CreateDefaultShaderSourceStreamFactory(const Char*                       Se
 
     auto&                             Allocator = GetRawAllocator();
     DefaultShaderSourceStreamFactory* pStreamFactory =
-        NEW_RC_OBJ(Allocator, "DefaultShaderSourceStreamFactory instance", DefaultShaderSourceStreamFactory)(SearchDirectories);
+        NEW_RC_OBJ(Allocator, "DefaultShaderSourceStreamFactory instance", DefaultShaderSourceStreamFactory)(SearchDirectories, false, 0, 0);
     pStreamFactory->QueryInterface(IID_IShaderSourceInputStreamFactory, reinterpret_cast<IObject**>(ppShaderSourceStreamFactory));
 }
 
+void CreateCachingShaderSourceStreamFactory(const Char*                       SearchDirectories,
+                                            Uint32                            RevalidationPeriodMs,
+                                            Uint64                            MaxCacheSize,
+                                            IShaderSourceInputStreamFactory** ppShaderSourceStreamFactory)
+{
+    auto&                             Allocator = GetRawAllocator();
+    DefaultShaderSourceStreamFactory* pStreamFactory =
+        NEW_RC_OBJ(Allocator, "DefaultShaderSourceStreamFactory instance", DefaultShaderSourceStreamFactory)(SearchDirectories, true, RevalidationPeriodMs, MaxCacheSize);
+    pStreamFactory->QueryInterface(IID_IShaderSourceInputStreamFactory, reinterpret_cast<IObject**>(ppShaderSourceStreamFactory));
+}
+
+ShaderSourceStreamFactoryStats GetShaderSourceStreamFactoryStats(IShaderSourceInputStreamFactory* pFactory)
+{
+    RefCntAutoPtr<DefaultShaderSourceStreamFactory> pDefaultFactory{pFactory, IID_DefaultShaderSourceStreamFactory};
+    return pDefaultFactory ? pDefaultFactory->GetStats() : ShaderSourceStreamFactoryStats{};
+}
+
 } // namespace Diligent
@@ -77,6 +77,40 @@ bool VerifyDrawIndexedAttribs(const DrawIndexedAttribs& Attribs)
     return true;
 }
 
+bool VerifyMultiDrawAttribs(const MultiDrawAttribs& Attribs)
+{
+#define CHECK_MULTI_DRAW_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, "Multi-draw attribs are invalid: ", __VA_ARGS__)
+
+    CHECK_MULTI_DRAW_ATTRIBS(Attribs.NumDrawItems == 0 || Attribs.pDrawItems != nullptr, "pDrawItems must not be null when NumDrawItems (", Attribs.NumDrawItems, ") is not zero.");
+
+    if (Attribs.NumDrawItems == 0)
+        LOG_INFO_MESSAGE("MultiDrawAttribs.NumDrawItems is 0. This is OK as the draw command will be ignored, but may be unintentional.");
+    if (Attribs.NumInstances == 0)
+        LOG_INFO_MESSAGE("MultiDrawAttribs.NumInstances is 0. This is OK as the draw command will be ignored, but may be unintentional.");
+
+#undef CHECK_MULTI_DRAW_ATTRIBS
+
+    return true;
+}
+
+bool VerifyMultiDrawIndexedAttribs(const MultiDrawIndexedAttribs& Attribs)
+{
+#define CHECK_MULTI_DRAW_INDEXED_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, "Multi-draw indexed attribs are invalid: ", __VA_ARGS__)
+
+    CHECK_MULTI_DRAW_INDEXED_ATTRIBS(Attribs.IndexType == VT_UINT16 || Attribs.IndexType == VT_UINT32,
+                                     "IndexType (", GetValueTypeString(Attribs.IndexType), ") must be VT_UINT16 or VT_UINT32.");
+    CHECK_MULTI_DRAW_INDEXED_ATTRIBS(Attribs.NumDrawItems == 0 || Attribs.pDrawItems != nullptr, "pDrawItems must not be null when NumDrawItems (", Attribs.NumDrawItems, ") is not zero.");
+
+    if (Attribs.NumDrawItems == 0)
+        LOG_INFO_MESSAGE("MultiDrawIndexedAttribs.NumDrawItems is 0. This is OK as the draw command will be ignored, but may be unintentional.");
+    if (Attribs.NumInstances == 0)
+        LOG_INFO_MESSAGE("MultiDrawIndexedAttribs.NumInstances is 0. This is OK as the draw command will be ignored, but may be unintentional.");
+
+#undef CHECK_MULTI_DRAW_INDEXED_ATTRIBS
+
+    return true;
+}
+
 bool VerifyDrawMeshAttribs(Uint32 MaxDrawMeshTasksCount, const DrawMeshAttribs& Attribs)
 {
 #define CHECK_DRAW_MESH_ATTRIBS(Expr, ...) CHECK_PARAMETER(Expr, "Draw mesh attribs are invalid: ", __VA_ARGS__)
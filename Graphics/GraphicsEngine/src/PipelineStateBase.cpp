@@ -387,6 +387,54 @@ void ValidatePipelineResourceLayoutDesc(const PipelineStateDesc& PSODesc, const
 }
 
 
+void ValidateSpecializationConstants(const PipelineStateCreateInfo& CreateInfo, const DeviceFeatures& Features) noexcept(false)
+{
+    const auto& PSODesc = CreateInfo.PSODesc;
+
+    if (CreateInfo.NumSpecializationConstants != 0 && CreateInfo.pSpecializationConstants == nullptr)
+        LOG_PSO_ERROR_AND_THROW("pSpecializationConstants is null, but NumSpecializationConstants (", CreateInfo.NumSpecializationConstants, ") is not zero.");
+
+    if (CreateInfo.NumSpecializationConstants == 0)
+        return;
+
+    if (!Features.SpecializationConstants)
+        LOG_PSO_ERROR_AND_THROW("Specialization constants require SpecializationConstants feature.");
+
+    std::unordered_multimap<HashMapStringKey, SHADER_TYPE, HashMapStringKey::Hasher> UniqueConstants;
+    for (Uint32 i = 0; i < CreateInfo.NumSpecializationConstants; ++i)
+    {
+        const auto& Const = CreateInfo.pSpecializationConstants[i];
+
+        if (Const.Name == nullptr)
+            LOG_PSO_ERROR_AND_THROW("pSpecializationConstants[", i, "].Name must not be null.");
+
+        if (Const.Name[0] == '\0')
+            LOG_PSO_ERROR_AND_THROW("pSpecializationConstants[", i, "].Name must not be empty.");
+
+        if (Const.ShaderStages == SHADER_TYPE_UNKNOWN)
+            LOG_PSO_ERROR_AND_THROW("pSpecializationConstants[", i, "].ShaderStages must not be SHADER_TYPE_UNKNOWN.");
+
+        if (Const.pValue == nullptr)
+            LOG_PSO_ERROR_AND_THROW("pSpecializationConstants[", i, "].pValue must not be null.");
+
+        if (Const.Size == 0)
+            LOG_PSO_ERROR_AND_THROW("pSpecializationConstants[", i, "].Size must not be zero.");
+
+        auto range = UniqueConstants.equal_range(Const.Name);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if ((it->second & Const.ShaderStages) != 0)
+            {
+                LOG_PSO_ERROR_AND_THROW("Specialization constant '", Const.Name, "' is defined in overlapping shader stages (", GetShaderStagesString(Const.ShaderStages),
+                                        " and ", GetShaderStagesString(it->second),
+                                        "). Multiple constants with the same name are allowed, but shader stages they use must not overlap.");
+            }
+        }
+        UniqueConstants.emplace(Const.Name, Const.ShaderStages);
+    }
+}
+
+
 #define VALIDATE_SHADER_TYPE(Shader, ExpectedType, ShaderName)                                                                           \
     if (Shader != nullptr && Shader->GetDesc().ShaderType != ExpectedType)                                                               \
     {                                                                                                                                    \
@@ -410,6 +458,7 @@ void ValidateGraphicsPipelineCreateInfo(const GraphicsPipelineStateCreateInfo& C
     ValidateDepthStencilDesc(PSODesc, GraphicsPipeline);
     ValidateGraphicsPipelineDesc(PSODesc, GraphicsPipeline, AdapterInfo.ShadingRate);
     ValidatePipelineResourceLayoutDesc(PSODesc, Features);
+    ValidateSpecializationConstants(CreateInfo, Features);
 
 
     if (PSODesc.PipelineType == PIPELINE_TYPE_GRAPHICS)
@@ -491,6 +540,7 @@ void ValidateComputePipelineCreateInfo(const ComputePipelineStateCreateInfo& Cre
 
     ValidatePipelineResourceSignatures(CreateInfo, Features);
     ValidatePipelineResourceLayoutDesc(PSODesc, Features);
+    ValidateSpecializationConstants(CreateInfo, Features);
 
     if (CreateInfo.pCS == nullptr)
         LOG_PSO_ERROR_AND_THROW("Compute shader must not be null.");
@@ -512,6 +562,7 @@ void ValidateRayTracingPipelineCreateInfo(IRenderDevice*
 
     ValidatePipelineResourceSignatures(CreateInfo, DeviceInfo.Features);
     ValidatePipelineResourceLayoutDesc(PSODesc, DeviceInfo.Features);
+    ValidateSpecializationConstants(CreateInfo, DeviceInfo.Features);
 
     if (DeviceInfo.Type == RENDER_DEVICE_TYPE_D3D12)
     {
@@ -597,6 +648,7 @@ void ValidateTilePipelineCreateInfo(const TilePipelineStateCreateInfo& CreateInf
 
     ValidatePipelineResourceSignatures(CreateInfo, Features);
     ValidatePipelineResourceLayoutDesc(PSODesc, Features);
+    ValidateSpecializationConstants(CreateInfo, Features);
 
     if (CreateInfo.pTS == nullptr)
         LOG_PSO_ERROR_AND_THROW("Tile shader must not be null.");
@@ -26,6 +26,13 @@
 
 #include "PipelineStateCacheBase.hpp"
 
+#include <cstring>
+
+#include "DataBlobImpl.hpp"
+#include "ArchiveFileImpl.hpp"
+#include "FileSystem.hpp"
+#include "ObjectBase.hpp"
+
 namespace Diligent
 {
 
@@ -42,7 +49,296 @@ namespace Diligent
 
 void ValidatePipelineStateCacheCreateInfo(const PipelineStateCacheCreateInfo& CreateInfo) noexcept(false)
 {
-    // AZ TODO
+    if (CreateInfo.CacheDataSize != 0)
+        VERIFY_PipelineStateCache(CreateInfo.pCacheData != nullptr, "CacheDataSize (", CreateInfo.CacheDataSize, ") is not zero, but pCacheData is null.");
+    else
+        VERIFY_PipelineStateCache(CreateInfo.pCacheData == nullptr, "pCacheData is not null, but CacheDataSize is zero.");
+
+    VERIFY_PipelineStateCache(CreateInfo.pCacheData == nullptr || CreateInfo.FilePath == nullptr, "pCacheData and FilePath must not be specified at the same time.");
+}
+
+namespace
+{
+
+struct PSOCacheDataHeader
+{
+    static constexpr Uint32 ExpectedMagic   = 0x43535044; // 'DPSC'
+    static constexpr Uint32 ExpectedVersion = 1;
+
+    Uint32 Magic;
+    Uint32 Version;
+    Uint32 DeviceType;
+    Uint32 NumEntries;
+    Uint64 DriverDataSize;
+};
+static_assert(sizeof(PSOCacheDataHeader) == 24, "Unexpected sizeof(PSOCacheDataHeader)");
+
+struct PSOCacheEntryHeader
+{
+    Uint64 KeyLo;
+    Uint64 KeyHi;
+    // Offset from the start of the entry data
+    Uint64 Offset;
+    Uint64 Size;
+};
+static_assert(sizeof(PSOCacheEntryHeader) == 32, "Unexpected sizeof(PSOCacheEntryHeader)");
+
+/// Read-only data blob that references a range of the source data of the storage.
+class SourceDataBlobView final : public ObjectBase<IDataBlob>
+{
+public:
+    using TBase = ObjectBase<IDataBlob>;
+
+    SourceDataBlobView(IReferenceCounters* pRefCounters, IDataBlob* pSourceData, const void* pData, size_t Size) :
+        TBase{pRefCounters},
+        m_pSourceData{pSourceData},
+        m_pData{pData},
+        m_Size{Size}
+    {}
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DataBlob, TBase)
+
+    virtual void DILIGENT_CALL_TYPE Resize(size_t /*NewSize*/) override final
+    {
+        UNEXPECTED("Pipeline state cache entry data blob can't be resized");
+    }
+
+    virtual size_t DILIGENT_CALL_TYPE GetSize() const override final
+    {
+        return m_Size;
+    }
+
+    virtual void* DILIGENT_CALL_TYPE GetDataPtr() override final
+    {
+        // The source data may be a read-only mapping: the returned memory must not be written to
+        return const_cast<void*>(m_pData);
+    }
+
+    virtual const void* DILIGENT_CALL_TYPE GetConstDataPtr() const override final
+    {
+        return m_pData;
+    }
+
+private:
+    // Keep the source data alive
+    RefCntAutoPtr<IDataBlob> m_pSourceData;
+
+    const void* const m_pData;
+    const size_t      m_Size;
+};
+
+} // namespace
+
+bool PipelineStateCacheStorage::IsValidData(const void* pData, size_t DataSize)
+{
+    if (pData == nullptr || DataSize < sizeof(PSOCacheDataHeader))
+        return false;
+
+    PSOCacheDataHeader Header;
+    memcpy(&Header, pData, sizeof(Header));
+    return Header.Magic == PSOCacheDataHeader::ExpectedMagic && Header.Version == PSOCacheDataHeader::ExpectedVersion;
+}
+
+PipelineStateCacheStorage::PipelineStateCacheStorage(RENDER_DEVICE_TYPE DeviceType, const PipelineStateCacheCreateInfo& CreateInfo) :
+    m_DeviceType{DeviceType}
+{
+    if (CreateInfo.pCacheData != nullptr && CreateInfo.CacheDataSize != 0)
+    {
+        // Make a single copy of the data that all entries will reference
+        auto pDataBlob = DataBlobImpl::Create(CreateInfo.CacheDataSize);
+        memcpy(pDataBlob->GetDataPtr(), CreateInfo.pCacheData, CreateInfo.CacheDataSize);
+        m_pSourceData = pDataBlob;
+    }
+    else if (CreateInfo.FilePath != nullptr)
+    {
+        if (!FileSystem::FileExists(CreateInfo.FilePath))
+        {
+            LOG_INFO_MESSAGE("Pipeline state cache file '", CreateInfo.FilePath, "' does not exist. The cache will start empty.");
+        }
+        else
+        {
+            try
+            {
+                // The file is memory-mapped where supported, so only the entries that are used are paged in
+                auto pArchive = ArchiveFileImpl::Create(CreateInfo.FilePath);
+                m_pSourceData = ClassPtrCast<ArchiveFileImpl>(pArchive.RawPtr())->Map(0, pArchive->GetSize());
+            }
+            catch (...)
+            {
+                LOG_WARNING_MESSAGE("Failed to open pipeline state cache file '", CreateInfo.FilePath, "'. The cache will start empty.");
+            }
+        }
+    }
+
+    if (m_pSourceData && m_pSourceData->GetSize() != 0)
+        Load();
+}
+
+void PipelineStateCacheStorage::Load()
+{
+    const auto* const pBytes   = static_cast<const Uint8*>(m_pSourceData->GetConstDataPtr());
+    const auto        DataSize = m_pSourceData->GetSize();
+
+    PSOCacheDataHeader Header{};
+    if (DataSize >= sizeof(Header))
+        memcpy(&Header, pBytes, sizeof(Header));
+
+    if (Header.Magic != PSOCacheDataHeader::ExpectedMagic)
+    {
+        // Not produced by the engine: keep the data as is and let the driver validate them
+        // (e.g. a VkPipelineCache blob saved by the application).
+        LOG_INFO_MESSAGE("Pipeline state cache data do not have the engine header and will be used as raw driver cache data");
+        m_pDriverData    = pBytes;
+        m_DriverDataSize = DataSize;
+        return;
+    }
+
+    if (Header.Version != PSOCacheDataHeader::ExpectedVersion)
+    {
+        LOG_WARNING_MESSAGE("Pipeline state cache data version (", Header.Version, ") is not supported and will be ignored");
+        return;
+    }
+
+    if (Header.DeviceType != static_cast<Uint32>(m_DeviceType))
+    {
+        LOG_WARNING_MESSAGE("Pipeline state cache data was created by a device of a different type (", Header.DeviceType,
+                            ") and will be ignored");
+        return;
+    }
+
+    const auto TableOffset    = sizeof(Header);
+    const auto TableSize      = static_cast<Uint64>(Header.NumEntries) * sizeof(PSOCacheEntryHeader);
+    const auto EntryDataStart = TableOffset + TableSize;
+    if (EntryDataStart > DataSize || Header.DriverDataSize > DataSize - EntryDataStart)
+    {
+        LOG_WARNING_MESSAGE("Pipeline state cache data is truncated and will be ignored");
+        return;
+    }
+    const auto EntryDataSize = DataSize - EntryDataStart - Header.DriverDataSize;
+
+    m_Entries.reserve(Header.NumEntries);
+    for (Uint32 i = 0; i < Header.NumEntries; ++i)
+    {
+        PSOCacheEntryHeader EntryHeader;
+        memcpy(&EntryHeader, pBytes + TableOffset + i * sizeof(PSOCacheEntryHeader), sizeof(EntryHeader));
+        if (EntryHeader.Offset > EntryDataSize || EntryHeader.Size > EntryDataSize - EntryHeader.Offset)
+        {
+            LOG_WARNING_MESSAGE("Pipeline state cache data is corrupted and will be ignored");
+            m_Entries.clear();
+            return;
+        }
+
+        ContentHash Key;
+        Key.Lo = EntryHeader.KeyLo;
+        Key.Hi = EntryHeader.KeyHi;
+
+        Entry NewEntry;
+        NewEntry.pData = pBytes + EntryDataStart + EntryHeader.Offset;
+        NewEntry.Size  = static_cast<size_t>(EntryHeader.Size);
+        m_Entries.emplace(Key, std::move(NewEntry));
+    }
+
+    m_pDriverData    = pBytes + EntryDataStart + EntryDataSize;
+    m_DriverDataSize = static_cast<size_t>(Header.DriverDataSize);
+}
+
+RefCntAutoPtr<IDataBlob> PipelineStateCacheStorage::Find(const ContentHash& Key) const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    auto it = m_Entries.find(Key);
+    if (it == m_Entries.end())
+        return {};
+
+    auto& FoundEntry = it->second;
+    if (!FoundEntry.pDataBlob)
+    {
+        VERIFY_EXPR(m_pSourceData);
+        FoundEntry.pDataBlob = MakeNewRCObj<SourceDataBlobView>()(const_cast<IDataBlob*>(m_pSourceData.RawPtr()), FoundEntry.pData, FoundEntry.Size);
+    }
+
+    return FoundEntry.pDataBlob;
+}
+
+void PipelineStateCacheStorage::Store(const ContentHash& Key, const void* pData, size_t DataSize)
+{
+    VERIFY_EXPR(pData != nullptr || DataSize == 0);
+    const auto* pBytes = static_cast<const Uint8*>(pData);
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    auto it_inserted = m_Entries.emplace(Key, Entry{});
+    if (!it_inserted.second)
+        return;
+
+    auto  pDataBlob    = DataBlobImpl::Create(DataSize, pBytes);
+    auto& NewEntry     = it_inserted.first->second;
+    NewEntry.pData     = static_cast<const Uint8*>(pDataBlob->GetConstDataPtr());
+    NewEntry.Size      = DataSize;
+    NewEntry.pDataBlob = pDataBlob;
+}
+
+size_t PipelineStateCacheStorage::GetNumEntries() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return m_Entries.size();
+}
+
+void PipelineStateCacheStorage::Clear()
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_Entries.clear();
+    m_pDriverData    = nullptr;
+    m_DriverDataSize = 0;
+    m_pSourceData.Release();
+}
+
+RefCntAutoPtr<IDataBlob> PipelineStateCacheStorage::Serialize(const void* pDriverData, size_t DriverDataSize) const
+{
+    VERIFY_EXPR(pDriverData != nullptr || DriverDataSize == 0);
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    size_t EntryDataSize = 0;
+    for (const auto& it : m_Entries)
+        EntryDataSize += it.second.Size;
+
+    const auto TableOffset    = sizeof(PSOCacheDataHeader);
+    const auto EntryDataStart = TableOffset + m_Entries.size() * sizeof(PSOCacheEntryHeader);
+
+    auto  pDataBlob = DataBlobImpl::Create(EntryDataStart + EntryDataSize + DriverDataSize);
+    auto* pBytes    = static_cast<Uint8*>(pDataBlob->GetDataPtr());
+
+    PSOCacheDataHeader Header;
+    Header.Magic          = PSOCacheDataHeader::ExpectedMagic;
+    Header.Version        = PSOCacheDataHeader::ExpectedVersion;
+    Header.DeviceType     = static_cast<Uint32>(m_DeviceType);
+    Header.NumEntries     = static_cast<Uint32>(m_Entries.size());
+    Header.DriverDataSize = DriverDataSize;
+    memcpy(pBytes, &Header, sizeof(Header));
+
+    Uint64 Offset = 0;
+    Uint32 Idx    = 0;
+    for (const auto& it : m_Entries)
+    {
+        PSOCacheEntryHeader Entry;
+        Entry.KeyLo  = it.first.Lo;
+        Entry.KeyHi  = it.first.Hi;
+        Entry.Offset = Offset;
+        Entry.Size   = it.second.Size;
+        memcpy(pBytes + TableOffset + Idx * sizeof(PSOCacheEntryHeader), &Entry, sizeof(Entry));
+        if (it.second.Size != 0)
+            memcpy(pBytes + EntryDataStart + Offset, it.second.pData, it.second.Size);
+
+        Offset += it.second.Size;
+        ++Idx;
+    }
+    VERIFY_EXPR(Offset == EntryDataSize);
+
+    if (DriverDataSize != 0)
+        memcpy(pBytes + EntryDataStart + EntryDataSize, pDriverData, DriverDataSize);
+
+    return RefCntAutoPtr<IDataBlob>{pDataBlob};
 }
 
 } // namespace Diligent
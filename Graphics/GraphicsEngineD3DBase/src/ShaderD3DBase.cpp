@@ -38,7 +38,7 @@
 #include "dxc/dxcapi.h"
 
 #include "D3DErrors.hpp"
-#include "DataBlobImpl.hpp"
+#include "MemoryFileStream.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "ShaderD3DBase.hpp"
 #include "DXCompiler.hpp"
@@ -71,10 +71,9 @@ public:
             return E_FAIL;
         }
 
-        RefCntAutoPtr<IDataBlob> pFileData(MakeNewRCObj<DataBlobImpl>{}(0));
-        pSourceStream->ReadBlob(pFileData);
-        *ppData = pFileData->GetDataPtr();
-        *pBytes = StaticCast<UINT>(pFileData->GetSize());
+        auto pFileData = ReadStreamBlob(pSourceStream);
+        *ppData        = pFileData->GetDataPtr();
+        *pBytes        = StaticCast<UINT>(pFileData->GetSize());
 
         m_DataBlobs.insert(std::make_pair(*ppData, pFileData));
 
@@ -84,13 +83,17 @@ public:
     STDMETHOD(Close)
     (THIS_ LPCVOID pData)
     {
-        m_DataBlobs.erase(pData);
+        // The same include file may be opened multiple times and share the data
+        // when it comes from a caching stream factory, so only remove one instance.
+        auto it = m_DataBlobs.find(pData);
+        if (it != m_DataBlobs.end())
+            m_DataBlobs.erase(it);
         return S_OK;
     }
 
 private:
-    IShaderSourceInputStreamFactory*                      m_pStreamFactory;
-    std::unordered_map<LPCVOID, RefCntAutoPtr<IDataBlob>> m_DataBlobs;
+    IShaderSourceInputStreamFactory*                           m_pStreamFactory;
+    std::unordered_multimap<LPCVOID, RefCntAutoPtr<IDataBlob>> m_DataBlobs;
 };
 
 static HRESULT CompileShader(const char*             Source,
@@ -116,13 +119,17 @@ static HRESULT CompileShader(const char*             Source,
     for (auto CompileFlags = ShaderCI.CompileFlags; CompileFlags != SHADER_COMPILE_FLAG_NONE;)
     {
         auto Flag = ExtractLSB(CompileFlags);
-        static_assert(SHADER_COMPILE_FLAG_LAST == 1, "Please updated the switch below to handle the new shader flag");
+        static_assert(SHADER_COMPILE_FLAG_LAST == 2, "Please updated the switch below to handle the new shader flag");
         switch (Flag)
         {
             case SHADER_COMPILE_FLAG_ENABLE_UNBOUNDED_ARRAYS:
                 dwShaderFlags |= D3DCOMPILE_ENABLE_UNBOUNDED_DESCRIPTOR_TABLES;
                 break;
 
+            case SHADER_COMPILE_FLAG_ASYNCHRONOUS:
+                // D3D shaders are always compiled synchronously
+                break;
+
             default:
                 UNEXPECTED("Unexpected shader compile flag");
         }
@@ -33,6 +33,7 @@
 #include "GLObjectWrapper.hpp"
 #include "AsyncWritableResource.hpp"
 #include "GLContextState.hpp"
+#include "GLDynamicHeap.hpp"
 
 namespace Diligent
 {
@@ -66,7 +67,7 @@ public:
 
     void UpdateData(GLContextState& CtxState, Uint64 Offset, Uint64 Size, const void* pData);
     void CopyData(GLContextState& CtxState, BufferGLImpl& SrcBufferGL, Uint64 SrcOffset, Uint64 DstOffset, Uint64 Size);
-    void Map(GLContextState& CtxState, MAP_TYPE MapType, Uint32 MapFlags, PVoid& pMappedData);
+    void Map(GLContextState& CtxState, GLDynamicHeap* pDynamicHeap, MAP_TYPE MapType, Uint32 MapFlags, PVoid& pMappedData);
     void MapRange(GLContextState& CtxState, MAP_TYPE MapType, Uint32 MapFlags, Uint64 Offset, Uint64 Length, PVoid& pMappedData);
     void Unmap(GLContextState& CtxState);
 
@@ -74,6 +75,23 @@ public:
 
     const GLObjectWrappers::GLBufferObj& GetGLHandle() const { return m_GlBuffer; }
 
+#ifdef DILIGENT_DEVELOPMENT
+    void DvpVerifyDynamicAllocation(const GLDynamicHeap& DynamicHeap) const;
+#endif
+
+    /// Returns true if the buffer is suballocated from the context's dynamic heap when it is mapped with MAP_FLAG_DISCARD.
+    bool UsesDynamicHeap() const { return m_UseDynamicHeap; }
+
+    /// Returns the GL buffer that holds the current buffer contents, which is the
+    /// dynamic heap buffer if the buffer was last mapped from the heap.
+    const GLObjectWrappers::GLBufferObj& GetDynamicGLHandle() const
+    {
+        return m_DynamicAllocation ? *m_DynamicAllocation.pBuffer : m_GlBuffer;
+    }
+
+    /// Returns the offset of the buffer contents in the buffer returned by GetDynamicGLHandle().
+    Uint64 GetDynamicOffset() const { return m_DynamicAllocation.Offset; }
+
     /// Implementation of IBufferGL::GetGLBufferHandle().
     virtual GLuint DILIGENT_CALL_TYPE GetGLBufferHandle() override final { return GetGLHandle(); }
 
@@ -92,6 +110,11 @@ private:
     GLObjectWrappers::GLBufferObj m_GlBuffer;
     const Uint32                  m_BindTarget;
     const GLenum                  m_GLUsageHint;
+    const bool                    m_UseDynamicHeap;
+
+    // The last allocation in the dynamic heap. Empty if the buffer
+    // contents reside in the buffer's own storage.
+    GLDynamicHeap::Allocation m_DynamicAllocation;
 };
 
 void BufferGLImpl::BufferMemoryBarrier(MEMORY_BARRIER RequiredBarriers, GLContextState& GLState)
@@ -28,6 +28,7 @@
 #pragma once
 
 #include <vector>
+#include <memory>
 
 #include "EngineGLImplTraits.hpp"
 #include "DeviceContextBase.hpp"
@@ -43,6 +44,7 @@
 
 #include "GLContextState.hpp"
 #include "GLObjectWrapper.hpp"
+#include "GLDynamicHeap.hpp"
 
 namespace Diligent
 {
@@ -125,6 +127,10 @@ public:
     virtual void DILIGENT_CALL_TYPE Draw               (const DrawAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DrawIndexed() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE DrawIndexed        (const DrawIndexedAttribs& Attribs) override final;
+    /// Implementation of IDeviceContext::MultiDraw() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE MultiDraw          (const MultiDrawAttribs& Attribs) override final;
+    /// Implementation of IDeviceContext::MultiDrawIndexed() in OpenGL backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndexed   (const MultiDrawIndexedAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DrawIndirect() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE DrawIndirect       (const DrawIndirectAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DrawIndexedIndirect() in OpenGL backend.
@@ -345,6 +351,19 @@ private:
     std::vector<class TextureBaseGL*> m_BoundWritableTextures;
     std::vector<class BufferGLImpl*>  m_BoundWritableBuffers;
 
+    // Scratch arrays for native multi-draw commands
+    struct MultiDrawScratch
+    {
+        std::vector<GLsizei> Counts;
+        std::vector<GLint>   Firsts; // First vertices or base vertices
+        std::vector<void*>   IndexOffsets;
+    } m_MultiDrawScratch;
+
+    // Persistently mapped heap for dynamic buffers. Null if the heap is
+    // disabled or not supported, in which case dynamic buffers are mapped
+    // with glMapBufferRange().
+    std::unique_ptr<GLDynamicHeap> m_pDynamicHeap;
+
     RefCntAutoPtr<ISwapChainGL> m_pSwapChain;
 
     bool m_IsDefaultFBOBound = false;
@@ -0,0 +1,121 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GLDynamicHeap class
+
+#include <deque>
+
+#include "RingBuffer.hpp"
+#include "GLObjectWrapper.hpp"
+
+// Persistent mapping requires glBufferStorage() (GL4.4 or GL_ARB_buffer_storage).
+// GLES only exposes it through GL_EXT_buffer_storage, which is not loaded by the GLES stubs.
+#if defined(GL_MAP_PERSISTENT_BIT) && defined(GL_MAP_COHERENT_BIT) && !PLATFORM_EMSCRIPTEN
+#    define GL_DYNAMIC_HEAP_SUPPORTED 1
+#else
+#    define GL_DYNAMIC_HEAP_SUPPORTED 0
+#endif
+
+namespace Diligent
+{
+
+class GLContextState;
+
+/// Persistently mapped ring buffer that is used to suballocate memory for dynamic
+/// buffers mapped with MAP_FLAG_DISCARD.
+///
+/// The heap is backed by a single buffer object created with glBufferStorage() and
+/// GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT, so that an allocation is merely a pointer
+/// bump and does not require any GL calls. Memory used by a frame is reclaimed once the
+/// fence inserted by FinishFrame() is signaled.
+class GLDynamicHeap
+{
+public:
+    GLDynamicHeap(IMemoryAllocator& Allocator,
+                  GLContextState&   GLState,
+                  Uint32            Size);
+    ~GLDynamicHeap();
+
+    // clang-format off
+    GLDynamicHeap             (const GLDynamicHeap&)  = delete;
+    GLDynamicHeap             (      GLDynamicHeap&&) = delete;
+    GLDynamicHeap& operator = (const GLDynamicHeap&)  = delete;
+    GLDynamicHeap& operator = (      GLDynamicHeap&&) = delete;
+    // clang-format on
+
+    struct Allocation
+    {
+        const GLObjectWrappers::GLBufferObj* pBuffer = nullptr;
+
+        Uint64 Offset      = 0;
+        Uint8* pCPUAddress = nullptr;
+
+#ifdef DILIGENT_DEVELOPMENT
+        // The heap frame in which the allocation was made
+        Uint64 dvpFrameNumber = 0;
+#endif
+
+        explicit operator bool() const
+        {
+            return pBuffer != nullptr;
+        }
+    };
+
+    /// Allocates Size bytes from the heap. Returns an empty allocation if
+    /// there is not enough space even after all completed frames have been released.
+    Allocation Allocate(Uint64 Size);
+
+    /// Closes the current frame and releases the memory of all frames that have been completed by the GPU.
+    void FinishFrame();
+
+    /// Returns the number of frames finished by FinishFrame().
+    /// An allocation is only valid in the frame it was made in: once the frame is finished,
+    /// its memory may be recycled at any time.
+    Uint64 GetFrameNumber() const { return m_FrameNumber; }
+
+private:
+    void ReleaseCompletedFrames(bool WaitForOldestFrame);
+
+    GLObjectWrappers::GLBufferObj m_Buffer;
+
+    Uint8*       m_pMappedData = nullptr;
+    const Uint32 m_Alignment;
+
+    RingBuffer m_RingBuffer;
+
+    // Fences that mark the ends of the frames that may still be in use by the GPU
+    std::deque<std::pair<Uint64, GLObjectWrappers::GLSyncObj>> m_PendingFences;
+
+    Uint64 m_NextFenceValue      = 1;
+    Uint64 m_FrameNumber         = 0;
+    bool   m_CurrFrameHasAllocs  = false;
+    bool   m_OutOfMemoryReported = false;
+};
+
+} // namespace Diligent
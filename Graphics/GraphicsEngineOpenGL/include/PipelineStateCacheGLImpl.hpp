@@ -0,0 +1,77 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::PipelineStateCacheGLImpl class
+
+#include <string>
+
+#include "EngineGLImplTraits.hpp"
+#include "PipelineStateCacheBase.hpp"
+#include "GLObjectWrapper.hpp"
+
+namespace Diligent
+{
+
+/// Pipeline state cache object implementation in OpenGL backend.
+
+/// The cache stores linked program binaries obtained with glGetProgramBinary() keyed by
+/// the hash of the GLSL sources of all program stages. Binaries are only valid for the
+/// driver that produced them, so the vendor, renderer and version strings are kept as
+/// the driver data of the cache, and all entries are discarded when they do not match.
+class PipelineStateCacheGLImpl final : public PipelineStateCacheBase<EngineGLImplTraits>
+{
+public:
+    using TPipelineStateCacheBase = PipelineStateCacheBase<EngineGLImplTraits>;
+
+    PipelineStateCacheGLImpl(IReferenceCounters*                 pRefCounters,
+                             RenderDeviceGLImpl*                 pDeviceGL,
+                             const PipelineStateCacheCreateInfo& CreateInfo);
+    ~PipelineStateCacheGLImpl();
+
+    /// Implementation of IPipelineStateCache::GetData().
+    virtual void DILIGENT_CALL_TYPE GetData(IDataBlob** ppBlob) override final;
+
+    /// Returns true if the driver supports retrieving program binaries.
+    bool IsProgramBinarySupported() const { return m_ProgramBinarySupported; }
+
+    /// Creates a program from the binary stored in the cache.
+    /// Returns a null program if there is no binary for the key or if the driver rejects it.
+    GLObjectWrappers::GLProgramObj LoadProgram(const ContentHash& Key, bool IsSeparableProgram);
+
+    /// Retrieves the binary of the linked program and stores it in the cache.
+    void StoreProgram(const ContentHash& Key, const GLObjectWrappers::GLProgramObj& GLProgram);
+
+private:
+    // GL_VENDOR, GL_RENDERER and GL_VERSION strings
+    std::string m_DriverId;
+
+    bool m_ProgramBinarySupported = false;
+};
+
+} // namespace Diligent
@@ -200,6 +200,9 @@ public:
     };
     const GLDeviceLimits& GetDeviceLimits() const { return m_DeviceLimits; }
 
+    /// Returns the size of the dynamic heap, or zero if the heap is disabled or not supported.
+    Uint32 GetDynamicHeapSize() const { return m_DynamicHeapSize; }
+
 protected:
     friend class DeviceContextGLImpl;
     friend class TextureBaseGL;
@@ -209,6 +212,7 @@ protected:
     friend class TextureViewGLImpl;
     friend class SwapChainGLImpl;
     friend class GLContextState;
+    friend class PipelineStateCacheGLImpl;
 
     // Must be the first member because its constructor initializes OpenGL
     GLContext m_GLContext;
@@ -232,6 +236,8 @@ private:
     int m_ShowDebugGLOutput = 1;
 
     GLDeviceLimits m_DeviceLimits = {};
+
+    Uint32 m_DynamicHeapSize = 0;
 };
 
 } // namespace Diligent
@@ -27,10 +27,17 @@
 
 #pragma once
 
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "EngineGLImplTraits.hpp"
 #include "ShaderBase.hpp"
 #include "GLObjectWrapper.hpp"
 #include "ShaderResourcesGL.hpp"
+#include "HashUtils.hpp"
 
 namespace Diligent
 {
@@ -55,16 +62,69 @@ public:
     /// Implementation of IShader::GetResource() in OpenGL backend.
     virtual void DILIGENT_CALL_TYPE GetResourceDesc(Uint32 Index, ShaderResourceDesc& ResourceDesc) const override final;
 
-    static GLObjectWrappers::GLProgramObj LinkProgram(ShaderGLImpl* const* ppShaders, Uint32 NumShaders, bool IsSeparableProgram);
+    /// Links the program from the given shaders. If the PSO cache is not null, the program
+    /// is created from the cached binary when possible, and the binary of a newly linked
+    /// program is added to the cache.
+    static GLObjectWrappers::GLProgramObj LinkProgram(ShaderGLImpl* const*      ppShaders,
+                                                      Uint32                    NumShaders,
+                                                      bool                      IsSeparableProgram,
+                                                      PipelineStateCacheGLImpl* pPSOCache = nullptr);
 
     const std::shared_ptr<const ShaderResourcesGL>& GetShaderResources() const { return m_pShaderResources; }
 
     SHADER_SOURCE_LANGUAGE GetSourceLanguage() const { return m_SourceLanguage; }
 
+    /// Hash of the GLSL source passed to the driver.
+    const ContentHash& GetSourceHash() const { return m_SourceHash; }
+
+    /// Returns the shader with its specialization constants set to the values from the
+    /// create info. OpenGL has no native specialization constants, so they are emulated by
+    /// compiling a copy of the source where the default values are replaced with the literals.
+    /// Shaders with the same values are shared; the number of shared copies is limited by
+    /// MaxSpecializedShaders. If none of the constants is specialized, the shader itself is returned.
+    RefCntAutoPtr<ShaderGLImpl> Specialize(const PipelineStateCreateInfo& CreateInfo) noexcept(false);
+
 private:
+    // Specialization constant declared in GLSL source as
+    // layout(constant_id = N) const <Type> <Name> = <Value>;
+    struct SpecializationConstantDecl
+    {
+        std::string Name;
+        std::string Type;
+
+        // The range of the default value in m_SpecializableSource
+        size_t ValueStart = 0;
+        size_t ValueEnd   = 0;
+    };
+
+    // Finds specialization constant declarations in the source and initializes m_SpecializableSource
+    // and m_SpecConstants. Returns false if the source does not declare any constants.
+    // Throws an exception if a declaration does not have the supported form.
+    bool InitSpecializationConstants(const char* Source, size_t Length);
+
     const SHADER_SOURCE_LANGUAGE             m_SourceLanguage;
     GLObjectWrappers::GLShaderObj            m_GLShaderObj;
     std::shared_ptr<const ShaderResourcesGL> m_pShaderResources;
+    ContentHash                              m_SourceHash;
+
+    // Full shader source with constant_id layout qualifiers removed.
+    // Only initialized when the shader declares specialization constants.
+    std::string                             m_SpecializableSource;
+    std::vector<SpecializationConstantDecl> m_SpecConstants;
+
+    // The maximum number of specialized copies kept by the shader. When the limit is reached,
+    // the least recently used copy is released.
+    static constexpr size_t MaxSpecializedShaders = 32;
+
+    struct SpecializedShaderInfo
+    {
+        RefCntAutoPtr<ShaderGLImpl>      pShader;
+        std::list<ContentHash>::iterator LRUPos;
+    };
+
+    std::mutex                                                                  m_SpecializedShadersMtx;
+    std::unordered_map<ContentHash, SpecializedShaderInfo, ContentHash::Hasher> m_SpecializedShaders;
+    std::list<ContentHash>                                                      m_SpecializedShadersLRU; // Most recently used first
 };
 
 } // namespace Diligent
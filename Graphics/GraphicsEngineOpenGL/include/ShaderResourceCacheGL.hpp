@@ -71,12 +71,13 @@ public:
         Uint32 RangeSize     = 0;
         Uint32 DynamicOffset = 0;
 
-        // In OpenGL dynamic buffers are only those that are not bound as a whole and
-        // can use a dynamic offset, irrespective of the variable type or whether the
-        // buffer is USAGE_DYNAMIC or not.
+        // In OpenGL dynamic buffers are those that are not bound as a whole and
+        // can use a dynamic offset, irrespective of the variable type, as well as
+        // USAGE_DYNAMIC buffers that are suballocated from the dynamic heap and
+        // change their location every time they are mapped.
         bool IsDynamic() const
         {
-            return pBuffer && RangeSize < pBuffer->GetDesc().Size;
+            return pBuffer && (RangeSize < pBuffer->GetDesc().Size || pBuffer->UsesDynamicHeap());
         }
     };
 
@@ -349,6 +350,11 @@ public:
     void DbgVerifyDynamicBufferMasks() const;
 #endif
 
+#ifdef DILIGENT_DEVELOPMENT
+    // Verifies that all uniform buffers suballocated from the dynamic heap have been mapped in the current frame
+    void DvpVerifyDynamicAllocations(const GLDynamicHeap& DynamicHeap) const;
+#endif
+
 private:
     CachedUB& GetUB(Uint32 CacheOffset)
     {
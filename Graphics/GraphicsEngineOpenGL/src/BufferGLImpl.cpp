@@ -69,6 +69,17 @@ static GLenum GetBufferBindTarget(const BufferDesc& Desc)
 
     return Target;
 }
+
+static bool UseDynamicHeap(const BufferDesc& Desc, const RenderDeviceGLImpl& DeviceGL)
+{
+    // Only uniform buffers can be suballocated from the dynamic heap as the heap buffer is bound
+    // with glBindBufferRange(). Other bind points (vertex, index, indirect buffers, buffer views)
+    // do not reference the buffer through an offset and use the buffer's own storage.
+    return (Desc.Usage == USAGE_DYNAMIC &&
+            Desc.BindFlags == BIND_UNIFORM_BUFFER &&
+            Desc.Size <= DeviceGL.GetDynamicHeapSize());
+}
+
 BufferGLImpl::BufferGLImpl(IReferenceCounters*        pRefCounters,
                            FixedBlockMemoryAllocator& BuffViewObjMemAllocator,
                            RenderDeviceGLImpl*        pDeviceGL,
@@ -85,9 +96,10 @@ BufferGLImpl::BufferGLImpl(IReferenceCounters*        pRefCounters,
         BuffDesc,
         bIsDeviceInternal
     },
-    m_GlBuffer    {true                          }, // Create buffer immediately
-    m_BindTarget  {GetBufferBindTarget(BuffDesc) },
-    m_GLUsageHint {UsageToGLUsage(BuffDesc)}
+    m_GlBuffer      {true                          }, // Create buffer immediately
+    m_BindTarget    {GetBufferBindTarget(BuffDesc) },
+    m_GLUsageHint   {UsageToGLUsage(BuffDesc)},
+    m_UseDynamicHeap{UseDynamicHeap(BuffDesc, *pDeviceGL)}
 // clang-format on
 {
     ValidateBufferInitData(BuffDesc, pBuffData);
@@ -199,9 +211,10 @@ BufferGLImpl::BufferGLImpl(IReferenceCounters*        pRefCounters,
         bIsDeviceInternal
     },
     // Attach to external buffer handle
-    m_GlBuffer    {true, GLObjectWrappers::GLBufferObjCreateReleaseHelper(GLHandle)},
-    m_BindTarget  {GetBufferBindTarget(m_Desc)},
-    m_GLUsageHint {UsageToGLUsage(BuffDesc)   }
+    m_GlBuffer      {true, GLObjectWrappers::GLBufferObjCreateReleaseHelper(GLHandle)},
+    m_BindTarget    {GetBufferBindTarget(m_Desc)},
+    m_GLUsageHint   {UsageToGLUsage(BuffDesc)   },
+    m_UseDynamicHeap{false}
 // clang-format on
 {
     m_MemoryProperties = MEMORY_PROPERTY_HOST_COHERENT;
@@ -253,15 +266,38 @@ void BufferGLImpl::CopyData(GLContextState& CtxState, BufferGLImpl& SrcBufferGL,
     // what was bound to the target before your copy.
     constexpr bool ResetVAO = false; // No need to reset VAO for READ/WRITE targets
     CtxState.BindBuffer(GL_COPY_WRITE_BUFFER, m_GlBuffer, ResetVAO);
-    CtxState.BindBuffer(GL_COPY_READ_BUFFER, SrcBufferGL.m_GlBuffer, ResetVAO);
+    // The source may be a dynamic buffer whose contents reside in the dynamic heap
+    CtxState.BindBuffer(GL_COPY_READ_BUFFER, SrcBufferGL.GetDynamicGLHandle(), ResetVAO);
+    SrcOffset += SrcBufferGL.GetDynamicOffset();
     glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, StaticCast<GLintptr>(SrcOffset), StaticCast<GLintptr>(DstOffset), StaticCast<GLsizeiptr>(Size));
     CHECK_GL_ERROR("glCopyBufferSubData() failed");
     CtxState.BindBuffer(GL_COPY_READ_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
     CtxState.BindBuffer(GL_COPY_WRITE_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+
+    // The data has been written to the buffer's own storage
+    m_DynamicAllocation = {};
 }
 
-void BufferGLImpl::Map(GLContextState& CtxState, MAP_TYPE MapType, Uint32 MapFlags, PVoid& pMappedData)
+void BufferGLImpl::Map(GLContextState& CtxState, GLDynamicHeap* pDynamicHeap, MAP_TYPE MapType, Uint32 MapFlags, PVoid& pMappedData)
 {
+    if (m_UseDynamicHeap && pDynamicHeap != nullptr)
+    {
+        VERIFY(MapType == MAP_WRITE, "Dynamic buffers can only be mapped for writing");
+        if (MapFlags & MAP_FLAG_DISCARD)
+        {
+            // Suballocate new memory from the persistently mapped heap. This does not require any GL calls.
+            m_DynamicAllocation = pDynamicHeap->Allocate(m_Desc.Size);
+        }
+
+        if (m_DynamicAllocation)
+        {
+            // With MAP_FLAG_NO_OVERWRITE, the same memory is returned
+            pMappedData = m_DynamicAllocation.pCPUAddress;
+            return;
+        }
+        // The heap is out of space: fall back to mapping the buffer's own storage
+    }
+
     MapRange(CtxState, MapType, MapFlags, 0, m_Desc.Size, pMappedData);
 }
 
@@ -326,8 +362,27 @@ void BufferGLImpl::MapRange(GLContextState& CtxState, MAP_TYPE MapType, Uint32 M
     VERIFY(pMappedData, "Map failed");
 }
 
+#ifdef DILIGENT_DEVELOPMENT
+void BufferGLImpl::DvpVerifyDynamicAllocation(const GLDynamicHeap& DynamicHeap) const
+{
+    if (!m_DynamicAllocation)
+        return;
+
+    const auto CurrentFrame = DynamicHeap.GetFrameNumber();
+    DEV_CHECK_ERR(m_DynamicAllocation.dvpFrameNumber == CurrentFrame, "Dynamic heap allocation of dynamic buffer '", m_Desc.Name, "' in frame ", CurrentFrame,
+                  " is out-of-date. Note: when the dynamic heap is enabled, contents of dynamic uniform buffers is discarded at the end of every frame. "
+                  "A buffer must be mapped before its first use in any frame.");
+}
+#endif
+
 void BufferGLImpl::Unmap(GLContextState& CtxState)
 {
+    if (m_DynamicAllocation)
+    {
+        // The dynamic heap is persistently mapped and coherent, so there is nothing to do
+        return;
+    }
+
     constexpr bool ResetVAO = true;
     CtxState.BindBuffer(m_BindTarget, m_GlBuffer, ResetVAO);
     auto Result = glUnmapBuffer(m_BindTarget);
@@ -74,6 +74,11 @@ DeviceContextGLImpl::DeviceContextGLImpl(IReferenceCounters*      pRefCounters,
 {
     m_BoundWritableTextures.reserve(16);
     m_BoundWritableBuffers.reserve(16);
+
+    if (const auto DynamicHeapSize = pDeviceGL->GetDynamicHeapSize())
+    {
+        m_pDynamicHeap = std::make_unique<GLDynamicHeap>(GetRawAllocator(), m_ContextState, DynamicHeapSize);
+    }
 }
 
 IMPLEMENT_QUERY_INTERFACE(DeviceContextGLImpl, IID_DeviceContextGL, TDeviceContextBase)
@@ -670,6 +675,10 @@ void DeviceContextGLImpl::BindProgramResources(Uint32 BindSRBMask)
 
         const auto* pResourceCache = m_BindInfo.ResourceCaches[sign];
         DEV_CHECK_ERR(pResourceCache != nullptr, "Resource cache at index ", sign, " is null");
+#ifdef DILIGENT_DEVELOPMENT
+        if (m_pDynamicHeap)
+            pResourceCache->DvpVerifyDynamicAllocations(*m_pDynamicHeap);
+#endif
         if (m_BindInfo.StaleSRBMask & SignBit)
             pResourceCache->BindResources(GetContextState(), BaseBindings, m_BoundWritableTextures, m_BoundWritableBuffers);
         else
@@ -867,6 +876,139 @@ void DeviceContextGLImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
     PostDraw();
 }
 
+void DeviceContextGLImpl::MultiDraw(const MultiDrawAttribs& Attribs)
+{
+    DvpVerifyMultiDrawArguments(Attribs);
+
+    GLenum GlTopology;
+    PrepareForDraw(Attribs.Flags, false, GlTopology);
+
+    if (Attribs.NumDrawItems > 0 && Attribs.NumInstances > 0)
+    {
+        const bool IsInstanced = Attribs.NumInstances > 1 || Attribs.FirstInstanceLocation != 0;
+
+        bool NativeMultiDrawExecuted = false;
+#if GL_VERSION_1_4
+        // There is no instanced version of glMultiDrawArrays
+        if (!IsInstanced && (m_pDevice->GetAdapterInfo().DrawCommand.CapFlags & DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW) != 0)
+        {
+            auto& Counts = m_MultiDrawScratch.Counts;
+            auto& Firsts = m_MultiDrawScratch.Firsts;
+            Counts.resize(Attribs.NumDrawItems);
+            Firsts.resize(Attribs.NumDrawItems);
+            for (Uint32 i = 0; i < Attribs.NumDrawItems; ++i)
+            {
+                Counts[i] = static_cast<GLsizei>(Attribs.pDrawItems[i].NumVertices);
+                Firsts[i] = static_cast<GLint>(Attribs.pDrawItems[i].StartVertexLocation);
+            }
+            glMultiDrawArrays(GlTopology, Firsts.data(), Counts.data(), static_cast<GLsizei>(Attribs.NumDrawItems));
+            DEV_CHECK_GL_ERROR("glMultiDrawArrays() failed");
+            NativeMultiDrawExecuted = true;
+        }
+#endif
+
+        if (!NativeMultiDrawExecuted)
+        {
+            for (Uint32 i = 0; i < Attribs.NumDrawItems; ++i)
+            {
+                const auto& Item = Attribs.pDrawItems[i];
+                if (Item.NumVertices == 0)
+                    continue;
+
+                if (!IsInstanced)
+                    glDrawArrays(GlTopology, Item.StartVertexLocation, Item.NumVertices);
+                else if (Attribs.FirstInstanceLocation != 0)
+                    glDrawArraysInstancedBaseInstance(GlTopology, Item.StartVertexLocation, Item.NumVertices, Attribs.NumInstances, Attribs.FirstInstanceLocation);
+                else
+                    glDrawArraysInstanced(GlTopology, Item.StartVertexLocation, Item.NumVertices, Attribs.NumInstances);
+            }
+            DEV_CHECK_GL_ERROR("OpenGL draw command failed");
+        }
+    }
+
+    PostDraw();
+}
+
+void DeviceContextGLImpl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs)
+{
+    DvpVerifyMultiDrawIndexedArguments(Attribs);
+
+    GLenum GlTopology;
+    PrepareForDraw(Attribs.Flags, true, GlTopology);
+    GLenum GLIndexType;
+    size_t BaseIndexByteOffset;
+    PrepareForIndexedDraw(Attribs.IndexType, 0, GLIndexType, BaseIndexByteOffset);
+    const auto IndexSize = GetValueSize(Attribs.IndexType);
+
+    if (Attribs.NumDrawItems > 0 && Attribs.NumInstances > 0)
+    {
+        const bool IsInstanced = Attribs.NumInstances > 1 || Attribs.FirstInstanceLocation != 0;
+
+        bool NativeMultiDrawExecuted = false;
+#if GL_VERSION_3_2
+        // There is no instanced version of glMultiDrawElementsBaseVertex
+        if (!IsInstanced && (m_pDevice->GetAdapterInfo().DrawCommand.CapFlags & DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW) != 0)
+        {
+            auto& Counts       = m_MultiDrawScratch.Counts;
+            auto& BaseVertices = m_MultiDrawScratch.Firsts;
+            auto& Offsets      = m_MultiDrawScratch.IndexOffsets;
+            Counts.resize(Attribs.NumDrawItems);
+            BaseVertices.resize(Attribs.NumDrawItems);
+            Offsets.resize(Attribs.NumDrawItems);
+            for (Uint32 i = 0; i < Attribs.NumDrawItems; ++i)
+            {
+                const auto& Item = Attribs.pDrawItems[i];
+                Counts[i]        = static_cast<GLsizei>(Item.NumIndices);
+                BaseVertices[i]  = static_cast<GLint>(Item.BaseVertex);
+                Offsets[i]       = reinterpret_cast<void*>(BaseIndexByteOffset + size_t{Item.FirstIndexLocation} * IndexSize);
+            }
+            glMultiDrawElementsBaseVertex(GlTopology, Counts.data(), GLIndexType, Offsets.data(), static_cast<GLsizei>(Attribs.NumDrawItems), BaseVertices.data());
+            DEV_CHECK_GL_ERROR("glMultiDrawElementsBaseVertex() failed");
+            NativeMultiDrawExecuted = true;
+        }
+#endif
+
+        if (!NativeMultiDrawExecuted)
+        {
+            for (Uint32 i = 0; i < Attribs.NumDrawItems; ++i)
+            {
+                const auto& Item = Attribs.pDrawItems[i];
+                if (Item.NumIndices == 0)
+                    continue;
+
+                auto* pIndices = reinterpret_cast<GLvoid*>(BaseIndexByteOffset + size_t{Item.FirstIndexLocation} * IndexSize);
+                if (IsInstanced)
+                {
+                    if (Item.BaseVertex > 0)
+                    {
+                        if (Attribs.FirstInstanceLocation != 0)
+                            glDrawElementsInstancedBaseVertexBaseInstance(GlTopology, Item.NumIndices, GLIndexType, pIndices, Attribs.NumInstances, Item.BaseVertex, Attribs.FirstInstanceLocation);
+                        else
+                            glDrawElementsInstancedBaseVertex(GlTopology, Item.NumIndices, GLIndexType, pIndices, Attribs.NumInstances, Item.BaseVertex);
+                    }
+                    else
+                    {
+                        if (Attribs.FirstInstanceLocation != 0)
+                            glDrawElementsInstancedBaseInstance(GlTopology, Item.NumIndices, GLIndexType, pIndices, Attribs.NumInstances, Attribs.FirstInstanceLocation);
+                        else
+                            glDrawElementsInstanced(GlTopology, Item.NumIndices, GLIndexType, pIndices, Attribs.NumInstances);
+                    }
+                }
+                else
+                {
+                    if (Item.BaseVertex > 0)
+                        glDrawElementsBaseVertex(GlTopology, Item.NumIndices, GLIndexType, pIndices, Item.BaseVertex);
+                    else
+                        glDrawElements(GlTopology, Item.NumIndices, GLIndexType, pIndices);
+                }
+            }
+            DEV_CHECK_GL_ERROR("OpenGL draw command failed");
+        }
+    }
+
+    PostDraw();
+}
+
 void DeviceContextGLImpl::PrepareForIndirectDraw(IBuffer* pAttribsBuffer)
 {
 #if GL_ARB_draw_indirect
@@ -1241,6 +1383,9 @@ void DeviceContextGLImpl::Flush()
 
 void DeviceContextGLImpl::FinishFrame()
 {
+    if (m_pDynamicHeap)
+        m_pDynamicHeap->FinishFrame();
+
     TDeviceContextBase::EndFrame();
 }
 
@@ -1420,6 +1565,10 @@ void DeviceContextGLImpl::CopyBuffer(IBuffer*                       pSrcBuffer,
 
     auto* pSrcBufferGL = ClassPtrCast<BufferGLImpl>(pSrcBuffer);
     auto* pDstBufferGL = ClassPtrCast<BufferGLImpl>(pDstBuffer);
+#ifdef DILIGENT_DEVELOPMENT
+    if (m_pDynamicHeap)
+        pSrcBufferGL->DvpVerifyDynamicAllocation(*m_pDynamicHeap);
+#endif
     pDstBufferGL->CopyData(m_ContextState, *pSrcBufferGL, SrcOffset, DstOffset, Size);
 }
 
@@ -1427,7 +1576,7 @@ void DeviceContextGLImpl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAG
 {
     TDeviceContextBase::MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
     auto* pBufferGL = ClassPtrCast<BufferGLImpl>(pBuffer);
-    pBufferGL->Map(m_ContextState, MapType, MapFlags, pMappedData);
+    pBufferGL->Map(m_ContextState, m_pDynamicHeap.get(), MapType, MapFlags, pMappedData);
 }
 
 void DeviceContextGLImpl::UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
@@ -0,0 +1,173 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "GLDynamicHeap.hpp"
+
+#include <limits>
+
+#include "GLContextState.hpp"
+#include "Align.hpp"
+
+namespace Diligent
+{
+
+static Uint32 GetUniformBufferOffsetAlignment()
+{
+    GLint Alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &Alignment);
+    CHECK_GL_ERROR("glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT) failed");
+    // Every allocation may be bound as a uniform buffer, so it must satisfy the UBO offset alignment.
+    // The alignment is a power of two on all known implementations, but we can't rely on the spec.
+    return (Alignment > 0 && IsPowerOfTwo(static_cast<Uint32>(Alignment))) ? std::max(static_cast<Uint32>(Alignment), 16u) : 256u;
+}
+
+GLDynamicHeap::GLDynamicHeap(IMemoryAllocator& Allocator,
+                             GLContextState&   GLState,
+                             Uint32            Size) :
+    // clang-format off
+    m_Buffer    {true},
+    m_Alignment {GetUniformBufferOffsetAlignment()},
+    m_RingBuffer{Size, Allocator}
+// clang-format on
+{
+#if GL_DYNAMIC_HEAP_SUPPORTED
+    // We must unbind VAO because otherwise we will break the bindings
+    constexpr bool ResetVAO = true;
+    GLState.BindBuffer(GL_ARRAY_BUFFER, m_Buffer, ResetVAO);
+
+    // GL_MAP_COHERENT_BIT guarantees that CPU writes become visible to the GPU without explicit
+    // flushes, while GL_MAP_PERSISTENT_BIT allows the buffer to remain mapped while it is used.
+    constexpr GLbitfield StorageFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(GL_ARRAY_BUFFER, StaticCast<GLsizeiptr>(Size), nullptr, StorageFlags);
+    CHECK_GL_ERROR_AND_THROW("glBufferStorage() failed");
+
+    m_pMappedData = static_cast<Uint8*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, StaticCast<GLsizeiptr>(Size), StorageFlags));
+    CHECK_GL_ERROR_AND_THROW("glMapBufferRange() failed");
+    if (m_pMappedData == nullptr)
+        LOG_ERROR_AND_THROW("Failed to persistently map the dynamic heap buffer");
+
+    GLState.BindBuffer(GL_ARRAY_BUFFER, GLObjectWrappers::GLBufferObj::Null(), ResetVAO);
+
+    m_Buffer.SetName("Dynamic heap");
+#else
+    (void)GLState;
+    LOG_ERROR_AND_THROW("Persistently mapped buffers are not supported on this platform");
+#endif
+}
+
+GLDynamicHeap::~GLDynamicHeap()
+{
+    // The buffer object is implicitly unmapped when it is deleted. The GPU may still
+    // be using the memory, but GL defers the actual release until it is no longer in use.
+    m_RingBuffer.FinishCurrentFrame(m_NextFenceValue);
+    m_RingBuffer.ReleaseCompletedFrames(m_NextFenceValue);
+    m_PendingFences.clear();
+}
+
+GLDynamicHeap::Allocation GLDynamicHeap::Allocate(Uint64 Size)
+{
+    const auto AllocSize = StaticCast<RingBuffer::OffsetType>(Size);
+
+    auto Offset = m_RingBuffer.Allocate(AllocSize, m_Alignment);
+    // If the heap is full, wait for the oldest frames to complete
+    while (Offset == RingBuffer::InvalidOffset && !m_PendingFences.empty())
+    {
+        ReleaseCompletedFrames(/*WaitForOldestFrame = */ true);
+        Offset = m_RingBuffer.Allocate(AllocSize, m_Alignment);
+    }
+
+    if (Offset == RingBuffer::InvalidOffset)
+    {
+        if (!m_OutOfMemoryReported)
+        {
+            LOG_WARNING_MESSAGE("Not enough space in the dynamic heap to allocate ", Size,
+                                " bytes. Dynamic buffers will be mapped with glMapBufferRange(). Increase the heap size "
+                                "(EngineGLCreateInfo::DynamicHeapSize) or make sure that IDeviceContext::FinishFrame() is called every frame.");
+            m_OutOfMemoryReported = true;
+        }
+        return {};
+    }
+
+    m_CurrFrameHasAllocs = true;
+
+    Allocation Alloc;
+    Alloc.pBuffer     = &m_Buffer;
+    Alloc.Offset      = Offset;
+    Alloc.pCPUAddress = m_pMappedData + Offset;
+#ifdef DILIGENT_DEVELOPMENT
+    Alloc.dvpFrameNumber = m_FrameNumber;
+#endif
+    return Alloc;
+}
+
+void GLDynamicHeap::FinishFrame()
+{
+    if (m_CurrFrameHasAllocs)
+    {
+        const auto FenceValue = m_NextFenceValue++;
+        m_RingBuffer.FinishCurrentFrame(FenceValue);
+
+        GLObjectWrappers::GLSyncObj GLFence{glFenceSync(
+            GL_SYNC_GPU_COMMANDS_COMPLETE, // Condition must always be GL_SYNC_GPU_COMMANDS_COMPLETE
+            0                              // Flags, must be 0
+            )};
+        DEV_CHECK_GL_ERROR("Failed to create gl fence");
+        m_PendingFences.emplace_back(FenceValue, std::move(GLFence));
+
+        m_CurrFrameHasAllocs = false;
+    }
+
+    ++m_FrameNumber;
+
+    ReleaseCompletedFrames(/*WaitForOldestFrame = */ false);
+}
+
+void GLDynamicHeap::ReleaseCompletedFrames(bool WaitForOldestFrame)
+{
+    Uint64 CompletedFenceValue = 0;
+    while (!m_PendingFences.empty())
+    {
+        auto& val_fence = m_PendingFences.front();
+
+        auto res = WaitForOldestFrame ?
+            glClientWaitSync(val_fence.second, GL_SYNC_FLUSH_COMMANDS_BIT, std::numeric_limits<GLuint64>::max()) :
+            glClientWaitSync(val_fence.second, 0, 0);
+        if (res != GL_ALREADY_SIGNALED && res != GL_CONDITION_SATISFIED)
+            break;
+
+        CompletedFenceValue = val_fence.first;
+        m_PendingFences.pop_front();
+        // Only wait for the first frame, all others are released if they have been completed
+        WaitForOldestFrame = false;
+    }
+
+    if (CompletedFenceValue != 0)
+        m_RingBuffer.ReleaseCompletedFrames(CompletedFenceValue);
+}
+
+} // namespace Diligent
@@ -0,0 +1,194 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+
+#include "PipelineStateCacheGLImpl.hpp"
+
+#include <cstring>
+#include <vector>
+
+#include "RenderDeviceGLImpl.hpp"
+
+#if defined(GL_NUM_PROGRAM_BINARY_FORMATS) && defined(GL_PROGRAM_BINARY_LENGTH) && !PLATFORM_EMSCRIPTEN
+#    define GL_PROGRAM_BINARY_SUPPORTED 1
+#else
+#    define GL_PROGRAM_BINARY_SUPPORTED 0
+#endif
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Every cache entry starts with this header followed by the program binary
+struct ProgramBinaryHeader
+{
+    Uint32 BinaryFormat;
+};
+
+std::string GetDriverId()
+{
+    std::string DriverId;
+    for (auto Name : {GL_VENDOR, GL_RENDERER, GL_VERSION})
+    {
+        const auto* Str = reinterpret_cast<const char*>(glGetString(Name));
+        if (Str != nullptr)
+            DriverId.append(Str);
+        DriverId.push_back('\n');
+    }
+    return DriverId;
+}
+
+} // namespace
+
+PipelineStateCacheGLImpl::PipelineStateCacheGLImpl(IReferenceCounters*                 pRefCounters,
+                                                   RenderDeviceGLImpl*                 pDeviceGL,
+                                                   const PipelineStateCacheCreateInfo& CreateInfo) :
+    // clang-format off
+    TPipelineStateCacheBase
+    {
+        pRefCounters,
+        pDeviceGL,
+        CreateInfo,
+        false
+    },
+    m_DriverId{GetDriverId()}
+// clang-format on
+{
+#if GL_PROGRAM_BINARY_SUPPORTED
+    const auto& DeviceInfo = pDeviceGL->GetDeviceInfo();
+
+    bool BinaryFunctionsAvailable = false;
+    if (DeviceInfo.Type == RENDER_DEVICE_TYPE_GLES)
+        BinaryFunctionsAvailable = DeviceInfo.APIVersion >= Version{3, 0} || pDeviceGL->CheckExtension("GL_OES_get_program_binary");
+    else
+        BinaryFunctionsAvailable = DeviceInfo.APIVersion >= Version{4, 1} || pDeviceGL->CheckExtension("GL_ARB_get_program_binary");
+
+    if (BinaryFunctionsAvailable)
+    {
+        GLint NumFormats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &NumFormats);
+        if (glGetError() == GL_NO_ERROR && NumFormats > 0)
+            m_ProgramBinarySupported = true;
+    }
+#endif
+
+    if (!m_ProgramBinarySupported)
+    {
+        LOG_INFO_MESSAGE("The driver does not support program binaries. Pipeline state cache '", (m_Desc.Name != nullptr ? m_Desc.Name : ""), "' will not store any data.");
+    }
+
+    const auto* pDriverData    = m_Storage.GetDriverData();
+    const auto  DriverDataSize = m_Storage.GetDriverDataSize();
+    if ((m_Storage.GetNumEntries() != 0 || DriverDataSize != 0) &&
+        (DriverDataSize != m_DriverId.size() || memcmp(pDriverData, m_DriverId.data(), m_DriverId.size()) != 0))
+    {
+        // Program binaries produced by a different driver can't be used
+        LOG_INFO_MESSAGE("Pipeline state cache data was created by a different OpenGL driver and will be ignored");
+        m_Storage.Clear();
+    }
+}
+
+PipelineStateCacheGLImpl::~PipelineStateCacheGLImpl()
+{
+}
+
+void PipelineStateCacheGLImpl::GetData(IDataBlob** ppBlob)
+{
+    DEV_CHECK_ERR(ppBlob != nullptr, "ppBlob must not be null");
+    *ppBlob = nullptr;
+
+    auto pDataBlob = m_Storage.Serialize(m_DriverId.data(), m_DriverId.size());
+    *ppBlob        = pDataBlob.Detach();
+}
+
+GLObjectWrappers::GLProgramObj PipelineStateCacheGLImpl::LoadProgram(const ContentHash& Key, bool IsSeparableProgram)
+{
+#if GL_PROGRAM_BINARY_SUPPORTED
+    if (!m_ProgramBinarySupported)
+        return GLObjectWrappers::GLProgramObj::Null();
+
+    std::vector<Uint8> Data;
+    if (!m_Storage.Find(Key, Data) || Data.size() <= sizeof(ProgramBinaryHeader))
+        return GLObjectWrappers::GLProgramObj::Null();
+
+    ProgramBinaryHeader Header;
+    memcpy(&Header, Data.data(), sizeof(Header));
+
+    GLObjectWrappers::GLProgramObj GLProg{true};
+    if (IsSeparableProgram)
+        glProgramParameteri(GLProg, GL_PROGRAM_SEPARABLE, GL_TRUE);
+
+    glProgramBinary(GLProg, static_cast<GLenum>(Header.BinaryFormat), Data.data() + sizeof(Header), static_cast<GLsizei>(Data.size() - sizeof(Header)));
+
+    // The driver may reject the binary at any time (e.g. after an update that
+    // did not change the version string), in which case the program must be linked
+    // from the source. This is not an error.
+    GLint IsLinked = GL_FALSE;
+    glGetProgramiv(GLProg, GL_LINK_STATUS, &IsLinked);
+    if (glGetError() != GL_NO_ERROR || !IsLinked)
+        return GLObjectWrappers::GLProgramObj::Null();
+
+    return GLProg;
+#else
+    return GLObjectWrappers::GLProgramObj::Null();
+#endif
+}
+
+void PipelineStateCacheGLImpl::StoreProgram(const ContentHash& Key, const GLObjectWrappers::GLProgramObj& GLProgram)
+{
+#if GL_PROGRAM_BINARY_SUPPORTED
+    if (!m_ProgramBinarySupported)
+        return;
+
+    GLint BinaryLength = 0;
+    glGetProgramiv(GLProgram, GL_PROGRAM_BINARY_LENGTH, &BinaryLength);
+    if (glGetError() != GL_NO_ERROR || BinaryLength <= 0)
+        return;
+
+    std::vector<Uint8> Data(sizeof(ProgramBinaryHeader) + static_cast<size_t>(BinaryLength));
+
+    GLenum  BinaryFormat = 0;
+    GLsizei Length       = 0;
+    glGetProgramBinary(GLProgram, BinaryLength, &Length, &BinaryFormat, Data.data() + sizeof(ProgramBinaryHeader));
+    if (glGetError() != GL_NO_ERROR || Length <= 0)
+    {
+        LOG_WARNING_MESSAGE("Failed to retrieve program binary");
+        return;
+    }
+
+    ProgramBinaryHeader Header;
+    Header.BinaryFormat = static_cast<Uint32>(BinaryFormat);
+    memcpy(Data.data(), &Header, sizeof(Header));
+
+    m_Storage.Store(Key, Data.data(), sizeof(Header) + static_cast<size_t>(Length));
+#endif
+}
+
+} // namespace Diligent
@@ -39,6 +39,7 @@
 #include "DeviceContextGLImpl.hpp"
 #include "ShaderResourceBindingGLImpl.hpp"
 #include "GLTypeConversions.hpp"
+#include "PipelineStateCacheGLImpl.hpp"
 
 #include "EngineMemory.h"
 
@@ -64,6 +65,26 @@ static void VerifyResourceMerge(const PipelineStateDesc&                    PSOD
 #undef LOG_RESOURCE_MERGE_ERROR_AND_THROW
 }
 
+// Replaces the shaders with their copies compiled with the specialization constant values.
+// The copies are kept alive by SpecializedShaders until the programs are linked.
+static void SpecializeShaders(const PipelineStateCreateInfo&            CreateInfo,
+                              std::vector<ShaderGLImpl*>&               ShaderStages,
+                              std::vector<RefCntAutoPtr<ShaderGLImpl>>& SpecializedShaders) noexcept(false)
+{
+    if (CreateInfo.NumSpecializationConstants == 0)
+        return;
+
+    for (auto& pShader : ShaderStages)
+    {
+        auto pSpecializedShader = pShader->Specialize(CreateInfo);
+        if (pSpecializedShader.RawPtr() != pShader)
+        {
+            pShader = pSpecializedShader.RawPtr();
+            SpecializedShaders.emplace_back(std::move(pSpecializedShader));
+        }
+    }
+}
+
 PIPELINE_RESOURCE_FLAGS PipelineStateGLImpl::GetSamplerResourceFlag(const TShaderStages& Stages, bool SilenceWarning) const
 {
     VERIFY_EXPR(!Stages.empty());
@@ -259,19 +280,21 @@ void PipelineStateGLImpl::InitInternalObjects(const PSOCreateInfoType& CreateInf
         ActiveStages |= ShaderType;
     }
 
+    auto* pPSOCache = CreateInfo.pPSOCache != nullptr ? ClassPtrCast<PipelineStateCacheGLImpl>(CreateInfo.pPSOCache) : nullptr;
+
     // Create programs.
     if (m_IsProgramPipelineSupported)
     {
         for (size_t i = 0; i < ShaderStages.size(); ++i)
         {
             auto* pShaderGL  = ShaderStages[i];
-            m_GLPrograms[i]  = GLProgramObj{ShaderGLImpl::LinkProgram(&ShaderStages[i], 1, true)};
+            m_GLPrograms[i]  = GLProgramObj{ShaderGLImpl::LinkProgram(&ShaderStages[i], 1, true, pPSOCache)};
             m_ShaderTypes[i] = pShaderGL->GetDesc().ShaderType;
         }
     }
     else
     {
-        m_GLPrograms[0]  = ShaderGLImpl::LinkProgram(ShaderStages.data(), static_cast<Uint32>(ShaderStages.size()), false);
+        m_GLPrograms[0]  = ShaderGLImpl::LinkProgram(ShaderStages.data(), static_cast<Uint32>(ShaderStages.size()), false, pPSOCache);
         m_ShaderTypes[0] = ActiveStages;
 
         m_GLPrograms[0].SetName(m_Desc.Name);
@@ -299,6 +322,9 @@ PipelineStateGLImpl::PipelineStateGLImpl(IReferenceCounters*
         TShaderStages Shaders;
         ExtractShaders<ShaderGLImpl>(CreateInfo, Shaders);
 
+        std::vector<RefCntAutoPtr<ShaderGLImpl>> SpecializedShaders;
+        SpecializeShaders(CreateInfo, Shaders, SpecializedShaders);
+
         RefCntAutoPtr<ShaderGLImpl> pTempPS;
         if (CreateInfo.pPS == nullptr)
         {
@@ -342,6 +368,9 @@ PipelineStateGLImpl::PipelineStateGLImpl(IReferenceCounters*                   p
         TShaderStages Shaders;
         ExtractShaders<ShaderGLImpl>(CreateInfo, Shaders);
 
+        std::vector<RefCntAutoPtr<ShaderGLImpl>> SpecializedShaders;
+        SpecializeShaders(CreateInfo, Shaders, SpecializedShaders);
+
         InitInternalObjects(CreateInfo, Shaders);
     }
     catch (...)
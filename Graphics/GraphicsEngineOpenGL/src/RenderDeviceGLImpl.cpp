@@ -47,6 +47,8 @@
 #include "RenderPassGLImpl.hpp"
 #include "FramebufferGLImpl.hpp"
 #include "PipelineResourceSignatureGLImpl.hpp"
+#include "PipelineStateCacheGLImpl.hpp"
+#include "GLDynamicHeap.hpp"
 
 #include "GLTypeConversions.hpp"
 #include "VAOCache.hpp"
@@ -269,6 +271,23 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
 #endif
         }
     }
+
+    if (EngineCI.DynamicHeapSize != 0)
+    {
+        bool BufferStorageSupported = false;
+#if GL_DYNAMIC_HEAP_SUPPORTED
+        if (m_DeviceInfo.Type == RENDER_DEVICE_TYPE_GL)
+        {
+            BufferStorageSupported =
+                (m_DeviceInfo.APIVersion >= Version{4, 4} || CheckExtension("GL_ARB_buffer_storage")) &&
+                glBufferStorage != nullptr;
+        }
+#endif
+        if (BufferStorageSupported)
+            m_DynamicHeapSize = EngineCI.DynamicHeapSize;
+        else
+            LOG_INFO_MESSAGE("Persistently mapped buffers are not supported by this device. Dynamic buffers will be mapped with glMapBufferRange().");
+    }
 }
 
 RenderDeviceGLImpl::~RenderDeviceGLImpl()
@@ -555,7 +574,7 @@ void RenderDeviceGLImpl::CreateDeviceMemory(const DeviceMemoryCreateInfo& Create
 void RenderDeviceGLImpl::CreatePipelineStateCache(const PipelineStateCacheCreateInfo& CreateInfo,
                                                   IPipelineStateCache**               ppPSOCache)
 {
-    *ppPSOCache = nullptr;
+    CreatePipelineStateCacheImpl(ppPSOCache, CreateInfo);
 }
 
 SparseTextureFormatInfo RenderDeviceGLImpl::GetSparseTextureFormatInfo(TEXTURE_FORMAT     TexFormat,
@@ -688,6 +707,8 @@ void RenderDeviceGLImpl::InitAdapterInfo()
         Features.InstanceDataStepRate       = DEVICE_FEATURE_STATE_ENABLED;
         Features.NativeFence                = DEVICE_FEATURE_STATE_DISABLED;
         Features.TileShaders                = DEVICE_FEATURE_STATE_DISABLED;
+        // Specialization constants are emulated by patching GLSL source
+        Features.SpecializationConstants = DEVICE_FEATURE_STATE_ENABLED;
 
         {
             bool WireframeFillSupported = (glPolygonMode != nullptr);
@@ -956,6 +977,10 @@ void RenderDeviceGLImpl::InitAdapterInfo()
             if (GLVersion >= Version{4, 6} || CheckExtension("GL_ARB_indirect_parameters"))
                 DrawCommandProps.CapFlags |= DRAW_COMMAND_CAP_FLAG_DRAW_INDIRECT_COUNTER_BUFFER;
 
+            // glMultiDrawArrays and glMultiDrawElementsBaseVertex are core since GL 3.2
+            if (GLVersion >= Version{3, 2})
+                DrawCommandProps.CapFlags |= DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW;
+
             // Always 2^32-1 on desktop
             DrawCommandProps.MaxIndexValue = ~Uint32{0};
         }
@@ -1001,7 +1026,7 @@ void RenderDeviceGLImpl::InitAdapterInfo()
     }
 
 #if defined(_MSC_VER) && defined(_WIN64)
-    static_assert(sizeof(DeviceFeatures) == 39, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
+    static_assert(sizeof(DeviceFeatures) == 40, "Did you add a new feature to DeviceFeatures? Please handle its satus here.");
 #endif
 }
 
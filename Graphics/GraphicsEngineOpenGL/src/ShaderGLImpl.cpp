@@ -29,7 +29,13 @@
 
 #include "ShaderGLImpl.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <limits>
 
 #include "RenderDeviceGLImpl.hpp"
 #include "DeviceContextGLImpl.hpp"
@@ -37,12 +43,108 @@
 #include "GLSLUtils.hpp"
 #include "ShaderToolsCommon.hpp"
 #include "GLTypeConversions.hpp"
+#include "PipelineStateCacheGLImpl.hpp"
 
 using namespace Diligent;
 
 namespace Diligent
 {
 
+namespace
+{
+
+bool IsIdentifierChar(char c)
+{
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+size_t SkipSpaces(const char* Str, size_t Pos, size_t End)
+{
+    while (Pos < End && std::isspace(static_cast<unsigned char>(Str[Pos])))
+        ++Pos;
+    return Pos;
+}
+
+size_t SkipIdentifier(const char* Str, size_t Pos, size_t End)
+{
+    while (Pos < End && IsIdentifierChar(Str[Pos]))
+        ++Pos;
+    return Pos;
+}
+
+bool MatchToken(const char* Str, size_t Pos, size_t End, const char* Token)
+{
+    const auto Len = strlen(Token);
+    return Pos + Len <= End && strncmp(Str + Pos, Token, Len) == 0 && (Pos + Len == End || !IsIdentifierChar(Str[Pos + Len]));
+}
+
+Uint32 GetGLSLScalarTypeSize(const std::string& Type)
+{
+    if (Type == "bool" || Type == "int" || Type == "uint" || Type == "float")
+        return 4;
+    else if (Type == "double")
+        return 8;
+    else
+        return 0;
+}
+
+std::string FormatGLSLLiteral(const std::string& Type, const void* pValue)
+{
+    std::stringstream ss;
+    if (Type == "bool")
+    {
+        Uint32 Val;
+        memcpy(&Val, pValue, sizeof(Val));
+        ss << (Val != 0 ? "true" : "false");
+    }
+    else if (Type == "int")
+    {
+        Int32 Val;
+        memcpy(&Val, pValue, sizeof(Val));
+        // -2147483648 is parsed as the negation of an out-of-range literal
+        if (Val == std::numeric_limits<Int32>::min())
+            ss << "(-2147483647 - 1)";
+        else
+            ss << Val;
+    }
+    else if (Type == "uint")
+    {
+        Uint32 Val;
+        memcpy(&Val, pValue, sizeof(Val));
+        ss << Val << 'u';
+    }
+    else if (Type == "float")
+    {
+        float Val;
+        memcpy(&Val, pValue, sizeof(Val));
+        if (std::isfinite(Val))
+        {
+            // 9 significant digits are enough to restore the exact value
+            ss << std::setprecision(9) << std::showpoint << Val;
+        }
+        else
+        {
+            Uint32 Bits;
+            memcpy(&Bits, pValue, sizeof(Bits));
+            ss << "uintBitsToFloat(0x" << std::hex << Bits << "u)";
+        }
+    }
+    else if (Type == "double")
+    {
+        double Val;
+        memcpy(&Val, pValue, sizeof(Val));
+        DEV_CHECK_ERR(std::isfinite(Val), "Non-finite double specialization constants are not supported");
+        ss << std::setprecision(17) << std::showpoint << Val << "lf";
+    }
+    else
+    {
+        UNEXPECTED("Unexpected type");
+    }
+    return ss.str();
+}
+
+} // namespace
+
 ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
                            RenderDeviceGLImpl*     pDeviceGL,
                            const ShaderCreateInfo& ShaderCI,
@@ -109,6 +211,22 @@ ShaderGLImpl::ShaderGLImpl(IReferenceCounters*     pRefCounters,
         Lengths[0]       = static_cast<GLint>(GLSLSourceString.length());
     }
 
+    // constant_id layout qualifier is not allowed in OpenGL GLSL,
+    // so it is removed and the constants are specialized in the source.
+    if (m_SourceLanguage != SHADER_SOURCE_LANGUAGE_HLSL &&
+        InitSpecializationConstants(ShaderStrings[0], static_cast<size_t>(Lengths[0])))
+    {
+        ShaderStrings[0] = m_SpecializableSource.c_str();
+        Lengths[0]       = static_cast<GLint>(m_SpecializableSource.length());
+    }
+
+
+    {
+        const Uint32 ShaderType = static_cast<Uint32>(m_Desc.ShaderType);
+        m_SourceHash            = ComputeContentHash(&ShaderType, sizeof(ShaderType));
+        for (size_t i = 0; i < ShaderStrings.size(); ++i)
+            m_SourceHash = ComputeContentHash(ShaderStrings[i], static_cast<size_t>(Lengths[i]), m_SourceHash);
+    }
 
     // Provide source strings (the strings will be saved in internal OpenGL memory)
     glShaderSource(m_GLShaderObj, static_cast<GLsizei>(ShaderStrings.size()), ShaderStrings.data(), Lengths.data());
@@ -188,17 +306,284 @@ ShaderGLImpl::~ShaderGLImpl()
 
 IMPLEMENT_QUERY_INTERFACE(ShaderGLImpl, IID_ShaderGL, TShaderBase)
 
+bool ShaderGLImpl::InitSpecializationConstants(const char* Source, size_t Length)
+{
+    // The source is not preprocessed, so the declarations are matched as text. A declaration is a line
+    // that starts with 'layout(constant_id' and must have the exact form
+    //
+    //      layout(constant_id = N) const Type Name = Value;
+    //
+    // where Type is bool, int, uint, float or double. Other qualifiers, multiple declarators and
+    // declarations that span several lines are rejected. Declarations in block comments and disabled
+    // conditional blocks are processed as the active ones; commented-out lines are skipped because
+    // 'layout' is not the first token of the line.
+
+    static constexpr char ConstantId[] = "constant_id";
+    static constexpr char Layout[]     = "layout";
+
+    // Offset of the first source character that has not been copied to m_SpecializableSource yet
+    size_t CopyPos = 0;
+    for (size_t Pos = 0; Pos < Length; ++Pos)
+    {
+        // The source is not necessarily null-terminated
+        const auto* pFound = std::search(Source + Pos, Source + Length, ConstantId, ConstantId + sizeof(ConstantId) - 1);
+        if (pFound == Source + Length)
+            break;
+        Pos = static_cast<size_t>(pFound - Source);
+
+        // Go back to the layout qualifier: 'layout' '('
+        size_t LayoutStart = Pos;
+        while (LayoutStart > 0 && std::isspace(static_cast<unsigned char>(Source[LayoutStart - 1])))
+            --LayoutStart;
+        if (LayoutStart == 0 || Source[LayoutStart - 1] != '(')
+            continue;
+        --LayoutStart;
+        while (LayoutStart > 0 && std::isspace(static_cast<unsigned char>(Source[LayoutStart - 1])))
+            --LayoutStart;
+        if (LayoutStart < sizeof(Layout) - 1 || strncmp(Source + LayoutStart - (sizeof(Layout) - 1), Layout, sizeof(Layout) - 1) != 0)
+            continue;
+        LayoutStart -= sizeof(Layout) - 1;
+
+        // 'layout' must be the first token of the line
+        size_t LineStart = LayoutStart;
+        while (LineStart > 0 && Source[LineStart - 1] != '\n' && std::isspace(static_cast<unsigned char>(Source[LineStart - 1])))
+            --LineStart;
+        if (LineStart > 0 && Source[LineStart - 1] != '\n')
+            continue;
+
+        // The rest of the declaration is parsed up to the end of the line
+        const size_t LineEnd = static_cast<size_t>(std::find(Source + LayoutStart, Source + Length, '\n') - Source);
+
+        const auto ThrowUnsupported = [&]() {
+            LOG_ERROR_AND_THROW("Unsupported specialization constant declaration '", std::string{Source + LayoutStart, LineEnd - LayoutStart},
+                                "' in shader '", m_Desc.Name, "'. OpenGL backend only supports single-line declarations of the form "
+                                                              "'layout(constant_id = N) const Type Name = Value;', where Type is bool, int, uint, float or double.");
+        };
+
+        if (Pos >= LineEnd)
+            ThrowUnsupported();
+
+        // '=' N ')'
+        size_t LayoutEnd = SkipSpaces(Source, Pos + sizeof(ConstantId) - 1, LineEnd);
+        if (LayoutEnd == LineEnd || Source[LayoutEnd] != '=')
+            ThrowUnsupported();
+        LayoutEnd          = SkipSpaces(Source, LayoutEnd + 1, LineEnd);
+        const auto IdStart = LayoutEnd;
+        while (LayoutEnd < LineEnd && std::isdigit(static_cast<unsigned char>(Source[LayoutEnd])))
+            ++LayoutEnd;
+        if (LayoutEnd == IdStart)
+            ThrowUnsupported();
+        LayoutEnd = SkipSpaces(Source, LayoutEnd, LineEnd);
+        if (LayoutEnd == LineEnd || Source[LayoutEnd] != ')')
+            ThrowUnsupported();
+        ++LayoutEnd;
+
+        // 'const' Type Name '=' Value ';'
+        size_t DeclPos = SkipSpaces(Source, LayoutEnd, LineEnd);
+        if (!MatchToken(Source, DeclPos, LineEnd, "const"))
+            ThrowUnsupported();
+        DeclPos = SkipSpaces(Source, DeclPos + 5, LineEnd);
+
+        const auto TypeStart = DeclPos;
+        DeclPos              = SkipIdentifier(Source, DeclPos, LineEnd);
+        const auto TypeEnd   = DeclPos;
+
+        DeclPos              = SkipSpaces(Source, DeclPos, LineEnd);
+        const auto NameStart = DeclPos;
+        DeclPos              = SkipIdentifier(Source, DeclPos, LineEnd);
+        const auto NameEnd   = DeclPos;
+        if (NameStart == NameEnd || GetGLSLScalarTypeSize(std::string{Source + TypeStart, TypeEnd - TypeStart}) == 0)
+            ThrowUnsupported();
+
+        DeclPos = SkipSpaces(Source, DeclPos, LineEnd);
+        if (DeclPos == LineEnd || Source[DeclPos] != '=')
+            ThrowUnsupported();
+
+        const auto ValueStart = SkipSpaces(Source, DeclPos + 1, LineEnd);
+        auto       ValueEnd   = ValueStart;
+        // A comma outside of parentheses separates multiple declarators
+        int ParenDepth = 0;
+        while (ValueEnd < LineEnd && Source[ValueEnd] != ';')
+        {
+            if (Source[ValueEnd] == '(')
+                ++ParenDepth;
+            else if (Source[ValueEnd] == ')')
+                --ParenDepth;
+            else if (Source[ValueEnd] == ',' && ParenDepth == 0)
+                ThrowUnsupported();
+            ++ValueEnd;
+        }
+        if (ValueEnd == LineEnd)
+            ThrowUnsupported();
+        while (ValueEnd > ValueStart && std::isspace(static_cast<unsigned char>(Source[ValueEnd - 1])))
+            --ValueEnd;
+        if (ValueEnd == ValueStart)
+            ThrowUnsupported();
+
+        if (m_SpecConstants.empty())
+            m_SpecializableSource.reserve(Length);
+
+        // Remove the layout qualifier. The value range is translated to the offsets in
+        // m_SpecializableSource, which continues from LayoutEnd.
+        m_SpecializableSource.append(Source + CopyPos, LayoutStart - CopyPos);
+        CopyPos = LayoutEnd;
+
+        SpecializationConstantDecl Decl;
+        Decl.Name       = std::string{Source + NameStart, NameEnd - NameStart};
+        Decl.Type       = std::string{Source + TypeStart, TypeEnd - TypeStart};
+        Decl.ValueStart = m_SpecializableSource.length() + (ValueStart - LayoutEnd);
+        Decl.ValueEnd   = m_SpecializableSource.length() + (ValueEnd - LayoutEnd);
+        m_SpecConstants.emplace_back(std::move(Decl));
+
+        Pos = ValueEnd;
+    }
+
+    if (m_SpecConstants.empty())
+        return false;
 
-GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(ShaderGLImpl* const* ppShaders, Uint32 NumShaders, bool IsSeparableProgram)
+    m_SpecializableSource.append(Source + CopyPos, Length - CopyPos);
+    return true;
+}
+
+RefCntAutoPtr<ShaderGLImpl> ShaderGLImpl::Specialize(const PipelineStateCreateInfo& CreateInfo) noexcept(false)
+{
+    RefCntAutoPtr<ShaderGLImpl> pShader{this};
+    if (m_SpecConstants.empty() || CreateInfo.NumSpecializationConstants == 0)
+        return pShader;
+
+    // Values of the declared constants; null for the constants that keep their default values
+    std::vector<const SpecializationConstant*> Values(m_SpecConstants.size());
+
+    bool IsSpecialized = false;
+    for (Uint32 i = 0; i < CreateInfo.NumSpecializationConstants; ++i)
+    {
+        const auto& Const = CreateInfo.pSpecializationConstants[i];
+        if ((Const.ShaderStages & m_Desc.ShaderType) == 0)
+            continue;
+
+        for (size_t j = 0; j < m_SpecConstants.size(); ++j)
+        {
+            const auto& Decl = m_SpecConstants[j];
+            if (Decl.Name != Const.Name)
+                continue;
+
+            // Unsupported types are rejected by InitSpecializationConstants
+            const auto TypeSize = GetGLSLScalarTypeSize(Decl.Type);
+            VERIFY_EXPR(TypeSize != 0);
+            if (TypeSize != Const.Size)
+            {
+                LOG_ERROR_AND_THROW("The size (", Const.Size, ") of specialization constant '", Const.Name,
+                                    "' does not match the size of the constant in shader '", m_Desc.Name, "' (", TypeSize, ").");
+            }
+
+            Values[j]     = &Const;
+            IsSpecialized = true;
+        }
+    }
+    if (!IsSpecialized)
+        return pShader;
+
+    std::string Source;
+    Source.reserve(m_SpecializableSource.length());
+    size_t Pos = 0;
+    for (size_t j = 0; j < m_SpecConstants.size(); ++j)
+    {
+        const auto& Decl = m_SpecConstants[j];
+        Source.append(m_SpecializableSource, Pos, Decl.ValueStart - Pos);
+        if (Values[j] != nullptr)
+            Source.append(FormatGLSLLiteral(Decl.Type, Values[j]->pValue));
+        else
+            Source.append(m_SpecializableSource, Decl.ValueStart, Decl.ValueEnd - Decl.ValueStart);
+        Pos = Decl.ValueEnd;
+    }
+    Source.append(m_SpecializableSource, Pos, std::string::npos);
+
+    const auto Hash = ComputeContentHash(Source.data(), Source.length());
+    {
+        std::lock_guard<std::mutex> Lock{m_SpecializedShadersMtx};
+
+        auto it = m_SpecializedShaders.find(Hash);
+        if (it != m_SpecializedShaders.end())
+        {
+            m_SpecializedShadersLRU.splice(m_SpecializedShadersLRU.begin(), m_SpecializedShadersLRU, it->second.LRUPos);
+            return it->second.pShader;
+        }
+    }
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Source         = Source.c_str();
+    ShaderCI.SourceLength   = Source.length();
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_GLSL_VERBATIM;
+    ShaderCI.Desc           = m_Desc;
+
+    RefCntAutoPtr<ShaderGLImpl> pSpecializedShader;
+    GetDevice()->CreateShader(ShaderCI, pSpecializedShader.DblPtr<IShader>(), m_bIsDeviceInternal);
+    if (!pSpecializedShader)
+        LOG_ERROR_AND_THROW("Failed to create specialized copy of shader '", m_Desc.Name, "'.");
+
+    // Released copies are destroyed after the lock is released
+    std::vector<RefCntAutoPtr<ShaderGLImpl>> EvictedShaders;
+
+    std::lock_guard<std::mutex> Lock{m_SpecializedShadersMtx};
+
+    // Another thread may have created the same shader in the meantime
+    auto it = m_SpecializedShaders.find(Hash);
+    if (it != m_SpecializedShaders.end())
+    {
+        m_SpecializedShadersLRU.splice(m_SpecializedShadersLRU.begin(), m_SpecializedShadersLRU, it->second.LRUPos);
+        return it->second.pShader;
+    }
+
+    while (m_SpecializedShaders.size() >= MaxSpecializedShaders)
+    {
+        auto evict_it = m_SpecializedShaders.find(m_SpecializedShadersLRU.back());
+        VERIFY_EXPR(evict_it != m_SpecializedShaders.end());
+        EvictedShaders.emplace_back(std::move(evict_it->second.pShader));
+        m_SpecializedShaders.erase(evict_it);
+        m_SpecializedShadersLRU.pop_back();
+    }
+
+    m_SpecializedShadersLRU.emplace_front(Hash);
+    m_SpecializedShaders.emplace(Hash, SpecializedShaderInfo{pSpecializedShader, m_SpecializedShadersLRU.begin()});
+    return pSpecializedShader;
+}
+
+
+GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(ShaderGLImpl* const*      ppShaders,
+                                                         Uint32                    NumShaders,
+                                                         bool                      IsSeparableProgram,
+                                                         PipelineStateCacheGLImpl* pPSOCache)
 {
     VERIFY(!IsSeparableProgram || NumShaders == 1, "Number of shaders must be 1 when separable program is created");
 
+    if (pPSOCache != nullptr && !pPSOCache->IsProgramBinarySupported())
+        pPSOCache = nullptr;
+
+    ContentHash CacheKey;
+    if (pPSOCache != nullptr)
+    {
+        const Uint32 Separable = IsSeparableProgram ? 1 : 0;
+        CacheKey               = ComputeContentHash(&Separable, sizeof(Separable));
+        for (Uint32 i = 0; i < NumShaders; ++i)
+            CacheKey = ComputeContentHash(&ppShaders[i]->m_SourceHash, sizeof(ContentHash), CacheKey);
+
+        auto GLProg = pPSOCache->LoadProgram(CacheKey, IsSeparableProgram);
+        if (GLProg)
+            return GLProg;
+    }
+
     GLObjectWrappers::GLProgramObj GLProg(true);
 
     // GL_PROGRAM_SEPARABLE parameter must be set before linking!
     if (IsSeparableProgram)
         glProgramParameteri(GLProg, GL_PROGRAM_SEPARABLE, GL_TRUE);
 
+#ifdef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    // Some drivers only keep the binary if the hint is set before linking
+    if (pPSOCache != nullptr)
+        glProgramParameteri(GLProg, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+
     for (Uint32 i = 0; i < NumShaders; ++i)
     {
         auto* pCurrShader = ppShaders[i];
@@ -237,6 +622,10 @@ GLObjectWrappers::GLProgramObj ShaderGLImpl::LinkProgram(ShaderGLImpl* const* pp
         LOG_ERROR_MESSAGE("Failed to link shader program:\n", shaderProgramInfoLog.data(), '\n');
         UNEXPECTED("glLinkProgram failed");
     }
+    else if (pPSOCache != nullptr)
+    {
+        pPSOCache->StoreProgram(CacheKey, GLProg);
+    }
 
     for (Uint32 i = 0; i < NumShaders; ++i)
     {
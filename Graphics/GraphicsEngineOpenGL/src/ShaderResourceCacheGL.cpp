@@ -137,7 +137,7 @@ void ShaderResourceCacheGL::BindResources(GLContextState&              GLState,
                                            // will reflect data written by shaders prior to the barrier
             GLState);
 
-        GLState.BindUniformBuffer(binding, pBufferGL->GetGLHandle(), UB.BaseOffset + UB.DynamicOffset, UB.RangeSize);
+        GLState.BindUniformBuffer(binding, pBufferGL->GetDynamicGLHandle(), StaticCast<GLintptr>(pBufferGL->GetDynamicOffset() + UB.BaseOffset + UB.DynamicOffset), UB.RangeSize);
     }
 
     for (Uint32 s = 0, binding = BaseBindings[BINDING_RANGE_TEXTURE]; s < GetTextureCount(); ++s, ++binding)
@@ -312,7 +312,8 @@ void ShaderResourceCacheGL::BindDynamicBuffers(GLContextState&              GLSt
         const auto  UBOIdx = PlatformMisc::GetLSB(UBOBit);
         const auto& UB     = GetConstUB(UBOIdx);
         VERIFY_EXPR(UB.IsDynamic());
-        GLState.BindUniformBuffer(BaseUBOBinding + UBOIdx, UB.pBuffer->GetGLHandle(), UB.BaseOffset + UB.DynamicOffset, UB.RangeSize);
+        const auto* pBufferGL = UB.pBuffer.RawPtr<const BufferGLImpl>();
+        GLState.BindUniformBuffer(BaseUBOBinding + UBOIdx, pBufferGL->GetDynamicGLHandle(), StaticCast<GLintptr>(pBufferGL->GetDynamicOffset() + UB.BaseOffset + UB.DynamicOffset), UB.RangeSize);
     }
 
 
@@ -335,6 +336,18 @@ void ShaderResourceCacheGL::BindDynamicBuffers(GLContextState&              GLSt
     }
 }
 
+#ifdef DILIGENT_DEVELOPMENT
+void ShaderResourceCacheGL::DvpVerifyDynamicAllocations(const GLDynamicHeap& DynamicHeap) const
+{
+    for (Uint32 ub = 0; ub < GetUBCount(); ++ub)
+    {
+        const auto& UB = GetConstUB(ub);
+        if (UB.pBuffer)
+            UB.pBuffer->DvpVerifyDynamicAllocation(DynamicHeap);
+    }
+}
+#endif
+
 #ifdef DILIGENT_DEBUG
 void ShaderResourceCacheGL::DbgVerifyDynamicBufferMasks() const
 {
@@ -126,6 +126,28 @@ public:
         return reinterpret_cast<Uint8*>(m_MemoryAllocation.Page->GetCPUMemory()) + m_BufferMemoryAlignedOffset;
     }
 
+    // Returns true if the buffer can be moved to another memory page by the defragmentation pass,
+    // see DeviceContextVkImpl::DefragmentMemory().
+    bool IsRelocatable() const { return m_IsRelocatable; }
+
+    // Returns true if the buffer memory is in a page that is being evacuated.
+    bool IsBeingEvacuated() const;
+
+    struct RelocationTarget
+    {
+        VulkanUtilities::BufferWrapper          vkBuffer;
+        VulkanUtilities::VulkanMemoryAllocation MemoryAllocation;
+        VkDeviceSize                            MemoryAlignedOffset = 0;
+    };
+
+    // Creates a new Vulkan buffer and binds it to the memory in another page.
+    // Returns false if the memory can't be allocated.
+    bool CreateRelocationTarget(RelocationTarget& Target);
+
+    // Replaces the Vulkan buffer and its memory with the ones from Target and releases the old ones.
+    // The caller is responsible for copying the buffer contents.
+    void Relocate(RelocationTarget&& Target);
+
 private:
     friend class DeviceContextVkImpl;
 
@@ -136,6 +158,10 @@ private:
     Uint32       m_DynamicOffsetAlignment    = 0;
     VkDeviceSize m_BufferMemoryAlignedOffset = 0;
 
+    // Usage flags that are required to recreate the buffer when it is relocated
+    VkBufferUsageFlags m_VkUsageFlags  = 0;
+    bool               m_IsRelocatable = false;
+
     // TODO (assiduous): move dynamic allocations to device context.
     static constexpr size_t CacheLineSize = 64;
     struct alignas(CacheLineSize) CtxDynamicData : VulkanDynamicAllocation
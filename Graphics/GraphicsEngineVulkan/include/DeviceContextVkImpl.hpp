@@ -143,6 +143,10 @@ public:
     virtual void DILIGENT_CALL_TYPE Draw               (const DrawAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DrawIndexed() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE DrawIndexed        (const DrawIndexedAttribs& Attribs) override final;
+    /// Implementation of IDeviceContext::MultiDraw() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE MultiDraw          (const MultiDrawAttribs& Attribs) override final;
+    /// Implementation of IDeviceContext::MultiDrawIndexed() in Vulkan backend.
+    virtual void DILIGENT_CALL_TYPE MultiDrawIndexed   (const MultiDrawIndexedAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DrawIndirect() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE DrawIndirect       (const DrawIndirectAttribs& Attribs) override final;
     /// Implementation of IDeviceContext::DrawIndexedIndirect() in Vulkan backend.
@@ -318,6 +322,16 @@ public:
     /// Implementation of IDeviceContextVk::GetVkCommandBuffer().
     virtual VkCommandBuffer DILIGENT_CALL_TYPE GetVkCommandBuffer() override final;
 
+    /// Implementation of IDeviceContextVk::GetBarrierStatistics().
+    virtual BarrierStatisticsVk DILIGENT_CALL_TYPE GetBarrierStatistics() const override final;
+
+    /// Implementation of IDeviceContextVk::ResetBarrierStatistics().
+    virtual void DILIGENT_CALL_TYPE ResetBarrierStatistics() override final;
+
+    /// Implementation of IDeviceContextVk::DefragmentMemory().
+    virtual void DILIGENT_CALL_TYPE DefragmentMemory(const MemoryDefragmentationAttribsVk& Attribs,
+                                                     MemoryDefragmentationStatsVk*         pStats) override final;
+
     // Transitions BLAS state from OldState to NewState, and optionally updates internal state.
     // If OldState == RESOURCE_STATE_UNKNOWN, internal BLAS state is used as old state.
     void TransitionBLASState(BottomLevelASVkImpl& BLAS,
@@ -437,6 +451,9 @@ private:
 
     void AliasingBarrier(IDeviceObject* pResourceBefore, IDeviceObject* pResourceAfter);
 
+    bool RelocateBuffer(BufferVkImpl& BufferVk);
+    bool RelocateTexture(TextureVkImpl& TextureVk);
+
     __forceinline void EnsureVkCmdBuffer()
     {
         VERIFY_EXPR(m_CmdPool != nullptr);
@@ -472,11 +489,15 @@ private:
                              Uint64                         DstBufferOffset,
                              Uint32                         DstBufferRowStrideInTexels);
 
-    __forceinline void          PrepareForDraw(DRAW_FLAGS Flags);
-    __forceinline void          PrepareForIndexedDraw(DRAW_FLAGS Flags, VALUE_TYPE IndexType);
+    // Prepare* methods return false if the command must be skipped because
+    // the pipeline is still being compiled asynchronously.
+    __forceinline bool          PrepareForDraw(DRAW_FLAGS Flags);
+    __forceinline bool          PrepareForIndexedDraw(DRAW_FLAGS Flags, VALUE_TYPE IndexType);
     __forceinline BufferVkImpl* PrepareIndirectAttribsBuffer(IBuffer* pAttribsBuffer, RESOURCE_STATE_TRANSITION_MODE TransitionMode, const char* OpName);
-    __forceinline void          PrepareForDispatchCompute();
-    __forceinline void          PrepareForRayTracing();
+    __forceinline bool          PrepareForDispatchCompute();
+    __forceinline bool          PrepareForRayTracing();
+
+    bool BindPendingPipeline();
 
     void DvpLogRenderPass_PSOMismatch();
 
@@ -500,6 +521,10 @@ private:
         /// vkCmdSetFragmentShadingRateKHR must be called before the draw.
         bool ShadingRateIsSet = false;
 
+        /// Flag indicating that the pipeline state has been set, but the Vulkan pipeline
+        /// has not been bound because the PSO is still being compiled asynchronously.
+        bool PipelineBindPending = false;
+
         Uint32 NumCommands = 0;
 
         VkPipelineBindPoint vkPipelineBindPoint = VK_PIPELINE_BIND_POINT_MAX_ENUM;
@@ -551,6 +576,12 @@ private:
     /// Memory to store dynamic buffer offsets for descriptor sets.
     std::vector<Uint32> m_DynamicBufferOffsets;
 
+#ifdef VK_EXT_multi_draw
+    /// Memory to store draw items of native multi-draw commands.
+    std::vector<VkMultiDrawInfoEXT>        m_MultiDrawInfo;
+    std::vector<VkMultiDrawIndexedInfoEXT> m_MultiDrawIndexedInfo;
+#endif
+
     /// Render pass that matches currently bound render targets.
     /// This render pass may or may not be currently set in the command buffer
     VkRenderPass m_vkRenderPass = VK_NULL_HANDLE;
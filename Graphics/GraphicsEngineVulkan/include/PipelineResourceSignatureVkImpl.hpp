@@ -119,6 +119,10 @@ public:
     void CommitDynamicResources(const ShaderResourceCacheVk& ResourceCache,
                                 VkDescriptorSet              vkDynamicDescriptorSet) const;
 
+    // Writes static and mutable resources that have been bound since the last commit
+    // to the static/mutable descriptor set of ResourceCache
+    void CommitStaticMutableResources(ShaderResourceCacheVk& ResourceCache, Uint32 RelocationEpoch) const;
+
 #ifdef DILIGENT_DEVELOPMENT
     /// Verifies committed resource using the SPIRV resource attributes from the PSO.
     bool DvpValidateCommittedResource(const DeviceContextVkImpl*        pDeviceCtx,
@@ -160,6 +164,21 @@ private:
     void Destruct();
 
     void CreateSetLayouts();
+    void CreateDescriptorUpdateTemplates();
+
+    // Returns the range of resources that are allocated in the given descriptor set
+    std::pair<Uint32, Uint32> GetDescriptorSetResourceRange(DESCRIPTOR_SET_ID SetId) const;
+
+    // Writes all resources of the given set using the descriptor update template.
+    // Returns false if the template can't be used, e.g. when not all resources are bound.
+    bool WriteDescriptorSetWithTemplate(const ShaderResourceCacheVk& ResourceCache,
+                                        DESCRIPTOR_SET_ID            SetId,
+                                        VkDescriptorSet              vkDescriptorSet) const;
+
+    // Writes all non-null resources of the given set using batched vkUpdateDescriptorSets calls.
+    void WriteDescriptorSet(const ShaderResourceCacheVk& ResourceCache,
+                            DESCRIPTOR_SET_ID            SetId,
+                            VkDescriptorSet              vkDescriptorSet) const;
 
     static inline CACHE_GROUP       GetResourceCacheGroup(const PipelineResourceDesc& Res);
     static inline DESCRIPTOR_SET_ID VarTypeToDescriptorSetId(SHADER_RESOURCE_VARIABLE_TYPE VarType);
@@ -167,6 +186,10 @@ private:
 private:
     std::array<VulkanUtilities::DescriptorSetLayoutWrapper, DESCRIPTOR_SET_ID_NUM_SETS> m_VkDescrSetLayouts;
 
+    // Descriptor update templates that write all resources of the SRB resource cache descriptor set.
+    // Null if VK_KHR_descriptor_update_template is not enabled.
+    std::array<VulkanUtilities::DescrUpdateTemplateWrapper, DESCRIPTOR_SET_ID_NUM_SETS> m_VkDescrUpdateTemplates;
+
     // Descriptor set sizes indexed by the set index in the layout (not DESCRIPTOR_SET_ID!)
     std::array<Uint32, MAX_DESCRIPTOR_SETS> m_DescriptorSetSizes = {~0U, ~0U};
 
@@ -58,6 +58,8 @@ public:
     virtual VkPipelineCache DILIGENT_CALL_TYPE GetVkPipelineCache() const override final { return m_PipelineStateCache; }
 
 private:
+    bool IsCompatibleDriverData(const Uint8* pData, size_t DataSize) const;
+
     VulkanUtilities::PipelineCacheWrapper m_PipelineStateCache;
 };
 
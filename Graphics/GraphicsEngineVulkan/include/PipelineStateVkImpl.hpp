@@ -41,6 +41,7 @@
 #include "FixedBlockMemoryAllocator.hpp"
 #include "SRBMemoryAllocator.hpp"
 #include "PipelineLayoutVk.hpp"
+#include "HashUtils.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
 #include "VulkanUtilities/VulkanCommandBuffer.hpp"
 
@@ -98,12 +99,20 @@ public:
 #endif
 
 private:
+    // Initializes the pipeline description and the layout. If the pipeline entry is found in the PSO cache,
+    // the byte code of all shaders is replaced with the cached one and IsCachedByteCode is set to true.
     template <typename PSOCreateInfoType>
-    TShaderStages InitInternalObjects(const PSOCreateInfoType&                           CreateInfo,
-                                      std::vector<VkPipelineShaderStageCreateInfo>&      vkShaderStages,
-                                      std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules);
+    TShaderStages InitInternalObjects(const PSOCreateInfoType&  CreateInfo,
+                                      PipelineStateCacheVkImpl* pPSOCache,
+                                      ContentHash&              PSOCacheKey,
+                                      bool&                     IsCachedByteCode);
 
-    void InitPipelineLayout(TShaderStages& ShaderStages);
+    // Initializes the pipeline layout and runs the task that creates shader modules and calls
+    // CreatePipelineHandler(vkShaderStages, vkPipelineCache) to create the Vulkan pipeline.
+    template <typename PSOCreateInfoType, typename CreatePipelineHandlerType>
+    void InitPipeline(const PSOCreateInfoType& CreateInfo, CreatePipelineHandlerType&& CreatePipelineHandler);
+
+    void InitPipelineLayout(TShaderStages& ShaderStages, bool RemapBindings);
 
     RefCntAutoPtr<PipelineResourceSignatureVkImpl> CreateDefaultSignature(const TShaderStages& ShaderStages);
 
@@ -30,7 +30,10 @@
 /// \file
 /// Declaration of Diligent::RenderDeviceVkImpl class
 #include <memory>
+#include <mutex>
+#include <atomic>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "EngineVkImplTraits.hpp"
@@ -51,6 +54,7 @@
 #include "VulkanUploadHeap.hpp"
 #include "FramebufferCache.hpp"
 #include "RenderPassCache.hpp"
+#include "ShaderModuleCache.hpp"
 #include "CommandPoolManager.hpp"
 #include "DXCompiler.hpp"
 
@@ -58,6 +62,8 @@ namespace Diligent
 {
 
 class QueryManagerVk;
+class BufferVkImpl;
+class TextureVkImpl;
 
 /// Render device implementation in Vulkan backend.
 class RenderDeviceVkImpl final : public RenderDeviceNextGenBase<RenderDeviceBase<EngineVkImplTraits>, ICommandQueueVk>
@@ -195,6 +201,15 @@ public:
                                                                   const FenceDesc& Desc,
                                                                   IFence**         ppFence) override final;
 
+    /// Implementation of IRenderDeviceVk::GetShaderModuleCacheStats().
+    virtual ShaderModuleCacheStats DILIGENT_CALL_TYPE GetShaderModuleCacheStats() const override final
+    {
+        return m_ShaderModuleCache.GetStats();
+    }
+
+    /// Implementation of IRenderDeviceVk::GetMemoryStatistics().
+    virtual void DILIGENT_CALL_TYPE GetMemoryStatistics(Uint32& NumMemoryTypes, DeviceMemoryStatsVk* pStats) override final;
+
     /// Implementation of IRenderDevice::IdleGPU() in Vulkan backend.
     virtual void DILIGENT_CALL_TYPE IdleGPU() override final;
 
@@ -230,6 +245,8 @@ public:
     FramebufferCache& GetFramebufferCache() { return m_FramebufferCache; }
     RenderPassCache&  GetImplicitRenderPassCache() { return m_ImplicitRenderPassCache; }
 
+    ShaderModuleCache& GetShaderModuleCache() { return m_ShaderModuleCache; }
+
     VulkanUtilities::VulkanMemoryAllocation AllocateMemory(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProperties, VkMemoryAllocateFlags AllocateFlags = 0)
     {
         return m_MemoryMgr.Allocate(MemReqs, MemoryProperties, AllocateFlags);
@@ -243,6 +260,33 @@ public:
     }
     VulkanUtilities::VulkanMemoryManager& GetGlobalMemoryManager() { return m_MemoryMgr; }
 
+    // Buffers and textures that can be moved to other memory pages by the defragmentation pass
+    // (see DeviceContextVkImpl::DefragmentMemory()) are registered by CreateBuffer() and CreateTexture()
+    // once fully constructed, and unregister themselves at the beginning of the destructor.
+    void RegisterRelocatableResource(BufferVkImpl* pBuffer);
+    void RegisterRelocatableResource(TextureVkImpl* pTexture);
+    void UnregisterRelocatableResource(BufferVkImpl* pBuffer);
+    void UnregisterRelocatableResource(TextureVkImpl* pTexture);
+
+    struct RelocatableResources
+    {
+        std::unique_lock<std::mutex>              Lock;
+        const std::unordered_set<BufferVkImpl*>&  Buffers;
+        const std::unordered_set<TextureVkImpl*>& Textures;
+    };
+    // Returns the registered resources. The registry is locked until the returned object is destroyed,
+    // which prevents the resources from being destroyed, but not released.
+    RelocatableResources LockRelocatableResources()
+    {
+        return {std::unique_lock<std::mutex>{m_RelocatableResourcesMtx}, m_RelocatableBuffers, m_RelocatableTextures};
+    }
+
+    // The counter is incremented every time the defragmentation pass replaces Vulkan handles
+    // of some resources. Shader resource caches compare it with the value at which their
+    // descriptor sets have been written to find out if the sets must be rewritten.
+    Uint32 GetResourceRelocationEpoch() const { return m_ResourceRelocationEpoch.load(); }
+    void   OnResourcesRelocated() { m_ResourceRelocationEpoch.fetch_add(1); }
+
     VulkanDynamicMemoryManager& GetDynamicMemoryManager() { return m_DynamicMemoryManager; }
 
     void FlushStaleResources(SoftwareQueueIndex CmdQueueIndex);
@@ -291,6 +335,7 @@ private:
 
     FramebufferCache       m_FramebufferCache;
     RenderPassCache        m_ImplicitRenderPassCache;
+    ShaderModuleCache      m_ShaderModuleCache;
     DescriptorSetAllocator m_DescriptorSetAllocator;
     DescriptorPoolManager  m_DynamicDescriptorPool;
 
@@ -304,6 +349,11 @@ private:
 
     VulkanUtilities::VulkanMemoryManager m_MemoryMgr;
 
+    std::mutex                         m_RelocatableResourcesMtx;
+    std::unordered_set<BufferVkImpl*>  m_RelocatableBuffers;
+    std::unordered_set<TextureVkImpl*> m_RelocatableTextures;
+    std::atomic<Uint32>                m_ResourceRelocationEpoch{0};
+
     VulkanDynamicMemoryManager m_DynamicMemoryManager;
 
     std::unique_ptr<IDXCompiler> m_pDxCompiler;
@@ -0,0 +1,102 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::ShaderModuleCache class
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "GraphicsTypes.h"
+#include "HashUtils.hpp"
+#include "VulkanUtilities/VulkanLogicalDevice.hpp"
+
+namespace Diligent
+{
+
+/// Device-level cache of Vulkan shader modules.
+
+/// Shader modules are keyed by the content hash of the SPIRV bytecode with remapped
+/// bindings, so that pipelines that use the same shader with compatible layouts share
+/// one module, and reflection stripping is only performed once per unique module.
+/// Modules are kept alive by the pipelines being created, so that evicting a module
+/// from the cache never invalidates it while it is in use.
+class ShaderModuleCache
+{
+public:
+    using ModulePtr = std::shared_ptr<const VulkanUtilities::ShaderModuleWrapper>;
+
+    /// MaxModules is the maximum number of modules kept in the cache;
+    /// least recently used modules are evicted first. Zero disables the cache.
+    explicit ShaderModuleCache(Uint32 MaxModules) :
+        m_MaxModules{MaxModules}
+    {}
+
+    // clang-format off
+    ShaderModuleCache             (const ShaderModuleCache&) = delete;
+    ShaderModuleCache             (ShaderModuleCache&&)      = delete;
+    ShaderModuleCache& operator = (const ShaderModuleCache&) = delete;
+    ShaderModuleCache& operator = (ShaderModuleCache&&)      = delete;
+    // clang-format on
+
+    /// Returns the module with the given key, or null if there is no such module in the cache.
+    ModulePtr Find(const ContentHash& Key);
+
+    /// Adds the module to the cache. If a module with the same key was added by another
+    /// thread in the meantime, the existing module is returned and the new one is released.
+    ModulePtr Add(const ContentHash& Key, VulkanUtilities::ShaderModuleWrapper&& Module);
+
+    ShaderModuleCacheStats GetStats() const;
+
+private:
+    using LRUListType = std::list<ContentHash>;
+
+    struct CacheEntry
+    {
+        ModulePtr             pModule;
+        LRUListType::iterator LRUPos;
+    };
+
+    const Uint32 m_MaxModules;
+
+    mutable std::mutex m_Mutex;
+
+    std::unordered_map<ContentHash, CacheEntry, ContentHash::Hasher> m_Cache;
+
+    // Most recently used modules are at the front
+    LRUListType m_LRUList;
+
+    Uint64 m_NumHits      = 0;
+    Uint64 m_NumMisses    = 0;
+    Uint64 m_NumEvictions = 0;
+};
+
+} // namespace Diligent
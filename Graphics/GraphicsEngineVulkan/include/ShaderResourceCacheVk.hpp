@@ -52,15 +52,21 @@
 //
 // Descriptor set for static and mutable resources is assigned during cache initialization
 // Descriptor set for dynamic resources is assigned at every draw call
+//
+// Binding static and mutable resources does not write descriptors immediately. Instead, the cache
+// is marked as having pending writes, and the whole set is written once when the cache is committed
+// (see PipelineResourceSignatureVkImpl::CommitStaticMutableResources).
 
 #include <vector>
 #include <memory>
+#include <atomic>
 
 #include "DescriptorPoolManager.hpp"
 #include "SPIRVShaderResources.hpp"
 #include "BufferVkImpl.hpp"
 #include "ShaderResourceCacheCommon.hpp"
 #include "PipelineResourceAttribsVk.hpp"
+#include "LockHelper.hpp"
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
 
 namespace Diligent
@@ -68,7 +74,7 @@ namespace Diligent
 
 class DeviceContextVkImpl;
 
-// sizeof(ShaderResourceCacheVk) == 24 (x64, msvc, Release)
+// sizeof(ShaderResourceCacheVk) == 32 (x64, msvc, Release)
 class ShaderResourceCacheVk : public ShaderResourceCacheBase
 {
 public:
@@ -202,9 +208,6 @@ public:
 
     struct SetResourceInfo
     {
-        const Uint32 BindingIndex = 0;
-        const Uint32 ArrayIndex   = 0;
-
         RefCntAutoPtr<IDeviceObject> pObject;
 
         const Uint64 BufferBaseOffset = 0;
@@ -214,14 +217,10 @@ public:
         {
         }
 
-        SetResourceInfo(Uint32                         _BindingIndex,
-                        Uint32                         _ArrayIndex,
-                        RefCntAutoPtr<IDeviceObject>&& _pObject,
+        SetResourceInfo(RefCntAutoPtr<IDeviceObject>&& _pObject,
                         Uint64                         _BufferBaseOffset = 0,
                         Uint64                         _BufferRangeSize  = 0) noexcept :
             // clang-format off
-            BindingIndex    {_BindingIndex      },
-            ArrayIndex      {_ArrayIndex        },
             pObject         {std::move(_pObject)},
             BufferBaseOffset{_BufferBaseOffset  },
             BufferRangeSize {_BufferRangeSize   }
@@ -229,16 +228,42 @@ public:
         {
         }
     };
-    // Sets the resource at the given descriptor set index and offset
-    const Resource& SetResource(const VulkanUtilities::VulkanLogicalDevice* pLogicalDevice,
-                                Uint32                                      DescrSetIndex,
-                                Uint32                                      CacheOffset,
-                                SetResourceInfo&&                           SrcRes);
+    // Sets the resource at the given descriptor set index and offset.
+    // If the set has a Vulkan descriptor set assigned, the descriptor write is deferred until
+    // the cache is committed.
+    const Resource& SetResource(Uint32            DescrSetIndex,
+                                Uint32            CacheOffset,
+                                SetResourceInfo&& SrcRes);
 
     const Resource& ResetResource(Uint32 SetIndex,
                                   Uint32 Offset)
     {
-        return SetResource(nullptr, SetIndex, Offset, {});
+        return SetResource(SetIndex, Offset, {});
+    }
+
+    // Returns true if resources have been bound to the descriptor set that has a Vulkan
+    // descriptor set assigned, but the descriptors have not yet been written.
+    bool HasPendingDescriptorWrites() const { return m_DescriptorWritesPending.load(); }
+
+    // Returns true if the descriptors need to be written either because new resources have been bound,
+    // or because Vulkan handles of some resources have been replaced by the memory defragmentation
+    // (see RenderDeviceVkImpl::GetResourceRelocationEpoch()).
+    bool NeedsDescriptorWrites(Uint32 RelocationEpoch) const
+    {
+        return m_DescriptorWritesPending.load() || m_RelocationEpoch.load() != RelocationEpoch;
+    }
+
+    // Locks the cache to write pending descriptors. Only one thread may write descriptors at a time.
+    ThreadingTools::LockHelper LockDescriptorWrites() { return ThreadingTools::LockHelper{m_DescriptorWritesLock}; }
+
+    // Must be called while the lock is held, before the descriptors are written. Resources bound while
+    // the descriptors are being written mark the cache again and are written by the next commit.
+    // Returns true if the descriptors need to be written.
+    bool ClearPendingDescriptorWrites(Uint32 RelocationEpoch)
+    {
+        const bool WritesPending = m_DescriptorWritesPending.exchange(false);
+        const auto PrevEpoch     = m_RelocationEpoch.exchange(RelocationEpoch);
+        return WritesPending || PrevEpoch != RelocationEpoch;
     }
 
     void SetDynamicBufferOffset(Uint32 DescrSetIndex,
@@ -290,6 +315,14 @@ private:
     // Indicates what types of resources are stored in the cache
     const Uint32 m_ContentType : 1;
 
+    // Indicates that descriptors of the static/mutable set need to be written
+    std::atomic<bool> m_DescriptorWritesPending{false};
+
+    // Resource relocation epoch at which the descriptors were last written
+    std::atomic<Uint32> m_RelocationEpoch{0};
+
+    ThreadingTools::LockFlag m_DescriptorWritesLock;
+
 #ifdef DILIGENT_DEBUG
     // Debug array that stores flags indicating if resources in the cache have been initialized
     std::vector<std::vector<bool>> m_DbgInitializedResources;
@@ -33,6 +33,7 @@
 #include "EngineVkImplTraits.hpp"
 #include "ShaderBase.hpp"
 #include "SPIRVShaderResources.hpp"
+#include "HashUtils.hpp"
 
 namespace Diligent
 {
@@ -51,7 +52,8 @@ public:
     /// Implementation of IShader::GetResourceCount() in Vulkan backend.
     virtual Uint32 DILIGENT_CALL_TYPE GetResourceCount() const override final
     {
-        return m_pShaderResources->GetTotalResources();
+        WaitForAsyncCompileTask();
+        return m_pShaderResources ? m_pShaderResources->GetTotalResources() : 0;
     }
 
     /// Implementation of IShader::GetResource() in Vulkan backend.
@@ -60,20 +62,36 @@ public:
     /// Implementation of IShaderVk::GetSPIRV().
     virtual const std::vector<uint32_t>& DILIGENT_CALL_TYPE GetSPIRV() const override final
     {
+        WaitForAsyncCompileTask();
         return m_SPIRV;
     }
 
+    /// Implementation of IShaderVk::GetReflectionData().
+    virtual void DILIGENT_CALL_TYPE GetReflectionData(IDataBlob** ppReflectionData) const override final;
+
+    // The methods below must only be called after the shader is ready (see ShaderBase::IsReady())
+
     const std::shared_ptr<const SPIRVShaderResources>& GetShaderResources() const { return m_pShaderResources; }
 
     const char* GetEntryPoint() const { return m_EntryPoint.c_str(); }
 
+    /// Content hash of the byte code, used to identify the shader in the pipeline state cache.
+    const ContentHash& GetSPIRVHash() const { return m_SPIRVHash; }
+
 private:
+    // Compiles or loads the byte code and reflects the shader resources. If the shader is compiled
+    // asynchronously, this method is executed by the pipeline compilation thread pool.
+    void Initialize(const ShaderCreateInfo& ShaderCI) noexcept(false);
+
+    void CompileShader(const ShaderCreateInfo& ShaderCI, SHADER_COMPILER ShaderCompiler) noexcept(false);
+
     void MapHLSLVertexShaderInputs();
 
     std::shared_ptr<const SPIRVShaderResources> m_pShaderResources;
 
     std::string           m_EntryPoint;
     std::vector<uint32_t> m_SPIRV;
+    ContentHash           m_SPIRVHash;
 };
 
 } // namespace Diligent
@@ -56,6 +56,9 @@ public:
     /// Implementation of ITextureViewVk::GetVulkanImageView().
     virtual VkImageView DILIGENT_CALL_TYPE GetVulkanImageView() const override final { return m_ImageView; }
 
+    // Replaces the image view after the texture has been relocated, see TextureVkImpl::Relocate().
+    void SetImageView(VulkanUtilities::ImageViewWrapper&& ImgView);
+
 protected:
     /// Vulkan image view descriptor handle
     VulkanUtilities::ImageViewWrapper m_ImageView;
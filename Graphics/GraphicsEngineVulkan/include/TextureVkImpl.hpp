@@ -30,6 +30,9 @@
 /// \file
 /// Declaration of Diligent::TextureVkImpl class
 
+#include <mutex>
+#include <vector>
+
 #include "EngineVkImplTraits.hpp"
 #include "TextureBase.hpp"
 #include "TextureViewVkImpl.hpp"
@@ -98,6 +101,32 @@ public:
     // ("Copying Data Between Buffers and Images")
     static constexpr Uint32 StagingBufferOffsetAlignment = 16; // max texel size - 16 bytes (RGBA32F), max texel block size - 16 bytes.
 
+    // Returns true if the texture can be moved to another memory page by the defragmentation pass,
+    // see DeviceContextVkImpl::DefragmentMemory().
+    bool IsRelocatable() const { return m_IsRelocatable; }
+
+    // Returns true if the texture memory is in a page that is being evacuated.
+    bool IsBeingEvacuated() const;
+
+    struct RelocationTarget
+    {
+        VulkanUtilities::ImageWrapper           vkImage;
+        VulkanUtilities::VulkanMemoryAllocation MemoryAllocation;
+    };
+
+    // Creates a new Vulkan image and binds it to the memory in another page.
+    // Returns false if the memory can't be allocated.
+    bool CreateRelocationTarget(RelocationTarget& Target);
+
+    // Replaces the Vulkan image and its memory with the ones from Target, releases the old ones
+    // and recreates image views of all texture views. The caller is responsible for copying
+    // the texture contents.
+    void Relocate(RelocationTarget&& Target);
+
+    // Non-default views of relocatable textures are tracked so that their image views
+    // can be recreated when the texture is relocated.
+    void OnDestroyView(TextureViewVkImpl* pView);
+
 protected:
     void CreateViewInternal(const struct TextureViewDesc& ViewDesc, ITextureView** ppView, bool bIsDefaultView) override;
     //void PrepareVkInitData(const TextureData &InitData, Uint32 NumSubresources, std::vector<Vk_SUBRESOURCE_DATA> &VkInitData);
@@ -116,6 +145,11 @@ protected:
     VulkanUtilities::BufferWrapper          m_StagingBuffer;
     VulkanUtilities::VulkanMemoryAllocation m_MemoryAllocation;
     VkDeviceSize                            m_StagingDataAlignedOffset;
+
+    bool m_IsRelocatable = false;
+
+    std::mutex                      m_ViewsMtx;
+    std::vector<TextureViewVkImpl*> m_Views;
 };
 
 VkImageCreateInfo TextureDescToVkImageCreateInfo(const TextureDesc& Desc, const RenderDeviceVkImpl* pDevice) noexcept;
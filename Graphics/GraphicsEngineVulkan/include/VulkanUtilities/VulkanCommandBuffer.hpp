@@ -120,6 +120,35 @@ public:
         vkCmdDrawIndexed(m_VkCmdBuffer, IndexCount, InstanceCount, FirstIndex, VertexOffset, FirstInstance);
     }
 
+#ifdef VK_EXT_multi_draw
+    __forceinline void DrawMulti(uint32_t DrawCount, const VkMultiDrawInfoEXT* pVertexInfo, uint32_t InstanceCount, uint32_t FirstInstance)
+    {
+#    if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawMultiEXT() must be called inside render pass");
+        VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
+
+        vkCmdDrawMultiEXT(m_VkCmdBuffer, DrawCount, pVertexInfo, InstanceCount, FirstInstance, sizeof(VkMultiDrawInfoEXT));
+#    else
+        UNSUPPORTED("DrawMulti is not supported when vulkan library is linked statically");
+#    endif
+    }
+
+    __forceinline void DrawMultiIndexed(uint32_t DrawCount, const VkMultiDrawIndexedInfoEXT* pIndexInfo, uint32_t InstanceCount, uint32_t FirstInstance)
+    {
+#    if DILIGENT_USE_VOLK
+        VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
+        VERIFY(m_State.RenderPass != VK_NULL_HANDLE, "vkCmdDrawMultiIndexedEXT() must be called inside render pass");
+        VERIFY(m_State.GraphicsPipeline != VK_NULL_HANDLE, "No graphics pipeline bound");
+        VERIFY(m_State.IndexBuffer != VK_NULL_HANDLE, "No index buffer bound");
+
+        vkCmdDrawMultiIndexedEXT(m_VkCmdBuffer, DrawCount, pIndexInfo, InstanceCount, FirstInstance, sizeof(VkMultiDrawIndexedInfoEXT), nullptr);
+#    else
+        UNSUPPORTED("DrawMultiIndexed is not supported when vulkan library is linked statically");
+#    endif
+    }
+#endif
+
     __forceinline void DrawIndirect(VkBuffer Buffer, VkDeviceSize Offset, uint32_t DrawCount, uint32_t Stride)
     {
         VERIFY_EXPR(m_VkCmdBuffer != VK_NULL_HANDLE);
@@ -769,6 +798,24 @@ public:
 
     const StateCache& GetState() const { return m_State; }
 
+    struct BarrierStatistics
+    {
+        // The number of vkCmdPipelineBarrier commands
+        uint32_t PipelineBarrierCount = 0;
+        // The number of image memory barriers passed to vkCmdPipelineBarrier
+        uint32_t ImageBarrierCount = 0;
+        // The number of global memory barriers passed to vkCmdPipelineBarrier
+        uint32_t MemoryBarrierCount = 0;
+        // The number of transitions that were combined with other pending barriers
+        uint32_t MergedBarrierCount = 0;
+        // The number of transitions that were dropped because they require no synchronization
+        uint32_t ElidedBarrierCount = 0;
+    };
+
+    // Barrier statistics are accumulated across command buffers and are not affected by Reset()
+    const BarrierStatistics& GetBarrierStatistics() const { return m_BarrierStats; }
+    void                     ResetBarrierStatistics() { m_BarrierStats = {}; }
+
 private:
     struct PipelineBarrier
     {
@@ -789,6 +836,8 @@ private:
     PipelineBarrier m_Barrier;
 
     std::vector<VkImageMemoryBarrier> m_ImageBarriers;
+
+    BarrierStatistics m_BarrierStats;
 };
 
 } // namespace VulkanUtilities
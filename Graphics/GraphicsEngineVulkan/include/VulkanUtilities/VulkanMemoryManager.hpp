@@ -29,15 +29,15 @@
 
 #include <mutex>
 #include <array>
-#include <unordered_map>
 #include <atomic>
+#include <memory>
 #include <string>
+#include <vector>
 #include "MemoryAllocator.h"
 #include "VariableSizeAllocationsManager.hpp"
 #include "VulkanUtilities/VulkanPhysicalDevice.hpp"
 #include "VulkanUtilities/VulkanLogicalDevice.hpp"
 #include "VulkanUtilities/VulkanObjectWrappers.hpp"
-#include "HashUtils.hpp"
 
 namespace VulkanUtilities
 {
@@ -105,9 +105,14 @@ public:
     // clang-format off
     VulkanMemoryPage(VulkanMemoryPage&& rhs)noexcept :
         m_ParentMemoryMgr {rhs.m_ParentMemoryMgr         },
+        m_MemoryTypeIndex {rhs.m_MemoryTypeIndex         },
+        m_AllocateFlags   {rhs.m_AllocateFlags           },
         m_AllocationMgr   {std::move(rhs.m_AllocationMgr)},
         m_VkMemory        {std::move(rhs.m_VkMemory)     },
-        m_CPUMemory       {rhs.m_CPUMemory               }
+        m_CPUMemory       {rhs.m_CPUMemory               },
+        m_MaxFreeBlockSize{rhs.m_MaxFreeBlockSize.load() },
+        m_IsEvacuating    {rhs.m_IsEvacuating.load()     },
+        m_ReleaseWhenEmpty{rhs.m_ReleaseWhenEmpty.load() }
     {
         rhs.m_CPUMemory = nullptr;
     }
@@ -121,8 +126,25 @@ public:
     VkDeviceSize GetPageSize() const { return m_AllocationMgr.GetMaxSize();  }
     VkDeviceSize GetUsedSize() const { return m_AllocationMgr.GetUsedSize(); }
 
+    uint32_t              GetMemoryTypeIndex() const { return m_MemoryTypeIndex; }
+    VkMemoryAllocateFlags GetAllocateFlags()   const { return m_AllocateFlags;   }
+
+    // Returns true if the page is being emptied by the defragmentation pass,
+    // see VulkanMemoryManager::BeginDefragmentation().
+    bool IsEvacuating() const { return m_IsEvacuating.load(); }
+
+    // Returns true if the page has been evacuated by the defragmentation pass and will be
+    // destroyed by VulkanMemoryManager::ShrinkMemory() as soon as it becomes empty,
+    // regardless of the reserve size. The flag is cleared when the page is allocated from.
+    bool IsReleasedWhenEmpty() const { return m_ReleaseWhenEmpty.load(); }
+
+    // Size of the largest free block, which can be checked without locking the page.
+    // The value may be out of date by the time it is used, so allocation may still fail.
+    VkDeviceSize GetMaxFreeBlockSizeHint() const { return m_MaxFreeBlockSize.load(); }
     // clang-format on
 
+    void GetFreeBlockStats(size_t& NumFreeBlocks, VkDeviceSize& MaxFreeBlockSize);
+
     VulkanMemoryAllocation Allocate(VkDeviceSize size, VkDeviceSize alignment);
 
     VkDeviceMemory GetVkMemory() const { return m_VkMemory; }
@@ -136,11 +158,24 @@ private:
     // Memory is reclaimed immediately. The application is responsible to ensure it is not in use by the GPU
     void Free(VulkanMemoryAllocation&& Allocation);
 
+    friend class VulkanMemoryManager;
+
     VulkanMemoryManager&                     m_ParentMemoryMgr;
+    const uint32_t                           m_MemoryTypeIndex;
+    const VkMemoryAllocateFlags              m_AllocateFlags;
     std::mutex                               m_Mutex;
     Diligent::VariableSizeAllocationsManager m_AllocationMgr;
     VulkanUtilities::DeviceMemoryWrapper     m_VkMemory;
     void*                                    m_CPUMemory = nullptr;
+
+    // Updated while m_Mutex is locked
+    std::atomic<VkDeviceSize> m_MaxFreeBlockSize{0};
+
+    // Modified by the parent manager while m_PagesMtx is locked
+    std::atomic<bool> m_IsEvacuating{false};
+
+    // Set by the parent manager while m_PagesMtx is locked, cleared by Allocate()
+    std::atomic<bool> m_ReleaseWhenEmpty{false};
 };
 
 class VulkanMemoryManager
@@ -159,6 +194,7 @@ public:
         m_LogicalDevice         {LogicalDevice         },
         m_PhysicalDevice        {PhysicalDevice        },
         m_Allocator             {Allocator             },
+        m_Shards                {GetNumShards()        },
         m_DeviceLocalPageSize   {DeviceLocalPageSize   },
         m_HostVisiblePageSize   {HostVisiblePageSize   },
         m_DeviceLocalReserveSize{DeviceLocalReserveSize},
@@ -174,21 +210,27 @@ public:
         m_LogicalDevice   {rhs.m_LogicalDevice     },
         m_PhysicalDevice  {rhs.m_PhysicalDevice    },
         m_Allocator       {rhs.m_Allocator         },
-        m_Pages           {std::move(rhs.m_Pages)  },
+        m_Shards          {std::move(rhs.m_Shards) },
 
         m_DeviceLocalPageSize    {rhs.m_DeviceLocalPageSize   },
         m_HostVisiblePageSize    {rhs.m_HostVisiblePageSize   },
         m_DeviceLocalReserveSize {rhs.m_DeviceLocalReserveSize},
         m_HostVisibleReserveSize {rhs.m_HostVisibleReserveSize},
 
-        //m_CurrUsedSize      {rhs.m_CurrUsedSize},
-        m_PeakUsedSize      {rhs.m_PeakUsedSize     },
-        m_CurrAllocatedSize {rhs.m_CurrAllocatedSize},
-        m_PeakAllocatedSize {rhs.m_PeakAllocatedSize}
+        m_Defrag           {rhs.m_Defrag           },
+        m_HasPagesToRelease{rhs.m_HasPagesToRelease}
     {
         // clang-format on
+        for (size_t i = 0; i < m_MemoryTypePages.size(); ++i)
+            m_MemoryTypePages[i].Pages = std::move(rhs.m_MemoryTypePages[i].Pages);
+
         for (size_t i = 0; i < m_CurrUsedSize.size(); ++i)
+        {
             m_CurrUsedSize[i].store(rhs.m_CurrUsedSize[i].load());
+            m_PeakUsedSize[i].store(rhs.m_PeakUsedSize[i].load());
+            m_CurrAllocatedSize[i].store(rhs.m_CurrAllocatedSize[i].load());
+            m_PeakAllocatedSize[i].store(rhs.m_PeakAllocatedSize[i].load());
+        }
     }
 
     ~VulkanMemoryManager();
@@ -201,7 +243,78 @@ public:
 
     VulkanMemoryAllocation Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags);
     VulkanMemoryAllocation Allocate(const VkMemoryRequirements& MemReqs, VkMemoryPropertyFlags MemoryProps, VkMemoryAllocateFlags AllocateFlags);
-    void                   ShrinkMemory();
+
+    // Destroys empty pages while the allocated size exceeds the reserve size,
+    // as well as empty pages that have been evacuated by the defragmentation pass.
+    void ShrinkMemory();
+
+    struct MemoryTypeStats
+    {
+        uint32_t MemoryTypeIndex = 0;
+        bool     IsHostVisible   = false;
+
+        uint32_t NumPages      = 0;
+        uint32_t NumEmptyPages = 0;
+
+        VkDeviceSize AllocatedSize    = 0;
+        VkDeviceSize UsedSize         = 0;
+        VkDeviceSize MaxFreeBlockSize = 0;
+        size_t       NumFreeBlocks    = 0;
+
+        // Share of the free memory that is not in the largest free block:
+        // 0 when all free memory is contiguous, close to 1 when it is scattered
+        // across many small blocks and pages.
+        float Fragmentation = 0;
+    };
+    // Returns page occupancy and fragmentation statistics for every memory type
+    // that has at least one page.
+    std::vector<MemoryTypeStats> GetMemoryTypeStats();
+
+    struct DefragmentationInfo
+    {
+        // Only pages whose used size does not exceed this fraction of the page size
+        // are considered for evacuation.
+        float MaxPageOccupancy = 0.5f;
+    };
+
+    struct DefragmentationStats
+    {
+        uint32_t     NumEvacuatedPages = 0;
+        VkDeviceSize BytesToMove       = 0;
+        VkDeviceSize BytesMoved        = 0;
+    };
+
+    // Defragmentation is driven by the owners of the allocations (see DeviceContextVkImpl::DefragmentMemory()):
+    //
+    //  - BeginDefragmentation() selects sparsely occupied pages whose contents fit into the free
+    //    space of the other pages of the same memory type and marks them as evacuating.
+    //    New allocations never go to evacuating pages.
+    //  - The evacuation is spread over several frames. Every frame, BeginDefragmentationFrame() sets
+    //    the number of bytes that may be moved in this frame (0 means no limit). Then for every resource
+    //    whose allocation IsBeingEvacuated(), the owner requests new memory with AllocateForRelocation(),
+    //    creates a new Vulkan object bound to it, records a GPU copy and releases the old allocation
+    //    through the device release queue. AllocateForRelocation() returns an empty allocation once
+    //    the frame budget is exhausted, and IsFrameBudgetExhausted() then returns true.
+    //  - When a frame ends without exhausting the budget, all resources that could be moved have been
+    //    moved. EndDefragmentation() clears the evacuation flags and marks the evacuated pages to be
+    //    released when empty. They are destroyed by ShrinkMemory() regardless of the reserve size once
+    //    the old allocations have gone through the release queue.
+    DefragmentationStats BeginDefragmentation(const DefragmentationInfo& Info);
+    void                 BeginDefragmentationFrame(VkDeviceSize MaxBytesPerFrame);
+    DefragmentationStats EndDefragmentation();
+
+    bool                 IsDefragmenting();
+    bool                 IsFrameBudgetExhausted();
+    DefragmentationStats GetDefragmentationStats();
+
+    bool IsBeingEvacuated(const VulkanMemoryAllocation& Allocation) const
+    {
+        return Allocation.Page != nullptr && Allocation.Page->IsEvacuating();
+    }
+
+    // Allocates memory for the contents of the Allocation that is being evacuated.
+    // Only pages of the same memory type that are not being evacuated are used; new pages are never created.
+    VulkanMemoryAllocation AllocateForRelocation(const VulkanMemoryAllocation& Allocation, VkDeviceSize Size, VkDeviceSize Alignment);
 
 protected:
     friend class VulkanMemoryPage;
@@ -216,7 +329,9 @@ protected:
 
     Diligent::IMemoryAllocator& m_Allocator;
 
+    // Protects the defragmentation state and the evacuation flags of the pages
     std::mutex m_PagesMtx;
+
     struct MemoryPageIndex
     {
         const uint32_t              MemoryTypeIndex;
@@ -231,37 +346,97 @@ protected:
             AllocateFlags  {_AllocateFlags},
             IsHostVisible  {_IsHostVisible}
         {}
-
-        bool operator == (const MemoryPageIndex& rhs)const
-        {
-            return MemoryTypeIndex == rhs.MemoryTypeIndex &&
-                   AllocateFlags   == rhs.AllocateFlags   &&
-                   IsHostVisible   == rhs.IsHostVisible;
-        }
         // clang-format on
+    };
+
+    // Pages of one memory type. Host-visible and device-local pages are kept in separate lists
+    // even if they use the same memory type (see Allocate()). Pages with different allocate
+    // flags share the list. Allocations of different memory types only contend for the page
+    // list lock of their own type.
+    struct MemoryTypePages
+    {
+        std::mutex Mtx;
 
-        struct Hasher
+        struct PageInfo
         {
-            size_t operator()(const MemoryPageIndex& PageIndex) const
-            {
-                return Diligent::ComputeHash(PageIndex.MemoryTypeIndex, PageIndex.AllocateFlags, PageIndex.IsHostVisible);
-            }
+            std::unique_ptr<VulkanMemoryPage> pPage;
+
+            // The size of the largest free block of the page when the order was last restored
+            VkDeviceSize MaxFreeBlockSize = 0;
         };
+        // Sorted by the size of the largest free block in ascending order
+        std::vector<PageInfo> Pages;
+
+        // Allocations are released without locking the list, so the order may be out of date.
+        // Mtx must be locked.
+        void RestoreOrder();
     };
-    std::unordered_multimap<MemoryPageIndex, VulkanMemoryPage, MemoryPageIndex::Hasher> m_Pages;
+    std::array<MemoryTypePages, VK_MAX_MEMORY_TYPES * 2> m_MemoryTypePages;
+
+    MemoryTypePages& GetMemoryTypePages(uint32_t MemoryTypeIndex, bool IsHostVisible)
+    {
+        VERIFY_EXPR(MemoryTypeIndex < VK_MAX_MEMORY_TYPES);
+        return m_MemoryTypePages[size_t{MemoryTypeIndex} * 2 + (IsHostVisible ? 1 : 0)];
+    }
+
+    // Tries to allocate memory from the existing pages that are not being evacuated, starting
+    // with the page that has the smallest free block that is large enough.
+    // TypePages.Mtx must be locked.
+    VulkanMemoryAllocation AllocateFromExistingPages(MemoryTypePages& TypePages, VkMemoryAllocateFlags AllocateFlags, VkDeviceSize Size, VkDeviceSize Alignment);
+
+    // Every thread is assigned to one of the shards. A shard remembers the pages that recent allocations
+    // of the thread were served from, so that most allocations only lock the shard and the page mutexes.
+    // Lock order: m_PagesMtx -> MemoryTypePages::Mtx -> Shard::Mtx -> VulkanMemoryPage::m_Mutex.
+    static constexpr size_t CacheLineSize     = 64;
+    static constexpr size_t NumPreferredPages = 4;
+
+    struct ShardData
+    {
+        std::mutex Mtx;
+
+        std::array<VulkanMemoryPage*, NumPreferredPages> PreferredPages = {};
+    };
+    struct Shard : ShardData
+    {
+        Diligent::Uint8 Padding[CacheLineSize - sizeof(ShardData) % CacheLineSize];
+    };
+
+    static size_t GetNumShards();
+
+    Shard& GetThreadShard();
+
+    VulkanMemoryAllocation AllocateFromPreferredPages(Shard& ThreadShard, const MemoryPageIndex& PageIdx, VkDeviceSize Size, VkDeviceSize Alignment);
+    void                   SetPreferredPage(Shard& ThreadShard, VulkanMemoryPage& Page);
+    void                   ForgetPreferredPage(const VulkanMemoryPage& Page);
+
+    std::vector<Shard> m_Shards;
 
     const VkDeviceSize m_DeviceLocalPageSize;
     const VkDeviceSize m_HostVisiblePageSize;
     const VkDeviceSize m_DeviceLocalReserveSize;
     const VkDeviceSize m_HostVisibleReserveSize;
 
+    void OnNewAllocation(VkDeviceSize Size, bool IsHostVisible);
     void OnFreeAllocation(VkDeviceSize Size, bool IsHostVisible);
 
     // 0 == Device local, 1 == Host-visible
-    std::array<std::atomic<int64_t>, 2> m_CurrUsedSize      = {};
-    std::array<VkDeviceSize, 2>         m_PeakUsedSize      = {};
-    std::array<VkDeviceSize, 2>         m_CurrAllocatedSize = {};
-    std::array<VkDeviceSize, 2>         m_PeakAllocatedSize = {};
+    std::array<std::atomic<int64_t>, 2>      m_CurrUsedSize      = {};
+    std::array<std::atomic<VkDeviceSize>, 2> m_PeakUsedSize      = {};
+    std::array<std::atomic<VkDeviceSize>, 2> m_CurrAllocatedSize = {};
+    std::array<std::atomic<VkDeviceSize>, 2> m_PeakAllocatedSize = {};
+
+    // Protected by m_PagesMtx
+    struct DefragmentationState
+    {
+        bool                 IsActive             = false;
+        bool                 FrameBudgetExhausted = false;
+        VkDeviceSize         MaxBytesPerFrame     = 0;
+        VkDeviceSize         FrameBytesRemaining  = 0;
+        DefragmentationStats Stats;
+    } m_Defrag;
+
+    // Indicates that some pages may have m_ReleaseWhenEmpty flag set. Protected by m_PagesMtx.
+    bool m_HasPagesToRelease = false;
 
     // If adding new member, do not forget to update move ctor
 };
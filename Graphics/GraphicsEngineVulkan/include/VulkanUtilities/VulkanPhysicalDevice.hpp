@@ -58,6 +58,9 @@ public:
         VkPhysicalDeviceFragmentDensityMapFeaturesEXT     FragmentDensityMap     = {}; // Only for desktop devices
         VkPhysicalDeviceFragmentDensityMap2FeaturesEXT    FragmentDensityMap2    = {}; // Only for mobile devices
         VkPhysicalDeviceMultiviewFeaturesKHR              Multiview              = {}; // Required for RenderPass2
+#ifdef VK_EXT_multi_draw
+        VkPhysicalDeviceMultiDrawFeaturesEXT MultiDraw = {};
+#endif
 
         bool Spirv14              = false; // Ray tracing requires Vulkan 1.2 or SPIRV 1.4 extension
         bool Spirv15              = false; // DXC shaders with ray tracing requires Vulkan 1.2 with SPIRV 1.5
@@ -65,6 +68,7 @@ public:
         bool HasPortabilitySubset = false;
         bool RenderPass2          = false;
         bool DrawIndirectCount    = false;
+        bool DescrUpdateTemplate  = false;
     };
 
     struct ExtensionProperties
@@ -82,6 +86,9 @@ public:
         VkPhysicalDeviceMultiviewPropertiesKHR              Multiview              = {};
         VkPhysicalDeviceMaintenance3Properties              Maintenance3           = {};
         VkPhysicalDeviceFragmentDensityMap2PropertiesEXT    FragmentDensityMap2    = {};
+#ifdef VK_EXT_multi_draw
+        VkPhysicalDeviceMultiDrawPropertiesEXT MultiDraw = {};
+#endif
     };
 
 public:
@@ -39,6 +39,65 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 static const INTERFACE_ID IID_DeviceContextVk =
     {0x72aeb1ba, 0xc6ad, 0x42ec, {0x88, 0x11, 0x7e, 0xd9, 0xc7, 0x21, 0x76, 0xbb}};
 
+/// Pipeline barrier statistics of a Vulkan device context, see IDeviceContextVk::GetBarrierStatistics().
+struct BarrierStatisticsVk
+{
+    /// The number of vkCmdPipelineBarrier commands recorded by the context
+    Uint32 PipelineBarrierCount DEFAULT_INITIALIZER(0);
+
+    /// The total number of image memory barriers in all vkCmdPipelineBarrier commands
+    Uint32 ImageBarrierCount DEFAULT_INITIALIZER(0);
+
+    /// The total number of global memory barriers in all vkCmdPipelineBarrier commands.
+    /// All buffer state transitions are combined into a single global memory barrier.
+    Uint32 MemoryBarrierCount DEFAULT_INITIALIZER(0);
+
+    /// The number of state transitions that were combined with other pending barriers,
+    /// e.g. transitions of adjacent subresource ranges, or consecutive transitions
+    /// of the same subresources.
+    Uint32 MergedBarrierCount DEFAULT_INITIALIZER(0);
+
+    /// The number of state transitions that were dropped because they do not
+    /// require any synchronization, e.g. read-to-read transitions.
+    Uint32 ElidedBarrierCount DEFAULT_INITIALIZER(0);
+};
+typedef struct BarrierStatisticsVk BarrierStatisticsVk;
+
+/// Device memory defragmentation attributes, see IDeviceContextVk::DefragmentMemory().
+struct MemoryDefragmentationAttribsVk
+{
+    /// Only memory pages whose used size does not exceed this
+    /// fraction of the page size are evacuated. The pages are selected by
+    /// the call that starts the defragmentation; the calls that continue it
+    /// ignore this value.
+    Float32 MaxPageOccupancy DEFAULT_INITIALIZER(0.5f);
+
+    /// The maximum number of bytes to move by one call. 0 means no limit.
+    /// Resources that do not fit into the budget stay where they are and
+    /// are moved by the next call.
+    Uint64 MaxBytesToMove DEFAULT_INITIALIZER(0);
+};
+typedef struct MemoryDefragmentationAttribsVk MemoryDefragmentationAttribsVk;
+
+/// Device memory defragmentation statistics, see IDeviceContextVk::DefragmentMemory().
+struct MemoryDefragmentationStatsVk
+{
+    /// The number of memory pages that were selected for evacuation when the defragmentation started
+    Uint32 NumEvacuatedPages DEFAULT_INITIALIZER(0);
+
+    /// The number of buffers and textures that were moved to other pages by this call
+    Uint32 NumRelocatedResources DEFAULT_INITIALIZER(0);
+
+    /// The number of bytes that were moved by this call
+    Uint64 BytesMoved DEFAULT_INITIALIZER(0);
+
+    /// Whether the defragmentation has been completed. If this member is false, some resources
+    /// did not fit into the MaxBytesToMove budget, and the method should be called again,
+    /// typically in the next frame.
+    Bool IsComplete DEFAULT_INITIALIZER(False);
+};
+typedef struct MemoryDefragmentationStatsVk MemoryDefragmentationStatsVk;
+
 #define DILIGENT_INTERFACE_NAME IDeviceContextVk
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -84,6 +143,49 @@ DILIGENT_BEGIN_INTERFACE(IDeviceContextVk, IDeviceContext)
     ///           calling IDeviceContext::InvalidateState() and then manually restore all required states via
     ///           appropriate Diligent API calls.
     VIRTUAL VkCommandBuffer METHOD(GetVkCommandBuffer)(THIS) PURE;
+
+    /// Returns pipeline barrier statistics accumulated since the context was created
+    /// or since the last call to IDeviceContextVk::ResetBarrierStatistics().
+
+    /// \remarks  Barriers are recorded lazily and are flushed before the next command that
+    ///           requires them, so the statistics may not include pending barriers.
+    VIRTUAL BarrierStatisticsVk METHOD(GetBarrierStatistics)(THIS) CONST PURE;
+
+    /// Resets pipeline barrier statistics.
+    VIRTUAL void METHOD(ResetBarrierStatistics)(THIS) PURE;
+
+    /// Moves buffers and textures out of sparsely occupied device memory pages and releases the pages.
+
+    /// \param [in]  Attribs - Defragmentation attributes, see Diligent::MemoryDefragmentationAttribsVk.
+    /// \param [out] pStats  - Optional pointer to the structure that receives the defragmentation statistics.
+    ///
+    /// \remarks  The first call selects pages whose contents fit into the free space of the other pages of the
+    ///           same memory type. Every call then creates new Vulkan objects in the other pages for as many
+    ///           resources as fit into MemoryDefragmentationAttribsVk::MaxBytesToMove, copies the data on the GPU
+    ///           and replaces the Vulkan handles of the buffers, textures and their views. Descriptor sets of
+    ///           shader resource bindings that reference the moved resources are rewritten when the bindings
+    ///           are committed next time. To spread the copies over several frames, call the method once per
+    ///           frame until MemoryDefragmentationStatsVk::IsComplete is true. New resources are not placed
+    ///           into the pages that are being evacuated. The old Vulkan objects are released when the GPU is
+    ///           done with them, and the evacuated pages are released once they become empty.
+    ///
+    ///           Only the following resources are moved:
+    ///           - USAGE_DEFAULT and USAGE_IMMUTABLE buffers that are not formatted, are not used for ray tracing
+    ///             and are used by a single immediate context;
+    ///           - USAGE_DEFAULT and USAGE_IMMUTABLE non-depth textures that are not render targets, depth-stencil
+    ///             buffers, input attachments, shading rate or subsampled textures, and are used by a single
+    ///             immediate context;
+    ///           - Resources whose state is known to the engine.
+    ///
+    ///           If any resources have been moved, the method flushes the context (but does not wait for the GPU),
+    ///           so the application must set the pipeline state, commit shader resources and set other states
+    ///           again after the call. Native Vulkan handles of the moved resources previously obtained by the
+    ///           application become invalid. The method must only be called from the immediate context, outside
+    ///           of a render pass, while no other thread uses the resources, and when there are no recorded
+    ///           command lists that reference them and have not been executed.
+    VIRTUAL void METHOD(DefragmentMemory)(THIS_
+                                          const MemoryDefragmentationAttribsVk REF Attribs,
+                                          MemoryDefragmentationStatsVk*            pStats DEFAULT_VALUE(nullptr)) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -95,6 +197,9 @@ DILIGENT_END_INTERFACE
 
 #    define IDeviceContextVk_TransitionImageLayout(This, ...) CALL_IFACE_METHOD(DeviceContextVk, TransitionImageLayout, This, __VA_ARGS__)
 #    define IDeviceContextVk_BufferMemoryBarrier(This, ...)   CALL_IFACE_METHOD(DeviceContextVk, BufferMemoryBarrier,   This, __VA_ARGS__)
+#    define IDeviceContextVk_GetBarrierStatistics(This)       CALL_IFACE_METHOD(DeviceContextVk, GetBarrierStatistics,  This)
+#    define IDeviceContextVk_ResetBarrierStatistics(This)     CALL_IFACE_METHOD(DeviceContextVk, ResetBarrierStatistics, This)
+#    define IDeviceContextVk_DefragmentMemory(This, ...)      CALL_IFACE_METHOD(DeviceContextVk, DefragmentMemory,       This, __VA_ARGS__)
 
 // clang-format on
 
@@ -38,6 +38,40 @@ DILIGENT_BEGIN_NAMESPACE(Diligent)
 static const INTERFACE_ID IID_RenderDeviceVk =
     {0xab8cf3a6, 0xd959, 0x41c1, {0xae, 0x0, 0xa5, 0x8a, 0xe9, 0x82, 0xe, 0x6a}};
 
+/// Device memory statistics of a Vulkan memory type, see IRenderDeviceVk::GetMemoryStatistics().
+struct DeviceMemoryStatsVk
+{
+    /// Index of the memory type in VkPhysicalDeviceMemoryProperties::memoryTypes
+    Uint32 MemoryTypeIndex DEFAULT_INITIALIZER(0);
+
+    /// Whether the pages of this memory type are mapped to the CPU address space
+    Bool IsHostVisible DEFAULT_INITIALIZER(False);
+
+    /// The number of memory pages allocated from this memory type
+    Uint32 NumPages DEFAULT_INITIALIZER(0);
+
+    /// The number of pages that contain no allocations
+    Uint32 NumEmptyPages DEFAULT_INITIALIZER(0);
+
+    /// The total size of all pages, in bytes
+    Uint64 AllocatedSize DEFAULT_INITIALIZER(0);
+
+    /// The total size of all allocations in all pages, in bytes
+    Uint64 UsedSize DEFAULT_INITIALIZER(0);
+
+    /// The size of the largest free block in all pages, in bytes
+    Uint64 MaxFreeBlockSize DEFAULT_INITIALIZER(0);
+
+    /// The total number of free blocks in all pages
+    Uint64 NumFreeBlocks DEFAULT_INITIALIZER(0);
+
+    /// The share of the free memory that is not in the largest free block:
+    /// 0 when all free memory is contiguous, close to 1 when it is scattered
+    /// across many small blocks and pages.
+    Float32 Fragmentation DEFAULT_INITIALIZER(0);
+};
+typedef struct DeviceMemoryStatsVk DeviceMemoryStatsVk;
+
 #define DILIGENT_INTERFACE_NAME IRenderDeviceVk
 #include "../../../Primitives/interface/DefineInterfaceHelperMacros.h"
 
@@ -157,6 +191,22 @@ DILIGENT_BEGIN_INTERFACE(IRenderDeviceVk, IRenderDevice)
                                                        VkSemaphore         vkTimelineSemaphore,
                                                        const FenceDesc REF Desc,
                                                        IFence**            ppFence) PURE;
+
+    /// Returns the statistics of the device-level shader module cache, see Diligent::ShaderModuleCacheStats.
+    VIRTUAL ShaderModuleCacheStats METHOD(GetShaderModuleCacheStats)(THIS) CONST PURE;
+
+    /// Returns device memory statistics for every memory type that has at least one memory page.
+
+    /// \param [in, out] NumMemoryTypes - When pStats is null, receives the number of memory types.
+    ///                                   Otherwise, specifies the number of elements in pStats and
+    ///                                   receives the number of elements that were written.
+    /// \param [out]     pStats         - Pointer to the array of DeviceMemoryStatsVk structures, or null.
+    ///
+    /// \remarks  Use IDeviceContextVk::DefragmentMemory() to reduce fragmentation and release
+    ///           sparsely occupied pages.
+    VIRTUAL void METHOD(GetMemoryStatistics)(THIS_
+                                             Uint32 REF           NumMemoryTypes,
+                                             DeviceMemoryStatsVk* pStats) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -174,6 +224,8 @@ DILIGENT_END_INTERFACE
 #    define IRenderDeviceVk_CreateBLASFromVulkanResource(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, CreateBLASFromVulkanResource,   This, __VA_ARGS__)
 #    define IRenderDeviceVk_CreateTLASFromVulkanResource(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, CreateTLASFromVulkanResource,   This, __VA_ARGS__)
 #    define IRenderDeviceVk_CreateFenceFromVulkanResource(This, ...)  CALL_IFACE_METHOD(RenderDeviceVk, CreateFenceFromVulkanResource,  This, __VA_ARGS__)
+#    define IRenderDeviceVk_GetShaderModuleCacheStats(This)           CALL_IFACE_METHOD(RenderDeviceVk, GetShaderModuleCacheStats,      This)
+#    define IRenderDeviceVk_GetMemoryStatistics(This, ...)            CALL_IFACE_METHOD(RenderDeviceVk, GetMemoryStatistics,            This, __VA_ARGS__)
 
 // clang-format on
 
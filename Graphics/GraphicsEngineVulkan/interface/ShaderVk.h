@@ -55,6 +55,14 @@ class IShaderVk : public IShader
 public:
     /// Returns SPIRV bytecode
     virtual const std::vector<uint32_t>& DILIGENT_CALL_TYPE GetSPIRV() const = 0;
+
+    /// Serializes the shader resources reflected from the SPIRV bytecode.
+
+    /// \param [out] ppReflectionData - Address of the memory location where the pointer to the
+    ///                                 data blob will be written. The blob can be passed to
+    ///                                 ShaderCreateInfo::pReflectionData along with the bytecode
+    ///                                 returned by GetSPIRV() to skip the reflection.
+    virtual void DILIGENT_CALL_TYPE GetReflectionData(IDataBlob** ppReflectionData) const = 0;
 };
 
 #endif
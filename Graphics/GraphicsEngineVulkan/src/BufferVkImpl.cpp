@@ -237,6 +237,7 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
                "ImmediateContextMask must contain single set bit, this error should've been handled in ValidateBufferDesc()");
 
         m_VulkanBuffer = LogicalDevice.CreateBuffer(VkBuffCI, m_Desc.Name);
+        m_VkUsageFlags = VkBuffCI.usage;
 
         VkMemoryRequirements MemReqs = LogicalDevice.GetBufferMemoryRequirements(m_VulkanBuffer);
 
@@ -444,6 +445,16 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
         }
 
         SetState(InitialState);
+
+        // Formatted buffers are referenced by buffer views, and ray tracing buffers are referenced by
+        // device addresses, which can't be updated when the buffer is moved to another memory page.
+        // Buffers that use concurrent sharing mode are not moved to keep relocation in a single queue.
+        m_IsRelocatable =
+            (m_Desc.Usage == USAGE_DEFAULT || m_Desc.Usage == USAGE_IMMUTABLE) &&
+            m_Desc.Mode != BUFFER_MODE_FORMATTED &&
+            (m_Desc.BindFlags & BIND_RAY_TRACING) == 0 &&
+            m_Desc.CPUAccessFlags == CPU_ACCESS_NONE &&
+            VkBuffCI.sharingMode == VK_SHARING_MODE_EXCLUSIVE;
     }
 
     VERIFY_EXPR(IsInKnownState());
@@ -474,6 +485,9 @@ BufferVkImpl::BufferVkImpl(IReferenceCounters*        pRefCounters,
 
 BufferVkImpl::~BufferVkImpl()
 {
+    if (m_IsRelocatable)
+        m_pDevice->UnregisterRelocatableResource(this);
+
     // Vk object can only be destroyed when it is no longer used by the GPU
     if (m_VulkanBuffer != VK_NULL_HANDLE)
         m_pDevice->SafeReleaseDeviceObject(std::move(m_VulkanBuffer), m_Desc.ImmediateContextMask);
@@ -551,6 +565,59 @@ VkBuffer BufferVkImpl::GetVkBuffer() const
     }
 }
 
+bool BufferVkImpl::IsBeingEvacuated() const
+{
+    return m_IsRelocatable && m_pDevice->GetGlobalMemoryManager().IsBeingEvacuated(m_MemoryAllocation);
+}
+
+bool BufferVkImpl::CreateRelocationTarget(RelocationTarget& Target)
+{
+    VERIFY_EXPR(m_IsRelocatable);
+    const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
+
+    VkBufferCreateInfo VkBuffCI{};
+    VkBuffCI.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    VkBuffCI.pNext       = nullptr;
+    VkBuffCI.flags       = 0;
+    VkBuffCI.size        = m_Desc.Size;
+    VkBuffCI.usage       = m_VkUsageFlags;
+    VkBuffCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    auto vkBuffer = LogicalDevice.CreateBuffer(VkBuffCI, m_Desc.Name);
+
+    const auto MemReqs = LogicalDevice.GetBufferMemoryRequirements(vkBuffer);
+    VERIFY((MemReqs.memoryTypeBits & (1u << m_MemoryAllocation.Page->GetMemoryTypeIndex())) != 0,
+           "The memory type of the original allocation is not compatible with the new buffer");
+
+    auto Allocation = m_pDevice->GetGlobalMemoryManager().AllocateForRelocation(m_MemoryAllocation, MemReqs.size, MemReqs.alignment);
+    if (Allocation.Page == nullptr)
+        return false;
+
+    const auto AlignedOffset = AlignUp(VkDeviceSize{Allocation.UnalignedOffset}, MemReqs.alignment);
+    VERIFY_EXPR(Allocation.Size >= MemReqs.size + (AlignedOffset - Allocation.UnalignedOffset));
+
+    auto err = LogicalDevice.BindBufferMemory(vkBuffer, Allocation.Page->GetVkMemory(), AlignedOffset);
+    CHECK_VK_ERROR_AND_THROW(err, "Failed to bind buffer memory");
+
+    Target.vkBuffer            = std::move(vkBuffer);
+    Target.MemoryAllocation    = std::move(Allocation);
+    Target.MemoryAlignedOffset = AlignedOffset;
+    return true;
+}
+
+void BufferVkImpl::Relocate(RelocationTarget&& Target)
+{
+    VERIFY_EXPR(Target.vkBuffer != VK_NULL_HANDLE && Target.MemoryAllocation.Page != nullptr);
+
+    // The old buffer may still be used by the GPU
+    m_pDevice->SafeReleaseDeviceObject(std::move(m_VulkanBuffer), m_Desc.ImmediateContextMask);
+    m_pDevice->SafeReleaseDeviceObject(std::move(m_MemoryAllocation), m_Desc.ImmediateContextMask);
+
+    m_VulkanBuffer              = std::move(Target.vkBuffer);
+    m_MemoryAllocation          = std::move(Target.MemoryAllocation);
+    m_BufferMemoryAlignedOffset = Target.MemoryAlignedOffset;
+}
+
 void BufferVkImpl::SetAccessFlags(VkAccessFlags AccessFlags)
 {
     SetState(VkAccessFlagsToResourceStates(AccessFlags));
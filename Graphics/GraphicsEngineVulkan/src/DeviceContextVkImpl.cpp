@@ -306,7 +306,11 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
     TDeviceContextBase::SetPipelineState(pPipelineStateVk, 0 /*Dummy*/);
     EnsureVkCmdBuffer();
 
-    auto vkPipeline = pPipelineStateVk->GetVkPipeline();
+    // If the PSO is being compiled asynchronously, the pipeline will be bound
+    // by the first draw or dispatch command after the compilation completes.
+    const auto IsReady          = pPipelineStateVk->IsReady();
+    const auto vkPipeline       = IsReady ? pPipelineStateVk->GetVkPipeline() : VK_NULL_HANDLE;
+    m_State.PipelineBindPending = !IsReady;
 
     static_assert(PIPELINE_TYPE_LAST == 4, "Please update the switch below to handle the new pipeline type");
     switch (PSODesc.PipelineType)
@@ -315,7 +319,8 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
         case PIPELINE_TYPE_MESH:
         {
             auto& GraphicsPipeline = pPipelineStateVk->GetGraphicsPipelineDesc();
-            m_CommandBuffer.BindGraphicsPipeline(vkPipeline);
+            if (IsReady)
+                m_CommandBuffer.BindGraphicsPipeline(vkPipeline);
 
             if (CommitStates)
             {
@@ -333,13 +338,15 @@ void DeviceContextVkImpl::SetPipelineState(IPipelineState* pPipelineState)
         }
         case PIPELINE_TYPE_COMPUTE:
         {
-            m_CommandBuffer.BindComputePipeline(vkPipeline);
+            if (IsReady)
+                m_CommandBuffer.BindComputePipeline(vkPipeline);
             m_State.vkPipelineBindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
             break;
         }
         case PIPELINE_TYPE_RAY_TRACING:
         {
-            m_CommandBuffer.BindRayTracingPipeline(vkPipeline);
+            if (IsReady)
+                m_CommandBuffer.BindRayTracingPipeline(vkPipeline);
             m_State.vkPipelineBindPoint = VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR;
             break;
         }
@@ -542,6 +549,12 @@ void DeviceContextVkImpl::CommitShaderResources(IShaderResourceBinding* pShaderR
     if (pSignature->HasDescriptorSet(PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_STATIC_MUTABLE))
     {
         VERIFY_EXPR(DSIndex == pSignature->GetDescriptorSetIndex<PipelineResourceSignatureVkImpl::DESCRIPTOR_SET_ID_STATIC_MUTABLE>());
+        // Write static and mutable resources that have been bound since the last commit or relocated
+        // by the memory defragmentation
+        const auto RelocationEpoch = m_pDevice->GetResourceRelocationEpoch();
+        if (ResourceCache.NeedsDescriptorWrites(RelocationEpoch))
+            pSignature->CommitStaticMutableResources(ResourceCache, RelocationEpoch);
+
         const auto& CachedDescrSet = const_cast<const ShaderResourceCacheVk&>(ResourceCache).GetDescriptorSet(DSIndex);
         VERIFY_EXPR(CachedDescrSet.GetVkDescriptorSet() != VK_NULL_HANDLE);
         SetInfo.vkSets[DSIndex] = CachedDescrSet.GetVkDescriptorSet();
@@ -692,7 +705,44 @@ void DeviceContextVkImpl::DvpLogRenderPass_PSOMismatch()
     LOG_ERROR_MESSAGE(ss.str());
 }
 
-void DeviceContextVkImpl::PrepareForDraw(DRAW_FLAGS Flags)
+bool DeviceContextVkImpl::BindPendingPipeline()
+{
+    VERIFY_EXPR(m_State.PipelineBindPending && m_pPipelineState);
+    const auto Status = m_pPipelineState->GetStatus(false);
+    if (Status != PIPELINE_STATE_STATUS_READY)
+    {
+        if (Status == PIPELINE_STATE_STATUS_FAILED && m_pPipelineState->MarkFailureReported())
+        {
+            LOG_ERROR_MESSAGE("Asynchronous compilation of pipeline state '", m_pPipelineState->GetDesc().Name,
+                              "' has failed. All draw, dispatch and trace rays commands that use this pipeline will be skipped.");
+        }
+        return false;
+    }
+
+    const auto vkPipeline = m_pPipelineState->GetVkPipeline();
+    switch (m_State.vkPipelineBindPoint)
+    {
+        case VK_PIPELINE_BIND_POINT_GRAPHICS:
+            m_CommandBuffer.BindGraphicsPipeline(vkPipeline);
+            break;
+
+        case VK_PIPELINE_BIND_POINT_COMPUTE:
+            m_CommandBuffer.BindComputePipeline(vkPipeline);
+            break;
+
+        case VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR:
+            m_CommandBuffer.BindRayTracingPipeline(vkPipeline);
+            break;
+
+        default:
+            UNEXPECTED("Unexpected pipeline bind point");
+    }
+    m_State.PipelineBindPending = false;
+
+    return true;
+}
+
+bool DeviceContextVkImpl::PrepareForDraw(DRAW_FLAGS Flags)
 {
 #ifdef DILIGENT_DEVELOPMENT
     if ((Flags & DRAW_FLAG_VERIFY_RENDER_TARGETS) != 0)
@@ -704,6 +754,9 @@ void DeviceContextVkImpl::PrepareForDraw(DRAW_FLAGS Flags)
 
     EnsureVkCmdBuffer();
 
+    if (m_State.PipelineBindPending && !BindPendingPipeline())
+        return false;
+
     if (!m_State.CommittedVBsUpToDate && m_pPipelineState->GetNumBufferSlotsUsed() > 0)
     {
         CommitVkVertexBuffers();
@@ -748,6 +801,8 @@ void DeviceContextVkImpl::PrepareForDraw(DRAW_FLAGS Flags)
 
         CommitRenderPassAndFramebuffer((Flags & DRAW_FLAG_VERIFY_STATES) != 0);
     }
+
+    return true;
 }
 
 BufferVkImpl* DeviceContextVkImpl::PrepareIndirectAttribsBuffer(IBuffer*                       pAttribsBuffer,
@@ -768,9 +823,10 @@ BufferVkImpl* DeviceContextVkImpl::PrepareIndirectAttribsBuffer(IBuffer*
     return pIndirectDrawAttribsVk;
 }
 
-void DeviceContextVkImpl::PrepareForIndexedDraw(DRAW_FLAGS Flags, VALUE_TYPE IndexType)
+bool DeviceContextVkImpl::PrepareForIndexedDraw(DRAW_FLAGS Flags, VALUE_TYPE IndexType)
 {
-    PrepareForDraw(Flags);
+    if (!PrepareForDraw(Flags))
+        return false;
 
 #ifdef DILIGENT_DEVELOPMENT
     if ((Flags & DRAW_FLAG_VERIFY_STATES) != 0)
@@ -781,13 +837,16 @@ void DeviceContextVkImpl::PrepareForIndexedDraw(DRAW_FLAGS Flags, VALUE_TYPE Ind
     DEV_CHECK_ERR(IndexType == VT_UINT16 || IndexType == VT_UINT32, "Unsupported index format. Only R16_UINT and R32_UINT are allowed.");
     VkIndexType vkIndexType = TypeToVkIndexType(IndexType);
     m_CommandBuffer.BindIndexBuffer(m_pIndexBuffer->GetVkBuffer(), m_IndexDataStartOffset + m_pIndexBuffer->GetDynamicOffset(GetContextId(), this), vkIndexType);
+
+    return true;
 }
 
 void DeviceContextVkImpl::Draw(const DrawAttribs& Attribs)
 {
     DvpVerifyDrawArguments(Attribs);
 
-    PrepareForDraw(Attribs.Flags);
+    if (!PrepareForDraw(Attribs.Flags))
+        return;
 
     if (Attribs.NumVertices > 0 && Attribs.NumInstances > 0)
     {
@@ -800,7 +859,8 @@ void DeviceContextVkImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 {
     DvpVerifyDrawIndexedArguments(Attribs);
 
-    PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
+    if (!PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType))
+        return;
 
     if (Attribs.NumIndices > 0 && Attribs.NumInstances > 0)
     {
@@ -809,6 +869,93 @@ void DeviceContextVkImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
     }
 }
 
+void DeviceContextVkImpl::MultiDraw(const MultiDrawAttribs& Attribs)
+{
+    DvpVerifyMultiDrawArguments(Attribs);
+
+    if (!PrepareForDraw(Attribs.Flags))
+        return;
+
+    if (Attribs.NumDrawItems == 0 || Attribs.NumInstances == 0)
+        return;
+
+#ifdef VK_EXT_multi_draw
+    if ((m_pDevice->GetAdapterInfo().DrawCommand.CapFlags & DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW) != 0)
+    {
+        m_MultiDrawInfo.resize(Attribs.NumDrawItems);
+        for (Uint32 i = 0; i < Attribs.NumDrawItems; ++i)
+        {
+            m_MultiDrawInfo[i].firstVertex = Attribs.pDrawItems[i].StartVertexLocation;
+            m_MultiDrawInfo[i].vertexCount = Attribs.pDrawItems[i].NumVertices;
+        }
+
+        const auto MaxDrawCount = m_pDevice->GetPhysicalDevice().GetExtProperties().MultiDraw.maxMultiDrawCount;
+        for (Uint32 FirstItem = 0; FirstItem < Attribs.NumDrawItems; FirstItem += MaxDrawCount)
+        {
+            const auto DrawCount = std::min(Attribs.NumDrawItems - FirstItem, MaxDrawCount);
+            m_CommandBuffer.DrawMulti(DrawCount, &m_MultiDrawInfo[FirstItem], Attribs.NumInstances, Attribs.FirstInstanceLocation);
+            ++m_State.NumCommands;
+        }
+        return;
+    }
+#endif
+
+    for (Uint32 i = 0; i < Attribs.NumDrawItems; ++i)
+    {
+        const auto& Item = Attribs.pDrawItems[i];
+        if (Item.NumVertices > 0)
+        {
+            m_CommandBuffer.Draw(Item.NumVertices, Attribs.NumInstances, Item.StartVertexLocation, Attribs.FirstInstanceLocation);
+            ++m_State.NumCommands;
+        }
+    }
+}
+
+void DeviceContextVkImpl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs)
+{
+    DvpVerifyMultiDrawIndexedArguments(Attribs);
+
+    if (!PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType))
+        return;
+
+    if (Attribs.NumDrawItems == 0 || Attribs.NumInstances == 0)
+        return;
+
+#ifdef VK_EXT_multi_draw
+    if ((m_pDevice->GetAdapterInfo().DrawCommand.CapFlags & DRAW_COMMAND_CAP_FLAG_NATIVE_MULTI_DRAW) != 0)
+    {
+        m_MultiDrawIndexedInfo.resize(Attribs.NumDrawItems);
+        for (Uint32 i = 0; i < Attribs.NumDrawItems; ++i)
+        {
+            const auto& Item = Attribs.pDrawItems[i];
+
+            m_MultiDrawIndexedInfo[i].firstIndex   = Item.FirstIndexLocation;
+            m_MultiDrawIndexedInfo[i].indexCount   = Item.NumIndices;
+            m_MultiDrawIndexedInfo[i].vertexOffset = static_cast<int32_t>(Item.BaseVertex);
+        }
+
+        const auto MaxDrawCount = m_pDevice->GetPhysicalDevice().GetExtProperties().MultiDraw.maxMultiDrawCount;
+        for (Uint32 FirstItem = 0; FirstItem < Attribs.NumDrawItems; FirstItem += MaxDrawCount)
+        {
+            const auto DrawCount = std::min(Attribs.NumDrawItems - FirstItem, MaxDrawCount);
+            m_CommandBuffer.DrawMultiIndexed(DrawCount, &m_MultiDrawIndexedInfo[FirstItem], Attribs.NumInstances, Attribs.FirstInstanceLocation);
+            ++m_State.NumCommands;
+        }
+        return;
+    }
+#endif
+
+    for (Uint32 i = 0; i < Attribs.NumDrawItems; ++i)
+    {
+        const auto& Item = Attribs.pDrawItems[i];
+        if (Item.NumIndices > 0)
+        {
+            m_CommandBuffer.DrawIndexed(Item.NumIndices, Attribs.NumInstances, Item.FirstIndexLocation, Item.BaseVertex, Attribs.FirstInstanceLocation);
+            ++m_State.NumCommands;
+        }
+    }
+}
+
 void DeviceContextVkImpl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 {
     DvpVerifyDrawIndirectArguments(Attribs);
@@ -820,7 +967,8 @@ void DeviceContextVkImpl::DrawIndirect(const DrawIndirectAttribs& Attribs)
         PrepareIndirectAttribsBuffer(Attribs.pCounterBuffer, Attribs.CounterBufferStateTransitionMode, "Count buffer (DeviceContextVkImpl::DrawIndirect)") :
         nullptr;
 
-    PrepareForDraw(Attribs.Flags);
+    if (!PrepareForDraw(Attribs.Flags))
+        return;
 
     if (Attribs.DrawCount > 0)
     {
@@ -855,7 +1003,8 @@ void DeviceContextVkImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs&
         PrepareIndirectAttribsBuffer(Attribs.pCounterBuffer, Attribs.CounterBufferStateTransitionMode, "Count buffer (DeviceContextVkImpl::DrawIndexedIndirect)") :
         nullptr;
 
-    PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType);
+    if (!PrepareForIndexedDraw(Attribs.Flags, Attribs.IndexType))
+        return;
 
     if (Attribs.DrawCount > 0)
     {
@@ -883,7 +1032,8 @@ void DeviceContextVkImpl::DrawMesh(const DrawMeshAttribs& Attribs)
 {
     DvpVerifyDrawMeshArguments(Attribs);
 
-    PrepareForDraw(Attribs.Flags);
+    if (!PrepareForDraw(Attribs.Flags))
+        return;
 
     if (Attribs.ThreadGroupCount > 0)
     {
@@ -903,7 +1053,8 @@ void DeviceContextVkImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attrib
         PrepareIndirectAttribsBuffer(Attribs.pCounterBuffer, Attribs.CounterBufferStateTransitionMode, "Counter buffer (DeviceContextVkImpl::DrawMeshIndirect)") :
         nullptr;
 
-    PrepareForDraw(Attribs.Flags);
+    if (!PrepareForDraw(Attribs.Flags))
+        return;
 
     if (Attribs.CommandCount > 0)
     {
@@ -928,10 +1079,13 @@ void DeviceContextVkImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attrib
     ++m_State.NumCommands;
 }
 
-void DeviceContextVkImpl::PrepareForDispatchCompute()
+bool DeviceContextVkImpl::PrepareForDispatchCompute()
 {
     EnsureVkCmdBuffer();
 
+    if (m_State.PipelineBindPending && !BindPendingPipeline())
+        return false;
+
     // Dispatch commands must be executed outside of render pass
     if (m_CommandBuffer.GetState().RenderPass != VK_NULL_HANDLE)
         m_CommandBuffer.EndRenderPass();
@@ -946,12 +1100,17 @@ void DeviceContextVkImpl::PrepareForDispatchCompute()
     // Must be called after CommitDescriptorSets as it needs SetInfo.BaseInd
     DvpValidateCommittedShaderResources(BindInfo);
 #endif
+
+    return true;
 }
 
-void DeviceContextVkImpl::PrepareForRayTracing()
+bool DeviceContextVkImpl::PrepareForRayTracing()
 {
     EnsureVkCmdBuffer();
 
+    if (m_State.PipelineBindPending && !BindPendingPipeline())
+        return false;
+
     auto& BindInfo = GetBindInfo(PIPELINE_TYPE_RAY_TRACING);
     if (Uint32 CommitMask = BindInfo.GetCommitMask())
     {
@@ -962,13 +1121,16 @@ void DeviceContextVkImpl::PrepareForRayTracing()
     // Must be called after CommitDescriptorSets as it needs SetInfo.BaseInd
     DvpValidateCommittedShaderResources(BindInfo);
 #endif
+
+    return true;
 }
 
 void DeviceContextVkImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 {
     DvpVerifyDispatchArguments(Attribs);
 
-    PrepareForDispatchCompute();
+    if (!PrepareForDispatchCompute())
+        return;
 
     if (Attribs.ThreadGroupCountX > 0 && Attribs.ThreadGroupCountY > 0 && Attribs.ThreadGroupCountZ > 0)
     {
@@ -981,7 +1143,8 @@ void DeviceContextVkImpl::DispatchComputeIndirect(const DispatchComputeIndirectA
 {
     DvpVerifyDispatchIndirectArguments(Attribs);
 
-    PrepareForDispatchCompute();
+    if (!PrepareForDispatchCompute())
+        return;
 
     auto* pBufferVk = ClassPtrCast<BufferVkImpl>(Attribs.pAttribsBuffer);
 
@@ -2842,6 +3005,190 @@ VkCommandBuffer DeviceContextVkImpl::GetVkCommandBuffer()
     return m_CommandBuffer.GetVkCmdBuffer();
 }
 
+BarrierStatisticsVk DeviceContextVkImpl::GetBarrierStatistics() const
+{
+    const auto& Stats = m_CommandBuffer.GetBarrierStatistics();
+
+    BarrierStatisticsVk StatsVk;
+    StatsVk.PipelineBarrierCount = Stats.PipelineBarrierCount;
+    StatsVk.ImageBarrierCount    = Stats.ImageBarrierCount;
+    StatsVk.MemoryBarrierCount   = Stats.MemoryBarrierCount;
+    StatsVk.MergedBarrierCount   = Stats.MergedBarrierCount;
+    StatsVk.ElidedBarrierCount   = Stats.ElidedBarrierCount;
+    return StatsVk;
+}
+
+void DeviceContextVkImpl::ResetBarrierStatistics()
+{
+    m_CommandBuffer.ResetBarrierStatistics();
+}
+
+bool DeviceContextVkImpl::RelocateBuffer(BufferVkImpl& BufferVk)
+{
+    BufferVkImpl::RelocationTarget Target;
+    if (!BufferVk.CreateRelocationTarget(Target))
+        return false;
+
+    const auto OldState = BufferVk.GetState();
+    TransitionBufferState(BufferVk, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_COPY_SOURCE, /*UpdateBufferState = */ true);
+
+    VkBufferCopy CopyRegion;
+    CopyRegion.srcOffset = 0;
+    CopyRegion.dstOffset = 0;
+    CopyRegion.size      = BufferVk.GetDesc().Size;
+    m_CommandBuffer.CopyBuffer(BufferVk.GetVkBuffer(), Target.vkBuffer, 1, &CopyRegion);
+
+    BufferVk.Relocate(std::move(Target));
+
+    // The new buffer has been written by the copy command
+    BufferVk.SetState(RESOURCE_STATE_COPY_DEST);
+    TransitionBufferState(BufferVk, RESOURCE_STATE_COPY_DEST, OldState, /*UpdateBufferState = */ true);
+    return true;
+}
+
+bool DeviceContextVkImpl::RelocateTexture(TextureVkImpl& TextureVk)
+{
+    TextureVkImpl::RelocationTarget Target;
+    if (!TextureVk.CreateRelocationTarget(Target))
+        return false;
+
+    const auto OldState = TextureVk.GetState();
+    if (OldState == RESOURCE_STATE_UNDEFINED)
+    {
+        // The contents are undefined, so there is nothing to copy
+        TextureVk.Relocate(std::move(Target));
+        return true;
+    }
+
+    const auto& TexDesc = TextureVk.GetDesc();
+    TransitionTextureState(TextureVk, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_COPY_SOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE);
+
+    VkImageSubresourceRange SubresRange;
+    SubresRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+    SubresRange.baseArrayLayer = 0;
+    SubresRange.layerCount     = VK_REMAINING_ARRAY_LAYERS;
+    SubresRange.baseMipLevel   = 0;
+    SubresRange.levelCount     = VK_REMAINING_MIP_LEVELS;
+    m_CommandBuffer.TransitionImageLayout(Target.vkImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, SubresRange,
+                                          VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+    std::vector<VkImageCopy> CopyRegions(TexDesc.MipLevels);
+    for (Uint32 mip = 0; mip < TexDesc.MipLevels; ++mip)
+    {
+        const auto MipProps = GetMipLevelProperties(TexDesc, mip);
+
+        auto& Region = CopyRegions[mip];
+
+        Region.srcSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        Region.srcSubresource.mipLevel       = mip;
+        Region.srcSubresource.baseArrayLayer = 0;
+        Region.srcSubresource.layerCount     = TexDesc.GetArraySize();
+        Region.dstSubresource                = Region.srcSubresource;
+
+        Region.srcOffset = VkOffset3D{0, 0, 0};
+        Region.dstOffset = VkOffset3D{0, 0, 0};
+        // Copy regions of compressed textures must either be multiples of the block size
+        // or cover the entire subresource, so use the logical mip level size.
+        Region.extent = VkExtent3D{MipProps.LogicalWidth, MipProps.LogicalHeight, MipProps.Depth};
+    }
+    m_CommandBuffer.CopyImage(TextureVk.GetVkImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                              Target.vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                              static_cast<uint32_t>(CopyRegions.size()), CopyRegions.data());
+
+    TextureVk.Relocate(std::move(Target));
+
+    // The new image is in TRANSFER_DST layout
+    TextureVk.SetState(RESOURCE_STATE_COPY_DEST);
+    TransitionTextureState(TextureVk, RESOURCE_STATE_COPY_DEST, OldState, STATE_TRANSITION_FLAG_UPDATE_STATE);
+    return true;
+}
+
+void DeviceContextVkImpl::DefragmentMemory(const MemoryDefragmentationAttribsVk& Attribs,
+                                           MemoryDefragmentationStatsVk*         pStats)
+{
+    DEV_CHECK_ERR(!IsDeferred(), "Memory can only be defragmented by the immediate context");
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Memory can't be defragmented inside an active render pass");
+    DEV_CHECK_ERR(Attribs.MaxPageOccupancy >= 0 && Attribs.MaxPageOccupancy <= 1, "MaxPageOccupancy (", Attribs.MaxPageOccupancy, ") must be in [0, 1] range");
+
+    if (pStats != nullptr)
+        *pStats = {};
+
+    auto& MemMgr = m_pDevice->GetGlobalMemoryManager();
+
+    // The pages to evacuate are selected by the first call. The following calls continue moving
+    // the resources out of these pages until all resources that can be moved have been moved.
+    if (!MemMgr.IsDefragmenting())
+    {
+        VulkanUtilities::VulkanMemoryManager::DefragmentationInfo DefragInfo;
+        DefragInfo.MaxPageOccupancy = Attribs.MaxPageOccupancy;
+
+        const auto BeginStats = MemMgr.BeginDefragmentation(DefragInfo);
+        if (BeginStats.NumEvacuatedPages == 0)
+        {
+            MemMgr.EndDefragmentation();
+            if (pStats != nullptr)
+                pStats->IsComplete = True;
+            return;
+        }
+    }
+
+    MemMgr.BeginDefragmentationFrame(Attribs.MaxBytesToMove);
+    const auto BytesMovedBefore = MemMgr.GetDefragmentationStats().BytesMoved;
+
+    Uint32 NumRelocatedResources = 0;
+    {
+        // Resources can't be destroyed while the lock is held
+        auto Resources = m_pDevice->LockRelocatableResources();
+
+        const auto CtxMask = Uint64{1} << GetContextId();
+        auto       CanMove = [CtxMask](const auto& Res) {
+            // Resources used by other immediate contexts are left alone as their contents may be accessed by these contexts
+            return Res.IsBeingEvacuated() && Res.IsInKnownState() && (Res.GetDesc().ImmediateContextMask & ~CtxMask) == 0;
+        };
+
+        for (auto* pBufferVk : Resources.Buffers)
+        {
+            if (CanMove(*pBufferVk) && RelocateBuffer(*pBufferVk))
+                ++NumRelocatedResources;
+        }
+        for (auto* pTextureVk : Resources.Textures)
+        {
+            if (CanMove(*pTextureVk) && RelocateTexture(*pTextureVk))
+                ++NumRelocatedResources;
+        }
+    }
+
+    if (NumRelocatedResources > 0)
+    {
+        // Descriptor sets that reference the old Vulkan objects will be rewritten on the next commit
+        m_pDevice->OnResourcesRelocated();
+
+        // Submit the copy commands. The old Vulkan objects and their memory have been
+        // put into the release queue and will be destroyed when the GPU is done with them.
+        Flush();
+    }
+
+    const auto DefragStats = MemMgr.GetDefragmentationStats();
+
+    // If the budget has not been exhausted, every resource that can be moved has been moved
+    const bool IsComplete = !MemMgr.IsFrameBudgetExhausted();
+    if (IsComplete)
+    {
+        MemMgr.EndDefragmentation();
+        // Destroy the pages that have already become empty. The remaining evacuated pages are destroyed
+        // by ShrinkMemory() when the old allocations are released from the release queue.
+        MemMgr.ShrinkMemory();
+    }
+
+    if (pStats != nullptr)
+    {
+        pStats->NumEvacuatedPages     = DefragStats.NumEvacuatedPages;
+        pStats->NumRelocatedResources = NumRelocatedResources;
+        pStats->BytesMoved            = DefragStats.BytesMoved - BytesMovedBefore;
+        pStats->IsComplete            = IsComplete;
+    }
+}
+
 void DeviceContextVkImpl::TransitionBufferState(BufferVkImpl& BufferVk, RESOURCE_STATE OldState, RESOURCE_STATE NewState, bool UpdateBufferState)
 {
     VERIFY(m_pActiveRenderPass == nullptr, "State transitions are not allowed inside a render pass");
@@ -3603,7 +3950,9 @@ void DeviceContextVkImpl::TraceRays(const TraceRaysAttribs& Attribs)
     const auto* pSBTVk       = ClassPtrCast<const ShaderBindingTableVkImpl>(Attribs.pSBT);
     const auto& BindingTable = pSBTVk->GetVkBindingTable();
 
-    PrepareForRayTracing();
+    if (!PrepareForRayTracing())
+        return;
+
     m_CommandBuffer.TraceRays(BindingTable.RaygenShader, BindingTable.MissShader, BindingTable.HitShader, BindingTable.CallableShader,
                               Attribs.DimensionX, Attribs.DimensionY, Attribs.DimensionZ);
     ++m_State.NumCommands;
@@ -3619,7 +3968,9 @@ void DeviceContextVkImpl::TraceRaysIndirect(const TraceRaysIndirectAttribs& Attr
     auto* const pIndirectAttribsVk = PrepareIndirectAttribsBuffer(Attribs.pAttribsBuffer, Attribs.AttribsBufferStateTransitionMode, "Trace rays indirect (DeviceContextVkImpl::TraceRaysIndirect)");
     const auto  IndirectBuffOffset = Attribs.ArgsByteOffset + TraceRaysIndirectCommandSBTSize;
 
-    PrepareForRayTracing();
+    if (!PrepareForRayTracing())
+        return;
+
     m_CommandBuffer.TraceRaysIndirect(BindingTable.RaygenShader, BindingTable.MissShader, BindingTable.HitShader, BindingTable.CallableShader,
                                       pIndirectAttribsVk->GetVkDeviceAddress() + IndirectBuffOffset);
     ++m_State.NumCommands;
@@ -111,6 +111,63 @@ Uint32 FindImmutableSamplerVk(const PipelineResourceDesc&          Res,
     return FindImmutableSampler(Desc.ImmutableSamplers, Desc.NumImmutableSamplers, Res.ShaderStages, Res.Name, SamplerSuffix);
 }
 
+// Descriptor update template data contains one element for every resource in the SRB resource cache
+// descriptor set, so that the offset of the element is defined by the resource cache offset.
+union DescriptorTemplateData
+{
+    VkDescriptorImageInfo      ImageInfo;
+    VkDescriptorBufferInfo     BufferInfo;
+    VkBufferView               BufferView;
+    VkAccelerationStructureKHR AccelStruct;
+};
+
+void WriteDescriptorTemplateData(const ShaderResourceCacheVk::Resource& Res, DescriptorTemplateData& Data)
+{
+    static_assert(static_cast<Uint32>(DescriptorType::Count) == 16, "Please update the switch below to handle the new descriptor type");
+    switch (Res.Type)
+    {
+        case DescriptorType::Sampler:
+            Data.ImageInfo = Res.GetSamplerDescriptorWriteInfo();
+            break;
+
+        case DescriptorType::CombinedImageSampler:
+        case DescriptorType::SeparateImage:
+        case DescriptorType::StorageImage:
+            Data.ImageInfo = Res.GetImageDescriptorWriteInfo();
+            break;
+
+        case DescriptorType::UniformTexelBuffer:
+        case DescriptorType::StorageTexelBuffer:
+        case DescriptorType::StorageTexelBuffer_ReadOnly:
+            Data.BufferView = Res.GetBufferViewWriteInfo();
+            break;
+
+        case DescriptorType::UniformBuffer:
+        case DescriptorType::UniformBufferDynamic:
+            Data.BufferInfo = Res.GetUniformBufferDescriptorWriteInfo();
+            break;
+
+        case DescriptorType::StorageBuffer:
+        case DescriptorType::StorageBuffer_ReadOnly:
+        case DescriptorType::StorageBufferDynamic:
+        case DescriptorType::StorageBufferDynamic_ReadOnly:
+            Data.BufferInfo = Res.GetStorageBufferDescriptorWriteInfo();
+            break;
+
+        case DescriptorType::InputAttachment:
+        case DescriptorType::InputAttachment_General:
+            Data.ImageInfo = Res.GetInputAttachmentDescriptorWriteInfo();
+            break;
+
+        case DescriptorType::AccelerationStructure:
+            Data.AccelStruct = *Res.GetAccelerationStructureWriteInfo().pAccelerationStructures;
+            break;
+
+        default:
+            UNEXPECTED("Unexpected descriptor type");
+    }
+}
+
 } // namespace
 
 inline PipelineResourceSignatureVkImpl::CACHE_GROUP PipelineResourceSignatureVkImpl::GetResourceCacheGroup(const PipelineResourceDesc& Res)
@@ -152,6 +209,7 @@ PipelineResourceSignatureVkImpl::PipelineResourceSignatureVkImpl(IReferenceCount
             [this]() //
             {
                 CreateSetLayouts();
+                CreateDescriptorUpdateTemplates();
             },
             [this]() //
             {
@@ -438,6 +496,64 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts()
     VERIFY_EXPR(NumSets == GetNumDescriptorSets());
 }
 
+void PipelineResourceSignatureVkImpl::CreateDescriptorUpdateTemplates()
+{
+    const auto& LogicalDevice = GetDevice()->GetLogicalDevice();
+    if (!LogicalDevice.GetEnabledExtFeatures().DescrUpdateTemplate)
+        return;
+
+    std::vector<VkDescriptorUpdateTemplateEntry> vkEntries;
+    for (size_t SetId = 0; SetId < DESCRIPTOR_SET_ID_NUM_SETS; ++SetId)
+    {
+        if (!HasDescriptorSet(static_cast<DESCRIPTOR_SET_ID>(SetId)))
+            continue;
+
+        vkEntries.clear();
+        const auto ResIdxRange = GetDescriptorSetResourceRange(static_cast<DESCRIPTOR_SET_ID>(SetId));
+        for (Uint32 r = ResIdxRange.first; r < ResIdxRange.second; ++r)
+        {
+            const auto& Attr = GetResourceAttribs(r);
+            // Immutable samplers are permanently bound into the set layout and must not be written
+            if (Attr.GetDescriptorType() == DescriptorType::Sampler && Attr.IsImmutableSamplerAssigned())
+                continue;
+
+            vkEntries.emplace_back();
+            auto& vkEntry = vkEntries.back();
+
+            vkEntry.dstBinding      = Attr.BindingIndex;
+            vkEntry.dstArrayElement = 0;
+            vkEntry.descriptorCount = Attr.ArraySize;
+            vkEntry.descriptorType  = DescriptorTypeToVkDescriptorType(Attr.GetDescriptorType());
+            vkEntry.offset          = size_t{Attr.CacheOffset(ResourceCacheContentType::SRB)} * sizeof(DescriptorTemplateData);
+            vkEntry.stride          = sizeof(DescriptorTemplateData);
+        }
+
+        if (vkEntries.empty())
+            continue;
+
+        VkDescriptorUpdateTemplateCreateInfo TemplateCI{};
+
+        TemplateCI.sType                      = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+        TemplateCI.pNext                      = nullptr;
+        TemplateCI.flags                      = 0;
+        TemplateCI.descriptorUpdateEntryCount = static_cast<Uint32>(vkEntries.size());
+        TemplateCI.pDescriptorUpdateEntries   = vkEntries.data();
+        TemplateCI.templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+        TemplateCI.descriptorSetLayout        = m_VkDescrSetLayouts[SetId];
+
+        m_VkDescrUpdateTemplates[SetId] = LogicalDevice.CreateDescriptorUpdateTemplate(TemplateCI);
+    }
+}
+
+std::pair<Uint32, Uint32> PipelineResourceSignatureVkImpl::GetDescriptorSetResourceRange(DESCRIPTOR_SET_ID SetId) const
+{
+    // Resources are sorted by variable type, so static and mutable resources form one continuous range
+    static_assert(SHADER_RESOURCE_VARIABLE_TYPE_STATIC + 1 == SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE, "Static and mutable variables are expected to be adjacent");
+    return SetId == DESCRIPTOR_SET_ID_STATIC_MUTABLE ?
+        std::make_pair(GetResourceIndexRange(SHADER_RESOURCE_VARIABLE_TYPE_STATIC).first, GetResourceIndexRange(SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE).second) :
+        GetResourceIndexRange(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+}
+
 PipelineResourceSignatureVkImpl::~PipelineResourceSignatureVkImpl()
 {
     Destruct();
@@ -445,6 +561,12 @@ PipelineResourceSignatureVkImpl::~PipelineResourceSignatureVkImpl()
 
 void PipelineResourceSignatureVkImpl::Destruct()
 {
+    for (auto& UpdateTemplate : m_VkDescrUpdateTemplates)
+    {
+        if (UpdateTemplate)
+            m_pDevice->SafeReleaseDeviceObject(std::move(UpdateTemplate), ~0ull);
+    }
+
     for (auto& Layout : m_VkDescrSetLayouts)
     {
         if (Layout)
@@ -541,12 +663,9 @@ void PipelineResourceSignatureVkImpl::CopyStaticResources(ShaderResourceCacheVk&
             if (pCachedResource != pObject)
             {
                 VERIFY(pCachedResource == nullptr, "Static resource has already been initialized, and the new resource does not match previously assigned resource");
-                DstResourceCache.SetResource(&GetDevice()->GetLogicalDevice(),
-                                             StaticSetIdx,
+                DstResourceCache.SetResource(StaticSetIdx,
                                              DstCacheOffset,
                                              {
-                                                 Attr.BindingIndex,
-                                                 ArrInd,
                                                  RefCntAutoPtr<IDeviceObject>{SrcCachedRes.pObject},
                                                  SrcCachedRes.BufferBaseOffset,
                                                  SrcCachedRes.BufferRangeSize //
@@ -580,6 +699,90 @@ void PipelineResourceSignatureVkImpl::CommitDynamicResources(const ShaderResourc
     VERIFY(HasDescriptorSet(DESCRIPTOR_SET_ID_DYNAMIC), "This signature does not contain dynamic resources");
     VERIFY_EXPR(vkDynamicDescriptorSet != VK_NULL_HANDLE);
     VERIFY_EXPR(ResourceCache.GetContentType() == ResourceCacheContentType::SRB);
+    VERIFY(ResourceCache.GetDescriptorSet(GetDescriptorSetIndex<DESCRIPTOR_SET_ID_DYNAMIC>()).GetVkDescriptorSet() == VK_NULL_HANDLE,
+           "Dynamic descriptor set must not be assigned to the resource cache");
+
+    if (!WriteDescriptorSetWithTemplate(ResourceCache, DESCRIPTOR_SET_ID_DYNAMIC, vkDynamicDescriptorSet))
+        WriteDescriptorSet(ResourceCache, DESCRIPTOR_SET_ID_DYNAMIC, vkDynamicDescriptorSet);
+}
+
+void PipelineResourceSignatureVkImpl::CommitStaticMutableResources(ShaderResourceCacheVk& ResourceCache, Uint32 RelocationEpoch) const
+{
+    VERIFY(HasDescriptorSet(DESCRIPTOR_SET_ID_STATIC_MUTABLE), "This signature does not contain static or mutable resources");
+    VERIFY_EXPR(ResourceCache.GetContentType() == ResourceCacheContentType::SRB);
+
+    // The same SRB may be committed by multiple contexts simultaneously
+    auto Lock = ResourceCache.LockDescriptorWrites();
+    // Clear the flag before writing the descriptors so that resources bound by another thread
+    // in the meantime are not lost: they mark the cache again and are written by the next commit.
+    if (!ResourceCache.ClearPendingDescriptorWrites(RelocationEpoch))
+        return; // Descriptors have been written by another thread
+
+    const auto& DescrSet = const_cast<const ShaderResourceCacheVk&>(ResourceCache).GetDescriptorSet(GetDescriptorSetIndex<DESCRIPTOR_SET_ID_STATIC_MUTABLE>());
+    const auto  vkSet    = DescrSet.GetVkDescriptorSet();
+    VERIFY(vkSet != VK_NULL_HANDLE, "Static/mutable descriptor set must be assigned to the resource cache");
+
+    // Note that non-dynamic variables can't be rebound, so the set is normally written when the SRB is
+    // committed for the first time, then after unbound variables have been set, and after the resources
+    // have been relocated.
+    if (!WriteDescriptorSetWithTemplate(ResourceCache, DESCRIPTOR_SET_ID_STATIC_MUTABLE, vkSet))
+        WriteDescriptorSet(ResourceCache, DESCRIPTOR_SET_ID_STATIC_MUTABLE, vkSet);
+}
+
+bool PipelineResourceSignatureVkImpl::WriteDescriptorSetWithTemplate(const ShaderResourceCacheVk& ResourceCache,
+                                                                     DESCRIPTOR_SET_ID            SetId,
+                                                                     VkDescriptorSet              vkDescriptorSet) const
+{
+    const VkDescriptorUpdateTemplate vkTemplate = m_VkDescrUpdateTemplates[SetId];
+    if (vkTemplate == VK_NULL_HANDLE)
+        return false;
+
+    const auto  SetIdx   = SetId == DESCRIPTOR_SET_ID_STATIC_MUTABLE ? GetDescriptorSetIndex<DESCRIPTOR_SET_ID_STATIC_MUTABLE>() : GetDescriptorSetIndex<DESCRIPTOR_SET_ID_DYNAMIC>();
+    const auto& DescrSet = ResourceCache.GetDescriptorSet(SetIdx);
+    const auto  SetSize  = DescrSet.GetSize();
+
+    // Do not zero-initialize the array!
+    std::array<DescriptorTemplateData, 64> LocalData;
+    std::vector<DescriptorTemplateData>    HeapData;
+
+    auto* pData = LocalData.data();
+    if (SetSize > LocalData.size())
+    {
+        HeapData.resize(SetSize);
+        pData = HeapData.data();
+    }
+
+    constexpr auto CacheType   = ResourceCacheContentType::SRB;
+    const auto     ResIdxRange = GetDescriptorSetResourceRange(SetId);
+    for (Uint32 ResIdx = ResIdxRange.first; ResIdx < ResIdxRange.second; ++ResIdx)
+    {
+        const auto& Attr = GetResourceAttribs(ResIdx);
+        if (Attr.GetDescriptorType() == DescriptorType::Sampler && Attr.IsImmutableSamplerAssigned())
+            continue; // Immutable samplers are not written by the template
+
+        const auto CacheOffset = Attr.CacheOffset(CacheType);
+        for (Uint32 ArrElem = 0; ArrElem < Attr.ArraySize; ++ArrElem)
+        {
+            const auto& CachedRes = DescrSet.GetResource(CacheOffset + ArrElem);
+            // The template writes every array element, while null descriptors are not allowed
+            if (!CachedRes)
+                return false;
+
+            WriteDescriptorTemplateData(CachedRes, pData[CacheOffset + ArrElem]);
+        }
+    }
+
+    GetDevice()->GetLogicalDevice().UpdateDescriptorSetWithTemplate(vkDescriptorSet, vkTemplate, pData);
+    return true;
+}
+
+void PipelineResourceSignatureVkImpl::WriteDescriptorSet(const ShaderResourceCacheVk& ResourceCache,
+                                                         DESCRIPTOR_SET_ID            SetId,
+                                                         VkDescriptorSet              vkDescriptorSet) const
+{
+    VERIFY_EXPR(HasDescriptorSet(SetId));
+    VERIFY_EXPR(vkDescriptorSet != VK_NULL_HANDLE);
+    VERIFY_EXPR(ResourceCache.GetContentType() == ResourceCacheContentType::SRB);
 
 #ifdef DILIGENT_DEBUG
     static constexpr size_t ImgUpdateBatchSize          = 4;
@@ -608,14 +811,14 @@ void PipelineResourceSignatureVkImpl::CommitDynamicResources(const ShaderResourc
     auto AccelStructIt   = DescrAccelStructArr.begin();
     auto WriteDescrSetIt = WriteDescrSetArr.begin();
 
-    const auto  DynamicSetIdx  = GetDescriptorSetIndex<DESCRIPTOR_SET_ID_DYNAMIC>();
-    const auto& SetResources   = ResourceCache.GetDescriptorSet(DynamicSetIdx);
-    const auto& LogicalDevice  = GetDevice()->GetLogicalDevice();
-    const auto  DynResIdxRange = GetResourceIndexRange(SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+    const auto  SetIdx        = SetId == DESCRIPTOR_SET_ID_STATIC_MUTABLE ? GetDescriptorSetIndex<DESCRIPTOR_SET_ID_STATIC_MUTABLE>() : GetDescriptorSetIndex<DESCRIPTOR_SET_ID_DYNAMIC>();
+    const auto& SetResources  = ResourceCache.GetDescriptorSet(SetIdx);
+    const auto& LogicalDevice = GetDevice()->GetLogicalDevice();
+    const auto  ResIdxRange   = GetDescriptorSetResourceRange(SetId);
 
     constexpr auto CacheType = ResourceCacheContentType::SRB;
 
-    for (Uint32 ResIdx = DynResIdxRange.first, ArrElem = 0; ResIdx < DynResIdxRange.second;)
+    for (Uint32 ResIdx = ResIdxRange.first, ArrElem = 0; ResIdx < ResIdxRange.second;)
     {
         const auto& Attr        = GetResourceAttribs(ResIdx);
         const auto  CacheOffset = Attr.CacheOffset(CacheType);
@@ -626,14 +829,13 @@ void PipelineResourceSignatureVkImpl::CommitDynamicResources(const ShaderResourc
         {
             const auto& Res = GetResourceDesc(ResIdx);
             VERIFY_EXPR(ArraySize == GetResourceDesc(ResIdx).ArraySize);
-            VERIFY_EXPR(Res.VarType == SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+            VERIFY_EXPR(VarTypeToDescriptorSetId(Res.VarType) == SetId);
         }
 #endif
 
-        WriteDescrSetIt->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        WriteDescrSetIt->pNext = nullptr;
-        VERIFY(SetResources.GetVkDescriptorSet() == VK_NULL_HANDLE, "Dynamic descriptor set must not be assigned to the resource cache");
-        WriteDescrSetIt->dstSet = vkDynamicDescriptorSet;
+        WriteDescrSetIt->sType  = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        WriteDescrSetIt->pNext  = nullptr;
+        WriteDescrSetIt->dstSet = vkDescriptorSet;
         VERIFY(WriteDescrSetIt->dstSet != VK_NULL_HANDLE, "Vulkan descriptor set must not be null");
         WriteDescrSetIt->dstBinding      = Attr.BindingIndex;
         WriteDescrSetIt->dstArrayElement = ArrElem;
@@ -28,11 +28,46 @@
 #include "PipelineStateCacheVkImpl.hpp"
 #include "RenderDeviceVkImpl.hpp"
 #include "VulkanTypeConversions.hpp"
-#include "DataBlobImpl.hpp"
 
 namespace Diligent
 {
 
+bool PipelineStateCacheVkImpl::IsCompatibleDriverData(const Uint8* pData, size_t DataSize) const
+{
+    if (pData == nullptr || DataSize == 0)
+        return false;
+
+    // Check the header before passing the data to the driver, so that data from another
+    // device or garbage are dropped rather than relying on every driver to reject them.
+    struct
+    {
+        Uint32 headerSize;
+        Uint32 headerVersion;
+        Uint32 vendorID;
+        Uint32 deviceID;
+        Uint8  pipelineCacheUUID[VK_UUID_SIZE];
+    } Header{};
+    static_assert(sizeof(Header) == 32, "Unexpected size of the Vulkan pipeline cache header");
+    if (DataSize < sizeof(Header))
+    {
+        LOG_WARNING_MESSAGE("Vulkan pipeline cache data is too small and will be ignored");
+        return false;
+    }
+    memcpy(&Header, pData, sizeof(Header));
+
+    const auto& Props = m_pDevice->GetPhysicalDevice().GetProperties();
+    if (Header.headerSize < sizeof(Header) || Header.headerSize > DataSize ||
+        Header.headerVersion != static_cast<Uint32>(VK_PIPELINE_CACHE_HEADER_VERSION_ONE) ||
+        Header.vendorID != Props.vendorID || Header.deviceID != Props.deviceID ||
+        memcmp(Header.pipelineCacheUUID, Props.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+    {
+        LOG_INFO_MESSAGE("Vulkan pipeline cache data was created by a different device or driver and will be ignored");
+        return false;
+    }
+
+    return true;
+}
+
 PipelineStateCacheVkImpl::PipelineStateCacheVkImpl(IReferenceCounters*                 pRefCounters,
                                                    RenderDeviceVkImpl*                 pRenderDeviceVk,
                                                    const PipelineStateCacheCreateInfo& CreateInfo) :
@@ -49,10 +84,11 @@ PipelineStateCacheVkImpl::PipelineStateCacheVkImpl(IReferenceCounters*
     VkPipelineCacheCreateInfo VkPipelineStateCacheCI{};
     VkPipelineStateCacheCI.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
 
-    if (CreateInfo.pCacheData != nullptr && CreateInfo.CacheDataSize > 0)
+    // Driver cache data is stored in the backend-independent container
+    if (IsCompatibleDriverData(m_Storage.GetDriverData(), m_Storage.GetDriverDataSize()))
     {
-        VkPipelineStateCacheCI.initialDataSize = CreateInfo.CacheDataSize;
-        VkPipelineStateCacheCI.pInitialData    = CreateInfo.pCacheData;
+        VkPipelineStateCacheCI.initialDataSize = m_Storage.GetDriverDataSize();
+        VkPipelineStateCacheCI.pInitialData    = m_Storage.GetDriverData();
     }
 
     m_PipelineStateCache = m_pDevice->GetLogicalDevice().CreatePipelineCache(VkPipelineStateCacheCI, m_Desc.Name);
@@ -76,12 +112,12 @@ void PipelineStateCacheVkImpl::GetData(IDataBlob** ppBlob)
     if (vkGetPipelineCacheData(vkDevice, m_PipelineStateCache, &DataSize, nullptr) != VK_SUCCESS)
         return;
 
-    auto pDataBlob = DataBlobImpl::Create(DataSize);
-
-    if (vkGetPipelineCacheData(vkDevice, m_PipelineStateCache, &DataSize, pDataBlob->GetDataPtr()) != VK_SUCCESS)
+    std::vector<Uint8> DriverData(DataSize);
+    if (vkGetPipelineCacheData(vkDevice, m_PipelineStateCache, &DataSize, DriverData.data()) != VK_SUCCESS)
         return;
 
-    *ppBlob = pDataBlob.Detach();
+    auto pDataBlob = m_Storage.Serialize(DriverData.data(), DataSize);
+    *ppBlob        = pDataBlob.Detach();
 }
 
 } // namespace Diligent
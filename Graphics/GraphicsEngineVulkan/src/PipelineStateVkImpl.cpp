@@ -86,11 +86,352 @@ bool StripReflection(std::vector<uint32_t>& SPIRV)
 #endif
 }
 
-void InitPipelineShaderStages(const VulkanUtilities::VulkanLogicalDevice&        LogicalDevice,
-                              PipelineStateVkImpl::TShaderStages&                ShaderStages,
-                              std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules,
-                              std::vector<VkPipelineShaderStageCreateInfo>&      Stages)
+// Specialization constant values of a single shader in the pipeline
+struct ShaderSpecializationData
 {
+    std::vector<VkSpecializationMapEntry> MapEntries;
+    std::vector<Uint8>                    Data;
+};
+// Specialization data for every shader, in the same order as shader stages are initialized by InitPipelineShaderStages()
+using PipelineSpecializationData = std::vector<ShaderSpecializationData>;
+
+PipelineSpecializationData GetSpecializationData(const PipelineStateCreateInfo&            CreateInfo,
+                                                 const PipelineStateVkImpl::TShaderStages& ShaderStages) noexcept(false)
+{
+    PipelineSpecializationData SpecData;
+    if (CreateInfo.NumSpecializationConstants == 0)
+        return SpecData;
+
+    for (const auto& Stage : ShaderStages)
+    {
+        for (const auto* pShader : Stage.Shaders)
+        {
+            SpecData.emplace_back();
+            auto& ShaderData = SpecData.back();
+
+            const auto& pResources = pShader->GetShaderResources();
+            VERIFY_EXPR(pResources);
+            for (Uint32 i = 0; i < CreateInfo.NumSpecializationConstants; ++i)
+            {
+                const auto& Const = CreateInfo.pSpecializationConstants[i];
+                if ((Const.ShaderStages & Stage.Type) == 0)
+                    continue;
+
+                const auto* pAttribs = pResources->FindSpecializationConstant(Const.Name);
+                if (pAttribs == nullptr)
+                    continue;
+
+                if (pAttribs->Size != Const.Size)
+                {
+                    LOG_ERROR_AND_THROW("The size (", Const.Size, ") of specialization constant '", Const.Name,
+                                        "' does not match the size of the constant in shader '", pShader->GetDesc().Name, "' (", pAttribs->Size, ").");
+                }
+
+                VkSpecializationMapEntry MapEntry{};
+                MapEntry.constantID = pAttribs->SpecId;
+                MapEntry.offset     = static_cast<uint32_t>(ShaderData.Data.size());
+                MapEntry.size       = Const.Size;
+                ShaderData.MapEntries.push_back(MapEntry);
+
+                const auto* pValue = static_cast<const Uint8*>(Const.pValue);
+                ShaderData.Data.insert(ShaderData.Data.end(), pValue, pValue + Const.Size);
+            }
+        }
+    }
+
+    return SpecData;
+}
+
+void HashShader(ContentHasher& Hasher, const IShader* pShader)
+{
+    if (pShader != nullptr)
+        Hasher.Update(ClassPtrCast<const ShaderVkImpl>(pShader)->GetSPIRVHash());
+    else
+        Hasher.Update(Uint32{0});
+}
+
+void HashImmutableSamplers(ContentHasher& Hasher, const ImmutableSamplerDesc* pSamplers, Uint32 NumSamplers)
+{
+    Hasher.Update(NumSamplers);
+    for (Uint32 i = 0; i < NumSamplers; ++i)
+    {
+        const auto& Sam = pSamplers[i];
+        Hasher.Update(Sam.ShaderStages);
+        Hasher.Update(Sam.SamplerOrTextureName);
+        Hasher.Update(Uint64{std::hash<SamplerDesc>{}(Sam.Desc)});
+    }
+}
+
+// Hashes all members of the create info that affect the pipeline. Pointers are never hashed directly,
+// so the key is stable between runs. Shaders are identified by the hash of their byte code.
+void HashPipelineStateCreateInfo(ContentHasher&                            Hasher,
+                                 const PipelineStateCreateInfo&            CreateInfo,
+                                 const PipelineStateVkImpl::TShaderStages& ShaderStages)
+{
+    // Separates pipeline entries from shader entries
+    Hasher.Update("PipelineVk");
+
+    const auto& PSODesc = CreateInfo.PSODesc;
+    Hasher.Update(PSODesc.PipelineType);
+    // Asynchronous creation does not affect the result
+    Hasher.Update(static_cast<Uint32>(CreateInfo.Flags & ~PSO_CREATE_FLAG_ASYNCHRONOUS));
+
+    const auto& ResLayout = PSODesc.ResourceLayout;
+    Hasher.Update(ResLayout.DefaultVariableType);
+    Hasher.Update(ResLayout.DefaultVariableMergeStages);
+    Hasher.Update(ResLayout.NumVariables);
+    for (Uint32 i = 0; i < ResLayout.NumVariables; ++i)
+    {
+        const auto& Var = ResLayout.Variables[i];
+        Hasher.Update(Var.ShaderStages);
+        Hasher.Update(Var.Name);
+        Hasher.Update(Var.Type);
+        Hasher.Update(Var.Flags);
+    }
+    HashImmutableSamplers(Hasher, ResLayout.ImmutableSamplers, ResLayout.NumImmutableSamplers);
+
+    Hasher.Update(CreateInfo.ResourceSignaturesCount);
+    for (Uint32 i = 0; i < CreateInfo.ResourceSignaturesCount; ++i)
+    {
+        const auto* pSignature = CreateInfo.ppResourceSignatures[i];
+        if (pSignature == nullptr)
+        {
+            Hasher.Update(Uint32{0});
+            continue;
+        }
+
+        const auto& SignDesc = pSignature->GetDesc();
+        Hasher.Update(SignDesc.BindingIndex);
+        Hasher.Update(SignDesc.NumResources);
+        for (Uint32 r = 0; r < SignDesc.NumResources; ++r)
+        {
+            const auto& Res = SignDesc.Resources[r];
+            Hasher.Update(Res.Name);
+            Hasher.Update(Res.ShaderStages);
+            Hasher.Update(Res.ArraySize);
+            Hasher.Update(Res.ResourceType);
+            Hasher.Update(Res.VarType);
+            Hasher.Update(Res.Flags);
+        }
+        HashImmutableSamplers(Hasher, SignDesc.ImmutableSamplers, SignDesc.NumImmutableSamplers);
+        Hasher.Update(SignDesc.UseCombinedTextureSamplers);
+        if (SignDesc.UseCombinedTextureSamplers)
+            Hasher.Update(SignDesc.CombinedSamplerSuffix);
+    }
+
+    Hasher.Update(CreateInfo.NumSpecializationConstants);
+    for (Uint32 i = 0; i < CreateInfo.NumSpecializationConstants; ++i)
+    {
+        const auto& Const = CreateInfo.pSpecializationConstants[i];
+        Hasher.Update(Const.Name);
+        Hasher.Update(Const.ShaderStages);
+        Hasher.Update(Const.Size);
+        Hasher.UpdateRaw(Const.pValue, Const.Size);
+    }
+
+    for (const auto& Stage : ShaderStages)
+    {
+        Hasher.Update(Stage.Type);
+        Hasher.Update(static_cast<Uint32>(Stage.Shaders.size()));
+        for (const auto* pShader : Stage.Shaders)
+        {
+            Hasher.Update(pShader->GetEntryPoint());
+            HashShader(Hasher, pShader);
+        }
+    }
+}
+
+void HashPipelineStateCreateInfo(ContentHasher&                            Hasher,
+                                 const GraphicsPipelineStateCreateInfo&    CreateInfo,
+                                 const PipelineStateVkImpl::TShaderStages& ShaderStages)
+{
+    HashPipelineStateCreateInfo(Hasher, static_cast<const PipelineStateCreateInfo&>(CreateInfo), ShaderStages);
+
+    const auto& GraphicsPipeline = CreateInfo.GraphicsPipeline;
+    Hasher.Update(Uint64{std::hash<BlendStateDesc>{}(GraphicsPipeline.BlendDesc)});
+    Hasher.Update(GraphicsPipeline.SampleMask);
+    Hasher.Update(Uint64{std::hash<RasterizerStateDesc>{}(GraphicsPipeline.RasterizerDesc)});
+    Hasher.Update(Uint64{std::hash<DepthStencilStateDesc>{}(GraphicsPipeline.DepthStencilDesc)});
+
+    const auto& InputLayout = GraphicsPipeline.InputLayout;
+    Hasher.Update(InputLayout.NumElements);
+    for (Uint32 i = 0; i < InputLayout.NumElements; ++i)
+    {
+        const auto& Elem = InputLayout.LayoutElements[i];
+        Hasher.Update(Elem.HLSLSemantic);
+        Hasher.Update(Elem.InputIndex);
+        Hasher.Update(Elem.BufferSlot);
+        Hasher.Update(Elem.NumComponents);
+        Hasher.Update(Elem.ValueType);
+        Hasher.Update(Elem.IsNormalized);
+        Hasher.Update(Elem.RelativeOffset);
+        Hasher.Update(Elem.Stride);
+        Hasher.Update(Elem.Frequency);
+        Hasher.Update(Elem.InstanceDataStepRate);
+    }
+
+    Hasher.Update(GraphicsPipeline.PrimitiveTopology);
+    Hasher.Update(GraphicsPipeline.NumViewports);
+    Hasher.Update(GraphicsPipeline.NumRenderTargets);
+    Hasher.Update(GraphicsPipeline.SubpassIndex);
+    Hasher.Update(GraphicsPipeline.ShadingRateFlags);
+    for (Uint32 rt = 0; rt < GraphicsPipeline.NumRenderTargets; ++rt)
+        Hasher.Update(GraphicsPipeline.RTVFormats[rt]);
+    Hasher.Update(GraphicsPipeline.DSVFormat);
+    Hasher.Update(GraphicsPipeline.SmplDesc.Count);
+    Hasher.Update(GraphicsPipeline.SmplDesc.Quality);
+    Hasher.Update(GraphicsPipeline.NodeMask);
+
+    if (GraphicsPipeline.pRenderPass != nullptr)
+    {
+        // Only attachment formats and sample counts affect render pass compatibility
+        const auto& RPDesc = GraphicsPipeline.pRenderPass->GetDesc();
+        Hasher.Update(RPDesc.AttachmentCount);
+        for (Uint32 i = 0; i < RPDesc.AttachmentCount; ++i)
+        {
+            Hasher.Update(RPDesc.pAttachments[i].Format);
+            Hasher.Update(RPDesc.pAttachments[i].SampleCount);
+        }
+        Hasher.Update(RPDesc.SubpassCount);
+    }
+}
+
+void HashPipelineStateCreateInfo(ContentHasher&                            Hasher,
+                                 const RayTracingPipelineStateCreateInfo&  CreateInfo,
+                                 const PipelineStateVkImpl::TShaderStages& ShaderStages)
+{
+    HashPipelineStateCreateInfo(Hasher, static_cast<const PipelineStateCreateInfo&>(CreateInfo), ShaderStages);
+
+    Hasher.Update(CreateInfo.RayTracingPipeline.ShaderRecordSize);
+    Hasher.Update(CreateInfo.RayTracingPipeline.MaxRecursionDepth);
+    Hasher.Update(CreateInfo.pShaderRecordName);
+    Hasher.Update(CreateInfo.MaxAttributeSize);
+    Hasher.Update(CreateInfo.MaxPayloadSize);
+
+    Hasher.Update(CreateInfo.GeneralShaderCount);
+    for (Uint32 i = 0; i < CreateInfo.GeneralShaderCount; ++i)
+    {
+        const auto& Group = CreateInfo.pGeneralShaders[i];
+        Hasher.Update(Group.Name);
+        HashShader(Hasher, Group.pShader);
+    }
+
+    Hasher.Update(CreateInfo.TriangleHitShaderCount);
+    for (Uint32 i = 0; i < CreateInfo.TriangleHitShaderCount; ++i)
+    {
+        const auto& Group = CreateInfo.pTriangleHitShaders[i];
+        Hasher.Update(Group.Name);
+        HashShader(Hasher, Group.pClosestHitShader);
+        HashShader(Hasher, Group.pAnyHitShader);
+    }
+
+    Hasher.Update(CreateInfo.ProceduralHitShaderCount);
+    for (Uint32 i = 0; i < CreateInfo.ProceduralHitShaderCount; ++i)
+    {
+        const auto& Group = CreateInfo.pProceduralHitShaders[i];
+        Hasher.Update(Group.Name);
+        HashShader(Hasher, Group.pIntersectionShader);
+        HashShader(Hasher, Group.pClosestHitShader);
+        HashShader(Hasher, Group.pAnyHitShader);
+    }
+}
+
+// Pipeline entry in the PSO cache contains the byte code of every shader, with remapped bindings
+// and stripped reflection, in the order of shader stages:
+//
+//     | Num shaders | Size 0 | SPIRV 0 | Size 1 | SPIRV 1 | ...
+//
+// Sizes are given in 32-bit words.
+std::vector<Uint8> SerializePipelineByteCode(const PipelineStateVkImpl::TShaderStages& ShaderStages)
+{
+    std::vector<uint32_t> Words;
+    Words.push_back(0);
+    for (const auto& Stage : ShaderStages)
+    {
+        for (const auto& SPIRV : Stage.SPIRVs)
+        {
+            Words.push_back(static_cast<uint32_t>(SPIRV.size()));
+            Words.insert(Words.end(), SPIRV.begin(), SPIRV.end());
+            ++Words[0];
+        }
+    }
+
+    const auto* pBytes = reinterpret_cast<const Uint8*>(Words.data());
+    return std::vector<Uint8>{pBytes, pBytes + Words.size() * sizeof(uint32_t)};
+}
+
+// Replaces the byte code of all shaders with the byte code from the pipeline entry.
+// Returns false if there is no entry or it does not match the shader stages.
+bool LoadPipelineByteCode(const PipelineStateCacheStorage&    Storage,
+                          const ContentHash&                  Key,
+                          PipelineStateVkImpl::TShaderStages& ShaderStages)
+{
+    const auto pData = Storage.Find(Key);
+    if (!pData || pData->GetSize() % sizeof(uint32_t) != 0 || pData->GetSize() == 0)
+        return false;
+
+    // The entry references the cache data, which are not necessarily aligned, so the words are read with memcpy
+    const auto* const pBytes   = static_cast<const Uint8*>(pData->GetConstDataPtr());
+    const size_t      NumWords = pData->GetSize() / sizeof(uint32_t);
+
+    const auto GetWord = [pBytes](size_t Idx) {
+        uint32_t Word;
+        memcpy(&Word, pBytes + Idx * sizeof(uint32_t), sizeof(Word));
+        return Word;
+    };
+
+    size_t NumShaders = 0;
+    for (const auto& Stage : ShaderStages)
+        NumShaders += Stage.Count();
+    if (GetWord(0) != NumShaders)
+        return false;
+
+    // Validate the entry before modifying the stages
+    size_t Offset = 1;
+    for (size_t i = 0; i < NumShaders; ++i)
+    {
+        if (Offset >= NumWords || GetWord(Offset) == 0 || GetWord(Offset) > NumWords - Offset - 1)
+            return false;
+        Offset += 1 + GetWord(Offset);
+    }
+    if (Offset != NumWords)
+        return false;
+
+    Offset = 1;
+    for (auto& Stage : ShaderStages)
+    {
+        for (auto& SPIRV : Stage.SPIRVs)
+        {
+            const auto Size = GetWord(Offset++);
+            SPIRV.resize(Size);
+            memcpy(SPIRV.data(), pBytes + Offset * sizeof(uint32_t), Size * sizeof(uint32_t));
+            Offset += Size;
+        }
+    }
+
+    return true;
+}
+
+void InitPipelineShaderStages(RenderDeviceVkImpl*                           pDeviceVk,
+                              PipelineStateVkImpl::TShaderStages&           ShaderStages,
+                              const PipelineSpecializationData&             SpecData,
+                              std::vector<ShaderModuleCache::ModulePtr>&    ShaderModules,
+                              std::vector<VkPipelineShaderStageCreateInfo>& Stages,
+                              std::vector<VkSpecializationInfo>&            SpecInfos,
+                              PipelineStateCacheVkImpl*                     pPSOCache,
+                              const ContentHash&                            PSOCacheKey,
+                              bool                                          IsCachedByteCode)
+{
+    const auto& LogicalDevice = pDeviceVk->GetLogicalDevice();
+    auto&       ModuleCache   = pDeviceVk->GetShaderModuleCache();
+
+    // The pipeline entry is only stored if the byte code of all shaders has been processed
+    const bool StoreInCache = pPSOCache != nullptr && !IsCachedByteCode;
+    bool       AllStripped  = true;
+
+    // Stages keep pointers to the specialization infos, so the array must not be reallocated
+    SpecInfos.reserve(SpecData.size());
+
     for (size_t s = 0; s < ShaderStages.size(); ++s)
     {
         const auto& Shaders    = ShaderStages[s].Shaders;
@@ -115,26 +456,65 @@ void InitPipelineShaderStages(const VulkanUtilities::VulkanLogicalDevice&
             auto* pShader = Shaders[i];
             auto& SPIRV   = SPIRVs[i];
 
-            // We have to strip reflection instructions to fix the following validation error:
-            //     SPIR-V module not valid: DecorateStringGOOGLE requires one of the following extensions: SPV_GOOGLE_decorate_string
-            // Optimizer also performs validation and may catch problems with the byte code.
-            if (!StripReflection(SPIRV))
-                LOG_ERROR("Failed to strip reflection information from shader '", pShader->GetDesc().Name, "'. This may indicate a problem with the byte code.");
+            // The byte code with remapped bindings fully defines the result of the processing below,
+            // so it is used as the key in the shader module cache. Byte code loaded from the PSO cache
+            // has already been processed and is used as the key as is.
+            const auto ModuleKey = ComputeContentHash(SPIRV.data(), SPIRV.size() * sizeof(uint32_t));
 
-            ShaderModuleCI.codeSize = SPIRV.size() * sizeof(uint32_t);
-            ShaderModuleCI.pCode    = SPIRV.data();
+            auto pModule = ModuleCache.Find(ModuleKey);
+            if (!IsCachedByteCode && (!pModule || StoreInCache))
+            {
+                // We have to strip reflection instructions to fix the following validation error:
+                //     SPIR-V module not valid: DecorateStringGOOGLE requires one of the following extensions: SPV_GOOGLE_decorate_string
+                // Optimizer also performs validation and may catch problems with the byte code.
+                if (!StripReflection(SPIRV))
+                {
+                    LOG_ERROR("Failed to strip reflection information from shader '", pShader->GetDesc().Name, "'. This may indicate a problem with the byte code.");
+                    AllStripped = false;
+                }
+            }
+
+            if (!pModule)
+            {
+                ShaderModuleCI.codeSize = SPIRV.size() * sizeof(uint32_t);
+                ShaderModuleCI.pCode    = SPIRV.data();
 
-            ShaderModules.push_back(LogicalDevice.CreateShaderModule(ShaderModuleCI, pShader->GetDesc().Name));
+                pModule = ModuleCache.Add(ModuleKey, LogicalDevice.CreateShaderModule(ShaderModuleCI, pShader->GetDesc().Name));
+            }
+            ShaderModules.push_back(std::move(pModule));
 
-            StageCI.module              = ShaderModules.back();
+            StageCI.module              = *ShaderModules.back();
             StageCI.pName               = pShader->GetEntryPoint();
             StageCI.pSpecializationInfo = nullptr;
 
+            if (!SpecData.empty())
+            {
+                VERIFY_EXPR(Stages.size() < SpecData.size());
+                const auto& ShaderData = SpecData[Stages.size()];
+                if (!ShaderData.MapEntries.empty())
+                {
+                    VkSpecializationInfo SpecInfo{};
+                    SpecInfo.mapEntryCount = static_cast<uint32_t>(ShaderData.MapEntries.size());
+                    SpecInfo.pMapEntries   = ShaderData.MapEntries.data();
+                    SpecInfo.dataSize      = ShaderData.Data.size();
+                    SpecInfo.pData         = ShaderData.Data.data();
+                    SpecInfos.push_back(SpecInfo);
+
+                    StageCI.pSpecializationInfo = &SpecInfos.back();
+                }
+            }
+
             Stages.push_back(StageCI);
         }
     }
 
     VERIFY_EXPR(ShaderModules.size() == Stages.size());
+
+    if (StoreInCache && AllStripped)
+    {
+        const auto Data = SerializePipelineByteCode(ShaderStages);
+        pPSOCache->GetStorage().Store(PSOCacheKey, Data.data(), Data.size());
+    }
 }
 
 
@@ -658,7 +1038,7 @@ RefCntAutoPtr<PipelineResourceSignatureVkImpl> PipelineStateVkImpl::CreateDefaul
     return TPipelineStateBase::CreateDefaultSignature(Resources, pCombinedSamplerSuffix, pImmutableSamplers, GetActiveShaderStages(), bIsDeviceInternal);
 }
 
-void PipelineStateVkImpl::InitPipelineLayout(TShaderStages& ShaderStages)
+void PipelineStateVkImpl::InitPipelineLayout(TShaderStages& ShaderStages, bool RemapBindings)
 {
     if (m_UsingImplicitSignature)
     {
@@ -673,6 +1053,13 @@ void PipelineStateVkImpl::InitPipelineLayout(TShaderStages& ShaderStages)
 
     m_PipelineLayout.Create(GetDevice(), m_Signatures, m_SignatureCount);
 
+#ifndef DILIGENT_DEVELOPMENT
+    // Bindings in the byte code loaded from the PSO cache are already remapped.
+    // In development build, the resources are still verified below.
+    if (!RemapBindings)
+        return;
+#endif
+
     // Verify that pipeline layout is compatible with shader resources and
     // remap resource bindings.
     for (size_t s = 0; s < ShaderStages.size(); ++s)
@@ -739,8 +1126,11 @@ void PipelineStateVkImpl::InitPipelineLayout(TShaderStages& ShaderStages)
                     }
 
                     VERIFY_EXPR(ResourceBinding != ~0u && DescriptorSet != ~0u);
-                    SPIRV[SPIRVAttribs.BindingDecorationOffset]       = ResourceBinding;
-                    SPIRV[SPIRVAttribs.DescriptorSetDecorationOffset] = m_PipelineLayout.GetFirstDescrSetIndex(SignDesc.BindingIndex) + DescriptorSet;
+                    if (RemapBindings)
+                    {
+                        SPIRV[SPIRVAttribs.BindingDecorationOffset]       = ResourceBinding;
+                        SPIRV[SPIRVAttribs.DescriptorSetDecorationOffset] = m_PipelineLayout.GetFirstDescrSetIndex(SignDesc.BindingIndex) + DescriptorSet;
+                    }
 
 #ifdef DILIGENT_DEVELOPMENT
                     m_ResourceAttibutions.emplace_back(ResAttribution);
@@ -751,44 +1141,97 @@ void PipelineStateVkImpl::InitPipelineLayout(TShaderStages& ShaderStages)
 }
 
 template <typename PSOCreateInfoType>
-PipelineStateVkImpl::TShaderStages PipelineStateVkImpl::InitInternalObjects(
-    const PSOCreateInfoType&                           CreateInfo,
-    std::vector<VkPipelineShaderStageCreateInfo>&      vkShaderStages,
-    std::vector<VulkanUtilities::ShaderModuleWrapper>& ShaderModules) noexcept(false)
+PipelineStateVkImpl::TShaderStages PipelineStateVkImpl::InitInternalObjects(const PSOCreateInfoType&  CreateInfo,
+                                                                            PipelineStateCacheVkImpl* pPSOCache,
+                                                                            ContentHash&              PSOCacheKey,
+                                                                            bool&                     IsCachedByteCode) noexcept(false)
 {
     TShaderStages ShaderStages;
     ExtractShaders<ShaderVkImpl>(CreateInfo, ShaderStages);
 
+    // Pipeline layout is initialized from the shader resources, so shaders that
+    // are compiled asynchronously must be ready.
+    for (const auto& Stage : ShaderStages)
+    {
+        for (const auto* pShader : Stage.Shaders)
+        {
+            pShader->WaitForAsyncCompileTask();
+            if (!pShader->IsReady())
+                LOG_ERROR_AND_THROW("Shader '", pShader->GetDesc().Name, "' has failed to compile");
+        }
+    }
+
     FixedLinearAllocator MemPool{GetRawAllocator()};
 
     ReserveSpaceForPipelineDesc(CreateInfo, MemPool);
 
     MemPool.Reserve();
 
-    const auto& LogicalDevice = GetDevice()->GetLogicalDevice();
-
     InitializePipelineDesc(CreateInfo, MemPool);
 
-    InitPipelineLayout(ShaderStages);
+    IsCachedByteCode = false;
+    if (pPSOCache != nullptr)
+    {
+        ContentHasher Hasher;
+        HashPipelineStateCreateInfo(Hasher, CreateInfo, ShaderStages);
+        PSOCacheKey = Hasher.Get();
 
-    // Create shader modules and initialize shader stages
-    InitPipelineShaderStages(LogicalDevice, ShaderStages, ShaderModules, vkShaderStages);
+        // On a hit, the byte code with remapped bindings and stripped reflection is used as is
+        IsCachedByteCode = LoadPipelineByteCode(pPSOCache->GetStorage(), PSOCacheKey, ShaderStages);
+    }
+
+    InitPipelineLayout(ShaderStages, !IsCachedByteCode);
 
     return ShaderStages;
 }
 
+template <typename PSOCreateInfoType, typename CreatePipelineHandlerType>
+void PipelineStateVkImpl::InitPipeline(const PSOCreateInfoType& CreateInfo, CreatePipelineHandlerType&& CreatePipelineHandler) noexcept(false)
+{
+    RefCntAutoPtr<PipelineStateCacheVkImpl> pPSOCache;
+    if (CreateInfo.pPSOCache != nullptr)
+        pPSOCache = ClassPtrCast<PipelineStateCacheVkImpl>(CreateInfo.pPSOCache);
+
+    ContentHash PSOCacheKey;
+    bool        IsCachedByteCode = false;
+    auto        ShaderStages     = InitInternalObjects(CreateInfo, pPSOCache.RawPtr(), PSOCacheKey, IsCachedByteCode);
+
+    // Shader modules and the pipeline may be created asynchronously, so keep
+    // strong references to the shaders and the cache until the task is complete.
+    std::vector<RefCntAutoPtr<IShader>> Shaders;
+    for (const auto& Stage : ShaderStages)
+    {
+        for (const auto* pShader : Stage.Shaders)
+            Shaders.emplace_back(const_cast<ShaderVkImpl*>(pShader));
+    }
+
+    // Constant values are copied as the create info is not available in the asynchronous task
+    auto SpecData = GetSpecializationData(CreateInfo, ShaderStages);
+
+    RunPipelineInitTask(
+        CreateInfo.Flags,
+        [this, ShaderStages = std::move(ShaderStages), SpecData = std::move(SpecData), Shaders = std::move(Shaders), pPSOCache, PSOCacheKey, IsCachedByteCode, CreatePipelineHandler]() mutable {
+            std::vector<VkPipelineShaderStageCreateInfo> vkShaderStages;
+            std::vector<ShaderModuleCache::ModulePtr>    ShaderModules;
+            std::vector<VkSpecializationInfo>            SpecInfos;
+
+            // Create shader modules and initialize shader stages
+            InitPipelineShaderStages(GetDevice(), ShaderStages, SpecData, ShaderModules, vkShaderStages, SpecInfos, pPSOCache.RawPtr(), PSOCacheKey, IsCachedByteCode);
+
+            const auto vkSPOCache = pPSOCache != nullptr ? pPSOCache->GetVkPipelineCache() : VK_NULL_HANDLE;
+            CreatePipelineHandler(vkShaderStages, vkSPOCache);
+        });
+}
+
 PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, RenderDeviceVkImpl* pDeviceVk, const GraphicsPipelineStateCreateInfo& CreateInfo) :
     TPipelineStateBase{pRefCounters, pDeviceVk, CreateInfo}
 {
     try
     {
-        std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
-        std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
-
-        InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
-
-        const auto vkSPOCache = CreateInfo.pPSOCache != nullptr ? ClassPtrCast<PipelineStateCacheVkImpl>(CreateInfo.pPSOCache)->GetVkPipelineCache() : VK_NULL_HANDLE;
-        CreateGraphicsPipeline(pDeviceVk, vkShaderStages, m_PipelineLayout, m_Desc, GetGraphicsPipelineDesc(), m_Pipeline, GetRenderPassPtr(), vkSPOCache);
+        InitPipeline(CreateInfo,
+                     [this](const std::vector<VkPipelineShaderStageCreateInfo>& vkShaderStages, VkPipelineCache vkSPOCache) {
+                         CreateGraphicsPipeline(GetDevice(), vkShaderStages, m_PipelineLayout, m_Desc, GetGraphicsPipelineDesc(), m_Pipeline, GetRenderPassPtr(), vkSPOCache);
+                     });
     }
     catch (...)
     {
@@ -802,13 +1245,10 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, Rende
 {
     try
     {
-        std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
-        std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
-
-        InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
-
-        const auto vkSPOCache = CreateInfo.pPSOCache != nullptr ? ClassPtrCast<PipelineStateCacheVkImpl>(CreateInfo.pPSOCache)->GetVkPipelineCache() : VK_NULL_HANDLE;
-        CreateComputePipeline(pDeviceVk, vkShaderStages, m_PipelineLayout, m_Desc, m_Pipeline, vkSPOCache);
+        InitPipeline(CreateInfo,
+                     [this](const std::vector<VkPipelineShaderStageCreateInfo>& vkShaderStages, VkPipelineCache vkSPOCache) {
+                         CreateComputePipeline(GetDevice(), vkShaderStages, m_PipelineLayout, m_Desc, m_Pipeline, vkSPOCache);
+                     });
     }
     catch (...)
     {
@@ -824,12 +1264,23 @@ PipelineStateVkImpl::PipelineStateVkImpl(IReferenceCounters* pRefCounters, Rende
     {
         const auto& LogicalDevice = pDeviceVk->GetLogicalDevice();
 
-        std::vector<VkPipelineShaderStageCreateInfo>      vkShaderStages;
-        std::vector<VulkanUtilities::ShaderModuleWrapper> ShaderModules;
+        // Shader group handles must be available right after the PSO is created,
+        // so ray tracing pipelines are always created synchronously.
+        auto* pPSOCache = CreateInfo.pPSOCache != nullptr ? ClassPtrCast<PipelineStateCacheVkImpl>(CreateInfo.pPSOCache) : nullptr;
+
+        ContentHash PSOCacheKey;
+        bool        IsCachedByteCode = false;
+        auto        ShaderStages     = InitInternalObjects(CreateInfo, pPSOCache, PSOCacheKey, IsCachedByteCode);
+
+        const auto SpecData = GetSpecializationData(CreateInfo, ShaderStages);
+
+        std::vector<VkPipelineShaderStageCreateInfo> vkShaderStages;
+        std::vector<ShaderModuleCache::ModulePtr>    ShaderModules;
+        std::vector<VkSpecializationInfo>            SpecInfos;
+        InitPipelineShaderStages(pDeviceVk, ShaderStages, SpecData, ShaderModules, vkShaderStages, SpecInfos, pPSOCache, PSOCacheKey, IsCachedByteCode);
 
-        const auto ShaderStages   = InitInternalObjects(CreateInfo, vkShaderStages, ShaderModules);
         const auto vkShaderGroups = BuildRTShaderGroupDescription(CreateInfo, m_pRayTracingPipelineData->NameToGroupIndex, ShaderStages);
-        const auto vkSPOCache     = CreateInfo.pPSOCache != nullptr ? ClassPtrCast<PipelineStateCacheVkImpl>(CreateInfo.pPSOCache)->GetVkPipelineCache() : VK_NULL_HANDLE;
+        const auto vkSPOCache     = pPSOCache != nullptr ? pPSOCache->GetVkPipelineCache() : VK_NULL_HANDLE;
 
         CreateRayTracingPipeline(pDeviceVk, vkShaderStages, vkShaderGroups, m_PipelineLayout, m_Desc, GetRayTracingPipelineDesc(), m_Pipeline, vkSPOCache);
 
@@ -854,6 +1305,9 @@ PipelineStateVkImpl::~PipelineStateVkImpl()
 
 void PipelineStateVkImpl::Destruct()
 {
+    // The pipeline may still be being compiled by the thread pool
+    WaitForAsyncInitTask();
+
     m_pDevice->SafeReleaseDeviceObject(std::move(m_Pipeline), m_Desc.ImmediateContextMask);
     m_PipelineLayout.Release(m_pDevice, m_Desc.ImmediateContextMask);
 
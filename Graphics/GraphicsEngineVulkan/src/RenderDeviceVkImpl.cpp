@@ -80,6 +80,7 @@ RenderDeviceVkImpl::RenderDeviceVkImpl(IReferenceCounters*
     m_LogicalVkDevice        {std::move(LogicalDevice) },
     m_FramebufferCache       {*this                    },
     m_ImplicitRenderPassCache{*this                    },
+    m_ShaderModuleCache      {EngineCI.ShaderModuleCacheSize},
     m_DescriptorSetAllocator
     {
         *this,
@@ -444,6 +445,58 @@ void RenderDeviceVkImpl::ReleaseStaleResources(bool ForceRelease)
     PurgeReleaseQueues(ForceRelease);
 }
 
+void RenderDeviceVkImpl::GetMemoryStatistics(Uint32& NumMemoryTypes, DeviceMemoryStatsVk* pStats)
+{
+    const auto MemTypeStats = m_MemoryMgr.GetMemoryTypeStats();
+    if (pStats == nullptr)
+    {
+        NumMemoryTypes = static_cast<Uint32>(MemTypeStats.size());
+        return;
+    }
+
+    NumMemoryTypes = std::min(NumMemoryTypes, static_cast<Uint32>(MemTypeStats.size()));
+    for (Uint32 i = 0; i < NumMemoryTypes; ++i)
+    {
+        const auto& Src = MemTypeStats[i];
+        auto&       Dst = pStats[i];
+
+        Dst.MemoryTypeIndex  = Src.MemoryTypeIndex;
+        Dst.IsHostVisible    = Src.IsHostVisible;
+        Dst.NumPages         = Src.NumPages;
+        Dst.NumEmptyPages    = Src.NumEmptyPages;
+        Dst.AllocatedSize    = Src.AllocatedSize;
+        Dst.UsedSize         = Src.UsedSize;
+        Dst.MaxFreeBlockSize = Src.MaxFreeBlockSize;
+        Dst.NumFreeBlocks    = Src.NumFreeBlocks;
+        Dst.Fragmentation    = Src.Fragmentation;
+    }
+}
+
+void RenderDeviceVkImpl::RegisterRelocatableResource(BufferVkImpl* pBuffer)
+{
+    std::lock_guard<std::mutex> Lock{m_RelocatableResourcesMtx};
+    m_RelocatableBuffers.insert(pBuffer);
+}
+
+void RenderDeviceVkImpl::RegisterRelocatableResource(TextureVkImpl* pTexture)
+{
+    std::lock_guard<std::mutex> Lock{m_RelocatableResourcesMtx};
+    m_RelocatableTextures.insert(pTexture);
+}
+
+void RenderDeviceVkImpl::UnregisterRelocatableResource(BufferVkImpl* pBuffer)
+{
+    // Blocks until the defragmentation pass that may be moving the buffer is complete
+    std::lock_guard<std::mutex> Lock{m_RelocatableResourcesMtx};
+    m_RelocatableBuffers.erase(pBuffer);
+}
+
+void RenderDeviceVkImpl::UnregisterRelocatableResource(TextureVkImpl* pTexture)
+{
+    std::lock_guard<std::mutex> Lock{m_RelocatableResourcesMtx};
+    m_RelocatableTextures.erase(pTexture);
+}
+
 
 void RenderDeviceVkImpl::TestTextureFormat(TEXTURE_FORMAT TexFormat)
 {
@@ -580,6 +633,14 @@ void RenderDeviceVkImpl::CreateBufferFromVulkanResource(VkBuffer vkBuffer, const
 void RenderDeviceVkImpl::CreateBuffer(const BufferDesc& BuffDesc, const BufferData* pBuffData, IBuffer** ppBuffer)
 {
     CreateBufferImpl(ppBuffer, BuffDesc, pBuffData);
+
+    // Register the buffer only when it is fully constructed
+    if (*ppBuffer != nullptr)
+    {
+        auto* pBufferVk = ClassPtrCast<BufferVkImpl>(*ppBuffer);
+        if (pBufferVk->IsRelocatable())
+            RegisterRelocatableResource(pBufferVk);
+    }
 }
 
 
@@ -611,6 +672,14 @@ void RenderDeviceVkImpl::CreateTexture(const TextureDesc& TexDesc, VkImage vkImg
 void RenderDeviceVkImpl::CreateTexture(const TextureDesc& TexDesc, const TextureData* pData, ITexture** ppTexture)
 {
     CreateTextureImpl(ppTexture, TexDesc, pData);
+
+    // Register the texture only when its default views have been created
+    if (*ppTexture != nullptr)
+    {
+        auto* pTextureVk = ClassPtrCast<TextureVkImpl>(*ppTexture);
+        if (pTextureVk->IsRelocatable())
+            RegisterRelocatableResource(pTextureVk);
+    }
 }
 
 void RenderDeviceVkImpl::CreateSampler(const SamplerDesc& SamplerDesc, ISampler** ppSampler)
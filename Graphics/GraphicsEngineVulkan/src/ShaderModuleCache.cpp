@@ -0,0 +1,93 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "ShaderModuleCache.hpp"
+
+namespace Diligent
+{
+
+ShaderModuleCache::ModulePtr ShaderModuleCache::Find(const ContentHash& Key)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    auto it = m_Cache.find(Key);
+    if (it == m_Cache.end())
+    {
+        ++m_NumMisses;
+        return {};
+    }
+
+    ++m_NumHits;
+    // Move the module to the front of the LRU list
+    m_LRUList.splice(m_LRUList.begin(), m_LRUList, it->second.LRUPos);
+    return it->second.pModule;
+}
+
+ShaderModuleCache::ModulePtr ShaderModuleCache::Add(const ContentHash& Key, VulkanUtilities::ShaderModuleWrapper&& Module)
+{
+    auto pModule = std::make_shared<VulkanUtilities::ShaderModuleWrapper>(std::move(Module));
+    if (m_MaxModules == 0)
+        return pModule;
+
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    auto it = m_Cache.find(Key);
+    if (it != m_Cache.end())
+    {
+        // The same module was created by another thread
+        m_LRUList.splice(m_LRUList.begin(), m_LRUList, it->second.LRUPos);
+        return it->second.pModule;
+    }
+
+    m_LRUList.push_front(Key);
+    m_Cache.emplace(Key, CacheEntry{pModule, m_LRUList.begin()});
+
+    while (m_Cache.size() > m_MaxModules)
+    {
+        // Pipelines that are being created keep their own references to the module
+        m_Cache.erase(m_LRUList.back());
+        m_LRUList.pop_back();
+        ++m_NumEvictions;
+    }
+
+    return pModule;
+}
+
+ShaderModuleCacheStats ShaderModuleCache::GetStats() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+
+    ShaderModuleCacheStats Stats;
+    Stats.NumModules   = static_cast<Uint32>(m_Cache.size());
+    Stats.NumHits      = m_NumHits;
+    Stats.NumMisses    = m_NumMisses;
+    Stats.NumEvictions = m_NumEvictions;
+    return Stats;
+}
+
+} // namespace Diligent
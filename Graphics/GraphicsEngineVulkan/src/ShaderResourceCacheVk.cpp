@@ -288,11 +288,9 @@ void ShaderResourceCacheVk::Resource::SetStorageBuffer(RefCntAutoPtr<IDeviceObje
 #endif
 }
 
-const ShaderResourceCacheVk::Resource& ShaderResourceCacheVk::SetResource(
-    const VulkanUtilities::VulkanLogicalDevice* pLogicalDevice,
-    Uint32                                      DescrSetIndex,
-    Uint32                                      CacheOffset,
-    SetResourceInfo&&                           SrcRes)
+const ShaderResourceCacheVk::Resource& ShaderResourceCacheVk::SetResource(Uint32            DescrSetIndex,
+                                                                          Uint32            CacheOffset,
+                                                                          SetResourceInfo&& SrcRes)
 {
     auto& DescrSet = GetDescriptorSet(DescrSetIndex);
     auto& DstRes   = DescrSet.GetResource(CacheOffset);
@@ -328,86 +326,12 @@ const ShaderResourceCacheVk::Resource& ShaderResourceCacheVk::SetResource(
         ++m_NumDynamicBuffers;
     }
 
-    auto vkSet = DescrSet.GetVkDescriptorSet();
-    if (vkSet != VK_NULL_HANDLE && DstRes.pObject)
+    if (DstRes.pObject && DescrSet.GetVkDescriptorSet() != VK_NULL_HANDLE)
     {
-        VERIFY(pLogicalDevice != nullptr, "Logical device must not be null to write descriptor to a non-null set");
-
-        VkWriteDescriptorSet WriteDescrSet;
-        WriteDescrSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        WriteDescrSet.pNext           = nullptr;
-        WriteDescrSet.dstSet          = vkSet;
-        WriteDescrSet.dstBinding      = SrcRes.BindingIndex;
-        WriteDescrSet.dstArrayElement = SrcRes.ArrayIndex;
-        WriteDescrSet.descriptorCount = 1;
-        // descriptorType must be the same type as that specified in VkDescriptorSetLayoutBinding for dstSet at dstBinding.
-        // The type of the descriptor also controls which array the descriptors are taken from. (13.2.4)
-        WriteDescrSet.descriptorType   = DescriptorTypeToVkDescriptorType(DstRes.Type);
-        WriteDescrSet.pImageInfo       = nullptr;
-        WriteDescrSet.pBufferInfo      = nullptr;
-        WriteDescrSet.pTexelBufferView = nullptr;
-
-        // Do not zero-initialize!
-        union
-        {
-            VkDescriptorImageInfo                        vkDescrImageInfo;
-            VkDescriptorBufferInfo                       vkDescrBufferInfo;
-            VkBufferView                                 vkDescrBufferView;
-            VkWriteDescriptorSetAccelerationStructureKHR vkDescrAccelStructInfo;
-        };
-
-        static_assert(static_cast<Uint32>(DescriptorType::Count) == 16, "Please update the switch below to handle the new descriptor type");
-        switch (DstRes.Type)
-        {
-            case DescriptorType::Sampler:
-                vkDescrImageInfo         = DstRes.GetSamplerDescriptorWriteInfo();
-                WriteDescrSet.pImageInfo = &vkDescrImageInfo;
-                break;
-
-            case DescriptorType::CombinedImageSampler:
-            case DescriptorType::SeparateImage:
-            case DescriptorType::StorageImage:
-                vkDescrImageInfo         = DstRes.GetImageDescriptorWriteInfo();
-                WriteDescrSet.pImageInfo = &vkDescrImageInfo;
-                break;
-
-            case DescriptorType::UniformTexelBuffer:
-            case DescriptorType::StorageTexelBuffer:
-            case DescriptorType::StorageTexelBuffer_ReadOnly:
-                vkDescrBufferView              = DstRes.GetBufferViewWriteInfo();
-                WriteDescrSet.pTexelBufferView = &vkDescrBufferView;
-                break;
-
-            case DescriptorType::UniformBuffer:
-            case DescriptorType::UniformBufferDynamic:
-                vkDescrBufferInfo         = DstRes.GetUniformBufferDescriptorWriteInfo();
-                WriteDescrSet.pBufferInfo = &vkDescrBufferInfo;
-                break;
-
-            case DescriptorType::StorageBuffer:
-            case DescriptorType::StorageBuffer_ReadOnly:
-            case DescriptorType::StorageBufferDynamic:
-            case DescriptorType::StorageBufferDynamic_ReadOnly:
-                vkDescrBufferInfo         = DstRes.GetStorageBufferDescriptorWriteInfo();
-                WriteDescrSet.pBufferInfo = &vkDescrBufferInfo;
-                break;
-
-            case DescriptorType::InputAttachment:
-            case DescriptorType::InputAttachment_General:
-                vkDescrImageInfo         = DstRes.GetInputAttachmentDescriptorWriteInfo();
-                WriteDescrSet.pImageInfo = &vkDescrImageInfo;
-                break;
-
-            case DescriptorType::AccelerationStructure:
-                vkDescrAccelStructInfo = DstRes.GetAccelerationStructureWriteInfo();
-                WriteDescrSet.pNext    = &vkDescrAccelStructInfo;
-                break;
-
-            default:
-                UNEXPECTED("Unexpected descriptor type");
-        }
-
-        pLogicalDevice->UpdateDescriptorSets(1, &WriteDescrSet, 0, nullptr);
+        // Descriptors are written when the cache is committed, so that all resources
+        // bound since the last commit are written at once. The flag is set after the
+        // resource has been stored, so a commit that clears it will see the resource.
+        m_DescriptorWritesPending.store(true);
     }
 
     UpdateRevision();
@@ -398,12 +398,9 @@ bool BindResourceHelper::UpdateCachedResource(RefCntAutoPtr<ObjectType>&& pObjec
             return false;
         }
 
-        m_ResourceCache.SetResource(&m_Signature.GetDevice()->GetLogicalDevice(),
-                                    m_Attribs.DescrSet,
+        m_ResourceCache.SetResource(m_Attribs.DescrSet,
                                     m_DstResCacheOffset,
                                     {
-                                        m_Attribs.BindingIndex,
-                                        m_ArrayIndex,
                                         std::move(pObject),
                                         BufferBaseOffset,
                                         BufferRangeSize //
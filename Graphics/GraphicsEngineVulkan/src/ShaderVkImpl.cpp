@@ -31,8 +31,10 @@
 
 #include <array>
 #include <cctype>
+#include <memory>
 
 #include "RenderDeviceVkImpl.hpp"
+#include "PipelineStateCacheVkImpl.hpp"
 #include "DataBlobImpl.hpp"
 #include "GLSLUtils.hpp"
 #include "DXCompiler.hpp"
@@ -45,6 +47,282 @@
 namespace Diligent
 {
 
+namespace
+{
+
+// Header of the shader entry in the pipeline state cache:
+//
+//     | Header | SPIRV | Reflection data | Dependencies |
+//
+// Every dependency is stored as | Hash Lo | Hash Hi | Name length | Name |.
+struct ShaderCacheEntryHeader
+{
+    Uint32 SPIRVSize;
+    Uint32 ReflectionDataSize;
+    Uint32 NumDependencies;
+    Uint32 Padding;
+};
+static_assert(sizeof(ShaderCacheEntryHeader) == 16, "Unexpected sizeof(ShaderCacheEntryHeader)");
+
+ContentHash ComputeShaderCacheKey(const ShaderCreateInfo& ShaderCI, SHADER_COMPILER ShaderCompiler, RenderDeviceVkImpl* pDeviceVk)
+{
+    ContentHasher Hasher;
+    // Separates shader entries from pipeline entries
+    Hasher.Update("ShaderVk");
+
+    Hasher.Update(ShaderCI.Desc.ShaderType);
+    Hasher.Update(ShaderCI.SourceLanguage);
+    Hasher.Update(ShaderCompiler);
+    if (ShaderCompiler == SHADER_COMPILER_DXC)
+    {
+        Uint32 MajorVersion = 0, MinorVersion = 0;
+        pDeviceVk->GetDxCompiler()->GetVersion(MajorVersion, MinorVersion);
+        Hasher.Update(MajorVersion);
+        Hasher.Update(MinorVersion);
+    }
+    Hasher.Update(ShaderCI.EntryPoint);
+    for (const auto* pMacro = ShaderCI.Macros; pMacro != nullptr && pMacro->Name != nullptr; ++pMacro)
+    {
+        Hasher.Update(pMacro->Name);
+        Hasher.Update(pMacro->Definition);
+    }
+    Hasher.Update(ShaderCI.UseCombinedTextureSamplers);
+    if (ShaderCI.UseCombinedTextureSamplers)
+        Hasher.Update(ShaderCI.CombinedSamplerSuffix);
+    for (const auto& Ver : {ShaderCI.HLSLVersion, ShaderCI.GLSLVersion, ShaderCI.GLESSLVersion})
+    {
+        Hasher.Update(Ver.Major);
+        Hasher.Update(Ver.Minor);
+    }
+    // Asynchronous compilation does not affect the result
+    Hasher.Update(ShaderCI.CompileFlags & ~SHADER_COMPILE_FLAG_ASYNCHRONOUS);
+
+    if (ShaderCI.Source != nullptr)
+    {
+        const auto SourceLength = ShaderCI.SourceLength != 0 ? ShaderCI.SourceLength : strlen(ShaderCI.Source);
+        Hasher.Update(Uint64{SourceLength});
+        Hasher.UpdateRaw(ShaderCI.Source, SourceLength);
+    }
+    else
+    {
+        // The file contents are verified through the recorded dependencies
+        Hasher.Update(ShaderCI.FilePath);
+    }
+
+    // Target SPIRV version depends on the device
+    Hasher.Update(pDeviceVk->GetVkVersion());
+    Hasher.Update(pDeviceVk->GetLogicalDevice().GetEnabledExtFeatures().Spirv14);
+
+    return Hasher.Get();
+}
+
+// Loads the byte code and the reflection data from the cache entry after
+// checking that none of the source files have been modified. The reflection
+// data reference the entry blob, which is returned in pEntryData.
+bool LoadShaderFromCache(const PipelineStateCacheStorage& Storage,
+                         const ContentHash&               Key,
+                         IShaderSourceInputStreamFactory* pShaderSourceStreamFactory,
+                         std::vector<uint32_t>&           SPIRV,
+                         RefCntAutoPtr<IDataBlob>&        pEntryData,
+                         const void*&                     pReflectionData,
+                         size_t&                          ReflectionDataSize)
+{
+    auto pData = Storage.Find(Key);
+    if (!pData)
+        return false;
+
+    // The entry references the cache data and is not copied
+    const auto* const pBytes   = static_cast<const Uint8*>(pData->GetConstDataPtr());
+    const size_t      DataSize = pData->GetSize();
+
+    ShaderCacheEntryHeader Header{};
+    if (DataSize < sizeof(Header))
+        return false;
+    memcpy(&Header, pBytes, sizeof(Header));
+
+    size_t Offset = sizeof(Header);
+    if (Header.SPIRVSize == 0 || Header.SPIRVSize % sizeof(uint32_t) != 0 ||
+        Header.SPIRVSize > DataSize - Offset ||
+        Header.ReflectionDataSize > DataSize - Offset - Header.SPIRVSize)
+        return false;
+
+    const auto* pSPIRV = pBytes + Offset;
+    Offset += Header.SPIRVSize;
+    const auto* pReflection = pBytes + Offset;
+    Offset += Header.ReflectionDataSize;
+
+    for (Uint32 i = 0; i < Header.NumDependencies; ++i)
+    {
+        ContentHash Hash;
+        Uint32      NameLen = 0;
+        if (DataSize - Offset < sizeof(Hash.Lo) + sizeof(Hash.Hi) + sizeof(NameLen))
+            return false;
+        memcpy(&Hash.Lo, pBytes + Offset, sizeof(Hash.Lo));
+        Offset += sizeof(Hash.Lo);
+        memcpy(&Hash.Hi, pBytes + Offset, sizeof(Hash.Hi));
+        Offset += sizeof(Hash.Hi);
+        memcpy(&NameLen, pBytes + Offset, sizeof(NameLen));
+        Offset += sizeof(NameLen);
+        if (NameLen > DataSize - Offset)
+            return false;
+
+        const std::string Name{reinterpret_cast<const char*>(pBytes + Offset), NameLen};
+        Offset += NameLen;
+
+        ContentHash FileHash;
+        if (!ComputeShaderSourceFileHash(pShaderSourceStreamFactory, Name.c_str(), FileHash) || FileHash != Hash)
+            return false;
+    }
+
+    // The byte code is modified when vertex shader inputs are mapped, so it is copied
+    SPIRV.resize(Header.SPIRVSize / sizeof(uint32_t));
+    memcpy(SPIRV.data(), pSPIRV, Header.SPIRVSize);
+
+    pReflectionData    = pReflection;
+    ReflectionDataSize = Header.ReflectionDataSize;
+    pEntryData         = std::move(pData);
+    return true;
+}
+
+void StoreShaderInCache(PipelineStateCacheStorage&                                     Storage,
+                        const ContentHash&                                             Key,
+                        const std::vector<uint32_t>&                                   SPIRV,
+                        const std::vector<Uint8>&                                      ReflectionData,
+                        const std::vector<ShaderSourceDependencyRecorder::Dependency>& Dependencies)
+{
+    ShaderCacheEntryHeader Header{};
+    Header.SPIRVSize          = static_cast<Uint32>(SPIRV.size() * sizeof(uint32_t));
+    Header.ReflectionDataSize = static_cast<Uint32>(ReflectionData.size());
+    Header.NumDependencies    = static_cast<Uint32>(Dependencies.size());
+
+    std::vector<Uint8> Data;
+    auto               Append = [&Data](const void* pData, size_t Size) {
+        const auto* pBytes = static_cast<const Uint8*>(pData);
+        Data.insert(Data.end(), pBytes, pBytes + Size);
+    };
+    Append(&Header, sizeof(Header));
+    Append(SPIRV.data(), Header.SPIRVSize);
+    Append(ReflectionData.data(), ReflectionData.size());
+    for (const auto& Dep : Dependencies)
+    {
+        const auto NameLen = static_cast<Uint32>(Dep.Name.length());
+        Append(&Dep.Hash.Lo, sizeof(Dep.Hash.Lo));
+        Append(&Dep.Hash.Hi, sizeof(Dep.Hash.Hi));
+        Append(&NameLen, sizeof(NameLen));
+        Append(Dep.Name.data(), NameLen);
+    }
+
+    Storage.Store(Key, Data.data(), Data.size());
+}
+
+// Copy of the shader create info that owns all data it references.
+// Asynchronous compilation task uses the copy after the original struct is gone.
+class ShaderCreateInfoCopy
+{
+public:
+    ShaderCreateInfoCopy(const ShaderCreateInfo& ShaderCI, const char* Name) :
+        m_CI{ShaderCI},
+        m_pShaderSourceStreamFactory{ShaderCI.pShaderSourceStreamFactory},
+        m_pPSOCache{ShaderCI.pPSOCache}
+    {
+        m_CI.Desc.Name = Name;
+        // Compiler output can't be returned to the caller
+        m_CI.ppCompilerOutput   = nullptr;
+        m_CI.ppConversionStream = nullptr;
+
+        if (ShaderCI.FilePath != nullptr)
+        {
+            m_FilePath    = ShaderCI.FilePath;
+            m_CI.FilePath = m_FilePath.c_str();
+        }
+
+        if (ShaderCI.Source != nullptr)
+        {
+            m_Source.assign(ShaderCI.Source, ShaderCI.SourceLength != 0 ? ShaderCI.SourceLength : strlen(ShaderCI.Source));
+            m_CI.Source       = m_Source.c_str();
+            m_CI.SourceLength = m_Source.length();
+        }
+        else if (ShaderCI.ByteCode != nullptr)
+        {
+            const auto* pByteCode = static_cast<const Uint8*>(ShaderCI.ByteCode);
+            m_ByteCode.assign(pByteCode, pByteCode + ShaderCI.ByteCodeSize);
+            m_CI.ByteCode = m_ByteCode.data();
+
+            if (ShaderCI.pReflectionData != nullptr)
+            {
+                const auto* pReflectionData = static_cast<const Uint8*>(ShaderCI.pReflectionData);
+                m_ReflectionData.assign(pReflectionData, pReflectionData + ShaderCI.ReflectionDataSize);
+                m_CI.pReflectionData = m_ReflectionData.data();
+            }
+        }
+
+        if (ShaderCI.EntryPoint != nullptr)
+        {
+            m_EntryPoint    = ShaderCI.EntryPoint;
+            m_CI.EntryPoint = m_EntryPoint.c_str();
+        }
+
+        if (ShaderCI.CombinedSamplerSuffix != nullptr)
+        {
+            m_CombinedSamplerSuffix    = ShaderCI.CombinedSamplerSuffix;
+            m_CI.CombinedSamplerSuffix = m_CombinedSamplerSuffix.c_str();
+        }
+
+        if (ShaderCI.Macros != nullptr)
+        {
+            size_t NumMacros = 0;
+            while (ShaderCI.Macros[NumMacros].Name != nullptr)
+                ++NumMacros;
+
+            // The strings must not be reallocated after the macros are initialized
+            m_MacroStrings.reserve(NumMacros * 2);
+            for (size_t i = 0; i < NumMacros; ++i)
+            {
+                const auto& Macro = ShaderCI.Macros[i];
+                m_MacroStrings.emplace_back(Macro.Name);
+                const auto* Name = m_MacroStrings.back().c_str();
+
+                const char* Definition = nullptr;
+                if (Macro.Definition != nullptr)
+                {
+                    m_MacroStrings.emplace_back(Macro.Definition);
+                    Definition = m_MacroStrings.back().c_str();
+                }
+                m_Macros.emplace_back(Name, Definition);
+            }
+            // Null-terminate the array
+            m_Macros.emplace_back();
+            m_CI.Macros = m_Macros.data();
+        }
+    }
+
+    // clang-format off
+    ShaderCreateInfoCopy           (const ShaderCreateInfoCopy&)  = delete;
+    ShaderCreateInfoCopy           (      ShaderCreateInfoCopy&&) = delete;
+    ShaderCreateInfoCopy& operator=(const ShaderCreateInfoCopy&)  = delete;
+    ShaderCreateInfoCopy& operator=(      ShaderCreateInfoCopy&&) = delete;
+    // clang-format on
+
+    const ShaderCreateInfo& Get() const { return m_CI; }
+
+private:
+    ShaderCreateInfo m_CI;
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> m_pShaderSourceStreamFactory;
+    RefCntAutoPtr<IPipelineStateCache>             m_pPSOCache;
+
+    std::string              m_FilePath;
+    std::string              m_Source;
+    std::string              m_EntryPoint;
+    std::string              m_CombinedSamplerSuffix;
+    std::vector<std::string> m_MacroStrings;
+    std::vector<ShaderMacro> m_Macros;
+    std::vector<Uint8>       m_ByteCode;
+    std::vector<Uint8>       m_ReflectionData;
+};
+
+} // namespace
+
 ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
                            RenderDeviceVkImpl*     pRenderDeviceVk,
                            const ShaderCreateInfo& ShaderCI) :
@@ -57,21 +335,43 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
     }
 // clang-format on
 {
+    if (ShaderCI.Source == nullptr && ShaderCI.FilePath == nullptr && ShaderCI.ByteCode == nullptr)
+    {
+        LOG_ERROR_AND_THROW("Shader source must be provided through one of the 'Source', 'FilePath' or 'ByteCode' members");
+    }
+
+    if (IsAsyncCompilationEnabled(ShaderCI.CompileFlags))
+    {
+        // The data referenced by the create info are only valid during this call
+        auto pCICopy = std::make_shared<const ShaderCreateInfoCopy>(ShaderCI, m_Desc.Name);
+        RunAsyncCompileTask([this, pCICopy]() {
+            Initialize(pCICopy->Get());
+        });
+    }
+    else
+    {
+        Initialize(ShaderCI);
+    }
+}
+
+void ShaderVkImpl::Initialize(const ShaderCreateInfo& ShaderCI) noexcept(false)
+{
+    auto* const pRenderDeviceVk = GetDevice();
+
+    const void* pReflectionData    = ShaderCI.ByteCode != nullptr ? ShaderCI.pReflectionData : nullptr;
+    size_t      ReflectionDataSize = ShaderCI.ByteCode != nullptr ? ShaderCI.ReflectionDataSize : 0;
+
+    auto* const pPSOCache = ShaderCI.pPSOCache != nullptr ? ClassPtrCast<PipelineStateCacheVkImpl>(ShaderCI.pPSOCache) : nullptr;
+
+    ContentHash                                   CacheKey;
+    bool                                          StoreInCache = false;
+    RefCntAutoPtr<ShaderSourceDependencyRecorder> pDependencyRecorder;
+    RefCntAutoPtr<IDataBlob>                      pCacheEntryData;
+
     if (ShaderCI.Source != nullptr || ShaderCI.FilePath != nullptr)
     {
         DEV_CHECK_ERR(ShaderCI.ByteCode == nullptr, "'ByteCode' must be null when shader is created from source code or a file");
 
-        static constexpr char VulkanDefine[] =
-            "#ifndef VULKAN\n"
-            "#   define VULKAN 1\n"
-            "#endif\n"
-#if PLATFORM_MACOS || PLATFORM_IOS || PLATFORM_TVOS
-            "#ifndef METAL\n"
-            "#   define METAL 1\n"
-            "#endif\n"
-#endif
-            ;
-
         auto ShaderCompiler = ShaderCI.ShaderCompiler;
         if (ShaderCompiler == SHADER_COMPILER_DXC)
         {
@@ -83,79 +383,30 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
             }
         }
 
-        switch (ShaderCompiler)
+        bool LoadedFromCache = false;
+        if (pPSOCache != nullptr)
         {
-            case SHADER_COMPILER_DXC:
-            {
-                auto* pDXCompiler = pRenderDeviceVk->GetDxCompiler();
-                VERIFY_EXPR(pDXCompiler != nullptr && pDXCompiler->IsLoaded());
-                pDXCompiler->Compile(ShaderCI, ShaderVersion{}, VulkanDefine, nullptr, &m_SPIRV, ShaderCI.ppCompilerOutput);
-            }
-            break;
+            CacheKey = ComputeShaderCacheKey(ShaderCI, ShaderCompiler, pRenderDeviceVk);
+            // The reflection data are validated against the byte code below
+            LoadedFromCache = LoadShaderFromCache(pPSOCache->GetStorage(), CacheKey, ShaderCI.pShaderSourceStreamFactory,
+                                                  m_SPIRV, pCacheEntryData, pReflectionData, ReflectionDataSize);
+        }
 
-            case SHADER_COMPILER_DEFAULT:
-            case SHADER_COMPILER_GLSLANG:
+        if (!LoadedFromCache && pPSOCache != nullptr)
+        {
+            // Record all files read by the compiler to validate the cache entry when it is loaded
+            ShaderCreateInfo CompileCI = ShaderCI;
+            if (ShaderCI.pShaderSourceStreamFactory != nullptr)
             {
-#if DILIGENT_NO_GLSLANG
-                LOG_ERROR_AND_THROW("Diligent engine was not linked with glslang, use DXC or precompiled SPIRV bytecode.");
-#else
-                if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_HLSL)
-                {
-                    m_SPIRV = GLSLangUtils::HLSLtoSPIRV(ShaderCI, VulkanDefine, ShaderCI.ppCompilerOutput);
-                }
-                else
-                {
-                    std::string              GLSLSourceString;
-                    RefCntAutoPtr<IDataBlob> pSourceFileData;
-
-                    const char*        ShaderSource = nullptr;
-                    size_t             SourceLength = ShaderCI.SourceLength;
-                    const ShaderMacro* Macros       = nullptr;
-                    if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_GLSL_VERBATIM)
-                    {
-                        // Read the source file directly and use it as is
-                        ShaderSource = ReadShaderSourceFile(ShaderCI.Source, ShaderCI.pShaderSourceStreamFactory, ShaderCI.FilePath, pSourceFileData, SourceLength);
-
-                        // Add user macros.
-                        // BuildGLSLSourceString adds the macros to the source string, so we don't need to do this for SHADER_SOURCE_LANGUAGE_GLSL
-                        Macros = ShaderCI.Macros;
-                    }
-                    else
-                    {
-                        // Build the full source code string that will contain GLSL version declaration,
-                        // platform definitions, user-provided shader macros, etc.
-                        GLSLSourceString = BuildGLSLSourceString(ShaderCI, pRenderDeviceVk->GetDeviceInfo(), pRenderDeviceVk->GetAdapterInfo(),
-                                                                 TargetGLSLCompiler::glslang, VulkanDefine);
-                        ShaderSource     = GLSLSourceString.c_str();
-                        SourceLength     = GLSLSourceString.length();
-                    }
-
-                    const auto& ExtFeats  = GetDevice()->GetLogicalDevice().GetEnabledExtFeatures();
-                    const auto  VkVersion = GetDevice()->GetVkVersion();
-
-                    GLSLangUtils::GLSLtoSPIRVAttribs Attribs;
-                    Attribs.ShaderType                 = m_Desc.ShaderType;
-                    Attribs.ShaderSource               = ShaderSource;
-                    Attribs.SourceCodeLen              = static_cast<int>(SourceLength);
-                    Attribs.Version                    = GLSLangUtils::SpirvVersion::Vk100;
-                    Attribs.Macros                     = Macros;
-                    Attribs.AssignBindings             = true;
-                    Attribs.pShaderSourceStreamFactory = ShaderCI.pShaderSourceStreamFactory;
-                    Attribs.ppCompilerOutput           = ShaderCI.ppCompilerOutput;
-
-                    if (VkVersion >= VK_API_VERSION_1_2)
-                        Attribs.Version = GLSLangUtils::SpirvVersion::Vk120;
-                    else if (VkVersion >= VK_API_VERSION_1_1)
-                        Attribs.Version = ExtFeats.Spirv14 ? GLSLangUtils::SpirvVersion::Vk110_Spirv14 : GLSLangUtils::SpirvVersion::Vk110;
-
-                    m_SPIRV = GLSLangUtils::GLSLtoSPIRV(Attribs);
-                }
-#endif
-                break;
+                pDependencyRecorder                  = MakeNewRCObj<ShaderSourceDependencyRecorder>()(ShaderCI.pShaderSourceStreamFactory);
+                CompileCI.pShaderSourceStreamFactory = pDependencyRecorder;
             }
-
-            default:
-                LOG_ERROR_AND_THROW("Unsupported shader compiler");
+            CompileShader(CompileCI, ShaderCompiler);
+            StoreInCache = !m_SPIRV.empty();
+        }
+        else if (!LoadedFromCache)
+        {
+            CompileShader(ShaderCI, ShaderCompiler);
         }
 
         if (m_SPIRV.empty())
@@ -172,31 +423,160 @@ ShaderVkImpl::ShaderVkImpl(IReferenceCounters*     pRefCounters,
     }
     else
     {
-        LOG_ERROR_AND_THROW("Shader source must be provided through one of the 'Source', 'FilePath' or 'ByteCode' members");
+        UNEXPECTED("Shader source must be provided through one of the 'Source', 'FilePath' or 'ByteCode' members");
     }
 
     // We cannot create shader module here because resource bindings are assigned when
     // pipeline state is created
 
     // Load shader resources
-    auto& Allocator        = GetRawAllocator();
-    auto* pRawMem          = ALLOCATE(Allocator, "Allocator for ShaderResources", SPIRVShaderResources, 1);
-    auto  LoadShaderInputs = m_Desc.ShaderType == SHADER_TYPE_VERTEX;
-    auto* pResources       = new (pRawMem) SPIRVShaderResources //
-        {
-            Allocator,
-            m_SPIRV,
-            m_Desc,
-            ShaderCI.UseCombinedTextureSamplers ? ShaderCI.CombinedSamplerSuffix : nullptr,
-            LoadShaderInputs,
-            m_EntryPoint //
-        };
+    auto& Allocator             = GetRawAllocator();
+    auto* pRawMem               = ALLOCATE(Allocator, "Allocator for ShaderResources", SPIRVShaderResources, 1);
+    auto  LoadShaderInputs      = m_Desc.ShaderType == SHADER_TYPE_VERTEX;
+    auto* CombinedSamplerSuffix = ShaderCI.UseCombinedTextureSamplers ? ShaderCI.CombinedSamplerSuffix : nullptr;
+
+    bool UseReflectionData = false;
+    if (pReflectionData != nullptr)
+    {
+        UseReflectionData = SPIRVShaderResources::IsSerializedDataValid(pReflectionData, ReflectionDataSize, m_SPIRV, m_Desc.ShaderType, LoadShaderInputs);
+        if (!UseReflectionData)
+        {
+            LOG_WARNING_MESSAGE("Reflection data provided for shader '", m_Desc.Name,
+                                "' does not match the byte code and will be ignored. The byte code will be reflected instead.");
+        }
+    }
+
+    SPIRVShaderResources* pResources = nullptr;
+    if (UseReflectionData)
+    {
+        pResources = new (pRawMem) SPIRVShaderResources //
+            {
+                Allocator,
+                pReflectionData,
+                ReflectionDataSize,
+                m_Desc,
+                CombinedSamplerSuffix,
+                m_EntryPoint //
+            };
+    }
+    else
+    {
+        pResources = new (pRawMem) SPIRVShaderResources //
+            {
+                Allocator,
+                m_SPIRV,
+                m_Desc,
+                CombinedSamplerSuffix,
+                LoadShaderInputs,
+                m_EntryPoint //
+            };
+    }
     m_pShaderResources.reset(pResources, STDDeleterRawMem<SPIRVShaderResources>(Allocator));
 
     if (LoadShaderInputs && m_pShaderResources->IsHLSLSource())
     {
         MapHLSLVertexShaderInputs();
     }
+
+    m_SPIRVHash = ComputeContentHash(m_SPIRV.data(), m_SPIRV.size() * sizeof(uint32_t));
+
+    if (StoreInCache)
+    {
+        // Reflection data are serialized after the vertex shader inputs have been mapped
+        std::vector<Uint8> ReflectionData;
+        m_pShaderResources->Serialize(m_SPIRV, m_EntryPoint, ReflectionData);
+        StoreShaderInCache(pPSOCache->GetStorage(), CacheKey, m_SPIRV, ReflectionData,
+                           pDependencyRecorder ? pDependencyRecorder->GetDependencies() : std::vector<ShaderSourceDependencyRecorder::Dependency>{});
+    }
+}
+
+void ShaderVkImpl::CompileShader(const ShaderCreateInfo& ShaderCI, SHADER_COMPILER ShaderCompiler) noexcept(false)
+{
+    static constexpr char VulkanDefine[] =
+        "#ifndef VULKAN\n"
+        "#   define VULKAN 1\n"
+        "#endif\n"
+#if PLATFORM_MACOS || PLATFORM_IOS || PLATFORM_TVOS
+        "#ifndef METAL\n"
+        "#   define METAL 1\n"
+        "#endif\n"
+#endif
+        ;
+
+    switch (ShaderCompiler)
+    {
+        case SHADER_COMPILER_DXC:
+        {
+            auto* pDXCompiler = GetDevice()->GetDxCompiler();
+            VERIFY_EXPR(pDXCompiler != nullptr && pDXCompiler->IsLoaded());
+            pDXCompiler->Compile(ShaderCI, ShaderVersion{}, VulkanDefine, nullptr, &m_SPIRV, ShaderCI.ppCompilerOutput);
+        }
+        break;
+
+        case SHADER_COMPILER_DEFAULT:
+        case SHADER_COMPILER_GLSLANG:
+        {
+#if DILIGENT_NO_GLSLANG
+            LOG_ERROR_AND_THROW("Diligent engine was not linked with glslang, use DXC or precompiled SPIRV bytecode.");
+#else
+            if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_HLSL)
+            {
+                m_SPIRV = GLSLangUtils::HLSLtoSPIRV(ShaderCI, VulkanDefine, ShaderCI.ppCompilerOutput);
+            }
+            else
+            {
+                std::string              GLSLSourceString;
+                RefCntAutoPtr<IDataBlob> pSourceFileData;
+
+                const char*        ShaderSource = nullptr;
+                size_t             SourceLength = ShaderCI.SourceLength;
+                const ShaderMacro* Macros       = nullptr;
+                if (ShaderCI.SourceLanguage == SHADER_SOURCE_LANGUAGE_GLSL_VERBATIM)
+                {
+                    // Read the source file directly and use it as is
+                    ShaderSource = ReadShaderSourceFile(ShaderCI.Source, ShaderCI.pShaderSourceStreamFactory, ShaderCI.FilePath, pSourceFileData, SourceLength);
+
+                    // Add user macros.
+                    // BuildGLSLSourceString adds the macros to the source string, so we don't need to do this for SHADER_SOURCE_LANGUAGE_GLSL
+                    Macros = ShaderCI.Macros;
+                }
+                else
+                {
+                    // Build the full source code string that will contain GLSL version declaration,
+                    // platform definitions, user-provided shader macros, etc.
+                    GLSLSourceString = BuildGLSLSourceString(ShaderCI, GetDevice()->GetDeviceInfo(), GetDevice()->GetAdapterInfo(),
+                                                             TargetGLSLCompiler::glslang, VulkanDefine);
+                    ShaderSource     = GLSLSourceString.c_str();
+                    SourceLength     = GLSLSourceString.length();
+                }
+
+                const auto& ExtFeats  = GetDevice()->GetLogicalDevice().GetEnabledExtFeatures();
+                const auto  VkVersion = GetDevice()->GetVkVersion();
+
+                GLSLangUtils::GLSLtoSPIRVAttribs Attribs;
+                Attribs.ShaderType                 = m_Desc.ShaderType;
+                Attribs.ShaderSource               = ShaderSource;
+                Attribs.SourceCodeLen              = static_cast<int>(SourceLength);
+                Attribs.Version                    = GLSLangUtils::SpirvVersion::Vk100;
+                Attribs.Macros                     = Macros;
+                Attribs.AssignBindings             = true;
+                Attribs.pShaderSourceStreamFactory = ShaderCI.pShaderSourceStreamFactory;
+                Attribs.ppCompilerOutput           = ShaderCI.ppCompilerOutput;
+
+                if (VkVersion >= VK_API_VERSION_1_2)
+                    Attribs.Version = GLSLangUtils::SpirvVersion::Vk120;
+                else if (VkVersion >= VK_API_VERSION_1_1)
+                    Attribs.Version = ExtFeats.Spirv14 ? GLSLangUtils::SpirvVersion::Vk110_Spirv14 : GLSLangUtils::SpirvVersion::Vk110;
+
+                m_SPIRV = GLSLangUtils::GLSLtoSPIRV(Attribs);
+            }
+#endif
+            break;
+        }
+
+        default:
+            LOG_ERROR_AND_THROW("Unsupported shader compiler");
+    }
 }
 
 void ShaderVkImpl::MapHLSLVertexShaderInputs()
@@ -232,6 +612,27 @@ void ShaderVkImpl::MapHLSLVertexShaderInputs()
 
 ShaderVkImpl::~ShaderVkImpl()
 {
+    // The shader may still be being compiled by the thread pool
+    WaitForAsyncCompileTask();
+}
+
+void ShaderVkImpl::GetReflectionData(IDataBlob** ppReflectionData) const
+{
+    DEV_CHECK_ERR(ppReflectionData != nullptr, "ppReflectionData must not be null");
+    DEV_CHECK_ERR(*ppReflectionData == nullptr, "Overwriting reference to existing object may cause memory leaks");
+
+    WaitForAsyncCompileTask();
+    if (!m_pShaderResources)
+    {
+        LOG_ERROR_MESSAGE("Shader '", m_Desc.Name, "' has failed to compile and has no reflection data");
+        return;
+    }
+
+    std::vector<Uint8> Data;
+    m_pShaderResources->Serialize(m_SPIRV, m_EntryPoint, Data);
+
+    auto pDataBlob = DataBlobImpl::Create(Data.size(), Data.data());
+    pDataBlob->QueryInterface(IID_DataBlob, reinterpret_cast<IObject**>(ppReflectionData));
 }
 
 void ShaderVkImpl::GetResourceDesc(Uint32 Index, ShaderResourceDesc& ResourceDesc) const
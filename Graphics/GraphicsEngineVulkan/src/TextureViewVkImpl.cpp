@@ -29,6 +29,7 @@
 #include "TextureViewVkImpl.hpp"
 #include "RenderDeviceVkImpl.hpp"
 #include "DeviceContextVkImpl.hpp"
+#include "TextureVkImpl.hpp"
 
 namespace Diligent
 {
@@ -55,6 +56,10 @@ TextureViewVkImpl::TextureViewVkImpl(IReferenceCounters*                 pRefCou
 
 TextureViewVkImpl::~TextureViewVkImpl()
 {
+    // Default views are destroyed by the texture itself
+    if (m_spTexture)
+        GetTexture<TextureVkImpl>()->OnDestroyView(this);
+
     if (m_Desc.ViewType == TEXTURE_VIEW_DEPTH_STENCIL ||
         m_Desc.ViewType == TEXTURE_VIEW_RENDER_TARGET ||
         m_Desc.ViewType == TEXTURE_VIEW_SHADING_RATE)
@@ -64,4 +69,12 @@ TextureViewVkImpl::~TextureViewVkImpl()
     m_pDevice->SafeReleaseDeviceObject(std::move(m_ImageView), m_pTexture->GetDesc().ImmediateContextMask);
 }
 
+void TextureViewVkImpl::SetImageView(VulkanUtilities::ImageViewWrapper&& ImgView)
+{
+    VERIFY(m_Desc.ViewType == TEXTURE_VIEW_SHADER_RESOURCE || m_Desc.ViewType == TEXTURE_VIEW_UNORDERED_ACCESS,
+           "Only shader resource and unordered access views are expected: image views of other types may be referenced by framebuffers");
+    m_pDevice->SafeReleaseDeviceObject(std::move(m_ImageView), m_pTexture->GetDesc().ImmediateContextMask);
+    m_ImageView = std::move(ImgView);
+}
+
 } // namespace Diligent
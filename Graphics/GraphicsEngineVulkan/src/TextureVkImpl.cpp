@@ -224,6 +224,18 @@ TextureVkImpl::TextureVkImpl(IReferenceCounters*        pRefCounters,
                 InitializeTextureContent(*pInitData, FmtAttribs, ImageCI);
             else
                 SetState(RESOURCE_STATE_UNDEFINED);
+
+            // Attachments are referenced by framebuffers that are not tracked by the texture.
+            // Subsampled images can't be copied. Textures that use concurrent sharing mode
+            // are not moved to keep relocation in a single queue.
+            constexpr BIND_FLAGS AttachmentBindFlags = BIND_RENDER_TARGET | BIND_DEPTH_STENCIL | BIND_INPUT_ATTACHMENT | BIND_SHADING_RATE;
+            m_IsRelocatable =
+                (m_Desc.Usage == USAGE_DEFAULT || m_Desc.Usage == USAGE_IMMUTABLE) &&
+                (m_Desc.MiscFlags & (MISC_TEXTURE_FLAG_MEMORYLESS | MISC_TEXTURE_FLAG_SUBSAMPLED)) == 0 &&
+                (m_Desc.BindFlags & AttachmentBindFlags) == 0 &&
+                FmtAttribs.ComponentType != COMPONENT_TYPE_DEPTH &&
+                FmtAttribs.ComponentType != COMPONENT_TYPE_DEPTH_STENCIL &&
+                ImageCI.sharingMode == VK_SHARING_MODE_EXCLUSIVE;
         }
     }
     else if (m_Desc.Usage == USAGE_STAGING)
@@ -543,7 +555,14 @@ void TextureVkImpl::CreateViewInternal(const TextureViewDesc& ViewDesc, ITexture
         if (bIsDefaultView)
             *ppView = pViewVk;
         else
+        {
             pViewVk->QueryInterface(IID_TextureView, reinterpret_cast<IObject**>(ppView));
+            if (m_IsRelocatable)
+            {
+                std::lock_guard<std::mutex> Lock{m_ViewsMtx};
+                m_Views.push_back(pViewVk);
+            }
+        }
     }
     catch (const std::runtime_error&)
     {
@@ -554,6 +573,12 @@ void TextureVkImpl::CreateViewInternal(const TextureViewDesc& ViewDesc, ITexture
 
 TextureVkImpl::~TextureVkImpl()
 {
+    if (m_IsRelocatable)
+        m_pDevice->UnregisterRelocatableResource(this);
+
+    // Non-default views keep a strong reference to the texture
+    VERIFY(m_Views.empty(), "Not all views have been destroyed");
+
     // Vk object can only be destroyed when it is no longer used by the GPU
     // Wrappers for external texture will not be destroyed as they are created with null device pointer
     if (m_VulkanImage)
@@ -563,6 +588,81 @@ TextureVkImpl::~TextureVkImpl()
     m_pDevice->SafeReleaseDeviceObject(std::move(m_MemoryAllocation), m_Desc.ImmediateContextMask);
 }
 
+void TextureVkImpl::OnDestroyView(TextureViewVkImpl* pView)
+{
+    if (!m_IsRelocatable)
+        return;
+
+    std::lock_guard<std::mutex> Lock{m_ViewsMtx};
+
+    auto it = std::find(m_Views.begin(), m_Views.end(), pView);
+    VERIFY_EXPR(it != m_Views.end());
+    if (it != m_Views.end())
+        m_Views.erase(it);
+}
+
+bool TextureVkImpl::IsBeingEvacuated() const
+{
+    return m_IsRelocatable && m_pDevice->GetGlobalMemoryManager().IsBeingEvacuated(m_MemoryAllocation);
+}
+
+bool TextureVkImpl::CreateRelocationTarget(RelocationTarget& Target)
+{
+    VERIFY_EXPR(m_IsRelocatable);
+    const auto& LogicalDevice = m_pDevice->GetLogicalDevice();
+
+    auto ImageCI          = TextureDescToVkImageCreateInfo(m_Desc, m_pDevice);
+    ImageCI.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    auto vkImage = LogicalDevice.CreateImage(ImageCI, m_Desc.Name);
+
+    const auto MemReqs = LogicalDevice.GetImageMemoryRequirements(vkImage);
+    VERIFY((MemReqs.memoryTypeBits & (1u << m_MemoryAllocation.Page->GetMemoryTypeIndex())) != 0,
+           "The memory type of the original allocation is not compatible with the new image");
+
+    auto Allocation = m_pDevice->GetGlobalMemoryManager().AllocateForRelocation(m_MemoryAllocation, MemReqs.size, MemReqs.alignment);
+    if (Allocation.Page == nullptr)
+        return false;
+
+    const auto AlignedOffset = AlignUp(VkDeviceSize{Allocation.UnalignedOffset}, MemReqs.alignment);
+    VERIFY_EXPR(Allocation.Size >= MemReqs.size + (AlignedOffset - Allocation.UnalignedOffset));
+
+    auto err = LogicalDevice.BindImageMemory(vkImage, Allocation.Page->GetVkMemory(), AlignedOffset);
+    CHECK_VK_ERROR_AND_THROW(err, "Failed to bind image memory");
+
+    Target.vkImage          = std::move(vkImage);
+    Target.MemoryAllocation = std::move(Allocation);
+    return true;
+}
+
+void TextureVkImpl::Relocate(RelocationTarget&& Target)
+{
+    VERIFY_EXPR(Target.vkImage != VK_NULL_HANDLE && Target.MemoryAllocation.Page != nullptr);
+
+    // The old image may still be used by the GPU
+    m_pDevice->SafeReleaseDeviceObject(std::move(m_VulkanImage), m_Desc.ImmediateContextMask);
+    m_pDevice->SafeReleaseDeviceObject(std::move(m_MemoryAllocation), m_Desc.ImmediateContextMask);
+
+    m_VulkanImage      = std::move(Target.vkImage);
+    m_MemoryAllocation = std::move(Target.MemoryAllocation);
+
+    auto RecreateImageView = [this](TextureViewVkImpl* pViewVk) {
+        auto ViewDesc = pViewVk->GetDesc();
+        pViewVk->SetImageView(CreateImageView(ViewDesc));
+    };
+
+    // Relocatable textures may only have shader resource and unordered access views
+    for (auto ViewType : {TEXTURE_VIEW_SHADER_RESOURCE, TEXTURE_VIEW_UNORDERED_ACCESS})
+    {
+        if (auto* pDefaultView = GetDefaultView(ViewType))
+            RecreateImageView(ClassPtrCast<TextureViewVkImpl>(pDefaultView));
+    }
+
+    std::lock_guard<std::mutex> Lock{m_ViewsMtx};
+    for (auto* pViewVk : m_Views)
+        RecreateImageView(pViewVk);
+}
+
 VulkanUtilities::ImageViewWrapper TextureVkImpl::CreateImageView(TextureViewDesc& ViewDesc)
 {
     // clang-format off
@@ -25,6 +25,7 @@
  *  of the possibility of such damages.
  */
 #include <sstream>
+#include <algorithm>
 
 #include "VulkanUtilities/VulkanCommandBuffer.hpp"
 #include "AdvancedMath.hpp"
@@ -140,6 +141,83 @@ static VkAccessFlags AccessMaskFromImageLayout(VkImageLayout Layout,
     return AccessMask;
 }
 
+// Access types that write memory. Dependencies between accesses that
+// only read memory do not require any synchronization.
+// clang-format off
+constexpr VkAccessFlags WriteAccessMask =
+    VK_ACCESS_SHADER_WRITE_BIT                        |
+    VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT              |
+    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT      |
+    VK_ACCESS_TRANSFER_WRITE_BIT                      |
+    VK_ACCESS_HOST_WRITE_BIT                          |
+    VK_ACCESS_MEMORY_WRITE_BIT                        |
+    VK_ACCESS_TRANSFORM_FEEDBACK_WRITE_BIT_EXT        |
+    VK_ACCESS_TRANSFORM_FEEDBACK_COUNTER_WRITE_BIT_EXT|
+    VK_ACCESS_COMMAND_PREPROCESS_WRITE_BIT_NV         |
+    VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+// clang-format on
+
+struct SubresourceBounds
+{
+    uint32_t StartMip;
+    uint32_t EndMip;
+    uint32_t StartLayer;
+    uint32_t EndLayer;
+
+    explicit SubresourceBounds(const VkImageSubresourceRange& Range) :
+        // clang-format off
+        StartMip  {Range.baseMipLevel},
+        EndMip    {Range.levelCount != VK_REMAINING_MIP_LEVELS ? (Range.baseMipLevel + Range.levelCount) : ~0u},
+        StartLayer{Range.baseArrayLayer},
+        EndLayer  {Range.layerCount != VK_REMAINING_ARRAY_LAYERS ? (Range.baseArrayLayer + Range.layerCount) : ~0u}
+    // clang-format on
+    {}
+
+    bool Overlaps(const SubresourceBounds& Other) const
+    {
+        // End bounds are exclusive, so touching ranges do not overlap
+        return Diligent::CheckLineSectionOverlap<false>(StartLayer, EndLayer, Other.StartLayer, Other.EndLayer) &&
+            Diligent::CheckLineSectionOverlap<false>(StartMip, EndMip, Other.StartMip, Other.EndMip);
+    }
+
+    bool operator==(const SubresourceBounds& Other) const
+    {
+        // clang-format off
+        return StartMip   == Other.StartMip   &&
+               EndMip     == Other.EndMip     &&
+               StartLayer == Other.StartLayer &&
+               EndLayer   == Other.EndLayer;
+        // clang-format on
+    }
+};
+
+// Returns true if the ranges are adjacent and their union is a range too.
+bool CanMergeRanges(const SubresourceBounds& Bounds0, const SubresourceBounds& Bounds1)
+{
+    if (Bounds0.StartLayer == Bounds1.StartLayer && Bounds0.EndLayer == Bounds1.EndLayer)
+        return Bounds0.EndMip == Bounds1.StartMip || Bounds1.EndMip == Bounds0.StartMip;
+
+    if (Bounds0.StartMip == Bounds1.StartMip && Bounds0.EndMip == Bounds1.EndMip)
+        return Bounds0.EndLayer == Bounds1.StartLayer || Bounds1.EndLayer == Bounds0.StartLayer;
+
+    return false;
+}
+
+void MergeRanges(VkImageSubresourceRange& DstRange, const VkImageSubresourceRange& SrcRange)
+{
+    const SubresourceBounds DstBounds{DstRange};
+    const SubresourceBounds SrcBounds{SrcRange};
+    VERIFY_EXPR(CanMergeRanges(DstBounds, SrcBounds));
+
+    const auto EndMip   = std::max(DstBounds.EndMip, SrcBounds.EndMip);
+    const auto EndLayer = std::max(DstBounds.EndLayer, SrcBounds.EndLayer);
+
+    DstRange.baseMipLevel   = std::min(DstBounds.StartMip, SrcBounds.StartMip);
+    DstRange.levelCount     = EndMip != ~0u ? EndMip - DstRange.baseMipLevel : VK_REMAINING_MIP_LEVELS;
+    DstRange.baseArrayLayer = std::min(DstBounds.StartLayer, SrcBounds.StartLayer);
+    DstRange.layerCount     = EndLayer != ~0u ? EndLayer - DstRange.baseArrayLayer : VK_REMAINING_ARRAY_LAYERS;
+}
+
 } // namespace
 
 
@@ -165,50 +243,94 @@ void VulkanCommandBuffer::TransitionImageLayout(VkImage                        I
     VERIFY_EXPR((SrcStages & m_Barrier.SupportedStagesMask) != 0);
     VERIFY_EXPR((DstStages & m_Barrier.SupportedStagesMask) != 0);
 
+    const auto SrcAccess = AccessMaskFromImageLayout(OldLayout, false);
+    const auto DstAccess = AccessMaskFromImageLayout(NewLayout, true);
+
     if (OldLayout == NewLayout)
     {
+        // Read-after-read does not need a barrier
+        if (((SrcAccess | DstAccess) & WriteAccessMask) == 0)
+        {
+            ++m_BarrierStats.ElidedBarrierCount;
+            return;
+        }
+
         m_Barrier.MemorySrcStages |= SrcStages;
         m_Barrier.MemoryDstStages |= DstStages;
 
-        m_Barrier.MemorySrcAccess |= AccessMaskFromImageLayout(OldLayout, false);
-        m_Barrier.MemoryDstAccess |= AccessMaskFromImageLayout(NewLayout, true);
+        m_Barrier.MemorySrcAccess |= SrcAccess;
+        m_Barrier.MemoryDstAccess |= DstAccess;
         return;
     }
 
-    // Check overlapping subresources
-    for (size_t i = 0; i < m_ImageBarriers.size(); ++i)
+    // Pending barriers of the same image never overlap, so the new barrier may either
+    // be combined with one of them, or all of them must be flushed.
+    const SubresourceBounds NewBounds{SubresRange};
+
+    VkImageMemoryBarrier* pAdjacentBarrier = nullptr;
+    for (auto& ImgBarrier : m_ImageBarriers)
     {
-        const auto& ImgBarrier = m_ImageBarriers[i];
         if (ImgBarrier.image != Image)
             continue;
 
-        const auto& OtherRange = ImgBarrier.subresourceRange;
-
-        const auto StartLayer0 = SubresRange.baseArrayLayer;
-        const auto EndLayer0   = SubresRange.layerCount != VK_REMAINING_ARRAY_LAYERS ? (SubresRange.baseArrayLayer + SubresRange.layerCount) : ~0u;
-        const auto StartLayer1 = OtherRange.baseArrayLayer;
-        const auto EndLayer1   = OtherRange.layerCount != VK_REMAINING_ARRAY_LAYERS ? (OtherRange.baseArrayLayer + OtherRange.layerCount) : ~0u;
+        const SubresourceBounds Bounds{ImgBarrier.subresourceRange};
+        if (!Bounds.Overlaps(NewBounds))
+        {
+            // clang-format off
+            if (pAdjacentBarrier == nullptr                                       &&
+                ImgBarrier.oldLayout                   == OldLayout               &&
+                ImgBarrier.newLayout                   == NewLayout               &&
+                ImgBarrier.subresourceRange.aspectMask == SubresRange.aspectMask &&
+                CanMergeRanges(Bounds, NewBounds))
+            // clang-format on
+            {
+                pAdjacentBarrier = &ImgBarrier;
+            }
+            continue;
+        }
 
-        const auto StartMip0 = SubresRange.baseMipLevel;
-        const auto EndMip0   = SubresRange.levelCount != VK_REMAINING_MIP_LEVELS ? (SubresRange.baseMipLevel + SubresRange.levelCount) : ~0u;
-        const auto StartMip1 = OtherRange.baseMipLevel;
-        const auto EndMip1   = OtherRange.levelCount != VK_REMAINING_MIP_LEVELS ? (OtherRange.baseMipLevel + OtherRange.levelCount) : ~0u;
+        if (Bounds == NewBounds && ImgBarrier.subresourceRange.aspectMask == SubresRange.aspectMask)
+        {
+            if (ImgBarrier.oldLayout == OldLayout && ImgBarrier.newLayout == NewLayout)
+            {
+                // The same transition is already pending
+                m_Barrier.ImageSrcStages |= SrcStages;
+                m_Barrier.ImageDstStages |= DstStages;
+                ++m_BarrierStats.ElidedBarrierCount;
+                return;
+            }
 
-        const auto SlicesOverlap = Diligent::CheckLineSectionOverlap<true>(StartLayer0, EndLayer0, StartLayer1, EndLayer1);
-        const auto MipsOverlap   = Diligent::CheckLineSectionOverlap<true>(StartMip0, EndMip0, StartMip1, EndMip1);
+            if (ImgBarrier.newLayout == OldLayout)
+            {
+                // No commands can access the subresources between the two transitions,
+                // so they can be replaced with a single one: A -> B, B -> C  =>  A -> C.
+                ImgBarrier.newLayout     = NewLayout;
+                ImgBarrier.dstAccessMask = DstAccess & m_Barrier.SupportedAccessMask;
+                m_Barrier.ImageSrcStages |= SrcStages;
+                m_Barrier.ImageDstStages |= DstStages;
+                ++m_BarrierStats.MergedBarrierCount;
+                return;
+            }
+        }
 
         // If the range overlaps with any of the existing barriers, we need to
         // flush them.
-        if (SlicesOverlap && MipsOverlap)
-        {
-            FlushBarriers();
-            break;
-        }
+        FlushBarriers();
+        pAdjacentBarrier = nullptr;
+        break;
     }
 
     m_Barrier.ImageSrcStages |= SrcStages;
     m_Barrier.ImageDstStages |= DstStages;
 
+    if (pAdjacentBarrier != nullptr)
+    {
+        // Extend the pending barrier to cover the new subresources
+        MergeRanges(pAdjacentBarrier->subresourceRange, SubresRange);
+        ++m_BarrierStats.MergedBarrierCount;
+        return;
+    }
+
     VkImageMemoryBarrier ImgBarrier{};
     ImgBarrier.sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
     ImgBarrier.pNext               = nullptr;
@@ -216,8 +338,8 @@ void VulkanCommandBuffer::TransitionImageLayout(VkImage                        I
     ImgBarrier.newLayout           = NewLayout;
     ImgBarrier.image               = Image;
     ImgBarrier.subresourceRange    = SubresRange;
-    ImgBarrier.srcAccessMask       = AccessMaskFromImageLayout(OldLayout, false) & m_Barrier.SupportedAccessMask;
-    ImgBarrier.dstAccessMask       = AccessMaskFromImageLayout(NewLayout, true) & m_Barrier.SupportedAccessMask;
+    ImgBarrier.srcAccessMask       = SrcAccess & m_Barrier.SupportedAccessMask;
+    ImgBarrier.dstAccessMask       = DstAccess & m_Barrier.SupportedAccessMask;
     ImgBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED; // source queue family for a queue family ownership transfer.
     ImgBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED; // destination queue family for a queue family ownership transfer.
     m_ImageBarriers.emplace_back(ImgBarrier);
@@ -228,6 +350,13 @@ void VulkanCommandBuffer::MemoryBarrier(VkAccessFlags        srcAccessMask,
                                         VkPipelineStageFlags SrcStages,
                                         VkPipelineStageFlags DstStages)
 {
+    // Read-after-read does not need a barrier
+    if (((srcAccessMask | dstAccessMask) & WriteAccessMask) == 0)
+    {
+        ++m_BarrierStats.ElidedBarrierCount;
+        return;
+    }
+
     if (m_State.RenderPass != VK_NULL_HANDLE)
     {
         EndRenderPass();
@@ -236,6 +365,12 @@ void VulkanCommandBuffer::MemoryBarrier(VkAccessFlags        srcAccessMask,
     VERIFY_EXPR((SrcStages & m_Barrier.SupportedStagesMask) != 0);
     VERIFY_EXPR((DstStages & m_Barrier.SupportedStagesMask) != 0);
 
+    if (m_Barrier.MemorySrcStages != 0 || m_Barrier.MemoryDstStages != 0)
+    {
+        // All buffer transitions are combined into a single global memory barrier
+        ++m_BarrierStats.MergedBarrierCount;
+    }
+
     m_Barrier.MemorySrcStages |= SrcStages;
     m_Barrier.MemoryDstStages |= DstStages;
 
@@ -269,6 +404,10 @@ void VulkanCommandBuffer::FlushBarriers()
     const VkPipelineStageFlags DstStages = (m_Barrier.ImageDstStages | m_Barrier.MemoryDstStages) & m_Barrier.SupportedStagesMask;
     VERIFY_EXPR(SrcStages != 0 && DstStages != 0);
 
+    ++m_BarrierStats.PipelineBarrierCount;
+    m_BarrierStats.ImageBarrierCount += static_cast<uint32_t>(m_ImageBarriers.size());
+    m_BarrierStats.MemoryBarrierCount += HasMemoryBarrier ? 1 : 0;
+
     vkCmdPipelineBarrier(m_VkCmdBuffer,
                          SrcStages,
                          DstStages,
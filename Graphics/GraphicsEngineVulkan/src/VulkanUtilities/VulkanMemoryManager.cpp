@@ -27,6 +27,8 @@
 
 #include "pch.h"
 #include <sstream>
+#include <algorithm>
+#include <thread>
 #include "VulkanUtilities/VulkanMemoryManager.hpp"
 
 namespace VulkanUtilities
@@ -47,6 +49,8 @@ VulkanMemoryPage::VulkanMemoryPage(VulkanMemoryManager&  ParentMemoryMgr,
                                    VkMemoryAllocateFlags AllocateFlags) noexcept :
     // clang-format off
     m_ParentMemoryMgr{ParentMemoryMgr},
+    m_MemoryTypeIndex{MemoryTypeIndex},
+    m_AllocateFlags  {AllocateFlags  },
     m_AllocationMgr  {static_cast<AllocationsMgrOffsetType>(PageSize), ParentMemoryMgr.m_Allocator}
 // clang-format on
 {
@@ -83,6 +87,8 @@ VulkanMemoryPage::VulkanMemoryPage(VulkanMemoryManager&  ParentMemoryMgr,
             &m_CPUMemory);
         CHECK_VK_ERROR_AND_THROW(err, "Failed to map staging memory");
     }
+
+    m_MaxFreeBlockSize.store(m_AllocationMgr.GetMaxFreeBlockSize());
 }
 
 VulkanMemoryPage::~VulkanMemoryPage()
@@ -105,6 +111,10 @@ VulkanMemoryAllocation VulkanMemoryPage::Allocate(VkDeviceSize size, VkDeviceSiz
     auto Allocation = m_AllocationMgr.Allocate(static_cast<AllocationsMgrOffsetType>(size), static_cast<AllocationsMgrOffsetType>(alignment));
     if (Allocation.IsValid())
     {
+        m_MaxFreeBlockSize.store(m_AllocationMgr.GetMaxFreeBlockSize());
+        // The page is in use again and should not be released by ShrinkMemory()
+        m_ReleaseWhenEmpty.store(false);
+
         // Offset may not necessarily be aligned, but the allocation is guaranteed to be large enough
         // to accommodate requested alignment
         VERIFY_EXPR(Diligent::AlignUp(VkDeviceSize{Allocation.UnalignedOffset}, alignment) - Allocation.UnalignedOffset + size <= Allocation.Size);
@@ -116,6 +126,13 @@ VulkanMemoryAllocation VulkanMemoryPage::Allocate(VkDeviceSize size, VkDeviceSiz
     }
 }
 
+void VulkanMemoryPage::GetFreeBlockStats(size_t& NumFreeBlocks, VkDeviceSize& MaxFreeBlockSize)
+{
+    std::lock_guard<std::mutex> Lock{m_Mutex};
+    NumFreeBlocks    = m_AllocationMgr.GetNumFreeBlocks();
+    MaxFreeBlockSize = m_AllocationMgr.GetMaxFreeBlockSize();
+}
+
 void VulkanMemoryPage::Free(VulkanMemoryAllocation&& Allocation)
 {
     m_ParentMemoryMgr.OnFreeAllocation(Allocation.Size, m_CPUMemory != nullptr);
@@ -123,6 +140,7 @@ void VulkanMemoryPage::Free(VulkanMemoryAllocation&& Allocation)
     VERIFY_EXPR(Allocation.UnalignedOffset <= std::numeric_limits<AllocationsMgrOffsetType>::max());
     VERIFY_EXPR(Allocation.Size <= std::numeric_limits<AllocationsMgrOffsetType>::max());
     m_AllocationMgr.Free(static_cast<AllocationsMgrOffsetType>(Allocation.UnalignedOffset), static_cast<AllocationsMgrOffsetType>(Allocation.Size));
+    m_MaxFreeBlockSize.store(m_AllocationMgr.GetMaxFreeBlockSize());
     Allocation = VulkanMemoryAllocation{};
 }
 
@@ -158,10 +176,131 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(const VkMemoryRequirements&
     return Allocate(MemReqs.size, MemReqs.alignment, MemoryTypeIndex, HostVisible, AllocateFlags);
 }
 
-VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags)
+size_t VulkanMemoryManager::GetNumShards()
 {
-    VulkanMemoryAllocation Allocation;
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
 
+VulkanMemoryManager::Shard& VulkanMemoryManager::GetThreadShard()
+{
+    // Threads are assigned to shards in round-robin order
+    static std::atomic<size_t>     NumThreads{0};
+    static thread_local const auto ThreadId = NumThreads.fetch_add(1);
+
+    return m_Shards[ThreadId % m_Shards.size()];
+}
+
+static void UpdatePeakValue(std::atomic<VkDeviceSize>& PeakValue, VkDeviceSize CurrValue)
+{
+    auto Peak = PeakValue.load();
+    while (CurrValue > Peak && !PeakValue.compare_exchange_weak(Peak, CurrValue))
+    {
+    }
+}
+
+static bool PageMatchesIndex(const VulkanMemoryPage& Page, uint32_t MemoryTypeIndex, bool IsHostVisible, VkMemoryAllocateFlags AllocateFlags)
+{
+    return Page.GetMemoryTypeIndex() == MemoryTypeIndex &&
+        (Page.GetCPUMemory() != nullptr) == IsHostVisible &&
+        Page.GetAllocateFlags() == AllocateFlags;
+}
+
+VulkanMemoryAllocation VulkanMemoryManager::AllocateFromPreferredPages(Shard& ThreadShard, const MemoryPageIndex& PageIdx, VkDeviceSize Size, VkDeviceSize Alignment)
+{
+    std::lock_guard<std::mutex> Lock{ThreadShard.Mtx};
+    for (auto* pPage : ThreadShard.PreferredPages)
+    {
+        if (pPage == nullptr || !PageMatchesIndex(*pPage, PageIdx.MemoryTypeIndex, PageIdx.IsHostVisible, PageIdx.AllocateFlags))
+            continue;
+
+        // The page is not destroyed while it is in the list, see ForgetPreferredPage()
+        if (pPage->IsEvacuating() || pPage->GetMaxFreeBlockSizeHint() < Size)
+            continue;
+
+        auto Allocation = pPage->Allocate(Size, Alignment);
+        if (Allocation.Page != nullptr)
+            return Allocation;
+    }
+    return VulkanMemoryAllocation{};
+}
+
+void VulkanMemoryManager::SetPreferredPage(Shard& ThreadShard, VulkanMemoryPage& Page)
+{
+    const bool IsHostVisible = Page.GetCPUMemory() != nullptr;
+
+    std::lock_guard<std::mutex> Lock{ThreadShard.Mtx};
+
+    auto& PreferredPages = ThreadShard.PreferredPages;
+    // Replace the page of the same group, or the empty slot, or the least recently set page
+    size_t Slot = PreferredPages.size() - 1;
+    for (size_t i = 0; i < PreferredPages.size(); ++i)
+    {
+        if (PreferredPages[i] == nullptr || PageMatchesIndex(*PreferredPages[i], Page.GetMemoryTypeIndex(), IsHostVisible, Page.GetAllocateFlags()))
+        {
+            Slot = i;
+            break;
+        }
+    }
+    // Keep the most recently set page first
+    for (; Slot > 0; --Slot)
+        PreferredPages[Slot] = PreferredPages[Slot - 1];
+    PreferredPages[0] = &Page;
+}
+
+void VulkanMemoryManager::ForgetPreferredPage(const VulkanMemoryPage& Page)
+{
+    for (auto& ThreadShard : m_Shards)
+    {
+        std::lock_guard<std::mutex> Lock{ThreadShard.Mtx};
+        for (auto& pPage : ThreadShard.PreferredPages)
+        {
+            if (pPage == &Page)
+                pPage = nullptr;
+        }
+    }
+}
+
+void VulkanMemoryManager::MemoryTypePages::RestoreOrder()
+{
+    for (auto& Info : Pages)
+        Info.MaxFreeBlockSize = Info.pPage->GetMaxFreeBlockSizeHint();
+
+    // Only few pages change between two allocations, so insertion sort takes close to linear time.
+    // The sizes are read once above, so the comparison is consistent while other threads free memory.
+    for (size_t i = 1; i < Pages.size(); ++i)
+    {
+        for (size_t j = i; j > 0 && Pages[j - 1].MaxFreeBlockSize > Pages[j].MaxFreeBlockSize; --j)
+            std::swap(Pages[j - 1], Pages[j]);
+    }
+}
+
+VulkanMemoryAllocation VulkanMemoryManager::AllocateFromExistingPages(MemoryTypePages& TypePages, VkMemoryAllocateFlags AllocateFlags, VkDeviceSize Size, VkDeviceSize Alignment)
+{
+    TypePages.RestoreOrder();
+
+    // Pages whose largest free block is too small are skipped without locking them.
+    // Using the smallest block that fits keeps large blocks available for large allocations.
+    auto& Pages   = TypePages.Pages;
+    auto  page_it = std::lower_bound(Pages.begin(), Pages.end(), Size,
+                                    [](const MemoryTypePages::PageInfo& Info, VkDeviceSize RequiredSize) {
+                                        return Info.MaxFreeBlockSize < RequiredSize;
+                                    });
+    for (; page_it != Pages.end(); ++page_it)
+    {
+        auto& Page = *page_it->pPage;
+        if (Page.GetAllocateFlags() != AllocateFlags || Page.IsEvacuating())
+            continue;
+
+        auto Allocation = Page.Allocate(Size, Alignment);
+        if (Allocation.Page != nullptr)
+            return Allocation;
+    }
+
+    return VulkanMemoryAllocation{};
+}
+
+VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDeviceSize Alignment, uint32_t MemoryTypeIndex, bool HostVisible, VkMemoryAllocateFlags AllocateFlags)
+{
     // On integrated GPUs, there is no difference between host-visible and GPU-only
     // memory, so MemoryTypeIndex is the same. As GPU-only pages do not have CPU address,
     // we need to use HostVisible flag to differentiate the two.
@@ -169,43 +308,54 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDevice
     // even though on integrated GPUs same pages can be used for both GPU-only and staging
     // allocations. Staging allocations are short-living and will be released when upload is
     // complete, while GPU-only allocations are expected to be long-living.
-    MemoryPageIndex             PageIdx{MemoryTypeIndex, HostVisible, AllocateFlags};
-    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    MemoryPageIndex PageIdx{MemoryTypeIndex, HostVisible, AllocateFlags};
+
+    auto& ThreadShard = GetThreadShard();
 
-    auto range = m_Pages.equal_range(PageIdx);
-    for (auto page_it = range.first; page_it != range.second; ++page_it)
+    auto Allocation = AllocateFromPreferredPages(ThreadShard, PageIdx, Size, Alignment);
+    if (Allocation.Page != nullptr)
     {
-        Allocation = page_it->second.Allocate(Size, Alignment);
-        if (Allocation.Page != nullptr)
-            break;
+        OnNewAllocation(Allocation.Size, HostVisible);
+        return Allocation;
     }
 
-    size_t stat_ind = HostVisible ? 1 : 0;
-    if (Allocation.Page == nullptr)
     {
-        auto PageSize = HostVisible ? m_HostVisiblePageSize : m_DeviceLocalPageSize;
-        while (PageSize < Size)
-            PageSize *= 2;
-
-        m_CurrAllocatedSize[stat_ind] += PageSize;
-        m_PeakAllocatedSize[stat_ind] = std::max(m_PeakAllocatedSize[stat_ind], m_CurrAllocatedSize[stat_ind]);
-
-        auto it = m_Pages.emplace(PageIdx, VulkanMemoryPage{*this, PageSize, MemoryTypeIndex, HostVisible, AllocateFlags});
-        LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': created new ", (HostVisible ? "host-visible" : "device-local"),
-                         " page. (", Diligent::FormatMemorySize(PageSize, 2), ", type idx: ", MemoryTypeIndex,
-                         "). Current allocated size: ", Diligent::FormatMemorySize(m_CurrAllocatedSize[stat_ind], 2));
-        OnNewPageCreated(it->second);
-        Allocation = it->second.Allocate(Size, Alignment);
-        DEV_CHECK_ERR(Allocation.Page != nullptr, "Failed to allocate new memory page");
+        auto&                       TypePages = GetMemoryTypePages(MemoryTypeIndex, HostVisible);
+        std::lock_guard<std::mutex> Lock{TypePages.Mtx};
+
+        Allocation = AllocateFromExistingPages(TypePages, AllocateFlags, Size, Alignment);
+        if (Allocation.Page == nullptr)
+        {
+            auto PageSize = HostVisible ? m_HostVisiblePageSize : m_DeviceLocalPageSize;
+            while (PageSize < Size)
+                PageSize *= 2;
+
+            std::unique_ptr<VulkanMemoryPage> pNewPage{new VulkanMemoryPage{*this, PageSize, MemoryTypeIndex, HostVisible, AllocateFlags}};
+
+            size_t     stat_ind          = HostVisible ? 1 : 0;
+            const auto CurrAllocatedSize = m_CurrAllocatedSize[stat_ind].fetch_add(PageSize) + PageSize;
+            UpdatePeakValue(m_PeakAllocatedSize[stat_ind], CurrAllocatedSize);
+
+            LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': created new ", (HostVisible ? "host-visible" : "device-local"),
+                             " page. (", Diligent::FormatMemorySize(PageSize, 2), ", type idx: ", MemoryTypeIndex,
+                             "). Current allocated size: ", Diligent::FormatMemorySize(CurrAllocatedSize, 2));
+            OnNewPageCreated(*pNewPage);
+            Allocation = pNewPage->Allocate(Size, Alignment);
+            DEV_CHECK_ERR(Allocation.Page != nullptr, "Failed to allocate new memory page");
+
+            // The page will be moved to its place in the list by the next RestoreOrder()
+            TypePages.Pages.push_back(MemoryTypePages::PageInfo{std::move(pNewPage)});
+        }
     }
 
     if (Allocation.Page != nullptr)
     {
         VERIFY_EXPR(Size + Diligent::AlignUp(Allocation.UnalignedOffset, Alignment) - Allocation.UnalignedOffset <= Allocation.Size);
+        // The page holds the new allocation, so ShrinkMemory() can't destroy it
+        SetPreferredPage(ThreadShard, *Allocation.Page);
     }
 
-    m_CurrUsedSize[stat_ind].fetch_add(Allocation.Size);
-    m_PeakUsedSize[stat_ind] = std::max(m_PeakUsedSize[stat_ind], static_cast<VkDeviceSize>(m_CurrUsedSize[stat_ind].load()));
+    OnNewAllocation(Allocation.Size, HostVisible);
 
     return Allocation;
 }
@@ -213,29 +363,286 @@ VulkanMemoryAllocation VulkanMemoryManager::Allocate(VkDeviceSize Size, VkDevice
 void VulkanMemoryManager::ShrinkMemory()
 {
     std::lock_guard<std::mutex> Lock{m_PagesMtx};
-    if (m_CurrAllocatedSize[0] <= m_DeviceLocalReserveSize && m_CurrAllocatedSize[1] <= m_HostVisibleReserveSize)
+    if (m_CurrAllocatedSize[0].load() <= m_DeviceLocalReserveSize && m_CurrAllocatedSize[1].load() <= m_HostVisibleReserveSize && !m_HasPagesToRelease)
         return;
 
-    auto it = m_Pages.begin();
-    while (it != m_Pages.end())
+    // Set if some of the pages marked for release by EndDefragmentation() still have live allocations
+    bool HasPagesToRelease = false;
+
+    for (auto& TypePages : m_MemoryTypePages)
+    {
+        std::lock_guard<std::mutex> TypeLock{TypePages.Mtx};
+
+        auto& Pages   = TypePages.Pages;
+        auto  page_it = Pages.begin();
+        while (page_it != Pages.end())
+        {
+            auto& Page          = *page_it->pPage;
+            bool  IsHostVisible = Page.GetCPUMemory() != nullptr;
+            auto  stat_ind      = IsHostVisible ? 1 : 0;
+            auto  ReserveSize   = IsHostVisible ? m_HostVisibleReserveSize : m_DeviceLocalReserveSize;
+            if (Page.IsReleasedWhenEmpty() && !Page.IsEmpty())
+                HasPagesToRelease = true;
+
+            if (Page.IsEmpty() && (m_CurrAllocatedSize[stat_ind].load() > ReserveSize || Page.IsReleasedWhenEmpty()))
+            {
+                // Other threads may still allocate from the page through the shard lists.
+                // Once the page is removed from the lists, it can only be accessed by the
+                // threads that lock the page list.
+                ForgetPreferredPage(Page);
+                if (Page.IsEmpty())
+                {
+                    auto       PageSize          = Page.GetPageSize();
+                    const auto CurrAllocatedSize = m_CurrAllocatedSize[stat_ind].fetch_sub(PageSize) - PageSize;
+                    LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': destroying ", (IsHostVisible ? "host-visible" : "device-local"),
+                                     " page (", Diligent::FormatMemorySize(PageSize, 2),
+                                     "). Current allocated size: ",
+                                     Diligent::FormatMemorySize(CurrAllocatedSize, 2));
+                    OnPageDestroy(Page);
+                    page_it = Pages.erase(page_it);
+                    continue;
+                }
+
+                HasPagesToRelease = HasPagesToRelease || Page.IsReleasedWhenEmpty();
+            }
+            ++page_it;
+        }
+    }
+
+    m_HasPagesToRelease = HasPagesToRelease;
+}
+
+std::vector<VulkanMemoryManager::MemoryTypeStats> VulkanMemoryManager::GetMemoryTypeStats()
+{
+    std::vector<MemoryTypeStats> Stats;
+
+    for (size_t i = 0; i < m_MemoryTypePages.size(); ++i)
     {
-        auto curr_it = it;
-        ++it;
-        auto& Page          = curr_it->second;
-        bool  IsHostVisible = Page.GetCPUMemory() != nullptr;
-        auto  ReserveSize   = IsHostVisible ? m_HostVisibleReserveSize : m_DeviceLocalReserveSize;
-        if (Page.IsEmpty() && m_CurrAllocatedSize[IsHostVisible ? 1 : 0] > ReserveSize)
+        auto&                       TypePages = m_MemoryTypePages[i];
+        std::lock_guard<std::mutex> TypeLock{TypePages.Mtx};
+        if (TypePages.Pages.empty())
+            continue;
+
+        MemoryTypeStats TypeStats;
+        TypeStats.MemoryTypeIndex = static_cast<uint32_t>(i / 2);
+        TypeStats.IsHostVisible   = (i % 2) != 0;
+        for (auto& Info : TypePages.Pages)
         {
-            auto PageSize = Page.GetPageSize();
-            m_CurrAllocatedSize[IsHostVisible ? 1 : 0] -= PageSize;
-            LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': destroying ", (IsHostVisible ? "host-visible" : "device-local"),
-                             " page (", Diligent::FormatMemorySize(PageSize, 2),
-                             "). Current allocated size: ",
-                             Diligent::FormatMemorySize(m_CurrAllocatedSize[IsHostVisible ? 1 : 0], 2));
-            OnPageDestroy(Page);
-            m_Pages.erase(curr_it);
+            auto& Page = *Info.pPage;
+
+            size_t       NumFreeBlocks    = 0;
+            VkDeviceSize MaxFreeBlockSize = 0;
+            Page.GetFreeBlockStats(NumFreeBlocks, MaxFreeBlockSize);
+
+            ++TypeStats.NumPages;
+            if (Page.IsEmpty())
+                ++TypeStats.NumEmptyPages;
+            TypeStats.AllocatedSize += Page.GetPageSize();
+            TypeStats.UsedSize += Page.GetUsedSize();
+            TypeStats.NumFreeBlocks += NumFreeBlocks;
+            TypeStats.MaxFreeBlockSize = std::max(TypeStats.MaxFreeBlockSize, MaxFreeBlockSize);
         }
+
+        VERIFY_EXPR(TypeStats.UsedSize <= TypeStats.AllocatedSize);
+        auto FreeSize = TypeStats.AllocatedSize - TypeStats.UsedSize;
+        if (FreeSize > 0)
+            TypeStats.Fragmentation = 1.f - static_cast<float>(TypeStats.MaxFreeBlockSize) / static_cast<float>(FreeSize);
+
+        Stats.push_back(TypeStats);
     }
+
+    return Stats;
+}
+
+VulkanMemoryManager::DefragmentationStats VulkanMemoryManager::BeginDefragmentation(const DefragmentationInfo& Info)
+{
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    if (m_Defrag.IsActive)
+    {
+        LOG_ERROR_MESSAGE("VulkanMemoryManager '", m_MgrName, "': defragmentation is already in progress");
+        return m_Defrag.Stats;
+    }
+
+    m_Defrag          = {};
+    m_Defrag.IsActive = true;
+
+    struct PageUsage
+    {
+        VulkanMemoryPage* pPage;
+        VkDeviceSize      UsedSize;
+    };
+    std::vector<PageUsage>    Pages;
+    std::vector<VkDeviceSize> FreeSizeAfter;
+    for (auto& TypePages : m_MemoryTypePages)
+    {
+        std::lock_guard<std::mutex> TypeLock{TypePages.Mtx};
+
+        Pages.clear();
+        for (auto& PageInfo : TypePages.Pages)
+        {
+            if (!PageInfo.pPage->IsEmpty())
+                Pages.push_back({PageInfo.pPage.get(), PageInfo.pPage->GetUsedSize()});
+        }
+        if (Pages.size() < 2)
+            continue;
+
+        // Allocations can only be moved between pages with the same allocate flags.
+        // Within every group, evacuate the least occupied pages first.
+        std::sort(Pages.begin(), Pages.end(),
+                  [](const PageUsage& lhs, const PageUsage& rhs) {
+                      const auto lhsFlags = lhs.pPage->GetAllocateFlags();
+                      const auto rhsFlags = rhs.pPage->GetAllocateFlags();
+                      return lhsFlags != rhsFlags ? lhsFlags < rhsFlags : lhs.UsedSize < rhs.UsedSize;
+                  });
+
+        size_t GroupStart = 0;
+        while (GroupStart < Pages.size())
+        {
+            size_t GroupEnd = GroupStart + 1;
+            while (GroupEnd < Pages.size() && Pages[GroupEnd].pPage->GetAllocateFlags() == Pages[GroupStart].pPage->GetAllocateFlags())
+                ++GroupEnd;
+
+            // FreeSizeAfter[i] is the total free size of pages i+1, ..., GroupEnd-1 that may receive the data.
+            FreeSizeAfter.assign(Pages.size(), 0);
+            for (size_t i = GroupEnd - 1; i > GroupStart; --i)
+                FreeSizeAfter[i - 1] = FreeSizeAfter[i] + (Pages[i].pPage->GetPageSize() - Pages[i].UsedSize);
+
+            VkDeviceSize BytesToMove = 0;
+            for (size_t i = GroupStart; i + 1 < GroupEnd; ++i)
+            {
+                auto* pPage    = Pages[i].pPage;
+                auto  UsedSize = Pages[i].UsedSize;
+                if (static_cast<float>(UsedSize) > Info.MaxPageOccupancy * static_cast<float>(pPage->GetPageSize()))
+                    break;
+
+                // Free space is fragmented, so this is only an upper bound. Allocations that do not
+                // fit will fail in AllocateForRelocation() and will stay where they are.
+                if (BytesToMove + UsedSize > FreeSizeAfter[i])
+                    break;
+
+                pPage->m_IsEvacuating.store(true);
+                BytesToMove += UsedSize;
+                ++m_Defrag.Stats.NumEvacuatedPages;
+            }
+            m_Defrag.Stats.BytesToMove += BytesToMove;
+
+            GroupStart = GroupEnd;
+        }
+    }
+
+    LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': started defragmentation. Pages to evacuate: ", m_Defrag.Stats.NumEvacuatedPages,
+                     ", bytes to move: ", Diligent::FormatMemorySize(m_Defrag.Stats.BytesToMove, 2));
+
+    return m_Defrag.Stats;
+}
+
+void VulkanMemoryManager::BeginDefragmentationFrame(VkDeviceSize MaxBytesPerFrame)
+{
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    VERIFY(m_Defrag.IsActive, "Defragmentation is not in progress");
+    m_Defrag.MaxBytesPerFrame     = MaxBytesPerFrame;
+    m_Defrag.FrameBytesRemaining  = MaxBytesPerFrame;
+    m_Defrag.FrameBudgetExhausted = false;
+}
+
+bool VulkanMemoryManager::IsDefragmenting()
+{
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    return m_Defrag.IsActive;
+}
+
+bool VulkanMemoryManager::IsFrameBudgetExhausted()
+{
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    return m_Defrag.FrameBudgetExhausted;
+}
+
+VulkanMemoryManager::DefragmentationStats VulkanMemoryManager::GetDefragmentationStats()
+{
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    return m_Defrag.Stats;
+}
+
+VulkanMemoryAllocation VulkanMemoryManager::AllocateForRelocation(const VulkanMemoryAllocation& SrcAllocation, VkDeviceSize Size, VkDeviceSize Alignment)
+{
+    DEV_CHECK_ERR(SrcAllocation.Page != nullptr, "Source allocation must not be empty");
+
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    if (!m_Defrag.IsActive || !SrcAllocation.Page->IsEvacuating())
+        return VulkanMemoryAllocation{};
+
+    if (m_Defrag.MaxBytesPerFrame != 0 && m_Defrag.FrameBytesRemaining < Size)
+    {
+        // The allocation will be requested again in the next frame
+        m_Defrag.FrameBudgetExhausted = true;
+        return VulkanMemoryAllocation{};
+    }
+
+    const auto& SrcPage       = *SrcAllocation.Page;
+    const bool  IsHostVisible = SrcPage.GetCPUMemory() != nullptr;
+
+    VulkanMemoryAllocation Allocation;
+    {
+        auto&                       TypePages = GetMemoryTypePages(SrcPage.GetMemoryTypeIndex(), IsHostVisible);
+        std::lock_guard<std::mutex> TypeLock{TypePages.Mtx};
+        Allocation = AllocateFromExistingPages(TypePages, SrcPage.GetAllocateFlags(), Size, Alignment);
+    }
+    if (Allocation.Page == nullptr)
+        return Allocation;
+
+    VERIFY_EXPR(Size + Diligent::AlignUp(Allocation.UnalignedOffset, Alignment) - Allocation.UnalignedOffset <= Allocation.Size);
+
+    OnNewAllocation(Allocation.Size, IsHostVisible);
+
+    if (m_Defrag.MaxBytesPerFrame != 0)
+        m_Defrag.FrameBytesRemaining -= Size;
+    m_Defrag.Stats.BytesMoved += Size;
+
+    return Allocation;
+}
+
+VulkanMemoryManager::DefragmentationStats VulkanMemoryManager::EndDefragmentation()
+{
+    std::lock_guard<std::mutex> Lock{m_PagesMtx};
+    if (!m_Defrag.IsActive)
+    {
+        LOG_ERROR_MESSAGE("VulkanMemoryManager '", m_MgrName, "': defragmentation is not in progress");
+        return {};
+    }
+
+    for (auto& TypePages : m_MemoryTypePages)
+    {
+        std::lock_guard<std::mutex> TypeLock{TypePages.Mtx};
+        for (auto& PageInfo : TypePages.Pages)
+        {
+            auto& Page = *PageInfo.pPage;
+            if (!Page.IsEvacuating())
+                continue;
+
+            // Allocations that have not been relocated keep the page alive. Otherwise the page
+            // is destroyed by ShrinkMemory() once the old allocations are released.
+            Page.m_ReleaseWhenEmpty.store(true);
+            Page.m_IsEvacuating.store(false);
+            m_HasPagesToRelease = true;
+        }
+    }
+
+    LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "': finished defragmentation. Moved ",
+                     Diligent::FormatMemorySize(m_Defrag.Stats.BytesMoved, 2), " out of ",
+                     Diligent::FormatMemorySize(m_Defrag.Stats.BytesToMove, 2), " from ", m_Defrag.Stats.NumEvacuatedPages,
+                     (m_Defrag.Stats.NumEvacuatedPages == 1 ? " page" : " pages"));
+
+    auto Stats = m_Defrag.Stats;
+    m_Defrag   = {};
+    return Stats;
+}
+
+void VulkanMemoryManager::OnNewAllocation(VkDeviceSize Size, bool IsHostVisible)
+{
+    const size_t stat_ind = IsHostVisible ? 1 : 0;
+
+    const auto CurrUsedSize = static_cast<VkDeviceSize>(m_CurrUsedSize[stat_ind].fetch_add(Size) + static_cast<int64_t>(Size));
+    UpdatePeakValue(m_PeakUsedSize[stat_ind], CurrUsedSize);
 }
 
 void VulkanMemoryManager::OnFreeAllocation(VkDeviceSize Size, bool IsHostVisible)
@@ -245,20 +652,25 @@ void VulkanMemoryManager::OnFreeAllocation(VkDeviceSize Size, bool IsHostVisible
 
 VulkanMemoryManager::~VulkanMemoryManager()
 {
-    auto PeakDeviceLocalPages = m_PeakAllocatedSize[0] / m_DeviceLocalPageSize;
-    auto PeakHostVisiblePages = m_PeakAllocatedSize[1] / m_HostVisiblePageSize;
+    const VkDeviceSize PeakAllocatedSize[] = {m_PeakAllocatedSize[0].load(), m_PeakAllocatedSize[1].load()};
+
+    auto PeakDeviceLocalPages = PeakAllocatedSize[0] / m_DeviceLocalPageSize;
+    auto PeakHostVisiblePages = PeakAllocatedSize[1] / m_HostVisiblePageSize;
     LOG_INFO_MESSAGE("VulkanMemoryManager '", m_MgrName, "' stats:\n"
                                                          "                       Peak used/allocated device-local memory size: ",
-                     Diligent::FormatMemorySize(m_PeakUsedSize[0], 2, m_PeakAllocatedSize[0]), " / ",
-                     Diligent::FormatMemorySize(m_PeakAllocatedSize[0], 2, m_PeakAllocatedSize[0]),
+                     Diligent::FormatMemorySize(m_PeakUsedSize[0].load(), 2, PeakAllocatedSize[0]), " / ",
+                     Diligent::FormatMemorySize(PeakAllocatedSize[0], 2, PeakAllocatedSize[0]),
                      " (", PeakDeviceLocalPages, (PeakDeviceLocalPages == 1 ? " page)" : " pages)"),
                      "\n                       Peak used/allocated host-visible memory size: ",
-                     Diligent::FormatMemorySize(m_PeakUsedSize[1], 2, m_PeakAllocatedSize[1]), " / ",
-                     Diligent::FormatMemorySize(m_PeakAllocatedSize[1], 2, m_PeakAllocatedSize[1]),
+                     Diligent::FormatMemorySize(m_PeakUsedSize[1].load(), 2, PeakAllocatedSize[1]), " / ",
+                     Diligent::FormatMemorySize(PeakAllocatedSize[1], 2, PeakAllocatedSize[1]),
                      " (", PeakHostVisiblePages, (PeakHostVisiblePages == 1 ? " page)" : " pages)"));
 
-    for (auto it = m_Pages.begin(); it != m_Pages.end(); ++it)
-        VERIFY(it->second.IsEmpty(), "The page contains outstanding allocations");
+    for (auto& TypePages : m_MemoryTypePages)
+    {
+        for (auto& PageInfo : TypePages.Pages)
+            VERIFY(PageInfo.pPage->IsEmpty(), "The page contains outstanding allocations");
+    }
     VERIFY(m_CurrUsedSize[0] == 0 && m_CurrUsedSize[1] == 0, "Not all allocations have been released");
 }
 
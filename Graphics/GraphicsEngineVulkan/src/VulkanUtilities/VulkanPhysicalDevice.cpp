@@ -307,6 +307,26 @@ VulkanPhysicalDevice::VulkanPhysicalDevice(VkPhysicalDevice      vkDevice,
             m_ExtFeatures.DrawIndirectCount = true;
         }
 
+        if (IsExtensionSupported(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME))
+        {
+            m_ExtFeatures.DescrUpdateTemplate = true;
+        }
+
+#    ifdef VK_EXT_multi_draw
+        if (IsExtensionSupported(VK_EXT_MULTI_DRAW_EXTENSION_NAME))
+        {
+            *NextFeat = &m_ExtFeatures.MultiDraw;
+            NextFeat  = &m_ExtFeatures.MultiDraw.pNext;
+
+            m_ExtFeatures.MultiDraw.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTI_DRAW_FEATURES_EXT;
+
+            *NextProp = &m_ExtProperties.MultiDraw;
+            NextProp  = &m_ExtProperties.MultiDraw.pNext;
+
+            m_ExtProperties.MultiDraw.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTI_DRAW_PROPERTIES_EXT;
+        }
+#    endif
+
         if (IsExtensionSupported(VK_KHR_MAINTENANCE3_EXTENSION_NAME))
         {
             *NextProp = &m_ExtProperties.Maintenance3;
@@ -0,0 +1,327 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of FrameGraph class
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/Texture.h"
+#include "../../GraphicsEngine/interface/Buffer.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Frame graph resource handle.
+using FrameGraphResource = Uint32;
+
+/// Invalid frame graph resource handle.
+static constexpr FrameGraphResource InvalidFrameGraphResource = ~0u;
+
+/// Frame graph statistics, see Diligent::FrameGraph::GetStatistics().
+struct FrameGraphStatistics
+{
+    /// The total number of passes added to the graph.
+    Uint32 NumPasses = 0;
+
+    /// The number of passes that were culled because their results are never used.
+    Uint32 NumCulledPasses = 0;
+
+    /// The number of state transitions recorded by the graph.
+    Uint32 NumBarriers = 0;
+
+    /// The number of transient resources used by the passes that were not culled.
+    Uint32 NumTransientResources = 0;
+
+    /// The number of texture and buffer objects that back transient resources.
+    /// Transient resources with identical descriptions and non-overlapping
+    /// lifetimes share the same object.
+    Uint32 NumPhysicalResources = 0;
+
+    /// The number of texture and buffer objects created during the last compilation.
+    /// Objects are kept between frames, so this value is typically zero once
+    /// the graph structure stabilizes.
+    Uint32 NumCreatedResources = 0;
+};
+
+/// Render-graph style frame scheduler.
+
+/// An application describes a frame as a sequence of passes. Every pass declares
+/// the resources it reads and writes along with the states the resources must be in.
+/// The graph then
+///   - culls the passes whose results are not used,
+///   - allocates transient resources, reusing the same objects for resources with
+///     non-overlapping lifetimes,
+///   - computes the minimal set of state transitions and issues them in one batch
+///     before every pass.
+///
+/// Typical frame:
+///
+///     Graph.Reset();
+///     auto GBuffer = Graph.CreateTexture(GBufferDesc);
+///     auto Output  = Graph.ImportTexture(pBackBuffer, RESOURCE_STATE_PRESENT);
+///     Graph.AddPass("GBuffer", DrawGBuffer).Write(GBuffer, RESOURCE_STATE_RENDER_TARGET);
+///     Graph.AddPass("Lighting", DrawLighting).Read(GBuffer, RESOURCE_STATE_SHADER_RESOURCE).Write(Output, RESOURCE_STATE_RENDER_TARGET);
+///     Graph.Compile();
+///     Graph.Execute(pContext);
+///
+/// \remarks    The graph transitions all resources itself, so pass callbacks should
+///             use RESOURCE_STATE_TRANSITION_MODE_VERIFY or RESOURCE_STATE_TRANSITION_MODE_NONE
+///             for the resources declared by the pass.
+///
+///             The class is not thread-safe.
+class FrameGraph
+{
+public:
+    /// Pass execution callback.
+
+    /// The callback receives the graph, which may be used to get the objects
+    /// of the pass resources, and the context to record the commands to.
+    using ExecuteFuncType = std::function<void(const FrameGraph& Graph, IDeviceContext* pContext)>;
+
+    /// Declares the resources used by a pass, see Diligent::FrameGraph::AddPass().
+    class PassBuilder
+    {
+    public:
+        /// Declares that the pass reads the resource in the specified state.
+        PassBuilder& Read(FrameGraphResource Resource, RESOURCE_STATE State);
+
+        /// Declares that the pass writes the resource in the specified state.
+        PassBuilder& Write(FrameGraphResource Resource, RESOURCE_STATE State);
+
+        /// Marks the pass as having side effects not visible to the graph (e.g. readback),
+        /// so that it is never culled.
+        PassBuilder& SetSideEffects();
+
+        /// Returns the index of the pass in the graph.
+        Uint32 GetPassIndex() const { return m_PassIndex; }
+
+    private:
+        friend FrameGraph;
+        PassBuilder(FrameGraph& Graph, Uint32 PassIndex) :
+            m_Graph{Graph},
+            m_PassIndex{PassIndex}
+        {}
+
+        FrameGraph&  m_Graph;
+        const Uint32 m_PassIndex;
+    };
+
+    /// Initializes the frame graph.
+
+    /// \param[in] pDevice - Render device that will be used to create transient resources.
+    explicit FrameGraph(IRenderDevice* pDevice);
+
+    // clang-format off
+    FrameGraph           (const FrameGraph&)  = delete;
+    FrameGraph& operator=(const FrameGraph&)  = delete;
+    FrameGraph           (      FrameGraph&&) = delete;
+    FrameGraph& operator=(      FrameGraph&&) = delete;
+    // clang-format on
+
+    ~FrameGraph();
+
+
+    /// Declares a transient texture.
+
+    /// \remarks    The texture object is allocated by Compile() and may be shared with other
+    ///             transient textures with the same description. Its contents is undefined
+    ///             before the first pass that writes it.
+    FrameGraphResource CreateTexture(const TextureDesc& Desc);
+
+    /// Declares a transient buffer, see CreateTexture().
+    FrameGraphResource CreateBuffer(const BufferDesc& Desc);
+
+    /// Imports an external texture into the graph.
+
+    /// \param[in] pTexture   - Texture to import. Its state must be known to the engine.
+    /// \param[in] FinalState - The state the texture will be transitioned to after the last pass.
+    ///                         If RESOURCE_STATE_UNKNOWN, the texture is left in the state of its last use.
+    ///
+    /// \remarks    Passes that write imported resources are never culled.
+    FrameGraphResource ImportTexture(ITexture* pTexture, RESOURCE_STATE FinalState = RESOURCE_STATE_UNKNOWN);
+
+    /// Imports an external buffer into the graph, see ImportTexture().
+    FrameGraphResource ImportBuffer(IBuffer* pBuffer, RESOURCE_STATE FinalState = RESOURCE_STATE_UNKNOWN);
+
+
+    /// Adds a new pass to the graph.
+
+    /// \param[in] Name        - Pass name, used for debug markers.
+    /// \param[in] ExecuteFunc - Function that records the pass commands.
+    ///
+    /// \return     Builder object that should be used to declare the pass resources.
+    ///             Passes are executed in the order they are added.
+    ///
+    /// \remarks    A pass is culled if none of the resources it writes is used later and
+    ///             the pass is not marked with PassBuilder::SetSideEffects().
+    PassBuilder AddPass(const char* Name, ExecuteFuncType ExecuteFunc);
+
+
+    /// Culls unused passes, allocates transient resources and computes state transitions.
+    void Compile();
+
+    /// Records all passes to the device context.
+    void Execute(IDeviceContext* pContext);
+
+    /// Records the passes to deferred contexts and executes the command lists in the immediate context.
+
+    /// \param[in] pImmediateContext   - Immediate context that will execute the command lists.
+    /// \param[in] ppDeferredContexts  - Deferred contexts to record the passes to. The passes are split
+    ///                                  into contiguous ranges, one range per context.
+    /// \param[in] NumDeferredContexts - The number of deferred contexts.
+    ///
+    /// \remarks    An application is responsible for calling FinishFrame() for deferred contexts.
+    void Execute(IDeviceContext*        pImmediateContext,
+                 IDeviceContext* const* ppDeferredContexts,
+                 Uint32                 NumDeferredContexts);
+
+    /// Removes all passes and resources from the graph.
+    /// Objects that back transient resources are kept for the next frame.
+    void Reset();
+
+    /// Releases all objects that back transient resources.
+    void ReleaseTransientResources();
+
+
+    /// Returns the texture object of the graph resource.
+
+    /// \remarks    For transient resources, the object is only available after Compile()
+    ///             and only if the resource is used by a pass that was not culled.
+    ITexture* GetTexture(FrameGraphResource Resource) const;
+
+    /// Returns the buffer object of the graph resource, see GetTexture().
+    IBuffer* GetBuffer(FrameGraphResource Resource) const;
+
+    /// Returns true if the pass was culled by the last call to Compile().
+    bool IsPassCulled(Uint32 PassIndex) const;
+
+    /// Returns the statistics of the last compilation.
+    const FrameGraphStatistics& GetStatistics() const
+    {
+        return m_Stats;
+    }
+
+private:
+    struct ResourceAccess
+    {
+        FrameGraphResource Resource;
+        RESOURCE_STATE     State;
+        bool               IsWrite;
+    };
+
+    struct PassInfo
+    {
+        std::string     Name;
+        ExecuteFuncType ExecuteFunc;
+
+        std::vector<ResourceAccess> Accesses;
+
+        bool HasSideEffects = false;
+        bool IsCulled       = false;
+
+        // Range of the pass barriers in m_Barriers
+        size_t FirstBarrier = 0;
+        size_t NumBarriers  = 0;
+    };
+
+    // Texture or buffer object that backs one or more transient resources
+    struct PhysicalResource
+    {
+        RefCntAutoPtr<IDeviceObject> pObject;
+
+        // Resource state at the end of the last executed frame
+        RESOURCE_STATE State = RESOURCE_STATE_UNDEFINED;
+
+        // Index of the last live pass that uses the object in the current frame
+        Uint32 LastUse = ~0u;
+
+        bool IsTexture = false;
+    };
+
+    struct ResourceInfo
+    {
+        std::string Name;
+        bool        IsTexture  = false;
+        bool        IsImported = false;
+
+        // Transient resource description. Name pointers are not valid.
+        TextureDesc TexDesc;
+        BufferDesc  BuffDesc;
+
+        // Imported object or the object of the physical resource
+        IDeviceObject* pObject = nullptr;
+
+        RefCntAutoPtr<IDeviceObject> pImportedObject;
+        RESOURCE_STATE               FinalState = RESOURCE_STATE_UNKNOWN;
+
+        // Index of the physical resource in m_PhysicalResources
+        size_t PhysicalResource = ~size_t{0};
+
+        // Number of live passes that read the resource, used for culling
+        Uint32 RefCount = 0;
+
+        Uint32 FirstUse = ~0u;
+        Uint32 LastUse  = 0;
+    };
+
+    void AddAccess(Uint32 PassIndex, FrameGraphResource Resource, RESOURCE_STATE State, bool IsWrite);
+
+    void CullPasses();
+    void AllocateTransientResources();
+    void ComputeBarriers();
+
+    void ExecutePasses(IDeviceContext* pContext, size_t StartPass, size_t EndPass);
+    void TransitionFinalStates(IDeviceContext* pContext);
+    void CommitPhysicalStates();
+
+    RefCntAutoPtr<IRenderDevice> m_pDevice;
+
+    std::vector<PassInfo>         m_Passes;
+    std::vector<ResourceInfo>     m_Resources;
+    std::vector<PhysicalResource> m_PhysicalResources;
+
+    std::vector<StateTransitionDesc> m_Barriers;
+    // Transitions of imported resources to their final states
+    size_t m_FirstFinalBarrier = 0;
+
+    // States of the physical resources after the graph is executed
+    std::vector<RESOURCE_STATE> m_PhysicalEndStates;
+
+    bool m_IsCompiled = false;
+
+    FrameGraphStatistics m_Stats;
+};
+
+} // namespace Diligent
@@ -137,8 +137,51 @@ struct ComputeMipLevelAttribs
 #endif
 };
 typedef struct ComputeMipLevelAttribs ComputeMipLevelAttribs;
+
+
+/// ComputeMipChain function attributes
+struct ComputeMipChainAttribs
+{
+    /// Texture format.
+    TEXTURE_FORMAT Format      DEFAULT_INITIALIZER(TEX_FORMAT_UNKNOWN);
+
+    /// Most detailed mip level width.
+    Uint32 Width               DEFAULT_INITIALIZER(0);
+
+    /// Most detailed mip level height.
+    Uint32 Height              DEFAULT_INITIALIZER(0);
+
+    /// The number of mip levels, including the most detailed one.
+    /// If 0, the full mip chain is computed.
+    Uint32 NumMipLevels        DEFAULT_INITIALIZER(0);
+
+    /// Pointers to the mip level data. Level 0 must contain the source data,
+    /// levels 1 to NumMipLevels-1 are computed.
+    void* const* ppMipData     DEFAULT_INITIALIZER(nullptr);
+
+    /// Mip level data strides, in bytes.
+    const size_t* pMipStrides  DEFAULT_INITIALIZER(nullptr);
+
+    /// Filter type.
+    MIP_FILTER_TYPE FilterType DEFAULT_INITIALIZER(MIP_FILTER_TYPE_DEFAULT);
+
+    /// Alpha cutoff value, see ComputeMipLevelAttribs::AlphaCutoff.
+    float AlphaCutoff          DEFAULT_INITIALIZER(0);
+
+    /// The number of threads to use.
+    /// If 0, the number of hardware threads is used.
+    Uint32 NumThreads          DEFAULT_INITIALIZER(0);
+};
+typedef struct ComputeMipChainAttribs ComputeMipChainAttribs;
 // clang-format on
 
 void DILIGENT_GLOBAL_FUNCTION(ComputeMipLevel)(const ComputeMipLevelAttribs REF Attribs);
 
+/// Computes the mip chain of a texture on the CPU.
+
+/// \remarks   Mip levels are computed one after another, while each level is split
+///             between multiple threads. The results are identical to calling
+///             ComputeMipLevel for every level.
+void DILIGENT_GLOBAL_FUNCTION(ComputeMipChain)(const ComputeMipChainAttribs REF Attribs);
+
 DILIGENT_END_NAMESPACE // namespace Diligent
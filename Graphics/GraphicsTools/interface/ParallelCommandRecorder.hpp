@@ -0,0 +1,132 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of ParallelCommandRecorder class
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "../../GraphicsEngine/interface/DeviceContext.h"
+#include "../../GraphicsEngine/interface/CommandList.h"
+#include "../../../Common/interface/RefCntAutoPtr.hpp"
+#include "../../../Common/interface/ThreadPool.hpp"
+
+namespace Diligent
+{
+
+/// Parallel command recorder create information.
+struct ParallelCommandRecorderCreateInfo
+{
+    /// Immediate context that executes the recorded command lists.
+    IDeviceContext* pImmediateContext = nullptr;
+
+    /// Deferred contexts to record commands to.
+    IDeviceContext* const* ppDeferredContexts = nullptr;
+
+    /// The number of deferred contexts.
+    /// One recording thread is used for every deferred context.
+    Uint32 NumDeferredContexts = 0;
+
+    /// The minimum number of packets recorded by one context.
+    /// Small workloads are recorded by fewer contexts to avoid threading overhead.
+    Uint32 MinPacketsPerContext = 64;
+};
+
+/// Records a list of packets (e.g. draw calls) on multiple deferred contexts in parallel.
+
+/// The packets are split into contiguous ranges, one range per deferred context. The
+/// ranges are recorded on worker threads, and the command lists are executed by the
+/// immediate context in the packet order with one ExecuteCommandLists() call.
+///
+/// \remarks    The recording function is called concurrently from multiple threads. It must
+///             only use RESOURCE_STATE_TRANSITION_MODE_VERIFY or RESOURCE_STATE_TRANSITION_MODE_NONE,
+///             as resource states cannot be safely transitioned from multiple threads. Every deferred
+///             context has its own dynamic heap that allocates memory blocks from the device-wide
+///             dynamic memory pool, so dynamic buffers may be mapped in the recording function.
+class ParallelCommandRecorder
+{
+public:
+    /// Packet recording function.
+
+    /// \param[in] pContext    - Deferred context to record commands to. The context does not inherit
+    ///                          any state, so the function must set all states required by the packets.
+    /// \param[in] StartPacket - Index of the first packet to record.
+    /// \param[in] EndPacket   - Index of the packet after the last one to record.
+    using RecordFuncType = std::function<void(IDeviceContext* pContext, Uint32 StartPacket, Uint32 EndPacket)>;
+
+    explicit ParallelCommandRecorder(const ParallelCommandRecorderCreateInfo& CreateInfo);
+
+    // clang-format off
+    ParallelCommandRecorder           (const ParallelCommandRecorder&)  = delete;
+    ParallelCommandRecorder& operator=(const ParallelCommandRecorder&)  = delete;
+    ParallelCommandRecorder           (      ParallelCommandRecorder&&) = delete;
+    ParallelCommandRecorder& operator=(      ParallelCommandRecorder&&) = delete;
+    // clang-format on
+
+    ~ParallelCommandRecorder();
+
+    /// Records the packets and executes the command lists in the immediate context.
+
+    /// \param[in] NumPackets - The total number of packets.
+    /// \param[in] RecordFunc - Function that records a range of packets, see RecordFuncType.
+    ///
+    /// \return     The number of deferred contexts that were used.
+    ///
+    /// \remarks    The method blocks until all packets are recorded. If the recording
+    ///             function throws an exception, no command lists are executed and
+    ///             the exception is rethrown.
+    Uint32 Record(Uint32 NumPackets, const RecordFuncType& RecordFunc);
+
+    /// Calls FinishFrame() for all deferred contexts.
+
+    /// \remarks    This method must be called after the immediate context finishes the frame.
+    void FinishFrame();
+
+    /// Returns the number of deferred contexts.
+    Uint32 GetNumContexts() const
+    {
+        return static_cast<Uint32>(m_DeferredContexts.size());
+    }
+
+private:
+    void RecordRange(Uint32 CtxIdx, Uint32 StartPacket, Uint32 EndPacket, const RecordFuncType& RecordFunc);
+
+    RefCntAutoPtr<IDeviceContext>              m_pImmediateContext;
+    std::vector<RefCntAutoPtr<IDeviceContext>> m_DeferredContexts;
+    std::vector<RefCntAutoPtr<ICommandList>>   m_CommandLists;
+
+    const Uint32 m_MinPacketsPerContext;
+
+    // The first range is recorded by the calling thread
+    std::unique_ptr<ThreadPool> m_pThreadPool;
+};
+
+} // namespace Diligent
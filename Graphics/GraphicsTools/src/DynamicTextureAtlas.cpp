@@ -30,9 +30,8 @@
 #include <mutex>
 #include <algorithm>
 #include <atomic>
-#include <unordered_map>
-#include <map>
-#include <set>
+#include <array>
+#include <memory>
 
 #include "DynamicAtlasManager.hpp"
 #include "DynamicTextureArray.hpp"
@@ -42,6 +41,7 @@
 #include "DefaultRawMemoryAllocator.hpp"
 #include "GraphicsAccessories.hpp"
 #include "Align.hpp"
+#include "PlatformMisc.hpp"
 
 namespace Diligent
 {
@@ -135,6 +135,9 @@ private:
 namespace
 {
 
+// Atlas manager of a single slice.
+// The slice is active while it is owned by a slice batch. As soon as the last region
+// is freed, the slice is deactivated and may be returned to the atlas.
 class ThreadSafeAtlasManager
 {
 public:
@@ -149,132 +152,91 @@ public:
     ThreadSafeAtlasManager& operator=(      ThreadSafeAtlasManager&&) = delete;
     // clang-format on
 
-    class ManagerLock
+    bool IsActive() const
     {
-    public:
-        ManagerLock() noexcept {}
-
-        // clang-format off
-        ManagerLock           (const ManagerLock&) = delete;
-        ManagerLock& operator=(const ManagerLock&) = delete;
-        // clang-format on
-
-        ManagerLock(ManagerLock&& Other) noexcept :
-            pAtlasMgr{Other.pAtlasMgr}
-        {
-            Other.pAtlasMgr = nullptr;
-        }
-
-        ManagerLock& operator=(ManagerLock&& Other) noexcept
-        {
-            pAtlasMgr       = Other.pAtlasMgr;
-            Other.pAtlasMgr = nullptr;
-            return *this;
-        }
-
-        int Release()
-        {
-            int UseCnt = -1;
-            if (pAtlasMgr != nullptr)
-            {
-                UseCnt    = pAtlasMgr->ReleaseUse();
-                pAtlasMgr = nullptr;
-            }
-            return UseCnt;
-        }
-
-        ~ManagerLock()
-        {
-            Release();
-        }
-
-        explicit operator bool() const
-        {
-            return pAtlasMgr != nullptr;
-        }
-
-        DynamicAtlasManager::Region Allocate(Uint32 Width, Uint32 Height)
-        {
-            VERIFY_EXPR(pAtlasMgr != nullptr);
-            VERIFY_EXPR(pAtlasMgr->UseCount > 0);
-            std::lock_guard<std::mutex> Lock{pAtlasMgr->Mtx};
-            return pAtlasMgr->Mgr.Allocate(Width, Height);
-        }
-
-        // Frees a region and returns true if the atlas is empty
-        bool Free(DynamicAtlasManager::Region&& R)
-        {
-            VERIFY_EXPR(pAtlasMgr != nullptr);
-            VERIFY_EXPR(pAtlasMgr->UseCount > 0);
-            std::lock_guard<std::mutex> Lock{pAtlasMgr->Mtx};
-            pAtlasMgr->Mgr.Free(std::move(R));
-            return pAtlasMgr->Mgr.IsEmpty();
-        }
-
-        bool IsEmpty()
-        {
-            VERIFY_EXPR(pAtlasMgr != nullptr);
-            VERIFY_EXPR(pAtlasMgr->UseCount > 0);
-            std::lock_guard<std::mutex> Lock{pAtlasMgr->Mtx};
-            return pAtlasMgr->Mgr.IsEmpty();
-        }
-
-    private:
-        friend class ThreadSafeAtlasManager;
+        return Active.load(std::memory_order_acquire);
+    }
 
-        explicit ManagerLock(ThreadSafeAtlasManager& AtlasMg) :
-            pAtlasMgr{&AtlasMg}
-        {
-            AtlasMg.AddUse();
-        }
+    // Allocates a region from the slice. If Wait is false and the slice is locked by
+    // another thread, the method returns false without waiting for the lock.
+    bool Allocate(Uint32 Width, Uint32 Height, bool Wait, DynamicAtlasManager::Region& R)
+    {
+        std::unique_lock<std::mutex> Lock{Mtx, std::defer_lock};
+        if (Wait)
+            Lock.lock();
+        else if (!Lock.try_lock())
+            return false;
 
-        ThreadSafeAtlasManager* pAtlasMgr = nullptr;
-    };
+        // The slice could've been deactivated by another thread after the caller checked IsActive()
+        if (Active.load(std::memory_order_relaxed))
+            R = Mgr.Allocate(Width, Height);
 
-    ManagerLock Lock()
-    {
-        return ManagerLock{*this};
+        return true;
     }
 
-    int GetUseCount() const
+    // Activates the slice and allocates the first region from it.
+    // The slice is only activated if the allocation succeeds.
+    DynamicAtlasManager::Region Activate(Uint32 Width, Uint32 Height)
     {
-        return UseCount.load();
+        std::lock_guard<std::mutex> Lock{Mtx};
+        VERIFY(!Active.load(std::memory_order_relaxed), "The slice is already active. This is a bug.");
+        VERIFY_EXPR(Mgr.IsEmpty());
+
+        auto R = Mgr.Allocate(Width, Height);
+        if (!R.IsEmpty())
+            Active.store(true, std::memory_order_release);
+        return R;
     }
 
-private:
-    friend ManagerLock;
-
-    int AddUse()
+    // Frees a region and returns true if the slice became empty and was deactivated
+    bool Free(DynamicAtlasManager::Region&& R)
     {
-        auto Uses = UseCount.fetch_add(1) + 1;
-        VERIFY_EXPR(Uses > 0);
-        return Uses;
-    }
+        std::lock_guard<std::mutex> Lock{Mtx};
+        VERIFY(Active.load(std::memory_order_relaxed), "Freeing region from inactive slice. This is a bug.");
 
-    int ReleaseUse()
-    {
-        auto Uses = UseCount.fetch_add(-1) - 1;
-        VERIFY_EXPR(Uses >= 0);
-        return Uses;
+        Mgr.Free(std::move(R));
+        if (!Mgr.IsEmpty())
+            return false;
+
+        // Deactivate the slice while holding the mutex so that no other thread
+        // is able to allocate from it after it has been found empty.
+        Active.store(false, std::memory_order_release);
+        return true;
     }
 
 private:
     std::mutex          Mtx;
     DynamicAtlasManager Mgr;
 
-    std::atomic_int UseCount{0};
+    std::atomic<bool> Active{false};
 };
 
 
-struct SliceBatch
+// Slices used by allocations with the same alignment.
+// Slice managers are created on first use and are never destroyed until the batch
+// is released, so that they can be looked up without locking.
+class SliceBatch
 {
-    SliceBatch(const uint2 AtlasDim) noexcept :
-        m_AtlasDim{AtlasDim}
-    {}
+public:
+    SliceBatch(const uint2& AtlasDim, Uint32 MaxSliceCount) :
+        // clang-format off
+        m_AtlasDim     {AtlasDim},
+        m_MaxSliceCount{MaxSliceCount},
+        m_Slices       {new std::atomic<ThreadSafeAtlasManager*>[MaxSliceCount]}
+    // clang-format on
+    {
+        for (Uint32 i = 0; i < m_MaxSliceCount; ++i)
+            m_Slices[i].store(nullptr);
+    }
 
     ~SliceBatch()
     {
-        VERIFY(m_Slices.empty(), "Not all slice managers have been released.");
+        for (Uint32 i = 0; i < m_MaxSliceCount; ++i)
+        {
+            auto* pMgr = m_Slices[i].load();
+            VERIFY(pMgr == nullptr || !pMgr->IsActive(), "Slice ", i, " has not been released.");
+            delete pMgr;
+        }
     }
 
     // clang-format off
@@ -284,85 +246,76 @@ struct SliceBatch
     SliceBatch& operator=(      SliceBatch&&) = delete;
     // clang-format on
 
-    ThreadSafeAtlasManager::ManagerLock LockSlice(Uint32 Slice)
+    // Tries to allocate a region from one of the active slices in the range [0, NumSlices),
+    // starting with FirstSlice and wrapping around. In the first pass, slices locked by other
+    // threads are skipped, so that concurrent threads spread across different slices rather
+    // than wait on the same mutex.
+    DynamicAtlasManager::Region Allocate(Uint32 Width, Uint32 Height, Uint32 NumSlices, Uint32 FirstSlice, Uint32& Slice)
     {
-        std::lock_guard<std::mutex> Lock{m_Mtx};
+        VERIFY_EXPR(NumSlices <= m_MaxSliceCount);
+        for (Uint32 Pass = 0; Pass < 2; ++Pass)
+        {
+            const auto Wait             = Pass > 0;
+            bool       SkippedBusySlice = false;
+            for (Uint32 i = 0; i < NumSlices; ++i)
+            {
+                Slice = (FirstSlice + i) % NumSlices;
 
-        auto it = m_Slices.find(Slice);
-        // NB: Lock() atomically increases the use count of the slice while we hold the mutex.
-        return it != m_Slices.end() ? it->second.Lock() : ThreadSafeAtlasManager::ManagerLock{};
-    }
+                auto* pMgr = m_Slices[Slice].load(std::memory_order_acquire);
+                if (pMgr == nullptr || !pMgr->IsActive())
+                    continue;
 
-    ThreadSafeAtlasManager::ManagerLock LockSliceAfter(Uint32& Slice)
-    {
-        std::lock_guard<std::mutex> Lock{m_Mtx};
+                DynamicAtlasManager::Region R;
+                if (!pMgr->Allocate(Width, Height, Wait, R))
+                {
+                    SkippedBusySlice = true;
+                    continue;
+                }
 
-        auto it = m_Slices.lower_bound(Slice);
-        if (it != m_Slices.end())
-        {
-            Slice = it->first;
-            // NB: Lock() atomically increases the use count of the slice while we hold the mutex.
-            return it->second.Lock();
+                if (!R.IsEmpty())
+                    return R;
+            }
+
+            if (!SkippedBusySlice)
+                break;
         }
 
         return {};
     }
 
-    ThreadSafeAtlasManager::ManagerLock AddSlice(Uint32 Slice)
+    // Activates the slice that the caller has exclusively acquired from the atlas
+    // and allocates the first region from it.
+    DynamicAtlasManager::Region ActivateSlice(Uint32 Slice, Uint32 Width, Uint32 Height)
     {
-        std::lock_guard<std::mutex> Lock{m_Mtx};
-
-        VERIFY(m_Slices.find(Slice) == m_Slices.end(), "Slice ", Slice, " already present in the batch.");
-        auto it = m_Slices.emplace(Slice, m_AtlasDim).first;
-        // NB: Lock() atomically increases the use count of the slice while we hold the mutex.
-        return it->second.Lock();
+        VERIFY_EXPR(Slice < m_MaxSliceCount);
+        auto* pMgr = m_Slices[Slice].load(std::memory_order_acquire);
+        if (pMgr == nullptr)
+        {
+            // Only the thread that owns the slice may create its manager
+            pMgr = new ThreadSafeAtlasManager{m_AtlasDim};
+            m_Slices[Slice].store(pMgr, std::memory_order_release);
+        }
+        return pMgr->Activate(Width, Height);
     }
 
-    bool Purge(Uint32 Slice)
+    // Frees a region and returns true if the slice became empty and was deactivated.
+    bool Free(Uint32 Slice, DynamicAtlasManager::Region&& R)
     {
-        std::lock_guard<std::mutex> Lock{m_Mtx};
-
-        auto it = m_Slices.find(Slice);
-        if (it != m_Slices.end())
+        VERIFY_EXPR(Slice < m_MaxSliceCount);
+        auto* pMgr = m_Slices[Slice].load(std::memory_order_acquire);
+        if (pMgr == nullptr)
         {
-            // Use count may only be incremented under the mutex. If use count is zero,
-            // no other thread may be accessing this slice since we hold the mutex.
-            if (it->second.GetUseCount() == 0)
-            {
-                // Check that the slice is empty. It is very important to check this only
-                // after we checked the use count.
-                // If the slice is empty, but the use count is not zero, another thread may
-                // allocate from this slice after we checked if it is empty.
-                auto MgrLock = it->second.Lock();
-                VERIFY_EXPR(MgrLock);
-                // The slice could've been used by another thread and may not be empty anymore
-                if (MgrLock.IsEmpty())
-                {
-                    auto UseCnt = MgrLock.Release();
-                    VERIFY(UseCnt == 0, "There must be no other uses of this slice since we checked the use count already.");
-                    m_Slices.erase(it);
-                    return true;
-                }
-                else
-                {
-                    return false;
-                }
-            }
-            else
-            {
-                return false;
-            }
+            UNEXPECTED("Slice ", Slice, " is not found in the batch");
+            return false;
         }
-
-        return false;
+        return pMgr->Free(std::move(R));
     }
 
 private:
-    const uint2 m_AtlasDim;
+    const uint2  m_AtlasDim;
+    const Uint32 m_MaxSliceCount;
 
-    std::mutex m_Mtx;
-    // For every alignment, we keep a list of slice managers sorted by the slice index.
-    std::map<Uint32, ThreadSafeAtlasManager> m_Slices;
+    std::unique_ptr<std::atomic<ThreadSafeAtlasManager*>[]> m_Slices;
 };
 
 } // namespace
@@ -389,7 +342,7 @@ public:
         // clang-format off
         m_MinAlignment    {CreateInfo.MinAlignment},
         m_ExtraSliceCount {CreateInfo.ExtraSliceCount},
-        m_MaxSliceCount   {CreateInfo.Desc.Type == RESOURCE_DIM_TEX_2D_ARRAY ? std::min(CreateInfo.MaxSliceCount, Uint32{2048}) : 1},
+        m_MaxSliceCount   {CreateInfo.Desc.Type == RESOURCE_DIM_TEX_2D_ARRAY ? std::min(CreateInfo.MaxSliceCount, Uint32{MaxSupportedSliceCount}) : 1},
         m_Silent          {CreateInfo.Silent},
         m_SuballocationsAllocator
         {
@@ -423,8 +376,13 @@ public:
                 LOG_ERROR_AND_THROW("Texture height (", m_Desc.Height, ") is not a multiple of minimum alignment (", m_MinAlignment, ")");
         }
 
-        for (Uint32 i = 0; i < m_MaxSliceCount; ++i)
-            m_AvailableSlices.insert(i);
+        for (Uint32 i = 0; i < m_AvailableSlicesMask.size(); ++i)
+        {
+            const auto NumBits = std::min(m_MaxSliceCount - std::min(i * 64, m_MaxSliceCount), 64u);
+            m_AvailableSlicesMask[i].store(NumBits < 64 ? (Uint64{1} << NumBits) - 1 : ~Uint64{0});
+        }
+        for (auto& pBatch : m_SliceBatches)
+            pBatch.store(nullptr);
 
         m_TexArraySize.store(m_Desc.ArraySize);
         if (m_Desc.Type == RESOURCE_DIM_TEX_2D)
@@ -449,7 +407,17 @@ public:
         VERIFY_EXPR(m_AllocatedArea.load() == 0);
         VERIFY_EXPR(m_UsedArea.load() == 0);
         VERIFY_EXPR(m_AllocationCount.load() == 0);
-        VERIFY_EXPR(m_AvailableSlices.size() == m_MaxSliceCount);
+#ifdef DILIGENT_DEBUG
+        {
+            Uint32 NumAvailableSlices = 0;
+            for (const auto& Mask : m_AvailableSlicesMask)
+                NumAvailableSlices += PlatformMisc::CountOneBits(Mask.load());
+            VERIFY_EXPR(NumAvailableSlices == m_MaxSliceCount);
+        }
+#endif
+
+        for (auto& pBatch : m_SliceBatches)
+            delete pBatch.load();
     }
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DynamicTextureAtlas, TBase)
@@ -512,32 +480,29 @@ public:
         auto* pBatch = GetSliceBatch(Alignment, m_Desc.Width / Alignment, m_Desc.Height / Alignment);
         VERIFY_EXPR(pBatch != nullptr);
 
-        DynamicAtlasManager::Region Subregion;
+        const auto RegionWidth  = AlignedWidth / Alignment;
+        const auto RegionHeight = AlignedHeight / Alignment;
 
-        Uint32 Slice = 0;
-        while (Slice < m_MaxSliceCount)
-        {
-            // Lock the first available slice with index >= Slice
-            auto SliceLock = pBatch->LockSliceAfter(Slice);
-            if (!SliceLock)
-            {
-                Slice = GetNextAvailableSlice();
-                if (Slice == ~Uint32{0})
-                    break;
-
-                SliceLock = pBatch->AddSlice(Slice);
-                VERIFY_EXPR(SliceLock);
-            }
+        // Only slices below the current array size may be active.
+        // Every thread starts searching from its own slice to reduce contention.
+        const auto NumSlices  = std::min(m_TexArraySize.load(), m_MaxSliceCount);
+        const auto FirstSlice = NumSlices > 0 ? GetThreadId() % NumSlices : 0;
 
-            if (SliceLock)
+        Uint32 Slice     = 0;
+        auto   Subregion = pBatch->Allocate(RegionWidth, RegionHeight, NumSlices, FirstSlice, Slice);
+        if (Subregion.IsEmpty())
+        {
+            // There is no space in the active slices - acquire a new one
+            Slice = GetNextAvailableSlice();
+            if (Slice != ~Uint32{0})
             {
-                Subregion = SliceLock.Allocate(AlignedWidth / Alignment, AlignedHeight / Alignment);
-                if (!Subregion.IsEmpty())
-                    break;
+                Subregion = pBatch->ActivateSlice(Slice, RegionWidth, RegionHeight);
+                if (Subregion.IsEmpty())
+                {
+                    // The region does not fit into an empty slice
+                    RecycleSlice(Slice);
+                }
             }
-
-            // Failed to allocate the region - try the next slice
-            ++Slice;
         }
 
         if (Subregion.IsEmpty())
@@ -581,19 +546,10 @@ public:
                ". This may only happen when double-freeing the allocation or "
                "freeing an allocation that was not allocated from this atlas.");
 
-        bool DeleteSlice = false;
-        {
-            auto SliceLock = pBatch->LockSlice(Slice);
-            VERIFY(SliceLock, "Slice ", Slice, " is not found in the batch of slices with alignment ", Alignment);
-            DeleteSlice = SliceLock.Free(std::move(Subregion));
-        }
-
-        if (DeleteSlice)
+        if (pBatch->Free(Slice, std::move(Subregion)))
         {
-            if (pBatch->Purge(Slice))
-            {
-                RecycleSlice(Slice);
-            }
+            // The slice is empty and has been deactivated - return it to the atlas
+            RecycleSlice(Slice);
         }
     }
 
@@ -635,48 +591,80 @@ public:
     }
 
 private:
-    Uint32 GetNextAvailableSlice()
+    static Uint32 GetThreadId()
     {
-        std::lock_guard<std::mutex> Lock{m_AvailableSlicesMtx};
-        if (m_AvailableSlices.empty())
-            return ~Uint32{0};
-
-        auto FirstFreeSlice = *m_AvailableSlices.begin();
-        VERIFY_EXPR(FirstFreeSlice < m_MaxSliceCount);
-        m_AvailableSlices.erase(m_AvailableSlices.begin());
+        static std::atomic<Uint32>     NumThreads{0};
+        static thread_local const auto ThreadId = NumThreads.fetch_add(1);
+        return ThreadId;
+    }
 
-        while (m_TexArraySize <= FirstFreeSlice)
+    Uint32 GetNextAvailableSlice()
+    {
+        // Find the first available slice and atomically mark it as used
+        for (Uint32 i = 0; i < m_AvailableSlicesMask.size(); ++i)
         {
-            const auto ExtraSliceCount = m_ExtraSliceCount != 0 ?
-                m_ExtraSliceCount :
-                std::max(m_TexArraySize.load(), 1u);
+            auto& MaskWord = m_AvailableSlicesMask[i];
 
-            m_TexArraySize.store(std::min(m_TexArraySize + ExtraSliceCount, m_MaxSliceCount));
+            Uint64 Mask = MaskWord.load();
+            while (Mask != 0)
+            {
+                const auto Bit = PlatformMisc::GetLSB(Mask);
+                // On failure, Mask is updated with the current value
+                if (MaskWord.compare_exchange_weak(Mask, Mask & ~(Uint64{1} << Bit)))
+                {
+                    const auto FirstFreeSlice = i * 64 + Bit;
+                    VERIFY_EXPR(FirstFreeSlice < m_MaxSliceCount);
+
+                    auto ArraySize = m_TexArraySize.load();
+                    while (ArraySize <= FirstFreeSlice)
+                    {
+                        const auto ExtraSliceCount = m_ExtraSliceCount != 0 ?
+                            m_ExtraSliceCount :
+                            std::max(ArraySize, 1u);
+
+                        // On failure, ArraySize is updated with the current value
+                        const auto NewArraySize = std::min(ArraySize + ExtraSliceCount, m_MaxSliceCount);
+                        if (m_TexArraySize.compare_exchange_weak(ArraySize, NewArraySize))
+                            ArraySize = NewArraySize;
+                    }
+
+                    return FirstFreeSlice;
+                }
+            }
         }
 
-        return FirstFreeSlice;
+        return ~Uint32{0};
     }
 
     void RecycleSlice(Uint32 Slice)
     {
-        std::lock_guard<std::mutex> Lock{m_AvailableSlicesMtx};
-        VERIFY(m_AvailableSlices.find(Slice) == m_AvailableSlices.end(), "Slice ", Slice, " is already in the available slices list. This is a bug.");
-        m_AvailableSlices.insert(Slice);
+        VERIFY_EXPR(Slice < m_MaxSliceCount);
+        const auto Bit      = Uint64{1} << (Slice % 64);
+        const auto PrevMask = m_AvailableSlicesMask[Slice / 64].fetch_or(Bit);
+        VERIFY((PrevMask & Bit) == 0, "Slice ", Slice, " is already in the available slices list. This is a bug.");
+        (void)PrevMask;
     }
 
     SliceBatch* GetSliceBatch(Uint32 Alignment, Uint32 AtlasWidth = 0, Uint32 AtlasHeight = 0)
     {
-        std::lock_guard<std::mutex> Lock{m_SliceBatchesByAlignmentMtx};
+        VERIFY_EXPR(IsPowerOfTwo(Alignment));
+        auto& pBatchSlot = m_SliceBatches[PlatformMisc::GetLSB(Alignment)];
 
-        // Get the list of slices for this alignment
-        auto BatchIt = m_SliceBatchesByAlignment.find(Alignment);
-        if (BatchIt == m_SliceBatchesByAlignment.end() && AtlasWidth != 0 && AtlasHeight != 0)
-            BatchIt = m_SliceBatchesByAlignment.emplace(Alignment, uint2{AtlasWidth, AtlasHeight}).first;
+        auto* pBatch = pBatchSlot.load(std::memory_order_acquire);
+        if (pBatch == nullptr && AtlasWidth != 0 && AtlasHeight != 0)
+        {
+            std::unique_ptr<SliceBatch> pNewBatch{new SliceBatch{uint2{AtlasWidth, AtlasHeight}, m_MaxSliceCount}};
+            // On failure, pBatch is updated with the batch created by another thread
+            if (pBatchSlot.compare_exchange_strong(pBatch, pNewBatch.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+                pBatch = pNewBatch.release();
+        }
 
-        return BatchIt != m_SliceBatchesByAlignment.end() ? &BatchIt->second : nullptr;
+        return pBatch;
     }
 
 private:
+    static constexpr Uint32 MaxSupportedSliceCount = 2048;
+
     const std::string m_Name;
     const TextureDesc m_Desc;
 
@@ -697,13 +685,12 @@ private:
     std::atomic<Int64> m_AllocatedArea{0};
     std::atomic<Int64> m_UsedArea{0};
 
-    std::mutex m_SliceBatchesByAlignmentMtx;
-    // Alignment -> slice batch
-    std::unordered_map<Uint32, SliceBatch> m_SliceBatchesByAlignment;
+    // Slice batches indexed by the alignment bit
+    std::array<std::atomic<SliceBatch*>, 32> m_SliceBatches;
 
-    // Keep available slice indices sorted.
-    std::mutex       m_AvailableSlicesMtx;
-    std::set<Uint32> m_AvailableSlices;
+    // Bit mask of slices that are not used by any batch.
+    // A slice is acquired by atomically clearing its bit and is recycled by setting it back.
+    std::array<std::atomic<Uint64>, (MaxSupportedSliceCount + 63) / 64> m_AvailableSlicesMask;
 };
 
 
@@ -0,0 +1,647 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "FrameGraph.hpp"
+
+#include <algorithm>
+
+#include "DebugUtilities.hpp"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// clang-format off
+constexpr RESOURCE_STATE WriteStates =
+    RESOURCE_STATE_RENDER_TARGET    |
+    RESOURCE_STATE_UNORDERED_ACCESS |
+    RESOURCE_STATE_DEPTH_WRITE      |
+    RESOURCE_STATE_STREAM_OUT       |
+    RESOURCE_STATE_COPY_DEST        |
+    RESOURCE_STATE_RESOLVE_DEST     |
+    RESOURCE_STATE_BUILD_AS_WRITE;
+// clang-format on
+
+// Returns true if the resource must be transitioned from CurrState before it can be used in RequiredState.
+bool NeedsTransition(RESOURCE_STATE CurrState, RESOURCE_STATE RequiredState)
+{
+    // UAV barrier is required between consecutive unordered access passes
+    if (CurrState == RESOURCE_STATE_UNORDERED_ACCESS && RequiredState == RESOURCE_STATE_UNORDERED_ACCESS)
+        return true;
+
+    return (CurrState & RequiredState) != RequiredState;
+}
+
+} // namespace
+
+FrameGraph::FrameGraph(IRenderDevice* pDevice) :
+    m_pDevice{pDevice}
+{
+    DEV_CHECK_ERR(m_pDevice, "Render device must not be null");
+}
+
+FrameGraph::~FrameGraph()
+{
+}
+
+FrameGraphResource FrameGraph::CreateTexture(const TextureDesc& Desc)
+{
+    m_IsCompiled = false;
+
+    ResourceInfo Res;
+    Res.Name         = Desc.Name != nullptr ? Desc.Name : "Frame graph transient texture";
+    Res.IsTexture    = true;
+    Res.TexDesc      = Desc;
+    Res.TexDesc.Name = nullptr;
+    m_Resources.emplace_back(std::move(Res));
+    return static_cast<FrameGraphResource>(m_Resources.size() - 1);
+}
+
+FrameGraphResource FrameGraph::CreateBuffer(const BufferDesc& Desc)
+{
+    m_IsCompiled = false;
+
+    ResourceInfo Res;
+    Res.Name          = Desc.Name != nullptr ? Desc.Name : "Frame graph transient buffer";
+    Res.IsTexture     = false;
+    Res.BuffDesc      = Desc;
+    Res.BuffDesc.Name = nullptr;
+    m_Resources.emplace_back(std::move(Res));
+    return static_cast<FrameGraphResource>(m_Resources.size() - 1);
+}
+
+FrameGraphResource FrameGraph::ImportTexture(ITexture* pTexture, RESOURCE_STATE FinalState)
+{
+    DEV_CHECK_ERR(pTexture != nullptr, "Imported texture must not be null");
+    DEV_CHECK_ERR(pTexture->GetState() != RESOURCE_STATE_UNKNOWN, "The state of imported texture '", pTexture->GetDesc().Name, "' is unknown");
+    m_IsCompiled = false;
+
+    ResourceInfo Res;
+    Res.Name            = pTexture->GetDesc().Name != nullptr ? pTexture->GetDesc().Name : "";
+    Res.IsTexture       = true;
+    Res.IsImported      = true;
+    Res.pImportedObject = pTexture;
+    Res.pObject         = pTexture;
+    Res.FinalState      = FinalState;
+    m_Resources.emplace_back(std::move(Res));
+    return static_cast<FrameGraphResource>(m_Resources.size() - 1);
+}
+
+FrameGraphResource FrameGraph::ImportBuffer(IBuffer* pBuffer, RESOURCE_STATE FinalState)
+{
+    DEV_CHECK_ERR(pBuffer != nullptr, "Imported buffer must not be null");
+    DEV_CHECK_ERR(pBuffer->GetState() != RESOURCE_STATE_UNKNOWN, "The state of imported buffer '", pBuffer->GetDesc().Name, "' is unknown");
+    m_IsCompiled = false;
+
+    ResourceInfo Res;
+    Res.Name            = pBuffer->GetDesc().Name != nullptr ? pBuffer->GetDesc().Name : "";
+    Res.IsTexture       = false;
+    Res.IsImported      = true;
+    Res.pImportedObject = pBuffer;
+    Res.pObject         = pBuffer;
+    Res.FinalState      = FinalState;
+    m_Resources.emplace_back(std::move(Res));
+    return static_cast<FrameGraphResource>(m_Resources.size() - 1);
+}
+
+FrameGraph::PassBuilder FrameGraph::AddPass(const char* Name, ExecuteFuncType ExecuteFunc)
+{
+    m_IsCompiled = false;
+
+    PassInfo Pass;
+    Pass.Name        = Name != nullptr ? Name : "";
+    Pass.ExecuteFunc = std::move(ExecuteFunc);
+    m_Passes.emplace_back(std::move(Pass));
+    return PassBuilder{*this, static_cast<Uint32>(m_Passes.size() - 1)};
+}
+
+FrameGraph::PassBuilder& FrameGraph::PassBuilder::Read(FrameGraphResource Resource, RESOURCE_STATE State)
+{
+    DEV_CHECK_ERR((State & WriteStates) == 0, GetResourceStateString(State), " is not a read-only state");
+    m_Graph.AddAccess(m_PassIndex, Resource, State, false);
+    return *this;
+}
+
+FrameGraph::PassBuilder& FrameGraph::PassBuilder::Write(FrameGraphResource Resource, RESOURCE_STATE State)
+{
+    DEV_CHECK_ERR((State & WriteStates) != 0, GetResourceStateString(State), " is not a write state");
+    m_Graph.AddAccess(m_PassIndex, Resource, State, true);
+    return *this;
+}
+
+FrameGraph::PassBuilder& FrameGraph::PassBuilder::SetSideEffects()
+{
+    m_Graph.m_Passes[m_PassIndex].HasSideEffects = true;
+    return *this;
+}
+
+void FrameGraph::AddAccess(Uint32 PassIndex, FrameGraphResource Resource, RESOURCE_STATE State, bool IsWrite)
+{
+    VERIFY_EXPR(PassIndex < m_Passes.size());
+    DEV_CHECK_ERR(Resource < m_Resources.size(), "Invalid frame graph resource");
+    DEV_CHECK_ERR(State != RESOURCE_STATE_UNKNOWN && State != RESOURCE_STATE_UNDEFINED, "Resource access state must not be UNKNOWN or UNDEFINED");
+    if (Resource >= m_Resources.size())
+        return;
+
+    auto& Accesses = m_Passes[PassIndex].Accesses;
+    for (auto& Access : Accesses)
+    {
+        if (Access.Resource == Resource)
+        {
+            // The resource must be in a single state for the entire pass
+            DEV_CHECK_ERR(((Access.IsWrite || IsWrite) && Access.State == State) || (!Access.IsWrite && !IsWrite),
+                          "Resource '", m_Resources[Resource].Name, "' is used by pass '", m_Passes[PassIndex].Name,
+                          "' in incompatible states ", GetResourceStateString(Access.State), " and ", GetResourceStateString(State));
+            Access.State |= State;
+            Access.IsWrite = Access.IsWrite || IsWrite;
+            return;
+        }
+    }
+
+    Accesses.emplace_back(ResourceAccess{Resource, State, IsWrite});
+}
+
+void FrameGraph::CullPasses()
+{
+    // Number of resources written by the pass that are used later
+    std::vector<Uint32> PassRefCounts(m_Passes.size());
+    // Passes that write the resource
+    std::vector<std::vector<Uint32>> Writers(m_Resources.size());
+
+    for (auto& Res : m_Resources)
+    {
+        // Imported resources are always used outside of the graph
+        Res.RefCount = Res.IsImported ? 1 : 0;
+    }
+
+    for (Uint32 PassIdx = 0; PassIdx < m_Passes.size(); ++PassIdx)
+    {
+        auto& Pass    = m_Passes[PassIdx];
+        Pass.IsCulled = false;
+        if (Pass.HasSideEffects)
+            ++PassRefCounts[PassIdx];
+
+        for (const auto& Access : Pass.Accesses)
+        {
+            if (Access.IsWrite)
+            {
+                ++PassRefCounts[PassIdx];
+                Writers[Access.Resource].push_back(PassIdx);
+            }
+            else
+            {
+                ++m_Resources[Access.Resource].RefCount;
+            }
+        }
+    }
+
+    std::vector<FrameGraphResource> UnusedResources;
+
+    const auto CullPass = [&](Uint32 PassIdx) {
+        auto& Pass = m_Passes[PassIdx];
+        VERIFY_EXPR(!Pass.IsCulled);
+        Pass.IsCulled = true;
+        ++m_Stats.NumCulledPasses;
+        for (const auto& Access : Pass.Accesses)
+        {
+            if (Access.IsWrite)
+                continue;
+
+            auto& Res = m_Resources[Access.Resource];
+            VERIFY_EXPR(Res.RefCount > 0);
+            if (--Res.RefCount == 0)
+                UnusedResources.push_back(Access.Resource);
+        }
+    };
+
+    for (FrameGraphResource ResIdx = 0; ResIdx < m_Resources.size(); ++ResIdx)
+    {
+        if (m_Resources[ResIdx].RefCount == 0)
+            UnusedResources.push_back(ResIdx);
+    }
+
+    for (Uint32 PassIdx = 0; PassIdx < m_Passes.size(); ++PassIdx)
+    {
+        // Passes that do not write anything
+        if (PassRefCounts[PassIdx] == 0)
+            CullPass(PassIdx);
+    }
+
+    while (!UnusedResources.empty())
+    {
+        const auto ResIdx = UnusedResources.back();
+        UnusedResources.pop_back();
+        for (auto PassIdx : Writers[ResIdx])
+        {
+            VERIFY_EXPR(PassRefCounts[PassIdx] > 0);
+            if (--PassRefCounts[PassIdx] == 0)
+                CullPass(PassIdx);
+        }
+    }
+}
+
+void FrameGraph::AllocateTransientResources()
+{
+    for (auto& Res : m_Resources)
+    {
+        Res.FirstUse = ~0u;
+        Res.LastUse  = 0;
+        if (!Res.IsImported)
+        {
+            Res.pObject          = nullptr;
+            Res.PhysicalResource = ~size_t{0};
+        }
+    }
+
+    for (Uint32 PassIdx = 0; PassIdx < m_Passes.size(); ++PassIdx)
+    {
+        const auto& Pass = m_Passes[PassIdx];
+        if (Pass.IsCulled)
+            continue;
+
+        for (const auto& Access : Pass.Accesses)
+        {
+            auto& Res    = m_Resources[Access.Resource];
+            Res.FirstUse = std::min(Res.FirstUse, PassIdx);
+            Res.LastUse  = std::max(Res.LastUse, PassIdx);
+        }
+    }
+
+    std::vector<FrameGraphResource> Transients;
+    for (FrameGraphResource ResIdx = 0; ResIdx < m_Resources.size(); ++ResIdx)
+    {
+        const auto& Res = m_Resources[ResIdx];
+        if (!Res.IsImported && Res.FirstUse != ~0u)
+            Transients.push_back(ResIdx);
+    }
+    std::sort(Transients.begin(), Transients.end(),
+              [this](FrameGraphResource Res0, FrameGraphResource Res1) {
+                  return m_Resources[Res0].FirstUse < m_Resources[Res1].FirstUse;
+              });
+    m_Stats.NumTransientResources = static_cast<Uint32>(Transients.size());
+
+    for (auto& PhysRes : m_PhysicalResources)
+        PhysRes.LastUse = ~0u;
+
+    for (auto ResIdx : Transients)
+    {
+        auto& Res = m_Resources[ResIdx];
+
+        // Find an object with identical description that is not used
+        // by any pass in the lifetime of the resource
+        size_t PhysIdx = 0;
+        for (; PhysIdx < m_PhysicalResources.size(); ++PhysIdx)
+        {
+            const auto& PhysRes = m_PhysicalResources[PhysIdx];
+            if (PhysRes.IsTexture != Res.IsTexture)
+                continue;
+            if (PhysRes.LastUse != ~0u && PhysRes.LastUse >= Res.FirstUse)
+                continue;
+
+            const auto IsCompatible = Res.IsTexture ?
+                PhysRes.pObject.RawPtr<ITexture>()->GetDesc() == Res.TexDesc :
+                PhysRes.pObject.RawPtr<IBuffer>()->GetDesc() == Res.BuffDesc;
+            if (IsCompatible)
+                break;
+        }
+
+        if (PhysIdx == m_PhysicalResources.size())
+        {
+            PhysicalResource PhysRes;
+            PhysRes.IsTexture = Res.IsTexture;
+            if (Res.IsTexture)
+            {
+                auto Desc = Res.TexDesc;
+                Desc.Name = Res.Name.c_str();
+
+                RefCntAutoPtr<ITexture> pTexture;
+                m_pDevice->CreateTexture(Desc, nullptr, &pTexture);
+                PhysRes.pObject = std::move(pTexture);
+            }
+            else
+            {
+                auto Desc = Res.BuffDesc;
+                Desc.Name = Res.Name.c_str();
+
+                RefCntAutoPtr<IBuffer> pBuffer;
+                m_pDevice->CreateBuffer(Desc, nullptr, &pBuffer);
+                PhysRes.pObject = std::move(pBuffer);
+            }
+
+            if (!PhysRes.pObject)
+            {
+                LOG_ERROR_MESSAGE("Failed to create transient resource '", Res.Name, "'");
+                continue;
+            }
+
+            m_PhysicalResources.emplace_back(std::move(PhysRes));
+            ++m_Stats.NumCreatedResources;
+        }
+
+        auto& PhysRes        = m_PhysicalResources[PhysIdx];
+        PhysRes.LastUse      = Res.LastUse;
+        Res.PhysicalResource = PhysIdx;
+        Res.pObject          = PhysRes.pObject;
+    }
+
+    // Release objects that are not used in this frame
+    std::vector<size_t> PhysIdxRemap(m_PhysicalResources.size());
+    size_t              NumUsed = 0;
+    for (size_t PhysIdx = 0; PhysIdx < m_PhysicalResources.size(); ++PhysIdx)
+    {
+        if (m_PhysicalResources[PhysIdx].LastUse == ~0u)
+            continue;
+
+        if (NumUsed != PhysIdx)
+            m_PhysicalResources[NumUsed] = std::move(m_PhysicalResources[PhysIdx]);
+        PhysIdxRemap[PhysIdx] = NumUsed++;
+    }
+    m_PhysicalResources.resize(NumUsed);
+    m_Stats.NumPhysicalResources = static_cast<Uint32>(NumUsed);
+
+    for (auto ResIdx : Transients)
+    {
+        auto& Res = m_Resources[ResIdx];
+        if (Res.PhysicalResource != ~size_t{0})
+            Res.PhysicalResource = PhysIdxRemap[Res.PhysicalResource];
+    }
+}
+
+void FrameGraph::ComputeBarriers()
+{
+    m_Barriers.clear();
+
+    // Current states of the imported resources
+    std::vector<RESOURCE_STATE> ImportedStates(m_Resources.size(), RESOURCE_STATE_UNKNOWN);
+    for (size_t ResIdx = 0; ResIdx < m_Resources.size(); ++ResIdx)
+    {
+        const auto& Res = m_Resources[ResIdx];
+        if (Res.IsImported)
+        {
+            ImportedStates[ResIdx] = Res.IsTexture ?
+                static_cast<ITexture*>(Res.pObject)->GetState() :
+                static_cast<IBuffer*>(Res.pObject)->GetState();
+        }
+    }
+
+    // Transient resources share the state of their physical resource
+    m_PhysicalEndStates.resize(m_PhysicalResources.size());
+    for (size_t PhysIdx = 0; PhysIdx < m_PhysicalResources.size(); ++PhysIdx)
+        m_PhysicalEndStates[PhysIdx] = m_PhysicalResources[PhysIdx].State;
+
+    const auto GetState = [&](FrameGraphResource ResIdx) -> RESOURCE_STATE& {
+        const auto& Res = m_Resources[ResIdx];
+        return Res.IsImported ? ImportedStates[ResIdx] : m_PhysicalEndStates[Res.PhysicalResource];
+    };
+
+    for (Uint32 PassIdx = 0; PassIdx < m_Passes.size(); ++PassIdx)
+    {
+        auto& Pass        = m_Passes[PassIdx];
+        Pass.FirstBarrier = m_Barriers.size();
+        Pass.NumBarriers  = 0;
+        if (Pass.IsCulled)
+            continue;
+
+        for (const auto& Access : Pass.Accesses)
+        {
+            const auto& Res = m_Resources[Access.Resource];
+            if (Res.pObject == nullptr)
+                continue;
+
+            auto& CurrState = GetState(Access.Resource);
+            if (!NeedsTransition(CurrState, Access.State))
+                continue;
+
+            StateTransitionDesc Barrier;
+            Barrier.pResource = Res.pObject;
+            Barrier.OldState  = CurrState;
+            Barrier.NewState  = Access.State;
+            Barrier.Flags     = STATE_TRANSITION_FLAG_UPDATE_STATE;
+            if (!Res.IsImported && Res.FirstUse == PassIdx)
+            {
+                // Previous contents of the transient resource is not needed
+                Barrier.Flags |= STATE_TRANSITION_FLAG_DISCARD_CONTENT;
+            }
+            m_Barriers.emplace_back(Barrier);
+
+            CurrState = Access.State;
+        }
+
+        Pass.NumBarriers = m_Barriers.size() - Pass.FirstBarrier;
+    }
+
+    m_FirstFinalBarrier = m_Barriers.size();
+    for (FrameGraphResource ResIdx = 0; ResIdx < m_Resources.size(); ++ResIdx)
+    {
+        const auto& Res = m_Resources[ResIdx];
+        if (!Res.IsImported || Res.FinalState == RESOURCE_STATE_UNKNOWN)
+            continue;
+
+        auto& CurrState = GetState(ResIdx);
+        if ((CurrState & Res.FinalState) == Res.FinalState)
+            continue;
+
+        StateTransitionDesc Barrier;
+        Barrier.pResource = Res.pObject;
+        Barrier.OldState  = CurrState;
+        Barrier.NewState  = Res.FinalState;
+        Barrier.Flags     = STATE_TRANSITION_FLAG_UPDATE_STATE;
+        m_Barriers.emplace_back(Barrier);
+
+        CurrState = Res.FinalState;
+    }
+
+    m_Stats.NumBarriers = static_cast<Uint32>(m_Barriers.size());
+}
+
+void FrameGraph::Compile()
+{
+    m_Stats                 = {};
+    m_Stats.NumPasses       = static_cast<Uint32>(m_Passes.size());
+    m_Stats.NumCulledPasses = 0;
+
+    CullPasses();
+    AllocateTransientResources();
+    ComputeBarriers();
+
+    m_IsCompiled = true;
+}
+
+void FrameGraph::ExecutePasses(IDeviceContext* pContext, size_t StartPass, size_t EndPass)
+{
+    VERIFY_EXPR(pContext != nullptr);
+    for (size_t PassIdx = StartPass; PassIdx < EndPass; ++PassIdx)
+    {
+        const auto& Pass = m_Passes[PassIdx];
+        if (Pass.IsCulled)
+            continue;
+
+        if (Pass.NumBarriers > 0)
+            pContext->TransitionResourceStates(static_cast<Uint32>(Pass.NumBarriers), &m_Barriers[Pass.FirstBarrier]);
+
+        if (Pass.ExecuteFunc)
+        {
+            pContext->BeginDebugGroup(Pass.Name.c_str());
+            Pass.ExecuteFunc(*this, pContext);
+            pContext->EndDebugGroup();
+        }
+    }
+}
+
+void FrameGraph::TransitionFinalStates(IDeviceContext* pContext)
+{
+    VERIFY_EXPR(pContext != nullptr);
+    if (m_FirstFinalBarrier < m_Barriers.size())
+        pContext->TransitionResourceStates(static_cast<Uint32>(m_Barriers.size() - m_FirstFinalBarrier), &m_Barriers[m_FirstFinalBarrier]);
+}
+
+void FrameGraph::CommitPhysicalStates()
+{
+    VERIFY_EXPR(m_PhysicalEndStates.size() == m_PhysicalResources.size());
+    for (size_t PhysIdx = 0; PhysIdx < m_PhysicalResources.size(); ++PhysIdx)
+        m_PhysicalResources[PhysIdx].State = m_PhysicalEndStates[PhysIdx];
+}
+
+void FrameGraph::Execute(IDeviceContext* pContext)
+{
+    DEV_CHECK_ERR(pContext != nullptr, "Device context must not be null");
+    DEV_CHECK_ERR(m_IsCompiled, "The frame graph must be compiled before it can be executed");
+    if (!m_IsCompiled)
+        return;
+
+    ExecutePasses(pContext, 0, m_Passes.size());
+    TransitionFinalStates(pContext);
+    CommitPhysicalStates();
+}
+
+void FrameGraph::Execute(IDeviceContext*        pImmediateContext,
+                         IDeviceContext* const* ppDeferredContexts,
+                         Uint32                 NumDeferredContexts)
+{
+    DEV_CHECK_ERR(pImmediateContext != nullptr, "Immediate context must not be null");
+    DEV_CHECK_ERR(!pImmediateContext->GetDesc().IsDeferred, "Immediate context is expected");
+    DEV_CHECK_ERR(m_IsCompiled, "The frame graph must be compiled before it can be executed");
+    if (!m_IsCompiled)
+        return;
+
+    std::vector<size_t> LivePasses;
+    for (size_t PassIdx = 0; PassIdx < m_Passes.size(); ++PassIdx)
+    {
+        if (!m_Passes[PassIdx].IsCulled)
+            LivePasses.push_back(PassIdx);
+    }
+
+    NumDeferredContexts = std::min(NumDeferredContexts, static_cast<Uint32>(LivePasses.size()));
+    if (NumDeferredContexts == 0 || ppDeferredContexts == nullptr)
+    {
+        Execute(pImmediateContext);
+        return;
+    }
+
+    std::vector<RefCntAutoPtr<ICommandList>> CmdLists(NumDeferredContexts);
+    std::vector<ICommandList*>               pCmdLists(NumDeferredContexts);
+
+    // All state transitions are known in advance, so every context may record
+    // its range of passes independently.
+    size_t EndPass = 0;
+    for (Uint32 CtxIdx = 0; CtxIdx < NumDeferredContexts; ++CtxIdx)
+    {
+        auto* pCtx = ppDeferredContexts[CtxIdx];
+        DEV_CHECK_ERR(pCtx != nullptr && pCtx->GetDesc().IsDeferred, "Deferred context at index ", CtxIdx, " is null or is not deferred");
+
+        const auto StartPass = EndPass;
+        const auto LastLive  = (LivePasses.size() * (CtxIdx + 1)) / NumDeferredContexts - 1;
+        EndPass              = CtxIdx + 1 < NumDeferredContexts ? LivePasses[LastLive] + 1 : m_Passes.size();
+
+        pCtx->Begin(pImmediateContext->GetDesc().ContextId);
+        ExecutePasses(pCtx, StartPass, EndPass);
+        if (CtxIdx + 1 == NumDeferredContexts)
+            TransitionFinalStates(pCtx);
+        pCtx->FinishCommandList(&CmdLists[CtxIdx]);
+        pCmdLists[CtxIdx] = CmdLists[CtxIdx];
+    }
+
+    pImmediateContext->ExecuteCommandLists(NumDeferredContexts, pCmdLists.data());
+    CommitPhysicalStates();
+}
+
+void FrameGraph::Reset()
+{
+    m_Passes.clear();
+    m_Resources.clear();
+    m_Barriers.clear();
+    m_FirstFinalBarrier = 0;
+    m_IsCompiled        = false;
+}
+
+void FrameGraph::ReleaseTransientResources()
+{
+    for (auto& Res : m_Resources)
+    {
+        if (!Res.IsImported)
+        {
+            Res.pObject          = nullptr;
+            Res.PhysicalResource = ~size_t{0};
+        }
+    }
+    m_PhysicalResources.clear();
+    m_PhysicalEndStates.clear();
+    m_IsCompiled = false;
+}
+
+ITexture* FrameGraph::GetTexture(FrameGraphResource Resource) const
+{
+    DEV_CHECK_ERR(Resource < m_Resources.size(), "Invalid frame graph resource");
+    if (Resource >= m_Resources.size())
+        return nullptr;
+
+    const auto& Res = m_Resources[Resource];
+    DEV_CHECK_ERR(Res.IsTexture, "Resource '", Res.Name, "' is not a texture");
+    return Res.IsTexture ? static_cast<ITexture*>(Res.pObject) : nullptr;
+}
+
+IBuffer* FrameGraph::GetBuffer(FrameGraphResource Resource) const
+{
+    DEV_CHECK_ERR(Resource < m_Resources.size(), "Invalid frame graph resource");
+    if (Resource >= m_Resources.size())
+        return nullptr;
+
+    const auto& Res = m_Resources[Resource];
+    DEV_CHECK_ERR(!Res.IsTexture, "Resource '", Res.Name, "' is not a buffer");
+    return !Res.IsTexture ? static_cast<IBuffer*>(Res.pObject) : nullptr;
+}
+
+bool FrameGraph::IsPassCulled(Uint32 PassIndex) const
+{
+    DEV_CHECK_ERR(PassIndex < m_Passes.size(), "Pass index is out of range");
+    return PassIndex < m_Passes.size() ? m_Passes[PassIndex].IsCulled : true;
+}
+
+} // namespace Diligent
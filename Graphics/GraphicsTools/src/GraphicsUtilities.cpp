@@ -26,13 +26,27 @@
  */
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <future>
 #include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define DILIGENT_MIP_FILTER_SSE2 1
+#    include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#    define DILIGENT_MIP_FILTER_NEON 1
+#    include <arm_neon.h>
+#endif
 
 #include "GraphicsUtilities.h"
 #include "DebugUtilities.hpp"
 #include "GraphicsAccessories.hpp"
 #include "ColorConversion.h"
+#include "ThreadPool.hpp"
 
 #define PI_F 3.1415926f
 
@@ -133,27 +147,32 @@ void GenerateCheckerBoardPattern(Uint32 Width, Uint32 Height, TEXTURE_FORMAT Fmt
 
 
 
-template <typename ChannelType>
-ChannelType SRGBAverage(ChannelType c0, ChannelType c1, ChannelType c2, ChannelType c3, Uint32 /*col*/, Uint32 /*row*/)
+// FastSRGBToLinear() of all 8-bit values
+const std::array<float, 256>& GetSRGBToLinearTable()
 {
-    static_assert(std::numeric_limits<ChannelType>::is_integer && !std::numeric_limits<ChannelType>::is_signed, "Unsigned integers are expected");
+    static const std::array<float, 256> Table = []() {
+        std::array<float, 256> Table{};
+        for (Uint32 i = 0; i < Table.size(); ++i)
+            Table[i] = FastSRGBToLinear(static_cast<float>(i) * (1.f / 255.f));
+        return Table;
+    }();
+    return Table;
+}
 
-    static constexpr float MaxVal    = static_cast<float>(std::numeric_limits<ChannelType>::max());
-    static constexpr float MaxValInv = 1.f / MaxVal;
+Uint8 SRGBAverage(Uint8 c0, Uint8 c1, Uint8 c2, Uint8 c3, Uint32 /*col*/, Uint32 /*row*/)
+{
+    static constexpr float MaxVal = 255.f;
 
-    float fc0 = static_cast<float>(c0) * MaxValInv;
-    float fc1 = static_cast<float>(c1) * MaxValInv;
-    float fc2 = static_cast<float>(c2) * MaxValInv;
-    float fc3 = static_cast<float>(c3) * MaxValInv;
+    const auto& SRGBToLinear = GetSRGBToLinearTable();
 
-    float fLinearAverage = (FastSRGBToLinear(fc0) + FastSRGBToLinear(fc1) + FastSRGBToLinear(fc2) + FastSRGBToLinear(fc3)) * 0.25f;
+    float fLinearAverage = (SRGBToLinear[c0] + SRGBToLinear[c1] + SRGBToLinear[c2] + SRGBToLinear[c3]) * 0.25f;
     float fSRGBAverage   = FastLinearToSRGB(fLinearAverage) * MaxVal;
 
     // Clamping on both ends is essential because fast SRGB math is imprecise
     fSRGBAverage = std::max(fSRGBAverage, 0.f);
     fSRGBAverage = std::min(fSRGBAverage, MaxVal);
 
-    return static_cast<ChannelType>(fSRGBAverage);
+    return static_cast<Uint8>(fSRGBAverage);
 }
 
 template <typename ChannelType>
@@ -282,11 +301,261 @@ ChannelType MostFrequentSelector(ChannelType c0, ChannelType c1, ChannelType c2,
     }
 }
 
+// Box-filters the first pixels of a coarse mip row and returns the number of pixels processed.
+// The results must be bit-identical to the scalar filters.
+using FilterRowFuncType = Uint32 (*)(const void* pSrcRow0, const void* pSrcRow1, void* pDstRow, Uint32 CoarseWidth);
+
+#if DILIGENT_MIP_FILTER_SSE2
+
+Uint32 BoxFilterRowRGBA8(const void* pSrcRow0, const void* pSrcRow1, void* pDstRow, Uint32 CoarseWidth)
+{
+    const auto* pRow0 = static_cast<const Uint8*>(pSrcRow0);
+    const auto* pRow1 = static_cast<const Uint8*>(pSrcRow1);
+    auto*       pDst  = static_cast<Uint8*>(pDstRow);
+
+    const __m128i Zero = _mm_setzero_si128();
+
+    // 4 coarse pixels per iteration
+    Uint32 col = 0;
+    for (; col + 4 <= CoarseWidth; col += 4)
+    {
+        const __m128i r0a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow0 + col * 8));
+        const __m128i r0b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow0 + col * 8 + 16));
+        const __m128i r1a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow1 + col * 8));
+        const __m128i r1b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow1 + col * 8 + 16));
+
+        // Vertical sums of fine pixels [0, 1], [2, 3], [4, 5], [6, 7] as 16-bit values
+        const __m128i v01 = _mm_add_epi16(_mm_unpacklo_epi8(r0a, Zero), _mm_unpacklo_epi8(r1a, Zero));
+        const __m128i v23 = _mm_add_epi16(_mm_unpackhi_epi8(r0a, Zero), _mm_unpackhi_epi8(r1a, Zero));
+        const __m128i v45 = _mm_add_epi16(_mm_unpacklo_epi8(r0b, Zero), _mm_unpacklo_epi8(r1b, Zero));
+        const __m128i v67 = _mm_add_epi16(_mm_unpackhi_epi8(r0b, Zero), _mm_unpackhi_epi8(r1b, Zero));
+
+        // Horizontal sums: [0+1, 2+3], [4+5, 6+7]
+        const __m128i s01 = _mm_add_epi16(_mm_unpacklo_epi64(v01, v23), _mm_unpackhi_epi64(v01, v23));
+        const __m128i s23 = _mm_add_epi16(_mm_unpacklo_epi64(v45, v67), _mm_unpackhi_epi64(v45, v67));
+
+        const __m128i Res = _mm_packus_epi16(_mm_srli_epi16(s01, 2), _mm_srli_epi16(s23, 2));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + col * 4), Res);
+    }
+    return col;
+}
+
+Uint32 BoxFilterRowR16(const void* pSrcRow0, const void* pSrcRow1, void* pDstRow, Uint32 CoarseWidth)
+{
+    const auto* pRow0 = static_cast<const Uint16*>(pSrcRow0);
+    const auto* pRow1 = static_cast<const Uint16*>(pSrcRow1);
+    auto*       pDst  = static_cast<Uint16*>(pDstRow);
+
+    const __m128i LowMask  = _mm_set1_epi32(0xFFFF);
+    const __m128i Bias32   = _mm_set1_epi32(0x8000);
+    const __m128i Bias16   = _mm_set1_epi16(static_cast<short>(0x8000));
+    const auto    SumPairs = [LowMask](__m128i v) {
+        return _mm_add_epi32(_mm_and_si128(v, LowMask), _mm_srli_epi32(v, 16));
+    };
+
+    // 8 coarse pixels per iteration
+    Uint32 col = 0;
+    for (; col + 8 <= CoarseWidth; col += 8)
+    {
+        const __m128i r0a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow0 + col * 2));
+        const __m128i r0b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow0 + col * 2 + 8));
+        const __m128i r1a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow1 + col * 2));
+        const __m128i r1b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow1 + col * 2 + 8));
+
+        const __m128i Avg0 = _mm_srli_epi32(_mm_add_epi32(SumPairs(r0a), SumPairs(r1a)), 2);
+        const __m128i Avg1 = _mm_srli_epi32(_mm_add_epi32(SumPairs(r0b), SumPairs(r1b)), 2);
+
+        // SSE2 only has signed saturation, so bias the values into the signed range
+        const __m128i Res = _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(Avg0, Bias32), _mm_sub_epi32(Avg1, Bias32)), Bias16);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + col), Res);
+    }
+    return col;
+}
+
+Uint32 BoxFilterRowRGBA32F(const void* pSrcRow0, const void* pSrcRow1, void* pDstRow, Uint32 CoarseWidth)
+{
+    const auto* pRow0 = static_cast<const float*>(pSrcRow0);
+    const auto* pRow1 = static_cast<const float*>(pSrcRow1);
+    auto*       pDst  = static_cast<float*>(pDstRow);
+
+    const __m128 Quarter = _mm_set1_ps(0.25f);
+    for (Uint32 col = 0; col < CoarseWidth; ++col)
+    {
+        // Same summation order as in LinearAverage<float>
+        __m128 Sum = _mm_add_ps(_mm_loadu_ps(pRow0 + col * 8), _mm_loadu_ps(pRow0 + col * 8 + 4));
+        Sum        = _mm_add_ps(Sum, _mm_loadu_ps(pRow1 + col * 8));
+        Sum        = _mm_add_ps(Sum, _mm_loadu_ps(pRow1 + col * 8 + 4));
+        _mm_storeu_ps(pDst + col * 4, _mm_mul_ps(Sum, Quarter));
+    }
+    return CoarseWidth;
+}
+
+// Vector version of FastLinearToSRGB() with the same sequence of operations
+inline __m128 FastLinearToSRGB_SSE2(__m128 x)
+{
+    const __m128 AbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+    const __m128 Lo = _mm_mul_ps(_mm_set1_ps(12.92f), x);
+
+    const __m128 Sqrt = _mm_sqrt_ps(_mm_and_ps(_mm_sub_ps(x, _mm_set1_ps(0.00228f)), AbsMask));
+    __m128       Hi   = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(1.13005f), Sqrt), _mm_mul_ps(_mm_set1_ps(0.13448f), x));
+    Hi                = _mm_add_ps(Hi, _mm_set1_ps(0.005719f));
+
+    const __m128 IsLo = _mm_cmplt_ps(x, _mm_set1_ps(0.0031308f));
+    return _mm_or_ps(_mm_and_ps(IsLo, Lo), _mm_andnot_ps(IsLo, Hi));
+}
+
+Uint32 BoxFilterRowSRGBA8(const void* pSrcRow0, const void* pSrcRow1, void* pDstRow, Uint32 CoarseWidth)
+{
+    const auto* pRow0 = static_cast<const Uint8*>(pSrcRow0);
+    const auto* pRow1 = static_cast<const Uint8*>(pSrcRow1);
+    auto*       pDst  = static_cast<Uint8*>(pDstRow);
+
+    const auto* SRGBToLinear = GetSRGBToLinearTable().data();
+
+    const auto ToLinear = [SRGBToLinear](const Uint8* pPixel) {
+        return _mm_setr_ps(SRGBToLinear[pPixel[0]], SRGBToLinear[pPixel[1]], SRGBToLinear[pPixel[2]], SRGBToLinear[pPixel[3]]);
+    };
+
+    const __m128 Quarter = _mm_set1_ps(0.25f);
+    const __m128 MaxVal  = _mm_set1_ps(255.f);
+    const __m128 Zero    = _mm_setzero_ps();
+
+    // 4 coarse pixels per iteration
+    Uint32 col = 0;
+    for (; col + 4 <= CoarseWidth; col += 4)
+    {
+        __m128i Res[4];
+        for (Uint32 i = 0; i < 4; ++i)
+        {
+            const auto* pFine0 = pRow0 + (col + i) * 8;
+            const auto* pFine1 = pRow1 + (col + i) * 8;
+
+            // Same summation order as in SRGBAverage()
+            __m128 Sum = _mm_add_ps(ToLinear(pFine0), ToLinear(pFine0 + 4));
+            Sum        = _mm_add_ps(Sum, ToLinear(pFine1));
+            Sum        = _mm_add_ps(Sum, ToLinear(pFine1 + 4));
+
+            __m128 SRGB = _mm_mul_ps(FastLinearToSRGB_SSE2(_mm_mul_ps(Sum, Quarter)), MaxVal);
+            SRGB        = _mm_min_ps(_mm_max_ps(SRGB, Zero), MaxVal);
+            Res[i]      = _mm_cvttps_epi32(SRGB);
+        }
+        const __m128i Packed = _mm_packus_epi16(_mm_packs_epi32(Res[0], Res[1]), _mm_packs_epi32(Res[2], Res[3]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + col * 4), Packed);
+    }
+    return col;
+}
+
+#elif DILIGENT_MIP_FILTER_NEON
+
+Uint32 BoxFilterRowRGBA8(const void* pSrcRow0, const void* pSrcRow1, void* pDstRow, Uint32 CoarseWidth)
+{
+    const auto* pRow0 = static_cast<const Uint8*>(pSrcRow0);
+    const auto* pRow1 = static_cast<const Uint8*>(pSrcRow1);
+    auto*       pDst  = static_cast<Uint8*>(pDstRow);
+
+    // 4 coarse pixels per iteration
+    Uint32 col = 0;
+    for (; col + 4 <= CoarseWidth; col += 4)
+    {
+        // Split even and odd fine pixels
+        const uint32x4x2_t r0 = vuzpq_u32(vreinterpretq_u32_u8(vld1q_u8(pRow0 + col * 8)), vreinterpretq_u32_u8(vld1q_u8(pRow0 + col * 8 + 16)));
+        const uint32x4x2_t r1 = vuzpq_u32(vreinterpretq_u32_u8(vld1q_u8(pRow1 + col * 8)), vreinterpretq_u32_u8(vld1q_u8(pRow1 + col * 8 + 16)));
+
+        const uint8x16_t r0e = vreinterpretq_u8_u32(r0.val[0]);
+        const uint8x16_t r0o = vreinterpretq_u8_u32(r0.val[1]);
+        const uint8x16_t r1e = vreinterpretq_u8_u32(r1.val[0]);
+        const uint8x16_t r1o = vreinterpretq_u8_u32(r1.val[1]);
+
+        const uint16x8_t SumLo = vaddq_u16(vaddl_u8(vget_low_u8(r0e), vget_low_u8(r0o)), vaddl_u8(vget_low_u8(r1e), vget_low_u8(r1o)));
+        const uint16x8_t SumHi = vaddq_u16(vaddl_u8(vget_high_u8(r0e), vget_high_u8(r0o)), vaddl_u8(vget_high_u8(r1e), vget_high_u8(r1o)));
+
+        vst1q_u8(pDst + col * 4, vcombine_u8(vshrn_n_u16(SumLo, 2), vshrn_n_u16(SumHi, 2)));
+    }
+    return col;
+}
+
+Uint32 BoxFilterRowR16(const void* pSrcRow0, const void* pSrcRow1, void* pDstRow, Uint32 CoarseWidth)
+{
+    const auto* pRow0 = static_cast<const Uint16*>(pSrcRow0);
+    const auto* pRow1 = static_cast<const Uint16*>(pSrcRow1);
+    auto*       pDst  = static_cast<Uint16*>(pDstRow);
+
+    // 8 coarse pixels per iteration
+    Uint32 col = 0;
+    for (; col + 8 <= CoarseWidth; col += 8)
+    {
+        // Split even and odd fine pixels
+        const uint16x8x2_t r0 = vuzpq_u16(vld1q_u16(pRow0 + col * 2), vld1q_u16(pRow0 + col * 2 + 8));
+        const uint16x8x2_t r1 = vuzpq_u16(vld1q_u16(pRow1 + col * 2), vld1q_u16(pRow1 + col * 2 + 8));
+
+        const uint32x4_t SumLo = vaddq_u32(vaddl_u16(vget_low_u16(r0.val[0]), vget_low_u16(r0.val[1])), vaddl_u16(vget_low_u16(r1.val[0]), vget_low_u16(r1.val[1])));
+        const uint32x4_t SumHi = vaddq_u32(vaddl_u16(vget_high_u16(r0.val[0]), vget_high_u16(r0.val[1])), vaddl_u16(vget_high_u16(r1.val[0]), vget_high_u16(r1.val[1])));
+
+        vst1q_u16(pDst + col, vcombine_u16(vshrn_n_u32(SumLo, 2), vshrn_n_u32(SumHi, 2)));
+    }
+    return col;
+}
+
+Uint32 BoxFilterRowRGBA32F(const void* pSrcRow0, const void* pSrcRow1, void* pDstRow, Uint32 CoarseWidth)
+{
+    const auto* pRow0 = static_cast<const float*>(pSrcRow0);
+    const auto* pRow1 = static_cast<const float*>(pSrcRow1);
+    auto*       pDst  = static_cast<float*>(pDstRow);
+
+    const float32x4_t Quarter = vdupq_n_f32(0.25f);
+    for (Uint32 col = 0; col < CoarseWidth; ++col)
+    {
+        // Same summation order as in LinearAverage<float>
+        float32x4_t Sum = vaddq_f32(vld1q_f32(pRow0 + col * 8), vld1q_f32(pRow0 + col * 8 + 4));
+        Sum             = vaddq_f32(Sum, vld1q_f32(pRow1 + col * 8));
+        Sum             = vaddq_f32(Sum, vld1q_f32(pRow1 + col * 8 + 4));
+        vst1q_f32(pDst + col * 4, vmulq_f32(Sum, Quarter));
+    }
+    return CoarseWidth;
+}
+
+// sRGB filter is not vectorized as compilers may contract the scalar
+// FastLinearToSRGB() into fused multiply-adds, which would break bit-exactness.
+
+#endif
+
+// Returns the SIMD box filter for the format, or null if the format is not accelerated
+FilterRowFuncType GetBoxFilterRowFunc(const TextureFormatAttribs& FmtAttribs)
+{
+#if DILIGENT_MIP_FILTER_SSE2 || DILIGENT_MIP_FILTER_NEON
+    switch (FmtAttribs.ComponentType)
+    {
+#    if DILIGENT_MIP_FILTER_SSE2
+        case COMPONENT_TYPE_UNORM_SRGB:
+            return FmtAttribs.ComponentSize == 1 && FmtAttribs.NumComponents == 4 ? BoxFilterRowSRGBA8 : nullptr;
+#    endif
+
+        case COMPONENT_TYPE_UNORM:
+        case COMPONENT_TYPE_UINT:
+            if (FmtAttribs.ComponentSize == 1 && FmtAttribs.NumComponents == 4)
+                return BoxFilterRowRGBA8;
+            if (FmtAttribs.ComponentSize == 2 && FmtAttribs.NumComponents == 1)
+                return BoxFilterRowR16;
+            return nullptr;
+
+        case COMPONENT_TYPE_FLOAT:
+            return FmtAttribs.ComponentSize == 4 && FmtAttribs.NumComponents == 4 ? BoxFilterRowRGBA32F : nullptr;
+
+        default:
+            return nullptr;
+    }
+#else
+    return nullptr;
+#endif
+}
+
 template <typename ChannelType,
           typename FilterType>
 void FilterMipLevel(const ComputeMipLevelAttribs& Attribs,
                     Uint32                        NumChannels,
-                    FilterType                    Filter)
+                    FilterType                    Filter,
+                    FilterRowFuncType             FilterRowSIMD = nullptr)
 {
     VERIFY_EXPR(Attribs.FineMipWidth > 0 && Attribs.FineMipHeight > 0);
     DEV_CHECK_ERR(Attribs.FineMipHeight == 1 || Attribs.FineMipStride >= Attribs.FineMipWidth * sizeof(ChannelType) * NumChannels, "Fine mip level stride is too small");
@@ -304,7 +573,12 @@ void FilterMipLevel(const ComputeMipLevelAttribs& Attribs,
         auto pSrcRow0 = reinterpret_cast<const ChannelType*>(reinterpret_cast<const Uint8*>(Attribs.pFineMipData) + src_row0 * Attribs.FineMipStride);
         auto pSrcRow1 = reinterpret_cast<const ChannelType*>(reinterpret_cast<const Uint8*>(Attribs.pFineMipData) + src_row1 * Attribs.FineMipStride);
 
-        for (Uint32 col = 0; col < CoarseMipWidth; ++col)
+        Uint32 col = 0;
+        // SIMD filters always read two fine columns per coarse column
+        if (FilterRowSIMD != nullptr && Attribs.FineMipWidth > 1)
+            col = FilterRowSIMD(pSrcRow0, pSrcRow1, reinterpret_cast<Uint8*>(Attribs.pCoarseMipData) + row * Attribs.CoarseMipStride, CoarseMipWidth);
+
+        for (; col < CoarseMipWidth; ++col)
         {
             auto src_col0 = col * 2;
             auto src_col1 = std::min(col * 2 + 1, Attribs.FineMipWidth - 1);
@@ -361,10 +635,10 @@ void ComputeMipLevelInternal(const ComputeMipLevelAttribs& Attribs,
             MIP_FILTER_TYPE_BOX_AVERAGE;
     }
 
-    FilterMipLevel<ChannelType>(Attribs, FmtAttribs.NumComponents,
-                                FilterType == MIP_FILTER_TYPE_BOX_AVERAGE ?
-                                    LinearAverage<ChannelType> :
-                                    MostFrequentSelector<ChannelType>);
+    if (FilterType == MIP_FILTER_TYPE_BOX_AVERAGE)
+        FilterMipLevel<ChannelType>(Attribs, FmtAttribs.NumComponents, LinearAverage<ChannelType>, GetBoxFilterRowFunc(FmtAttribs));
+    else
+        FilterMipLevel<ChannelType>(Attribs, FmtAttribs.NumComponents, MostFrequentSelector<ChannelType>);
 }
 
 void ComputeMipLevel(const ComputeMipLevelAttribs& Attribs)
@@ -385,10 +659,10 @@ void ComputeMipLevel(const ComputeMipLevelAttribs& Attribs)
     {
         case COMPONENT_TYPE_UNORM_SRGB:
             VERIFY(FmtAttribs.ComponentSize == 1, "Only 8-bit sRGB formats are expected");
-            FilterMipLevel<Uint8>(Attribs, FmtAttribs.NumComponents,
-                                  Attribs.FilterType == MIP_FILTER_TYPE_MOST_FREQUENT ?
-                                      MostFrequentSelector<Uint8> :
-                                      SRGBAverage<Uint8>);
+            if (Attribs.FilterType == MIP_FILTER_TYPE_MOST_FREQUENT)
+                FilterMipLevel<Uint8>(Attribs, FmtAttribs.NumComponents, MostFrequentSelector<Uint8>);
+            else
+                FilterMipLevel<Uint8>(Attribs, FmtAttribs.NumComponents, SRGBAverage, GetBoxFilterRowFunc(FmtAttribs));
             if (Attribs.AlphaCutoff > 0)
             {
                 RemapAlpha(Attribs, FmtAttribs.NumComponents, FmtAttribs.NumComponents - 1);
@@ -451,6 +725,76 @@ void ComputeMipLevel(const ComputeMipLevelAttribs& Attribs)
     }
 }
 
+void ComputeMipChain(const ComputeMipChainAttribs& Attribs)
+{
+    DEV_CHECK_ERR(Attribs.Width != 0 && Attribs.Height != 0, "Texture dimensions must not be zero");
+    DEV_CHECK_ERR(Attribs.ppMipData != nullptr, "Mip level data must not be null");
+    DEV_CHECK_ERR(Attribs.pMipStrides != nullptr, "Mip level strides must not be null");
+
+    const auto NumMipLevels = Attribs.NumMipLevels != 0 ? Attribs.NumMipLevels : ComputeMipLevelsCount(Attribs.Width, Attribs.Height);
+
+    const auto NumThreads = Attribs.NumThreads != 0 ?
+        Attribs.NumThreads :
+        std::max(std::thread::hardware_concurrency(), 1u);
+
+    // Do not bother with threads for levels that are too small
+    static constexpr Uint32 MinTexelsPerThread = 16384;
+
+    std::unique_ptr<ThreadPool>    pThreadPool;
+    std::vector<std::future<void>> Futures;
+    for (Uint32 CoarseMip = 1; CoarseMip < NumMipLevels; ++CoarseMip)
+    {
+        const auto FineMip = CoarseMip - 1;
+
+        ComputeMipLevelAttribs LevelAttribs;
+        LevelAttribs.Format          = Attribs.Format;
+        LevelAttribs.FineMipWidth    = std::max(Attribs.Width >> FineMip, 1u);
+        LevelAttribs.FineMipHeight   = std::max(Attribs.Height >> FineMip, 1u);
+        LevelAttribs.pFineMipData    = Attribs.ppMipData[FineMip];
+        LevelAttribs.FineMipStride   = Attribs.pMipStrides[FineMip];
+        LevelAttribs.pCoarseMipData  = Attribs.ppMipData[CoarseMip];
+        LevelAttribs.CoarseMipStride = Attribs.pMipStrides[CoarseMip];
+        LevelAttribs.FilterType      = Attribs.FilterType;
+        LevelAttribs.AlphaCutoff     = Attribs.AlphaCutoff;
+
+        const auto CoarseWidth  = std::max(LevelAttribs.FineMipWidth / 2u, 1u);
+        const auto CoarseHeight = std::max(LevelAttribs.FineMipHeight / 2u, 1u);
+
+        // Split the level into bands of coarse rows. Band height must be a multiple of 4
+        // to keep the pixel pattern of the most-frequent filter intact.
+        auto BandHeight = std::max(MinTexelsPerThread / CoarseWidth, 1u);
+        BandHeight      = std::max(BandHeight, (CoarseHeight + NumThreads - 1) / NumThreads);
+        BandHeight      = (BandHeight + 3u) & ~3u;
+        if (NumThreads == 1 || BandHeight >= CoarseHeight || LevelAttribs.FineMipHeight == 1)
+        {
+            ComputeMipLevel(LevelAttribs);
+            continue;
+        }
+
+        if (!pThreadPool)
+            pThreadPool.reset(new ThreadPool{NumThreads - 1});
+
+        for (Uint32 StartRow = 0; StartRow < CoarseHeight; StartRow += BandHeight)
+        {
+            ComputeMipLevelAttribs BandAttribs{LevelAttribs};
+            BandAttribs.pFineMipData   = reinterpret_cast<const Uint8*>(LevelAttribs.pFineMipData) + size_t{StartRow} * 2 * LevelAttribs.FineMipStride;
+            BandAttribs.pCoarseMipData = reinterpret_cast<Uint8*>(LevelAttribs.pCoarseMipData) + size_t{StartRow} * LevelAttribs.CoarseMipStride;
+            // The last band includes the odd fine row, if any
+            BandAttribs.FineMipHeight = StartRow + BandHeight < CoarseHeight ? BandHeight * 2 : LevelAttribs.FineMipHeight - StartRow * 2;
+
+            if (StartRow + BandHeight < CoarseHeight)
+                Futures.emplace_back(pThreadPool->Enqueue([BandAttribs]() { ComputeMipLevel(BandAttribs); }));
+            else
+                ComputeMipLevel(BandAttribs); // The last band is processed by the calling thread
+        }
+
+        // The next level reads the results of this one
+        for (auto& Future : Futures)
+            Future.get();
+        Futures.clear();
+    }
+}
+
 } // namespace Diligent
 
 
@@ -483,4 +827,9 @@ extern "C"
     {
         Diligent::ComputeMipLevel(Attribs);
     }
+
+    void Diligent_ComputeMipChain(const Diligent::ComputeMipChainAttribs& Attribs)
+    {
+        Diligent::ComputeMipChain(Attribs);
+    }
 }
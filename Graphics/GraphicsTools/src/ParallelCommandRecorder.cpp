@@ -0,0 +1,161 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ParallelCommandRecorder.hpp"
+
+#include <algorithm>
+#include <future>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+ParallelCommandRecorder::ParallelCommandRecorder(const ParallelCommandRecorderCreateInfo& CreateInfo) :
+    m_pImmediateContext{CreateInfo.pImmediateContext},
+    m_MinPacketsPerContext{std::max(CreateInfo.MinPacketsPerContext, 1u)}
+{
+    if (!m_pImmediateContext)
+        LOG_ERROR_AND_THROW("Immediate context must not be null");
+
+    if (m_pImmediateContext->GetDesc().IsDeferred)
+        LOG_ERROR_AND_THROW("Context '", m_pImmediateContext->GetDesc().Name, "' is not an immediate context");
+
+    if (CreateInfo.NumDeferredContexts == 0 || CreateInfo.ppDeferredContexts == nullptr)
+        LOG_ERROR_AND_THROW("At least one deferred context is required");
+
+    m_DeferredContexts.reserve(CreateInfo.NumDeferredContexts);
+    for (Uint32 i = 0; i < CreateInfo.NumDeferredContexts; ++i)
+    {
+        auto* pCtx = CreateInfo.ppDeferredContexts[i];
+        if (pCtx == nullptr)
+            LOG_ERROR_AND_THROW("Deferred context at index ", i, " is null");
+        if (!pCtx->GetDesc().IsDeferred)
+            LOG_ERROR_AND_THROW("Context '", pCtx->GetDesc().Name, "' is not a deferred context");
+        m_DeferredContexts.emplace_back(pCtx);
+    }
+    m_CommandLists.resize(m_DeferredContexts.size());
+
+    if (m_DeferredContexts.size() > 1)
+        m_pThreadPool = std::make_unique<ThreadPool>(static_cast<Uint32>(m_DeferredContexts.size() - 1));
+}
+
+ParallelCommandRecorder::~ParallelCommandRecorder()
+{
+}
+
+void ParallelCommandRecorder::RecordRange(Uint32 CtxIdx, Uint32 StartPacket, Uint32 EndPacket, const RecordFuncType& RecordFunc)
+{
+    auto* pCtx = m_DeferredContexts[CtxIdx].RawPtr();
+    pCtx->Begin(m_pImmediateContext->GetDesc().ContextId);
+    try
+    {
+        RecordFunc(pCtx, StartPacket, EndPacket);
+    }
+    catch (...)
+    {
+        // Leave the context in a valid state
+        pCtx->FinishCommandList(&m_CommandLists[CtxIdx]);
+        throw;
+    }
+    pCtx->FinishCommandList(&m_CommandLists[CtxIdx]);
+}
+
+Uint32 ParallelCommandRecorder::Record(Uint32 NumPackets, const RecordFuncType& RecordFunc)
+{
+    if (NumPackets == 0)
+        return 0;
+
+    const auto NumRanges = std::min(static_cast<Uint32>(m_DeferredContexts.size()),
+                                    (NumPackets + m_MinPacketsPerContext - 1) / m_MinPacketsPerContext);
+    VERIFY_EXPR(NumRanges > 0);
+
+    const auto GetRangeStart = [NumPackets, NumRanges](Uint32 Range) {
+        return static_cast<Uint32>((Uint64{NumPackets} * Range) / NumRanges);
+    };
+
+    std::vector<std::future<void>> Tasks;
+    Tasks.reserve(NumRanges - 1);
+    for (Uint32 Range = 1; Range < NumRanges; ++Range)
+    {
+        VERIFY_EXPR(m_pThreadPool);
+        const auto StartPacket = GetRangeStart(Range);
+        const auto EndPacket   = GetRangeStart(Range + 1);
+        Tasks.emplace_back(m_pThreadPool->Enqueue(
+            [this, Range, StartPacket, EndPacket, &RecordFunc]() {
+                RecordRange(Range, StartPacket, EndPacket, RecordFunc);
+            }));
+    }
+
+    std::exception_ptr pException;
+    try
+    {
+        RecordRange(0, 0, GetRangeStart(1), RecordFunc);
+    }
+    catch (...)
+    {
+        pException = std::current_exception();
+    }
+
+    // Wait for all tasks even if one of them failed as they reference RecordFunc
+    for (auto& Task : Tasks)
+    {
+        try
+        {
+            Task.get();
+        }
+        catch (...)
+        {
+            if (!pException)
+                pException = std::current_exception();
+        }
+    }
+
+    if (!pException)
+    {
+        std::vector<ICommandList*> pCmdLists(NumRanges);
+        for (Uint32 Range = 0; Range < NumRanges; ++Range)
+            pCmdLists[Range] = m_CommandLists[Range];
+        m_pImmediateContext->ExecuteCommandLists(NumRanges, pCmdLists.data());
+    }
+
+    for (auto& pCmdList : m_CommandLists)
+        pCmdList.Release();
+
+    if (pException)
+        std::rethrow_exception(pException);
+
+    return NumRanges;
+}
+
+void ParallelCommandRecorder::FinishFrame()
+{
+    for (auto& pCtx : m_DeferredContexts)
+        pCtx->FinishFrame();
+}
+
+} // namespace Diligent
@@ -32,6 +32,10 @@
 #include <unordered_map>
 #include <vector>
 #include <array>
+#include <cstring>
+#include <ostream>
+#include <mutex>
+#include <atomic>
 
 #include "HLSL2GLSLConverter.h"
 #include "ObjectBase.hpp"
@@ -40,6 +44,7 @@
 #include "HashUtils.hpp"
 #include "HLSLKeywords.h"
 #include "Constants.h"
+#include "STDAllocator.hpp"
 
 namespace Diligent
 {
@@ -163,6 +168,78 @@ public:
                       size_t                           NumSymbols,
                       IHLSL2GLSLConversionStream**     ppStream) const;
 
+    /// Cache of conversion results
+
+    /// The cache maps the hash of the preprocessed HLSL source (i.e. the source with all
+    /// includes inlined), the entry point, the shader type and the conversion flags to the
+    /// resulting GLSL source. When a conversion stream finds the result in the cache, it
+    /// skips tokenization and conversion altogether, so re-creating the same shader
+    /// only costs loading its source and includes.
+    /// The cache is disabled by default. The memory cache is bounded by the maximum size;
+    /// when it is exceeded, the least recently used results are evicted.
+    /// Optionally, results are also stored in a directory on disk, which allows
+    /// reusing them across application runs. Every file starts with a header that holds
+    /// the key and the hash of the payload; files that fail validation are ignored.
+    /// All methods are thread-safe.
+    class ResultCache
+    {
+    public:
+        using Stats = HLSL2GLSLResultCacheStats;
+
+        /// Enables or disables the cache.
+        /// Disabling the cache does not release the results; use Clear() for this.
+        void SetEnabled(bool Enabled);
+
+        bool IsEnabled() const { return m_Enabled.load(); }
+
+        /// Sets the maximum total size of the results kept in memory. Zero means no limit.
+        void SetMaxMemorySize(size_t MaxMemorySize);
+
+        /// Sets the directory where conversion results are stored.
+        /// The directory must exist. Null or empty string disables the on-disk store.
+        void SetDirectory(const Char* Directory);
+
+        /// Releases all results kept in memory. Results stored on disk are not affected.
+        void Clear();
+
+        Stats GetStats() const;
+
+        bool Find(const ContentHash& Key, String& GLSLSource);
+        void Add(const ContentHash& Key, const String& GLSLSource);
+
+    private:
+        struct Entry
+        {
+            String GLSLSource;
+
+            // Position of the key in the LRU list
+            std::list<ContentHash>::iterator LRUPos;
+        };
+
+        String GetFilePath(const ContentHash& Key) const;
+
+        bool ReadFile(const String& FilePath, const ContentHash& Key, String& GLSLSource) const;
+        void WriteFile(const String& FilePath, const ContentHash& Key, const String& GLSLSource) const;
+
+        // Inserts the result into the memory cache and evicts the least recently used
+        // results to stay within the size limit. Must be called with the mutex locked.
+        void InsertLocked(const ContentHash& Key, const String& GLSLSource);
+        void EvictLocked();
+
+        std::atomic_bool m_Enabled{false};
+
+        mutable std::mutex                                          m_Mtx;
+        std::unordered_map<ContentHash, Entry, ContentHash::Hasher> m_Results;
+        // Most recently used keys are at the front
+        std::list<ContentHash> m_LRU;
+        size_t                 m_MaxMemorySize = size_t{16} << 20;
+        String                 m_Directory;
+        Stats                  m_Stats;
+    };
+
+    /// Returns the conversion result cache.
+    ResultCache& GetResultCache() const { return m_ResultCache; }
+
 private:
     HLSL2GLSLConverterImpl();
 
@@ -248,11 +325,204 @@ private:
     };
     // clang-format on
 
+    /// Token string that either references a range of the tokenized source
+    /// or owns its characters.
+
+    /// Tokens produced by the tokenizer reference the source buffer, which
+    /// avoids allocating a string for every literal and delimiter. The string
+    /// is converted into an owned string the first time it is modified.
+    class TokenString
+    {
+    public:
+        TokenString() noexcept {}
+
+        TokenString(const Char* Str) :
+            m_Str{Str}
+        {}
+
+        TokenString(String Str) noexcept :
+            m_Str{std::move(Str)}
+        {}
+
+        /// Creates a string that references external memory.
+        /// The memory must outlive the string and all its copies.
+        static TokenString View(const Char* pData, size_t Length)
+        {
+            VERIFY_EXPR(pData != nullptr);
+            TokenString Str;
+            Str.m_pView      = pData;
+            Str.m_ViewLength = Length;
+            return Str;
+        }
+
+        // clang-format off
+        const Char* data()   const { return m_pView != nullptr ? m_pView : m_Str.data(); }
+        size_t      size()   const { return m_pView != nullptr ? m_ViewLength : m_Str.size(); }
+        size_t      length() const { return size(); }
+        bool        empty()  const { return size() == 0; }
+        const Char* begin()  const { return data(); }
+        const Char* end()    const { return data() + size(); }
+        // clang-format on
+
+        Char operator[](size_t i) const
+        {
+            VERIFY_EXPR(i < size());
+            return data()[i];
+        }
+
+        Char back() const
+        {
+            VERIFY_EXPR(!empty());
+            return data()[size() - 1];
+        }
+
+        /// Returns null-terminated string. A view is converted into an owned string.
+        const Char* c_str() const
+        {
+            MakeOwned();
+            return m_Str.c_str();
+        }
+
+        String str() const
+        {
+            return String{data(), size()};
+        }
+
+        TokenString& operator=(const Char* Str)
+        {
+            m_pView = nullptr;
+            m_Str   = Str;
+            return *this;
+        }
+
+        TokenString& operator=(String Str)
+        {
+            m_pView = nullptr;
+            m_Str   = std::move(Str);
+            return *this;
+        }
+
+        void push_back(Char Symbol)
+        {
+            MakeOwned();
+            m_Str.push_back(Symbol);
+        }
+
+        void pop_back()
+        {
+            VERIFY_EXPR(!empty());
+            if (m_pView != nullptr)
+                --m_ViewLength;
+            else
+                m_Str.pop_back();
+        }
+
+        TokenString& append(const Char* Str)
+        {
+            MakeOwned();
+            m_Str.append(Str);
+            return *this;
+        }
+
+        TokenString& append(const String& Str)
+        {
+            MakeOwned();
+            m_Str.append(Str);
+            return *this;
+        }
+
+        TokenString& append(const TokenString& Str)
+        {
+            MakeOwned();
+            m_Str.append(Str.data(), Str.size());
+            return *this;
+        }
+
+        void clear()
+        {
+            m_pView = nullptr;
+            m_Str.clear();
+        }
+
+        bool operator==(const TokenString& Str) const
+        {
+            return size() == Str.size() && memcmp(data(), Str.data(), size()) == 0;
+        }
+
+        bool operator==(const Char* Str) const
+        {
+            return strlen(Str) == size() && memcmp(data(), Str, size()) == 0;
+        }
+
+        bool operator==(const String& Str) const
+        {
+            return Str.size() == size() && memcmp(data(), Str.data(), size()) == 0;
+        }
+
+        template <typename T>
+        bool operator!=(const T& Str) const
+        {
+            return !(*this == Str);
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const TokenString& Str)
+        {
+            return os.write(Str.data(), Str.size());
+        }
+
+    private:
+        void MakeOwned() const
+        {
+            if (m_pView != nullptr)
+            {
+                m_Str.assign(m_pView, m_ViewLength);
+                m_pView = nullptr;
+            }
+        }
+
+        mutable const Char* m_pView      = nullptr;
+        size_t              m_ViewLength = 0;
+        mutable String      m_Str;
+    };
+
+    /// Null-terminated copy of a token string that is used for hash map lookups.
+    /// Short strings are copied into the buffer on the stack, so that no memory is allocated.
+    class TokenCString
+    {
+    public:
+        explicit TokenCString(const TokenString& Str)
+        {
+            if (Str.size() < _countof(m_Buffer))
+            {
+                memcpy(m_Buffer, Str.data(), Str.size());
+                m_Buffer[Str.size()] = '\0';
+                m_pStr               = m_Buffer;
+            }
+            else
+            {
+                m_LongStr = Str.str();
+                m_pStr    = m_LongStr.c_str();
+            }
+        }
+
+        // clang-format off
+        TokenCString             (const TokenCString&) = delete;
+        TokenCString& operator = (const TokenCString&) = delete;
+        // clang-format on
+
+        const Char* c_str() const { return m_pStr; }
+
+    private:
+        Char        m_Buffer[128];
+        String      m_LongStr;
+        const Char* m_pStr = nullptr;
+    };
+
     struct TokenInfo
     {
-        TokenType Type;
-        String    Literal;
-        String    Delimiter;
+        TokenType   Type;
+        TokenString Literal;
+        TokenString Delimiter;
 
         bool IsBuiltInType() const
         {
@@ -269,14 +539,65 @@ private:
         }
 
         TokenInfo(TokenType   _Type      = TokenType::Undefined,
-                  const Char* _Literal   = "",
-                  const Char* _Delimiter = "") :
+                  TokenString _Literal   = TokenString{},
+                  TokenString _Delimiter = TokenString{}) :
             Type{_Type},
-            Literal{_Literal},
-            Delimiter{_Delimiter}
+            Literal{std::move(_Literal)},
+            Delimiter{std::move(_Delimiter)}
         {}
     };
-    typedef std::list<TokenInfo> TokenListType;
+
+    /// Single-threaded pool that allocates token list nodes from contiguous pages
+    /// and recycles released nodes.
+
+    /// Besides the nodes, the list may allocate other objects through the same allocator
+    /// (e.g. the container proxy in MSVC debug builds), so the pool keeps a separate free
+    /// list for every requested size. Pages start small and grow up to MaxNodesInPage nodes.
+    class TokenNodePool final : public IMemoryAllocator
+    {
+    public:
+        explicit TokenNodePool(size_t MaxNodesInPage = 1024) :
+            m_MaxNodesInPage{MaxNodesInPage}
+        {}
+        ~TokenNodePool();
+
+        // clang-format off
+        TokenNodePool             (const TokenNodePool&) = delete;
+        TokenNodePool             (TokenNodePool&&)      = delete;
+        TokenNodePool& operator = (const TokenNodePool&) = delete;
+        TokenNodePool& operator = (TokenNodePool&&)      = delete;
+        // clang-format on
+
+        virtual void* Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber) override final;
+
+        virtual void Free(void* Ptr) override final;
+
+        size_t GetNumPages() const { return m_Pages.size(); }
+
+    private:
+        struct SizeClass
+        {
+            size_t NodeSize   = 0;
+            void*  pFreeNodes = nullptr;
+
+            // The page that new nodes of this size are taken from
+            Uint8* pCurrPage        = nullptr;
+            size_t NumNodesInPage   = 0;
+            size_t NumUsedPageNodes = 0;
+        };
+        std::vector<SizeClass> m_SizeClasses;
+
+        struct PageInfo
+        {
+            Uint8* pData;
+            size_t Size;
+            size_t SizeClassIdx;
+        };
+        std::vector<PageInfo> m_Pages;
+
+        const size_t m_MaxNodesInPage;
+    };
+    typedef std::list<TokenInfo, STDAllocator<TokenInfo, TokenNodePool>> TokenListType;
 
 
     class ConversionStream : public ObjectBase<IHLSL2GLSLConversionStream>
@@ -326,11 +647,17 @@ private:
 
     private:
         void InsertIncludes(String& GLSLSource, IShaderSourceInputStreamFactory* pSourceStreamFactory);
-        void Tokenize(const String& Source);
+        void Tokenize();
+
+        ContentHash ComputeResultKey(const Char* EntryPoint,
+                                     SHADER_TYPE ShaderType,
+                                     bool        IncludeDefintions,
+                                     const char* SamplerSuffix,
+                                     bool        UseInOutLocationQualifiers) const;
 
         typedef std::unordered_map<String, bool> SamplerHashType;
 
-        const HLSLObjectInfo* FindHLSLObject(const String& Name);
+        const HLSLObjectInfo* FindHLSLObject(const TokenString& Name);
 
         void ProcessShaderDeclaration(TokenListType::iterator EntryPointToken, SHADER_TYPE ShaderType);
 
@@ -510,6 +837,18 @@ private:
 
         String BuildGLSLSource();
 
+        // Source code with all includes inlined. Tokens reference this buffer.
+        String m_Source;
+
+        // Hash of m_Source that identifies conversion results in the result cache
+        ContentHash m_SourceHash;
+
+        // The source is tokenized when the result is not found in the cache
+        bool m_bTokenized = false;
+
+        // Pool that allocates token list nodes
+        TokenNodePool m_TokenPool;
+
         // Tokenized source code
         TokenListType m_Tokens;
 
@@ -534,6 +873,8 @@ private:
         const String m_InputFileName;
     };
 
+    mutable ResultCache m_ResultCache;
+
     // HLSL keyword->token info hash map
     // Example: "Texture2D" -> TokenInfo(TokenType::Texture2D, "Texture2D")
     std::unordered_map<HashMapStringKey, TokenInfo, HashMapStringKey::Hasher> m_HLSLKeywords;
@@ -50,6 +50,12 @@ public:
                                                  const Char*                      HLSLSource,
                                                  size_t                           NumSymbols,
                                                  IHLSL2GLSLConversionStream**     ppStream) const override;
+
+    virtual void DILIGENT_CALL_TYPE SetResultCacheAttribs(const HLSL2GLSLResultCacheAttribs& Attribs) const override;
+
+    virtual void DILIGENT_CALL_TYPE GetResultCacheStats(HLSL2GLSLResultCacheStats& Stats) const override;
+
+    virtual void DILIGENT_CALL_TYPE ClearResultCache() const override;
 };
 
 } // namespace Diligent
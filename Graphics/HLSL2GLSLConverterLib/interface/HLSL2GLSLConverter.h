@@ -74,6 +74,52 @@ DILIGENT_END_INTERFACE
 #endif
 
 
+/// HLSL to GLSL conversion result cache attributes, see IHLSL2GLSLConverter::SetResultCacheAttribs().
+struct HLSL2GLSLResultCacheAttribs
+{
+    /// Whether conversion results are cached. The cache is disabled by default.
+    Bool Enabled DEFAULT_INITIALIZER(False);
+
+    /// The maximum total size of the results kept in memory, in bytes.
+    /// When the limit is exceeded, the least recently used results are evicted.
+    /// Zero means no limit.
+    Uint64 MaxMemorySize DEFAULT_INITIALIZER(16 << 20);
+
+    /// The directory where conversion results are additionally stored, so that they
+    /// can be reused across application runs. The directory must exist.
+    /// Null or empty string disables the on-disk store.
+    const Char* Directory DEFAULT_INITIALIZER(nullptr);
+};
+typedef struct HLSL2GLSLResultCacheAttribs HLSL2GLSLResultCacheAttribs;
+
+
+/// HLSL to GLSL conversion result cache statistics, see IHLSL2GLSLConverter::GetResultCacheStats().
+struct HLSL2GLSLResultCacheStats
+{
+    /// The number of results in the memory cache.
+    Uint32 NumEntries DEFAULT_INITIALIZER(0);
+
+    /// The total size of all results in the memory cache, in bytes.
+    Uint64 TotalSize DEFAULT_INITIALIZER(0);
+
+    /// The number of lookups that were satisfied from memory.
+    Uint64 NumHits DEFAULT_INITIALIZER(0);
+
+    /// The number of lookups that were satisfied from disk.
+    Uint64 NumDiskHits DEFAULT_INITIALIZER(0);
+
+    /// The number of lookups that required the conversion.
+    Uint64 NumMisses DEFAULT_INITIALIZER(0);
+
+    /// The number of results evicted from memory to stay within the size limit.
+    Uint64 NumEvictions DEFAULT_INITIALIZER(0);
+
+    /// The number of on-disk results that were rejected because they failed validation.
+    Uint64 NumRejectedFiles DEFAULT_INITIALIZER(0);
+};
+typedef struct HLSL2GLSLResultCacheStats HLSL2GLSLResultCacheStats;
+
+
 // {44A21160-77E0-4DDC-A57E-B8B8B65B5342}
 static const INTERFACE_ID IID_HLSL2GLSLConverter =
     {0x44a21160, 0x77e0, 0x4ddc, {0xa5, 0x7e, 0xb8, 0xb8, 0xb6, 0x5b, 0x53, 0x42}};
@@ -96,6 +142,22 @@ DILIGENT_BEGIN_INTERFACE(IHLSL2GLSLConverter, IObject)
                                       const Char*                      HLSLSource,
                                       size_t                           NumSymbols,
                                       IHLSL2GLSLConversionStream**     ppStream) CONST PURE;
+
+    /// Sets the conversion result cache attributes.
+
+    /// \param [in] Attribs - Cache attributes, see Diligent::HLSL2GLSLResultCacheAttribs.
+    ///
+    /// \remarks   The cache is shared by all converter objects.
+    ///            Disabling the cache does not release the results; use ClearResultCache() for this.
+    VIRTUAL void METHOD(SetResultCacheAttribs)(THIS_
+                                               const HLSL2GLSLResultCacheAttribs REF Attribs) CONST PURE;
+
+    /// Returns the conversion result cache statistics.
+    VIRTUAL void METHOD(GetResultCacheStats)(THIS_
+                                             HLSL2GLSLResultCacheStats REF Stats) CONST PURE;
+
+    /// Releases all results kept in memory. Results stored on disk are not affected.
+    VIRTUAL void METHOD(ClearResultCache)(THIS) CONST PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -105,7 +167,10 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IHLSL2GLSLConverter_CreateStream(This, ...) CALL_IFACE_METHOD(HLSL2GLSLConverter, CreateStream, This, __VA_ARGS__)
+#    define IHLSL2GLSLConverter_CreateStream(This, ...)          CALL_IFACE_METHOD(HLSL2GLSLConverter, CreateStream,          This, __VA_ARGS__)
+#    define IHLSL2GLSLConverter_SetResultCacheAttribs(This, ...) CALL_IFACE_METHOD(HLSL2GLSLConverter, SetResultCacheAttribs, This, __VA_ARGS__)
+#    define IHLSL2GLSLConverter_GetResultCacheStats(This, ...)   CALL_IFACE_METHOD(HLSL2GLSLConverter, GetResultCacheStats,   This, __VA_ARGS__)
+#    define IHLSL2GLSLConverter_ClearResultCache(This)           CALL_IFACE_METHOD(HLSL2GLSLConverter, ClearResultCache,      This)
 
 // clang-format on
 
@@ -356,13 +356,17 @@
 #include "pch.h"
 #include <unordered_set>
 #include <string>
+#include <cstdio>
 
 #include "HLSL2GLSLConverterImpl.hpp"
 #include "GraphicsAccessories.hpp"
 #include "DataBlobImpl.hpp"
 #include "StringDataBlobImpl.hpp"
+#include "MemoryFileStream.hpp"
 #include "StringTools.hpp"
 #include "EngineMemory.h"
+#include "Align.hpp"
+#include "FileWrapper.hpp"
 
 using namespace std;
 
@@ -768,7 +772,8 @@ HLSL2GLSLConverterImpl::HLSL2GLSLConverterImpl()
 #undef DEFINE_VARIABLE
 }
 
-String CompressNewLines(const String& Str)
+template <typename StringType>
+String CompressNewLines(const StringType& Str)
 {
     String Out;
     auto   Char = Str.begin();
@@ -794,7 +799,8 @@ String CompressNewLines(const String& Str)
     return Out;
 }
 
-static Int32 CountNewLines(const String& Str)
+template <typename StringType>
+static Int32 CountNewLines(const StringType& Str)
 {
     Int32 NumNewLines = 0;
     auto  Char        = Str.begin();
@@ -873,7 +879,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::PrintTokenContext(IteratorType&
     for (; Token != CurrLineStartToken; ++Token)
     {
         Ctx.append(CompressNewLines(Token->Delimiter));
-        Ctx.append(Token->Literal);
+        Ctx.append(Token->Literal.data(), Token->Literal.size());
     }
 
     //\n  if ( x != 0 )
@@ -905,7 +911,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::PrintTokenContext(IteratorType&
             Spaces.append(Token->Literal.length(), ' ');
 
         Ctx.append(CompressNewLines(Token->Delimiter));
-        Ctx.append(Token->Literal);
+        Ctx.append(Token->Literal.data(), Token->Literal.size());
         ++Token;
 
         if (Token == m_Tokens.end())
@@ -923,7 +929,7 @@ String HLSL2GLSLConverterImpl::ConversionStream::PrintTokenContext(IteratorType&
     while (Token != m_Tokens.end() && NumLinesBelow <= NumAdjacentLines)
     {
         Ctx.append(CompressNewLines(Token->Delimiter));
-        Ctx.append(Token->Literal);
+        Ctx.append(Token->Literal.data(), Token->Literal.size());
         ++Token;
 
         if (Token == m_Tokens.end())
@@ -977,10 +983,13 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
     // Put all the includes into the set to avoid multiple inclusion
     std::unordered_set<String> ProcessedIncludes;
 
+    // Position where the search for the next #include starts. Everything before it
+    // has already been processed, so there is no need to scan it again.
+    size_t SearchStart = 0;
     do
     {
         // Find the first #include statement
-        auto Pos             = GLSLSource.begin();
+        auto Pos             = GLSLSource.begin() + SearchStart;
         auto IncludeStartPos = GLSLSource.end();
         while (Pos != GLSLSource.end())
         {
@@ -1047,6 +1056,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
         // #   include "TestFile.fxh"
         // ^                         ^
         // IncludeStartPos           Pos
+        SearchStart = IncludeStartPos - GLSLSource.begin();
         GLSLSource.erase(IncludeStartPos, Pos);
 
         // Convert the name to lower case
@@ -1061,62 +1071,71 @@ void HLSL2GLSLConverterImpl::ConversionStream::InsertIncludes(String& GLSLSource
             pSourceStreamFactory->CreateInputStream(IncludeName.c_str(), &pIncludeDataStream);
             if (!pIncludeDataStream)
                 LOG_ERROR_AND_THROW("Failed to open include file ", IncludeName);
-            RefCntAutoPtr<IDataBlob> pIncludeData(MakeNewRCObj<DataBlobImpl>()(0));
-            pIncludeDataStream->ReadBlob(pIncludeData);
+            auto pIncludeData = ReadStreamBlob(pIncludeDataStream);
 
             // Get include text
             auto   IncludeText = reinterpret_cast<const Char*>(pIncludeData->GetDataPtr());
             size_t NumSymbols  = pIncludeData->GetSize();
 
-            // Insert the text into source
-            GLSLSource.insert(IncludeStartPos - GLSLSource.begin(), IncludeText, NumSymbols);
+            // Insert the text into source. The search continues from the start of the inserted
+            // text to process nested includes.
+            GLSLSource.insert(SearchStart, IncludeText, NumSymbols);
         }
     } while (true);
 }
 
 
-void ReadNumericConstant(const String& Source, String::const_iterator& Pos, String& Output)
+void SkipNumericConstant(const String& Source, String::const_iterator& Pos)
 {
-#define COPY_SYMBOL()                    \
+#define SKIP_SYMBOL()                    \
     {                                    \
-        Output.push_back(*(Pos++));      \
+        ++Pos;                           \
         if (Pos == Source.end()) return; \
     }
 
     while (Pos != Source.end() && *Pos >= '0' && *Pos <= '9')
-        COPY_SYMBOL()
+        SKIP_SYMBOL()
 
     if (*Pos == '.')
     {
-        COPY_SYMBOL()
-        // Copy all numbers
+        SKIP_SYMBOL()
+        // Skip all numbers
         while (Pos != Source.end() && *Pos >= '0' && *Pos <= '9')
-            COPY_SYMBOL()
+            SKIP_SYMBOL()
     }
 
     // Scientific notation
     // e+1242, E-234
     if (*Pos == 'e' || *Pos == 'E')
     {
-        COPY_SYMBOL()
+        SKIP_SYMBOL()
 
         if (*Pos == '+' || *Pos == '-')
-            COPY_SYMBOL()
+            SKIP_SYMBOL()
 
         // Skip all numbers
         while (Pos != Source.end() && *Pos >= '0' && *Pos <= '9')
-            COPY_SYMBOL()
+            SKIP_SYMBOL()
     }
 
     if (*Pos == 'f' || *Pos == 'F')
-        COPY_SYMBOL()
-#undef COPY_SYMBOL
+        SKIP_SYMBOL()
+#undef SKIP_SYMBOL
 }
 
 
-// The function converts source code into a token list
-void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
+// The function converts source code into a token list.
+// Token literals and delimiters reference the source buffer, which must not change
+// while the tokens are alive.
+void HLSL2GLSLConverterImpl::ConversionStream::Tokenize()
 {
+    const auto& Source = m_Source;
+
+    // Creates a token string that references the source range [Start, End)
+    auto MakeView = [&Source](String::const_iterator Start, String::const_iterator End) {
+        return TokenString::View(Source.data() + (Start - Source.begin()), static_cast<size_t>(End - Start));
+    };
+
 #define CHECK_END(...)                      \
     do                                      \
     {                                       \
@@ -1148,11 +1167,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
         auto      DelimStart = SrcPos;
         SkipDelimetersAndComments(Source, SrcPos);
         if (DelimStart != SrcPos)
-        {
-            auto DelimSize = SrcPos - DelimStart;
-            NewToken.Delimiter.reserve(DelimSize);
-            NewToken.Delimiter.append(DelimStart, SrcPos);
-        }
+            NewToken.Delimiter = MakeView(DelimStart, SrcPos);
         if (SrcPos == Source.end())
             break;
 
@@ -1166,9 +1181,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                 SkipDelimetersAndComments(Source, SrcPos);
                 CHECK_END("Missing preprocessor directive");
                 SkipIdentifier(Source, SrcPos);
-                auto DirectiveSize = SrcPos - DirectiveStart;
-                NewToken.Literal.reserve(DirectiveSize);
-                NewToken.Literal.append(DirectiveStart, SrcPos);
+                NewToken.Literal = MakeView(DirectiveStart, SrcPos);
             }
             break;
 
@@ -1294,8 +1307,12 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                 ++SrcPos;
                 //[domain("quad")]
                 //         ^
-                while (SrcPos != Source.end() && *SrcPos != '"')
-                    NewToken.Literal.push_back(*(SrcPos++));
+                {
+                    auto StringStart = SrcPos;
+                    while (SrcPos != Source.end() && *SrcPos != '"')
+                        ++SrcPos;
+                    NewToken.Literal = MakeView(StringStart, SrcPos);
+                }
                 //[domain("quad")]
                 //             ^
                 if (SrcPos != Source.end())
@@ -1327,10 +1344,9 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                 SkipIdentifier(Source, SrcPos);
                 if (IdentifierStartPos != SrcPos)
                 {
-                    auto IDSize = SrcPos - IdentifierStartPos;
-                    NewToken.Literal.reserve(IDSize);
-                    NewToken.Literal.append(IdentifierStartPos, SrcPos);
-                    auto KeywordIt = m_Converter.m_HLSLKeywords.find(NewToken.Literal.c_str());
+                    NewToken.Literal = MakeView(IdentifierStartPos, SrcPos);
+
+                    auto KeywordIt = m_Converter.m_HLSLKeywords.find(TokenCString{NewToken.Literal}.c_str());
                     if (KeywordIt != m_Converter.m_HLSLKeywords.end())
                     {
                         NewToken.Type = KeywordIt->second.Type;
@@ -1352,8 +1368,10 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
                     }
                     if (bIsNumericalCostant)
                     {
-                        ReadNumericConstant(Source, SrcPos, NewToken.Literal);
-                        NewToken.Type = TokenType::NumericConstant;
+                        auto ConstantStart = SrcPos;
+                        SkipNumericConstant(Source, SrcPos);
+                        NewToken.Literal = MakeView(ConstantStart, SrcPos);
+                        NewToken.Type    = TokenType::NumericConstant;
                     }
                 }
 
@@ -1366,7 +1384,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::Tokenize(const String& Source)
             }
         }
 
-        m_Tokens.push_back(NewToken);
+        m_Tokens.push_back(std::move(NewToken));
     }
 #undef CHECK_END
 }
@@ -1567,7 +1585,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessStructuredBuffer(TokenList
     if (Token->Delimiter.empty())
         Token->Delimiter = " ";
 
-    m_Tokens.insert(OpenBraceToken, TokenInfo(TokenType::Identifier, Token->Literal.c_str(), " "));
+    m_Tokens.insert(OpenBraceToken, TokenInfo(TokenType::Identifier, Token->Literal, " "));
     //          OpenBraceToken
     //              V
     // buffer g_Data{DataType g_Data;
@@ -1604,8 +1622,9 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessStructuredBuffer(TokenList
     // buffer g_Data{DataType g_Data[]};
     //                                 ^
     ++Token;
-    String NameRedefine("#define ");
-    NameRedefine += GlobalVarNameToken->Literal + ' ' + GlobalVarNameToken->Literal + "_data\r\n";
+    String     NameRedefine("#define ");
+    const auto VarName = GlobalVarNameToken->Literal.str();
+    NameRedefine += VarName + ' ' + VarName + "_data\r\n";
     m_Tokens.insert(Token, TokenInfo(TokenType::TextBlock, NameRedefine.c_str(), "\r\n"));
     GlobalVarNameToken->Literal.append("_data");
     // buffer g_Data{DataType g_Data_data[]};
@@ -1728,7 +1747,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ParseSamplers(TokenListType::iter
                 const auto& SamplerName = Token->Literal;
 
                 // Add sampler state into the hash map
-                SamplersHash.insert(std::make_pair(SamplerName, bIsComparison));
+                SamplersHash.insert(std::make_pair(SamplerName.str(), bIsComparison));
 
                 ++Token;
                 // SamplerState LinearClamp ;
@@ -1966,13 +1985,13 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessTextureDeclaration(TokenLi
         {
             // RWTexture2D<float /* format = r32f */ >
             //                                       ^
-            ParseImageFormat(Token->Delimiter, ImgFormat);
+            ParseImageFormat(Token->Delimiter.str(), ImgFormat);
             if (ImgFormat.length() == 0)
             {
                 // RWTexture2D</* format = r32f */ float >
                 //                                 ^
                 //                            TexFmtToken
-                ParseImageFormat(TexFmtToken->Delimiter, ImgFormat);
+                ParseImageFormat(TexFmtToken->Delimiter.str(), ImgFormat);
             }
 
             if (ImgFormat.length() != 0)
@@ -2078,7 +2097,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessTextureDeclaration(TokenLi
         if (!IsRWTexture)
         {
             // Try to find matching sampler
-            auto SamplerName = TextureName + SamplerSuffix;
+            auto SamplerName = TextureName.str() + SamplerSuffix;
             // Search all scopes starting with the innermost
             for (auto ScopeIt = Samplers.rbegin(); ScopeIt != Samplers.rend(); ++ScopeIt)
             {
@@ -2112,7 +2131,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessTextureDeclaration(TokenLi
                 TexDeclToken->Literal.append("IMAGE_WRITEONLY "); // defined as 'writeonly' on GLES and as '' on desktop in GLSLDefinitions.h
         }
         TexDeclToken->Literal.append(CompleteGLSLSampler);
-        Objects.m.insert(std::make_pair(HashMapStringKey(TextureName), HLSLObjectInfo{std::move(CompleteGLSLSampler), NumComponents, ArrayDim}));
+        Objects.m.insert(std::make_pair(HashMapStringKey{TextureName.c_str(), true}, HLSLObjectInfo{std::move(CompleteGLSLSampler), NumComponents, ArrayDim}));
 
         // In global scope, multiple variables can be declared in the same statement
         if (IsGlobalScope)
@@ -2185,11 +2204,12 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessTextureDeclaration(TokenLi
 
 
 // Finds an HLSL object with the given name in object stack
-const HLSL2GLSLConverterImpl::HLSLObjectInfo* HLSL2GLSLConverterImpl::ConversionStream::FindHLSLObject(const String& Name)
+const HLSL2GLSLConverterImpl::HLSLObjectInfo* HLSL2GLSLConverterImpl::ConversionStream::FindHLSLObject(const TokenString& Name)
 {
+    const TokenCString NameStr{Name};
     for (auto ScopeIt = m_Objects.rbegin(); ScopeIt != m_Objects.rend(); ++ScopeIt)
     {
-        auto It = ScopeIt->m.find(Name.c_str());
+        auto It = ScopeIt->m.find(NameStr.c_str());
         if (It != ScopeIt->m.end())
             return &It->second;
     }
@@ -2299,7 +2319,7 @@ bool HLSL2GLSLConverterImpl::ConversionStream::ProcessObjectMethod(TokenListType
     // TestText.Sample( TestText_sampler, float2(0.0, 1.0)  );
     //                                                       ^
     //                                               ArgsListEndToken
-    auto StubIt = m_Converter.m_GLSLStubs.find(FunctionStubHashKey(ObjectType, MethodToken->Literal.c_str(), NumArguments));
+    auto StubIt = m_Converter.m_GLSLStubs.find(FunctionStubHashKey(ObjectType, TokenCString{MethodToken->Literal}.c_str(), NumArguments));
     if (StubIt == m_Converter.m_GLSLStubs.end())
     {
         LOG_ERROR_MESSAGE("Unable to find function stub for ", IdentifierToken->Literal, ".", MethodToken->Literal, "(", NumArguments, " args). GLSL object type: ", ObjectType);
@@ -2322,7 +2342,7 @@ bool HLSL2GLSLConverterImpl::ConversionStream::ProcessObjectMethod(TokenListType
     // ^
     // IdentifierToken
 
-    m_Tokens.insert(IdentifierToken, TokenInfo(TokenType::Identifier, StubIt->second.Name.c_str(), IdentifierToken->Delimiter.c_str()));
+    m_Tokens.insert(IdentifierToken, TokenInfo(TokenType::Identifier, StubIt->second.Name.c_str(), IdentifierToken->Delimiter));
     IdentifierToken->Delimiter = " ";
     // FunctionStub TestTextArr[2], TestTextArr_sampler, ...
     //              ^
@@ -2547,7 +2567,7 @@ bool HLSL2GLSLConverterImpl::ConversionStream::ProcessRWTextureStore(TokenListTy
     // ^                                              ^
     // Token                                    SemicolonToken
 
-    m_Tokens.insert(Token, TokenInfo(TokenType::Identifier, "imageStore", Token->Delimiter.c_str()));
+    m_Tokens.insert(Token, TokenInfo(TokenType::Identifier, "imageStore", Token->Delimiter));
     m_Tokens.insert(Token, TokenInfo(TokenType::OpenBracket, "(", ""));
     Token->Delimiter = " ";
     // imageStore( RWTex[Location.xy] = float4(0.0, 0.0, 0.0, 1.0);
@@ -2653,7 +2673,7 @@ bool HLSL2GLSLConverterImpl::ConversionStream::ProcessRWTextureLoad(TokenListTyp
     //           ^           ^
     //  OpenStaplePos     ClosingStaplePos
 
-    m_Tokens.insert(Token, TokenInfo(TokenType::Identifier, "imageLoad", Token->Delimiter.c_str()));
+    m_Tokens.insert(Token, TokenInfo(TokenType::Identifier, "imageLoad", Token->Delimiter));
     m_Tokens.insert(Token, TokenInfo(TokenType::OpenBracket, "(", ""));
     Token->Delimiter = " ";
     // imageLoad( RWTex[Location.xy]
@@ -2754,7 +2774,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessAtomics(const TokenListTyp
     {
         if (Token->Type == TokenType::Identifier)
         {
-            auto AtomicIt = m_Converter.m_AtomicOperations.find(Token->Literal.c_str());
+            auto AtomicIt = m_Converter.m_AtomicOperations.find(TokenCString{Token->Literal}.c_str());
             if (AtomicIt == m_Converter.m_AtomicOperations.end())
             {
                 ++Token;
@@ -2785,7 +2805,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessAtomics(const TokenListTyp
             {
                 // InterlockedAdd(Tex2D[GTid.xy], 1, iOldVal);
                 //                ^
-                auto StubIt = m_Converter.m_GLSLStubs.find(FunctionStubHashKey("image", OperationToken->Literal.c_str(), NumArguments));
+                auto StubIt = m_Converter.m_GLSLStubs.find(FunctionStubHashKey("image", TokenCString{OperationToken->Literal}.c_str(), NumArguments));
                 VERIFY_PARSER_STATE(OperationToken, StubIt != m_Converter.m_GLSLStubs.end(), "Unable to find function stub for function ", OperationToken->Literal, " with ", NumArguments, " arguments");
 
                 // Find first comma
@@ -2835,7 +2855,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessAtomics(const TokenListTyp
             {
                 // InterlockedAdd(g_i4SharedArray[GTid.x].x, 1, iOldVal);
                 //                ^
-                auto StubIt = m_Converter.m_GLSLStubs.find(FunctionStubHashKey("shared_var", OperationToken->Literal.c_str(), NumArguments));
+                auto StubIt = m_Converter.m_GLSLStubs.find(FunctionStubHashKey("shared_var", TokenCString{OperationToken->Literal}.c_str(), NumArguments));
                 VERIFY_PARSER_STATE(OperationToken, StubIt != m_Converter.m_GLSLStubs.end(), "Unable to find function stub for function ", OperationToken->Literal, " with ", NumArguments, " arguments");
                 OperationToken->Literal = StubIt->second.Name;
                 // InterlockedAddSharedVar_3(g_i4SharedArray[GTid.x].x, 1, iOldVal);
@@ -2854,14 +2874,14 @@ void HLSL2GLSLConverterImpl::ConversionStream::ParseShaderParameter(TokenListTyp
     VERIFY_PARSER_STATE(Token, Token->IsBuiltInType() || Token->Type == TokenType::Identifier,
                         "Missing argument type");
     auto TypeToken = Token;
-    ParamInfo.Type = Token->Literal;
+    ParamInfo.Type = Token->Literal.str();
 
     ++Token;
     //          out float4 Color : SV_Target,
     //                     ^
     VERIFY_PARSER_STATE(Token, Token != m_Tokens.end(), "Unexpected EOF while parsing argument list");
     VERIFY_PARSER_STATE(Token, Token->Type == TokenType::Identifier, "Missing argument name after ", ParamInfo.Type);
-    ParamInfo.Name = Token->Literal;
+    ParamInfo.Name = Token->Literal.str();
 
     ++Token;
     VERIFY_PARSER_STATE(Token, Token != m_Tokens.end(), "Unexpected EOF");
@@ -2873,8 +2893,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::ParseShaderParameter(TokenListTyp
         ProcessScope(
             Token, m_Tokens.end(), TokenType::OpenStaple, TokenType::ClosingStaple,
             [&](TokenListType::iterator& tkn, int) {
-                ParamInfo.ArraySize.append(tkn->Delimiter);
-                ParamInfo.ArraySize.append(tkn->Literal);
+                ParamInfo.ArraySize.append(tkn->Delimiter.data(), tkn->Delimiter.size());
+                ParamInfo.ArraySize.append(tkn->Literal.data(), tkn->Literal.size());
                 ++tkn;
             } //
         );
@@ -2902,7 +2922,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ParseShaderParameter(TokenListTyp
             VERIFY_PARSER_STATE(Token, Token != m_Tokens.end(), "Unexpected end of file while looking for semantic for argument \"", ParamInfo.Name, '\"');
             VERIFY_PARSER_STATE(Token, Token->Type == TokenType::Identifier, "Missing semantic for argument \"", ParamInfo.Name, '\"');
             // Transform to lower case -  semantics are case-insensitive
-            ParamInfo.Semantic = StrToLower(Token->Literal);
+            ParamInfo.Semantic = StrToLower(Token->Literal.str());
 
             ++Token;
             //          out float4 Color : SV_Target,
@@ -2966,8 +2986,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessFunctionParameters(TokenLi
     if (!bIsVoid)
     {
         ShaderParameterInfo RetParam;
-        RetParam.Type             = TypeToken->Literal;
-        RetParam.Name             = FuncNameToken->Literal;
+        RetParam.Type             = TypeToken->Literal.str();
+        RetParam.Name             = FuncNameToken->Literal.str();
         RetParam.storageQualifier = ShaderParameterInfo::StorageQualifier::Ret;
         Params.push_back(RetParam);
     }
@@ -3142,7 +3162,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessFunctionParameters(TokenLi
                     //                                   ^
                     VERIFY_PARSER_STATE(TmpToken, TmpToken != m_Tokens.end() && TmpToken->Type == TokenType::NumericConstant, "Numeric constant expected");
 
-                    ParamInfo.ArraySize     = TmpToken->Literal;
+                    ParamInfo.ArraySize     = TmpToken->Literal.str();
                     auto NumCtrlPointsToken = TmpToken;
                     ++TmpToken;
                     VERIFY_PARSER_STATE(TmpToken, TmpToken != m_Tokens.end() && TmpToken->Literal == ">", "Angle bracket expected");
@@ -3192,7 +3212,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessFunctionParameters(TokenLi
             VERIFY_PARSER_STATE(SemanticToken, SemanticToken != m_Tokens.end(), "Unexpected EOF");
             VERIFY_PARSER_STATE(SemanticToken, SemanticToken->Type == TokenType::Identifier, "Expected semantic for the return argument ");
             // Transform to lower case -  semantics are case-insensitive
-            RetParam.Semantic = StrToLower(SemanticToken->Literal);
+            RetParam.Semantic = StrToLower(SemanticToken->Literal.str());
             ++SemanticToken;
             // float4 TestPS  ( in VSOutput In ) : SV_Target
             // {
@@ -3875,7 +3895,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessHullShaderConstantFunction
         }
     }
     ReturnHandlerSS << "return;}\n";
-    m_Tokens.insert(TypeToken, TokenInfo(TokenType::TextBlock, ReturnHandlerSS.str().c_str(), TypeToken->Delimiter.c_str()));
+    m_Tokens.insert(TypeToken, TokenInfo(TokenType::TextBlock, ReturnHandlerSS.str(), TypeToken->Delimiter));
     TypeToken->Delimiter = "\n";
 
     String Prologue = PrologueSS.str();
@@ -3925,8 +3945,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessShaderAttributes(TokenList
         VERIFY_PARSER_STATE(TmpToken, TmpToken != m_Tokens.end() && TmpToken->Type == TokenType::Identifier, "Identifier expected");
         // [domain("quad")]
         //  ^
-        auto& Attrib = TmpToken->Literal;
-        StrToLowerInPlace(Attrib);
+        auto Attrib = StrToLower(TmpToken->Literal.str());
 
         ++TmpToken;
         VERIFY_PARSER_STATE(TmpToken, TmpToken != m_Tokens.end() && TmpToken->Type == TokenType::OpenBracket, "\'(\' expected");
@@ -3935,8 +3954,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessShaderAttributes(TokenList
             TmpToken, m_Tokens.end(), TokenType::OpenBracket, TokenType::ClosingBracket,
             [&](TokenListType::iterator& tkn, int) //
             {
-                AttribValue.append(tkn->Delimiter);
-                AttribValue.append(tkn->Literal);
+                AttribValue.append(tkn->Delimiter.data(), tkn->Delimiter.size());
+                AttribValue.append(tkn->Literal.data(), tkn->Literal.size());
                 ++tkn;
             } //
         );
@@ -4245,7 +4264,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessDomainShaderArguments(Toke
     // ^
 
     std::unordered_map<HashMapStringKey, String, HashMapStringKey::Hasher> Attributes;
-    ParseAttributesInComment(TypeToken->Delimiter, Attributes);
+    ParseAttributesInComment(TypeToken->Delimiter.str(), Attributes);
     ProcessShaderAttributes(Token, Attributes);
 
     stringstream GlobalsSS;
@@ -4463,7 +4482,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessReturnStatements(TokenList
     if (IsVoid)
     {
         // Insert return handler before the closing brace
-        m_Tokens.insert(Token, TokenInfo(TokenType::TextBlock, MacroName, Token->Delimiter.c_str()));
+        m_Tokens.insert(Token, TokenInfo(TokenType::TextBlock, MacroName, Token->Delimiter));
         Token->Delimiter = "\n";
         // void main ()
         // {
@@ -4582,8 +4601,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::ProcessShaderDeclaration(TokenLis
     // TypeToken
 
     // Insert global variables & return handler before the function
-    m_Tokens.insert(TypeToken, TokenInfo(TokenType::TextBlock, GlobalVariables.c_str(), TypeToken->Delimiter.c_str()));
-    m_Tokens.insert(TypeToken, TokenInfo(TokenType::TextBlock, ReturnHandlerSS.str().c_str(), "\n"));
+    m_Tokens.insert(TypeToken, TokenInfo(TokenType::TextBlock, GlobalVariables.c_str(), TypeToken->Delimiter));
+    m_Tokens.insert(TypeToken, TokenInfo(TokenType::TextBlock, ReturnHandlerSS.str(), "\n"));
     TypeToken->Delimiter = "\n";
     auto BodyStartToken  = ArgsListEndToken;
     while (BodyStartToken != m_Tokens.end() && BodyStartToken->Type != TokenType::OpenBrace)
@@ -4785,7 +4804,7 @@ void HLSL2GLSLConverterImpl::ConversionStream::RemoveSpecialShaderAttributes()
                 // void CS(uint3 ThreadId  : SV_DispatchThreadID)
                 // ^
                 if (Token != m_Tokens.end())
-                    Token->Delimiter = OpenStaple->Delimiter + Token->Delimiter;
+                    Token->Delimiter = OpenStaple->Delimiter.str() + Token->Delimiter.str();
                 m_Tokens.erase(OpenStaple, Token);
             }
             else
@@ -4796,11 +4815,16 @@ void HLSL2GLSLConverterImpl::ConversionStream::RemoveSpecialShaderAttributes()
 
 String HLSL2GLSLConverterImpl::ConversionStream::BuildGLSLSource()
 {
+    size_t OutputSize = 0;
+    for (const auto& Token : m_Tokens)
+        OutputSize += Token.Delimiter.size() + Token.Literal.size();
+
     String Output;
+    Output.reserve(OutputSize);
     for (const auto& Token : m_Tokens)
     {
-        Output.append(Token.Delimiter);
-        Output.append(Token.Literal);
+        Output.append(Token.Delimiter.data(), Token.Delimiter.size());
+        Output.append(Token.Literal.data(), Token.Literal.size());
     }
     return Output;
 }
@@ -4814,6 +4838,7 @@ HLSL2GLSLConverterImpl::ConversionStream::ConversionStream(IReferenceCounters*
                                                            bool                             bPreserveTokens) :
     // clang-format off
     TBase            {pRefCounters   },
+    m_Tokens         {STD_ALLOCATOR(TokenInfo, TokenNodePool, m_TokenPool, "Allocator for HLSL tokens")},
     m_bPreserveTokens{bPreserveTokens},
     m_Converter      {Converter      },
     m_InputFileName  {InputFileName != nullptr ? InputFileName : "<Unknown>"}
@@ -4833,17 +4858,83 @@ HLSL2GLSLConverterImpl::ConversionStream::ConversionStream(IReferenceCounters*
         if (pSourceStream == nullptr)
             LOG_ERROR_AND_THROW("Failed to open shader source file ", InputFileName);
 
-        pFileData = MakeNewRCObj<DataBlobImpl>()(0);
-        pSourceStream->ReadBlob(pFileData);
+        pFileData  = ReadStreamBlob(pSourceStream);
         HLSLSource = reinterpret_cast<char*>(pFileData->GetDataPtr());
         NumSymbols = pFileData->GetSize();
     }
 
-    String Source(HLSLSource, NumSymbols);
+    m_Source.assign(HLSLSource, NumSymbols);
+
+    InsertIncludes(m_Source, pInputStreamFactory);
+
+    m_SourceHash = ComputeContentHash(m_Source.data(), m_Source.size());
 
-    InsertIncludes(Source, pInputStreamFactory);
+    // Tokenization is deferred until the first conversion that misses the result cache
+    if (!m_Converter.m_ResultCache.IsEnabled())
+    {
+        Tokenize();
+        m_bTokenized = true;
+    }
+}
+
+HLSL2GLSLConverterImpl::TokenNodePool::~TokenNodePool()
+{
+    auto& RawAllocator = GetRawAllocator();
+    for (auto& Page : m_Pages)
+        RawAllocator.Free(Page.pData);
+}
 
-    Tokenize(Source);
+void* HLSL2GLSLConverterImpl::TokenNodePool::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+{
+    // Every node must be able to hold the pointer to the next free node
+    const auto NodeSize = AlignUp(std::max(Size, sizeof(void*)), sizeof(void*));
+
+    auto size_class_it = std::find_if(m_SizeClasses.begin(), m_SizeClasses.end(),
+                                      [NodeSize](const SizeClass& Class) { return Class.NodeSize == NodeSize; });
+    if (size_class_it == m_SizeClasses.end())
+    {
+        m_SizeClasses.emplace_back();
+        size_class_it           = m_SizeClasses.end() - 1;
+        size_class_it->NodeSize = NodeSize;
+    }
+    auto& Class = *size_class_it;
+
+    if (Class.pFreeNodes != nullptr)
+    {
+        auto* pNode      = Class.pFreeNodes;
+        Class.pFreeNodes = *reinterpret_cast<void**>(pNode);
+        return pNode;
+    }
+
+    if (Class.NumUsedPageNodes == Class.NumNodesInPage)
+    {
+        // Most lists are short, so start with a small page and double the size of every next one
+        Class.NumNodesInPage   = Class.NumNodesInPage != 0 ? std::min(Class.NumNodesInPage * 2, m_MaxNodesInPage) : std::min(size_t{16}, m_MaxNodesInPage);
+        Class.NumUsedPageNodes = 0;
+
+        const auto PageSize = NodeSize * Class.NumNodesInPage;
+        Class.pCurrPage     = reinterpret_cast<Uint8*>(GetRawAllocator().Allocate(PageSize, dbgDescription, dbgFileName, dbgLineNumber));
+        m_Pages.push_back({Class.pCurrPage, PageSize, static_cast<size_t>(size_class_it - m_SizeClasses.begin())});
+    }
+
+    return Class.pCurrPage + NodeSize * Class.NumUsedPageNodes++;
+}
+
+void HLSL2GLSLConverterImpl::TokenNodePool::Free(void* Ptr)
+{
+    // Recently allocated pages are the most likely to contain the node
+    auto* pNode = reinterpret_cast<Uint8*>(Ptr);
+    for (auto page_it = m_Pages.rbegin(); page_it != m_Pages.rend(); ++page_it)
+    {
+        if (pNode >= page_it->pData && pNode < page_it->pData + page_it->Size)
+        {
+            auto& Class                    = m_SizeClasses[page_it->SizeClassIdx];
+            *reinterpret_cast<void**>(Ptr) = Class.pFreeNodes;
+            Class.pFreeNodes               = Ptr;
+            return;
+        }
+    }
+    UNEXPECTED("The node was not allocated by this pool");
 }
 
 
@@ -4929,8 +5020,28 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
                                                          const char* SamplerSuffix,
                                                          bool        UseInOutLocationQualifiers)
 {
+    auto&       Cache    = m_Converter.m_ResultCache;
+    const auto  UseCache = Cache.IsEnabled();
+    ContentHash ResultKey;
+    if (UseCache)
+    {
+        ResultKey = ComputeResultKey(EntryPoint, ShaderType, IncludeDefintions, SamplerSuffix, UseInOutLocationQualifiers);
+
+        String GLSLSource;
+        if (Cache.Find(ResultKey, GLSLSource))
+            return GLSLSource;
+    }
+
+    if (!m_bTokenized)
+    {
+        Tokenize();
+        m_bTokenized = true;
+    }
+
     m_bUseInOutLocationQualifiers = UseInOutLocationQualifiers;
-    TokenListType TokensCopy(m_bPreserveTokens ? m_Tokens : TokenListType());
+    TokenListType TokensCopy{m_Tokens.get_allocator()};
+    if (m_bPreserveTokens)
+        TokensCopy = m_Tokens;
 
     Uint32 ShaderStorageBlockBinding = 0;
     Uint32 ImageBinding              = 0;
@@ -5171,7 +5282,256 @@ String HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
     if (IncludeDefintions)
         GLSLSource.insert(0, g_GLSLDefinitions);
 
+    if (UseCache)
+        Cache.Add(ResultKey, GLSLSource);
+
     return GLSLSource;
 }
 
+ContentHash HLSL2GLSLConverterImpl::ConversionStream::ComputeResultKey(const Char* EntryPoint,
+                                                                       SHADER_TYPE ShaderType,
+                                                                       bool        IncludeDefintions,
+                                                                       const char* SamplerSuffix,
+                                                                       bool        UseInOutLocationQualifiers) const
+{
+    // Increment the version whenever the converter output changes for the same input,
+    // so that stale results stored on disk are not reused.
+    static constexpr Uint32 ResultVersion = 1;
+
+    // GLSL definitions are part of the output
+    static const ContentHash DefinitionsHash = ComputeContentHash(g_GLSLDefinitions, strlen(g_GLSLDefinitions));
+
+    const Uint32 Flags[] = {
+        ResultVersion,
+        static_cast<Uint32>(ShaderType),
+        IncludeDefintions ? 1u : 0u,
+        UseInOutLocationQualifiers ? 1u : 0u,
+    };
+
+    auto Hash = ComputeContentHash(Flags, sizeof(Flags), m_SourceHash);
+    Hash      = ComputeContentHash(&DefinitionsHash, sizeof(DefinitionsHash), Hash);
+    // Include the terminating null so that different strings can't produce the same byte sequence
+    if (EntryPoint != nullptr)
+        Hash = ComputeContentHash(EntryPoint, strlen(EntryPoint) + 1, Hash);
+    if (SamplerSuffix != nullptr)
+        Hash = ComputeContentHash(SamplerSuffix, strlen(SamplerSuffix) + 1, Hash);
+    return Hash;
+}
+
+void HLSL2GLSLConverterImpl::ResultCache::SetEnabled(bool Enabled)
+{
+    m_Enabled.store(Enabled);
+}
+
+void HLSL2GLSLConverterImpl::ResultCache::SetMaxMemorySize(size_t MaxMemorySize)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_MaxMemorySize = MaxMemorySize;
+    EvictLocked();
+}
+
+void HLSL2GLSLConverterImpl::ResultCache::SetDirectory(const Char* Directory)
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_Directory = Directory != nullptr ? Directory : "";
+    if (!m_Directory.empty() && m_Directory.back() != '/' && m_Directory.back() != '\\')
+        m_Directory.push_back(FileSystem::GetSlashSymbol());
+}
+
+void HLSL2GLSLConverterImpl::ResultCache::Clear()
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    m_Results.clear();
+    m_LRU.clear();
+    m_Stats.NumEntries = 0;
+    m_Stats.TotalSize  = 0;
+}
+
+HLSL2GLSLConverterImpl::ResultCache::Stats HLSL2GLSLConverterImpl::ResultCache::GetStats() const
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    return m_Stats;
+}
+
+String HLSL2GLSLConverterImpl::ResultCache::GetFilePath(const ContentHash& Key) const
+{
+    static constexpr char HexDigits[] = "0123456789abcdef";
+
+    String Path = m_Directory;
+    for (auto Word : {Key.Hi, Key.Lo})
+    {
+        for (int Shift = 60; Shift >= 0; Shift -= 4)
+            Path.push_back(HexDigits[(Word >> Shift) & 0xF]);
+    }
+    Path.append(".glsl");
+    return Path;
+}
+
+namespace
+{
+
+struct ResultFileHeader
+{
+    static constexpr Uint32 ExpectedMagic   = 0x43473248; // 'H2GC'
+    static constexpr Uint32 ExpectedVersion = 1;
+
+    Uint32      Magic   = ExpectedMagic;
+    Uint32      Version = ExpectedVersion;
+    ContentHash Key;
+    ContentHash DataHash;
+    Uint64      DataSize = 0;
+};
+
+} // namespace
+
+bool HLSL2GLSLConverterImpl::ResultCache::ReadFile(const String& FilePath, const ContentHash& Key, String& GLSLSource) const
+{
+    FileWrapper File{FilePath.c_str()};
+    if (!File)
+        return false;
+
+    const auto FileSize = File->GetSize();
+
+    ResultFileHeader Header;
+    if (FileSize < sizeof(Header) || !File->Read(&Header, sizeof(Header)))
+        return false;
+
+    if (Header.Magic != ResultFileHeader::ExpectedMagic ||
+        Header.Version != ResultFileHeader::ExpectedVersion ||
+        Header.Key != Key ||
+        Header.DataSize != FileSize - sizeof(Header))
+        return false;
+
+    GLSLSource.resize(static_cast<size_t>(Header.DataSize));
+    if (!GLSLSource.empty() && !File->Read(&GLSLSource[0], GLSLSource.size()))
+        return false;
+
+    return ComputeContentHash(GLSLSource.data(), GLSLSource.size()) == Header.DataHash;
+}
+
+void HLSL2GLSLConverterImpl::ResultCache::WriteFile(const String& FilePath, const ContentHash& Key, const String& GLSLSource) const
+{
+    ResultFileHeader Header;
+    Header.Key      = Key;
+    Header.DataHash = ComputeContentHash(GLSLSource.data(), GLSLSource.size());
+    Header.DataSize = GLSLSource.size();
+
+    // Write to a temporary file first so that other processes never read a partially written result
+    const auto TmpFilePath = FilePath + ".tmp";
+    {
+        FileWrapper File{TmpFilePath.c_str(), EFileAccessMode::Overwrite};
+        if (!File || !File->Write(&Header, sizeof(Header)) || !File->Write(GLSLSource.data(), GLSLSource.size()))
+        {
+            LOG_WARNING_MESSAGE("Failed to write HLSL2GLSL conversion result to file ", TmpFilePath);
+            return;
+        }
+    }
+    if (std::rename(TmpFilePath.c_str(), FilePath.c_str()) != 0)
+        std::remove(TmpFilePath.c_str());
+}
+
+void HLSL2GLSLConverterImpl::ResultCache::InsertLocked(const ContentHash& Key, const String& GLSLSource)
+{
+    auto it_ins = m_Results.emplace(Key, Entry{GLSLSource, {}});
+    if (!it_ins.second)
+        return;
+
+    m_LRU.push_front(Key);
+    it_ins.first->second.LRUPos = m_LRU.begin();
+    ++m_Stats.NumEntries;
+    m_Stats.TotalSize += GLSLSource.size();
+    EvictLocked();
+}
+
+void HLSL2GLSLConverterImpl::ResultCache::EvictLocked()
+{
+    if (m_MaxMemorySize == 0)
+        return;
+
+    // Always keep the most recently used result, even if it alone exceeds the limit
+    while (m_Stats.TotalSize > m_MaxMemorySize && m_LRU.size() > 1)
+    {
+        auto it = m_Results.find(m_LRU.back());
+        VERIFY_EXPR(it != m_Results.end());
+        m_Stats.TotalSize -= it->second.GLSLSource.size();
+        --m_Stats.NumEntries;
+        ++m_Stats.NumEvictions;
+        m_Results.erase(it);
+        m_LRU.pop_back();
+    }
+}
+
+bool HLSL2GLSLConverterImpl::ResultCache::Find(const ContentHash& Key, String& GLSLSource)
+{
+    String FilePath;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        auto it = m_Results.find(Key);
+        if (it != m_Results.end())
+        {
+            GLSLSource = it->second.GLSLSource;
+            m_LRU.splice(m_LRU.begin(), m_LRU, it->second.LRUPos);
+            ++m_Stats.NumHits;
+            return true;
+        }
+
+        if (m_Directory.empty())
+        {
+            ++m_Stats.NumMisses;
+            return false;
+        }
+        FilePath = GetFilePath(Key);
+    }
+
+    // Read the file without holding the lock
+    bool Found    = false;
+    bool Rejected = false;
+    if (FileSystem::FileExists(FilePath.c_str()))
+    {
+        Found = ReadFile(FilePath, Key, GLSLSource);
+        if (!Found)
+        {
+            LOG_WARNING_MESSAGE("HLSL2GLSL conversion result file ", FilePath, " is corrupted and will be ignored");
+            Rejected = true;
+        }
+    }
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+    if (Found)
+    {
+        ++m_Stats.NumDiskHits;
+        InsertLocked(Key, GLSLSource);
+    }
+    else
+    {
+        ++m_Stats.NumMisses;
+        if (Rejected)
+            ++m_Stats.NumRejectedFiles;
+    }
+    return Found;
+}
+
+void HLSL2GLSLConverterImpl::ResultCache::Add(const ContentHash& Key, const String& GLSLSource)
+{
+    String FilePath;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        if (m_Results.find(Key) != m_Results.end())
+        {
+            // Another thread has converted the same shader
+            return;
+        }
+        InsertLocked(Key, GLSLSource);
+
+        if (m_Directory.empty())
+            return;
+        FilePath = GetFilePath(Key);
+    }
+
+    // A corrupted file with the same name, if any, is overwritten
+    WriteFile(FilePath, Key, GLSLSource);
+}
+
 } // namespace Diligent
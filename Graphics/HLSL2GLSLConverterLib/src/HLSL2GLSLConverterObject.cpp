@@ -43,4 +43,22 @@ void HLSL2GLSLConverterObject::CreateStream(const Char*                      Inp
     Converter.CreateStream(InputFileName, pSourceStreamFactory, HLSLSource, NumSymbols, ppStream);
 }
 
+void HLSL2GLSLConverterObject::SetResultCacheAttribs(const HLSL2GLSLResultCacheAttribs& Attribs) const
+{
+    auto& Cache = HLSL2GLSLConverterImpl::GetInstance().GetResultCache();
+    Cache.SetMaxMemorySize(static_cast<size_t>(Attribs.MaxMemorySize));
+    Cache.SetDirectory(Attribs.Directory);
+    Cache.SetEnabled(Attribs.Enabled);
+}
+
+void HLSL2GLSLConverterObject::GetResultCacheStats(HLSL2GLSLResultCacheStats& Stats) const
+{
+    Stats = HLSL2GLSLConverterImpl::GetInstance().GetResultCache().GetStats();
+}
+
+void HLSL2GLSLConverterObject::ClearResultCache() const
+{
+    HLSL2GLSLConverterImpl::GetInstance().GetResultCache().Clear();
+}
+
 } // namespace Diligent
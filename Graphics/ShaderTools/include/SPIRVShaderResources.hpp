@@ -34,7 +34,7 @@
 //
 //   m_MemoryBuffer                                                                                                              m_TotalResources
 //    |                                                                                                                             |                                       |
-//    | Uniform Buffers | Storage Buffers | Storage Images | Sampled Images | Atomic Counters | Separate Samplers | Separate Images |   Stage Inputs   |   Resource Names   |
+//    | Uniform Buffers | Storage Buffers | Storage Images | Sampled Images | Atomic Counters | Separate Samplers | Separate Images |   Stage Inputs   |   Specialization Constants   |   Resource Names   |
 
 #include <memory>
 #include <vector>
@@ -105,6 +105,28 @@ struct SPIRVShaderResourceAttribs
                                Uint32                                _BufferStaticSize = 0,
                                Uint32                                _BufferStride     = 0) noexcept;
 
+    SPIRVShaderResourceAttribs(const char*        _Name,
+                               Uint16             _ArraySize,
+                               ResourceType       _Type,
+                               RESOURCE_DIMENSION _ResourceDim,
+                               bool               _IsMS,
+                               uint32_t           _BindingDecorationOffset,
+                               uint32_t           _DescriptorSetDecorationOffset,
+                               Uint32             _BufferStaticSize,
+                               Uint32             _BufferStride) noexcept :
+        // clang-format off
+        Name                          {_Name},
+        ArraySize                     {_ArraySize},
+        Type                          {_Type},
+        ResourceDim                   {static_cast<Uint8>(_ResourceDim)},
+        IsMS                          {_IsMS ? Uint8{1} : Uint8{0}},
+        BindingDecorationOffset       {_BindingDecorationOffset},
+        DescriptorSetDecorationOffset {_DescriptorSetDecorationOffset},
+        BufferStaticSize              {_BufferStaticSize},
+        BufferStride                  {_BufferStride}
+    // clang-format on
+    {}
+
     ShaderResourceDesc GetResourceDesc() const
     {
         return ShaderResourceDesc{Name, GetShaderResourceType(Type), ArraySize};
@@ -137,6 +159,27 @@ struct SPIRVShaderStageInputAttribs
 };
 static_assert(sizeof(SPIRVShaderStageInputAttribs) % sizeof(void*) == 0, "Size of SPIRVShaderStageInputAttribs struct must be multiple of sizeof(void*)");
 
+// sizeof(SPIRVSpecializationConstantAttribs) == 16, msvc x64
+struct SPIRVSpecializationConstantAttribs
+{
+    // clang-format off
+    SPIRVSpecializationConstantAttribs(const char* _Name, uint32_t _SpecId, Uint32 _Size) :
+        Name   {_Name  },
+        SpecId {_SpecId},
+        Size   {_Size  }
+    {}
+    // clang-format on
+
+    const char* const Name;
+
+    // The value of the SpecId decoration (constant_id in GLSL)
+    const uint32_t SpecId;
+
+    // The size of the constant value, in bytes
+    const Uint32 Size;
+};
+static_assert(sizeof(SPIRVSpecializationConstantAttribs) % sizeof(void*) == 0, "Size of SPIRVSpecializationConstantAttribs struct must be multiple of sizeof(void*)");
+
 /// Diligent::SPIRVShaderResources class
 class SPIRVShaderResources
 {
@@ -148,6 +191,30 @@ public:
                          bool                  LoadShaderStageInputs,
                          std::string&          EntryPoint);
 
+    /// Loads the resources from the data produced by Serialize() without reflecting the SPIRV binary.
+    /// The data must be validated with IsSerializedDataValid() first.
+    SPIRVShaderResources(IMemoryAllocator& Allocator,
+                         const void*       pSerializedData,
+                         size_t            SerializedDataSize,
+                         const ShaderDesc& shaderDesc,
+                         const char*       CombinedSamplerSuffix,
+                         std::string&      EntryPoint);
+
+    /// Serializes the resources, the entry point and the hash of the SPIRV binary.
+    /// The data can be used to re-create the resources for the same binary with the constructor above,
+    /// which does not require SPIRV-Cross and is much faster than the reflection.
+    void Serialize(const std::vector<uint32_t>& SPIRV,
+                   const std::string&           EntryPoint,
+                   std::vector<Uint8>&          Data) const;
+
+    /// Checks if the serialized data is well-formed and was produced for the given SPIRV binary,
+    /// shader type and stage input loading mode.
+    static bool IsSerializedDataValid(const void*                  pSerializedData,
+                                      size_t                       SerializedDataSize,
+                                      const std::vector<uint32_t>& SPIRV,
+                                      SHADER_TYPE                  ShaderType,
+                                      bool                         LoadShaderStageInputs);
+
     // clang-format off
     SPIRVShaderResources             (const SPIRVShaderResources&)  = delete;
     SPIRVShaderResources             (      SPIRVShaderResources&&) = delete;
@@ -170,6 +237,7 @@ public:
     Uint32 GetNumAccelStructs()const noexcept{ return (m_TotalResources        - m_AccelStructOffset);    }
     Uint32 GetTotalResources ()    const noexcept { return m_TotalResources; }
     Uint32 GetNumShaderStageInputs()const noexcept { return m_NumShaderStageInputs; }
+    Uint32 GetNumSpecializationConstants()const noexcept { return m_NumSpecConstants; }
 
     const SPIRVShaderResourceAttribs& GetUB         (Uint32 n)const noexcept{ return GetResAttribs(n, GetNumUBs(),          0                      ); }
     const SPIRVShaderResourceAttribs& GetSB         (Uint32 n)const noexcept{ return GetResAttribs(n, GetNumSBs(),          m_StorageBufferOffset  ); }
@@ -191,6 +259,17 @@ public:
         return reinterpret_cast<const SPIRVShaderStageInputAttribs*>(ResourceMemoryEnd)[n];
     }
 
+    const SPIRVSpecializationConstantAttribs& GetSpecializationConstant(Uint32 n) const noexcept
+    {
+        VERIFY(n < m_NumSpecConstants, "Specialization constant index (", n, ") is out of range. Total constant count: ", m_NumSpecConstants);
+        auto* ResourceMemoryEnd = reinterpret_cast<const SPIRVShaderResourceAttribs*>(m_MemoryBuffer.get()) + m_TotalResources;
+        auto* StageInputsEnd    = reinterpret_cast<const SPIRVShaderStageInputAttribs*>(ResourceMemoryEnd) + m_NumShaderStageInputs;
+        return reinterpret_cast<const SPIRVSpecializationConstantAttribs*>(StageInputsEnd)[n];
+    }
+
+    /// Returns the specialization constant with the given name, or null if the constant is not found.
+    const SPIRVSpecializationConstantAttribs* FindSpecializationConstant(const char* Name) const noexcept;
+
     struct ResourceCounters
     {
         Uint32 NumUBs          = 0;
@@ -314,6 +393,7 @@ private:
     void Initialize(IMemoryAllocator&       Allocator,
                     const ResourceCounters& Counters,
                     Uint32                  NumShaderStageInputs,
+                    Uint32                  NumSpecConstants,
                     size_t                  ResourceNamesPoolSize,
                     StringPool&             ResourceNamesPool);
 
@@ -351,8 +431,13 @@ private:
         return const_cast<SPIRVShaderStageInputAttribs&>(const_cast<const SPIRVShaderResources*>(this)->GetShaderStageInputAttribs(n));
     }
 
+    SPIRVSpecializationConstantAttribs& GetSpecializationConstant(Uint32 n) noexcept
+    {
+        return const_cast<SPIRVSpecializationConstantAttribs&>(const_cast<const SPIRVShaderResources*>(this)->GetSpecializationConstant(n));
+    }
+
     // Memory buffer that holds all resources as continuous chunk of memory:
-    // |  UBs  |  SBs  |  StrgImgs  |  SmplImgs  |  ACs  |  SepSamplers  |  SepImgs  | Stage Inputs | Resource Names |
+    // |  UBs  |  SBs  |  StrgImgs  |  SmplImgs  |  ACs  |  SepSamplers  |  SepImgs  | Stage Inputs | Spec Constants | Resource Names |
     std::unique_ptr<void, STDDeleterRawMem<void>> m_MemoryBuffer;
 
     const char* m_CombinedSamplerSuffix = nullptr;
@@ -369,6 +454,7 @@ private:
     OffsetType m_AccelStructOffset     = 0;
     OffsetType m_TotalResources        = 0;
     OffsetType m_NumShaderStageInputs  = 0;
+    OffsetType m_NumSpecConstants      = 0;
 
     SHADER_TYPE m_ShaderType = SHADER_TYPE_UNKNOWN;
 
@@ -376,6 +462,10 @@ private:
 
     // Indicates if the shader was compiled from HLSL source.
     bool m_IsHLSLSource = false;
+
+    // Indicates if shader stage inputs were requested when the resources were created.
+    // The inputs may still be empty, e.g. if the shader was not compiled from HLSL.
+    bool m_ShaderStageInputsRequested = false;
 };
 
 } // namespace Diligent
@@ -27,10 +27,15 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include "GraphicsTypes.h"
 #include "Shader.h"
 #include "RefCntAutoPtr.hpp"
 #include "DataBlob.h"
+#include "ObjectBase.hpp"
+#include "HashUtils.hpp"
 
 namespace Diligent
 {
@@ -79,4 +84,39 @@ const char* ReadShaderSourceFile(const char*                      SourceCode,
 void AppendShaderSourceCode(std::string& Source, const ShaderCreateInfo& ShaderCI) noexcept(false);
 
 
+/// Shader source stream factory that records the content hash of every file
+/// opened through it. The recorded files are used to validate cached compilation results.
+class ShaderSourceDependencyRecorder final : public ObjectBase<IShaderSourceInputStreamFactory>
+{
+public:
+    using TBase = ObjectBase<IShaderSourceInputStreamFactory>;
+
+    struct Dependency
+    {
+        std::string Name;
+        ContentHash Hash;
+    };
+
+    ShaderSourceDependencyRecorder(IReferenceCounters* pRefCounters, IShaderSourceInputStreamFactory* pFactory);
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_IShaderSourceInputStreamFactory, TBase)
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream(const Char* Name, IFileStream** ppStream) override final;
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream2(const Char*                             Name,
+                                                       CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS Flags,
+                                                       IFileStream**                           ppStream) override final;
+
+    const std::vector<Dependency>& GetDependencies() const { return m_Dependencies; }
+
+private:
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> m_pFactory;
+    std::vector<Dependency>                        m_Dependencies;
+};
+
+/// Reads the file through the factory and computes the content hash of its data.
+/// Returns false if the file can't be opened.
+bool ComputeShaderSourceFileHash(IShaderSourceInputStreamFactory* pFactory, const Char* Name, ContentHash& Hash);
+
+
 } // namespace Diligent
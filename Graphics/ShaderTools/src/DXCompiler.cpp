@@ -44,7 +44,7 @@
 #    error DXC is not supported on this platform
 #endif
 
-#include "DataBlobImpl.hpp"
+#include "MemoryFileStream.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "ShaderToolsCommon.hpp"
 
@@ -240,8 +240,7 @@ public:
             return E_FAIL;
         }
 
-        RefCntAutoPtr<IDataBlob> pFileData{MakeNewRCObj<DataBlobImpl>()(0)};
-        pSourceStream->ReadBlob(pFileData);
+        auto pFileData = ReadStreamBlob(pSourceStream);
 
         CComPtr<IDxcBlobEncoding> sourceBlob;
 
@@ -40,6 +40,7 @@
 #include "GLSLangUtils.hpp"
 #include "DebugUtilities.hpp"
 #include "DataBlobImpl.hpp"
+#include "MemoryFileStream.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "ShaderToolsCommon.hpp"
 #include "SPIRVTools.hpp"
@@ -297,8 +298,7 @@ public:
             return nullptr;
         }
 
-        RefCntAutoPtr<IDataBlob> pFileData(MakeNewRCObj<DataBlobImpl>()(0));
-        pSourceStream->ReadBlob(pFileData);
+        auto  pFileData = ReadStreamBlob(pSourceStream);
         auto* pNewInclude =
             new IncludeResult{
                 headerName,
@@ -26,6 +26,8 @@
  */
 
 #include <iomanip>
+#include <limits>
+#include <cstring>
 #include "SPIRVShaderResources.hpp"
 #include "spirv_parser.hpp"
 #include "spirv_cross.hpp"
@@ -33,6 +35,7 @@
 #include "GraphicsAccessories.hpp"
 #include "StringTools.hpp"
 #include "Align.hpp"
+#include "HashUtils.hpp"
 
 namespace Diligent
 {
@@ -266,7 +269,8 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
                                            const char*           CombinedSamplerSuffix,
                                            bool                  LoadShaderStageInputs,
                                            std::string&          EntryPoint) :
-    m_ShaderType{shaderDesc.ShaderType}
+    m_ShaderType{shaderDesc.ShaderType},
+    m_ShaderStageInputsRequested{LoadShaderStageInputs}
 {
     // https://github.com/KhronosGroup/SPIRV-Cross/wiki/Reflection-API-user-guide
     diligent_spirv_cross::Parser parser(move(spirv_binary));
@@ -373,6 +377,17 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
         }
     }
 
+    // Only named constants can be addressed by the pipeline
+    std::vector<std::pair<diligent_spirv_cross::SpecializationConstant, std::string>> SpecConstants;
+    for (const auto& SpecConst : Compiler.get_specialization_constants())
+    {
+        const auto& Name = Compiler.get_name(SpecConst.id);
+        if (Name.empty())
+            continue;
+        ResourceNamesPoolSize += Name.length() + 1;
+        SpecConstants.emplace_back(SpecConst, Name);
+    }
+
     ResourceCounters ResCounters;
     ResCounters.NumUBs          = static_cast<Uint32>(resources.uniform_buffers.size());
     ResCounters.NumSBs          = static_cast<Uint32>(resources.storage_buffers.size());
@@ -387,7 +402,7 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
 
     // Resource names pool is only needed to facilitate string allocation.
     StringPool ResourceNamesPool;
-    Initialize(Allocator, ResCounters, NumShaderStageInputs, ResourceNamesPoolSize, ResourceNamesPool);
+    Initialize(Allocator, ResCounters, NumShaderStageInputs, static_cast<Uint32>(SpecConstants.size()), ResourceNamesPoolSize, ResourceNamesPool);
 
     {
         Uint32 CurrUB = 0;
@@ -578,6 +593,20 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
         VERIFY_EXPR(CurrStageInput == GetNumShaderStageInputs());
     }
 
+    for (Uint32 n = 0; n < SpecConstants.size(); ++n)
+    {
+        const auto& SpecConst = SpecConstants[n].first;
+        const auto& Type      = Compiler.get_type(Compiler.get_constant(SpecConst.id).constant_type);
+        // Booleans are 32-bit values in VkSpecializationInfo
+        const Uint32 Size = Type.basetype == diligent_spirv_cross::SPIRType::Boolean ? Uint32{4} : Type.width / 8;
+        new (&GetSpecializationConstant(n)) SPIRVSpecializationConstantAttribs //
+            {
+                ResourceNamesPool.CopyString(SpecConstants[n].second),
+                SpecConst.constant_id,
+                Size //
+            };
+    }
+
     VERIFY(ResourceNamesPool.GetRemainingSize() == 0, "Names pool must be empty");
 
     if (shaderDesc.ShaderType == SHADER_TYPE_COMPUTE)
@@ -592,6 +621,7 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
 void SPIRVShaderResources::Initialize(IMemoryAllocator&       Allocator,
                                       const ResourceCounters& Counters,
                                       Uint32                  NumShaderStageInputs,
+                                      Uint32                  NumSpecConstants,
                                       size_t                  ResourceNamesPoolSize,
                                       StringPool&             ResourceNamesPool)
 {
@@ -621,12 +651,16 @@ void SPIRVShaderResources::Initialize(IMemoryAllocator&       Allocator,
     VERIFY(NumShaderStageInputs <= MaxOffset, "Max offset exceeded");
     m_NumShaderStageInputs = static_cast<OffsetType>(NumShaderStageInputs);
 
+    VERIFY(NumSpecConstants <= MaxOffset, "Max offset exceeded");
+    m_NumSpecConstants = static_cast<OffsetType>(NumSpecConstants);
+
     auto AlignedResourceNamesPoolSize = AlignUp(ResourceNamesPoolSize, sizeof(void*));
 
     static_assert(sizeof(SPIRVShaderResourceAttribs) % sizeof(void*) == 0, "Size of SPIRVShaderResourceAttribs struct must be multiple of sizeof(void*)");
     // clang-format off
     auto MemorySize = m_TotalResources              * sizeof(SPIRVShaderResourceAttribs) +
                       m_NumShaderStageInputs        * sizeof(SPIRVShaderStageInputAttribs) +
+                      m_NumSpecConstants            * sizeof(SPIRVSpecializationConstantAttribs) +
                       AlignedResourceNamesPoolSize  * sizeof(char);
 
     VERIFY_EXPR(GetNumUBs()          == Counters.NumUBs);
@@ -647,11 +681,381 @@ void SPIRVShaderResources::Initialize(IMemoryAllocator&       Allocator,
         m_MemoryBuffer  = std::unique_ptr<void, STDDeleterRawMem<void>>(pRawMem, Allocator);
         char* NamesPool = reinterpret_cast<char*>(m_MemoryBuffer.get()) +
             m_TotalResources * sizeof(SPIRVShaderResourceAttribs) +
-            m_NumShaderStageInputs * sizeof(SPIRVShaderStageInputAttribs);
+            m_NumShaderStageInputs * sizeof(SPIRVShaderStageInputAttribs) +
+            m_NumSpecConstants * sizeof(SPIRVSpecializationConstantAttribs);
         ResourceNamesPool.AssignMemory(NamesPool, ResourceNamesPoolSize);
     }
 }
 
+namespace
+{
+
+// Layout of the serialized resources:
+//
+//  | Header | Resources (in storage order) | Stage inputs | Specialization constants | String table |
+//
+// All offsets of strings are relative to the start of the string table.
+
+constexpr Uint32 SerializedDataMagic   = 0x52525053; // 'SPRR'
+constexpr Uint32 SerializedDataVersion = 2;
+
+struct SerializedHeader
+{
+    Uint32      Magic   = SerializedDataMagic;
+    Uint32      Version = SerializedDataVersion;
+    ContentHash SPIRVHash;
+
+    SPIRVShaderResources::ResourceCounters Counters;
+
+    Uint32 NumShaderStageInputs = 0;
+    Uint32 ShaderType           = 0;
+    Uint32 ComputeGroupSize[3]  = {};
+    Uint32 EntryPointOffset     = 0;
+    Uint32 StringTableSize      = 0;
+
+    Uint8  IsHLSLSource               = 0;
+    Uint8  ShaderStageInputsRequested = 0;
+    Uint8  Padding[2]                 = {};
+    Uint32 NumSpecConstants           = 0;
+};
+// There must be no implicit padding, so that the serialized bytes are deterministic
+static_assert(sizeof(SerializedHeader) == 96, "Unexpected size of SerializedHeader");
+
+struct SerializedResource
+{
+    Uint32 NameOffset;
+    Uint32 BindingDecorationOffset;
+    Uint32 DescriptorSetDecorationOffset;
+    Uint32 BufferStaticSize;
+    Uint32 BufferStride;
+    Uint16 ArraySize;
+    Uint8  Type;
+    Uint8  ResourceDim_IsMS; // Resource dimension in bits 0-6, multisample flag in bit 7
+};
+static_assert(sizeof(SerializedResource) == 24, "Unexpected size of SerializedResource");
+
+struct SerializedStageInput
+{
+    Uint32 SemanticOffset;
+    Uint32 LocationDecorationOffset;
+};
+
+struct SerializedSpecConstant
+{
+    Uint32 NameOffset;
+    Uint32 SpecId;
+    Uint32 Size;
+};
+static_assert(sizeof(SerializedSpecConstant) == 12, "Unexpected size of SerializedSpecConstant");
+
+Uint32 GetTotalResourceCount(const SPIRVShaderResources::ResourceCounters& Counters)
+{
+    static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please account for the new resource type counter here");
+    // clang-format off
+    return Counters.NumUBs       +
+           Counters.NumSBs       +
+           Counters.NumImgs      +
+           Counters.NumSmpldImgs +
+           Counters.NumACs       +
+           Counters.NumSepSmplrs +
+           Counters.NumSepImgs   +
+           Counters.NumInptAtts  +
+           Counters.NumAccelStructs;
+    // clang-format on
+}
+
+ContentHash ComputeSPIRVHash(const std::vector<uint32_t>& SPIRV)
+{
+    return ComputeContentHash(SPIRV.data(), SPIRV.size() * sizeof(SPIRV[0]));
+}
+
+} // namespace
+
+void SPIRVShaderResources::Serialize(const std::vector<uint32_t>& SPIRV,
+                                     const std::string&           EntryPoint,
+                                     std::vector<Uint8>&          Data) const
+{
+    std::vector<char> Strings;
+
+    auto AddString = [&Strings](const char* Str) {
+        const auto Offset = static_cast<Uint32>(Strings.size());
+        Strings.insert(Strings.end(), Str, Str + strlen(Str) + 1);
+        return Offset;
+    };
+
+    SerializedHeader Header;
+    Header.SPIRVHash = ComputeSPIRVHash(SPIRV);
+
+    // clang-format off
+    Header.Counters.NumUBs          = GetNumUBs();
+    Header.Counters.NumSBs          = GetNumSBs();
+    Header.Counters.NumImgs         = GetNumImgs();
+    Header.Counters.NumSmpldImgs    = GetNumSmpldImgs();
+    Header.Counters.NumACs          = GetNumACs();
+    Header.Counters.NumSepSmplrs    = GetNumSepSmplrs();
+    Header.Counters.NumSepImgs      = GetNumSepImgs();
+    Header.Counters.NumInptAtts     = GetNumInptAtts();
+    Header.Counters.NumAccelStructs = GetNumAccelStructs();
+    // clang-format on
+    static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please serialize the new resource type counter here");
+
+    Header.NumShaderStageInputs       = GetNumShaderStageInputs();
+    Header.NumSpecConstants           = GetNumSpecializationConstants();
+    Header.ShaderType                 = static_cast<Uint32>(m_ShaderType);
+    Header.IsHLSLSource               = m_IsHLSLSource ? 1 : 0;
+    Header.ShaderStageInputsRequested = m_ShaderStageInputsRequested ? 1 : 0;
+    for (size_t i = 0; i < m_ComputeGroupSize.size(); ++i)
+        Header.ComputeGroupSize[i] = m_ComputeGroupSize[i];
+    Header.EntryPointOffset = AddString(EntryPoint.c_str());
+
+    std::vector<SerializedResource> Resources(GetTotalResources());
+    for (Uint32 n = 0; n < GetTotalResources(); ++n)
+    {
+        const auto& Res = GetResource(n);
+        auto&       Dst = Resources[n];
+
+        Dst.NameOffset                    = AddString(Res.Name);
+        Dst.BindingDecorationOffset       = Res.BindingDecorationOffset;
+        Dst.DescriptorSetDecorationOffset = Res.DescriptorSetDecorationOffset;
+        Dst.BufferStaticSize              = Res.BufferStaticSize;
+        Dst.BufferStride                  = Res.BufferStride;
+        Dst.ArraySize                     = Res.ArraySize;
+        Dst.Type                          = static_cast<Uint8>(Res.Type);
+        Dst.ResourceDim_IsMS              = static_cast<Uint8>(Res.ResourceDim | (Res.IsMS << 7u));
+    }
+
+    std::vector<SerializedStageInput> StageInputs(GetNumShaderStageInputs());
+    for (Uint32 n = 0; n < GetNumShaderStageInputs(); ++n)
+    {
+        const auto& Input = GetShaderStageInputAttribs(n);
+
+        StageInputs[n].SemanticOffset           = AddString(Input.Semantic);
+        StageInputs[n].LocationDecorationOffset = Input.LocationDecorationOffset;
+    }
+
+    std::vector<SerializedSpecConstant> SpecConstants(GetNumSpecializationConstants());
+    for (Uint32 n = 0; n < GetNumSpecializationConstants(); ++n)
+    {
+        const auto& SpecConst = GetSpecializationConstant(n);
+
+        SpecConstants[n].NameOffset = AddString(SpecConst.Name);
+        SpecConstants[n].SpecId     = SpecConst.SpecId;
+        SpecConstants[n].Size       = SpecConst.Size;
+    }
+
+    Header.StringTableSize = static_cast<Uint32>(Strings.size());
+
+    const auto ResourcesSize     = Resources.size() * sizeof(SerializedResource);
+    const auto StageInputsSize   = StageInputs.size() * sizeof(SerializedStageInput);
+    const auto SpecConstantsSize = SpecConstants.size() * sizeof(SerializedSpecConstant);
+
+    Data.resize(sizeof(Header) + ResourcesSize + StageInputsSize + SpecConstantsSize + Strings.size());
+
+    auto* pDst = Data.data();
+    memcpy(pDst, &Header, sizeof(Header));
+    pDst += sizeof(Header);
+    if (ResourcesSize > 0)
+        memcpy(pDst, Resources.data(), ResourcesSize);
+    pDst += ResourcesSize;
+    if (StageInputsSize > 0)
+        memcpy(pDst, StageInputs.data(), StageInputsSize);
+    pDst += StageInputsSize;
+    if (SpecConstantsSize > 0)
+        memcpy(pDst, SpecConstants.data(), SpecConstantsSize);
+    pDst += SpecConstantsSize;
+    memcpy(pDst, Strings.data(), Strings.size());
+}
+
+bool SPIRVShaderResources::IsSerializedDataValid(const void*                  pSerializedData,
+                                                 size_t                       SerializedDataSize,
+                                                 const std::vector<uint32_t>& SPIRV,
+                                                 SHADER_TYPE                  ShaderType,
+                                                 bool                         LoadShaderStageInputs)
+{
+    if (pSerializedData == nullptr || SerializedDataSize < sizeof(SerializedHeader))
+        return false;
+
+    SerializedHeader Header;
+    memcpy(&Header, pSerializedData, sizeof(Header));
+    if (Header.Magic != SerializedDataMagic || Header.Version != SerializedDataVersion)
+        return false;
+
+    if (Header.ShaderType != static_cast<Uint32>(ShaderType) || (Header.ShaderStageInputsRequested != 0) != LoadShaderStageInputs)
+        return false;
+
+    // Resource offsets are stored as 16-bit values
+    const auto TotalResources = static_cast<size_t>(Header.Counters.NumUBs) + Header.Counters.NumSBs + Header.Counters.NumImgs +
+        Header.Counters.NumSmpldImgs + Header.Counters.NumACs + Header.Counters.NumSepSmplrs + Header.Counters.NumSepImgs +
+        Header.Counters.NumInptAtts + Header.Counters.NumAccelStructs;
+    if (TotalResources > std::numeric_limits<OffsetType>::max() ||
+        Header.NumShaderStageInputs > std::numeric_limits<OffsetType>::max() ||
+        Header.NumSpecConstants > std::numeric_limits<OffsetType>::max())
+        return false;
+
+    const auto ExpectedSize = sizeof(SerializedHeader) +
+        TotalResources * sizeof(SerializedResource) +
+        Header.NumShaderStageInputs * sizeof(SerializedStageInput) +
+        Header.NumSpecConstants * sizeof(SerializedSpecConstant) +
+        Header.StringTableSize;
+    if (SerializedDataSize != ExpectedSize)
+        return false;
+
+    // Hash the binary last as this is the most expensive check
+    const auto* pData          = static_cast<const Uint8*>(pSerializedData);
+    const auto* pResources     = pData + sizeof(SerializedHeader);
+    const auto* pStageInputs   = pResources + TotalResources * sizeof(SerializedResource);
+    const auto* pSpecConstants = pStageInputs + Header.NumShaderStageInputs * sizeof(SerializedStageInput);
+    const auto* pStrings       = reinterpret_cast<const char*>(pSpecConstants + Header.NumSpecConstants * sizeof(SerializedSpecConstant));
+
+    if (Header.StringTableSize == 0 || pStrings[Header.StringTableSize - 1] != '\0')
+        return false;
+
+    auto IsValidDecorationOffset = [&SPIRV](Uint32 Offset) {
+        return Offset < SPIRV.size();
+    };
+
+    if (Header.EntryPointOffset >= Header.StringTableSize)
+        return false;
+
+    for (size_t n = 0; n < TotalResources; ++n)
+    {
+        SerializedResource Res;
+        memcpy(&Res, pResources + n * sizeof(SerializedResource), sizeof(Res));
+        if (Res.NameOffset >= Header.StringTableSize ||
+            Res.Type >= SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes ||
+            !IsValidDecorationOffset(Res.BindingDecorationOffset) ||
+            !IsValidDecorationOffset(Res.DescriptorSetDecorationOffset))
+            return false;
+    }
+
+    for (size_t n = 0; n < Header.NumShaderStageInputs; ++n)
+    {
+        SerializedStageInput Input;
+        memcpy(&Input, pStageInputs + n * sizeof(SerializedStageInput), sizeof(Input));
+        if (Input.SemanticOffset >= Header.StringTableSize || !IsValidDecorationOffset(Input.LocationDecorationOffset))
+            return false;
+    }
+
+    for (size_t n = 0; n < Header.NumSpecConstants; ++n)
+    {
+        SerializedSpecConstant SpecConst;
+        memcpy(&SpecConst, pSpecConstants + n * sizeof(SerializedSpecConstant), sizeof(SpecConst));
+        if (SpecConst.NameOffset >= Header.StringTableSize || SpecConst.Size == 0)
+            return false;
+    }
+
+    return Header.SPIRVHash == ComputeSPIRVHash(SPIRV);
+}
+
+SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator& Allocator,
+                                           const void*       pSerializedData,
+                                           size_t            SerializedDataSize,
+                                           const ShaderDesc& shaderDesc,
+                                           const char*       CombinedSamplerSuffix,
+                                           std::string&      EntryPoint) :
+    m_ShaderType{shaderDesc.ShaderType}
+{
+    VERIFY_EXPR(pSerializedData != nullptr && SerializedDataSize >= sizeof(SerializedHeader));
+
+    SerializedHeader Header;
+    memcpy(&Header, pSerializedData, sizeof(Header));
+    VERIFY(Header.Magic == SerializedDataMagic && Header.ShaderType == static_cast<Uint32>(shaderDesc.ShaderType),
+           "Serialized data is not valid. Use IsSerializedDataValid() to validate the data.");
+
+    const auto  TotalResources = GetTotalResourceCount(Header.Counters);
+    const auto* pData          = static_cast<const Uint8*>(pSerializedData);
+    const auto* pResources     = pData + sizeof(SerializedHeader);
+    const auto* pStageInputs   = pResources + TotalResources * sizeof(SerializedResource);
+    const auto* pSpecConstants = pStageInputs + Header.NumShaderStageInputs * sizeof(SerializedStageInput);
+    const auto* pStrings       = reinterpret_cast<const char*>(pSpecConstants + Header.NumSpecConstants * sizeof(SerializedSpecConstant));
+    VERIFY_EXPR(pStrings + Header.StringTableSize == reinterpret_cast<const char*>(pData + SerializedDataSize));
+    (void)SerializedDataSize;
+
+    m_IsHLSLSource               = Header.IsHLSLSource != 0;
+    m_ShaderStageInputsRequested = Header.ShaderStageInputsRequested != 0;
+    for (size_t i = 0; i < m_ComputeGroupSize.size(); ++i)
+        m_ComputeGroupSize[i] = Header.ComputeGroupSize[i];
+    EntryPoint = pStrings + Header.EntryPointOffset;
+
+    auto ReadResource = [pResources](size_t n) {
+        SerializedResource Res;
+        memcpy(&Res, pResources + n * sizeof(SerializedResource), sizeof(Res));
+        return Res;
+    };
+    auto ReadStageInput = [pStageInputs](size_t n) {
+        SerializedStageInput Input;
+        memcpy(&Input, pStageInputs + n * sizeof(SerializedStageInput), sizeof(Input));
+        return Input;
+    };
+    auto ReadSpecConstant = [pSpecConstants](size_t n) {
+        SerializedSpecConstant SpecConst;
+        memcpy(&SpecConst, pSpecConstants + n * sizeof(SerializedSpecConstant), sizeof(SpecConst));
+        return SpecConst;
+    };
+
+    size_t ResourceNamesPoolSize = 0;
+    for (Uint32 n = 0; n < TotalResources; ++n)
+        ResourceNamesPoolSize += strlen(pStrings + ReadResource(n).NameOffset) + 1;
+    for (Uint32 n = 0; n < Header.NumShaderStageInputs; ++n)
+        ResourceNamesPoolSize += strlen(pStrings + ReadStageInput(n).SemanticOffset) + 1;
+    for (Uint32 n = 0; n < Header.NumSpecConstants; ++n)
+        ResourceNamesPoolSize += strlen(pStrings + ReadSpecConstant(n).NameOffset) + 1;
+    if (CombinedSamplerSuffix != nullptr)
+        ResourceNamesPoolSize += strlen(CombinedSamplerSuffix) + 1;
+    VERIFY_EXPR(shaderDesc.Name != nullptr);
+    ResourceNamesPoolSize += strlen(shaderDesc.Name) + 1;
+
+    StringPool ResourceNamesPool;
+    Initialize(Allocator, Header.Counters, Header.NumShaderStageInputs, Header.NumSpecConstants, ResourceNamesPoolSize, ResourceNamesPool);
+
+    for (Uint32 n = 0; n < TotalResources; ++n)
+    {
+        const auto Res = ReadResource(n);
+        new (&GetResource(n)) SPIRVShaderResourceAttribs //
+            {
+                ResourceNamesPool.CopyString(pStrings + Res.NameOffset),
+                Res.ArraySize,
+                static_cast<SPIRVShaderResourceAttribs::ResourceType>(Res.Type),
+                static_cast<RESOURCE_DIMENSION>(Res.ResourceDim_IsMS & 0x7Fu),
+                (Res.ResourceDim_IsMS & 0x80u) != 0,
+                Res.BindingDecorationOffset,
+                Res.DescriptorSetDecorationOffset,
+                Res.BufferStaticSize,
+                Res.BufferStride //
+            };
+    }
+
+    if (CombinedSamplerSuffix != nullptr)
+    {
+        m_CombinedSamplerSuffix = ResourceNamesPool.CopyString(CombinedSamplerSuffix);
+    }
+
+    m_ShaderName = ResourceNamesPool.CopyString(shaderDesc.Name);
+
+    for (Uint32 n = 0; n < Header.NumShaderStageInputs; ++n)
+    {
+        const auto Input = ReadStageInput(n);
+        new (&GetShaderStageInputAttribs(n)) SPIRVShaderStageInputAttribs //
+            {
+                ResourceNamesPool.CopyString(pStrings + Input.SemanticOffset),
+                Input.LocationDecorationOffset //
+            };
+    }
+
+    for (Uint32 n = 0; n < Header.NumSpecConstants; ++n)
+    {
+        const auto SpecConst = ReadSpecConstant(n);
+        new (&GetSpecializationConstant(n)) SPIRVSpecializationConstantAttribs //
+            {
+                ResourceNamesPool.CopyString(pStrings + SpecConst.NameOffset),
+                SpecConst.SpecId,
+                SpecConst.Size //
+            };
+    }
+
+    VERIFY(ResourceNamesPool.GetRemainingSize() == 0, "Names pool must be empty");
+}
+
 SPIRVShaderResources::~SPIRVShaderResources()
 {
     for (Uint32 n = 0; n < GetNumUBs(); ++n)
@@ -681,12 +1085,26 @@ SPIRVShaderResources::~SPIRVShaderResources()
     for (Uint32 n = 0; n < GetNumShaderStageInputs(); ++n)
         GetShaderStageInputAttribs(n).~SPIRVShaderStageInputAttribs();
 
+    for (Uint32 n = 0; n < GetNumSpecializationConstants(); ++n)
+        GetSpecializationConstant(n).~SPIRVSpecializationConstantAttribs();
+
     for (Uint32 n = 0; n < GetNumAccelStructs(); ++n)
         GetAccelStruct(n).~SPIRVShaderResourceAttribs();
 
     static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please add destructor for the new resource");
 }
 
+const SPIRVSpecializationConstantAttribs* SPIRVShaderResources::FindSpecializationConstant(const char* Name) const noexcept
+{
+    for (Uint32 n = 0; n < GetNumSpecializationConstants(); ++n)
+    {
+        const auto& SpecConst = GetSpecializationConstant(n);
+        if (strcmp(SpecConst.Name, Name) == 0)
+            return &SpecConst;
+    }
+    return nullptr;
+}
+
 
 
 std::string SPIRVShaderResources::DumpResources()
@@ -796,6 +1214,18 @@ std::string SPIRVShaderResources::DumpResources()
     );
     VERIFY_EXPR(ResNum == GetTotalResources());
 
+    if (GetNumSpecializationConstants() > 0)
+    {
+        ss << std::endl
+           << "Specialization constants:";
+        for (Uint32 n = 0; n < GetNumSpecializationConstants(); ++n)
+        {
+            const auto& SpecConst = GetSpecializationConstant(n);
+            ss << std::endl
+               << std::setw(3) << n << " '" << SpecConst.Name << "' id: " << SpecConst.SpecId << ", size: " << SpecConst.Size;
+        }
+    }
+
     return ss.str();
 }
 
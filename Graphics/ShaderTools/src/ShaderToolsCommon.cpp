@@ -27,7 +27,7 @@
 
 #include "ShaderToolsCommon.hpp"
 #include "DebugUtilities.hpp"
-#include "DataBlobImpl.hpp"
+#include "MemoryFileStream.hpp"
 
 namespace Diligent
 {
@@ -126,8 +126,7 @@ const char* ReadShaderSourceFile(const char*                      SourceCode,
                 if (pSourceStream == nullptr)
                     LOG_ERROR_AND_THROW("Failed to load shader source file '", FilePath, '\'');
 
-                pFileData = MakeNewRCObj<DataBlobImpl>{}(0);
-                pSourceStream->ReadBlob(pFileData);
+                pFileData     = ReadStreamBlob(pSourceStream);
                 SourceCode    = reinterpret_cast<char*>(pFileData->GetDataPtr());
                 SourceCodeLen = pFileData->GetSize();
             }
@@ -159,4 +158,53 @@ void AppendShaderSourceCode(std::string& Source, const ShaderCreateInfo& ShaderC
     Source.append(SourceCode, SourceCodeLen);
 }
 
+ShaderSourceDependencyRecorder::ShaderSourceDependencyRecorder(IReferenceCounters*              pRefCounters,
+                                                               IShaderSourceInputStreamFactory* pFactory) :
+    TBase{pRefCounters},
+    m_pFactory{pFactory}
+{
+    VERIFY_EXPR(pFactory != nullptr);
+}
+
+void ShaderSourceDependencyRecorder::CreateInputStream(const Char* Name, IFileStream** ppStream)
+{
+    CreateInputStream2(Name, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_NONE, ppStream);
+}
+
+void ShaderSourceDependencyRecorder::CreateInputStream2(const Char*                             Name,
+                                                        CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS Flags,
+                                                        IFileStream**                           ppStream)
+{
+    DEV_CHECK_ERR(ppStream != nullptr, "ppStream must not be null");
+    *ppStream = nullptr;
+
+    RefCntAutoPtr<IFileStream> pStream;
+    m_pFactory->CreateInputStream2(Name, Flags, &pStream);
+    if (!pStream)
+        return;
+
+    // Read the data once to both hash it and hand it over to the compiler
+    auto pData = ReadStreamBlob(pStream);
+    m_Dependencies.push_back({Name, ComputeContentHash(pData->GetConstDataPtr(), pData->GetSize())});
+
+    RefCntAutoPtr<IFileStream> pMemStream{MakeNewRCObj<MemoryFileStream>()(pData, true)};
+    *ppStream = pMemStream.Detach();
+}
+
+bool ComputeShaderSourceFileHash(IShaderSourceInputStreamFactory* pFactory, const Char* Name, ContentHash& Hash)
+{
+    if (pFactory == nullptr)
+        return false;
+
+    RefCntAutoPtr<IFileStream> pStream;
+    // A missing file is not an error: the caller will recompile the shader
+    pFactory->CreateInputStream2(Name, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT, &pStream);
+    if (!pStream)
+        return false;
+
+    auto pData = ReadStreamBlob(pStream);
+    Hash       = ComputeContentHash(pData->GetConstDataPtr(), pData->GetSize());
+    return true;
+}
+
 } // namespace Diligent
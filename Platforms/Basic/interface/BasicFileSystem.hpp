@@ -103,6 +103,14 @@ public:
 
     static bool IsPathAbsolute(const Diligent::Char* strPath);
 
+    /// Returns the last modification time of the file, in nanoseconds since the epoch.
+
+    /// The resolution depends on the platform and the file system.
+    /// Returns zero if the file does not exist or the time can't be queried
+    /// (e.g. for files in Android application assets).
+    /// On Windows, the method is implemented by the platform file systems.
+    static Diligent::Uint64 GetFileModificationTime(const Diligent::Char* strFilePath);
+
 
     /// Simplifies the path.
 
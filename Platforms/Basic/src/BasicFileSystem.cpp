@@ -29,6 +29,9 @@
 #include "DebugUtilities.hpp"
 #include <algorithm>
 
+#include <sys/types.h>
+#include <sys/stat.h>
+
 Diligent::String BasicFileSystem::m_strWorkingDirectory;
 
 BasicFile::BasicFile(const FileOpenAttribs& OpenAttribs, Diligent::Char SlashSymbol) :
@@ -142,6 +145,35 @@ bool BasicFileSystem::IsPathAbsolute(const Diligent::Char* strPath)
 #endif
 }
 
+Diligent::Uint64 BasicFileSystem::GetFileModificationTime(const Diligent::Char* strFilePath)
+{
+    if (strFilePath == nullptr || strFilePath[0] == 0)
+        return 0;
+
+#if PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS
+    // _stat64 only has one-second resolution. Windows file systems query
+    // the last write time instead, see WindowsFileSystem::GetFileModificationTime().
+    UNEXPECTED("Use WindowsFileSystem::GetFileModificationTime() or WindowsStoreFileSystem::GetFileModificationTime()");
+    return 0;
+#elif PLATFORM_LINUX || PLATFORM_ANDROID || PLATFORM_EMSCRIPTEN
+    auto Path = GetFullPath(strFilePath);
+    CorrectSlashes(Path, '/');
+    struct stat FileStat;
+    if (stat(Path.c_str(), &FileStat) != 0)
+        return 0;
+    return static_cast<Diligent::Uint64>(FileStat.st_mtim.tv_sec) * 1000000000ull + static_cast<Diligent::Uint64>(FileStat.st_mtim.tv_nsec);
+#elif PLATFORM_MACOS || PLATFORM_IOS || PLATFORM_TVOS
+    auto Path = GetFullPath(strFilePath);
+    CorrectSlashes(Path, '/');
+    struct stat FileStat;
+    if (stat(Path.c_str(), &FileStat) != 0)
+        return 0;
+    return static_cast<Diligent::Uint64>(FileStat.st_mtimespec.tv_sec) * 1000000000ull + static_cast<Diligent::Uint64>(FileStat.st_mtimespec.tv_nsec);
+#else
+#    error Unknown platform.
+#endif
+}
+
 std::string BasicFileSystem::SimplifyPath(const Diligent::Char* Path, Diligent::Char SlashSymbol)
 {
     if (Path == nullptr)
@@ -72,6 +72,9 @@ public:
     static bool FileExists(const Diligent::Char* strFilePath);
     static bool PathExists(const Diligent::Char* strPath);
 
+    /// Returns the last write time of the file, in nanoseconds since the epoch, see BasicFileSystem::GetFileModificationTime().
+    static Diligent::Uint64 GetFileModificationTime(const Diligent::Char* strFilePath);
+
     static bool CreateDirectory(const Diligent::Char* strPath);
     static void ClearDirectory(const Diligent::Char* strPath);
     static void DeleteFile(const Diligent::Char* strPath);
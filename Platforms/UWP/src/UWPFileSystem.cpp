@@ -248,6 +248,31 @@ bool WindowsStoreFileSystem::FileExists(const Diligent::Char* strFilePath)
 }
 
 
+Diligent::Uint64 WindowsStoreFileSystem::GetFileModificationTime(const Diligent::Char* strFilePath)
+{
+    if (strFilePath == nullptr || strFilePath[0] == 0)
+        return 0;
+
+    FileOpenAttribs OpenAttribs;
+    OpenAttribs.AccessMode  = EFileAccessMode::Read;
+    OpenAttribs.strFilePath = strFilePath;
+    BasicFile   DummyFile(OpenAttribs, WindowsStoreFileSystem::GetSlashSymbol());
+    const auto& Path = DummyFile.GetPath();
+
+    auto wstrPath = Diligent::WidenString(Path);
+
+    WIN32_FILE_ATTRIBUTE_DATA FileAttribs = {};
+    if (!GetFileAttributesExW(wstrPath.c_str(), GetFileExInfoStandard, &FileAttribs))
+        return 0;
+
+    // FILETIME is the number of 100-nanosecond intervals since January 1, 1601 (UTC)
+    constexpr Uint64 EpochDelta = 116444736000000000ull; // January 1, 1970 (UTC)
+
+    const auto Time = (static_cast<Uint64>(FileAttribs.ftLastWriteTime.dwHighDateTime) << 32u) | static_cast<Uint64>(FileAttribs.ftLastWriteTime.dwLowDateTime);
+    return Time > EpochDelta ? (Time - EpochDelta) * 100 : 0;
+}
+
+
 bool WindowsStoreFileSystem::PathExists(const Diligent::Char* strPath)
 {
     UNSUPPORTED("Not implemented");
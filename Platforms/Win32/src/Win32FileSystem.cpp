@@ -233,6 +233,24 @@ bool WindowsFileSystem::PathExists(const Char* strPath)
     return PathFileExistsA(strPath) != FALSE;
 }
 
+Uint64 WindowsFileSystem::GetFileModificationTime(const Char* strFilePath)
+{
+    if (strFilePath == nullptr || strFilePath[0] == 0)
+        return 0;
+
+    // Unlike _stat64, the last write time has 100-nanosecond resolution, so
+    // modifications made within the same second are detected.
+    WIN32_FILE_ATTRIBUTE_DATA FileAttribs = {};
+    if (!GetFileAttributesExA(strFilePath, GetFileExInfoStandard, &FileAttribs))
+        return 0;
+
+    // FILETIME is the number of 100-nanosecond intervals since January 1, 1601 (UTC)
+    constexpr Uint64 EpochDelta = 116444736000000000ull; // January 1, 1970 (UTC)
+
+    const auto Time = (static_cast<Uint64>(FileAttribs.ftLastWriteTime.dwHighDateTime) << 32u) | static_cast<Uint64>(FileAttribs.ftLastWriteTime.dwLowDateTime);
+    return Time > EpochDelta ? (Time - EpochDelta) * 100 : 0;
+}
+
 struct WndFindFileData : public FindFileData
 {
     virtual const Char* Name() const override { return ffd.cFileName; }
@@ -0,0 +1,234 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char g_ComputeShaderSource[] = R"(
+RWBuffer<float> g_Output;
+
+[numthreads(1, 1, 1)]
+void main()
+{
+    g_Output[0] = CONST_VALUE;
+}
+)";
+
+RefCntAutoPtr<IShader> CreateComputeShader(Uint32 Idx, SHADER_COMPILE_FLAGS CompileFlags = SHADER_COMPILE_FLAG_NONE, const char* Source = g_ComputeShaderSource)
+{
+    auto* pEnv = TestingEnvironment::GetInstance();
+
+    const auto ConstValue = std::to_string(Idx) + ".0";
+
+    ShaderMacro Macros[] = {{"CONST_VALUE", ConstValue.c_str()}, {}};
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Source                     = Source;
+    ShaderCI.Macros                     = Macros;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.UseCombinedTextureSamplers = true;
+    ShaderCI.Desc.ShaderType            = SHADER_TYPE_COMPUTE;
+    ShaderCI.EntryPoint                 = "main";
+    ShaderCI.Desc.Name                  = "Async pipeline creation test CS";
+    ShaderCI.CompileFlags               = CompileFlags;
+
+    RefCntAutoPtr<IShader> pCS;
+    pEnv->GetDevice()->CreateShader(ShaderCI, &pCS);
+    return pCS;
+}
+
+RefCntAutoPtr<IPipelineState> CreateComputePSO(IShader* pCS, PSO_CREATE_FLAGS Flags)
+{
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name                               = "Async pipeline creation test";
+    PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+    PSOCreateInfo.pCS                                        = pCS;
+    PSOCreateInfo.Flags                                      = Flags;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    TestingEnvironment::GetInstance()->GetDevice()->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    return pPSO;
+}
+
+TEST(AsyncPipelineCreationTest, ComputePipelines)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+    {
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    // Pipelines created without the flag are always ready
+    {
+        auto pCS = CreateComputeShader(0);
+        ASSERT_NE(pCS, nullptr);
+        auto pPSO = CreateComputePSO(pCS, PSO_CREATE_FLAG_NONE);
+        ASSERT_NE(pPSO, nullptr);
+        EXPECT_EQ(pPSO->GetStatus(), PIPELINE_STATE_STATUS_READY);
+    }
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name              = "Async pipeline creation test buffer";
+    BuffDesc.Size              = 16;
+    BuffDesc.BindFlags         = BIND_UNORDERED_ACCESS;
+    BuffDesc.Mode              = BUFFER_MODE_FORMATTED;
+    BuffDesc.ElementByteStride = sizeof(float);
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+    ASSERT_NE(pBuffer, nullptr);
+
+    BufferViewDesc UAVDesc;
+    UAVDesc.ViewType             = BUFFER_VIEW_UNORDERED_ACCESS;
+    UAVDesc.Format.ValueType     = VT_FLOAT32;
+    UAVDesc.Format.NumComponents = 1;
+
+    RefCntAutoPtr<IBufferView> pUAV;
+    pBuffer->CreateView(UAVDesc, &pUAV);
+    ASSERT_NE(pUAV, nullptr);
+
+    constexpr Uint32 NumPSOs = 32;
+
+    std::vector<RefCntAutoPtr<IPipelineState>> PSOs;
+    for (Uint32 i = 0; i < NumPSOs; ++i)
+    {
+        auto pCS = CreateComputeShader(i + 1);
+        ASSERT_NE(pCS, nullptr);
+        PSOs.emplace_back(CreateComputePSO(pCS, PSO_CREATE_FLAG_ASYNCHRONOUS));
+        ASSERT_NE(PSOs.back(), nullptr);
+    }
+
+    // SRBs may be created and dispatch commands may be recorded while pipelines are compiling.
+    // Commands that use pipelines that are not ready are skipped.
+    for (auto& pPSO : PSOs)
+    {
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+        pPSO->CreateShaderResourceBinding(&pSRB, true);
+        ASSERT_NE(pSRB, nullptr);
+        pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(pUAV);
+
+        pContext->SetPipelineState(pPSO);
+        pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+    }
+    pContext->Flush();
+
+    for (auto& pPSO : PSOs)
+        EXPECT_EQ(pPSO->GetStatus(true), PIPELINE_STATE_STATUS_READY);
+
+    pContext->WaitForIdle();
+}
+
+static const char g_BrokenComputeShaderSource[] = R"(
+RWBuffer<float> g_Output;
+
+[numthreads(1, 1, 1)]
+void main()
+{
+    g_Output[0] = float3(CONST_VALUE, 0.0, 0.0, 0.0);
+}
+)";
+
+TEST(AsyncPipelineCreationTest, ComputeShaders)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    if (!pDevice->GetDeviceInfo().Features.ComputeShaders)
+    {
+        GTEST_SKIP() << "Compute shaders are not supported by this device";
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    // Shaders created without the flag are always ready
+    {
+        auto pCS = CreateComputeShader(0);
+        ASSERT_NE(pCS, nullptr);
+        EXPECT_EQ(pCS->GetStatus(), SHADER_STATUS_READY);
+    }
+
+    constexpr Uint32 NumShaders = 32;
+
+    // The macros and the source are only valid while the shader is created,
+    // so the asynchronous compilation must not rely on them.
+    std::vector<RefCntAutoPtr<IShader>> Shaders;
+    for (Uint32 i = 0; i < NumShaders; ++i)
+    {
+        Shaders.emplace_back(CreateComputeShader(i + 1, SHADER_COMPILE_FLAG_ASYNCHRONOUS));
+        ASSERT_NE(Shaders.back(), nullptr);
+    }
+
+    // Pipeline creation waits for the shaders
+    std::vector<RefCntAutoPtr<IPipelineState>> PSOs;
+    for (Uint32 i = 0; i < NumShaders; i += 2)
+    {
+        PSOs.emplace_back(CreateComputePSO(Shaders[i], PSO_CREATE_FLAG_ASYNCHRONOUS));
+        ASSERT_NE(PSOs.back(), nullptr);
+    }
+
+    for (Uint32 i = 1; i < NumShaders; i += 2)
+    {
+        EXPECT_EQ(Shaders[i]->GetStatus(true), SHADER_STATUS_READY);
+        EXPECT_NE(Shaders[i]->GetResourceCount(), 0u);
+    }
+
+    for (auto& pPSO : PSOs)
+        EXPECT_EQ(pPSO->GetStatus(true), PIPELINE_STATE_STATUS_READY);
+
+    if (pDevice->GetDeviceInfo().IsVulkanDevice())
+    {
+        // Compilation errors are reported through the shader status
+        pEnv->SetErrorAllowance(3, "\n\nNo worries, testing broken shader...\n\n");
+        auto pBrokenCS = CreateComputeShader(0, SHADER_COMPILE_FLAG_ASYNCHRONOUS, g_BrokenComputeShaderSource);
+        ASSERT_NE(pBrokenCS, nullptr);
+        EXPECT_EQ(pBrokenCS->GetStatus(true), SHADER_STATUS_FAILED);
+        EXPECT_EQ(pBrokenCS->GetResourceCount(), 0u);
+
+        pEnv->SetErrorAllowance(2, "Errors below are expected: testing pipeline creation with broken shader\n");
+        EXPECT_EQ(CreateComputePSO(pBrokenCS, PSO_CREATE_FLAG_NONE), nullptr);
+        pEnv->SetErrorAllowance(0);
+    }
+}
+
+} // namespace
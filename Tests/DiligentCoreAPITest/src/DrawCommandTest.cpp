@@ -28,6 +28,7 @@
 #include <thread>
 #include <array>
 #include <atomic>
+#include <vector>
 
 #include "TestingEnvironment.hpp"
 #include "TestingSwapChainBase.hpp"
@@ -2069,6 +2070,119 @@ TEST_F(DrawCommandTest, MultiDrawIndexedIndirectCount)
     Present();
 }
 
+TEST_F(DrawCommandTest, MultiDraw)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets(sm_pDrawPSO);
+
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        {}, {},
+        Vert[0], Vert[1], Vert[2],
+        {},
+        Vert[3], Vert[4], Vert[5]
+    };
+    const MultiDrawItem DrawItems[] =
+    {
+        {3, 2},
+        {0, 0}, // Empty items must be skipped
+        {3, 6}
+    };
+    // clang-format on
+
+    auto     pVB    = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    IBuffer* pVBs[] = {pVB};
+    pContext->SetVertexBuffers(0, 1, pVBs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+    MultiDrawAttribs drawAttrs{_countof(DrawItems), DrawItems, DRAW_FLAG_VERIFY_ALL};
+    pContext->MultiDraw(drawAttrs);
+
+    Present();
+}
+
+TEST_F(DrawCommandTest, MultiDrawIndexed)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets(sm_pDrawPSO);
+
+    Uint32 bv = 2; // Base vertex of the second item
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        {}, {},
+        Vert[0], {}, Vert[1], {}, {}, Vert[2],
+        Vert[3], {}, {}, Vert[5], Vert[4]
+    };
+    const Uint32 Indices[] = {0,0,0,0, 2,4,7, 0, 8-bv,12-bv,11-bv};
+    const MultiDrawIndexedItem DrawItems[] =
+    {
+        {3, 4},
+        {3, 8, bv}
+    };
+    // clang-format on
+
+    auto pVB = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    auto pIB = CreateIndexBuffer(Indices, _countof(Indices));
+
+    IBuffer*     pVBs[]    = {pVB};
+    const Uint64 Offsets[] = {0};
+    pContext->SetVertexBuffers(0, 1, pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+    pContext->SetIndexBuffer(pIB, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    MultiDrawIndexedAttribs drawAttrs{_countof(DrawItems), DrawItems, VT_UINT32, DRAW_FLAG_VERIFY_ALL};
+    pContext->MultiDrawIndexed(drawAttrs);
+
+    Present();
+}
+
+TEST_F(DrawCommandTest, MultiDrawIndexedInstanced_IBOffset)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    SetRenderTargets(sm_pDrawInstancedPSO);
+
+    // clang-format off
+    const Vertex Triangles[] =
+    {
+        {}, {},
+        VertInst[1], {}, VertInst[0], {}, {}, VertInst[2]
+    };
+    const Uint32 Indices[] = {0,0,0,0, 4, 2, 7}; // Skip 4 indices using index buffer offset
+    const float4 InstancedData[] =
+    {
+        float4{0.5f,  0.5f,  -0.5f, -0.5f},
+        float4{0.5f,  0.5f,  +0.5f, -0.5f}
+    };
+    // Both items draw the same triangle, which must produce the same image
+    const MultiDrawIndexedItem DrawItems[] =
+    {
+        {3, 0},
+        {3, 0}
+    };
+    // clang-format on
+
+    auto pVB     = CreateVertexBuffer(Triangles, sizeof(Triangles));
+    auto pInstVB = CreateVertexBuffer(InstancedData, sizeof(InstancedData));
+    auto pIB     = CreateIndexBuffer(Indices, _countof(Indices));
+
+    IBuffer*     pVBs[]    = {pVB, pInstVB};
+    const Uint64 Offsets[] = {0, 0};
+    pContext->SetVertexBuffers(0, _countof(pVBs), pVBs, Offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
+    pContext->SetIndexBuffer(pIB, sizeof(Uint32) * 4, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    MultiDrawIndexedAttribs drawAttrs{_countof(DrawItems), DrawItems, VT_UINT32, DRAW_FLAG_VERIFY_ALL};
+    drawAttrs.NumInstances = 2;
+    pContext->MultiDrawIndexed(drawAttrs);
+
+    Present();
+}
+
 TEST_F(DrawCommandTest, Draw_InstanceDataStepRate)
 {
     auto* pEnv    = TestingEnvironment::GetInstance();
@@ -0,0 +1,214 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <array>
+#include <vector>
+
+#include "FrameGraph.hpp"
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+void CopyTexture(IDeviceContext* pContext, ITexture* pSrcTex, ITexture* pDstTex)
+{
+    CopyTextureAttribs CopyAttribs{pSrcTex, RESOURCE_STATE_TRANSITION_MODE_VERIFY, pDstTex, RESOURCE_STATE_TRANSITION_MODE_VERIFY};
+    pContext->CopyTexture(CopyAttribs);
+}
+
+class FrameGraphTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+        TextureDesc TexDesc;
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.Width     = 128;
+        TexDesc.Height    = 128;
+        TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+        TexDesc.Usage     = USAGE_DEFAULT;
+
+        std::vector<Uint32> Data(TexDesc.Width * TexDesc.Height, 0xFF00FF00u);
+        TextureSubResData   SubResData{Data.data(), TexDesc.Width * 4};
+        TextureData         InitData{&SubResData, 1};
+
+        TexDesc.Name = "Frame graph test source";
+        pDevice->CreateTexture(TexDesc, &InitData, &sm_pSrcTex);
+        ASSERT_NE(sm_pSrcTex, nullptr);
+
+        TexDesc.Name = "Frame graph test destination";
+        pDevice->CreateTexture(TexDesc, nullptr, &sm_pDstTex);
+        ASSERT_NE(sm_pDstTex, nullptr);
+
+        sm_TransientDesc      = TexDesc;
+        sm_TransientDesc.Name = nullptr;
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_pSrcTex.Release();
+        sm_pDstTex.Release();
+        TestingEnvironment::GetInstance()->Reset();
+    }
+
+    // Src -> A -> B -> C -> Dst
+    //        A -> D (unused)
+    static void BuildGraph(FrameGraph& Graph, std::array<bool, 5>& Executed)
+    {
+        Executed.fill(false);
+        Graph.Reset();
+
+        auto Src = Graph.ImportTexture(sm_pSrcTex);
+        auto Dst = Graph.ImportTexture(sm_pDstTex, RESOURCE_STATE_SHADER_RESOURCE);
+
+        auto Desc = sm_TransientDesc;
+
+        Desc.Name = "Transient A";
+        auto A    = Graph.CreateTexture(Desc);
+        Desc.Name = "Transient B";
+        auto B    = Graph.CreateTexture(Desc);
+        Desc.Name = "Transient C";
+        auto C    = Graph.CreateTexture(Desc);
+        Desc.Name = "Transient D";
+        auto D    = Graph.CreateTexture(Desc);
+
+        const auto AddCopyPass = [&](const char* Name, Uint32 Idx, FrameGraphResource SrcRes, FrameGraphResource DstRes) {
+            return Graph.AddPass(Name,
+                                 [&Executed, Idx, SrcRes, DstRes](const FrameGraph& Graph, IDeviceContext* pContext) {
+                                     Executed[Idx] = true;
+                                     CopyTexture(pContext, Graph.GetTexture(SrcRes), Graph.GetTexture(DstRes));
+                                 })
+                .Read(SrcRes, RESOURCE_STATE_COPY_SOURCE)
+                .Write(DstRes, RESOURCE_STATE_COPY_DEST)
+                .GetPassIndex();
+        };
+
+        EXPECT_EQ(AddCopyPass("Src -> A", 0, Src, A), 0u);
+        EXPECT_EQ(AddCopyPass("A -> D", 1, A, D), 1u);
+        EXPECT_EQ(AddCopyPass("A -> B", 2, A, B), 2u);
+        EXPECT_EQ(AddCopyPass("B -> C", 3, B, C), 3u);
+        EXPECT_EQ(AddCopyPass("C -> Dst", 4, C, Dst), 4u);
+
+        Graph.Compile();
+
+        EXPECT_EQ(Graph.GetTexture(D), nullptr);
+        EXPECT_NE(Graph.GetTexture(A), nullptr);
+        // A and C have non-overlapping lifetimes
+        EXPECT_EQ(Graph.GetTexture(A), Graph.GetTexture(C));
+        EXPECT_NE(Graph.GetTexture(A), Graph.GetTexture(B));
+    }
+
+    static void CheckGraph(const FrameGraph& Graph, const std::array<bool, 5>& Executed)
+    {
+        for (Uint32 i = 0; i < Executed.size(); ++i)
+        {
+            EXPECT_EQ(Graph.IsPassCulled(i), i == 1);
+            EXPECT_EQ(Executed[i], i != 1);
+        }
+
+        const auto& Stats = Graph.GetStatistics();
+        EXPECT_EQ(Stats.NumPasses, 5u);
+        EXPECT_EQ(Stats.NumCulledPasses, 1u);
+        EXPECT_EQ(Stats.NumTransientResources, 3u);
+        EXPECT_EQ(Stats.NumPhysicalResources, 2u);
+        EXPECT_GT(Stats.NumBarriers, 0u);
+
+        EXPECT_EQ(sm_pDstTex->GetState(), RESOURCE_STATE_SHADER_RESOURCE);
+    }
+
+    static RefCntAutoPtr<ITexture> sm_pSrcTex;
+    static RefCntAutoPtr<ITexture> sm_pDstTex;
+    static TextureDesc             sm_TransientDesc;
+};
+
+RefCntAutoPtr<ITexture> FrameGraphTest::sm_pSrcTex;
+RefCntAutoPtr<ITexture> FrameGraphTest::sm_pDstTex;
+TextureDesc             FrameGraphTest::sm_TransientDesc;
+
+
+TEST_F(FrameGraphTest, CullAndAlias)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    FrameGraph          Graph{pDevice};
+    std::array<bool, 5> Executed{};
+
+    BuildGraph(Graph, Executed);
+    EXPECT_EQ(Graph.GetStatistics().NumCreatedResources, 2u);
+    Graph.Execute(pContext);
+    CheckGraph(Graph, Executed);
+
+    // Transient objects must be reused in the next frame
+    BuildGraph(Graph, Executed);
+    EXPECT_EQ(Graph.GetStatistics().NumCreatedResources, 0u);
+    Graph.Execute(pContext);
+    CheckGraph(Graph, Executed);
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+}
+
+TEST_F(FrameGraphTest, DeferredContexts)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    if (pEnv->GetNumDeferredContexts() < 2)
+        GTEST_SKIP() << "Deferred contexts are not supported by this device";
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    FrameGraph          Graph{pDevice};
+    std::array<bool, 5> Executed{};
+
+    IDeviceContext* pDeferredCtxs[] = {pEnv->GetDeferredContext(0), pEnv->GetDeferredContext(1)};
+
+    BuildGraph(Graph, Executed);
+    Graph.Execute(pContext, pDeferredCtxs, _countof(pDeferredCtxs));
+    CheckGraph(Graph, Executed);
+
+    for (auto* pCtx : pDeferredCtxs)
+        pCtx->FinishFrame();
+
+    pContext->Flush();
+    pContext->WaitForIdle();
+}
+
+} // namespace
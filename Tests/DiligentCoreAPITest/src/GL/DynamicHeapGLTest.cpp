@@ -0,0 +1,135 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <unordered_set>
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+void FillBufferData(Uint32* pData, size_t NumValues, Uint32 Seed)
+{
+    for (size_t i = 0; i < NumValues; ++i)
+        pData[i] = Seed * 0x9E3779B9u + static_cast<Uint32>(i);
+}
+
+void VerifyBufferData(IBuffer* pBuffer, IBuffer* pStagingBuffer, Uint32 Seed)
+{
+    auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+
+    const auto Size = pBuffer->GetDesc().Size;
+    pContext->CopyBuffer(pBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                         pStagingBuffer, 0, Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    std::vector<Uint32> RefData(static_cast<size_t>(Size / sizeof(Uint32)));
+    FillBufferData(RefData.data(), RefData.size(), Seed);
+
+    void* pStagingData = nullptr;
+    pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pStagingData);
+    ASSERT_NE(pStagingData, nullptr);
+    EXPECT_EQ(memcmp(pStagingData, RefData.data(), static_cast<size_t>(Size)), 0) << "Buffer data does not match reference values. Seed: " << Seed;
+    pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+}
+
+// Maps dynamic uniform buffers over many frames so that the dynamic heap ring
+// wraps around several times, and verifies the buffer contents every time.
+TEST(DynamicHeapGLTest, MapAndRecycle)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    const auto& DeviceInfo = pDevice->GetDeviceInfo();
+    if (!DeviceInfo.IsGLDevice())
+        GTEST_SKIP() << "Dynamic heap is only used by the OpenGL backend";
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    // The testing environment creates an 8 MB heap, so every 8 frames the ring must be recycled
+    constexpr Uint32 BufferSize = 1 << 20;
+    constexpr Uint32 NumFrames  = 32;
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = "Dynamic heap test buffer";
+    BuffDesc.Usage          = USAGE_DYNAMIC;
+    BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    BuffDesc.Size           = BufferSize;
+
+    RefCntAutoPtr<IBuffer> pBuffers[2];
+    for (auto& pBuffer : pBuffers)
+    {
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+        ASSERT_NE(pBuffer, nullptr);
+    }
+
+    BuffDesc.Name           = "Dynamic heap test staging buffer";
+    BuffDesc.Usage          = USAGE_STAGING;
+    BuffDesc.BindFlags      = BIND_NONE;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuffer);
+    ASSERT_NE(pStagingBuffer, nullptr);
+
+    std::unordered_set<void*> MappedAddresses;
+    bool                      AddressReused = false;
+    for (Uint32 frame = 0; frame < NumFrames; ++frame)
+    {
+        for (Uint32 buff = 0; buff < _countof(pBuffers); ++buff)
+        {
+            void* pData = nullptr;
+            pContext->MapBuffer(pBuffers[buff], MAP_WRITE, MAP_FLAG_DISCARD, pData);
+            ASSERT_NE(pData, nullptr);
+            FillBufferData(static_cast<Uint32*>(pData), BufferSize / sizeof(Uint32), frame * 2 + buff);
+            pContext->UnmapBuffer(pBuffers[buff], MAP_WRITE);
+
+            AddressReused = !MappedAddresses.insert(pData).second || AddressReused;
+        }
+
+        // Mapping the second buffer must not overwrite the contents of the first one
+        for (Uint32 buff = 0; buff < _countof(pBuffers); ++buff)
+            VerifyBufferData(pBuffers[buff], pStagingBuffer, frame * 2 + buff);
+
+        pContext->FinishFrame();
+    }
+
+    // The heap requires persistently mapped buffers that are core in desktop GL 4.4.
+    // When it is used, memory of completed frames must be reused.
+    if (DeviceInfo.Type == RENDER_DEVICE_TYPE_GL && DeviceInfo.APIVersion >= Version{4, 4})
+        EXPECT_TRUE(AddressReused) << "Dynamic heap memory has not been recycled";
+}
+
+} // namespace
@@ -0,0 +1,243 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+#include "HLSL2GLSLConverter.h"
+#include "EngineFactoryOpenGL.h"
+#include "FileWrapper.hpp"
+#include "FileSystem.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+class HLSL2GLSLConverterCacheTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+        if (!pDevice->GetDeviceInfo().IsGLDevice())
+            GTEST_SKIP() << "HLSL2GLSL converter is only exposed by the OpenGL engine factory";
+
+        RefCntAutoPtr<IEngineFactoryOpenGL> pFactoryGL{pDevice->GetEngineFactory(), IID_EngineFactoryOpenGL};
+        ASSERT_NE(pFactoryGL, nullptr);
+        pFactoryGL->CreateHLSL2GLSLConverter(&m_pConverter);
+        ASSERT_NE(m_pConverter, nullptr);
+
+        pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory("shaders/HLSL2GLSLConverter", &m_pSourceFactory);
+        ASSERT_NE(m_pSourceFactory, nullptr);
+
+        m_pConverter->ClearResultCache();
+    }
+
+    void TearDown() override
+    {
+        if (m_pConverter)
+        {
+            // Restore the default attributes
+            m_pConverter->SetResultCacheAttribs(HLSL2GLSLResultCacheAttribs{});
+            m_pConverter->ClearResultCache();
+        }
+    }
+
+    std::string Convert(const char* EntryPoint, SHADER_TYPE ShaderType)
+    {
+        RefCntAutoPtr<IHLSL2GLSLConversionStream> pStream;
+        m_pConverter->CreateStream("VS_PS.hlsl", m_pSourceFactory, nullptr, 0, &pStream);
+        if (!pStream)
+            return {};
+
+        RefCntAutoPtr<IDataBlob> pGLSLSource;
+        pStream->Convert(EntryPoint, ShaderType, true, "_sampler", false, &pGLSLSource);
+        if (!pGLSLSource)
+            return {};
+
+        return std::string{static_cast<const char*>(pGLSLSource->GetDataPtr()), pGLSLSource->GetSize()};
+    }
+
+    HLSL2GLSLResultCacheStats GetStats() const
+    {
+        HLSL2GLSLResultCacheStats Stats;
+        m_pConverter->GetResultCacheStats(Stats);
+        return Stats;
+    }
+
+    RefCntAutoPtr<IHLSL2GLSLConverter>             m_pConverter;
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> m_pSourceFactory;
+};
+
+TEST_F(HLSL2GLSLConverterCacheTest, Disabled)
+{
+    const auto StatsBefore = GetStats();
+
+    const auto VS1 = Convert("TestVS", SHADER_TYPE_VERTEX);
+    ASSERT_FALSE(VS1.empty());
+    const auto VS2 = Convert("TestVS", SHADER_TYPE_VERTEX);
+    EXPECT_EQ(VS1, VS2);
+
+    // The cache is disabled by default
+    const auto Stats = GetStats();
+    EXPECT_EQ(Stats.NumEntries, 0u);
+    EXPECT_EQ(Stats.NumHits, StatsBefore.NumHits);
+    EXPECT_EQ(Stats.NumMisses, StatsBefore.NumMisses);
+}
+
+TEST_F(HLSL2GLSLConverterCacheTest, Memory)
+{
+    // Reference result produced by the converter itself
+    const auto RefVS = Convert("TestVS", SHADER_TYPE_VERTEX);
+    ASSERT_FALSE(RefVS.empty());
+
+    HLSL2GLSLResultCacheAttribs Attribs;
+    Attribs.Enabled = True;
+    m_pConverter->SetResultCacheAttribs(Attribs);
+
+    const auto StatsBefore = GetStats();
+
+    EXPECT_EQ(Convert("TestVS", SHADER_TYPE_VERTEX), RefVS);
+    // The second conversion of the same shader is served from the cache and must produce the same source
+    EXPECT_EQ(Convert("TestVS", SHADER_TYPE_VERTEX), RefVS);
+
+    auto Stats = GetStats();
+    EXPECT_EQ(Stats.NumEntries, 1u);
+    EXPECT_EQ(Stats.NumMisses - StatsBefore.NumMisses, 1u);
+    EXPECT_EQ(Stats.NumHits - StatsBefore.NumHits, 1u);
+
+    // Different entry points of the same source must not share the result
+    const auto PS = Convert("TestPS", SHADER_TYPE_PIXEL);
+    ASSERT_FALSE(PS.empty());
+    EXPECT_NE(PS, RefVS);
+
+    // Entry points that are not found must still fail
+    EXPECT_TRUE(Convert("MissingEntryPoint", SHADER_TYPE_VERTEX).empty());
+
+    Stats = GetStats();
+    EXPECT_EQ(Stats.NumEntries, 2u);
+
+    m_pConverter->ClearResultCache();
+    Stats = GetStats();
+    EXPECT_EQ(Stats.NumEntries, 0u);
+    EXPECT_EQ(Stats.TotalSize, 0u);
+}
+
+TEST_F(HLSL2GLSLConverterCacheTest, Eviction)
+{
+    HLSL2GLSLResultCacheAttribs Attribs;
+    Attribs.Enabled       = True;
+    Attribs.MaxMemorySize = 1;
+    m_pConverter->SetResultCacheAttribs(Attribs);
+
+    const auto StatsBefore = GetStats();
+
+    const auto VS = Convert("TestVS", SHADER_TYPE_VERTEX);
+    ASSERT_FALSE(VS.empty());
+    const auto PS = Convert("TestPS", SHADER_TYPE_PIXEL);
+    ASSERT_FALSE(PS.empty());
+
+    // Only the most recently used result is kept
+    auto Stats = GetStats();
+    EXPECT_EQ(Stats.NumEntries, 1u);
+    EXPECT_EQ(Stats.TotalSize, PS.size());
+    EXPECT_EQ(Stats.NumEvictions - StatsBefore.NumEvictions, 1u);
+
+    // The evicted result is converted again
+    EXPECT_EQ(Convert("TestVS", SHADER_TYPE_VERTEX), VS);
+    Stats = GetStats();
+    EXPECT_EQ(Stats.NumMisses - StatsBefore.NumMisses, 3u);
+    EXPECT_EQ(Stats.NumHits - StatsBefore.NumHits, 0u);
+}
+
+TEST_F(HLSL2GLSLConverterCacheTest, Disk)
+{
+    const std::string CacheDir = "HLSL2GLSLConverterCache";
+    if (FileSystem::PathExists(CacheDir.c_str()))
+        FileSystem::ClearDirectory(CacheDir.c_str());
+    else
+        ASSERT_TRUE(FileSystem::CreateDirectory(CacheDir.c_str()));
+
+    HLSL2GLSLResultCacheAttribs Attribs;
+    Attribs.Enabled   = True;
+    Attribs.Directory = CacheDir.c_str();
+    m_pConverter->SetResultCacheAttribs(Attribs);
+
+    const auto StatsBefore = GetStats();
+
+    const auto VS = Convert("TestVS", SHADER_TYPE_VERTEX);
+    ASSERT_FALSE(VS.empty());
+
+    // The result is loaded from disk after the memory cache is cleared
+    m_pConverter->ClearResultCache();
+    EXPECT_EQ(Convert("TestVS", SHADER_TYPE_VERTEX), VS);
+    auto Stats = GetStats();
+    EXPECT_EQ(Stats.NumDiskHits - StatsBefore.NumDiskHits, 1u);
+
+    // Corrupt the last byte of the stored result
+    const auto Files = FileSystem::Search((CacheDir + FileSystem::GetSlashSymbol() + "*.glsl").c_str());
+    ASSERT_EQ(Files.size(), size_t{1});
+    const auto FilePath = CacheDir + FileSystem::GetSlashSymbol() + Files[0]->Name();
+    {
+        std::vector<char> Data;
+        {
+            FileWrapper File{FilePath.c_str()};
+            ASSERT_TRUE(File);
+            Data.resize(File->GetSize());
+            ASSERT_TRUE(File->Read(Data.data(), Data.size()));
+        }
+        ASSERT_FALSE(Data.empty());
+        Data.back() ^= 0x1;
+
+        FileWrapper File{FilePath.c_str(), EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+        ASSERT_TRUE(File->Write(Data.data(), Data.size()));
+    }
+
+    // The corrupted file must be rejected and the shader converted again
+    m_pConverter->ClearResultCache();
+    EXPECT_EQ(Convert("TestVS", SHADER_TYPE_VERTEX), VS);
+    Stats = GetStats();
+    EXPECT_EQ(Stats.NumDiskHits - StatsBefore.NumDiskHits, 1u);
+    EXPECT_EQ(Stats.NumRejectedFiles - StatsBefore.NumRejectedFiles, 1u);
+
+    // The rejected file is overwritten with the valid result
+    m_pConverter->ClearResultCache();
+    EXPECT_EQ(Convert("TestVS", SHADER_TYPE_VERTEX), VS);
+    Stats = GetStats();
+    EXPECT_EQ(Stats.NumDiskHits - StatsBefore.NumDiskHits, 2u);
+
+    m_pConverter->SetResultCacheAttribs(HLSL2GLSLResultCacheAttribs{});
+    FileSystem::ClearDirectory(CacheDir.c_str());
+}
+
+} // namespace
@@ -1028,6 +1028,89 @@ TEST_F(PSOCreationFailureTest, InvalidCS)
     TestCreatePSOFailure(PsoCI, "SHADER_TYPE_PIXEL is not a valid type for compute shader");
 }
 
+TEST_F(PSOCreationFailureTest, SpecializationConstantsNotSupported)
+{
+    if (TestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo().Features.SpecializationConstants)
+    {
+        GTEST_SKIP();
+    }
+
+    const float                  Value = 1;
+    const SpecializationConstant SpecConsts[] //
+        {
+            SpecializationConstant{"c_Value", SHADER_TYPE_COMPUTE, sizeof(Value), &Value} //
+        };
+
+    auto PsoCI{GetComputePSOCreateInfo("PSO Create Failure - Specialization constants not supported")};
+    PsoCI.NumSpecializationConstants = _countof(SpecConsts);
+    PsoCI.pSpecializationConstants   = SpecConsts;
+    TestCreatePSOFailure(PsoCI, "Specialization constants require SpecializationConstants feature");
+}
+
+TEST_F(PSOCreationFailureTest, NullSpecializationConstants)
+{
+    auto PsoCI{GetComputePSOCreateInfo("PSO Create Failure - null specialization constants")};
+    PsoCI.NumSpecializationConstants = 1;
+    TestCreatePSOFailure(PsoCI, "pSpecializationConstants is null, but NumSpecializationConstants (1) is not zero");
+}
+
+TEST_F(PSOCreationFailureTest, NullSpecializationConstantName)
+{
+    if (!TestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo().Features.SpecializationConstants)
+    {
+        GTEST_SKIP();
+    }
+
+    const float                  Value = 1;
+    const SpecializationConstant SpecConsts[] //
+        {
+            SpecializationConstant{nullptr, SHADER_TYPE_COMPUTE, sizeof(Value), &Value} //
+        };
+
+    auto PsoCI{GetComputePSOCreateInfo("PSO Create Failure - null specialization constant name")};
+    PsoCI.NumSpecializationConstants = _countof(SpecConsts);
+    PsoCI.pSpecializationConstants   = SpecConsts;
+    TestCreatePSOFailure(PsoCI, "pSpecializationConstants[0].Name must not be null");
+}
+
+TEST_F(PSOCreationFailureTest, NullSpecializationConstantValue)
+{
+    if (!TestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo().Features.SpecializationConstants)
+    {
+        GTEST_SKIP();
+    }
+
+    const SpecializationConstant SpecConsts[] //
+        {
+            SpecializationConstant{"c_Value", SHADER_TYPE_COMPUTE, 4, nullptr} //
+        };
+
+    auto PsoCI{GetComputePSOCreateInfo("PSO Create Failure - null specialization constant value")};
+    PsoCI.NumSpecializationConstants = _countof(SpecConsts);
+    PsoCI.pSpecializationConstants   = SpecConsts;
+    TestCreatePSOFailure(PsoCI, "pSpecializationConstants[0].pValue must not be null");
+}
+
+TEST_F(PSOCreationFailureTest, OverlappingSpecializationConstantStages)
+{
+    if (!TestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo().Features.SpecializationConstants)
+    {
+        GTEST_SKIP();
+    }
+
+    const float                  Value = 1;
+    const SpecializationConstant SpecConsts[] //
+        {
+            SpecializationConstant{"c_Value", SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL, sizeof(Value), &Value},
+            SpecializationConstant{"c_Value", SHADER_TYPE_PIXEL, sizeof(Value), &Value} //
+        };
+
+    auto PsoCI{GetGraphicsPSOCreateInfo("PSO Create Failure - overlapping specialization constant stages")};
+    PsoCI.NumSpecializationConstants = _countof(SpecConsts);
+    PsoCI.pSpecializationConstants   = SpecConsts;
+    TestCreatePSOFailure(PsoCI, "Specialization constant 'c_Value' is defined in overlapping shader stages");
+}
+
 TEST_F(PSOCreationFailureTest, NullMS)
 {
     if (!HasMeshShader())
@@ -0,0 +1,229 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "ParallelCommandRecorder.hpp"
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char g_VSSource[] = R"(
+void main(in uint VertId : SV_VertexID,
+          out float4 Pos : SV_Position)
+{
+    float2 Coords[3];
+    Coords[0] = float2(-1.0, -1.0);
+    Coords[1] = float2( 0.0, +1.0);
+    Coords[2] = float2(+1.0, -1.0);
+    Pos = float4(Coords[VertId % 3u] * 0.01, 0.0, 1.0);
+}
+)";
+
+static const char g_PSSource[] = R"(
+float4 main(in float4 Pos : SV_Position) : SV_Target
+{
+    return float4(1.0, 0.0, 0.0, 1.0);
+}
+)";
+
+class ParallelCommandRecorderTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        auto* pEnv    = TestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+
+        if (pEnv->GetNumDeferredContexts() == 0)
+            return;
+
+        TextureDesc TexDesc;
+        TexDesc.Name      = "Parallel command recorder test render target";
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+        TexDesc.Width     = 256;
+        TexDesc.Height    = 256;
+        TexDesc.BindFlags = BIND_RENDER_TARGET;
+
+        RefCntAutoPtr<ITexture> pRenderTarget;
+        pDevice->CreateTexture(TexDesc, nullptr, &pRenderTarget);
+        ASSERT_NE(pRenderTarget, nullptr);
+        sm_pRTV = pRenderTarget->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+        auto& PSODesc          = PSOCreateInfo.PSODesc;
+        auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+        PSODesc.Name = "Parallel command recorder test";
+
+        GraphicsPipeline.NumRenderTargets             = 1;
+        GraphicsPipeline.RTVFormats[0]                = TexDesc.Format;
+        GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+        GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.UseCombinedTextureSamplers = true;
+        ShaderCI.EntryPoint                 = "main";
+
+        RefCntAutoPtr<IShader> pVS;
+        {
+            ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+            ShaderCI.Desc.Name       = "Parallel command recorder test VS";
+            ShaderCI.Source          = g_VSSource;
+            pDevice->CreateShader(ShaderCI, &pVS);
+            ASSERT_NE(pVS, nullptr);
+        }
+
+        RefCntAutoPtr<IShader> pPS;
+        {
+            ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+            ShaderCI.Desc.Name       = "Parallel command recorder test PS";
+            ShaderCI.Source          = g_PSSource;
+            pDevice->CreateShader(ShaderCI, &pPS);
+            ASSERT_NE(pPS, nullptr);
+        }
+
+        PSOCreateInfo.pVS = pVS;
+        PSOCreateInfo.pPS = pPS;
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &sm_pPSO);
+        ASSERT_NE(sm_pPSO, nullptr);
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_pPSO.Release();
+        sm_pRTV.Release();
+        TestingEnvironment::GetInstance()->Reset();
+    }
+
+    static void SetUpTest(IDeviceContext* pContext)
+    {
+        ITextureView* pRTVs[] = {sm_pRTV};
+        pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        const float ClearColor[] = {0, 0, 0, 0};
+        pContext->ClearRenderTarget(sm_pRTV, ClearColor, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    }
+
+    static void RecordDraws(IDeviceContext* pContext, Uint32 StartPacket, Uint32 EndPacket)
+    {
+        ITextureView* pRTVs[] = {sm_pRTV};
+        pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        pContext->SetPipelineState(sm_pPSO);
+        for (Uint32 Packet = StartPacket; Packet < EndPacket; ++Packet)
+            pContext->Draw(DrawAttribs{3, DRAW_FLAG_VERIFY_ALL});
+    }
+
+    static std::vector<IDeviceContext*> GetDeferredContexts(Uint32 NumContexts)
+    {
+        auto*                        pEnv = TestingEnvironment::GetInstance();
+        std::vector<IDeviceContext*> Contexts(NumContexts);
+        for (Uint32 i = 0; i < NumContexts; ++i)
+            Contexts[i] = pEnv->GetDeferredContext(i);
+        return Contexts;
+    }
+
+    static RefCntAutoPtr<ITextureView>   sm_pRTV;
+    static RefCntAutoPtr<IPipelineState> sm_pPSO;
+};
+
+RefCntAutoPtr<ITextureView>   ParallelCommandRecorderTest::sm_pRTV;
+RefCntAutoPtr<IPipelineState> ParallelCommandRecorderTest::sm_pPSO;
+
+
+TEST_F(ParallelCommandRecorderTest, RecordPackets)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    const auto NumDeferredCtx = static_cast<Uint32>(pEnv->GetNumDeferredContexts());
+    if (NumDeferredCtx == 0)
+        GTEST_SKIP() << "Deferred contexts are not supported by this device";
+
+    auto DeferredCtxs = GetDeferredContexts(NumDeferredCtx);
+
+    ParallelCommandRecorderCreateInfo CI;
+    CI.pImmediateContext    = pContext;
+    CI.ppDeferredContexts   = DeferredCtxs.data();
+    CI.NumDeferredContexts  = NumDeferredCtx;
+    CI.MinPacketsPerContext = 16;
+    ParallelCommandRecorder Recorder{CI};
+    EXPECT_EQ(Recorder.GetNumContexts(), NumDeferredCtx);
+
+    SetUpTest(pContext);
+
+    // Small workloads must use fewer contexts
+    EXPECT_EQ(Recorder.Record(10, RecordDraws), 1u);
+
+    constexpr Uint32 NumPackets = 1000;
+
+    // Every packet must be recorded exactly once
+    std::vector<Uint32> PacketCounts(NumPackets);
+    std::atomic<Uint32> NumRanges{0};
+    const auto          NumUsedCtx = Recorder.Record(NumPackets, [&](IDeviceContext* pCtx, Uint32 StartPacket, Uint32 EndPacket) {
+        EXPECT_LT(StartPacket, EndPacket);
+        for (Uint32 Packet = StartPacket; Packet < EndPacket; ++Packet)
+            ++PacketCounts[Packet];
+        RecordDraws(pCtx, StartPacket, EndPacket);
+        NumRanges.fetch_add(1);
+    });
+    EXPECT_EQ(NumUsedCtx, std::min(NumDeferredCtx, (NumPackets + CI.MinPacketsPerContext - 1) / CI.MinPacketsPerContext));
+    EXPECT_EQ(NumRanges.load(), NumUsedCtx);
+    for (Uint32 Packet = 0; Packet < NumPackets; ++Packet)
+        EXPECT_EQ(PacketCounts[Packet], 1u) << "Packet " << Packet;
+
+    // Exceptions must be propagated to the caller
+    EXPECT_THROW(Recorder.Record(NumPackets,
+                                 [](IDeviceContext* pCtx, Uint32 StartPacket, Uint32 EndPacket) {
+                                     RecordDraws(pCtx, StartPacket, EndPacket);
+                                     if (EndPacket == NumPackets)
+                                         throw std::runtime_error{"Recording error"};
+                                 }),
+                 std::runtime_error);
+
+    // The recorder must remain usable after the exception
+    EXPECT_EQ(Recorder.Record(NumPackets, RecordDraws), NumUsedCtx);
+
+    pContext->Flush();
+    pContext->FinishFrame();
+    Recorder.FinishFrame();
+    pContext->WaitForIdle();
+}
+
+} // namespace
@@ -0,0 +1,311 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+#include "FileWrapper.hpp"
+#include "FileSystem.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char g_ShaderSourceTemplate[] = R"(
+void VSMain(in  uint   VertId : SV_VertexID,
+            out float4 Pos    : SV_POSITION)
+{
+    float2 UV = float2(VertId & 1, VertId >> 1);
+    Pos = float4(UV * 2.0 - 1.0, 0.0, 1.0);
+}
+
+float4 PSMain(in float4 Pos : SV_POSITION) : SV_TARGET
+{
+    return float4(Pos.xy * CONST_VALUE, 0.0, 1.0);
+}
+)";
+
+RefCntAutoPtr<IShader> CreateTestShader(SHADER_TYPE Type, Uint32 Idx)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    const auto ConstValue = std::to_string(Idx + 1) + ".0";
+
+    ShaderMacro Macros[] = {{"CONST_VALUE", ConstValue.c_str()}, {}};
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Source                     = g_ShaderSourceTemplate;
+    ShaderCI.Macros                     = Macros;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.UseCombinedTextureSamplers = true;
+    ShaderCI.Desc.ShaderType            = Type;
+    ShaderCI.EntryPoint                 = Type == SHADER_TYPE_VERTEX ? "VSMain" : "PSMain";
+    ShaderCI.Desc.Name                  = Type == SHADER_TYPE_VERTEX ? "PSO cache test VS" : "PSO cache test PS";
+
+    RefCntAutoPtr<IShader> pShader;
+    pDevice->CreateShader(ShaderCI, &pShader);
+    return pShader;
+}
+
+RefCntAutoPtr<IPipelineState> CreateTestPSO(IShader* pVS, IShader* pPS, IPipelineStateCache* pCache)
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+    GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+    auto& PSODesc          = PSOCreateInfo.PSODesc;
+    auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+    PSODesc.Name                       = "PSO cache test";
+    PSOCreateInfo.pVS                  = pVS;
+    PSOCreateInfo.pPS                  = pPS;
+    PSOCreateInfo.pPSOCache            = pCache;
+    GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+    GraphicsPipeline.NumRenderTargets  = 1;
+    GraphicsPipeline.RTVFormats[0]     = TEX_FORMAT_RGBA8_UNORM;
+    GraphicsPipeline.DSVFormat         = TEX_FORMAT_D32_FLOAT;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+    return pPSO;
+}
+
+TEST(PipelineStateCacheTest, InvalidData)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    // Data without the engine header are passed to the driver, which must reject them
+    const std::vector<Uint8> Garbage(256, 0xAB);
+
+    PipelineStateCacheCreateInfo CacheCI;
+    CacheCI.Desc.Name     = "PSO cache with invalid data";
+    CacheCI.pCacheData    = Garbage.data();
+    CacheCI.CacheDataSize = static_cast<Uint32>(Garbage.size());
+
+    RefCntAutoPtr<IPipelineStateCache> pCache;
+    pDevice->CreatePipelineStateCache(CacheCI, &pCache);
+    if (!pCache)
+    {
+        GTEST_SKIP() << "Pipeline state cache is not supported by this device";
+    }
+
+    auto pVS = CreateTestShader(SHADER_TYPE_VERTEX, 0);
+    auto pPS = CreateTestShader(SHADER_TYPE_PIXEL, 0);
+    ASSERT_TRUE(pVS && pPS);
+    EXPECT_NE(CreateTestPSO(pVS, pPS, pCache), nullptr);
+}
+
+// Creates PSOs with an empty cache and with the cache loaded from the data
+// serialized after the first run. Creation time is measured by DiligentCoreBenchmark.
+TEST(PipelineStateCacheTest, ColdAndWarmStart)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    PipelineStateCacheCreateInfo CacheCI;
+    CacheCI.Desc.Name = "Cold PSO cache";
+
+    RefCntAutoPtr<IPipelineStateCache> pColdCache;
+    pDevice->CreatePipelineStateCache(CacheCI, &pColdCache);
+    if (!pColdCache)
+    {
+        GTEST_SKIP() << "Pipeline state cache is not supported by this device";
+    }
+
+    constexpr Uint32 NumPSOs = 32;
+
+    std::vector<RefCntAutoPtr<IShader>> VertexShaders, PixelShaders;
+    for (Uint32 i = 0; i < NumPSOs; ++i)
+    {
+        VertexShaders.emplace_back(CreateTestShader(SHADER_TYPE_VERTEX, i));
+        PixelShaders.emplace_back(CreateTestShader(SHADER_TYPE_PIXEL, i));
+        ASSERT_TRUE(VertexShaders.back() && PixelShaders.back());
+    }
+
+    auto CreatePSOs = [&](IPipelineStateCache* pCache) {
+        for (Uint32 i = 0; i < NumPSOs; ++i)
+        {
+            auto pPSO = CreateTestPSO(VertexShaders[i], PixelShaders[i], pCache);
+            EXPECT_NE(pPSO, nullptr);
+        }
+    };
+
+    CreatePSOs(pColdCache);
+
+    RefCntAutoPtr<IDataBlob> pCacheData;
+    pColdCache->GetData(&pCacheData);
+    ASSERT_NE(pCacheData, nullptr);
+    ASSERT_GT(pCacheData->GetSize(), size_t{0});
+
+    CacheCI.Desc.Name     = "Warm PSO cache";
+    CacheCI.pCacheData    = pCacheData->GetConstDataPtr();
+    CacheCI.CacheDataSize = static_cast<Uint32>(pCacheData->GetSize());
+
+    RefCntAutoPtr<IPipelineStateCache> pWarmCache;
+    pDevice->CreatePipelineStateCache(CacheCI, &pWarmCache);
+    ASSERT_NE(pWarmCache, nullptr);
+
+    CreatePSOs(pWarmCache);
+
+    // The warm cache must preserve all entries
+    RefCntAutoPtr<IDataBlob> pWarmCacheData;
+    pWarmCache->GetData(&pWarmCacheData);
+    ASSERT_NE(pWarmCacheData, nullptr);
+    EXPECT_GE(pWarmCacheData->GetSize(), pCacheData->GetSize());
+}
+
+// The cache loaded from a file must be equivalent to the cache created from the same data in memory
+TEST(PipelineStateCacheTest, LoadFromFile)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    PipelineStateCacheCreateInfo CacheCI;
+    CacheCI.Desc.Name = "PSO cache";
+
+    RefCntAutoPtr<IPipelineStateCache> pCache;
+    pDevice->CreatePipelineStateCache(CacheCI, &pCache);
+    if (!pCache)
+    {
+        GTEST_SKIP() << "Pipeline state cache is not supported by this device";
+    }
+
+    auto pVS = CreateTestShader(SHADER_TYPE_VERTEX, 0);
+    auto pPS = CreateTestShader(SHADER_TYPE_PIXEL, 0);
+    ASSERT_TRUE(pVS && pPS);
+    ASSERT_NE(CreateTestPSO(pVS, pPS, pCache), nullptr);
+
+    RefCntAutoPtr<IDataBlob> pCacheData;
+    pCache->GetData(&pCacheData);
+    ASSERT_NE(pCacheData, nullptr);
+
+    const char* FilePath = "PipelineStateCacheTest.bin";
+    {
+        FileWrapper File{FilePath, EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+        ASSERT_TRUE(File->Write(pCacheData->GetConstDataPtr(), pCacheData->GetSize()));
+    }
+
+    CacheCI.Desc.Name = "PSO cache loaded from file";
+    CacheCI.FilePath  = FilePath;
+
+    RefCntAutoPtr<IPipelineStateCache> pFileCache;
+    pDevice->CreatePipelineStateCache(CacheCI, &pFileCache);
+    ASSERT_NE(pFileCache, nullptr);
+    EXPECT_NE(CreateTestPSO(pVS, pPS, pFileCache), nullptr);
+
+    RefCntAutoPtr<IDataBlob> pFileCacheData;
+    pFileCache->GetData(&pFileCacheData);
+    ASSERT_NE(pFileCacheData, nullptr);
+    EXPECT_GE(pFileCacheData->GetSize(), pCacheData->GetSize());
+
+    pFileCache.Release();
+    FileSystem::DeleteFile(FilePath);
+
+    // Missing file must result in an empty cache
+    CacheCI.Desc.Name = "PSO cache with missing file";
+    pDevice->CreatePipelineStateCache(CacheCI, &pFileCache);
+    ASSERT_NE(pFileCache, nullptr);
+    EXPECT_NE(CreateTestPSO(pVS, pPS, pFileCache), nullptr);
+}
+
+// Program binaries in OpenGL are only valid for the driver that produced them.
+// Cache data created by a different driver must be ignored.
+TEST(PipelineStateCacheTest, GL_ForeignDriverData)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().IsGLDevice())
+    {
+        GTEST_SKIP() << "This test is specific to OpenGL";
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    PipelineStateCacheCreateInfo CacheCI;
+    CacheCI.Desc.Name = "GL PSO cache";
+
+    RefCntAutoPtr<IPipelineStateCache> pCache;
+    pDevice->CreatePipelineStateCache(CacheCI, &pCache);
+    ASSERT_NE(pCache, nullptr);
+
+    RefCntAutoPtr<IDataBlob> pEmptyCacheData;
+    pCache->GetData(&pEmptyCacheData);
+    ASSERT_NE(pEmptyCacheData, nullptr);
+
+    auto pVS = CreateTestShader(SHADER_TYPE_VERTEX, 0);
+    auto pPS = CreateTestShader(SHADER_TYPE_PIXEL, 0);
+    ASSERT_TRUE(pVS && pPS);
+    ASSERT_NE(CreateTestPSO(pVS, pPS, pCache), nullptr);
+
+    RefCntAutoPtr<IDataBlob> pCacheData;
+    pCache->GetData(&pCacheData);
+    ASSERT_NE(pCacheData, nullptr);
+    if (pCacheData->GetSize() == pEmptyCacheData->GetSize())
+    {
+        GTEST_SKIP() << "The driver does not support program binaries";
+    }
+
+    // The driver identifier is stored at the end of the data
+    const auto*        pBytes = static_cast<const Uint8*>(pCacheData->GetConstDataPtr());
+    std::vector<Uint8> ForeignData{pBytes, pBytes + pCacheData->GetSize()};
+    ForeignData.back() ^= 0x55;
+
+    CacheCI.Desc.Name     = "GL PSO cache with foreign data";
+    CacheCI.pCacheData    = ForeignData.data();
+    CacheCI.CacheDataSize = static_cast<Uint32>(ForeignData.size());
+
+    RefCntAutoPtr<IPipelineStateCache> pForeignCache;
+    pDevice->CreatePipelineStateCache(CacheCI, &pForeignCache);
+    ASSERT_NE(pForeignCache, nullptr);
+
+    RefCntAutoPtr<IDataBlob> pForeignCacheData;
+    pForeignCache->GetData(&pForeignCacheData);
+    ASSERT_NE(pForeignCacheData, nullptr);
+    EXPECT_EQ(pForeignCacheData->GetSize(), pEmptyCacheData->GetSize());
+
+    // The program must be linked from the source
+    EXPECT_NE(CreateTestPSO(pVS, pPS, pForeignCache), nullptr);
+    pForeignCache->GetData(&pForeignCacheData);
+    EXPECT_EQ(pForeignCacheData->GetSize(), pCacheData->GetSize());
+}
+
+} // namespace
@@ -27,6 +27,8 @@
 
 #include <algorithm>
 #include <cctype>
+#include <thread>
+#include <vector>
 
 #include "TestingEnvironment.hpp"
 #include "Sampler.h"
@@ -236,6 +238,105 @@ INSTANTIATE_TEST_SUITE_P(ComparisonFunctions,
 );
 
 
+TEST(SamplerRegistryTest, Stats)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    SamplerDesc SamDesc;
+    SamDesc.Name          = "Sampler registry stats test";
+    SamDesc.MinFilter     = FILTER_TYPE_ANISOTROPIC;
+    SamDesc.MagFilter     = FILTER_TYPE_ANISOTROPIC;
+    SamDesc.MipFilter     = FILTER_TYPE_ANISOTROPIC;
+    SamDesc.MaxAnisotropy = 3;
+    SamDesc.MipLODBias    = 0.125f;
+
+    const auto Stats0 = pDevice->GetSamplerRegistryStats();
+
+    RefCntAutoPtr<ISampler> pSampler1, pSampler2;
+    pDevice->CreateSampler(SamDesc, &pSampler1);
+    ASSERT_TRUE(pSampler1);
+    pDevice->CreateSampler(SamDesc, &pSampler2);
+    EXPECT_EQ(pSampler1, pSampler2);
+
+    const auto Stats1 = pDevice->GetSamplerRegistryStats();
+    EXPECT_EQ(Stats1.NumMisses, Stats0.NumMisses + 1);
+    EXPECT_EQ(Stats1.NumHits, Stats0.NumHits + 1);
+    EXPECT_GE(Stats1.NumObjects, 1u);
+
+    // Released sampler must not be found in the registry
+    pSampler1.Release();
+    pSampler2.Release();
+    pDevice->CreateSampler(SamDesc, &pSampler1);
+    ASSERT_TRUE(pSampler1);
+
+    const auto Stats2 = pDevice->GetSamplerRegistryStats();
+    EXPECT_EQ(Stats2.NumMisses, Stats1.NumMisses + 1);
+    EXPECT_EQ(Stats2.NumHits, Stats1.NumHits);
+}
+
+TEST(SamplerRegistryTest, MultithreadedCreation)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    constexpr Uint32 NumUniqueSamplers = 16;
+    constexpr Uint32 NumIterations     = 64;
+
+    const Uint32 NumThreads = std::max(4u, std::thread::hardware_concurrency());
+
+    auto GetSamplerDesc = [](Uint32 i) {
+        SamplerDesc SamDesc;
+        SamDesc.Name          = "Sampler registry MT test";
+        SamDesc.MinFilter     = FILTER_TYPE_ANISOTROPIC;
+        SamDesc.MagFilter     = FILTER_TYPE_ANISOTROPIC;
+        SamDesc.MipFilter     = FILTER_TYPE_ANISOTROPIC;
+        SamDesc.MaxAnisotropy = 2;
+        SamDesc.MinLOD        = static_cast<float>(i);
+        return SamDesc;
+    };
+
+    // Keep one reference to every sampler so that all other threads must find it in the registry
+    std::vector<RefCntAutoPtr<ISampler>> pRefSamplers(NumUniqueSamplers);
+    for (Uint32 i = 0; i < NumUniqueSamplers; ++i)
+    {
+        pDevice->CreateSampler(GetSamplerDesc(i), &pRefSamplers[i]);
+        ASSERT_TRUE(pRefSamplers[i]);
+    }
+
+    const auto Stats0 = pDevice->GetSamplerRegistryStats();
+
+    std::vector<std::thread> Threads(NumThreads);
+    for (auto& Thread : Threads)
+    {
+        Thread = std::thread{
+            [&]() //
+            {
+                for (Uint32 it = 0; it < NumIterations; ++it)
+                {
+                    for (Uint32 i = 0; i < NumUniqueSamplers; ++i)
+                    {
+                        RefCntAutoPtr<ISampler> pSampler;
+                        pDevice->CreateSampler(GetSamplerDesc(i), &pSampler);
+                        EXPECT_EQ(pSampler, pRefSamplers[i]);
+                    }
+                }
+            } //
+        };
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    const auto Stats1 = pDevice->GetSamplerRegistryStats();
+    EXPECT_EQ(Stats1.NumHits - Stats0.NumHits, Uint64{NumThreads} * NumIterations * NumUniqueSamplers);
+    EXPECT_EQ(Stats1.NumMisses, Stats0.NumMisses);
+}
+
+
 void TestSamplerCorrectness(IShader*                      pVS,
                             IShader*                      pPS,
                             ITextureView*                 pDefaultSRV,
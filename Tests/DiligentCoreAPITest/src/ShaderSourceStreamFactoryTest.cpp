@@ -0,0 +1,230 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "../../../Graphics/GraphicsEngine/include/DefaultShaderSourceStreamFactory.h"
+#include "MemoryFileStream.hpp"
+#include "FileWrapper.hpp"
+#include "FileSystem.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+RefCntAutoPtr<IDataBlob> ReadSource(IShaderSourceInputStreamFactory* pFactory, const char* Name)
+{
+    RefCntAutoPtr<IFileStream> pStream;
+    pFactory->CreateInputStream2(Name, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT, &pStream);
+    return pStream ? ReadStreamBlob(pStream) : RefCntAutoPtr<IDataBlob>{};
+}
+
+std::string BlobToString(IDataBlob* pBlob)
+{
+    return std::string{static_cast<const char*>(pBlob->GetConstDataPtr()), pBlob->GetSize()};
+}
+
+// Writes the file and makes sure that its modification time differs from PrevModificationTime
+Uint64 WriteTestFile(const char* Path, const char* Text, Uint64 PrevModificationTime)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        {
+            FileWrapper File{Path, EFileAccessMode::Overwrite};
+            if (!File)
+                return 0;
+            File->Write(Text, strlen(Text));
+        }
+        const auto ModificationTime = FileSystem::GetFileModificationTime(Path);
+        if (ModificationTime != PrevModificationTime)
+            return ModificationTime;
+
+        // Some file systems have coarse time stamps
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    }
+    return 0;
+}
+
+TEST(ShaderSourceStreamFactoryTest, Default)
+{
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory;
+    CreateDefaultShaderSourceStreamFactory("shaders/HLSL2GLSLConverter", &pFactory);
+    ASSERT_NE(pFactory, nullptr);
+
+    auto pData0 = ReadSource(pFactory, "IncludeTest.h");
+    ASSERT_NE(pData0, nullptr);
+    auto pData1 = ReadSource(pFactory, "IncludeTest.h");
+    ASSERT_NE(pData1, nullptr);
+    EXPECT_NE(pData0, pData1);
+    EXPECT_EQ(BlobToString(pData0), BlobToString(pData1));
+
+    EXPECT_EQ(ReadSource(pFactory, "NonExistentFile.h"), nullptr);
+
+    const auto Stats = GetShaderSourceStreamFactoryStats(pFactory);
+    EXPECT_EQ(Stats.NumHits, Uint64{0});
+    EXPECT_EQ(Stats.NumMisses, Uint64{0});
+    EXPECT_GT(Stats.NumFileSystemCalls, Uint64{0});
+}
+
+TEST(ShaderSourceStreamFactoryTest, Caching)
+{
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory;
+    // Use a long revalidation period so that the warm cache does not touch the file system
+    CreateCachingShaderSourceStreamFactory("shaders/HLSL2GLSLConverter", 1000000, Uint64{1} << 20, &pFactory);
+    ASSERT_NE(pFactory, nullptr);
+
+    auto pData0 = ReadSource(pFactory, "IncludeTest.h");
+    ASSERT_NE(pData0, nullptr);
+
+    const auto ColdStats = GetShaderSourceStreamFactoryStats(pFactory);
+    EXPECT_EQ(ColdStats.NumHits, Uint64{0});
+    EXPECT_EQ(ColdStats.NumMisses, Uint64{1});
+    EXPECT_GT(ColdStats.NumFileSystemCalls, Uint64{0});
+
+    for (Uint32 i = 0; i < 4; ++i)
+    {
+        auto pData = ReadSource(pFactory, "IncludeTest.h");
+        EXPECT_EQ(pData, pData0);
+    }
+
+    const auto WarmStats = GetShaderSourceStreamFactoryStats(pFactory);
+    EXPECT_EQ(WarmStats.NumHits, Uint64{4});
+    EXPECT_EQ(WarmStats.NumMisses, Uint64{1});
+    EXPECT_EQ(WarmStats.NumInvalidations, Uint64{0});
+    EXPECT_EQ(WarmStats.NumFileSystemCalls, ColdStats.NumFileSystemCalls);
+    EXPECT_EQ(WarmStats.NumCachedFiles, Uint64{1});
+    EXPECT_EQ(WarmStats.CachedDataSize, Uint64{pData0->GetSize()});
+
+    EXPECT_EQ(ReadSource(pFactory, "NonExistentFile.h"), nullptr);
+}
+
+TEST(ShaderSourceStreamFactoryTest, CacheInvalidation)
+{
+    const char* TestFileName = "ShaderSourceStreamFactoryTest.h";
+
+    auto ModificationTime = WriteTestFile(TestFileName, "// Version 1", 0);
+    ASSERT_NE(ModificationTime, Uint64{0});
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory;
+    // Zero revalidation period: check the modification time on every request
+    CreateCachingShaderSourceStreamFactory(nullptr, 0, Uint64{1} << 20, &pFactory);
+    ASSERT_NE(pFactory, nullptr);
+
+    auto pData0 = ReadSource(pFactory, TestFileName);
+    ASSERT_NE(pData0, nullptr);
+    EXPECT_EQ(BlobToString(pData0), "// Version 1");
+    EXPECT_EQ(ReadSource(pFactory, TestFileName), pData0);
+
+    // Modified contents must be re-read
+    ModificationTime = WriteTestFile(TestFileName, "// Version 2", ModificationTime);
+    ASSERT_NE(ModificationTime, Uint64{0});
+
+    auto pData1 = ReadSource(pFactory, TestFileName);
+    ASSERT_NE(pData1, nullptr);
+    EXPECT_NE(pData1, pData0);
+    EXPECT_EQ(BlobToString(pData1), "// Version 2");
+    // The previously returned data must not be affected
+    EXPECT_EQ(BlobToString(pData0), "// Version 1");
+
+    // The same contents with a new time stamp must keep the existing blob
+    ModificationTime = WriteTestFile(TestFileName, "// Version 2", ModificationTime);
+    ASSERT_NE(ModificationTime, Uint64{0});
+    EXPECT_EQ(ReadSource(pFactory, TestFileName), pData1);
+
+    auto Stats = GetShaderSourceStreamFactoryStats(pFactory);
+    EXPECT_EQ(Stats.NumHits, Uint64{1});
+    EXPECT_EQ(Stats.NumMisses, Uint64{3});
+    EXPECT_EQ(Stats.NumInvalidations, Uint64{2});
+
+    // Removed file must be dropped from the cache
+    FileSystem::DeleteFile(TestFileName);
+    EXPECT_EQ(ReadSource(pFactory, TestFileName), nullptr);
+}
+
+
+TEST(ShaderSourceStreamFactoryTest, CacheEviction)
+{
+    const char* TestFileNames[] = {"ShaderSourceStreamFactoryTest0.h", "ShaderSourceStreamFactoryTest1.h", "ShaderSourceStreamFactoryTest2.h"};
+    const char* LargeFileName   = "ShaderSourceStreamFactoryTestLarge.h";
+
+    // Every file is 16 bytes long
+    for (const auto* FileName : TestFileNames)
+        ASSERT_NE(WriteTestFile(FileName, "// 0123456789abc", 0), Uint64{0});
+    ASSERT_NE(WriteTestFile(LargeFileName, "// 0123456789abcdef0123456789abcdef0123456789abc", 0), Uint64{0});
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory;
+    // The cache only fits two test files
+    CreateCachingShaderSourceStreamFactory(nullptr, 1000000, 40, &pFactory);
+    ASSERT_NE(pFactory, nullptr);
+
+    auto pData0 = ReadSource(pFactory, TestFileNames[0]);
+    auto pData1 = ReadSource(pFactory, TestFileNames[1]);
+    ASSERT_NE(pData0, nullptr);
+    ASSERT_NE(pData1, nullptr);
+
+    // Make file 0 the most recently used one
+    EXPECT_EQ(ReadSource(pFactory, TestFileNames[0]), pData0);
+
+    // File 1 is the least recently used and must be evicted
+    auto pData2 = ReadSource(pFactory, TestFileNames[2]);
+    ASSERT_NE(pData2, nullptr);
+
+    auto Stats = GetShaderSourceStreamFactoryStats(pFactory);
+    EXPECT_EQ(Stats.NumEvictions, Uint64{1});
+    EXPECT_EQ(Stats.NumCachedFiles, Uint64{2});
+    EXPECT_EQ(Stats.CachedDataSize, Uint64{32});
+
+    EXPECT_EQ(ReadSource(pFactory, TestFileNames[0]), pData0);
+    EXPECT_EQ(ReadSource(pFactory, TestFileNames[2]), pData2);
+    auto pData1Reloaded = ReadSource(pFactory, TestFileNames[1]);
+    ASSERT_NE(pData1Reloaded, nullptr);
+    EXPECT_NE(pData1Reloaded, pData1);
+    EXPECT_EQ(BlobToString(pData1Reloaded), BlobToString(pData1));
+
+    // A file larger than the cache is returned, but not cached
+    auto pLargeData = ReadSource(pFactory, LargeFileName);
+    ASSERT_NE(pLargeData, nullptr);
+    EXPECT_EQ(pLargeData->GetSize(), size_t{48});
+    EXPECT_NE(ReadSource(pFactory, LargeFileName), pLargeData);
+
+    Stats = GetShaderSourceStreamFactoryStats(pFactory);
+    EXPECT_EQ(Stats.NumEvictions, Uint64{2});
+    EXPECT_EQ(Stats.NumCachedFiles, Uint64{2});
+    EXPECT_EQ(Stats.CachedDataSize, Uint64{32});
+
+    for (const auto* FileName : TestFileNames)
+        FileSystem::DeleteFile(FileName);
+    FileSystem::DeleteFile(LargeFileName);
+}
+
+} // namespace
@@ -0,0 +1,329 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char g_ComputeShaderSource[] = R"(
+layout(constant_id = 0) const float c_Scale  = 1.0;
+layout(constant_id = 1) const int   c_Offset = -1;
+layout(constant_id = 2) const uint  c_Mask   = 0u;
+layout(constant_id = 3) const bool  c_Negate = false;
+
+layout(std140, binding = 0) buffer g_Output
+{
+    vec4 g_Data[4];
+};
+
+layout(local_size_x = 1, local_size_y = 1, local_size_z = 1) in;
+void main()
+{
+    g_Data[0] = vec4(c_Scale, float(c_Offset), float(c_Mask), c_Negate ? 1.0 : 0.0);
+}
+)";
+
+// Commented-out declarations must be ignored
+static const char g_CommentedOutDeclarationShaderSource[] = R"(
+// layout(constant_id = 0) const int c_Scale = 2
+layout(constant_id = 0) const float c_Scale = 1.0;
+
+layout(std140, binding = 0) buffer g_Output
+{
+    vec4 g_Data[4];
+};
+
+layout(local_size_x = 1, local_size_y = 1, local_size_z = 1) in;
+void main()
+{
+    g_Data[0] = vec4(c_Scale, 0.0, 0.0, 0.0);
+}
+)";
+
+// The body of the shaders with the declarations that are not supported in OpenGL
+static const char g_UnsupportedDeclarationShaderBody[] = R"(
+layout(std140, binding = 0) buffer g_Output
+{
+    vec4 g_Data[4];
+};
+
+layout(local_size_x = 1, local_size_y = 1, local_size_z = 1) in;
+void main()
+{
+    g_Data[0] = vec4(float(c_Value), 0.0, 0.0, 0.0);
+}
+)";
+
+class SpecializationConstantsTest : public ::testing::Test
+{
+protected:
+    static bool IsSupported()
+    {
+        const auto& DeviceInfo = TestingEnvironment::GetInstance()->GetDevice()->GetDeviceInfo();
+        // GLSL source is only supported in Vulkan and OpenGL
+        return DeviceInfo.Features.SpecializationConstants && DeviceInfo.Features.ComputeShaders &&
+            (DeviceInfo.IsVulkanDevice() || DeviceInfo.IsGLDevice());
+    }
+
+    static void SetUpTestSuite()
+    {
+        if (!IsSupported())
+            return;
+
+        auto* pEnv    = TestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+
+        sm_pCS = CreateShader(g_ComputeShaderSource, "Specialization constants test CS");
+        ASSERT_NE(sm_pCS, nullptr);
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name              = "Specialization constants test buffer";
+        BuffDesc.Size              = sizeof(float) * 4 * 4;
+        BuffDesc.BindFlags         = BIND_UNORDERED_ACCESS;
+        BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+        BuffDesc.ElementByteStride = sizeof(float) * 4;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &sm_pBuffer);
+        ASSERT_NE(sm_pBuffer, nullptr);
+
+        BuffDesc.Name           = "Specialization constants test staging buffer";
+        BuffDesc.Usage          = USAGE_STAGING;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        BuffDesc.BindFlags      = BIND_NONE;
+        BuffDesc.Mode           = BUFFER_MODE_UNDEFINED;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &sm_pStagingBuffer);
+        ASSERT_NE(sm_pStagingBuffer, nullptr);
+    }
+
+    static void TearDownTestSuite()
+    {
+        sm_pCS.Release();
+        sm_pBuffer.Release();
+        sm_pStagingBuffer.Release();
+
+        TestingEnvironment::GetInstance()->Reset();
+    }
+
+    void SetUp() override
+    {
+        if (!IsSupported())
+        {
+            GTEST_SKIP() << "Specialization constants in GLSL compute shaders are not supported by this device";
+        }
+    }
+
+    static RefCntAutoPtr<IShader> CreateShader(const char* Source, const char* Name)
+    {
+        auto* pEnv = TestingEnvironment::GetInstance();
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.Source                     = Source;
+        ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_GLSL;
+        ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.UseCombinedTextureSamplers = true;
+        ShaderCI.Desc.ShaderType            = SHADER_TYPE_COMPUTE;
+        ShaderCI.EntryPoint                 = "main";
+        ShaderCI.Desc.Name                  = Name;
+
+        RefCntAutoPtr<IShader> pShader;
+        pEnv->GetDevice()->CreateShader(ShaderCI, &pShader);
+        return pShader;
+    }
+
+    static RefCntAutoPtr<IPipelineState> CreatePSO(const std::vector<SpecializationConstant>& SpecConsts, IShader* pCS = sm_pCS)
+    {
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name                               = "Specialization constants test";
+        PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+        PSOCreateInfo.pCS                                        = pCS;
+        PSOCreateInfo.NumSpecializationConstants                 = static_cast<Uint32>(SpecConsts.size());
+        PSOCreateInfo.pSpecializationConstants                   = SpecConsts.data();
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        TestingEnvironment::GetInstance()->GetDevice()->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+        return pPSO;
+    }
+
+    static void RunAndVerify(IPipelineState* pPSO, const float (&RefValues)[4])
+    {
+        auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+        pPSO->CreateShaderResourceBinding(&pSRB, true);
+        ASSERT_NE(pSRB, nullptr);
+        pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(sm_pBuffer->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+        pContext->SetPipelineState(pPSO);
+        pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+
+        pContext->CopyBuffer(sm_pBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                             sm_pStagingBuffer, 0, sizeof(RefValues), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->WaitForIdle();
+
+        void* pData = nullptr;
+        pContext->MapBuffer(sm_pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+        ASSERT_NE(pData, nullptr);
+        const auto* pValues = static_cast<const float*>(pData);
+        for (size_t i = 0; i < _countof(RefValues); ++i)
+            EXPECT_EQ(pValues[i], RefValues[i]) << "i: " << i;
+        pContext->UnmapBuffer(sm_pStagingBuffer, MAP_READ);
+    }
+
+    static RefCntAutoPtr<IShader> sm_pCS;
+    static RefCntAutoPtr<IBuffer> sm_pBuffer;
+    static RefCntAutoPtr<IBuffer> sm_pStagingBuffer;
+};
+
+RefCntAutoPtr<IShader> SpecializationConstantsTest::sm_pCS;
+RefCntAutoPtr<IBuffer> SpecializationConstantsTest::sm_pBuffer;
+RefCntAutoPtr<IBuffer> SpecializationConstantsTest::sm_pStagingBuffer;
+
+TEST_F(SpecializationConstantsTest, DefaultValues)
+{
+    auto pPSO = CreatePSO({});
+    ASSERT_NE(pPSO, nullptr);
+    RunAndVerify(pPSO, {1, -1, 0, 0});
+}
+
+TEST_F(SpecializationConstantsTest, SpecializedValues)
+{
+    // The same shader is used by all pipelines
+    for (Uint32 i = 0; i < 4; ++i)
+    {
+        const float  Scale  = 0.25f * static_cast<float>(i + 1);
+        const Int32  Offset = -17 * static_cast<Int32>(i);
+        const Uint32 Mask   = 0x10u << i;
+        const Uint32 Negate = i & 0x01u;
+
+        std::vector<SpecializationConstant> SpecConsts //
+            {
+                {"c_Scale", SHADER_TYPE_COMPUTE, sizeof(Scale), &Scale},
+                {"c_Offset", SHADER_TYPE_COMPUTE, sizeof(Offset), &Offset},
+                {"c_Mask", SHADER_TYPE_COMPUTE, sizeof(Mask), &Mask},
+                {"c_Negate", SHADER_TYPE_COMPUTE, sizeof(Negate), &Negate},
+            };
+        auto pPSO = CreatePSO(SpecConsts);
+        ASSERT_NE(pPSO, nullptr);
+        RunAndVerify(pPSO, {Scale, static_cast<float>(Offset), static_cast<float>(Mask), Negate != 0 ? 1.f : 0.f});
+    }
+}
+
+TEST_F(SpecializationConstantsTest, PartialSpecialization)
+{
+    const float Scale = 3.5f;
+    const float Dummy = 7.f;
+
+    std::vector<SpecializationConstant> SpecConsts //
+        {
+            {"c_Scale", SHADER_TYPE_COMPUTE, sizeof(Scale), &Scale},
+            // Constants that are not used by the shader stage or not declared by the shader are ignored
+            {"c_Offset", SHADER_TYPE_PIXEL, sizeof(Dummy), &Dummy},
+            {"c_Unknown", SHADER_TYPE_COMPUTE, sizeof(Dummy), &Dummy},
+        };
+    auto pPSO = CreatePSO(SpecConsts);
+    ASSERT_NE(pPSO, nullptr);
+    RunAndVerify(pPSO, {Scale, -1, 0, 0});
+}
+
+TEST_F(SpecializationConstantsTest, CommentedOutDeclaration)
+{
+    auto pCS = CreateShader(g_CommentedOutDeclarationShaderSource, "Specialization constants test - commented-out declaration");
+    ASSERT_NE(pCS, nullptr);
+
+    const float Scale = 2.5f;
+
+    std::vector<SpecializationConstant> SpecConsts //
+        {
+            {"c_Scale", SHADER_TYPE_COMPUTE, sizeof(Scale), &Scale},
+        };
+    auto pPSO = CreatePSO(SpecConsts, pCS);
+    ASSERT_NE(pPSO, nullptr);
+    RunAndVerify(pPSO, {Scale, 0, 0, 0});
+}
+
+// OpenGL emulates specialization constants by patching the source and only supports
+// single-line declarations of the form 'layout(constant_id = N) const Type Name = Value;'
+TEST_F(SpecializationConstantsTest, UnsupportedDeclarations)
+{
+    auto* pEnv = TestingEnvironment::GetInstance();
+    if (!pEnv->GetDevice()->GetDeviceInfo().IsGLDevice())
+    {
+        GTEST_SKIP() << "Declaration restrictions only apply to OpenGL";
+    }
+
+    static const char* const UnsupportedDeclarations[] = //
+        {
+            // Declaration spans multiple lines
+            "layout(constant_id = 0)\nconst int c_Value = 1;",
+            "layout(constant_id = 0) const int c_Value =\n    1;",
+            // Constant id is not a literal
+            "#define VALUE_ID 0\nlayout(constant_id = VALUE_ID) const int c_Value = 1;",
+            // Precision qualifier
+            "layout(constant_id = 0) const highp int c_Value = 1;",
+            // Non-scalar type
+            "layout(constant_id = 0) const ivec2 c_Value = ivec2(1, 2);",
+            // Multiple declarators
+            "layout(constant_id = 0) const int c_Value = 1, c_Other = 2;",
+        };
+
+    for (const auto* Decl : UnsupportedDeclarations)
+    {
+        const auto Source = std::string{Decl} + g_UnsupportedDeclarationShaderBody;
+
+        pEnv->SetErrorAllowance(2, "Errors below are expected: testing unsupported specialization constant declaration\n");
+        auto pCS = CreateShader(Source.c_str(), "Specialization constants test - unsupported declaration");
+        EXPECT_EQ(pCS, nullptr) << Decl;
+        pEnv->SetErrorAllowance(0);
+    }
+}
+
+TEST_F(SpecializationConstantsTest, SizeMismatch)
+{
+    const Uint8 Offset = 1;
+
+    std::vector<SpecializationConstant> SpecConsts //
+        {
+            {"c_Offset", SHADER_TYPE_COMPUTE, sizeof(Offset), &Offset},
+        };
+
+    auto* pEnv = TestingEnvironment::GetInstance();
+    pEnv->SetErrorAllowance(2, "Errors below are expected: testing specialization constant size mismatch\n");
+    auto pPSO = CreatePSO(SpecConsts);
+    EXPECT_EQ(pPSO, nullptr);
+    pEnv->SetErrorAllowance(0);
+}
+
+} // namespace
@@ -0,0 +1,221 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "DeviceContextVk.h"
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+class BarrierMergingVk : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        auto* pEnv    = TestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+        if (!pDevice->GetDeviceInfo().IsVulkanDevice())
+        {
+            GTEST_SKIP() << "Barrier statistics are only available in Vulkan";
+        }
+
+        m_pContextVk = RefCntAutoPtr<IDeviceContextVk>{pEnv->GetDeviceContext(), IID_DeviceContextVk};
+        ASSERT_TRUE(m_pContextVk);
+    }
+
+    void TearDown() override
+    {
+        if (m_pContextVk)
+            m_pContextVk->Flush();
+        m_pContextVk.Release();
+    }
+
+    // Flushes all pending barriers and resets the statistics
+    void BeginTransitions()
+    {
+        m_pContextVk->GetVkCommandBuffer();
+        m_pContextVk->ResetBarrierStatistics();
+    }
+
+    // Flushes all pending barriers and returns the statistics
+    BarrierStatisticsVk EndTransitions()
+    {
+        // GetVkCommandBuffer() flushes pending barriers
+        m_pContextVk->GetVkCommandBuffer();
+        return m_pContextVk->GetBarrierStatistics();
+    }
+
+    RefCntAutoPtr<ITexture> CreateTexture(const char* Name, Uint32 MipLevels, BIND_FLAGS BindFlags)
+    {
+        TextureDesc TexDesc;
+        TexDesc.Name      = Name;
+        TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+        TexDesc.Width     = 256;
+        TexDesc.Height    = 256;
+        TexDesc.MipLevels = MipLevels;
+        TexDesc.BindFlags = BindFlags;
+        TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+
+        RefCntAutoPtr<ITexture> pTexture;
+        TestingEnvironment::GetInstance()->GetDevice()->CreateTexture(TexDesc, nullptr, &pTexture);
+        return pTexture;
+    }
+
+    RefCntAutoPtr<IBuffer> CreateBuffer(const char* Name)
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name      = Name;
+        BuffDesc.Size      = 1024;
+        BuffDesc.BindFlags = BIND_VERTEX_BUFFER | BIND_UNIFORM_BUFFER;
+        BuffDesc.Usage     = USAGE_DEFAULT;
+
+        RefCntAutoPtr<IBuffer> pBuffer;
+        TestingEnvironment::GetInstance()->GetDevice()->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+        return pBuffer;
+    }
+
+    void Transition(IDeviceObject* pResource, RESOURCE_STATE OldState, RESOURCE_STATE NewState)
+    {
+        StateTransitionDesc Barrier;
+        Barrier.pResource = pResource;
+        Barrier.OldState  = OldState;
+        Barrier.NewState  = NewState;
+        Barrier.Flags     = STATE_TRANSITION_FLAG_UPDATE_STATE;
+        m_pContextVk->TransitionResourceStates(1, &Barrier);
+    }
+
+    RefCntAutoPtr<IDeviceContextVk> m_pContextVk;
+};
+
+// Transitions of adjacent mip levels with the same layouts are combined into a single image barrier.
+TEST_F(BarrierMergingVk, AdjacentSubresources)
+{
+    constexpr Uint32 MipLevels = 4;
+
+    auto pTexture = CreateTexture("Barrier merging test texture", MipLevels, BIND_SHADER_RESOURCE);
+    ASSERT_NE(pTexture, nullptr);
+
+    Transition(pTexture, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_COPY_DEST);
+    BeginTransitions();
+
+    for (Uint32 Mip = 0; Mip < MipLevels; ++Mip)
+    {
+        const StateTransitionDesc Barrier{pTexture, RESOURCE_STATE_COPY_DEST, RESOURCE_STATE_SHADER_RESOURCE, Mip, 1};
+        m_pContextVk->TransitionResourceStates(1, &Barrier);
+    }
+    pTexture->SetState(RESOURCE_STATE_SHADER_RESOURCE);
+
+    const auto Stats = EndTransitions();
+    EXPECT_EQ(Stats.PipelineBarrierCount, 1u);
+    EXPECT_EQ(Stats.ImageBarrierCount, 1u);
+    EXPECT_EQ(Stats.MergedBarrierCount, MipLevels - 1);
+    EXPECT_EQ(Stats.ElidedBarrierCount, 0u);
+}
+
+// Consecutive transitions of the same subresources (A -> B, B -> C) are replaced with a single A -> C barrier.
+TEST_F(BarrierMergingVk, ConsecutiveTransitions)
+{
+    auto pTexture = CreateTexture("Barrier merging test texture", 1, BIND_SHADER_RESOURCE);
+    ASSERT_NE(pTexture, nullptr);
+
+    Transition(pTexture, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_COPY_DEST);
+    BeginTransitions();
+
+    Transition(pTexture, RESOURCE_STATE_COPY_DEST, RESOURCE_STATE_SHADER_RESOURCE);
+    Transition(pTexture, RESOURCE_STATE_SHADER_RESOURCE, RESOURCE_STATE_COPY_SOURCE);
+
+    const auto Stats = EndTransitions();
+    EXPECT_EQ(Stats.PipelineBarrierCount, 1u);
+    EXPECT_EQ(Stats.ImageBarrierCount, 1u);
+    EXPECT_EQ(Stats.MergedBarrierCount, 1u);
+    EXPECT_EQ(Stats.ElidedBarrierCount, 0u);
+}
+
+// Buffer transitions are combined into a single global memory barrier.
+TEST_F(BarrierMergingVk, BufferTransitions)
+{
+    auto pBuffer0 = CreateBuffer("Barrier merging test buffer 0");
+    auto pBuffer1 = CreateBuffer("Barrier merging test buffer 1");
+    ASSERT_TRUE(pBuffer0 && pBuffer1);
+
+    Transition(pBuffer0, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_COPY_DEST);
+    Transition(pBuffer1, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_COPY_DEST);
+    BeginTransitions();
+
+    Transition(pBuffer0, RESOURCE_STATE_COPY_DEST, RESOURCE_STATE_VERTEX_BUFFER);
+    Transition(pBuffer1, RESOURCE_STATE_COPY_DEST, RESOURCE_STATE_CONSTANT_BUFFER);
+
+    const auto Stats = EndTransitions();
+    EXPECT_EQ(Stats.PipelineBarrierCount, 1u);
+    EXPECT_EQ(Stats.ImageBarrierCount, 0u);
+    EXPECT_EQ(Stats.MemoryBarrierCount, 1u);
+    EXPECT_EQ(Stats.MergedBarrierCount, 1u);
+    EXPECT_EQ(Stats.ElidedBarrierCount, 0u);
+}
+
+// Read-to-read transitions and duplicates of pending transitions do not produce barriers.
+TEST_F(BarrierMergingVk, RedundantBarriers)
+{
+    auto pTexture = CreateTexture("Barrier elision test texture", 1, BIND_SHADER_RESOURCE | BIND_INPUT_ATTACHMENT);
+    auto pBuffer  = CreateBuffer("Barrier elision test buffer");
+    ASSERT_TRUE(pTexture && pBuffer);
+
+    Transition(pTexture, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE);
+    Transition(pBuffer, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_VERTEX_BUFFER);
+    BeginTransitions();
+
+    // Both states use VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL layout
+    Transition(pTexture, RESOURCE_STATE_SHADER_RESOURCE, RESOURCE_STATE_INPUT_ATTACHMENT);
+    Transition(pBuffer, RESOURCE_STATE_VERTEX_BUFFER, RESOURCE_STATE_CONSTANT_BUFFER);
+
+    auto Stats = EndTransitions();
+    EXPECT_EQ(Stats.PipelineBarrierCount, 0u);
+    EXPECT_EQ(Stats.ImageBarrierCount, 0u);
+    EXPECT_EQ(Stats.MemoryBarrierCount, 0u);
+    EXPECT_EQ(Stats.ElidedBarrierCount, 2u);
+
+    BeginTransitions();
+
+    // The same transition of the same subresources is recorded twice
+    const StateTransitionDesc Barrier{pTexture, RESOURCE_STATE_INPUT_ATTACHMENT, RESOURCE_STATE_COPY_SOURCE};
+    m_pContextVk->TransitionResourceStates(1, &Barrier);
+    m_pContextVk->TransitionResourceStates(1, &Barrier);
+    pTexture->SetState(RESOURCE_STATE_COPY_SOURCE);
+
+    Stats = EndTransitions();
+    EXPECT_EQ(Stats.PipelineBarrierCount, 1u);
+    EXPECT_EQ(Stats.ImageBarrierCount, 1u);
+    EXPECT_EQ(Stats.MergedBarrierCount, 0u);
+    EXPECT_EQ(Stats.ElidedBarrierCount, 1u);
+}
+
+} // namespace
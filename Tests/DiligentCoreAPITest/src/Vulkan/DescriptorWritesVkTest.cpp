@@ -0,0 +1,263 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char g_ShaderSource[] = R"(
+cbuffer cbStatic
+{
+    uint4 g_Static;
+};
+
+cbuffer cbMutable
+{
+    uint4 g_Mutable;
+};
+
+#if USE_EXTRA
+cbuffer cbExtra
+{
+    uint4 g_Extra;
+};
+#endif
+
+RWStructuredBuffer<uint4> g_Output;
+
+[numthreads(1, 1, 1)]
+void main()
+{
+    uint4 Value = g_Static + g_Mutable;
+#if USE_EXTRA
+    Value += g_Extra;
+#endif
+    g_Output[0] = Value;
+}
+)";
+
+// Static and mutable descriptors in Vulkan are not written when the resources are bound.
+// The set is written when the SRB is committed, with a descriptor update template if all
+// descriptors in the set are bound, and with vkUpdateDescriptorSets otherwise.
+class DescriptorWritesVk : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+        if (!pDevice->GetDeviceInfo().IsVulkanDevice())
+        {
+            GTEST_SKIP() << "Deferred descriptor writes are only used in Vulkan";
+        }
+    }
+
+    void TearDown() override
+    {
+        TestingEnvironment::GetInstance()->Reset();
+    }
+
+    static RefCntAutoPtr<IBuffer> CreateConstantBuffer(const char* Name, const Uint32 (&Value)[4])
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name      = Name;
+        BuffDesc.Size      = sizeof(Value);
+        BuffDesc.Usage     = USAGE_IMMUTABLE;
+        BuffDesc.BindFlags = BIND_UNIFORM_BUFFER;
+
+        BufferData InitData{Value, sizeof(Value)};
+
+        RefCntAutoPtr<IBuffer> pBuffer;
+        TestingEnvironment::GetInstance()->GetDevice()->CreateBuffer(BuffDesc, &InitData, &pBuffer);
+        return pBuffer;
+    }
+
+    static RefCntAutoPtr<IPipelineState> CreatePSO(IPipelineResourceSignature* pSignature, bool UseExtra)
+    {
+        auto* pEnv    = TestingEnvironment::GetInstance();
+        auto* pDevice = pEnv->GetDevice();
+
+        ShaderMacro Macros[] = {{"USE_EXTRA", UseExtra ? "1" : "0"}, {}};
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.Source                     = g_ShaderSource;
+        ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.UseCombinedTextureSamplers = true;
+        ShaderCI.Desc.ShaderType            = SHADER_TYPE_COMPUTE;
+        ShaderCI.EntryPoint                 = "main";
+        ShaderCI.Desc.Name                  = UseExtra ? "Descriptor writes test CS (extra)" : "Descriptor writes test CS";
+        ShaderCI.Macros                     = Macros;
+
+        RefCntAutoPtr<IShader> pCS;
+        pDevice->CreateShader(ShaderCI, &pCS);
+        if (!pCS)
+            return {};
+
+        IPipelineResourceSignature* ppSignatures[] = {pSignature};
+
+        ComputePipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name            = ShaderCI.Desc.Name;
+        PSOCreateInfo.pCS                     = pCS;
+        PSOCreateInfo.ppResourceSignatures    = ppSignatures;
+        PSOCreateInfo.ResourceSignaturesCount = _countof(ppSignatures);
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+        return pPSO;
+    }
+
+    static void DispatchAndVerify(IPipelineState*         pPSO,
+                                  IShaderResourceBinding* pSRB,
+                                  IBuffer*                pOutput,
+                                  IBuffer*                pStaging,
+                                  const Uint32 (&RefValue)[4])
+    {
+        auto* pContext = TestingEnvironment::GetInstance()->GetDeviceContext();
+
+        pContext->SetPipelineState(pPSO);
+        pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->DispatchCompute(DispatchComputeAttribs{1, 1, 1});
+
+        pContext->CopyBuffer(pOutput, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                             pStaging, 0, sizeof(RefValue), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->WaitForIdle();
+
+        void* pData = nullptr;
+        pContext->MapBuffer(pStaging, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+        ASSERT_NE(pData, nullptr);
+        const auto* pValue = static_cast<const Uint32*>(pData);
+        for (size_t i = 0; i < _countof(RefValue); ++i)
+            EXPECT_EQ(pValue[i], RefValue[i]) << "i: " << i;
+        pContext->UnmapBuffer(pStaging, MAP_READ);
+    }
+};
+
+// Binds the resources, commits the SRB while one descriptor is unbound (vkUpdateDescriptorSets path),
+// then binds the remaining resource and commits the SRB again (descriptor update template path).
+TEST_F(DescriptorWritesVk, BindAfterCommit)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    // clang-format off
+    const PipelineResourceDesc Resources[] =
+    {
+        {SHADER_TYPE_COMPUTE, "cbStatic",  1, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_STATIC},
+        {SHADER_TYPE_COMPUTE, "cbMutable", 1, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+        {SHADER_TYPE_COMPUTE, "cbExtra",   1, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+        {SHADER_TYPE_COMPUTE, "g_Output",  1, SHADER_RESOURCE_TYPE_BUFFER_UAV,      SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE}
+    };
+    // clang-format on
+
+    PipelineResourceSignatureDesc PRSDesc;
+    PRSDesc.Name                       = "Descriptor writes test signature";
+    PRSDesc.Resources                  = Resources;
+    PRSDesc.NumResources               = _countof(Resources);
+    PRSDesc.UseCombinedTextureSamplers = true;
+
+    RefCntAutoPtr<IPipelineResourceSignature> pSignature;
+    pDevice->CreatePipelineResourceSignature(PRSDesc, &pSignature);
+    ASSERT_NE(pSignature, nullptr);
+
+    // The first pipeline does not use cbExtra, so it may remain unbound
+    auto pPSO = CreatePSO(pSignature, false);
+    ASSERT_NE(pPSO, nullptr);
+    auto pPSOExtra = CreatePSO(pSignature, true);
+    ASSERT_NE(pPSOExtra, nullptr);
+
+    const Uint32 StaticValue[4]  = {1, 2, 3, 4};
+    const Uint32 MutableValue[4] = {10, 20, 30, 40};
+    const Uint32 ExtraValue[4]   = {100, 200, 300, 400};
+
+    auto pStaticCB  = CreateConstantBuffer("Descriptor writes test - static CB", StaticValue);
+    auto pMutableCB = CreateConstantBuffer("Descriptor writes test - mutable CB", MutableValue);
+    auto pExtraCB   = CreateConstantBuffer("Descriptor writes test - extra CB", ExtraValue);
+    ASSERT_TRUE(pStaticCB && pMutableCB && pExtraCB);
+
+    RefCntAutoPtr<IBuffer> pOutput;
+    RefCntAutoPtr<IBuffer> pStaging;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name              = "Descriptor writes test - output";
+        BuffDesc.Size              = sizeof(Uint32) * 4;
+        BuffDesc.BindFlags         = BIND_UNORDERED_ACCESS;
+        BuffDesc.Mode              = BUFFER_MODE_STRUCTURED;
+        BuffDesc.ElementByteStride = sizeof(Uint32) * 4;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pOutput);
+        ASSERT_NE(pOutput, nullptr);
+
+        BuffDesc.Name           = "Descriptor writes test - staging";
+        BuffDesc.Usage          = USAGE_STAGING;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        BuffDesc.BindFlags      = BIND_NONE;
+        BuffDesc.Mode           = BUFFER_MODE_UNDEFINED;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pStaging);
+        ASSERT_NE(pStaging, nullptr);
+    }
+
+    pSignature->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "cbStatic")->Set(pStaticCB);
+
+    // Static resources are copied to the SRB, which defers the descriptor writes until the first commit
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pSignature->CreateShaderResourceBinding(&pSRB, true);
+    ASSERT_NE(pSRB, nullptr);
+
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "cbMutable")->Set(pMutableCB);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "g_Output")->Set(pOutput->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS));
+
+    {
+        const Uint32 RefValue[4] = {11, 22, 33, 44};
+        DispatchAndVerify(pPSO, pSRB, pOutput, pStaging, RefValue);
+    }
+
+    // Binding a resource after the set has been written must write the set again on the next commit
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "cbExtra")->Set(pExtraCB);
+    {
+        const Uint32 RefValue[4] = {111, 222, 333, 444};
+        DispatchAndVerify(pPSOExtra, pSRB, pOutput, pStaging, RefValue);
+    }
+
+    // Binding the same resources again is a no-op; the descriptors must remain valid
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "cbMutable")->Set(pMutableCB);
+    pSRB->GetVariableByName(SHADER_TYPE_COMPUTE, "cbExtra")->Set(pExtraCB);
+    {
+        const Uint32 RefValue[4] = {111, 222, 333, 444};
+        DispatchAndVerify(pPSOExtra, pSRB, pOutput, pStaging, RefValue);
+    }
+    {
+        const Uint32 RefValue[4] = {11, 22, 33, 44};
+        DispatchAndVerify(pPSO, pSRB, pOutput, pStaging, RefValue);
+    }
+}
+
+} // namespace
@@ -0,0 +1,306 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "RenderDeviceVk.h"
+#include "DeviceContextVk.h"
+#include "BufferVk.h"
+#include "TextureVk.h"
+#include "TextureViewVk.h"
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+// Returns the total number of device-local memory pages
+Uint32 GetNumDeviceLocalPages(IRenderDeviceVk* pDeviceVk)
+{
+    Uint32 NumMemoryTypes = 0;
+    pDeviceVk->GetMemoryStatistics(NumMemoryTypes, nullptr);
+    std::vector<DeviceMemoryStatsVk> Stats(NumMemoryTypes);
+    pDeviceVk->GetMemoryStatistics(NumMemoryTypes, Stats.data());
+
+    Uint32 NumPages = 0;
+    for (Uint32 i = 0; i < NumMemoryTypes; ++i)
+    {
+        if (!Stats[i].IsHostVisible)
+            NumPages += Stats[i].NumPages;
+    }
+    return NumPages;
+}
+
+TEST(MemoryDefragmentationVk, Buffers)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().IsVulkanDevice())
+    {
+        GTEST_SKIP() << "Memory defragmentation is only supported in Vulkan";
+    }
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto* pContext = pEnv->GetDeviceContext();
+
+    RefCntAutoPtr<IRenderDeviceVk>  pDeviceVk{pDevice, IID_RenderDeviceVk};
+    RefCntAutoPtr<IDeviceContextVk> pContextVk{pContext, IID_DeviceContextVk};
+    ASSERT_TRUE(pDeviceVk && pContextVk);
+
+    constexpr Uint32 NumBuffers    = 64;
+    constexpr Uint32 BufferSize    = 1 << 20;
+    constexpr Uint32 NumBufferInts = BufferSize / sizeof(Uint32);
+
+    std::vector<Uint32> RefData(NumBufferInts);
+
+    std::vector<RefCntAutoPtr<IBuffer>> Buffers(NumBuffers);
+    for (Uint32 i = 0; i < NumBuffers; ++i)
+    {
+        for (Uint32 j = 0; j < NumBufferInts; ++j)
+            RefData[j] = i * NumBufferInts + j;
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name      = "Defragmentation test buffer";
+        BuffDesc.Usage     = USAGE_DEFAULT;
+        BuffDesc.BindFlags = BIND_VERTEX_BUFFER;
+        BuffDesc.Size      = BufferSize;
+
+        BufferData InitData{RefData.data(), BufferSize};
+        pDevice->CreateBuffer(BuffDesc, &InitData, &Buffers[i]);
+        ASSERT_NE(Buffers[i], nullptr);
+    }
+
+    // Release three out of every four buffers to leave the pages sparsely occupied
+    for (Uint32 i = 0; i < NumBuffers; ++i)
+    {
+        if (i % 4 != 0)
+            Buffers[i].Release();
+    }
+    pContext->Flush();
+    pDevice->IdleGPU();
+
+    const auto NumPagesBefore = GetNumDeviceLocalPages(pDeviceVk);
+
+    std::vector<VkBuffer> vkBuffersBefore(NumBuffers);
+    for (Uint32 i = 0; i < NumBuffers; i += 4)
+        vkBuffersBefore[i] = Buffers[i].Cast<IBufferVk>(IID_BufferVk)->GetVkBuffer();
+
+    // Move at most four buffers per call to spread the copies over several frames
+    MemoryDefragmentationAttribsVk DefragAttribs;
+    DefragAttribs.MaxPageOccupancy = 0.5f;
+    DefragAttribs.MaxBytesToMove   = BufferSize * 4;
+
+    MemoryDefragmentationStatsVk DefragStats;
+    Uint32                       NumCalls              = 0;
+    Uint32                       NumRelocatedResources = 0;
+    Uint64                       BytesMoved            = 0;
+    do
+    {
+        pContextVk->DefragmentMemory(DefragAttribs, &DefragStats);
+        ++NumCalls;
+        EXPECT_LE(DefragStats.BytesMoved, DefragAttribs.MaxBytesToMove);
+        NumRelocatedResources += DefragStats.NumRelocatedResources;
+        BytesMoved += DefragStats.BytesMoved;
+        pContext->FinishFrame();
+    } while (!DefragStats.IsComplete && NumCalls < NumBuffers);
+    EXPECT_TRUE(DefragStats.IsComplete);
+    EXPECT_GT(NumCalls, 1u);
+    EXPECT_GT(DefragStats.NumEvacuatedPages, 0u);
+    EXPECT_GT(NumRelocatedResources, 0u);
+    EXPECT_GT(BytesMoved, 0u);
+
+    // The evacuated pages are destroyed once the old buffers have been released
+    pContext->Flush();
+    pDevice->IdleGPU();
+    pDevice->ReleaseStaleResources();
+
+    const auto NumPagesAfter = GetNumDeviceLocalPages(pDeviceVk);
+    EXPECT_LT(NumPagesAfter, NumPagesBefore);
+
+    Uint32 NumMovedBuffers = 0;
+    for (Uint32 i = 0; i < NumBuffers; i += 4)
+    {
+        if (Buffers[i].Cast<IBufferVk>(IID_BufferVk)->GetVkBuffer() != vkBuffersBefore[i])
+            ++NumMovedBuffers;
+    }
+    EXPECT_EQ(NumMovedBuffers, NumRelocatedResources);
+
+    // Verify that the contents of all remaining buffers have been preserved
+    BufferDesc StagingBuffDesc;
+    StagingBuffDesc.Name           = "Defragmentation test staging buffer";
+    StagingBuffDesc.Usage          = USAGE_STAGING;
+    StagingBuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+    StagingBuffDesc.Size           = BufferSize;
+
+    RefCntAutoPtr<IBuffer> pStagingBuffer;
+    pDevice->CreateBuffer(StagingBuffDesc, nullptr, &pStagingBuffer);
+    ASSERT_NE(pStagingBuffer, nullptr);
+
+    for (Uint32 i = 0; i < NumBuffers; i += 4)
+    {
+        pContext->CopyBuffer(Buffers[i], 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                             pStagingBuffer, 0, BufferSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->WaitForIdle();
+
+        void* pMappedData = nullptr;
+        pContext->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pMappedData);
+        ASSERT_NE(pMappedData, nullptr);
+        const auto* pData = static_cast<const Uint32*>(pMappedData);
+        for (Uint32 j = 0; j < NumBufferInts; ++j)
+        {
+            if (pData[j] != i * NumBufferInts + j)
+            {
+                ADD_FAILURE() << "Contents of buffer " << i << " have not been preserved";
+                break;
+            }
+        }
+        pContext->UnmapBuffer(pStagingBuffer, MAP_READ);
+    }
+}
+
+TEST(MemoryDefragmentationVk, Textures)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().IsVulkanDevice())
+    {
+        GTEST_SKIP() << "Memory defragmentation is only supported in Vulkan";
+    }
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto* pContext = pEnv->GetDeviceContext();
+
+    RefCntAutoPtr<IRenderDeviceVk>  pDeviceVk{pDevice, IID_RenderDeviceVk};
+    RefCntAutoPtr<IDeviceContextVk> pContextVk{pContext, IID_DeviceContextVk};
+    ASSERT_TRUE(pDeviceVk && pContextVk);
+
+    constexpr Uint32 NumTextures = 64;
+    constexpr Uint32 TexDim      = 512;
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Defragmentation test texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.Width     = TexDim;
+    TexDesc.Height    = TexDim;
+    TexDesc.Usage     = USAGE_DEFAULT;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+
+    std::vector<Uint32> TexData(TexDim * TexDim);
+
+    std::vector<RefCntAutoPtr<ITexture>> Textures(NumTextures);
+    for (Uint32 i = 0; i < NumTextures; ++i)
+    {
+        for (size_t j = 0; j < TexData.size(); ++j)
+            TexData[j] = i * 0x01010101u + static_cast<Uint32>(j);
+
+        TextureSubResData SubresData{TexData.data(), TexDim * sizeof(Uint32)};
+        TextureData       InitData{&SubresData, 1};
+        pDevice->CreateTexture(TexDesc, &InitData, &Textures[i]);
+        ASSERT_NE(Textures[i], nullptr);
+    }
+
+    // Release three out of every four textures to leave the pages sparsely occupied
+    for (Uint32 i = 0; i < NumTextures; ++i)
+    {
+        if (i % 4 != 0)
+            Textures[i].Release();
+    }
+    pContext->Flush();
+    pDevice->IdleGPU();
+
+    const auto NumPagesBefore = GetNumDeviceLocalPages(pDeviceVk);
+
+    std::vector<VkImageView> vkSRVsBefore(NumTextures);
+    for (Uint32 i = 0; i < NumTextures; i += 4)
+    {
+        RefCntAutoPtr<ITextureViewVk> pSRVVk{Textures[i]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE), IID_TextureViewVk};
+        vkSRVsBefore[i] = pSRVVk->GetVulkanImageView();
+    }
+
+    // Without the budget, all textures are moved by a single call
+    MemoryDefragmentationStatsVk DefragStats;
+    pContextVk->DefragmentMemory(MemoryDefragmentationAttribsVk{}, &DefragStats);
+    EXPECT_TRUE(DefragStats.IsComplete);
+    EXPECT_GT(DefragStats.NumEvacuatedPages, 0u);
+    EXPECT_GT(DefragStats.NumRelocatedResources, 0u);
+
+    pContext->Flush();
+    pDevice->IdleGPU();
+    pDevice->ReleaseStaleResources();
+
+    const auto NumPagesAfter = GetNumDeviceLocalPages(pDeviceVk);
+    EXPECT_LT(NumPagesAfter, NumPagesBefore);
+
+    Uint32 NumMovedTextures = 0;
+    for (Uint32 i = 0; i < NumTextures; i += 4)
+    {
+        // Default views must have been recreated for the new images
+        RefCntAutoPtr<ITextureViewVk> pSRVVk{Textures[i]->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE), IID_TextureViewVk};
+        if (pSRVVk->GetVulkanImageView() != vkSRVsBefore[i])
+            ++NumMovedTextures;
+    }
+    EXPECT_EQ(NumMovedTextures, DefragStats.NumRelocatedResources);
+
+    TextureDesc StagingTexDesc    = TexDesc;
+    StagingTexDesc.Name           = "Defragmentation test staging texture";
+    StagingTexDesc.Usage          = USAGE_STAGING;
+    StagingTexDesc.BindFlags      = BIND_NONE;
+    StagingTexDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    RefCntAutoPtr<ITexture> pStagingTex;
+    pDevice->CreateTexture(StagingTexDesc, nullptr, &pStagingTex);
+    ASSERT_NE(pStagingTex, nullptr);
+
+    for (Uint32 i = 0; i < NumTextures; i += 4)
+    {
+        CopyTextureAttribs CopyAttribs{Textures[i], RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStagingTex, RESOURCE_STATE_TRANSITION_MODE_TRANSITION};
+        pContext->CopyTexture(CopyAttribs);
+        pContext->WaitForIdle();
+
+        MappedTextureSubresource MappedData;
+        pContext->MapTextureSubresource(pStagingTex, 0, 0, MAP_READ, MAP_FLAG_DO_NOT_WAIT, nullptr, MappedData);
+        ASSERT_NE(MappedData.pData, nullptr);
+        bool DataPreserved = true;
+        for (Uint32 y = 0; y < TexDim && DataPreserved; ++y)
+        {
+            const auto* pRow = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(MappedData.pData) + y * MappedData.Stride);
+            for (Uint32 x = 0; x < TexDim && DataPreserved; ++x)
+                DataPreserved = pRow[x] == i * 0x01010101u + y * TexDim + x;
+        }
+        EXPECT_TRUE(DataPreserved) << "Contents of texture " << i << " have not been preserved";
+        pContext->UnmapTextureSubresource(pStagingTex, 0, 0);
+    }
+}
+
+} // namespace
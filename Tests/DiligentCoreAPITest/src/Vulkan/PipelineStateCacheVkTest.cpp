@@ -0,0 +1,224 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "RenderDeviceVk.h"
+#include "PipelineStateCacheVk.h"
+#include "ShaderVk.h"
+#include "TestingEnvironment.hpp"
+#include "Vulkan/TestingEnvironmentVk.hpp"
+#include "FileWrapper.hpp"
+#include "FileSystem.hpp"
+
+#include "volk/volk.h"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char g_ComputeShaderHLSL[] = R"(
+#include "PipelineStateCacheVkTest.h"
+
+RWTexture2D<float4> g_tex2DUAV;
+
+[numthreads(16, 16, 1)]
+void main(uint3 DTid : SV_DispatchThreadID)
+{
+    g_tex2DUAV[DTid.xy] = float4(float2(DTid.xy % 256u) / 256.0, CONST_VALUE, 1.0);
+}
+)";
+
+static const char g_IncludeFileName[] = "PipelineStateCacheVkTest.h";
+
+bool WriteIncludeFile(const char* Text)
+{
+    FileWrapper File{g_IncludeFileName, EFileAccessMode::Overwrite};
+    return File && File->Write(Text, strlen(Text));
+}
+
+std::vector<Uint8> GetVkPipelineCacheData(IPipelineStateCache* pCache)
+{
+    RefCntAutoPtr<IPipelineStateCacheVk> pCacheVk{pCache, IID_PipelineStateCacheVk};
+    VERIFY_EXPR(pCacheVk);
+
+    const auto vkDevice = TestingEnvironmentVk::GetInstance()->GetVkDevice();
+
+    size_t DataSize = 0;
+    if (vkGetPipelineCacheData(vkDevice, pCacheVk->GetVkPipelineCache(), &DataSize, nullptr) != VK_SUCCESS)
+        return {};
+
+    std::vector<Uint8> Data(DataSize);
+    if (vkGetPipelineCacheData(vkDevice, pCacheVk->GetVkPipelineCache(), &DataSize, Data.data()) != VK_SUCCESS)
+        return {};
+    Data.resize(DataSize);
+    return Data;
+}
+
+RefCntAutoPtr<IShader> CreateTestShader(IShaderSourceInputStreamFactory* pFactory, IPipelineStateCache* pCache)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Source                     = g_ComputeShaderHLSL;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.Desc.ShaderType            = SHADER_TYPE_COMPUTE;
+    ShaderCI.Desc.Name                  = "PSO cache Vk test CS";
+    ShaderCI.pShaderSourceStreamFactory = pFactory;
+    ShaderCI.pPSOCache                  = pCache;
+
+    RefCntAutoPtr<IShader> pShader;
+    pDevice->CreateShader(ShaderCI, &pShader);
+    return pShader;
+}
+
+RefCntAutoPtr<IPipelineState> CreateTestPSO(IShader* pCS, IPipelineStateCache* pCache)
+{
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name         = "PSO cache Vk test";
+    PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+    PSOCreateInfo.pCS                  = pCS;
+    PSOCreateInfo.pPSOCache            = pCache;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    TestingEnvironment::GetInstance()->GetDevice()->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    return pPSO;
+}
+
+// A blob returned by vkGetPipelineCacheData must be accepted as is
+TEST(PipelineStateCacheVkTest, RawDriverData)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().IsVulkanDevice())
+    {
+        GTEST_SKIP() << "This test is specific to Vulkan";
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    ASSERT_TRUE(WriteIncludeFile("#define CONST_VALUE 0.5\n"));
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory;
+    pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory(nullptr, &pFactory);
+    ASSERT_NE(pFactory, nullptr);
+
+    PipelineStateCacheCreateInfo CacheCI;
+    CacheCI.Desc.Name = "Vk PSO cache";
+
+    RefCntAutoPtr<IPipelineStateCache> pCache;
+    pDevice->CreatePipelineStateCache(CacheCI, &pCache);
+    ASSERT_NE(pCache, nullptr);
+
+    auto pCS = CreateTestShader(pFactory, nullptr);
+    ASSERT_NE(pCS, nullptr);
+    ASSERT_NE(CreateTestPSO(pCS, pCache), nullptr);
+
+    const auto RawData = GetVkPipelineCacheData(pCache);
+    ASSERT_FALSE(RawData.empty());
+
+    CacheCI.Desc.Name     = "Vk PSO cache with raw data";
+    CacheCI.pCacheData    = RawData.data();
+    CacheCI.CacheDataSize = static_cast<Uint32>(RawData.size());
+
+    RefCntAutoPtr<IPipelineStateCache> pRawCache;
+    pDevice->CreatePipelineStateCache(CacheCI, &pRawCache);
+    ASSERT_NE(pRawCache, nullptr);
+
+    // The driver keeps the pipelines from the initial data
+    EXPECT_GE(GetVkPipelineCacheData(pRawCache).size(), RawData.size());
+    EXPECT_NE(CreateTestPSO(pCS, pRawCache), nullptr);
+
+    FileSystem::DeleteFile(g_IncludeFileName);
+}
+
+// Shaders loaded from the cache must be identical to the compiled ones and
+// must be recompiled when any of the included files changes.
+TEST(PipelineStateCacheVkTest, ShaderCache)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().IsVulkanDevice())
+    {
+        GTEST_SKIP() << "This test is specific to Vulkan";
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    ASSERT_TRUE(WriteIncludeFile("#define CONST_VALUE 0.25\n"));
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory;
+    pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory(nullptr, &pFactory);
+    ASSERT_NE(pFactory, nullptr);
+
+    PipelineStateCacheCreateInfo CacheCI;
+    CacheCI.Desc.Name = "Vk shader cache";
+
+    RefCntAutoPtr<IPipelineStateCache> pColdCache;
+    pDevice->CreatePipelineStateCache(CacheCI, &pColdCache);
+    ASSERT_NE(pColdCache, nullptr);
+
+    RefCntAutoPtr<IShaderVk> pColdCS{CreateTestShader(pFactory, pColdCache), IID_ShaderVk};
+    ASSERT_NE(pColdCS, nullptr);
+    ASSERT_NE(CreateTestPSO(pColdCS, pColdCache), nullptr);
+
+    RefCntAutoPtr<IDataBlob> pCacheData;
+    pColdCache->GetData(&pCacheData);
+    ASSERT_NE(pCacheData, nullptr);
+
+    CacheCI.Desc.Name     = "Warm Vk shader cache";
+    CacheCI.pCacheData    = pCacheData->GetConstDataPtr();
+    CacheCI.CacheDataSize = static_cast<Uint32>(pCacheData->GetSize());
+
+    RefCntAutoPtr<IPipelineStateCache> pWarmCache;
+    pDevice->CreatePipelineStateCache(CacheCI, &pWarmCache);
+    ASSERT_NE(pWarmCache, nullptr);
+
+    RefCntAutoPtr<IShaderVk> pWarmCS{CreateTestShader(pFactory, pWarmCache), IID_ShaderVk};
+    ASSERT_NE(pWarmCS, nullptr);
+    EXPECT_EQ(pWarmCS->GetSPIRV(), pColdCS->GetSPIRV());
+    EXPECT_EQ(pWarmCS->GetResourceCount(), pColdCS->GetResourceCount());
+    // The pipeline is created from the cached byte code with remapped bindings
+    EXPECT_NE(CreateTestPSO(pWarmCS, pWarmCache), nullptr);
+
+    // Modified include file must invalidate the cached shader
+    ASSERT_TRUE(WriteIncludeFile("#define CONST_VALUE 0.75\n"));
+
+    RefCntAutoPtr<IShaderVk> pModifiedCS{CreateTestShader(pFactory, pWarmCache), IID_ShaderVk};
+    ASSERT_NE(pModifiedCS, nullptr);
+    EXPECT_NE(pModifiedCS->GetSPIRV(), pColdCS->GetSPIRV());
+    EXPECT_NE(CreateTestPSO(pModifiedCS, pWarmCache), nullptr);
+
+    FileSystem::DeleteFile(g_IncludeFileName);
+}
+
+} // namespace
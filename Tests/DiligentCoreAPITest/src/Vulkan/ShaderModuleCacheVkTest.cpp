@@ -0,0 +1,111 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "RenderDeviceVk.h"
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char g_ComputeShaderHLSL[] = R"(
+RWTexture2D<float4> g_tex2DUAV;
+
+[numthreads(16, 16, 1)]
+void main(uint3 DTid : SV_DispatchThreadID)
+{
+    g_tex2DUAV[DTid.xy] = float4(float2(DTid.xy % 256u) / 256.0, 0.0, 1.0);
+}
+)";
+
+TEST(ShaderModuleCacheVk, SharedShader)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().IsVulkanDevice())
+    {
+        GTEST_SKIP() << "Shader module cache is only used in Vulkan";
+    }
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    RefCntAutoPtr<IRenderDeviceVk> pDeviceVk{pDevice, IID_RenderDeviceVk};
+    ASSERT_TRUE(pDeviceVk);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Source          = g_ComputeShaderHLSL;
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler  = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderCI.Desc.Name       = "Shader module cache test CS";
+
+    RefCntAutoPtr<IShader> pCS;
+    pDevice->CreateShader(ShaderCI, &pCS);
+    ASSERT_TRUE(pCS);
+
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name         = "Shader module cache test PSO";
+    PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+    PSOCreateInfo.pCS                  = pCS;
+
+    RefCntAutoPtr<IPipelineState> pPSO1;
+    pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO1);
+    ASSERT_TRUE(pPSO1);
+
+    // The module may have been created by other tests, so only relative values are checked
+    const auto Stats1 = pDeviceVk->GetShaderModuleCacheStats();
+    EXPECT_GT(Stats1.NumModules, 0u);
+
+    // The second pipeline has the same layout and must reuse the module
+    RefCntAutoPtr<IPipelineState> pPSO2;
+    pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO2);
+    ASSERT_TRUE(pPSO2);
+
+    const auto Stats2 = pDeviceVk->GetShaderModuleCacheStats();
+    EXPECT_EQ(Stats2.NumHits, Stats1.NumHits + 1);
+    EXPECT_EQ(Stats2.NumMisses, Stats1.NumMisses);
+    EXPECT_EQ(Stats2.NumModules, Stats1.NumModules);
+
+    // Releasing the pipelines must not release the cached module
+    pPSO1.Release();
+    pPSO2.Release();
+    pEnv->ReleaseResources();
+
+    RefCntAutoPtr<IPipelineState> pPSO3;
+    pDevice->CreateComputePipelineState(PSOCreateInfo, &pPSO3);
+    ASSERT_TRUE(pPSO3);
+
+    const auto Stats3 = pDeviceVk->GetShaderModuleCacheStats();
+    EXPECT_EQ(Stats3.NumHits, Stats2.NumHits + 1);
+    EXPECT_EQ(Stats3.NumMisses, Stats2.NumMisses);
+}
+
+} // namespace
@@ -0,0 +1,190 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+
+#include "ShaderVk.h"
+#include "TestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char g_ReflectionTestHLSL[] = R"(
+cbuffer cbConstants
+{
+    float4x4 g_WorldViewProj;
+    float4   g_Color;
+};
+
+struct BufferData
+{
+    float4 Data;
+};
+
+Texture2D                    g_Texture;
+SamplerState                 g_Texture_sampler;
+StructuredBuffer<BufferData> g_Buffer;
+RWTexture2D<float4>          g_RWTexture;
+Texture2D                    g_TexArray[4];
+
+struct VSInput
+{
+    float3 Pos : ATTRIB0;
+    float2 UV  : ATTRIB3;
+};
+
+void VSMain(in VSInput VSIn, out float4 Pos : SV_Position, out float2 UV : TEXCOORD)
+{
+    Pos = mul(float4(VSIn.Pos, 1.0), g_WorldViewProj);
+    UV  = VSIn.UV;
+}
+
+float4 PSMain(in float4 Pos : SV_Position, in float2 UV : TEXCOORD) : SV_Target
+{
+    g_RWTexture[uint2(Pos.xy)] = g_Color;
+    return g_Texture.Sample(g_Texture_sampler, UV) * g_Buffer[0].Data + g_TexArray[2].Sample(g_Texture_sampler, UV);
+}
+)";
+
+RefCntAutoPtr<IShader> CreateTestShader(const ShaderCreateInfo& ShaderCI)
+{
+    RefCntAutoPtr<IShader> pShader;
+    TestingEnvironment::GetInstance()->GetDevice()->CreateShader(ShaderCI, &pShader);
+    return pShader;
+}
+
+void CompareShaderResources(IShader* pShader1, IShader* pShader2)
+{
+    ASSERT_EQ(pShader1->GetResourceCount(), pShader2->GetResourceCount());
+    for (Uint32 i = 0; i < pShader1->GetResourceCount(); ++i)
+    {
+        ShaderResourceDesc Desc1, Desc2;
+        pShader1->GetResourceDesc(i, Desc1);
+        pShader2->GetResourceDesc(i, Desc2);
+        EXPECT_STREQ(Desc1.Name, Desc2.Name);
+        EXPECT_EQ(Desc1.Type, Desc2.Type);
+        EXPECT_EQ(Desc1.ArraySize, Desc2.ArraySize);
+    }
+}
+
+void TestReflectionData(SHADER_TYPE ShaderType, const char* EntryPoint)
+{
+    auto* pEnv = TestingEnvironment::GetInstance();
+    if (!pEnv->GetDevice()->GetDeviceInfo().IsVulkanDevice())
+    {
+        GTEST_SKIP() << "Reflection data is only supported in Vulkan";
+    }
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Source                     = g_ReflectionTestHLSL;
+    ShaderCI.EntryPoint                 = EntryPoint;
+    ShaderCI.Desc.ShaderType            = ShaderType;
+    ShaderCI.Desc.Name                  = "Reflection data test";
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.UseCombinedTextureSamplers = true;
+
+    auto pRefShader = CreateTestShader(ShaderCI);
+    ASSERT_TRUE(pRefShader);
+    RefCntAutoPtr<IShaderVk> pRefShaderVk{pRefShader, IID_ShaderVk};
+    ASSERT_TRUE(pRefShaderVk);
+
+    RefCntAutoPtr<IDataBlob> pReflectionData;
+    pRefShaderVk->GetReflectionData(&pReflectionData);
+    ASSERT_TRUE(pReflectionData);
+    EXPECT_NE(pReflectionData->GetSize(), size_t{0});
+
+    const auto& SPIRV = pRefShaderVk->GetSPIRV();
+
+    ShaderCI.Source             = nullptr;
+    ShaderCI.EntryPoint         = nullptr;
+    ShaderCI.ByteCode           = SPIRV.data();
+    ShaderCI.ByteCodeSize       = SPIRV.size() * sizeof(SPIRV[0]);
+    ShaderCI.pReflectionData    = pReflectionData->GetConstDataPtr();
+    ShaderCI.ReflectionDataSize = pReflectionData->GetSize();
+
+    // Shader created from the reflection data
+    {
+        auto pShader = CreateTestShader(ShaderCI);
+        ASSERT_TRUE(pShader);
+        CompareShaderResources(pRefShader, pShader);
+
+        RefCntAutoPtr<IShaderVk> pShaderVk{pShader, IID_ShaderVk};
+        ASSERT_TRUE(pShaderVk);
+        EXPECT_EQ(pShaderVk->GetSPIRV(), SPIRV);
+
+        // Reflection data must round-trip
+        RefCntAutoPtr<IDataBlob> pReflectionData2;
+        pShaderVk->GetReflectionData(&pReflectionData2);
+        ASSERT_TRUE(pReflectionData2);
+        ASSERT_EQ(pReflectionData2->GetSize(), pReflectionData->GetSize());
+        EXPECT_EQ(memcmp(pReflectionData2->GetConstDataPtr(), pReflectionData->GetConstDataPtr(), pReflectionData->GetSize()), 0);
+    }
+
+    // Reflection data that does not match the byte code must be ignored
+    {
+        std::vector<uint32_t> ModifiedSPIRV{SPIRV};
+        // Change the generator magic number, which does not affect the shader
+        ModifiedSPIRV[2] ^= 0x1u;
+
+        auto ModifiedCI     = ShaderCI;
+        ModifiedCI.ByteCode = ModifiedSPIRV.data();
+
+        auto pShader = CreateTestShader(ModifiedCI);
+        ASSERT_TRUE(pShader);
+        CompareShaderResources(pRefShader, pShader);
+    }
+
+    // Truncated reflection data must be ignored
+    {
+        auto TruncatedCI = ShaderCI;
+        TruncatedCI.ReflectionDataSize -= 1;
+
+        auto pShader = CreateTestShader(TruncatedCI);
+        ASSERT_TRUE(pShader);
+        CompareShaderResources(pRefShader, pShader);
+    }
+}
+
+TEST(ShaderVk, ReflectionData_VS)
+{
+    TestReflectionData(SHADER_TYPE_VERTEX, "VSMain");
+}
+
+TEST(ShaderVk, ReflectionData_PS)
+{
+    TestReflectionData(SHADER_TYPE_PIXEL, "PSMain");
+}
+
+} // namespace
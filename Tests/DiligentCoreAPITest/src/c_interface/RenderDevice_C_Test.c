@@ -40,6 +40,7 @@ int TestRenderDeviceCInterface_Misc(struct IRenderDevice* pRenderDevice)
     TextureFormatInfo         TexFmtInfo;
     TextureFormatInfoExt      TexFmtInfoExt;
     IEngineFactory*           pFactory = NULL;
+    StateObjectsRegistryStats SamRegistryStats;
 
     int num_errors = TestObjectCInterface((struct IObject*)pRenderDevice);
 
@@ -80,6 +81,9 @@ int TestRenderDeviceCInterface_Misc(struct IRenderDevice* pRenderDevice)
     if (pFactory == NULL)
         ++num_errors;
 
+    SamRegistryStats = IRenderDevice_GetSamplerRegistryStats(pRenderDevice);
+    (void)SamRegistryStats;
+
     return num_errors;
 }
 
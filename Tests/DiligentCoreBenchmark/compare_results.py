@@ -0,0 +1,68 @@
+#!/usr/bin/env python
+"""Compares two JSON files produced by DiligentCoreBenchmark (--benchmark_out=<file>)
+and prints the relative change of the real time for every benchmark present in both files.
+Returns a non-zero exit code if any benchmark is slower than the threshold.
+"""
+
+from __future__ import print_function
+
+import argparse
+import json
+import sys
+
+
+def load_results(path):
+    with open(path) as f:
+        data = json.load(f)
+    results = {}
+    for bm in data.get("benchmarks", []):
+        name = bm["run_name"]
+        if bm.get("run_type") == "aggregate":
+            # When repetitions are used, compare medians
+            if bm.get("aggregate_name") == "median":
+                results[name] = bm
+        elif name not in results:
+            results[name] = bm
+    return data.get("context", {}), results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("baseline", help="baseline results")
+    parser.add_argument("contender", help="results to compare with the baseline")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="slowdown in percent that is reported as a regression (default: 5)")
+    args = parser.parse_args()
+
+    base_ctx, base = load_results(args.baseline)
+    new_ctx, new = load_results(args.contender)
+    if base_ctx.get("library_build_type") != new_ctx.get("library_build_type"):
+        print("Warning: comparing results of different build types")
+
+    names = [name for name in base if name in new]
+    if not names:
+        print("No common benchmarks found")
+        return 1
+
+    width = max(len(name) for name in names) + 2
+    print("{:<{w}}{:>15}{:>15}{:>10}".format("Benchmark", "Baseline, ns", "Contender, ns", "Change", w=width))
+    print("-" * (width + 40))
+
+    regressions = 0
+    for name in names:
+        old_time = base[name]["real_time"]
+        new_time = new[name]["real_time"]
+        change = (new_time - old_time) / old_time * 100.0 if old_time > 0 else 0.0
+        mark = ""
+        if change > args.threshold:
+            mark = "  <-- slower"
+            regressions += 1
+        elif change < -args.threshold:
+            mark = "  <-- faster"
+        print("{:<{w}}{:>15.1f}{:>15.1f}{:>+9.1f}%{}".format(name, old_time, new_time, change, mark, w=width))
+
+    return 1 if regressions > 0 else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,275 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Minimal micro-benchmarking framework.
+///
+/// The framework follows the model of Google Benchmark: a benchmark is a function that
+/// takes the State object and runs the measured code in a `while (State.KeepRunning())` loop.
+/// The runner calibrates the number of iterations so that each run takes at least the minimum
+/// time, and reports the results to the console and, optionally, to a JSON file that uses the
+/// Google Benchmark format and can be compared across commits with its tools (e.g. compare.py).
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <chrono>
+#include <ctime>
+#include <initializer_list>
+
+#if defined(_MSC_VER)
+#    include <intrin.h>
+#endif
+
+#include "BasicTypes.h"
+
+namespace Diligent
+{
+
+namespace Benchmark
+{
+
+/// Benchmark state that controls the iteration loop and timing.
+class State
+{
+public:
+    State(Uint64 MaxIterations, Int64 Arg) noexcept :
+        m_MaxIterations{MaxIterations},
+        m_Arg{Arg}
+    {}
+
+    // clang-format off
+    State           (const State&)  = delete;
+    State           (      State&&) = delete;
+    State& operator=(const State&)  = delete;
+    State& operator=(      State&&) = delete;
+    // clang-format on
+
+    /// Returns true while the benchmark should keep running. The timer is started
+    /// by the first call and is stopped when the function returns false.
+    bool KeepRunning()
+    {
+        if (m_Iteration < m_MaxIterations && m_SkipMessage.empty())
+        {
+            if (m_Iteration == 0)
+                ResumeTiming();
+            ++m_Iteration;
+            return true;
+        }
+
+        if (m_TimerRunning)
+            PauseTiming();
+        return false;
+    }
+
+    /// Stops the timer, e.g. to exclude the setup of the next iteration from the measurement.
+    void PauseTiming()
+    {
+        const auto RealTime = std::chrono::steady_clock::now();
+        const auto CPUTime  = std::clock();
+
+        m_RealTime += std::chrono::duration<double>(RealTime - m_RealStartTime).count();
+        m_CPUTime += static_cast<double>(CPUTime - m_CPUStartTime) / CLOCKS_PER_SEC;
+        m_TimerRunning = false;
+    }
+
+    /// Restarts the timer stopped by PauseTiming().
+    void ResumeTiming()
+    {
+        m_TimerRunning  = true;
+        m_CPUStartTime  = std::clock();
+        m_RealStartTime = std::chrono::steady_clock::now();
+    }
+
+    /// Skips the benchmark. The iteration loop will exit at the next KeepRunning() call.
+    void SkipWithMessage(std::string Message)
+    {
+        m_SkipMessage = Message.empty() ? "skipped" : std::move(Message);
+    }
+
+    /// Sets the number of items processed by the whole run, which is reported as items per second.
+    void SetItemsProcessed(Uint64 NumItems) { m_ItemsProcessed = NumItems; }
+
+    /// Sets the number of bytes processed by the whole run, which is reported as bytes per second.
+    void SetBytesProcessed(Uint64 NumBytes) { m_BytesProcessed = NumBytes; }
+
+    using CountersType = std::vector<std::pair<std::string, double>>;
+
+    /// Sets the user-defined counter, e.g. the number of allocations per iteration.
+    /// Counters are reported as is, next to the run time.
+    void SetCounter(const char* Name, double Value)
+    {
+        for (auto& Counter : m_Counters)
+        {
+            if (Counter.first == Name)
+            {
+                Counter.second = Value;
+                return;
+            }
+        }
+        m_Counters.emplace_back(Name, Value);
+    }
+
+    // clang-format off
+    Int64  GetArg()            const { return m_Arg; }
+    Uint64 GetIterations()     const { return m_Iteration; }
+    Uint64 GetMaxIterations()  const { return m_MaxIterations; }
+    double GetRealTime()       const { return m_RealTime; }
+    double GetCPUTime()        const { return m_CPUTime; }
+    Uint64 GetItemsProcessed() const { return m_ItemsProcessed; }
+    Uint64 GetBytesProcessed() const { return m_BytesProcessed; }
+
+    const std::string&  GetSkipMessage() const { return m_SkipMessage; }
+    const CountersType& GetCounters()    const { return m_Counters; }
+    // clang-format on
+
+private:
+    const Uint64 m_MaxIterations;
+    const Int64  m_Arg;
+
+    Uint64 m_Iteration = 0;
+
+    bool                                  m_TimerRunning = false;
+    std::chrono::steady_clock::time_point m_RealStartTime;
+    std::clock_t                          m_CPUStartTime = 0;
+
+    double m_RealTime = 0;
+    double m_CPUTime  = 0;
+
+    Uint64 m_ItemsProcessed = 0;
+    Uint64 m_BytesProcessed = 0;
+
+    CountersType m_Counters;
+
+    std::string m_SkipMessage;
+};
+
+using BenchmarkFunction = void (*)(State&);
+
+struct BenchmarkInfo
+{
+    std::string       Name;
+    BenchmarkFunction Func = nullptr;
+
+    /// Arguments to run the benchmark with. Every argument produces a separate
+    /// benchmark instance named "Name/Arg". If the list is empty, the benchmark
+    /// runs once with the argument equal to zero.
+    std::vector<Int64> Args;
+
+    /// Whether the benchmark requires the render device. Such benchmarks only run
+    /// when the device type is given in the command line (e.g. --mode=vk).
+    bool RequiresDevice = false;
+};
+
+/// Registers the benchmark. Returns the benchmark index.
+int RegisterBenchmark(const char* Name, BenchmarkFunction Func, std::initializer_list<Int64> Args = {}, bool RequiresDevice = false);
+
+const std::vector<BenchmarkInfo>& GetRegisteredBenchmarks();
+
+struct RunAttribs
+{
+    /// Regular expression that selects benchmarks to run. Empty string selects all benchmarks.
+    std::string Filter;
+
+    /// Path to the JSON file to write the results to. Empty string disables JSON output.
+    std::string OutputFile;
+
+    /// Minimum time of a single run, in seconds.
+    double MinTime = 0.5;
+
+    /// The number of times to repeat each benchmark. When it is greater than one,
+    /// mean, median and standard deviation aggregates are reported as well.
+    Uint32 Repetitions = 1;
+
+    /// Whether benchmarks that require the render device should be run.
+    bool DeviceAvailable = false;
+
+    /// Additional context fields written to the JSON output, e.g. the device type.
+    std::vector<std::pair<std::string, std::string>> Context;
+};
+
+/// Parses the command line arguments:
+///  --benchmark_filter=<regex>
+///  --benchmark_out=<file.json>
+///  --benchmark_min_time=<seconds>
+///  --benchmark_repetitions=<count>
+///  --benchmark_list_tests
+/// Unrecognized arguments are ignored. Returns false if an argument is invalid.
+bool ParseCommandLine(int argc, char** argv, RunAttribs& Attribs, bool& ListOnly);
+
+/// Runs all registered benchmarks selected by the filter. Returns the process exit code.
+int RunBenchmarks(const RunAttribs& Attribs);
+
+#if defined(_MSC_VER)
+void UseCharPointer(const volatile char*);
+#endif
+
+/// Prevents the compiler from optimizing away the computation of the value.
+template <typename T>
+inline void DoNotOptimize(const T& Value)
+{
+#if defined(_MSC_VER)
+    UseCharPointer(&reinterpret_cast<const volatile char&>(Value));
+    _ReadWriteBarrier();
+#else
+    asm volatile(""
+                 :
+                 : "r,m"(Value)
+                 : "memory");
+#endif
+}
+
+/// Forces all pending memory writes to be considered visible.
+inline void ClobberMemory()
+{
+#if defined(_MSC_VER)
+    _ReadWriteBarrier();
+#else
+    asm volatile(""
+                 :
+                 :
+                 : "memory");
+#endif
+}
+
+} // namespace Benchmark
+
+} // namespace Diligent
+
+#define DILIGENT_BENCHMARK(Func) \
+    static const int Func##_BenchmarkId = ::Diligent::Benchmark::RegisterBenchmark(#Func, Func)
+
+#define DILIGENT_BENCHMARK_ARGS(Func, ...) \
+    static const int Func##_BenchmarkId = ::Diligent::Benchmark::RegisterBenchmark(#Func, Func, {__VA_ARGS__})
+
+#define DILIGENT_API_BENCHMARK(Func) \
+    static const int Func##_BenchmarkId = ::Diligent::Benchmark::RegisterBenchmark(#Func, Func, {}, true)
+
+#define DILIGENT_API_BENCHMARK_ARGS(Func, ...) \
+    static const int Func##_BenchmarkId = ::Diligent::Benchmark::RegisterBenchmark(#Func, Func, {__VA_ARGS__}, true)
@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::Benchmark::CountingMemoryAllocator class
+
+#include <atomic>
+
+#include "../../../Primitives/interface/MemoryAllocator.h"
+#include "BenchmarkFramework.hpp"
+
+namespace Diligent
+{
+
+namespace Benchmark
+{
+
+/// Raw memory allocator that counts allocations.
+
+/// Global operator new and operator delete of the benchmark executable are routed through
+/// this allocator, so that benchmarks can report the number of heap allocations made by the
+/// measured code, see ScopedAllocationCounter.
+class CountingMemoryAllocator final : public IMemoryAllocator
+{
+public:
+    static CountingMemoryAllocator& GetAllocator();
+
+    virtual void* Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber) override final;
+
+    virtual void Free(void* Ptr) override final;
+
+    /// Returns the total number of allocations made since the process started.
+    Uint64 GetNumAllocations() const { return m_NumAllocations.load(std::memory_order_relaxed); }
+
+    /// Returns the total size of all allocations made since the process started.
+    Uint64 GetAllocatedBytes() const { return m_AllocatedBytes.load(std::memory_order_relaxed); }
+
+private:
+    CountingMemoryAllocator() = default;
+
+    std::atomic<Uint64> m_NumAllocations{0};
+    std::atomic<Uint64> m_AllocatedBytes{0};
+};
+
+/// Counts the heap allocations made while the object is alive and reports them
+/// as "allocs_per_iter" and "bytes_per_iter" counters when it is destroyed.
+class ScopedAllocationCounter
+{
+public:
+    explicit ScopedAllocationCounter(State& St) :
+        m_State{St},
+        m_StartNumAllocations{CountingMemoryAllocator::GetAllocator().GetNumAllocations()},
+        m_StartAllocatedBytes{CountingMemoryAllocator::GetAllocator().GetAllocatedBytes()}
+    {}
+
+    ~ScopedAllocationCounter()
+    {
+        const auto& Allocator     = CountingMemoryAllocator::GetAllocator();
+        const auto  NumIterations = static_cast<double>(m_State.GetIterations());
+        if (NumIterations > 0)
+        {
+            m_State.SetCounter("allocs_per_iter", static_cast<double>(Allocator.GetNumAllocations() - m_StartNumAllocations) / NumIterations);
+            m_State.SetCounter("bytes_per_iter", static_cast<double>(Allocator.GetAllocatedBytes() - m_StartAllocatedBytes) / NumIterations);
+        }
+    }
+
+    // clang-format off
+    ScopedAllocationCounter           (const ScopedAllocationCounter&) = delete;
+    ScopedAllocationCounter& operator=(const ScopedAllocationCounter&) = delete;
+    // clang-format on
+
+private:
+    State&       m_State;
+    const Uint64 m_StartNumAllocations;
+    const Uint64 m_StartAllocatedBytes;
+};
+
+} // namespace Benchmark
+
+} // namespace Diligent
@@ -0,0 +1,161 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+
+namespace
+{
+
+namespace HLSL
+{
+
+// Vertex and pixel shaders (VSMain and PSMain) of a typical lit object with
+// textures, constant buffers, loops and a shadow map.
+// clang-format off
+const std::string Benchmark_LitShader{
+R"(
+struct VSInput
+{
+    float3 Pos    : ATTRIB0;
+    float3 Normal : ATTRIB1;
+    float2 UV     : ATTRIB2;
+};
+
+struct PSInput
+{
+    float4 Pos      : SV_POSITION;
+    float3 WorldPos : WORLD_POS;
+    float3 Normal   : NORMAL;
+    float2 UV       : TEX_COORD;
+};
+
+cbuffer cbCameraAttribs
+{
+    float4x4 g_WorldViewProj;
+    float4x4 g_World;
+    float4   g_CameraPos;
+};
+
+struct LightAttribs
+{
+    float4 Direction;
+    float4 Color;
+};
+
+cbuffer cbLights
+{
+    LightAttribs g_Lights[8];
+    uint         g_NumLights;
+};
+
+Texture2D    g_BaseColorMap;
+SamplerState g_BaseColorMap_sampler;
+
+Texture2D    g_NormalMap;
+SamplerState g_NormalMap_sampler;
+
+Texture2DArray g_ShadowMap;
+SamplerComparisonState g_ShadowMap_sampler;
+
+void VSMain(in  VSInput VSIn,
+            out PSInput PSIn)
+{
+    PSIn.Pos      = mul(float4(VSIn.Pos, 1.0), g_WorldViewProj);
+    PSIn.WorldPos = mul(float4(VSIn.Pos, 1.0), g_World).xyz;
+    PSIn.Normal   = normalize(mul(float4(VSIn.Normal, 0.0), g_World).xyz);
+    PSIn.UV       = VSIn.UV;
+}
+
+float ComputeShadow(float3 WorldPos, uint Cascade)
+{
+    float4 ShadowPos = mul(float4(WorldPos, 1.0), g_World);
+    float  Shadow    = 0.0;
+    [unroll]
+    for (int x = -1; x <= 1; ++x)
+    {
+        [unroll]
+        for (int y = -1; y <= 1; ++y)
+        {
+            float2 Offset = float2(float(x), float(y)) / 1024.0;
+            Shadow += g_ShadowMap.SampleCmp(g_ShadowMap_sampler, float3(ShadowPos.xy + Offset, float(Cascade)), ShadowPos.z);
+        }
+    }
+    return Shadow / 9.0;
+}
+
+float4 PSMain(in PSInput PSIn) : SV_Target
+{
+    float4 BaseColor = g_BaseColorMap.Sample(g_BaseColorMap_sampler, PSIn.UV);
+    float3 Normal    = g_NormalMap.Sample(g_NormalMap_sampler, PSIn.UV).xyz * 2.0 - 1.0;
+    Normal = normalize(Normal + PSIn.Normal);
+
+    float3 ViewDir = normalize(g_CameraPos.xyz - PSIn.WorldPos);
+    float3 Color   = float3(0.0, 0.0, 0.0);
+    for (uint i = 0; i < g_NumLights; ++i)
+    {
+        float3 LightDir = -g_Lights[i].Direction.xyz;
+        float  NdotL    = saturate(dot(Normal, LightDir));
+        float3 H        = normalize(LightDir + ViewDir);
+        float  Spec     = pow(saturate(dot(Normal, H)), 32.0);
+        float  Shadow   = i == 0 ? ComputeShadow(PSIn.WorldPos, 0) : 1.0;
+        Color += (BaseColor.rgb * NdotL + Spec) * g_Lights[i].Color.rgb * Shadow;
+    }
+    return float4(Color, BaseColor.a);
+}
+)"
+};
+
+// Draws a full-screen triangle without vertex buffers.
+const std::string Benchmark_FullScreenTriangleVS{
+R"(
+void main(in  uint   VertId : SV_VertexID,
+          out float4 Pos    : SV_Position)
+{
+    float2 UV = float2(float((VertId << 1u) & 2u), float(VertId & 2u));
+    Pos = float4(UV * float2(2.0, -2.0) + float2(-1.0, 1.0), 0.0, 1.0);
+}
+)"
+};
+
+const std::string Benchmark_ConstantColorPS{
+R"(
+cbuffer cbColor
+{
+    float4 g_Color;
+};
+
+float4 main(in float4 Pos : SV_Position) : SV_Target
+{
+    return g_Color;
+}
+)"
+};
+// clang-format on
+
+} // namespace HLSL
+
+} // namespace
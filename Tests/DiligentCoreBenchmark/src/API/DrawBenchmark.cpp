@@ -0,0 +1,254 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+#include "MapHelper.hpp"
+
+#include "BenchmarkFramework.hpp"
+#include "InlineShaders/BenchmarkShadersHLSL.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+// The maximum number of frames the CPU may be ahead of the GPU
+constexpr Uint64 MaxFramesInFlight = 2;
+
+RefCntAutoPtr<IPipelineState> CreateConstantColorPSO(IRenderDevice* pDevice, TEXTURE_FORMAT RTVFormat)
+{
+    auto* pEnv = TestingEnvironment::GetInstance();
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.UseCombinedTextureSamplers = true;
+    ShaderCI.EntryPoint                 = "main";
+
+    RefCntAutoPtr<IShader> pVS;
+    {
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+        ShaderCI.Desc.Name       = "Draw benchmark VS";
+        ShaderCI.Source          = HLSL::Benchmark_FullScreenTriangleVS.c_str();
+        pDevice->CreateShader(ShaderCI, &pVS);
+        if (!pVS)
+            return {};
+    }
+
+    RefCntAutoPtr<IShader> pPS;
+    {
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+        ShaderCI.Desc.Name       = "Draw benchmark PS";
+        ShaderCI.Source          = HLSL::Benchmark_ConstantColorPS.c_str();
+        pDevice->CreateShader(ShaderCI, &pPS);
+        if (!pPS)
+            return {};
+    }
+
+    GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+    auto& PSODesc          = PSOCreateInfo.PSODesc;
+    auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+    PSODesc.Name = "Draw benchmark PSO";
+
+    GraphicsPipeline.NumRenderTargets             = 1;
+    GraphicsPipeline.RTVFormats[0]                = RTVFormat;
+    GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+    GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+    PSOCreateInfo.pVS = pVS;
+    PSOCreateInfo.pPS = pPS;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+    return pPSO;
+}
+
+// Renders a frame of draw calls, each of which updates the dynamic constant buffer.
+// This measures the per-draw CPU overhead of the backend: dynamic memory allocation,
+// resource binding and command recording. The argument is the number of draws in the frame.
+void API_DrawFrame(State& St)
+{
+    auto* pEnv       = TestingEnvironment::GetInstance();
+    auto* pDevice    = pEnv->GetDevice();
+    auto* pContext   = pEnv->GetDeviceContext();
+    auto* pSwapChain = pEnv->GetSwapChain();
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto pPSO = CreateConstantColorPSO(pDevice, pSwapChain->GetDesc().ColorBufferFormat);
+    if (!pPSO)
+    {
+        St.SkipWithMessage("Failed to create the pipeline state");
+        return;
+    }
+
+    RefCntAutoPtr<IBuffer> pCB;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Draw benchmark constant buffer";
+        BuffDesc.Size           = sizeof(float4);
+        BuffDesc.Usage          = USAGE_DYNAMIC;
+        BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pCB);
+    }
+    pPSO->GetStaticVariableByName(SHADER_TYPE_PIXEL, "cbColor")->Set(pCB);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO->CreateShaderResourceBinding(&pSRB, true);
+
+    RefCntAutoPtr<IFence> pFence;
+    {
+        FenceDesc Desc;
+        Desc.Name = "Draw benchmark frame fence";
+        pDevice->CreateFence(Desc, &pFence);
+    }
+
+    const auto NumDraws = static_cast<Uint32>(St.GetArg());
+
+    Uint64 FrameId = 0;
+    while (St.KeepRunning())
+    {
+        ITextureView* pRTVs[] = {pSwapChain->GetCurrentBackBufferRTV()};
+        pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->SetPipelineState(pPSO);
+        pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        for (Uint32 i = 0; i < NumDraws; ++i)
+        {
+            {
+                MapHelper<float4> Color{pContext, pCB, MAP_WRITE, MAP_FLAG_DISCARD};
+                *Color = float4{static_cast<float>(i) / static_cast<float>(NumDraws), 0, 0, 1};
+            }
+            pContext->Draw(DrawAttribs{3, DRAW_FLAG_NONE});
+        }
+
+        pContext->EnqueueSignal(pFence, ++FrameId);
+        pContext->Flush();
+        pContext->FinishFrame();
+        if (FrameId > MaxFramesInFlight)
+            pFence->Wait(FrameId - MaxFramesInFlight);
+    }
+    St.SetItemsProcessed(St.GetIterations() * NumDraws);
+
+    pContext->WaitForIdle();
+}
+DILIGENT_API_BENCHMARK_ARGS(API_DrawFrame, 16, 256);
+
+
+// Compares the CPU cost of individual draw calls with a single multi-draw command that
+// records the same draws. The argument selects the method: 0 - Draw, 1 - MultiDraw.
+void API_MultiDraw(State& St)
+{
+    auto* pEnv       = TestingEnvironment::GetInstance();
+    auto* pDevice    = pEnv->GetDevice();
+    auto* pContext   = pEnv->GetDeviceContext();
+    auto* pSwapChain = pEnv->GetSwapChain();
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    auto pPSO = CreateConstantColorPSO(pDevice, pSwapChain->GetDesc().ColorBufferFormat);
+    if (!pPSO)
+    {
+        St.SkipWithMessage("Failed to create the pipeline state");
+        return;
+    }
+
+    RefCntAutoPtr<IBuffer> pCB;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Multi-draw benchmark constant buffer";
+        BuffDesc.Size           = sizeof(float4);
+        BuffDesc.Usage          = USAGE_DYNAMIC;
+        BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pCB);
+    }
+    pPSO->GetStaticVariableByName(SHADER_TYPE_PIXEL, "cbColor")->Set(pCB);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO->CreateShaderResourceBinding(&pSRB, true);
+
+    RefCntAutoPtr<IFence> pFence;
+    {
+        FenceDesc Desc;
+        Desc.Name = "Multi-draw benchmark frame fence";
+        pDevice->CreateFence(Desc, &pFence);
+    }
+
+    const bool UseMultiDraw = St.GetArg() != 0;
+
+    constexpr Uint32                 NumDraws = 4096;
+    const std::vector<MultiDrawItem> DrawItems(NumDraws, MultiDrawItem{3, 0});
+
+    Uint64 FrameId = 0;
+    while (St.KeepRunning())
+    {
+        {
+            MapHelper<float4> Color{pContext, pCB, MAP_WRITE, MAP_FLAG_DISCARD};
+            *Color = float4{0, 1, 0, 1};
+        }
+
+        ITextureView* pRTVs[] = {pSwapChain->GetCurrentBackBufferRTV()};
+        pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->SetPipelineState(pPSO);
+        pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        if (UseMultiDraw)
+        {
+            pContext->MultiDraw({NumDraws, DrawItems.data(), DRAW_FLAG_NONE});
+        }
+        else
+        {
+            for (const auto& Item : DrawItems)
+            {
+                DrawAttribs drawAttrs{Item.NumVertices, DRAW_FLAG_NONE};
+                drawAttrs.StartVertexLocation = Item.StartVertexLocation;
+                pContext->Draw(drawAttrs);
+            }
+        }
+
+        pContext->EnqueueSignal(pFence, ++FrameId);
+        pContext->Flush();
+        pContext->FinishFrame();
+        if (FrameId > MaxFramesInFlight)
+            pFence->Wait(FrameId - MaxFramesInFlight);
+    }
+    St.SetItemsProcessed(St.GetIterations() * NumDraws);
+
+    pContext->WaitForIdle();
+}
+DILIGENT_API_BENCHMARK_ARGS(API_MultiDraw, 0, 1);
+
+} // namespace
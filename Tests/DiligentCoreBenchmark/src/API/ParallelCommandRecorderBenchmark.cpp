@@ -0,0 +1,191 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+#include "ParallelCommandRecorder.hpp"
+
+#include "BenchmarkFramework.hpp"
+#include "InlineShaders/BenchmarkShadersHLSL.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+// Records a frame of draw calls on deferred contexts in parallel with ParallelCommandRecorder
+// and executes the command lists in the immediate context. The argument is the number of
+// deferred contexts.
+void API_ParallelRecord(State& St)
+{
+    auto* pEnv     = TestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    const auto NumContexts = static_cast<Uint32>(St.GetArg());
+    if (pEnv->GetNumDeferredContexts() < NumContexts)
+    {
+        St.SkipWithMessage("Not enough deferred contexts");
+        return;
+    }
+
+    TestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Parallel recording benchmark render target";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.Width     = 256;
+    TexDesc.Height    = 256;
+    TexDesc.BindFlags = BIND_RENDER_TARGET;
+
+    RefCntAutoPtr<ITexture> pRenderTarget;
+    pDevice->CreateTexture(TexDesc, nullptr, &pRenderTarget);
+    if (!pRenderTarget)
+    {
+        St.SkipWithMessage("Failed to create the render target");
+        return;
+    }
+    auto* pRTV = pRenderTarget->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.UseCombinedTextureSamplers = true;
+    ShaderCI.EntryPoint                 = "main";
+
+    RefCntAutoPtr<IShader> pVS;
+    {
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+        ShaderCI.Desc.Name       = "Parallel recording benchmark VS";
+        ShaderCI.Source          = HLSL::Benchmark_FullScreenTriangleVS.c_str();
+        pDevice->CreateShader(ShaderCI, &pVS);
+    }
+
+    RefCntAutoPtr<IShader> pPS;
+    {
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+        ShaderCI.Desc.Name       = "Parallel recording benchmark PS";
+        ShaderCI.Source          = HLSL::Benchmark_ConstantColorPS.c_str();
+        pDevice->CreateShader(ShaderCI, &pPS);
+    }
+
+    if (!pVS || !pPS)
+    {
+        St.SkipWithMessage("Failed to create the shaders");
+        return;
+    }
+
+    GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+    auto& PSODesc          = PSOCreateInfo.PSODesc;
+    auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+    PSODesc.Name = "Parallel recording benchmark PSO";
+
+    GraphicsPipeline.NumRenderTargets             = 1;
+    GraphicsPipeline.RTVFormats[0]                = TexDesc.Format;
+    GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    GraphicsPipeline.RasterizerDesc.CullMode      = CULL_MODE_NONE;
+    GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+    PSOCreateInfo.pVS = pVS;
+    PSOCreateInfo.pPS = pPS;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+    if (!pPSO)
+    {
+        St.SkipWithMessage("Failed to create the pipeline state");
+        return;
+    }
+
+    RefCntAutoPtr<IBuffer> pCB;
+    {
+        const float4 Color{1, 0, 0, 1};
+
+        BufferDesc BuffDesc;
+        BuffDesc.Name      = "Parallel recording benchmark constant buffer";
+        BuffDesc.Size      = sizeof(Color);
+        BuffDesc.Usage     = USAGE_IMMUTABLE;
+        BuffDesc.BindFlags = BIND_UNIFORM_BUFFER;
+
+        BufferData InitData{&Color, sizeof(Color)};
+        pDevice->CreateBuffer(BuffDesc, &InitData, &pCB);
+    }
+    pPSO->GetStaticVariableByName(SHADER_TYPE_PIXEL, "cbColor")->Set(pCB);
+
+    RefCntAutoPtr<IShaderResourceBinding> pSRB;
+    pPSO->CreateShaderResourceBinding(&pSRB, true);
+
+    std::vector<IDeviceContext*> DeferredCtxs(NumContexts);
+    for (Uint32 i = 0; i < NumContexts; ++i)
+        DeferredCtxs[i] = pEnv->GetDeferredContext(i);
+
+    ParallelCommandRecorderCreateInfo CI;
+    CI.pImmediateContext   = pContext;
+    CI.ppDeferredContexts  = DeferredCtxs.data();
+    CI.NumDeferredContexts = NumContexts;
+    ParallelCommandRecorder Recorder{CI};
+
+    constexpr Uint32 NumDraws = 16384;
+
+    const auto RecordDraws = [&](IDeviceContext* pCtx, Uint32 StartPacket, Uint32 EndPacket) {
+        ITextureView* pRTVs[] = {pRTV};
+        pCtx->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        pCtx->SetPipelineState(pPSO);
+        pCtx->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+        for (Uint32 Packet = StartPacket; Packet < EndPacket; ++Packet)
+            pCtx->Draw(DrawAttribs{3, DRAW_FLAG_NONE});
+    };
+
+    while (St.KeepRunning())
+    {
+        // Transition the resources in the immediate context, as the deferred contexts only verify the states
+        ITextureView* pRTVs[] = {pRTV};
+        pContext->SetRenderTargets(1, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        if (Recorder.Record(NumDraws, RecordDraws) == 0)
+        {
+            St.SkipWithMessage("Failed to record the draws");
+            break;
+        }
+
+        pContext->Flush();
+        pContext->FinishFrame();
+        Recorder.FinishFrame();
+        pContext->WaitForIdle();
+    }
+    St.SetItemsProcessed(St.GetIterations() * NumDraws);
+}
+DILIGENT_API_BENCHMARK_ARGS(API_ParallelRecord, 1, 2, 4);
+
+} // namespace
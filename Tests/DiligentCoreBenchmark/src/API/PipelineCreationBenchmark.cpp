@@ -0,0 +1,341 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+
+#if VULKAN_SUPPORTED
+#    include "RenderDeviceVk.h"
+#endif
+
+#include "BenchmarkFramework.hpp"
+#include "InlineShaders/BenchmarkShadersHLSL.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+// Pipelines released by the benchmark are kept in the release queues until the GPU
+// completes the frame, so the frame is periodically finished to keep the queues short.
+constexpr Uint64 PSOsPerFrame = 64;
+
+// Creates many pipelines that use the same pair of shaders and only differ in the
+// render states, which is typical for material systems. In Vulkan, the shader modules
+// are served by the device-level shader module cache after the first pipeline.
+void API_CreatePSOsSharingShaders(State& St)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    TestingEnvironment::ScopedReleaseResources AutoReleaseResources;
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.UseCombinedTextureSamplers = true;
+    ShaderCI.Source                     = HLSL::Benchmark_LitShader.c_str();
+
+    RefCntAutoPtr<IShader> pVS;
+    {
+        ShaderCI.EntryPoint      = "VSMain";
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_VERTEX;
+        ShaderCI.Desc.Name       = "PSO creation benchmark VS";
+        pDevice->CreateShader(ShaderCI, &pVS);
+    }
+
+    RefCntAutoPtr<IShader> pPS;
+    {
+        ShaderCI.EntryPoint      = "PSMain";
+        ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+        ShaderCI.Desc.Name       = "PSO creation benchmark PS";
+        pDevice->CreateShader(ShaderCI, &pPS);
+    }
+
+    if (!pVS || !pPS)
+    {
+        St.SkipWithMessage("Failed to create the shaders");
+        return;
+    }
+
+    GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+    auto& PSODesc          = PSOCreateInfo.PSODesc;
+    auto& GraphicsPipeline = PSOCreateInfo.GraphicsPipeline;
+
+    PSODesc.Name = "PSO creation benchmark PSO";
+
+    PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+
+    LayoutElement LayoutElems[] =
+        {
+            LayoutElement{0, 0, 3, VT_FLOAT32},
+            LayoutElement{1, 0, 3, VT_FLOAT32},
+            LayoutElement{2, 0, 2, VT_FLOAT32},
+        };
+    GraphicsPipeline.InputLayout.LayoutElements = LayoutElems;
+    GraphicsPipeline.InputLayout.NumElements    = _countof(LayoutElems);
+
+    GraphicsPipeline.NumRenderTargets  = 1;
+    GraphicsPipeline.RTVFormats[0]     = TEX_FORMAT_RGBA8_UNORM;
+    GraphicsPipeline.DSVFormat         = TEX_FORMAT_D32_FLOAT;
+    GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    PSOCreateInfo.pVS = pVS;
+    PSOCreateInfo.pPS = pPS;
+
+    std::vector<RefCntAutoPtr<IPipelineState>> PSOs;
+    PSOs.reserve(PSOsPerFrame);
+    while (St.KeepRunning())
+    {
+        // Vary the render states so that the pipelines are not identical
+        const auto Idx = St.GetIterations();
+
+        GraphicsPipeline.RasterizerDesc.CullMode                = (Idx & 0x01) ? CULL_MODE_BACK : CULL_MODE_NONE;
+        GraphicsPipeline.DepthStencilDesc.DepthWriteEnable      = (Idx & 0x02) ? True : False;
+        GraphicsPipeline.BlendDesc.RenderTargets[0].BlendEnable = (Idx & 0x04) ? True : False;
+        GraphicsPipeline.BlendDesc.RenderTargets[0].SrcBlend    = (Idx & 0x08) ? BLEND_FACTOR_SRC_ALPHA : BLEND_FACTOR_ONE;
+        GraphicsPipeline.BlendDesc.RenderTargets[0].DestBlend   = (Idx & 0x08) ? BLEND_FACTOR_INV_SRC_ALPHA : BLEND_FACTOR_ZERO;
+        GraphicsPipeline.DepthStencilDesc.DepthFunc             = (Idx & 0x10) ? COMPARISON_FUNC_LESS_EQUAL : COMPARISON_FUNC_LESS;
+        GraphicsPipeline.RasterizerDesc.FrontCounterClockwise   = (Idx & 0x20) ? True : False;
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+        if (!pPSO)
+        {
+            St.SkipWithMessage("Failed to create the pipeline state");
+            break;
+        }
+        PSOs.emplace_back(std::move(pPSO));
+
+        if (PSOs.size() == PSOsPerFrame)
+        {
+            St.PauseTiming();
+            PSOs.clear();
+            pEnv->GetDeviceContext()->Flush();
+            pEnv->GetDeviceContext()->FinishFrame();
+            pDevice->ReleaseStaleResources();
+            St.ResumeTiming();
+        }
+    }
+    St.SetItemsProcessed(St.GetIterations());
+
+#if VULKAN_SUPPORTED
+    if (RefCntAutoPtr<IRenderDeviceVk> pDeviceVk{pDevice, IID_RenderDeviceVk})
+    {
+        const auto Stats  = pDeviceVk->GetShaderModuleCacheStats();
+        const auto Total  = Stats.NumHits + Stats.NumMisses;
+        const auto HitPct = Total > 0 ? static_cast<double>(Stats.NumHits) * 100.0 / static_cast<double>(Total) : 0.0;
+        LOG_INFO_MESSAGE("Shader module cache: ", Stats.NumModules, " modules, ", Stats.NumHits, " hits, ", Stats.NumMisses,
+                         " misses (", HitPct, "% hit rate), ", Stats.NumEvictions, " evictions");
+    }
+#endif
+}
+DILIGENT_API_BENCHMARK(API_CreatePSOsSharingShaders);
+
+
+constexpr Uint32 NumComputePSOs = 32;
+
+static const char g_ComputeShaderSource[] = R"(
+RWBuffer<float> g_Output;
+
+[numthreads(1, 1, 1)]
+void main()
+{
+    g_Output[0] = CONST_VALUE;
+}
+)";
+
+// Creates NumComputePSOs compute shaders that only differ in the constant they write.
+std::vector<RefCntAutoPtr<IShader>> CreateComputeShaders()
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    std::vector<RefCntAutoPtr<IShader>> Shaders;
+    for (Uint32 i = 0; i < NumComputePSOs; ++i)
+    {
+        const auto ConstValue = std::to_string(i + 1) + ".0";
+
+        ShaderMacro Macros[] = {{"CONST_VALUE", ConstValue.c_str()}, {}};
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.Source                     = g_ComputeShaderSource;
+        ShaderCI.Macros                     = Macros;
+        ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.UseCombinedTextureSamplers = true;
+        ShaderCI.Desc.ShaderType            = SHADER_TYPE_COMPUTE;
+        ShaderCI.EntryPoint                 = "main";
+        ShaderCI.Desc.Name                  = "PSO creation benchmark CS";
+
+        RefCntAutoPtr<IShader> pCS;
+        pDevice->CreateShader(ShaderCI, &pCS);
+        if (!pCS)
+            return {};
+        Shaders.emplace_back(std::move(pCS));
+    }
+    return Shaders;
+}
+
+RefCntAutoPtr<IPipelineState> CreateComputePSO(IShader* pCS, PSO_CREATE_FLAGS Flags, IPipelineStateCache* pCache)
+{
+    ComputePipelineStateCreateInfo PSOCreateInfo;
+    PSOCreateInfo.PSODesc.Name                               = "PSO creation benchmark compute PSO";
+    PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+    PSOCreateInfo.pCS                                        = pCS;
+    PSOCreateInfo.Flags                                      = Flags;
+    PSOCreateInfo.pPSOCache                                  = pCache;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    TestingEnvironment::GetInstance()->GetDevice()->CreateComputePipelineState(PSOCreateInfo, &pPSO);
+    return pPSO;
+}
+
+void FinishBenchmarkFrame(State& St)
+{
+    auto* pEnv = TestingEnvironment::GetInstance();
+
+    St.PauseTiming();
+    pEnv->GetDeviceContext()->Flush();
+    pEnv->GetDeviceContext()->FinishFrame();
+    pEnv->GetDevice()->ReleaseStaleResources();
+    St.ResumeTiming();
+}
+
+// Creates NumComputePSOs pipelines with the pipeline state cache.
+// The argument selects the cache state: 0 - empty cache, 1 - cache loaded from the data
+// serialized after the pipelines have been created once.
+void API_CreatePSOsWithCache(State& St)
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+    TestingEnvironment::ScopedReleaseResources AutoReleaseResources;
+
+    auto Shaders = CreateComputeShaders();
+    if (Shaders.empty())
+    {
+        St.SkipWithMessage("Failed to create the shaders");
+        return;
+    }
+
+    PipelineStateCacheCreateInfo CacheCI;
+    CacheCI.Desc.Name = "PSO creation benchmark cache";
+
+    RefCntAutoPtr<IDataBlob> pCacheData;
+    if (St.GetArg() != 0)
+    {
+        RefCntAutoPtr<IPipelineStateCache> pCache;
+        pDevice->CreatePipelineStateCache(CacheCI, &pCache);
+        if (!pCache)
+        {
+            St.SkipWithMessage("Pipeline state cache is not supported by this device");
+            return;
+        }
+        for (auto& pCS : Shaders)
+            CreateComputePSO(pCS, PSO_CREATE_FLAG_NONE, pCache);
+        pCache->GetData(&pCacheData);
+        if (!pCacheData)
+        {
+            St.SkipWithMessage("Failed to serialize the pipeline state cache");
+            return;
+        }
+        CacheCI.pCacheData    = pCacheData->GetConstDataPtr();
+        CacheCI.CacheDataSize = static_cast<Uint32>(pCacheData->GetSize());
+    }
+
+    while (St.KeepRunning())
+    {
+        St.PauseTiming();
+        RefCntAutoPtr<IPipelineStateCache> pCache;
+        pDevice->CreatePipelineStateCache(CacheCI, &pCache);
+        St.ResumeTiming();
+        if (!pCache)
+        {
+            St.SkipWithMessage("Pipeline state cache is not supported by this device");
+            break;
+        }
+
+        for (auto& pCS : Shaders)
+        {
+            auto pPSO = CreateComputePSO(pCS, PSO_CREATE_FLAG_NONE, pCache);
+            DoNotOptimize(pPSO);
+        }
+
+        FinishBenchmarkFrame(St);
+    }
+    St.SetItemsProcessed(St.GetIterations() * NumComputePSOs);
+}
+DILIGENT_API_BENCHMARK_ARGS(API_CreatePSOsWithCache, 0, 1);
+
+// Creates NumComputePSOs pipelines and waits until all of them are ready.
+// The argument selects the creation mode: 0 - synchronous, 1 - asynchronous.
+void API_CreatePSOsAsync(State& St)
+{
+    TestingEnvironment::ScopedReleaseResources AutoReleaseResources;
+
+    auto Shaders = CreateComputeShaders();
+    if (Shaders.empty())
+    {
+        St.SkipWithMessage("Failed to create the shaders");
+        return;
+    }
+
+    const auto Flags = St.GetArg() != 0 ? PSO_CREATE_FLAG_ASYNCHRONOUS : PSO_CREATE_FLAG_NONE;
+
+    std::vector<RefCntAutoPtr<IPipelineState>> PSOs;
+    PSOs.reserve(NumComputePSOs);
+    while (St.KeepRunning())
+    {
+        for (auto& pCS : Shaders)
+        {
+            PSOs.emplace_back(CreateComputePSO(pCS, Flags, nullptr));
+            if (!PSOs.back())
+            {
+                St.SkipWithMessage("Failed to create the pipeline state");
+                break;
+            }
+        }
+
+        for (auto& pPSO : PSOs)
+        {
+            if (pPSO && pPSO->GetStatus(true) != PIPELINE_STATE_STATUS_READY)
+                St.SkipWithMessage("Failed to create the pipeline state");
+        }
+        PSOs.clear();
+
+        FinishBenchmarkFrame(St);
+    }
+    St.SetItemsProcessed(St.GetIterations() * NumComputePSOs);
+}
+DILIGENT_API_BENCHMARK_ARGS(API_CreatePSOsAsync, 0, 1);
+
+} // namespace
@@ -0,0 +1,253 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <thread>
+#include <atomic>
+
+#include "TestingEnvironment.hpp"
+
+#include "BenchmarkFramework.hpp"
+#include "InlineShaders/BenchmarkShadersHLSL.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+// Resources released by the benchmarks are kept in the release queues until the GPU
+// completes the frame, so the frame is periodically finished to keep the queues short.
+constexpr Uint64 ObjectsPerFrame = 64;
+
+void FinishFrameIfNeeded(Uint64 Iteration)
+{
+    if (Iteration % ObjectsPerFrame == 0)
+    {
+        auto* pEnv = TestingEnvironment::GetInstance();
+        pEnv->GetDeviceContext()->Flush();
+        pEnv->GetDeviceContext()->FinishFrame();
+        pEnv->GetDevice()->ReleaseStaleResources();
+    }
+}
+
+void API_CreateDynamicBuffer(State& St)
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+    TestingEnvironment::ScopedReleaseResources AutoReleaseResources;
+
+    BufferDesc BuffDesc;
+    BuffDesc.Name           = "Benchmark dynamic buffer";
+    BuffDesc.Size           = 256;
+    BuffDesc.Usage          = USAGE_DYNAMIC;
+    BuffDesc.BindFlags      = BIND_UNIFORM_BUFFER;
+    BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    while (St.KeepRunning())
+    {
+        RefCntAutoPtr<IBuffer> pBuffer;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pBuffer);
+        if (!pBuffer)
+        {
+            St.SkipWithMessage("Failed to create the buffer");
+            break;
+        }
+        pBuffer.Release();
+        FinishFrameIfNeeded(St.GetIterations());
+    }
+    St.SetItemsProcessed(St.GetIterations());
+}
+DILIGENT_API_BENCHMARK(API_CreateDynamicBuffer);
+
+
+void API_CreateTexture2D(State& St)
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+    TestingEnvironment::ScopedReleaseResources AutoReleaseResources;
+
+    TextureDesc TexDesc;
+    TexDesc.Name      = "Benchmark texture";
+    TexDesc.Type      = RESOURCE_DIM_TEX_2D;
+    TexDesc.Width     = 256;
+    TexDesc.Height    = 256;
+    TexDesc.MipLevels = 0;
+    TexDesc.Format    = TEX_FORMAT_RGBA8_UNORM;
+    TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+    while (St.KeepRunning())
+    {
+        RefCntAutoPtr<ITexture> pTexture;
+        pDevice->CreateTexture(TexDesc, nullptr, &pTexture);
+        if (!pTexture)
+        {
+            St.SkipWithMessage("Failed to create the texture");
+            break;
+        }
+        pTexture.Release();
+        FinishFrameIfNeeded(St.GetIterations());
+    }
+    St.SetItemsProcessed(St.GetIterations());
+}
+DILIGENT_API_BENCHMARK(API_CreateTexture2D);
+
+
+// Requests the same sampler over and over, which is served by the sampler registry.
+void API_CreateSampler(State& St)
+{
+    auto* pDevice = TestingEnvironment::GetInstance()->GetDevice();
+
+    TestingEnvironment::ScopedReleaseResources AutoReleaseResources;
+
+    SamplerDesc SamDesc;
+    SamDesc.Name     = "Benchmark sampler";
+    SamDesc.AddressU = TEXTURE_ADDRESS_CLAMP;
+    SamDesc.AddressV = TEXTURE_ADDRESS_CLAMP;
+
+    RefCntAutoPtr<ISampler> pSampler;
+    pDevice->CreateSampler(SamDesc, &pSampler);
+    if (!pSampler)
+    {
+        St.SkipWithMessage("Failed to create the sampler");
+        return;
+    }
+
+    while (St.KeepRunning())
+    {
+        RefCntAutoPtr<ISampler> pSampler2;
+        pDevice->CreateSampler(SamDesc, &pSampler2);
+        DoNotOptimize(pSampler2.RawPtr());
+    }
+    St.SetItemsProcessed(St.GetIterations());
+}
+DILIGENT_API_BENCHMARK(API_CreateSampler);
+
+
+// Creates the shader from HLSL source, which includes compilation or conversion to the backend language.
+void API_CreateShader(State& St)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    TestingEnvironment::ScopedReleaseResources AutoReleaseResources;
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.UseCombinedTextureSamplers = true;
+    ShaderCI.EntryPoint                 = "PSMain";
+    ShaderCI.Desc.ShaderType            = SHADER_TYPE_PIXEL;
+    ShaderCI.Desc.Name                  = "Benchmark shader";
+    ShaderCI.Source                     = HLSL::Benchmark_LitShader.c_str();
+    while (St.KeepRunning())
+    {
+        RefCntAutoPtr<IShader> pShader;
+        pDevice->CreateShader(ShaderCI, &pShader);
+        if (!pShader)
+        {
+            St.SkipWithMessage("Failed to create the shader");
+            break;
+        }
+        pShader.Release();
+        FinishFrameIfNeeded(St.GetIterations());
+    }
+    St.SetItemsProcessed(St.GetIterations());
+}
+DILIGENT_API_BENCHMARK(API_CreateShader);
+
+
+// Creates buffers from multiple threads concurrently. In Vulkan, this mostly exercises
+// device memory allocation. The argument is the number of threads.
+void API_CreateBuffersMultithreaded(State& St)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (pDevice->GetDeviceInfo().IsGLDevice())
+    {
+        St.SkipWithMessage("Multithreaded resource creation is not supported in OpenGL");
+        return;
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoReleaseResources;
+
+    const auto       NumThreads          = static_cast<Uint32>(St.GetArg());
+    constexpr Uint32 NumBuffersPerThread = 64;
+
+    std::vector<std::vector<RefCntAutoPtr<IBuffer>>> Buffers(NumThreads);
+    for (auto& ThreadBuffers : Buffers)
+        ThreadBuffers.resize(NumBuffersPerThread);
+
+    std::atomic<Uint32>      NumFailedBuffers{0};
+    std::vector<std::thread> Threads(NumThreads);
+    while (St.KeepRunning())
+    {
+        for (Uint32 t = 0; t < NumThreads; ++t)
+        {
+            Threads[t] = std::thread{
+                [&](Uint32 ThreadId) {
+                    auto& ThreadBuffers = Buffers[ThreadId];
+                    for (Uint32 i = 0; i < NumBuffersPerThread; ++i)
+                    {
+                        BufferDesc BuffDesc;
+                        BuffDesc.Name      = "Benchmark MT buffer";
+                        BuffDesc.Usage     = USAGE_DEFAULT;
+                        BuffDesc.BindFlags = BIND_VERTEX_BUFFER;
+                        BuffDesc.Size      = 256 + (i % 16) * 1024;
+                        pDevice->CreateBuffer(BuffDesc, nullptr, &ThreadBuffers[i]);
+                        if (!ThreadBuffers[i])
+                            NumFailedBuffers.fetch_add(1);
+                    }
+                },
+                t //
+            };
+        }
+        for (auto& Thread : Threads)
+            Thread.join();
+
+        // Release the buffers outside of the measured time
+        St.PauseTiming();
+        for (auto& ThreadBuffers : Buffers)
+        {
+            for (auto& pBuffer : ThreadBuffers)
+                pBuffer.Release();
+        }
+        pEnv->GetDeviceContext()->Flush();
+        pEnv->GetDeviceContext()->FinishFrame();
+        pDevice->ReleaseStaleResources();
+        St.ResumeTiming();
+
+        if (NumFailedBuffers.load() != 0)
+        {
+            St.SkipWithMessage("Failed to create the buffers");
+            break;
+        }
+    }
+    St.SetItemsProcessed(St.GetIterations() * NumThreads * NumBuffersPerThread);
+}
+DILIGENT_API_BENCHMARK_ARGS(API_CreateBuffersMultithreaded, 1, 2, 4);
+
+} // namespace
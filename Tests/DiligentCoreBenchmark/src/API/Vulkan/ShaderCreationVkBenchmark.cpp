@@ -0,0 +1,102 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ShaderVk.h"
+#include "TestingEnvironment.hpp"
+
+#include "BenchmarkFramework.hpp"
+#include "InlineShaders/BenchmarkShadersHLSL.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+// Creates the shader from SPIR-V bytecode. The argument indicates whether pre-reflected
+// resources are passed through ShaderCreateInfo::pReflectionData.
+void API_CreateShaderFromSPIRV(State& St)
+{
+    auto* pEnv    = TestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().IsVulkanDevice())
+    {
+        St.SkipWithMessage("SPIRV bytecode is only supported in Vulkan");
+        return;
+    }
+
+    TestingEnvironment::ScopedReleaseResources AutoReleaseResources;
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.UseCombinedTextureSamplers = true;
+    ShaderCI.EntryPoint                 = "PSMain";
+    ShaderCI.Desc.ShaderType            = SHADER_TYPE_PIXEL;
+    ShaderCI.Desc.Name                  = "Benchmark shader";
+    ShaderCI.Source                     = HLSL::Benchmark_LitShader.c_str();
+
+    RefCntAutoPtr<IShader> pSrcShader;
+    pDevice->CreateShader(ShaderCI, &pSrcShader);
+    RefCntAutoPtr<IShaderVk> pSrcShaderVk{pSrcShader, IID_ShaderVk};
+    if (!pSrcShaderVk)
+    {
+        St.SkipWithMessage("Failed to create the source shader");
+        return;
+    }
+
+    const auto& SPIRV = pSrcShaderVk->GetSPIRV();
+
+    ShaderCI.Source       = nullptr;
+    ShaderCI.EntryPoint   = nullptr;
+    ShaderCI.ByteCode     = SPIRV.data();
+    ShaderCI.ByteCodeSize = SPIRV.size() * sizeof(SPIRV[0]);
+
+    RefCntAutoPtr<IDataBlob> pReflectionData;
+    if (St.GetArg() != 0)
+    {
+        pSrcShaderVk->GetReflectionData(&pReflectionData);
+        ShaderCI.pReflectionData    = pReflectionData->GetConstDataPtr();
+        ShaderCI.ReflectionDataSize = pReflectionData->GetSize();
+    }
+
+    while (St.KeepRunning())
+    {
+        RefCntAutoPtr<IShader> pShader;
+        pDevice->CreateShader(ShaderCI, &pShader);
+        if (!pShader)
+        {
+            St.SkipWithMessage("Failed to create the shader");
+            break;
+        }
+    }
+    St.SetItemsProcessed(St.GetIterations());
+}
+DILIGENT_API_BENCHMARK_ARGS(API_CreateShaderFromSPIRV, 0, 1);
+
+} // namespace
@@ -0,0 +1,523 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "BenchmarkFramework.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+#include "DebugUtilities.hpp"
+#include "PlatformDefinitions.h"
+
+namespace Diligent
+{
+
+namespace Benchmark
+{
+
+namespace
+{
+
+std::vector<BenchmarkInfo>& GetBenchmarks()
+{
+    static std::vector<BenchmarkInfo> Benchmarks;
+    return Benchmarks;
+}
+
+struct RunResult
+{
+    std::string Name;
+    std::string RunName;
+    std::string AggregateName; // Empty for iteration runs
+
+    Uint32 RepetitionIndex = 0;
+    Uint64 Iterations      = 0;
+
+    // Per-iteration times, in nanoseconds
+    double RealTime = 0;
+    double CPUTime  = 0;
+
+    double ItemsPerSecond = 0;
+    double BytesPerSecond = 0;
+
+    State::CountersType Counters;
+
+    std::string SkipMessage;
+};
+
+std::string EscapeJSONString(const std::string& Str)
+{
+    std::string Escaped;
+    Escaped.reserve(Str.length());
+    for (auto c : Str)
+    {
+        switch (c)
+        {
+            case '"': Escaped += "\\\""; break;
+            case '\\': Escaped += "\\\\"; break;
+            case '\n': Escaped += "\\n"; break;
+            case '\t': Escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char Buff[8];
+                    snprintf(Buff, sizeof(Buff), "\\u%04x", c);
+                    Escaped += Buff;
+                }
+                else
+                {
+                    Escaped += c;
+                }
+        }
+    }
+    return Escaped;
+}
+
+std::string GetDateString()
+{
+    const auto Now = std::time(nullptr);
+    char       Buff[64];
+    std::strftime(Buff, sizeof(Buff), "%Y-%m-%dT%H:%M:%S", std::localtime(&Now));
+    return Buff;
+}
+
+std::string FormatTime(double TimeNs)
+{
+    std::stringstream ss;
+    ss << std::fixed;
+    if (TimeNs < 1e4)
+        ss << std::setprecision(2) << TimeNs << " ns";
+    else if (TimeNs < 1e7)
+        ss << std::setprecision(2) << TimeNs * 1e-3 << " us";
+    else
+        ss << std::setprecision(2) << TimeNs * 1e-6 << " ms";
+    return ss.str();
+}
+
+std::string FormatRate(double PerSecond, const char* Suffix)
+{
+    static constexpr const char* Prefixes[] = {"", "k", "M", "G", "T"};
+
+    size_t i = 0;
+    while (PerSecond >= 1000 && i + 1 < _countof(Prefixes))
+    {
+        PerSecond /= 1000;
+        ++i;
+    }
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3) << PerSecond << Prefixes[i] << Suffix;
+    return ss.str();
+}
+
+void PrintResult(const RunResult& Res, size_t NameWidth)
+{
+    std::cout << std::left << std::setw(static_cast<int>(NameWidth)) << Res.Name << std::right;
+    if (!Res.SkipMessage.empty())
+    {
+        std::cout << " SKIPPED: " << Res.SkipMessage << std::endl;
+        return;
+    }
+
+    std::cout << std::setw(15) << FormatTime(Res.RealTime)
+              << std::setw(15) << FormatTime(Res.CPUTime)
+              << std::setw(12) << Res.Iterations;
+    if (Res.ItemsPerSecond > 0)
+        std::cout << ' ' << FormatRate(Res.ItemsPerSecond, " items/s");
+    if (Res.BytesPerSecond > 0)
+        std::cout << ' ' << FormatRate(Res.BytesPerSecond, "B/s");
+    for (const auto& Counter : Res.Counters)
+        std::cout << ' ' << Counter.first << '=' << Counter.second;
+    std::cout << std::endl;
+}
+
+RunResult MakeResult(const std::string& Name, const State& St)
+{
+    RunResult Res;
+    Res.Name        = Name;
+    Res.RunName     = Name;
+    Res.Iterations  = St.GetIterations();
+    Res.SkipMessage = St.GetSkipMessage();
+    Res.Counters    = St.GetCounters();
+    if (Res.Iterations > 0)
+    {
+        Res.RealTime = St.GetRealTime() * 1e9 / static_cast<double>(Res.Iterations);
+        Res.CPUTime  = St.GetCPUTime() * 1e9 / static_cast<double>(Res.Iterations);
+    }
+    if (St.GetRealTime() > 0)
+    {
+        Res.ItemsPerSecond = static_cast<double>(St.GetItemsProcessed()) / St.GetRealTime();
+        Res.BytesPerSecond = static_cast<double>(St.GetBytesProcessed()) / St.GetRealTime();
+    }
+    return Res;
+}
+
+// Runs the benchmark with the increasing number of iterations until the run takes at least MinTime.
+// Returns the result of the last run.
+RunResult RunCalibrated(const std::string& Name, BenchmarkFunction Func, Int64 Arg, double MinTime)
+{
+    static constexpr Uint64 MaxIterations = 1000000000;
+
+    Uint64 NumIterations = 1;
+    while (true)
+    {
+        State St{NumIterations, Arg};
+        Func(St);
+        if (!St.GetSkipMessage().empty())
+            return MakeResult(Name, St);
+
+        if (St.GetIterations() != NumIterations)
+        {
+            RunResult Res;
+            Res.Name        = Name;
+            Res.SkipMessage = "the benchmark exited the iteration loop early";
+            return Res;
+        }
+
+        const auto Time = St.GetRealTime();
+        if (Time >= MinTime || NumIterations >= MaxIterations)
+            return MakeResult(Name, St);
+
+        // Predict the number of iterations required to reach the minimum time with a 40% margin.
+        // If the run was too short for the prediction to be reliable, only grow by a factor of 10.
+        double Multiplier = Time > MinTime * 0.1 ? MinTime * 1.4 / Time : 10.0;
+        Multiplier        = std::min(std::max(Multiplier, 1.0), 10.0);
+
+        const auto NextIterations = static_cast<Uint64>(std::round(static_cast<double>(NumIterations) * Multiplier));
+        NumIterations             = std::min(std::max(NextIterations, NumIterations + 1), MaxIterations);
+    }
+}
+
+std::vector<RunResult> ComputeAggregates(const std::vector<RunResult>& Runs)
+{
+    std::vector<RunResult> Aggregates;
+    if (Runs.size() < 2)
+        return Aggregates;
+
+    auto MakeAggregate = [&](const char* AggregateName, double (*Reduce)(std::vector<double>)) {
+        RunResult Res;
+        Res.RunName       = Runs[0].RunName;
+        Res.Name          = Res.RunName + "_" + AggregateName;
+        Res.AggregateName = AggregateName;
+        Res.Iterations    = Runs.size();
+
+        std::vector<double> Values(Runs.size());
+        auto                ReduceMember = [&](double RunResult::*Member) {
+            for (size_t i = 0; i < Runs.size(); ++i)
+                Values[i] = Runs[i].*Member;
+            return Reduce(Values);
+        };
+        Res.RealTime       = ReduceMember(&RunResult::RealTime);
+        Res.CPUTime        = ReduceMember(&RunResult::CPUTime);
+        Res.ItemsPerSecond = ReduceMember(&RunResult::ItemsPerSecond);
+        Res.BytesPerSecond = ReduceMember(&RunResult::BytesPerSecond);
+
+        // All runs of the same benchmark set the same counters in the same order
+        Res.Counters = Runs[0].Counters;
+        for (size_t c = 0; c < Res.Counters.size(); ++c)
+        {
+            for (size_t i = 0; i < Runs.size(); ++i)
+                Values[i] = c < Runs[i].Counters.size() ? Runs[i].Counters[c].second : 0;
+            Res.Counters[c].second = Reduce(Values);
+        }
+        Aggregates.emplace_back(std::move(Res));
+    };
+
+    MakeAggregate("mean", [](std::vector<double> Values) {
+        double Sum = 0;
+        for (auto Val : Values)
+            Sum += Val;
+        return Sum / static_cast<double>(Values.size());
+    });
+    MakeAggregate("median", [](std::vector<double> Values) {
+        std::sort(Values.begin(), Values.end());
+        const auto Mid = Values.size() / 2;
+        return (Values.size() % 2 != 0) ? Values[Mid] : (Values[Mid - 1] + Values[Mid]) * 0.5;
+    });
+    MakeAggregate("stddev", [](std::vector<double> Values) {
+        double Mean = 0;
+        for (auto Val : Values)
+            Mean += Val;
+        Mean /= static_cast<double>(Values.size());
+        double Var = 0;
+        for (auto Val : Values)
+            Var += (Val - Mean) * (Val - Mean);
+        return std::sqrt(Var / static_cast<double>(Values.size() - 1));
+    });
+
+    return Aggregates;
+}
+
+void WriteJSON(std::ostream& Stream, const RunAttribs& Attribs, const std::vector<RunResult>& Results)
+{
+    Stream << "{\n"
+           << "  \"context\": {\n"
+           << "    \"date\": \"" << GetDateString() << "\",\n"
+           << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+    for (const auto& Ctx : Attribs.Context)
+        Stream << "    \"" << EscapeJSONString(Ctx.first) << "\": \"" << EscapeJSONString(Ctx.second) << "\",\n";
+    Stream << "    \"library_build_type\": "
+#ifdef DILIGENT_DEBUG
+           << "\"debug\"\n"
+#else
+           << "\"release\"\n"
+#endif
+           << "  },\n"
+           << "  \"benchmarks\": [";
+
+    bool First = true;
+    for (const auto& Res : Results)
+    {
+        if (!Res.SkipMessage.empty())
+            continue;
+
+        Stream << (First ? "\n" : ",\n");
+        First = false;
+
+        Stream << std::setprecision(std::numeric_limits<double>::max_digits10)
+               << "    {\n"
+               << "      \"name\": \"" << EscapeJSONString(Res.Name) << "\",\n"
+               << "      \"run_name\": \"" << EscapeJSONString(Res.RunName) << "\",\n";
+        if (Res.AggregateName.empty())
+        {
+            Stream << "      \"run_type\": \"iteration\",\n"
+                   << "      \"repetition_index\": " << Res.RepetitionIndex << ",\n";
+        }
+        else
+        {
+            Stream << "      \"run_type\": \"aggregate\",\n"
+                   << "      \"aggregate_name\": \"" << Res.AggregateName << "\",\n";
+        }
+        Stream << "      \"iterations\": " << Res.Iterations << ",\n"
+               << "      \"real_time\": " << Res.RealTime << ",\n"
+               << "      \"cpu_time\": " << Res.CPUTime << ",\n";
+        if (Res.ItemsPerSecond > 0)
+            Stream << "      \"items_per_second\": " << Res.ItemsPerSecond << ",\n";
+        if (Res.BytesPerSecond > 0)
+            Stream << "      \"bytes_per_second\": " << Res.BytesPerSecond << ",\n";
+        for (const auto& Counter : Res.Counters)
+            Stream << "      \"" << EscapeJSONString(Counter.first) << "\": " << Counter.second << ",\n";
+        Stream << "      \"time_unit\": \"ns\"\n"
+               << "    }";
+    }
+    Stream << "\n  ]\n"
+           << "}\n";
+}
+
+} // namespace
+
+#if defined(_MSC_VER)
+void UseCharPointer(const volatile char*)
+{
+}
+#endif
+
+int RegisterBenchmark(const char* Name, BenchmarkFunction Func, std::initializer_list<Int64> Args, bool RequiresDevice)
+{
+    VERIFY_EXPR(Name != nullptr && Func != nullptr);
+
+    auto& Benchmarks = GetBenchmarks();
+
+    BenchmarkInfo Info;
+    Info.Name           = Name;
+    Info.Func           = Func;
+    Info.Args           = Args;
+    Info.RequiresDevice = RequiresDevice;
+    Benchmarks.emplace_back(std::move(Info));
+
+    return static_cast<int>(Benchmarks.size() - 1);
+}
+
+const std::vector<BenchmarkInfo>& GetRegisteredBenchmarks()
+{
+    return GetBenchmarks();
+}
+
+bool ParseCommandLine(int argc, char** argv, RunAttribs& Attribs, bool& ListOnly)
+{
+    auto GetValue = [](const char* Arg, const char* Name) -> const char* {
+        const auto Len = strlen(Name);
+        return (strncmp(Arg, Name, Len) == 0 && Arg[Len] == '=') ? Arg + Len + 1 : nullptr;
+    };
+
+    ListOnly = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        const auto* Arg = argv[i];
+        if (const auto* Filter = GetValue(Arg, "--benchmark_filter"))
+        {
+            Attribs.Filter = Filter;
+        }
+        else if (const auto* OutFile = GetValue(Arg, "--benchmark_out"))
+        {
+            Attribs.OutputFile = OutFile;
+        }
+        else if (const auto* MinTime = GetValue(Arg, "--benchmark_min_time"))
+        {
+            Attribs.MinTime = atof(MinTime);
+            if (Attribs.MinTime <= 0)
+            {
+                LOG_ERROR_MESSAGE("Invalid minimum time: '", MinTime, "'");
+                return false;
+            }
+        }
+        else if (const auto* Repetitions = GetValue(Arg, "--benchmark_repetitions"))
+        {
+            const auto Reps = atoi(Repetitions);
+            if (Reps <= 0)
+            {
+                LOG_ERROR_MESSAGE("Invalid repetition count: '", Repetitions, "'");
+                return false;
+            }
+            Attribs.Repetitions = static_cast<Uint32>(Reps);
+        }
+        else if (strcmp(Arg, "--benchmark_list_tests") == 0)
+        {
+            ListOnly = true;
+        }
+    }
+
+    return true;
+}
+
+int RunBenchmarks(const RunAttribs& Attribs)
+{
+    std::regex Filter;
+    try
+    {
+        Filter = std::regex{Attribs.Filter.empty() ? std::string{"."} : Attribs.Filter};
+    }
+    catch (const std::regex_error& err)
+    {
+        LOG_ERROR_MESSAGE("Invalid benchmark filter '", Attribs.Filter, "': ", err.what());
+        return -1;
+    }
+
+    struct Instance
+    {
+        std::string       Name;
+        BenchmarkFunction Func;
+        Int64             Arg;
+    };
+    std::vector<Instance> Instances;
+    for (const auto& Info : GetBenchmarks())
+    {
+        if (Info.RequiresDevice && !Attribs.DeviceAvailable)
+            continue;
+
+        auto AddInstance = [&](std::string Name, Int64 Arg) {
+            if (std::regex_search(Name, Filter))
+                Instances.push_back({std::move(Name), Info.Func, Arg});
+        };
+        if (Info.Args.empty())
+        {
+            AddInstance(Info.Name, 0);
+        }
+        else
+        {
+            for (auto Arg : Info.Args)
+                AddInstance(Info.Name + "/" + std::to_string(Arg), Arg);
+        }
+    }
+
+    if (Instances.empty())
+    {
+        LOG_ERROR_MESSAGE("No benchmarks match the filter '", Attribs.Filter, "'");
+        return -1;
+    }
+
+    size_t NameWidth = 10;
+    for (const auto& Inst : Instances)
+        NameWidth = std::max(NameWidth, Inst.Name.length() + (Attribs.Repetitions > 1 ? 7 : 0));
+    NameWidth += 2;
+
+    std::cout << std::left << std::setw(static_cast<int>(NameWidth)) << "Benchmark" << std::right
+              << std::setw(15) << "Time"
+              << std::setw(15) << "CPU"
+              << std::setw(12) << "Iterations" << std::endl
+              << std::string(NameWidth + 42, '-') << std::endl;
+
+    std::vector<RunResult> Results;
+    for (const auto& Inst : Instances)
+    {
+        auto Res = RunCalibrated(Inst.Name, Inst.Func, Inst.Arg, Attribs.MinTime);
+        PrintResult(Res, NameWidth);
+        if (!Res.SkipMessage.empty())
+        {
+            Results.emplace_back(std::move(Res));
+            continue;
+        }
+
+        // Subsequent repetitions use the calibrated number of iterations.
+        std::vector<RunResult> Runs{std::move(Res)};
+        for (Uint32 rep = 1; rep < Attribs.Repetitions; ++rep)
+        {
+            State St{Runs[0].Iterations, Inst.Arg};
+            Inst.Func(St);
+
+            auto RepRes            = MakeResult(Inst.Name, St);
+            RepRes.RepetitionIndex = rep;
+            PrintResult(RepRes, NameWidth);
+            Runs.emplace_back(std::move(RepRes));
+        }
+
+        auto Aggregates = ComputeAggregates(Runs);
+        for (const auto& Aggregate : Aggregates)
+            PrintResult(Aggregate, NameWidth);
+
+        std::move(Runs.begin(), Runs.end(), std::back_inserter(Results));
+        std::move(Aggregates.begin(), Aggregates.end(), std::back_inserter(Results));
+    }
+
+    if (!Attribs.OutputFile.empty())
+    {
+        std::ofstream OutFile{Attribs.OutputFile};
+        if (!OutFile)
+        {
+            LOG_ERROR_MESSAGE("Failed to open output file '", Attribs.OutputFile, "'");
+            return -1;
+        }
+        WriteJSON(OutFile, Attribs, Results);
+        LOG_INFO_MESSAGE("Benchmark results were written to '", Attribs.OutputFile, "'");
+    }
+
+    return 0;
+}
+
+} // namespace Benchmark
+
+} // namespace Diligent
@@ -0,0 +1,115 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+#include "ArchiveFileImpl.hpp"
+#include "FileWrapper.hpp"
+#include "FileSystem.hpp"
+#include "FastRand.hpp"
+
+#include "BenchmarkFramework.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+// Reads random 64 KB blocks of the archive file from multiple threads concurrently.
+// The argument selects the access method: 0 - Read(), 1 - Map().
+void ArchiveFile_MultithreadedRead(State& St)
+{
+    const char*      Path       = "ArchiveFileBenchmark.bin";
+    constexpr size_t FileSize   = size_t{4} << 20;
+    constexpr size_t ReadSize   = size_t{64} << 10;
+    constexpr Uint32 NumReads   = 64;
+    const Uint32     NumThreads = std::max(4u, std::thread::hardware_concurrency());
+    const bool       UseMap     = St.GetArg() != 0;
+
+    {
+        std::vector<Uint8> Data(FileSize);
+        for (size_t i = 0; i < Data.size(); ++i)
+            Data[i] = static_cast<Uint8>((i * 7) ^ (i >> 8));
+
+        FileWrapper File{Path, EFileAccessMode::Overwrite};
+        if (!File || !File->Write(Data.data(), Data.size()))
+        {
+            St.SkipWithMessage("Failed to create the archive file");
+            return;
+        }
+    }
+
+    auto pArchive = ArchiveFileImpl::Create(Path);
+    if (!pArchive)
+    {
+        St.SkipWithMessage("Failed to open the archive file");
+        FileSystem::DeleteFile(Path);
+        return;
+    }
+    // Map() falls back to reading the data into a blob when the file is not memory-mapped
+    auto* pFileArchive = ClassPtrCast<ArchiveFileImpl>(pArchive.RawPtr());
+
+    std::vector<std::thread> Threads(NumThreads);
+    while (St.KeepRunning())
+    {
+        for (Uint32 t = 0; t < NumThreads; ++t)
+        {
+            Threads[t] = std::thread{
+                [&, t]() {
+                    FastRandInt        Rnd{t, 0, static_cast<int>((FileSize - ReadSize) / 256)};
+                    std::vector<Uint8> Buffer(ReadSize);
+                    for (Uint32 i = 0; i < NumReads; ++i)
+                    {
+                        const auto Offset = static_cast<size_t>(Rnd()) * 256;
+                        if (UseMap)
+                        {
+                            auto pBlob = pFileArchive->Map(Offset, ReadSize);
+                            DoNotOptimize(pBlob);
+                        }
+                        else
+                        {
+                            pArchive->Read(Offset, ReadSize, Buffer.data());
+                            DoNotOptimize(Buffer.data());
+                        }
+                    }
+                } //
+            };
+        }
+        for (auto& Thread : Threads)
+            Thread.join();
+    }
+    St.SetBytesProcessed(St.GetIterations() * NumThreads * NumReads * ReadSize);
+
+    pArchive.Release();
+    FileSystem::DeleteFile(Path);
+}
+DILIGENT_BENCHMARK_ARGS(ArchiveFile_MultithreadedRead, 0, 1);
+
+} // namespace
@@ -0,0 +1,121 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "BasicMath.hpp"
+
+#include "BenchmarkFramework.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+constexpr size_t NumMatrices = 256;
+
+std::vector<float4x4> GenerateMatrices()
+{
+    std::vector<float4x4> Matrices(NumMatrices);
+    for (size_t i = 0; i < NumMatrices; ++i)
+    {
+        const auto Angle = static_cast<float>(i) * 0.01f;
+        Matrices[i]      = float4x4::RotationY(Angle) * float4x4::RotationX(Angle * 0.5f) * float4x4::Translation(1.f, static_cast<float>(i), -2.f);
+    }
+    return Matrices;
+}
+
+void float4x4_Multiply(State& St)
+{
+    const auto Matrices = GenerateMatrices();
+    while (St.KeepRunning())
+    {
+        float4x4 Result = float4x4::Identity();
+        for (const auto& M : Matrices)
+            Result = Result * M;
+        DoNotOptimize(Result);
+    }
+    St.SetItemsProcessed(St.GetIterations() * NumMatrices);
+}
+DILIGENT_BENCHMARK(float4x4_Multiply);
+
+
+void float4x4_Inverse(State& St)
+{
+    const auto Matrices = GenerateMatrices();
+    while (St.KeepRunning())
+    {
+        for (const auto& M : Matrices)
+        {
+            auto Inv = M.Inverse();
+            DoNotOptimize(Inv);
+        }
+    }
+    St.SetItemsProcessed(St.GetIterations() * NumMatrices);
+}
+DILIGENT_BENCHMARK(float4x4_Inverse);
+
+
+void float4x4_Transpose(State& St)
+{
+    const auto Matrices = GenerateMatrices();
+    while (St.KeepRunning())
+    {
+        for (const auto& M : Matrices)
+        {
+            auto T = M.Transpose();
+            DoNotOptimize(T);
+        }
+    }
+    St.SetItemsProcessed(St.GetIterations() * NumMatrices);
+}
+DILIGENT_BENCHMARK(float4x4_Transpose);
+
+
+void float4_Transform(State& St)
+{
+    const auto Matrices = GenerateMatrices();
+    const auto M        = Matrices[NumMatrices / 2];
+
+    std::vector<float4> Vectors(1024);
+    for (size_t i = 0; i < Vectors.size(); ++i)
+        Vectors[i] = float4{static_cast<float>(i), 1.f, -static_cast<float>(i), 1.f};
+
+    while (St.KeepRunning())
+    {
+        for (const auto& V : Vectors)
+        {
+            auto Res = V * M;
+            DoNotOptimize(Res);
+        }
+    }
+    St.SetItemsProcessed(St.GetIterations() * Vectors.size());
+}
+DILIGENT_BENCHMARK(float4_Transform);
+
+} // namespace
@@ -0,0 +1,137 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+#include "FixedBlockMemoryAllocator.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "BenchmarkFramework.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+constexpr size_t NumBlocks = 1024;
+
+// Allocates and releases NumBlocks blocks of the size given by the argument.
+void FixedBlockMemoryAllocator_AllocFree(State& St)
+{
+    FixedBlockMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator(), static_cast<size_t>(St.GetArg()), 256};
+
+    std::vector<void*> Blocks(NumBlocks);
+    while (St.KeepRunning())
+    {
+        for (auto& pBlock : Blocks)
+        {
+            pBlock = Allocator.Allocate(static_cast<size_t>(St.GetArg()), "Benchmark block", __FILE__, __LINE__);
+            DoNotOptimize(pBlock);
+        }
+        for (auto* pBlock : Blocks)
+            Allocator.Free(pBlock);
+    }
+    St.SetItemsProcessed(St.GetIterations() * NumBlocks * 2);
+}
+DILIGENT_BENCHMARK_ARGS(FixedBlockMemoryAllocator_AllocFree, 16, 64, 256);
+
+
+// Interleaves allocations and releases so that the allocator always reuses recently freed blocks.
+void FixedBlockMemoryAllocator_Interleaved(State& St)
+{
+    FixedBlockMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator(), 64, 256, ~Uint32{0}, static_cast<Uint32>(St.GetArg())};
+
+    std::vector<void*> Blocks(NumBlocks);
+    for (auto& pBlock : Blocks)
+        pBlock = Allocator.Allocate(64, "Benchmark block", __FILE__, __LINE__);
+
+    size_t Idx = 0;
+    while (St.KeepRunning())
+    {
+        for (size_t i = 0; i < NumBlocks; ++i)
+        {
+            // Visit blocks in a scattered order
+            Idx = (Idx + 389) % NumBlocks;
+            Allocator.Free(Blocks[Idx]);
+            Blocks[Idx] = Allocator.Allocate(64, "Benchmark block", __FILE__, __LINE__);
+            DoNotOptimize(Blocks[Idx]);
+        }
+    }
+    St.SetItemsProcessed(St.GetIterations() * NumBlocks * 2);
+
+    for (auto* pBlock : Blocks)
+        Allocator.Free(pBlock);
+}
+// The argument is the thread cache size; zero disables the cache.
+DILIGENT_BENCHMARK_ARGS(FixedBlockMemoryAllocator_Interleaved, 0, 64);
+
+// Allocates and releases blocks from multiple threads concurrently, which measures the
+// contention on the allocator. The argument is the thread cache size; zero disables the cache.
+void FixedBlockMemoryAllocator_Multithreaded(State& St)
+{
+    const Uint32     NumThreads         = std::max(4u, std::thread::hardware_concurrency());
+    constexpr Uint32 NumAllocsPerThread = 32;
+    constexpr Uint32 NumRounds          = 64;
+
+    FixedBlockMemoryAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator(), 64, 256, 4, static_cast<Uint32>(St.GetArg())};
+
+    std::vector<std::thread> Threads(NumThreads);
+    while (St.KeepRunning())
+    {
+        for (auto& Thread : Threads)
+        {
+            Thread = std::thread{
+                [&Allocator]() {
+                    void* Blocks[NumAllocsPerThread];
+                    for (Uint32 r = 0; r < NumRounds; ++r)
+                    {
+                        for (auto& pBlock : Blocks)
+                        {
+                            pBlock = Allocator.Allocate(64, "Benchmark block", __FILE__, __LINE__);
+                            DoNotOptimize(pBlock);
+                        }
+                        // Release blocks in interleaved order
+                        for (Uint32 s = 0; s < 3; ++s)
+                        {
+                            for (Uint32 a = s; a < NumAllocsPerThread; a += 3)
+                                Allocator.Free(Blocks[a]);
+                        }
+                    }
+                } //
+            };
+        }
+        for (auto& Thread : Threads)
+            Thread.join();
+    }
+    St.SetItemsProcessed(St.GetIterations() * NumThreads * NumRounds * NumAllocsPerThread * 2);
+}
+DILIGENT_BENCHMARK_ARGS(FixedBlockMemoryAllocator_Multithreaded, 0, 64);
+
+} // namespace
@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "HashUtils.hpp"
+
+#include "BenchmarkFramework.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+std::vector<std::string> GenerateKeys(size_t NumKeys)
+{
+    std::vector<std::string> Keys(NumKeys);
+    for (size_t i = 0; i < NumKeys; ++i)
+        Keys[i] = "g_ShaderResourceVariable_" + std::to_string(i * 7919);
+    return Keys;
+}
+
+// Looks up every key in the map of the size given by the argument.
+void HashMapStringKey_Find(State& St)
+{
+    const auto Keys = GenerateKeys(static_cast<size_t>(St.GetArg()));
+
+    std::unordered_map<HashMapStringKey, size_t, HashMapStringKey::Hasher> Map;
+    for (size_t i = 0; i < Keys.size(); ++i)
+        Map.emplace(HashMapStringKey{Keys[i]}, i);
+
+    while (St.KeepRunning())
+    {
+        for (const auto& Key : Keys)
+        {
+            // The key does not copy the string, so this is what a typical lookup by name costs
+            auto it = Map.find(Key.c_str());
+            DoNotOptimize(it);
+        }
+    }
+    St.SetItemsProcessed(St.GetIterations() * Keys.size());
+}
+DILIGENT_BENCHMARK_ARGS(HashMapStringKey_Find, 64, 4096);
+
+
+// Creates owning keys, which copies the strings and computes the hashes.
+void HashMapStringKey_Create(State& St)
+{
+    const auto Keys = GenerateKeys(256);
+    while (St.KeepRunning())
+    {
+        for (const auto& Key : Keys)
+        {
+            HashMapStringKey StrKey{Key.c_str(), true};
+            DoNotOptimize(StrKey.GetHash());
+        }
+    }
+    St.SetItemsProcessed(St.GetIterations() * Keys.size());
+}
+DILIGENT_BENCHMARK(HashMapStringKey_Create);
+
+
+// Hashes a data block of the size given by the argument.
+void ComputeContentHash_Throughput(State& St)
+{
+    std::vector<Uint8> Data(static_cast<size_t>(St.GetArg()));
+    for (size_t i = 0; i < Data.size(); ++i)
+        Data[i] = static_cast<Uint8>(i * 31 + 7);
+
+    while (St.KeepRunning())
+    {
+        auto Hash = ComputeContentHash(Data.data(), Data.size());
+        DoNotOptimize(Hash);
+    }
+    St.SetBytesProcessed(St.GetIterations() * Data.size());
+}
+DILIGENT_BENCHMARK_ARGS(ComputeContentHash_Throughput, 64, 65536);
+
+} // namespace
@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "CountingMemoryAllocator.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace Diligent
+{
+
+namespace Benchmark
+{
+
+CountingMemoryAllocator& CountingMemoryAllocator::GetAllocator()
+{
+    // The allocator is used by the global operator new, so it must be available
+    // before any static object is constructed and must never be destroyed.
+    static CountingMemoryAllocator* const pAllocator = new (malloc(sizeof(CountingMemoryAllocator))) CountingMemoryAllocator{};
+    return *pAllocator;
+}
+
+void* CountingMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+{
+    m_NumAllocations.fetch_add(1, std::memory_order_relaxed);
+    m_AllocatedBytes.fetch_add(Size, std::memory_order_relaxed);
+    // Memory can't be allocated through the default raw allocator as it uses operator new
+    return malloc(Size != 0 ? Size : 1);
+}
+
+void CountingMemoryAllocator::Free(void* Ptr)
+{
+    free(Ptr);
+}
+
+} // namespace Benchmark
+
+} // namespace Diligent
+
+
+void* operator new(size_t Size)
+{
+    auto* Ptr = Diligent::Benchmark::CountingMemoryAllocator::GetAllocator().Allocate(Size, "<global new>", __FILE__, __LINE__);
+    if (Ptr == nullptr)
+        throw std::bad_alloc{};
+    return Ptr;
+}
+
+void* operator new[](size_t Size)
+{
+    return operator new(Size);
+}
+
+void* operator new(size_t Size, const std::nothrow_t&) noexcept
+{
+    return Diligent::Benchmark::CountingMemoryAllocator::GetAllocator().Allocate(Size, "<global new>", __FILE__, __LINE__);
+}
+
+void* operator new[](size_t Size, const std::nothrow_t&) noexcept
+{
+    return Diligent::Benchmark::CountingMemoryAllocator::GetAllocator().Allocate(Size, "<global new>", __FILE__, __LINE__);
+}
+
+void operator delete(void* Ptr) noexcept
+{
+    Diligent::Benchmark::CountingMemoryAllocator::GetAllocator().Free(Ptr);
+}
+
+void operator delete[](void* Ptr) noexcept
+{
+    Diligent::Benchmark::CountingMemoryAllocator::GetAllocator().Free(Ptr);
+}
+
+void operator delete(void* Ptr, const std::nothrow_t&) noexcept
+{
+    Diligent::Benchmark::CountingMemoryAllocator::GetAllocator().Free(Ptr);
+}
+
+void operator delete[](void* Ptr, const std::nothrow_t&) noexcept
+{
+    Diligent::Benchmark::CountingMemoryAllocator::GetAllocator().Free(Ptr);
+}
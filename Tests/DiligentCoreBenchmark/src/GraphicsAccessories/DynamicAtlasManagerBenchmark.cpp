@@ -0,0 +1,89 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "DynamicAtlasManager.hpp"
+
+#include "BenchmarkFramework.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+// Keeps the atlas partially filled with regions of random sizes and repeatedly replaces
+// random regions, which exercises the free region search, splitting and merging.
+// The argument is the atlas dimension.
+void DynamicAtlasManager_AllocFree(State& St)
+{
+    const auto AtlasDim = static_cast<Uint32>(St.GetArg());
+
+    constexpr size_t NumRegions  = 512;
+    constexpr size_t NumReplaced = 128;
+
+    DynamicAtlasManager Mgr{AtlasDim, AtlasDim};
+
+    Uint32 Seed   = 0x6789u;
+    auto   Random = [&Seed]() {
+        Seed = Seed * 1664525u + 1013904223u;
+        return Seed >> 8;
+    };
+    auto Allocate = [&]() {
+        const auto Width  = 1 + Random() % 32;
+        const auto Height = 1 + Random() % 32;
+        return Mgr.Allocate(Width, Height);
+    };
+
+    std::vector<DynamicAtlasManager::Region> Regions;
+    Regions.reserve(NumRegions);
+    for (size_t i = 0; i < NumRegions; ++i)
+        Regions.emplace_back(Allocate());
+
+    while (St.KeepRunning())
+    {
+        for (size_t i = 0; i < NumReplaced; ++i)
+        {
+            auto& R = Regions[Random() % NumRegions];
+            if (!R.IsEmpty())
+                Mgr.Free(std::move(R));
+            R = Allocate();
+            DoNotOptimize(R);
+        }
+    }
+    St.SetItemsProcessed(St.GetIterations() * NumReplaced * 2);
+
+    for (auto& R : Regions)
+    {
+        if (!R.IsEmpty())
+            Mgr.Free(std::move(R));
+    }
+}
+DILIGENT_BENCHMARK_ARGS(DynamicAtlasManager_AllocFree, 512, 2048);
+
+} // namespace
@@ -0,0 +1,66 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "RingBuffer.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "BenchmarkFramework.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+// Simulates the dynamic upload heap usage pattern: every frame makes a number of small aligned
+// allocations, and the frame is released when the GPU is two frames behind.
+void RingBuffer_Frame(State& St)
+{
+    constexpr RingBuffer::OffsetType MaxSize               = 16 << 20;
+    constexpr size_t                 NumAllocationsInFrame = 1024;
+
+    RingBuffer Ring{MaxSize, DefaultRawMemoryAllocator::GetAllocator()};
+
+    Uint64 FenceValue = 0;
+    while (St.KeepRunning())
+    {
+        for (size_t i = 0; i < NumAllocationsInFrame; ++i)
+        {
+            auto Offset = Ring.Allocate(64 + (i % 8) * 32, 256);
+            DoNotOptimize(Offset);
+        }
+        Ring.FinishCurrentFrame(++FenceValue);
+        if (FenceValue > 2)
+            Ring.ReleaseCompletedFrames(FenceValue - 2);
+    }
+    St.SetItemsProcessed(St.GetIterations() * NumAllocationsInFrame);
+
+    Ring.ReleaseCompletedFrames(FenceValue);
+}
+DILIGENT_BENCHMARK(RingBuffer_Frame);
+
+} // namespace
@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "VariableSizeAllocationsManager.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "BenchmarkFramework.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+// Keeps a working set of allocations of random sizes and alignments and repeatedly replaces
+// random allocations with new ones, which exercises both the search and the free block merging.
+// The argument selects the algorithm (see VariableSizeAllocationsManager::ALGORITHM).
+void VariableSizeAllocationsManager_AllocFree(State& St)
+{
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+
+    constexpr OffsetType MaxSize        = OffsetType{64} << 20;
+    constexpr size_t     NumAllocations = 1024;
+    constexpr size_t     NumReplaced    = 256;
+
+    VariableSizeAllocationsManager Mgr{MaxSize, DefaultRawMemoryAllocator::GetAllocator(), static_cast<VariableSizeAllocationsManager::ALGORITHM>(St.GetArg())};
+
+    Uint32 Seed   = 0x12345u;
+    auto   Random = [&Seed]() {
+        // Linear congruential generator keeps the sequence identical across runs and platforms
+        Seed = Seed * 1664525u + 1013904223u;
+        return Seed >> 8;
+    };
+    auto Allocate = [&]() {
+        const auto Size      = OffsetType{16} + (Random() % 16384);
+        const auto Alignment = OffsetType{1} << (Random() % 9);
+        return Mgr.Allocate(Size, Alignment);
+    };
+
+    std::vector<VariableSizeAllocationsManager::Allocation> Allocations;
+    Allocations.reserve(NumAllocations);
+    for (size_t i = 0; i < NumAllocations; ++i)
+        Allocations.emplace_back(Allocate());
+
+    while (St.KeepRunning())
+    {
+        for (size_t i = 0; i < NumReplaced; ++i)
+        {
+            auto& Alloc = Allocations[Random() % NumAllocations];
+            if (Alloc.IsValid())
+                Mgr.Free(std::move(Alloc));
+            Alloc = Allocate();
+            DoNotOptimize(Alloc);
+        }
+    }
+    St.SetItemsProcessed(St.GetIterations() * NumReplaced * 2);
+
+    for (auto& Alloc : Allocations)
+    {
+        if (Alloc.IsValid())
+            Mgr.Free(std::move(Alloc));
+    }
+}
+DILIGENT_BENCHMARK_ARGS(VariableSizeAllocationsManager_AllocFree,
+                        VariableSizeAllocationsManager::ALGORITHM_ORDERED_MAPS,
+                        VariableSizeAllocationsManager::ALGORITHM_TLSF);
+
+} // namespace
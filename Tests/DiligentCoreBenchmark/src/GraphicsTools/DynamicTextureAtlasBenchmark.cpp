@@ -0,0 +1,119 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <thread>
+#include <atomic>
+
+#include "DynamicTextureAtlas.h"
+#include "RefCntAutoPtr.hpp"
+
+#include "BenchmarkFramework.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+// Allocates and releases atlas regions from multiple threads concurrently.
+// Only the CPU-side allocation is measured, so the atlas texture is never created.
+// The argument is the number of threads.
+void DynamicTextureAtlas_AllocFree(State& St)
+{
+    const auto NumThreads = static_cast<Uint32>(St.GetArg());
+
+    constexpr Uint32 AtlasDim          = 1024;
+    constexpr Uint32 AllocsPerThread   = 256;
+    constexpr Uint32 MaxSlicePerThread = 2;
+
+    DynamicTextureAtlasCreateInfo CI;
+    CI.ExtraSliceCount = 2;
+    CI.MaxSliceCount   = NumThreads * MaxSlicePerThread;
+    CI.Silent          = true;
+    CI.MinAlignment    = 16;
+    CI.Desc.Format     = TEX_FORMAT_RGBA8_UNORM;
+    CI.Desc.Name       = "Dynamic texture atlas benchmark";
+    CI.Desc.Type       = RESOURCE_DIM_TEX_2D_ARRAY;
+    CI.Desc.BindFlags  = BIND_SHADER_RESOURCE;
+    CI.Desc.Width      = AtlasDim;
+    CI.Desc.Height     = AtlasDim;
+    CI.Desc.ArraySize  = 1;
+
+    RefCntAutoPtr<IDynamicTextureAtlas> pAtlas;
+    CreateDynamicTextureAtlas(nullptr, CI, &pAtlas);
+    if (!pAtlas)
+    {
+        St.SkipWithMessage("Failed to create the atlas");
+        return;
+    }
+
+    std::atomic<Uint32>      NumFailedAllocs{0};
+    std::vector<std::thread> Threads(NumThreads);
+    while (St.KeepRunning())
+    {
+        for (Uint32 t = 0; t < NumThreads; ++t)
+        {
+            Threads[t] = std::thread{
+                [&](Uint32 ThreadId) {
+                    Uint32 Seed   = 0x1357u + ThreadId;
+                    auto   Random = [&Seed]() {
+                        Seed = Seed * 1664525u + 1013904223u;
+                        return 4 + (Seed >> 8) % 61;
+                    };
+
+                    std::vector<RefCntAutoPtr<ITextureAtlasSuballocation>> pAllocs(AllocsPerThread);
+                    for (auto& pAlloc : pAllocs)
+                    {
+                        pAtlas->Allocate(Random(), Random(), &pAlloc);
+                        if (!pAlloc)
+                            NumFailedAllocs.fetch_add(1);
+                    }
+
+                    // Release every other allocation first to fragment the atlas
+                    for (size_t i = 0; i < pAllocs.size(); i += 2)
+                        pAllocs[i].Release();
+                    for (size_t i = 1; i < pAllocs.size(); i += 2)
+                        pAllocs[i].Release();
+                },
+                t //
+            };
+        }
+        for (auto& Thread : Threads)
+            Thread.join();
+
+        if (NumFailedAllocs.load() != 0)
+        {
+            St.SkipWithMessage("Failed to allocate atlas regions");
+            break;
+        }
+    }
+    St.SetItemsProcessed(St.GetIterations() * NumThreads * AllocsPerThread * 2);
+}
+DILIGENT_BENCHMARK_ARGS(DynamicTextureAtlas_AllocFree, 1, 4);
+
+} // namespace
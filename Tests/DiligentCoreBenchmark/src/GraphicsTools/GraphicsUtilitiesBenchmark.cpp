@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+#include <algorithm>
+
+#include "GraphicsUtilities.h"
+#include "GraphicsAccessories.hpp"
+
+#include "BenchmarkFramework.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+// Generates the full mip chain of a 2048x2048 texture. The argument is the number of threads.
+void RunComputeMipChain(State& St, TEXTURE_FORMAT Format)
+{
+    constexpr Uint32 Width  = 2048;
+    constexpr Uint32 Height = 2048;
+
+    const auto NumMips = ComputeMipLevelsCount(Width, Height);
+
+    std::vector<std::vector<Uint8>> MipData(NumMips);
+    std::vector<void*>              pMipData(NumMips);
+    std::vector<size_t>             MipStrides(NumMips);
+    for (Uint32 mip = 0; mip < NumMips; ++mip)
+    {
+        MipStrides[mip] = std::max(Width >> mip, 1u) * 4;
+        MipData[mip].resize(MipStrides[mip] * std::max(Height >> mip, 1u));
+        pMipData[mip] = MipData[mip].data();
+    }
+
+    Uint32 Seed = 0x2468u;
+    for (auto& c : MipData[0])
+    {
+        Seed = Seed * 1664525u + 1013904223u;
+        c    = static_cast<Uint8>(Seed >> 24);
+    }
+
+    ComputeMipChainAttribs Attribs;
+    Attribs.Format      = Format;
+    Attribs.Width       = Width;
+    Attribs.Height      = Height;
+    Attribs.ppMipData   = pMipData.data();
+    Attribs.pMipStrides = MipStrides.data();
+    Attribs.NumThreads  = static_cast<Uint32>(St.GetArg());
+    while (St.KeepRunning())
+    {
+        ComputeMipChain(Attribs);
+        DoNotOptimize(MipData[1][0]);
+    }
+    St.SetBytesProcessed(St.GetIterations() * MipData[0].size());
+}
+
+void ComputeMipChain_RGBA8(State& St)
+{
+    RunComputeMipChain(St, TEX_FORMAT_RGBA8_UNORM);
+}
+DILIGENT_BENCHMARK_ARGS(ComputeMipChain_RGBA8, 1, 4);
+
+void ComputeMipChain_RGBA8_SRGB(State& St)
+{
+    RunComputeMipChain(St, TEX_FORMAT_RGBA8_UNORM_SRGB);
+}
+DILIGENT_BENCHMARK_ARGS(ComputeMipChain_RGBA8_SRGB, 1, 4);
+
+} // namespace
@@ -0,0 +1,272 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <vector>
+
+#include "HLSL2GLSLConverterImpl.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "../../../../Graphics/GraphicsEngine/include/DefaultShaderSourceStreamFactory.h"
+#include "FileWrapper.hpp"
+#include "FileSystem.hpp"
+
+#include "BenchmarkFramework.hpp"
+#include "CountingMemoryAllocator.hpp"
+#include "InlineShaders/BenchmarkShadersHLSL.h"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+HLSL2GLSLConverterImpl::ConversionAttribs GetConversionAttribs()
+{
+    HLSL2GLSLConverterImpl::ConversionAttribs Attribs;
+    Attribs.HLSLSource         = HLSL::Benchmark_LitShader.c_str();
+    Attribs.NumSymbols         = HLSL::Benchmark_LitShader.length();
+    Attribs.EntryPoint         = "PSMain";
+    Attribs.ShaderType         = SHADER_TYPE_PIXEL;
+    Attribs.IncludeDefinitions = true;
+    Attribs.InputFileName      = "Benchmark.hlsl";
+    return Attribs;
+}
+
+// Enables or disables the conversion result cache for the lifetime of the object
+class ScopedResultCacheState
+{
+public:
+    explicit ScopedResultCacheState(bool Enabled) :
+        m_Cache{HLSL2GLSLConverterImpl::GetInstance().GetResultCache()},
+        m_WasEnabled{m_Cache.IsEnabled()}
+    {
+        m_Cache.SetEnabled(Enabled);
+    }
+
+    ~ScopedResultCacheState()
+    {
+        m_Cache.SetEnabled(m_WasEnabled);
+    }
+
+private:
+    HLSL2GLSLConverterImpl::ResultCache& m_Cache;
+    const bool                           m_WasEnabled;
+};
+
+// Full conversion: tokenization, parsing and GLSL generation.
+void HLSL2GLSL_Convert(State& St)
+{
+    ScopedResultCacheState CacheState{false};
+
+    const auto& Converter = HLSL2GLSLConverterImpl::GetInstance();
+    auto        Attribs   = GetConversionAttribs();
+
+    ScopedAllocationCounter AllocCounter{St};
+    while (St.KeepRunning())
+    {
+        auto GLSL = Converter.Convert(Attribs);
+        if (GLSL.empty())
+        {
+            St.SkipWithMessage("Failed to convert the shader");
+            break;
+        }
+        DoNotOptimize(GLSL);
+    }
+    St.SetBytesProcessed(St.GetIterations() * Attribs.NumSymbols);
+}
+DILIGENT_BENCHMARK(HLSL2GLSL_Convert);
+
+
+// Conversion from the previously created stream, which reuses the tokenized source.
+// This is what happens when multiple entry points are converted from the same file.
+void HLSL2GLSL_ConvertFromStream(State& St)
+{
+    ScopedResultCacheState CacheState{false};
+
+    const auto& Converter = HLSL2GLSLConverterImpl::GetInstance();
+    auto        Attribs   = GetConversionAttribs();
+
+    RefCntAutoPtr<IHLSL2GLSLConversionStream> pStream;
+    Attribs.ppConversionStream = pStream.RawDblPtr();
+
+    ScopedAllocationCounter AllocCounter{St};
+    while (St.KeepRunning())
+    {
+        auto GLSL = Converter.Convert(Attribs);
+        if (GLSL.empty())
+        {
+            St.SkipWithMessage("Failed to convert the shader");
+            break;
+        }
+        DoNotOptimize(GLSL);
+    }
+    St.SetBytesProcessed(St.GetIterations() * Attribs.NumSymbols);
+}
+DILIGENT_BENCHMARK(HLSL2GLSL_ConvertFromStream);
+
+
+// Conversion that hits the result cache.
+void HLSL2GLSL_ConvertCached(State& St)
+{
+    ScopedResultCacheState CacheState{true};
+
+    const auto& Converter = HLSL2GLSLConverterImpl::GetInstance();
+    auto        Attribs   = GetConversionAttribs();
+    // Warm up the cache
+    if (Converter.Convert(Attribs).empty())
+    {
+        St.SkipWithMessage("Failed to convert the shader");
+        return;
+    }
+
+    ScopedAllocationCounter AllocCounter{St};
+    while (St.KeepRunning())
+    {
+        auto GLSL = Converter.Convert(Attribs);
+        DoNotOptimize(GLSL);
+    }
+    St.SetBytesProcessed(St.GetIterations() * Attribs.NumSymbols);
+}
+DILIGENT_BENCHMARK(HLSL2GLSL_ConvertCached);
+
+
+static const char* const IncludeBenchmarkMainFile = "HLSL2GLSLBenchmark_Main.hlsl";
+
+// Shader source files of the include-heavy conversion benchmark.
+// The files are written to the working directory and removed when the object is destroyed.
+class IncludeBenchmarkFiles
+{
+public:
+    static constexpr Uint32 NumIncludes = 30;
+
+
+    IncludeBenchmarkFiles()
+    {
+        std::string MainSource;
+        for (Uint32 i = 0; i < NumIncludes; ++i)
+        {
+            const auto IncludeName = "HLSL2GLSLBenchmark_Include" + std::to_string(i) + ".fxh";
+            const auto Index       = std::to_string(i);
+
+            std::string IncludeSource;
+            IncludeSource += "cbuffer Constants" + Index + "\n{\n    float4 g_Scale" + Index + ";\n};\n\n";
+            IncludeSource += "float4 Transform" + Index + "(float4 Value)\n{\n    return Value * g_Scale" + Index + " + float4(" + Index + ".0, 0.0, 0.0, 1.0);\n}\n";
+            if (!WriteFile(IncludeName, IncludeSource))
+                return;
+
+            MainSource += "#include \"" + IncludeName + "\"\n";
+        }
+
+        MainSource += "\nvoid PSMain(in float4 Pos : SV_Position, out float4 Color : SV_Target)\n{\n    Color = Pos;\n";
+        for (Uint32 i = 0; i < NumIncludes; ++i)
+            MainSource += "    Color = Transform" + std::to_string(i) + "(Color);\n";
+        MainSource += "}\n";
+
+        m_IsValid = WriteFile(IncludeBenchmarkMainFile, MainSource);
+    }
+
+    ~IncludeBenchmarkFiles()
+    {
+        for (const auto& FileName : m_FileNames)
+            FileSystem::DeleteFile(FileName.c_str());
+    }
+
+    bool IsValid() const { return m_IsValid; }
+
+private:
+    bool WriteFile(const std::string& FileName, const std::string& Source)
+    {
+        FileWrapper File{FileName.c_str(), EFileAccessMode::Overwrite};
+        if (!File)
+            return false;
+        m_FileNames.push_back(FileName);
+        return File->Write(Source.data(), Source.size());
+    }
+
+    std::vector<std::string> m_FileNames;
+    bool                     m_IsValid = false;
+};
+
+// Conversion of a shader that includes many files. Every included file is requested
+// from the shader source stream factory on each conversion.
+//  0 - default factory: every file is looked up and opened
+//  1 - caching factory that checks the file modification time on every request
+//  2 - caching factory with a warm cache: no file system calls
+void HLSL2GLSL_ConvertWithIncludes(State& St)
+{
+    ScopedResultCacheState CacheState{false};
+
+    IncludeBenchmarkFiles Files;
+    if (!Files.IsValid())
+    {
+        St.SkipWithMessage("Failed to write the shader source files");
+        return;
+    }
+
+    const auto Mode = St.GetArg();
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pStreamFactory;
+    if (Mode == 0)
+        CreateDefaultShaderSourceStreamFactory(nullptr, &pStreamFactory);
+    else
+        CreateCachingShaderSourceStreamFactory(nullptr, Mode == 1 ? 0 : ~Uint32{0}, Uint64{16} << 20, &pStreamFactory);
+
+    const auto& Converter = HLSL2GLSLConverterImpl::GetInstance();
+
+    HLSL2GLSLConverterImpl::ConversionAttribs Attribs;
+    Attribs.pSourceStreamFactory = pStreamFactory;
+    Attribs.InputFileName        = IncludeBenchmarkMainFile;
+    Attribs.EntryPoint           = "PSMain";
+    Attribs.ShaderType           = SHADER_TYPE_PIXEL;
+    Attribs.IncludeDefinitions   = true;
+
+    // Warm up the cache
+    if (Converter.Convert(Attribs).empty())
+    {
+        St.SkipWithMessage("Failed to convert the shader");
+        return;
+    }
+
+    const auto StartStats = GetShaderSourceStreamFactoryStats(pStreamFactory);
+    while (St.KeepRunning())
+    {
+        auto GLSL = Converter.Convert(Attribs);
+        DoNotOptimize(GLSL);
+    }
+    St.SetItemsProcessed(St.GetIterations());
+
+    const auto EndStats = GetShaderSourceStreamFactoryStats(pStreamFactory);
+    if (St.GetIterations() > 0)
+    {
+        const auto NumCalls = EndStats.NumFileSystemCalls - StartStats.NumFileSystemCalls;
+        LOG_INFO_MESSAGE("HLSL2GLSL_ConvertWithIncludes/", Mode, ": ",
+                         static_cast<double>(NumCalls) / static_cast<double>(St.GetIterations()), " file system calls per conversion");
+    }
+}
+DILIGENT_BENCHMARK_ARGS(HLSL2GLSL_ConvertWithIncludes, 0, 1, 2);
+
+} // namespace
@@ -0,0 +1,131 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <string>
+#include <vector>
+
+#include "SPIRVShaderResources.hpp"
+#include "GLSLangUtils.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "BenchmarkFramework.hpp"
+#include "InlineShaders/BenchmarkShadersHLSL.h"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+std::vector<uint32_t> CompileBenchmarkShader(const char* EntryPoint, SHADER_TYPE ShaderType)
+{
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.Source          = HLSL::Benchmark_LitShader.c_str();
+    ShaderCI.SourceLength    = HLSL::Benchmark_LitShader.length();
+    ShaderCI.SourceLanguage  = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.EntryPoint      = EntryPoint;
+    ShaderCI.Desc.ShaderType = ShaderType;
+    ShaderCI.Desc.Name       = "SPIRV reflection benchmark shader";
+
+    GLSLangUtils::InitializeGlslang();
+    auto SPIRV = GLSLangUtils::HLSLtoSPIRV(ShaderCI, nullptr, nullptr);
+    GLSLangUtils::FinalizeGlslang();
+
+    return {SPIRV.begin(), SPIRV.end()};
+}
+
+// Reflects the SPIR-V bytecode, which is what every shader creation in the Vulkan backend does.
+// The argument indicates whether shader stage inputs are loaded (as for vertex shaders).
+void SPIRVShaderResources_Reflect(State& St)
+{
+    const auto LoadStageInputs = St.GetArg() != 0;
+    const auto ShaderType      = LoadStageInputs ? SHADER_TYPE_VERTEX : SHADER_TYPE_PIXEL;
+    const auto SPIRV           = CompileBenchmarkShader(LoadStageInputs ? "VSMain" : "PSMain", ShaderType);
+    if (SPIRV.empty())
+    {
+        St.SkipWithMessage("Failed to compile the shader");
+        return;
+    }
+
+    ShaderDesc Desc;
+    Desc.Name       = "SPIRV reflection benchmark shader";
+    Desc.ShaderType = ShaderType;
+
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+    while (St.KeepRunning())
+    {
+        std::string          EntryPoint;
+        SPIRVShaderResources Resources{Allocator, SPIRV, Desc, "_sampler", LoadStageInputs, EntryPoint};
+        DoNotOptimize(Resources.GetTotalResources());
+    }
+    St.SetBytesProcessed(St.GetIterations() * SPIRV.size() * sizeof(SPIRV[0]));
+}
+DILIGENT_BENCHMARK_ARGS(SPIRVShaderResources_Reflect, 0, 1);
+
+
+// Validates and loads the serialized resources, which is what shader creation does
+// when pre-reflected data is provided through ShaderCreateInfo::pReflectionData.
+void SPIRVShaderResources_Load(State& St)
+{
+    const auto LoadStageInputs = St.GetArg() != 0;
+    const auto ShaderType      = LoadStageInputs ? SHADER_TYPE_VERTEX : SHADER_TYPE_PIXEL;
+    const auto SPIRV           = CompileBenchmarkShader(LoadStageInputs ? "VSMain" : "PSMain", ShaderType);
+    if (SPIRV.empty())
+    {
+        St.SkipWithMessage("Failed to compile the shader");
+        return;
+    }
+
+    ShaderDesc Desc;
+    Desc.Name       = "SPIRV reflection benchmark shader";
+    Desc.ShaderType = ShaderType;
+
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    std::vector<Uint8> Data;
+    {
+        std::string          EntryPoint;
+        SPIRVShaderResources Resources{Allocator, SPIRV, Desc, "_sampler", LoadStageInputs, EntryPoint};
+        Resources.Serialize(SPIRV, EntryPoint, Data);
+    }
+
+    while (St.KeepRunning())
+    {
+        if (!SPIRVShaderResources::IsSerializedDataValid(Data.data(), Data.size(), SPIRV, ShaderType, LoadStageInputs))
+        {
+            St.SkipWithMessage("Serialized data is not valid");
+            break;
+        }
+        std::string          EntryPoint;
+        SPIRVShaderResources Resources{Allocator, Data.data(), Data.size(), Desc, "_sampler", EntryPoint};
+        DoNotOptimize(Resources.GetTotalResources());
+    }
+    St.SetBytesProcessed(St.GetIterations() * SPIRV.size() * sizeof(SPIRV[0]));
+}
+DILIGENT_BENCHMARK_ARGS(SPIRVShaderResources_Load, 0, 1);
+
+} // namespace
@@ -0,0 +1,102 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+#include "BenchmarkFramework.hpp"
+#include "TestingEnvironment.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Benchmark;
+
+namespace
+{
+
+const char* GetDeviceTypeName(RENDER_DEVICE_TYPE DeviceType)
+{
+    switch (DeviceType)
+    {
+        // clang-format off
+        case RENDER_DEVICE_TYPE_D3D11:  return "d3d11";
+        case RENDER_DEVICE_TYPE_D3D12:  return "d3d12";
+        case RENDER_DEVICE_TYPE_GL:     return "gl";
+        case RENDER_DEVICE_TYPE_GLES:   return "gles";
+        case RENDER_DEVICE_TYPE_VULKAN: return "vk";
+        case RENDER_DEVICE_TYPE_METAL:  return "mtl";
+        default:                        return "unknown";
+            // clang-format on
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    RunAttribs Attribs;
+    bool       ListOnly = false;
+    if (!ParseCommandLine(argc, argv, Attribs, ListOnly))
+        return -1;
+
+    if (ListOnly)
+    {
+        for (const auto& Info : GetRegisteredBenchmarks())
+        {
+            std::cout << Info.Name << (Info.RequiresDevice ? " (requires --mode)" : "") << std::endl;
+        }
+        return 0;
+    }
+
+    // API scenarios only run when the device type is given in the command line, e.g.
+    // --mode=vk with the Vulkan software rasterizer or --mode=gl with llvmpipe.
+    bool DeviceRequested = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strncmp(argv[i], "--mode=", 7) == 0)
+            DeviceRequested = true;
+    }
+
+    std::unique_ptr<Testing::TestingEnvironment> pEnv;
+    if (DeviceRequested)
+    {
+        pEnv.reset(Testing::TestingEnvironment::Initialize(argc, argv));
+        if (!pEnv)
+            return -1;
+
+        const auto& DeviceInfo  = pEnv->GetDevice()->GetDeviceInfo();
+        const auto& AdapterInfo = pEnv->GetDevice()->GetAdapterInfo();
+
+        Attribs.DeviceAvailable = true;
+        Attribs.Context.emplace_back("device_type", GetDeviceTypeName(DeviceInfo.Type));
+        Attribs.Context.emplace_back("adapter", AdapterInfo.Description);
+    }
+
+    const auto ret_val = RunBenchmarks(Attribs);
+    std::cout << "\n\n\n";
+    return ret_val;
+}
@@ -26,6 +26,9 @@
  */
 
 #include <array>
+#include <thread>
+#include <vector>
+#include <algorithm>
 
 #include "DefaultRawMemoryAllocator.hpp"
 #include "FixedBlockMemoryAllocator.hpp"
@@ -124,6 +127,100 @@ TEST(Common_FixedBlockMemoryAllocator, UnalignedSize)
     }
 }
 
+TEST(Common_FixedBlockMemoryAllocator, PageReclamation)
+{
+    constexpr Uint32 AllocSize             = 24;
+    constexpr Uint32 NumAllocationsPerPage = 8;
+    constexpr Uint32 NumPages              = 4;
+    constexpr Uint32 MaxEmptyPages         = 1;
+
+    FixedBlockMemoryAllocator TestAllocator(DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage, MaxEmptyPages);
+
+    std::vector<void*> Allocations(NumAllocationsPerPage * NumPages);
+    for (auto& Alloc : Allocations)
+        Alloc = TestAllocator.Allocate(AllocSize, "Page reclamation test", __FILE__, __LINE__);
+    EXPECT_EQ(TestAllocator.GetNumPages(), size_t{NumPages});
+
+    for (auto* Alloc : Allocations)
+        TestAllocator.Free(Alloc);
+    EXPECT_EQ(TestAllocator.GetNumPages(), size_t{MaxEmptyPages});
+
+    for (auto& Alloc : Allocations)
+        Alloc = TestAllocator.Allocate(AllocSize, "Page reclamation test", __FILE__, __LINE__);
+    EXPECT_EQ(TestAllocator.GetNumPages(), size_t{NumPages});
+
+    for (auto* Alloc : Allocations)
+        TestAllocator.Free(Alloc);
+}
+
+TEST(Common_FixedBlockMemoryAllocator, Alignment)
+{
+    FixedBlockMemoryAllocator Allocator8(DefaultRawMemoryAllocator::GetAllocator(), 24, 16);
+    FixedBlockMemoryAllocator Allocator16(DefaultRawMemoryAllocator::GetAllocator(), 48, 16);
+
+    std::array<void*, 16> Allocations8  = {};
+    std::array<void*, 16> Allocations16 = {};
+    for (size_t i = 0; i < Allocations8.size(); ++i)
+    {
+        Allocations8[i]  = Allocator8.Allocate(24, "Alignment test", __FILE__, __LINE__);
+        Allocations16[i] = Allocator16.Allocate(48, "Alignment test", __FILE__, __LINE__);
+        EXPECT_EQ(reinterpret_cast<size_t>(Allocations8[i]) % sizeof(void*), size_t{0});
+        EXPECT_EQ(reinterpret_cast<size_t>(Allocations16[i]) % 16, size_t{0});
+    }
+
+    for (size_t i = 0; i < Allocations8.size(); ++i)
+    {
+        Allocator8.Free(Allocations8[i]);
+        Allocator16.Free(Allocations16[i]);
+    }
+}
+
+static void RunMultithreadedAllocations(FixedBlockMemoryAllocator& Allocator, Uint32 NumThreads, Uint32 NumIterations, Uint32 NumAllocsPerThread)
+{
+    constexpr Uint32 AllocSize = 64;
+
+    std::vector<std::thread> Threads(NumThreads);
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads[t] = std::thread{
+            [&Allocator, t, NumIterations, NumAllocsPerThread]() {
+                std::vector<Uint32*> Allocations(NumAllocsPerThread);
+                for (Uint32 i = 0; i < NumIterations; ++i)
+                {
+                    for (Uint32 a = 0; a < NumAllocsPerThread; ++a)
+                    {
+                        Allocations[a] = reinterpret_cast<Uint32*>(Allocator.Allocate(AllocSize, "Multithreaded allocator test", __FILE__, __LINE__));
+                        std::fill(Allocations[a], Allocations[a] + AllocSize / sizeof(Uint32), t * NumAllocsPerThread + a);
+                    }
+
+                    // Release allocations in interleaved order
+                    for (Uint32 s = 0; s < 3; ++s)
+                    {
+                        for (Uint32 a = s; a < NumAllocsPerThread; a += 3)
+                        {
+                            const auto RefVal = t * NumAllocsPerThread + a;
+                            EXPECT_EQ(Allocations[a][0], RefVal);
+                            EXPECT_EQ(Allocations[a][AllocSize / sizeof(Uint32) - 1], RefVal);
+                            Allocator.Free(Allocations[a]);
+                        }
+                    }
+                }
+            } //
+        };
+    }
+
+    for (auto& Thread : Threads)
+        Thread.join();
+}
+
+TEST(Common_FixedBlockMemoryAllocator, Multithreading)
+{
+    const Uint32 NumThreads = std::max(4u, std::thread::hardware_concurrency());
+
+    FixedBlockMemoryAllocator Allocator(DefaultRawMemoryAllocator::GetAllocator(), 64, 128, 2, 32);
+    RunMultithreadedAllocations(Allocator, NumThreads, 64, 256);
+}
+
 TEST(Common_FixedLinearAllocator, EmptyAllocator)
 {
     FixedLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
@@ -25,9 +25,15 @@
  */
 
 #include <cstring>
+#include <thread>
+#include <vector>
+#include <atomic>
 
 #include "ArchiveMemoryImpl.hpp"
+#include "ArchiveFileImpl.hpp"
 #include "DataBlobImpl.hpp"
+#include "FileWrapper.hpp"
+#include "FastRand.hpp"
 
 #include "gtest/gtest.h"
 
@@ -73,4 +79,139 @@ TEST(Common_Archive, MemoryImpl)
     EXPECT_FALSE(pArchive->Read(sizeof(RefData) + 1024, 1024, nullptr));
 }
 
+class TestArchiveFile
+{
+public:
+    TestArchiveFile(const char* Path, size_t Size) :
+        m_Path{Path},
+        m_Data(Size)
+    {
+        for (size_t i = 0; i < m_Data.size(); ++i)
+            m_Data[i] = static_cast<Uint8>((i * 7) ^ (i >> 8));
+
+        FileWrapper File{Path, EFileAccessMode::Overwrite};
+        VERIFY_EXPR(File);
+        File->Write(m_Data.data(), m_Data.size());
+    }
+
+    ~TestArchiveFile()
+    {
+        FileSystem::DeleteFile(m_Path);
+    }
+
+    const std::vector<Uint8>& GetData() const { return m_Data; }
+
+private:
+    const char* const  m_Path;
+    std::vector<Uint8> m_Data;
+};
+
+TEST(Common_Archive, FileImpl)
+{
+    const char*     Path = "ArchiveFileImplTest.bin";
+    TestArchiveFile TestFile{Path, 4096};
+    const auto&     RefData = TestFile.GetData();
+
+    auto pArchive = ArchiveFileImpl::Create(Path);
+    ASSERT_TRUE(pArchive);
+    EXPECT_EQ(pArchive->GetSize(), RefData.size());
+
+    {
+        std::vector<Uint8> TestData(RefData.size());
+        EXPECT_TRUE(pArchive->Read(0, TestData.size(), TestData.data()));
+        EXPECT_EQ(TestData, RefData);
+    }
+
+    {
+        Uint8 TestData[100] = {};
+        EXPECT_TRUE(pArchive->Read(1000, sizeof(TestData), TestData));
+        EXPECT_EQ(memcmp(&RefData[1000], TestData, sizeof(TestData)), 0);
+    }
+
+    {
+        Uint8 TestData[100] = {};
+        EXPECT_FALSE(pArchive->Read(RefData.size() - 50, sizeof(TestData), TestData));
+        EXPECT_EQ(memcmp(&RefData[RefData.size() - 50], TestData, 50), 0);
+    }
+
+    EXPECT_TRUE(pArchive->Read(RefData.size(), 0, nullptr));
+    EXPECT_FALSE(pArchive->Read(RefData.size(), 1, nullptr));
+
+    auto* pFileArchive = ClassPtrCast<ArchiveFileImpl>(pArchive.RawPtr());
+    {
+        auto pBlob = pFileArchive->Map(512, 1024);
+        ASSERT_TRUE(pBlob);
+        EXPECT_EQ(pBlob->GetSize(), size_t{1024});
+        EXPECT_EQ(memcmp(&RefData[512], pBlob->GetConstDataPtr(), 1024), 0);
+        if (pFileArchive->IsMapped())
+        {
+            // The blob must keep the mapping alive after the archive is released
+            auto pBlob2 = pFileArchive->Map(0, RefData.size());
+            pArchive.Release();
+            EXPECT_EQ(memcmp(RefData.data(), pBlob2->GetConstDataPtr(), RefData.size()), 0);
+        }
+    }
+    if (pArchive)
+    {
+        EXPECT_FALSE(pFileArchive->Map(RefData.size() - 10, 11));
+        EXPECT_FALSE(pFileArchive->Map(RefData.size() + 1, 0));
+    }
+}
+
+TEST(Common_Archive, FileImpl_MultithreadedRead)
+{
+    const char*     Path = "ArchiveFileImplMTTest.bin";
+    TestArchiveFile TestFile{Path, 4 << 20};
+    const auto&     RefData = TestFile.GetData();
+
+    auto pArchive = ArchiveFileImpl::Create(Path);
+    ASSERT_TRUE(pArchive);
+
+    const auto NumThreads     = std::max(std::thread::hardware_concurrency(), 4u);
+    const auto NumReads       = 256u;
+    const auto ReadSize       = size_t{64} << 10;
+    const auto MaxOffset      = static_cast<int>((RefData.size() - ReadSize) / 256 - 1);
+    auto*      pFileArchive   = ClassPtrCast<ArchiveFileImpl>(pArchive.RawPtr());
+    auto       RunReadThreads = [&](bool UseMap) {
+        std::atomic<Uint32>      NumErrors{0};
+        std::vector<std::thread> Threads;
+        Threads.reserve(NumThreads);
+
+        for (Uint32 t = 0; t < NumThreads; ++t)
+        {
+            Threads.emplace_back([&, t]() {
+                // Random offsets are not aligned to exercise all code paths
+                FastRandInt        Rnd{t, 0, MaxOffset};
+                std::vector<Uint8> Buffer(ReadSize);
+                for (Uint32 i = 0; i < NumReads; ++i)
+                {
+                    const auto  Offset = static_cast<size_t>(Rnd()) * 256 + i % 256;
+                    const void* pData  = nullptr;
+
+                    RefCntAutoPtr<IDataBlob> pBlob;
+                    if (UseMap)
+                    {
+                        pBlob = pFileArchive->Map(Offset, ReadSize);
+                        pData = pBlob ? pBlob->GetConstDataPtr() : nullptr;
+                    }
+                    else if (pArchive->Read(Offset, ReadSize, Buffer.data()))
+                    {
+                        pData = Buffer.data();
+                    }
+
+                    if (pData == nullptr || memcmp(pData, &RefData[Offset], ReadSize) != 0)
+                        NumErrors.fetch_add(1);
+                }
+            });
+        }
+        for (auto& Thread : Threads)
+            Thread.join();
+
+        EXPECT_EQ(NumErrors.load(), 0u);
+    };
+
+    RunReadThreads(false);
+    RunReadThreads(true);
+}
+
 } // namespace
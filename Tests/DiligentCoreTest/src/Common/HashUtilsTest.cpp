@@ -26,6 +26,8 @@
  */
 
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "HashUtils.hpp"
 
@@ -116,4 +118,60 @@ TEST(Common_HashUtils, HashMapStringKey)
     }
 }
 
+TEST(Common_HashUtils, ComputeContentHash)
+{
+    std::vector<Uint8> Data(1024);
+    for (size_t i = 0; i < Data.size(); ++i)
+        Data[i] = static_cast<Uint8>(i * 31 + 7);
+
+    std::unordered_set<ContentHash, ContentHash::Hasher> Hashes;
+    // Every prefix must have a unique hash, which also covers all tail sizes
+    for (size_t Size = 0; Size <= Data.size(); ++Size)
+    {
+        const auto Hash = ComputeContentHash(Data.data(), Size);
+        EXPECT_EQ(Hash, ComputeContentHash(Data.data(), Size));
+        EXPECT_TRUE(Hashes.insert(Hash).second) << "Hash collision for size " << Size;
+    }
+
+    // Single-bit changes must change the hash
+    const auto RefHash = ComputeContentHash(Data.data(), Data.size());
+    for (size_t i = 0; i < Data.size(); i += 13)
+    {
+        for (Uint8 Bit = 0; Bit < 8; ++Bit)
+        {
+            Data[i] ^= 1u << Bit;
+            EXPECT_NE(ComputeContentHash(Data.data(), Data.size()), RefHash);
+            Data[i] ^= 1u << Bit;
+        }
+    }
+    EXPECT_EQ(ComputeContentHash(Data.data(), Data.size()), RefHash);
+
+    // Seeded hashes of the same data must differ
+    const auto Hash1 = ComputeContentHash(Data.data(), 16);
+    const auto Hash2 = ComputeContentHash(Data.data() + 16, 16, Hash1);
+    const auto Hash3 = ComputeContentHash(Data.data() + 16, 16);
+    EXPECT_NE(Hash2, Hash3);
+    EXPECT_NE(Hash2, ComputeContentHash(Data.data() + 16, 16, Hash3));
+}
+
+TEST(Common_HashUtils, ContentHasher)
+{
+    auto Hash = [](const char* Str0, const char* Str1, Uint32 Val) {
+        ContentHasher Hasher;
+        Hasher.Update(Str0);
+        Hasher.Update(Str1);
+        Hasher.Update(Val);
+        return Hasher.Get();
+    };
+
+    const auto RefHash = Hash("abc", "def", 1);
+    EXPECT_EQ(Hash("abc", "def", 1), RefHash);
+    EXPECT_NE(Hash("abc", "def", 2), RefHash);
+    // String boundaries must affect the hash
+    EXPECT_NE(Hash("ab", "cdef", 1), RefHash);
+    EXPECT_NE(Hash("abcdef", "", 1), RefHash);
+    // Null string must differ from an empty string
+    EXPECT_NE(Hash(nullptr, "", 1), Hash("", "", 1));
+}
+
 } // namespace
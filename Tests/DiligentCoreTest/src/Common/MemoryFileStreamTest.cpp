@@ -0,0 +1,96 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <cstring>
+
+#include "MemoryFileStream.hpp"
+#include "DataBlobImpl.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+RefCntAutoPtr<IDataBlob> CreateTestBlob(const char* Str)
+{
+    const auto Len = strlen(Str);
+
+    RefCntAutoPtr<IDataBlob> pBlob{MakeNewRCObj<DataBlobImpl>()(Len)};
+    memcpy(pBlob->GetDataPtr(), Str, Len);
+    return pBlob;
+}
+
+TEST(Common_MemoryFileStream, ReadStreamBlob)
+{
+    const char* TestStr = "Memory file stream test data";
+    const auto  TestLen = strlen(TestStr);
+
+    auto pBlob = CreateTestBlob(TestStr);
+
+    // Read-only stream shares its blob
+    {
+        RefCntAutoPtr<IFileStream> pStream{MakeNewRCObj<MemoryFileStream>()(pBlob, true)};
+
+        auto pData = ReadStreamBlob(pStream);
+        ASSERT_NE(pData, nullptr);
+        EXPECT_EQ(pData, pBlob);
+
+        // The second stream over the same blob returns the same data
+        RefCntAutoPtr<IFileStream> pStream2{MakeNewRCObj<MemoryFileStream>()(pBlob, true)};
+        EXPECT_EQ(ReadStreamBlob(pStream2), pBlob);
+    }
+
+    // Writable stream is copied
+    {
+        RefCntAutoPtr<IFileStream> pStream{MakeNewRCObj<MemoryFileStream>()(pBlob)};
+
+        auto pData = ReadStreamBlob(pStream);
+        ASSERT_NE(pData, nullptr);
+        EXPECT_NE(pData, pBlob);
+        ASSERT_EQ(pData->GetSize(), TestLen);
+        EXPECT_EQ(memcmp(pData->GetConstDataPtr(), TestStr, TestLen), 0);
+    }
+
+    // Partially read stream returns the remaining data
+    {
+        RefCntAutoPtr<IFileStream> pStream{MakeNewRCObj<MemoryFileStream>()(pBlob, true)};
+
+        char Prefix[7] = {};
+        ASSERT_TRUE(pStream->Read(Prefix, 6));
+        EXPECT_STREQ(Prefix, "Memory");
+
+        auto pData = ReadStreamBlob(pStream);
+        ASSERT_NE(pData, nullptr);
+        EXPECT_NE(pData, pBlob);
+        ASSERT_EQ(pData->GetSize(), TestLen - 6);
+        EXPECT_EQ(memcmp(pData->GetConstDataPtr(), TestStr + 6, TestLen - 6), 0);
+    }
+}
+
+} // namespace
@@ -0,0 +1,117 @@
+/*
+ *  Copyright 2019-2021 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "ThreadPool.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(Common_ThreadPool, ExecuteTasks)
+{
+    constexpr Uint32 NumTasks = 1024;
+
+    ThreadPool Pool{4};
+    EXPECT_EQ(Pool.GetNumThreads(), 4u);
+
+    std::vector<std::atomic<int>> Counters(NumTasks);
+    for (auto& Counter : Counters)
+        Counter.store(0);
+
+    std::vector<std::future<void>> Futures;
+    for (Uint32 i = 0; i < NumTasks; ++i)
+    {
+        Futures.emplace_back(Pool.Enqueue([&Counters, i]() { Counters[i].fetch_add(1); }));
+    }
+
+    for (auto& Future : Futures)
+        Future.wait();
+
+    for (Uint32 i = 0; i < NumTasks; ++i)
+        EXPECT_EQ(Counters[i].load(), 1) << "Task " << i;
+
+    Pool.WaitForAllTasks();
+    EXPECT_EQ(Pool.GetNumPendingTasks(), 0u);
+}
+
+TEST(Common_ThreadPool, NestedTasks)
+{
+    constexpr Uint32 NumTasks    = 64;
+    constexpr Uint32 NumSubtasks = 16;
+
+    ThreadPool Pool{3};
+
+    std::atomic<Uint32> NumCompleted{0};
+    for (Uint32 i = 0; i < NumTasks; ++i)
+    {
+        Pool.Enqueue([&]() {
+            for (Uint32 j = 0; j < NumSubtasks; ++j)
+                Pool.Enqueue([&]() { NumCompleted.fetch_add(1); });
+        });
+    }
+
+    // Subtasks are enqueued before the parent task completes, so the pool
+    // can not become idle until all of them are executed.
+    Pool.WaitForAllTasks();
+    EXPECT_EQ(NumCompleted.load(), NumTasks * NumSubtasks);
+}
+
+TEST(Common_ThreadPool, Exception)
+{
+    ThreadPool Pool{2};
+
+    auto Future = Pool.Enqueue([]() { throw std::runtime_error{"Test exception"}; });
+    EXPECT_THROW(Future.get(), std::runtime_error);
+
+    // The pool must remain functional
+    bool Executed = false;
+    Pool.Enqueue([&Executed]() { Executed = true; }).get();
+    EXPECT_TRUE(Executed);
+}
+
+TEST(Common_ThreadPool, Destroy)
+{
+    constexpr Uint32 NumTasks = 256;
+
+    std::atomic<Uint32> NumCompleted{0};
+    {
+        ThreadPool Pool{2};
+        for (Uint32 i = 0; i < NumTasks; ++i)
+            Pool.Enqueue([&NumCompleted]() { NumCompleted.fetch_add(1); });
+        // All tasks must complete before the pool is destroyed
+    }
+    EXPECT_EQ(NumCompleted.load(), NumTasks);
+}
+
+} // namespace
@@ -26,11 +26,14 @@
  */
 
 #include "GraphicsUtilities.h"
+#include "GraphicsAccessories.hpp"
 #include "FastRand.hpp"
 #include "ColorConversion.h"
 
 #include <vector>
 #include <array>
+#include <algorithm>
+#include <cstring>
 
 #include "gtest/gtest.h"
 
@@ -575,4 +578,147 @@ TEST(GraphicsTools_CalculateMipLevel, sRGB_BOX_AVE)
     EXPECT_TRUE(CoarseData == RefCoarseData);
 }
 
+// Checks that vectorized filters produce the same results as the scalar ones
+// for all widths that exercise both the vector loop and the scalar tail.
+template <typename ChannelType, typename RefFilterType>
+void TestBoxFilterWidths(TEXTURE_FORMAT Fmt, Uint32 NumChannels, RefFilterType RefFilter, ChannelType MaxVal)
+{
+    FastRandInt rnd(0, 0, 32766);
+    for (Uint32 FineWidth = 2; FineWidth <= 43; ++FineWidth)
+    {
+        for (Uint32 FineHeight = 2; FineHeight <= 5; ++FineHeight)
+        {
+            const Uint32 CoarseWidth  = FineWidth / 2;
+            const Uint32 CoarseHeight = FineHeight / 2;
+
+            // Use padded strides to make sure that they are respected
+            const size_t FineStride   = (FineWidth * NumChannels + 3) * sizeof(ChannelType);
+            const size_t CoarseStride = (CoarseWidth * NumChannels + 5) * sizeof(ChannelType);
+
+            std::vector<ChannelType> FineData(FineStride / sizeof(ChannelType) * FineHeight);
+            for (auto& c : FineData)
+                c = static_cast<ChannelType>(static_cast<double>(rnd()) / 32766.0 * static_cast<double>(MaxVal));
+
+            const auto pFineRow = [&](Uint32 y) {
+                return FineData.data() + y * FineStride / sizeof(ChannelType);
+            };
+
+            std::vector<ChannelType> RefCoarseData(CoarseStride / sizeof(ChannelType) * CoarseHeight);
+            for (Uint32 y = 0; y < CoarseHeight; ++y)
+            {
+                for (Uint32 x = 0; x < CoarseWidth * NumChannels; ++x)
+                {
+                    const auto c = x % NumChannels;
+                    const auto i = x - c;
+                    RefCoarseData[y * CoarseStride / sizeof(ChannelType) + x] =
+                        RefFilter(pFineRow(y * 2 + 0)[i * 2 + c], pFineRow(y * 2 + 0)[i * 2 + NumChannels + c],
+                                  pFineRow(y * 2 + 1)[i * 2 + c], pFineRow(y * 2 + 1)[i * 2 + NumChannels + c]);
+                }
+            }
+
+            std::vector<ChannelType> CoarseData(RefCoarseData.size());
+            ComputeMipLevel({Fmt, FineWidth, FineHeight, FineData.data(), FineStride, CoarseData.data(), CoarseStride, MIP_FILTER_TYPE_BOX_AVERAGE});
+            for (Uint32 y = 0; y < CoarseHeight; ++y)
+            {
+                const auto RowOffset = y * CoarseStride / sizeof(ChannelType);
+                EXPECT_EQ(memcmp(&CoarseData[RowOffset], &RefCoarseData[RowOffset], CoarseWidth * NumChannels * sizeof(ChannelType)), 0)
+                    << "Fine mip size: " << FineWidth << "x" << FineHeight << ", row " << y;
+            }
+        }
+    }
+}
+
+TEST(GraphicsTools_CalculateMipLevel, VectorizedFilters)
+{
+    TestBoxFilterWidths<Uint8>(
+        TEX_FORMAT_RGBA8_UNORM, 4,
+        [](Uint8 c0, Uint8 c1, Uint8 c2, Uint8 c3) {
+            return static_cast<Uint8>((c0 + c1 + c2 + c3) / 4);
+        },
+        Uint8{255});
+
+    TestBoxFilterWidths<Uint8>(
+        TEX_FORMAT_RGBA8_UNORM_SRGB, 4,
+        [](Uint8 c0, Uint8 c1, Uint8 c2, Uint8 c3) {
+            const float fLinearAverage =
+                (FastSRGBToLinear(c0 * (1.f / 255.f)) +
+                 FastSRGBToLinear(c1 * (1.f / 255.f)) +
+                 FastSRGBToLinear(c2 * (1.f / 255.f)) +
+                 FastSRGBToLinear(c3 * (1.f / 255.f))) *
+                0.25f;
+            const float fSRGB = std::min(std::max(FastLinearToSRGB(fLinearAverage) * 255.f, 0.f), 255.f);
+            return static_cast<Uint8>(fSRGB);
+        },
+        Uint8{255});
+
+    TestBoxFilterWidths<Uint16>(
+        TEX_FORMAT_R16_UNORM, 1,
+        [](Uint16 c0, Uint16 c1, Uint16 c2, Uint16 c3) {
+            return static_cast<Uint16>((Uint32{c0} + Uint32{c1} + Uint32{c2} + Uint32{c3}) / 4);
+        },
+        Uint16{65535});
+
+    TestBoxFilterWidths<Float32>(
+        TEX_FORMAT_RGBA32_FLOAT, 4,
+        [](Float32 c0, Float32 c1, Float32 c2, Float32 c3) {
+            return (c0 + c1 + c2 + c3) * 0.25f;
+        },
+        1000.f);
+}
+
+TEST(GraphicsTools_ComputeMipChain, MatchesComputeMipLevel)
+{
+    for (auto Fmt : {TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA8_UNORM_SRGB, TEX_FORMAT_R8_UINT})
+    {
+        const Uint32 Width     = 1023;
+        const Uint32 Height    = 517;
+        const auto   PixelSize = Uint32{GetTextureFormatAttribs(Fmt).GetElementSize()};
+        const auto   NumMips   = ComputeMipLevelsCount(Width, Height);
+
+        std::vector<std::vector<Uint8>> MipData(NumMips);
+        std::vector<std::vector<Uint8>> RefMipData(NumMips);
+        std::vector<void*>              pMipData(NumMips);
+        std::vector<size_t>             MipStrides(NumMips);
+        for (Uint32 mip = 0; mip < NumMips; ++mip)
+        {
+            const auto MipWidth  = std::max(Width >> mip, 1u);
+            const auto MipHeight = std::max(Height >> mip, 1u);
+            MipStrides[mip]      = MipWidth * PixelSize + 4;
+            MipData[mip].resize(MipStrides[mip] * MipHeight);
+            RefMipData[mip].resize(MipData[mip].size());
+            pMipData[mip] = MipData[mip].data();
+        }
+
+        FastRandInt rnd(0, 0, 255);
+        for (auto& c : MipData[0])
+            c = static_cast<Uint8>(rnd());
+        RefMipData[0] = MipData[0];
+
+        for (Uint32 mip = 1; mip < NumMips; ++mip)
+        {
+            ComputeMipLevel({Fmt, std::max(Width >> (mip - 1), 1u), std::max(Height >> (mip - 1), 1u),
+                             RefMipData[mip - 1].data(), MipStrides[mip - 1],
+                             RefMipData[mip].data(), MipStrides[mip]});
+        }
+
+        for (Uint32 NumThreads : {1u, 3u, 8u})
+        {
+            ComputeMipChainAttribs Attribs;
+            Attribs.Format      = Fmt;
+            Attribs.Width       = Width;
+            Attribs.Height      = Height;
+            Attribs.ppMipData   = pMipData.data();
+            Attribs.pMipStrides = MipStrides.data();
+            Attribs.NumThreads  = NumThreads;
+            ComputeMipChain(Attribs);
+
+            for (Uint32 mip = 1; mip < NumMips; ++mip)
+            {
+                EXPECT_TRUE(MipData[mip] == RefMipData[mip]) << "Mip " << mip << ", " << NumThreads << " threads";
+                std::fill(MipData[mip].begin(), MipData[mip].end(), Uint8{0});
+            }
+        }
+    }
+}
+
 } // namespace
@@ -26,6 +26,9 @@
  */
 
 #include <memory>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 #include "ResourceReleaseQueue.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
@@ -128,4 +131,154 @@ TEST(GraphicsAccessories_ResourceReleaseQueue, GetFilterTypeLiteralName)
     }
 }
 
+struct CountedResource
+{
+    explicit CountedResource(std::atomic<int>& _Counter) :
+        Counter{&_Counter}
+    {}
+
+    CountedResource(CountedResource&& rhs) noexcept :
+        Counter{rhs.Counter}
+    {
+        rhs.Counter = nullptr;
+    }
+
+    ~CountedResource()
+    {
+        if (Counter != nullptr)
+            Counter->fetch_add(1);
+    }
+
+    std::atomic<int>* Counter = nullptr;
+};
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, FenceValues)
+{
+    std::atomic<int> NumDestroyed{0};
+
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+
+    // Released with command lists 0, 1 and 2
+    for (Uint64 CmdListNum = 0; CmdListNum < 3; ++CmdListNum)
+    {
+        for (int i = 0; i < 4; ++i)
+            Queue.SafeReleaseResource(CountedResource{NumDestroyed}, CmdListNum);
+    }
+    EXPECT_EQ(Queue.GetStaleResourceCount(), 12u);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 0u);
+
+    // Command list 1 is submitted with fence value 10
+    Queue.DiscardStaleResources(1, 10);
+    EXPECT_EQ(Queue.GetStaleResourceCount(), 4u);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 8u);
+
+    Queue.DiscardResource(CountedResource{NumDestroyed}, 15);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 9u);
+
+    Queue.Purge(9);
+    EXPECT_EQ(NumDestroyed, 0);
+
+    Queue.Purge(10);
+    EXPECT_EQ(NumDestroyed, 8);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 1u);
+
+    // Command list 2 is submitted with fence value 20
+    Queue.DiscardStaleResources(2, 20);
+    EXPECT_EQ(Queue.GetStaleResourceCount(), 0u);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 5u);
+
+    Queue.Purge(15);
+    EXPECT_EQ(NumDestroyed, 9);
+
+    Queue.Purge(20);
+    EXPECT_EQ(NumDestroyed, 13);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 0u);
+
+    const auto Stats = Queue.GetStats();
+    EXPECT_EQ(Stats.NumStaleResources, 0u);
+    EXPECT_EQ(Stats.NumPendingResources, 0u);
+    EXPECT_EQ(Stats.MaxQueueDepth, 13u);
+    EXPECT_EQ(Stats.NumReleasedResources, 13u);
+    EXPECT_EQ(Stats.NumPurges, 3u);
+    EXPECT_GE(Stats.MaxPurgeTime, Stats.LastPurgeTime);
+    EXPECT_GE(Stats.TotalPurgeTime, Stats.MaxPurgeTime);
+}
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, DiscardResources)
+{
+    std::atomic<int> NumDestroyed{0};
+
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+
+    int NumResources = 5;
+    Queue.DiscardResources<std::unique_ptr<CountedResource>>(
+        1,
+        [&](std::unique_ptr<CountedResource>& Res) {
+            if (NumResources == 0)
+                return false;
+            --NumResources;
+            Res.reset(new CountedResource{NumDestroyed});
+            return true;
+        });
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 5u);
+
+    Queue.Purge(0);
+    EXPECT_EQ(NumDestroyed, 0);
+    Queue.Purge(1);
+    EXPECT_EQ(NumDestroyed, 5);
+}
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, Multithreaded)
+{
+    constexpr int NumThreads            = 4;
+    constexpr int NumResourcesPerThread = 5000;
+
+    std::atomic<int> NumDestroyed{0};
+
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+
+    std::atomic<Uint64> NextCmdListNumber{0};
+    std::atomic<int>    NumRunningThreads{NumThreads};
+
+    std::vector<std::thread> Threads;
+    for (int t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back(
+            [&]() {
+                for (int i = 0; i < NumResourcesPerThread; ++i)
+                {
+                    if (i % 2 == 0)
+                        Queue.SafeReleaseResource(CountedResource{NumDestroyed}, NextCmdListNumber.load());
+                    else
+                        Queue.DiscardResource(CountedResource{NumDestroyed}, NextCmdListNumber.load());
+                }
+                NumRunningThreads.fetch_sub(1);
+            });
+    }
+
+    // Simulate command list submission and purging while the threads release resources
+    Uint64 FenceValue = 0;
+    while (NumRunningThreads.load() > 0)
+    {
+        const auto CmdListNumber = NextCmdListNumber.fetch_add(1);
+        Queue.DiscardStaleResources(CmdListNumber, ++FenceValue);
+        Queue.Purge(FenceValue - 1);
+    }
+
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    const auto CmdListNumber = NextCmdListNumber.fetch_add(1);
+    Queue.DiscardStaleResources(CmdListNumber, ++FenceValue);
+    Queue.Purge(FenceValue);
+
+    EXPECT_EQ(NumDestroyed, NumThreads * NumResourcesPerThread);
+    EXPECT_EQ(Queue.GetStaleResourceCount(), 0u);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 0u);
+
+    const auto Stats = Queue.GetStats();
+    EXPECT_EQ(Stats.NumReleasedResources, static_cast<Uint64>(NumThreads * NumResourcesPerThread));
+    EXPECT_GT(Stats.MaxQueueDepth, 0u);
+}
+
 } // namespace
@@ -25,9 +25,13 @@
  *  of the possibility of such damages.
  */
 
+#include <vector>
+#include <algorithm>
+
 #include "VariableSizeGPUAllocationsManager.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
 #include "PlatformDefinitions.h"
+#include "FastRand.hpp"
 
 #include "gtest/gtest.h"
 
@@ -183,6 +187,7 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, FreeOrder)
     auto& Allocator  = DefaultRawMemoryAllocator::GetAllocator();
     using OffsetType = VariableSizeAllocationsManager::OffsetType;
 
+    for (auto Algorithm : {VariableSizeAllocationsManager::ALGORITHM_ORDERED_MAPS, VariableSizeAllocationsManager::ALGORITHM_TLSF})
     {
         const auto NumAllocs = 6;
         int        NumPerms  = 0;
@@ -192,7 +197,7 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, FreeOrder)
         do
         {
             ++NumPerms;
-            VariableSizeAllocationsManager ListMgr(NumAllocs * 4, Allocator);
+            VariableSizeAllocationsManager ListMgr(NumAllocs * 4, Allocator, Algorithm);
 
             VariableSizeAllocationsManager::Allocation allocs[NumAllocs];
             for (size_t a = 0; a < NumAllocs; ++a)
@@ -205,6 +210,8 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, FreeOrder)
             {
                 ListMgr.Free(std::move(allocs[ReleaseOrder[a]]));
             }
+            EXPECT_TRUE(ListMgr.IsEmpty());
+            EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
         } while (std::next_permutation(std::begin(ReleaseOrder), std::end(ReleaseOrder)));
         EXPECT_EQ(NumPerms, 720);
     }
@@ -249,4 +256,251 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, Free)
     }
 }
 
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, TLSFAllocateFree)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+
+    {
+        VariableSizeAllocationsManager ListMgr(128, Allocator, VariableSizeAllocationsManager::ALGORITHM_TLSF);
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+        EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), size_t{128});
+
+        auto a1 = ListMgr.Allocate(17, 4);
+        EXPECT_EQ(a1.UnalignedOffset, OffsetType{0});
+        EXPECT_EQ(a1.Size, OffsetType{20});
+        EXPECT_EQ(ListMgr.GetFreeSize(), size_t{128 - 20});
+        EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), size_t{128 - 20});
+
+        auto a2 = ListMgr.Allocate(17, 8);
+        EXPECT_EQ(a2.UnalignedOffset, OffsetType{20});
+        EXPECT_EQ(a2.Size, OffsetType{28});
+
+        // The remaining block is exactly large enough
+        auto a3 = ListMgr.Allocate(80, 16);
+        EXPECT_EQ(a3.UnalignedOffset, OffsetType{48});
+        EXPECT_EQ(a3.Size, OffsetType{80});
+        EXPECT_TRUE(ListMgr.IsFull());
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{0});
+
+        auto a4 = ListMgr.Allocate(1, 1);
+        EXPECT_FALSE(a4.IsValid());
+
+        ListMgr.Free(std::move(a2));
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+        EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), size_t{28});
+
+        // 16 bytes at 16-byte alignment do not fit into [20, 48)
+        a4 = ListMgr.Allocate(24, 16);
+        EXPECT_FALSE(a4.IsValid());
+
+        a4 = ListMgr.Allocate(12, 16);
+        EXPECT_EQ(a4.UnalignedOffset, OffsetType{20});
+        EXPECT_EQ(a4.Size, OffsetType{28});
+
+        ListMgr.Free(std::move(a1));
+        ListMgr.Free(std::move(a3));
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{2});
+        ListMgr.Free(std::move(a4));
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+        EXPECT_TRUE(ListMgr.IsEmpty());
+    }
+
+    {
+        VariableSizeAllocationsManager ListMgr(128, Allocator, VariableSizeAllocationsManager::ALGORITHM_TLSF);
+
+        auto a1 = ListMgr.Allocate(64, 1);
+        EXPECT_EQ(a1.UnalignedOffset, OffsetType{0});
+
+        auto a2 = ListMgr.Allocate(128, 1);
+        EXPECT_FALSE(a2.IsValid());
+
+        ListMgr.Extend(128);
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+
+        a2 = ListMgr.Allocate(128, 1);
+        EXPECT_EQ(a2.UnalignedOffset, OffsetType{64});
+        EXPECT_EQ(a2.Size, OffsetType{128});
+
+        auto a3 = ListMgr.Allocate(64, 1);
+        EXPECT_TRUE(ListMgr.IsFull());
+
+        ListMgr.Free(std::move(a1));
+        ListMgr.Extend(1024);
+        EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{2});
+
+        auto a4 = ListMgr.Allocate(1024, 256);
+        EXPECT_EQ(a4.UnalignedOffset, OffsetType{256});
+
+        ListMgr.Free(std::move(a2));
+        ListMgr.Free(std::move(a4));
+        ListMgr.Free(std::move(a3));
+        EXPECT_TRUE(ListMgr.IsEmpty());
+    }
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, Move)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+
+    for (auto Algorithm : {VariableSizeAllocationsManager::ALGORITHM_ORDERED_MAPS, VariableSizeAllocationsManager::ALGORITHM_TLSF})
+    {
+        VariableSizeAllocationsManager Mgr0(128, Allocator, Algorithm);
+
+        auto a1 = Mgr0.Allocate(16, 1);
+        auto a2 = Mgr0.Allocate(16, 1);
+        auto a3 = Mgr0.Allocate(16, 1);
+        Mgr0.Free(std::move(a2));
+        EXPECT_EQ(Mgr0.GetNumFreeBlocks(), size_t{2});
+
+        VariableSizeAllocationsManager Mgr1{std::move(Mgr0)};
+        EXPECT_EQ(Mgr0.GetMaxSize(), OffsetType{0});
+        EXPECT_EQ(Mgr0.GetFreeSize(), OffsetType{0});
+        EXPECT_EQ(Mgr0.GetNumFreeBlocks(), size_t{0});
+        EXPECT_EQ(Mgr1.GetMaxSize(), OffsetType{128});
+        EXPECT_EQ(Mgr1.GetFreeSize(), OffsetType{128 - 32});
+        EXPECT_EQ(Mgr1.GetNumFreeBlocks(), size_t{2});
+
+        VariableSizeAllocationsManager Mgr2(64, Allocator, Algorithm);
+        auto                           b1 = Mgr2.Allocate(32, 1);
+        Mgr2.Free(std::move(b1));
+
+        Mgr2 = std::move(Mgr1);
+        EXPECT_EQ(Mgr1.GetMaxSize(), OffsetType{0});
+        EXPECT_EQ(Mgr1.GetFreeSize(), OffsetType{0});
+        EXPECT_EQ(Mgr1.GetNumFreeBlocks(), size_t{0});
+        EXPECT_EQ(Mgr2.GetMaxSize(), OffsetType{128});
+        EXPECT_EQ(Mgr2.GetNumFreeBlocks(), size_t{2});
+
+        // The free block between a1 and a3 must still be usable
+        auto a4 = Mgr2.Allocate(16, 1);
+        EXPECT_EQ(a4.UnalignedOffset, OffsetType{16});
+
+        Mgr2.Free(std::move(a1));
+        Mgr2.Free(std::move(a3));
+        Mgr2.Free(std::move(a4));
+        EXPECT_TRUE(Mgr2.IsEmpty());
+        EXPECT_EQ(Mgr2.GetNumFreeBlocks(), size_t{1});
+
+        // Moved-from managers must be destroyed cleanly and be assignable again
+        Mgr0 = std::move(Mgr2);
+        EXPECT_TRUE(Mgr0.IsEmpty());
+        EXPECT_EQ(Mgr0.GetMaxFreeBlockSize(), OffsetType{128});
+    }
+}
+
+// Runs the same random sequence of requests through both algorithms and checks that
+// they produce consistent results.
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, TLSFRandomizedEquivalence)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+    using Allocation = VariableSizeAllocationsManager::Allocation;
+
+    // Without alignment and with enough space, every request succeeds in both managers,
+    // so their free sizes must match after every operation.
+    {
+        constexpr OffsetType MaxSize = 1 << 20;
+
+        VariableSizeAllocationsManager MapMgr(MaxSize, Allocator, VariableSizeAllocationsManager::ALGORITHM_ORDERED_MAPS);
+        VariableSizeAllocationsManager TLSFMgr(MaxSize, Allocator, VariableSizeAllocationsManager::ALGORITHM_TLSF);
+
+        FastRandInt RndSize{0, 1, 512};
+        FastRandInt RndOp{1, 0, 2};
+
+        std::vector<Allocation> MapAllocs, TLSFAllocs;
+        for (int i = 0; i < 10000; ++i)
+        {
+            if (RndOp() != 0 || MapAllocs.empty())
+            {
+                const auto Size = static_cast<OffsetType>(RndSize());
+                MapAllocs.push_back(MapMgr.Allocate(Size, 1));
+                TLSFAllocs.push_back(TLSFMgr.Allocate(Size, 1));
+                ASSERT_TRUE(MapAllocs.back().IsValid());
+                ASSERT_TRUE(TLSFAllocs.back().IsValid());
+                EXPECT_EQ(MapAllocs.back().Size, TLSFAllocs.back().Size);
+            }
+            else
+            {
+                const auto Idx = static_cast<size_t>(RndSize()) % MapAllocs.size();
+                MapMgr.Free(std::move(MapAllocs[Idx]));
+                TLSFMgr.Free(std::move(TLSFAllocs[Idx]));
+                MapAllocs[Idx]  = MapAllocs.back();
+                TLSFAllocs[Idx] = TLSFAllocs.back();
+                MapAllocs.pop_back();
+                TLSFAllocs.pop_back();
+            }
+            ASSERT_EQ(MapMgr.GetFreeSize(), TLSFMgr.GetFreeSize());
+        }
+
+        for (auto& Alloc : MapAllocs)
+            MapMgr.Free(std::move(Alloc));
+        for (auto& Alloc : TLSFAllocs)
+            TLSFMgr.Free(std::move(Alloc));
+        EXPECT_TRUE(MapMgr.IsEmpty());
+        EXPECT_TRUE(TLSFMgr.IsEmpty());
+        EXPECT_EQ(TLSFMgr.GetNumFreeBlocks(), size_t{1});
+    }
+
+    // With random alignments in a small heap, the managers make different choices,
+    // but both must satisfy the same contract.
+    for (auto Algorithm : {VariableSizeAllocationsManager::ALGORITHM_ORDERED_MAPS, VariableSizeAllocationsManager::ALGORITHM_TLSF})
+    {
+        constexpr OffsetType MaxSize = 1 << 14;
+
+        VariableSizeAllocationsManager Mgr(MaxSize, Allocator, Algorithm);
+
+        FastRandInt RndSize{2, 1, 1024};
+        FastRandInt RndAlign{3, 0, 6};
+        FastRandInt RndOp{4, 0, 2};
+
+        std::vector<bool>       Used(MaxSize);
+        std::vector<Allocation> Allocs;
+        OffsetType              UsedSize = 0;
+        for (int i = 0; i < 10000; ++i)
+        {
+            if (RndOp() != 0 || Allocs.empty())
+            {
+                const auto Size      = static_cast<OffsetType>(RndSize());
+                const auto Alignment = OffsetType{1} << RndAlign();
+
+                auto Alloc = Mgr.Allocate(Size, Alignment);
+                if (!Alloc.IsValid())
+                    continue;
+
+                EXPECT_LE(AlignUp(Alloc.UnalignedOffset, Alignment) + Size, Alloc.UnalignedOffset + Alloc.Size);
+                for (auto o = Alloc.UnalignedOffset; o < Alloc.UnalignedOffset + Alloc.Size; ++o)
+                {
+                    ASSERT_FALSE(Used[o]) << "Overlapping allocations";
+                    Used[o] = true;
+                }
+                UsedSize += Alloc.Size;
+                Allocs.push_back(Alloc);
+            }
+            else
+            {
+                const auto Idx   = static_cast<size_t>(RndSize()) % Allocs.size();
+                auto&      Alloc = Allocs[Idx];
+                for (auto o = Alloc.UnalignedOffset; o < Alloc.UnalignedOffset + Alloc.Size; ++o)
+                    Used[o] = false;
+                UsedSize -= Alloc.Size;
+                Mgr.Free(std::move(Alloc));
+                Alloc = Allocs.back();
+                Allocs.pop_back();
+            }
+            ASSERT_EQ(Mgr.GetUsedSize(), UsedSize);
+        }
+
+        for (auto& Alloc : Allocs)
+            Mgr.Free(std::move(Alloc));
+        EXPECT_TRUE(Mgr.IsEmpty());
+        EXPECT_EQ(Mgr.GetNumFreeBlocks(), size_t{1});
+        EXPECT_EQ(Mgr.GetMaxFreeBlockSize(), MaxSize);
+    }
+}
+
 } // namespace
@@ -25,6 +25,7 @@
  */
 
 #include "FileSystem.hpp"
+#include "FileWrapper.hpp"
 
 #include "gtest/gtest.h"
 
@@ -137,4 +138,21 @@ TEST(Platforms_FileSystem, SimplifyPath)
     EXPECT_STREQ(FileSystem::SimplifyPath("..\\..", '\\').c_str(), "..\\..");
 }
 
+TEST(Platforms_FileSystem, GetFileModificationTime)
+{
+    const char* TestFileName = "FileSystemTest_ModificationTime.txt";
+    {
+        FileWrapper File{TestFileName, EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+        File->Write("Test", 4);
+    }
+
+    EXPECT_NE(FileSystem::GetFileModificationTime(TestFileName), Uint64{0});
+    FileSystem::DeleteFile(TestFileName);
+
+    EXPECT_EQ(FileSystem::GetFileModificationTime(TestFileName), Uint64{0});
+    EXPECT_EQ(FileSystem::GetFileModificationTime("NonExistentDirectory/NonExistentFile.txt"), Uint64{0});
+    EXPECT_EQ(FileSystem::GetFileModificationTime(""), Uint64{0});
+}
+
 } // namespace
@@ -388,6 +388,7 @@ TestingEnvironment::TestingEnvironment(const CreateInfo& CI, const SwapChainDesc
             CreateInfo.DebugMessageCallback = MessageCallback;
             CreateInfo.Window               = Window;
             CreateInfo.Features             = DeviceFeatures{DEVICE_FEATURE_STATE_OPTIONAL};
+            CreateInfo.DynamicHeapSize      = 8 << 20;
             if (CI.ForceNonSeparablePrograms)
                 CreateInfo.Features.SeparablePrograms = DEVICE_FEATURE_STATE_DISABLED;
             NumDeferredCtx = 0;
@@ -438,6 +439,8 @@ TestingEnvironment::TestingEnvironment(const CreateInfo& CI, const SwapChainDesc
             //CreateInfo.HostVisibleMemoryReserveSize = 48 << 20;
             CreateInfo.Features = DeviceFeatures{DEVICE_FEATURE_STATE_OPTIONAL};
 
+            CreateInfo.NumPipelineCompilationThreads = 2;
+
             NumDeferredCtx                 = CI.NumDeferredContexts;
             CreateInfo.NumDeferredContexts = NumDeferredCtx;
             ppContexts.resize(std::max(size_t{1}, ContextCI.size()) + NumDeferredCtx);
@@ -59,6 +59,8 @@ void TestDeviceContextCInterface(struct IDeviceContext* pCtx)
 
     IDeviceContext_Draw(pCtx, (struct DrawAttribs*)NULL);
     IDeviceContext_DrawIndexed(pCtx, (struct DrawIndexedAttribs*)NULL);
+    IDeviceContext_MultiDraw(pCtx, (struct MultiDrawAttribs*)NULL);
+    IDeviceContext_MultiDrawIndexed(pCtx, (struct MultiDrawIndexedAttribs*)NULL);
     IDeviceContext_DrawIndirect(pCtx, (struct DrawIndirectAttribs*)NULL);
     IDeviceContext_DrawIndexedIndirect(pCtx, (struct DrawIndexedIndirectAttribs*)NULL);
     IDeviceContext_DrawMesh(pCtx, (struct DrawMeshAttribs*)NULL);
@@ -49,4 +49,14 @@ void TestPipelineState_CInterface(IPipelineState* pPSO)
     (void)Compatible;
 
     IPipelineState_InitializeStaticSRBResources(pPSO, (struct IShaderResourceBinding*)NULL);
+
+    PIPELINE_STATE_STATUS Status = IPipelineState_GetStatus(pPSO, false);
+    (void)Status;
+
+    SpecializationConstant SpecConst;
+    SpecConst.Name         = "Constant";
+    SpecConst.ShaderStages = SHADER_TYPE_PIXEL;
+    SpecConst.Size         = 0;
+    SpecConst.pValue       = NULL;
+    (void)SpecConst;
 }
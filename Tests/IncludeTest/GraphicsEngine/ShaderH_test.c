@@ -26,3 +26,18 @@
  */
 
 #include "DiligentCore/Graphics/GraphicsEngine/interface/Shader.h"
+
+void TestShader_CInterface(IShader* pShader)
+{
+    const ShaderDesc* pDesc = IShader_GetDesc(pShader);
+    (void)pDesc;
+
+    Uint32 ResCount = IShader_GetResourceCount(pShader);
+    (void)ResCount;
+
+    ShaderResourceDesc ResDesc;
+    IShader_GetResourceDesc(pShader, 0, &ResDesc);
+
+    SHADER_STATUS Status = IShader_GetStatus(pShader, false);
+    (void)Status;
+}